@@ -0,0 +1,180 @@
+#include "BenchmarkUtilities.hpp"
+
+#include "complex/ComplexVersion.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <thread>
+
+#if defined(_WIN32)
+// clang-format off
+#include <windows.h>
+#include <psapi.h>
+// clang-format on
+#else
+#include <sys/resource.h>
+#endif
+
+namespace complex::Benchmark
+{
+// -----------------------------------------------------------------------------
+nlohmann::json BenchmarkResult::toJson() const
+{
+  nlohmann::json json;
+  json["name"] = name;
+  json["category"] = category;
+  json["problem_size"] = problemSize;
+  json["items_processed"] = itemsProcessed;
+  json["iteration_seconds"] = iterationSeconds;
+  json["min_seconds"] = minSeconds;
+  json["mean_seconds"] = meanSeconds;
+  json["max_seconds"] = maxSeconds;
+  json["items_per_second"] = itemsPerSecond;
+  json["peak_resident_bytes"] = peakResidentBytes;
+  json["peak_memory_delta_bytes"] = peakMemoryDeltaBytes;
+  json["valid"] = valid;
+  if(!message.empty())
+  {
+    json["message"] = message;
+  }
+  return json;
+}
+
+// -----------------------------------------------------------------------------
+usize GetPeakMemoryUsage()
+{
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) == 0)
+  {
+    return 0;
+  }
+  return static_cast<usize>(counters.PeakWorkingSetSize);
+#elif defined(__linux__)
+  // Unlike ru_maxrss, VmHWM follows resets through /proc/self/clear_refs
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while(std::getline(status, line))
+  {
+    if(line.rfind("VmHWM:", 0) == 0)
+    {
+      // Reported in kilobytes
+      return static_cast<usize>(std::stoull(line.substr(6))) * 1024;
+    }
+  }
+  return 0;
+#else
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) != 0)
+  {
+    return 0;
+  }
+#if defined(__APPLE__)
+  // macOS reports bytes
+  return static_cast<usize>(usage.ru_maxrss);
+#else
+  // Other platforms report kilobytes
+  return static_cast<usize>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+// -----------------------------------------------------------------------------
+bool ResetPeakMemoryUsage()
+{
+#if defined(__linux__)
+  std::ofstream clearRefs("/proc/self/clear_refs");
+  clearRefs << "5";
+  clearRefs.flush();
+  return clearRefs.good();
+#else
+  return false;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+nlohmann::json GetSystemInfo()
+{
+  nlohmann::json json;
+  json["complex_version"] = Version::Complete();
+  json["hardware_threads"] = std::thread::hardware_concurrency();
+#ifdef COMPLEX_ENABLE_MULTICORE
+  json["multicore"] = true;
+#else
+  json["multicore"] = false;
+#endif
+#if defined(_WIN32)
+  json["platform"] = "windows";
+#elif defined(__APPLE__)
+  json["platform"] = "macos";
+#else
+  json["platform"] = "linux";
+#endif
+#ifdef NDEBUG
+  json["build_type"] = "release";
+#else
+  json["build_type"] = "debug";
+#endif
+  return json;
+}
+
+// -----------------------------------------------------------------------------
+BenchmarkResult RunBenchmark(const std::string& name, const std::string& category, usize problemSize, usize itemsProcessed, usize repetitions,
+                             const std::function<BenchmarkIteration()>& createIteration)
+{
+  BenchmarkResult result;
+  result.name = name;
+  result.category = category;
+  result.problemSize = problemSize;
+  result.itemsProcessed = itemsProcessed;
+
+  // Without a reset the delta only counts memory above the peak of the earlier cases
+  ResetPeakMemoryUsage();
+  const usize basePeakMemory = GetPeakMemoryUsage();
+
+  for(usize i = 0; i < std::max<usize>(repetitions, 1); i++)
+  {
+    BenchmarkIteration iteration = createIteration();
+    if(iteration.setup)
+    {
+      std::string error = iteration.setup();
+      if(!error.empty())
+      {
+        result.valid = false;
+        result.message = error;
+        break;
+      }
+    }
+
+    Timer timer;
+    std::string error = iteration.run();
+    const float64 seconds = timer.elapsedSeconds();
+    if(!error.empty())
+    {
+      result.valid = false;
+      result.message = error;
+      break;
+    }
+    result.iterationSeconds.push_back(seconds);
+  }
+
+  result.peakResidentBytes = GetPeakMemoryUsage();
+  result.peakMemoryDeltaBytes = result.peakResidentBytes > basePeakMemory ? result.peakResidentBytes - basePeakMemory : 0;
+  if(result.iterationSeconds.empty())
+  {
+    return result;
+  }
+
+  const auto [minIter, maxIter] = std::minmax_element(result.iterationSeconds.cbegin(), result.iterationSeconds.cend());
+  result.minSeconds = *minIter;
+  result.maxSeconds = *maxIter;
+  result.meanSeconds = std::accumulate(result.iterationSeconds.cbegin(), result.iterationSeconds.cend(), 0.0) / static_cast<float64>(result.iterationSeconds.size());
+  if(result.minSeconds > 0.0)
+  {
+    result.itemsPerSecond = static_cast<float64>(itemsProcessed) / result.minSeconds;
+  }
+  return result;
+}
+} // namespace complex::Benchmark
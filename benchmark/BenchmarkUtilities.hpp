@@ -0,0 +1,114 @@
+#pragma once
+
+#include "complex/Common/Types.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace complex::Benchmark
+{
+/**
+ * @brief Timing and memory measurements of a single benchmark case.
+ */
+struct BenchmarkResult
+{
+  std::string name;
+  std::string category;
+  usize problemSize = 0;
+  usize itemsProcessed = 0;
+  std::vector<float64> iterationSeconds;
+  float64 minSeconds = 0.0;
+  float64 meanSeconds = 0.0;
+  float64 maxSeconds = 0.0;
+  float64 itemsPerSecond = 0.0;
+  // Peak resident set size while the case ran, or over the life time of the process where
+  // the peak cannot be reset
+  usize peakResidentBytes = 0;
+  // Growth of the peak resident set size over its value when the case started
+  usize peakMemoryDeltaBytes = 0;
+  bool valid = true;
+  std::string message;
+
+  /**
+   * @brief Serializes the result to json.
+   * @return nlohmann::json
+   */
+  nlohmann::json toJson() const;
+};
+
+/**
+ * @brief Returns the peak resident set size of the process in bytes or 0 if the platform does
+ * not report it. The value covers the life time of the process unless ResetPeakMemoryUsage()
+ * succeeded, in which case it covers the time since the reset.
+ * @return usize
+ */
+usize GetPeakMemoryUsage();
+
+/**
+ * @brief Resets the peak resident set size to the current resident set size. Only Linux
+ * supports this. Returns false if the peak could not be reset.
+ * @return bool
+ */
+bool ResetPeakMemoryUsage();
+
+/**
+ * @brief Returns a json object describing the machine and build the benchmarks were run with.
+ * @return nlohmann::json
+ */
+nlohmann::json GetSystemInfo();
+
+/**
+ * @brief Simple wall clock timer.
+ */
+class Timer
+{
+public:
+  using ClockType = std::chrono::steady_clock;
+
+  Timer()
+  : m_Start(ClockType::now())
+  {
+  }
+
+  /**
+   * @brief Returns the number of seconds since the timer was constructed.
+   * @return float64
+   */
+  float64 elapsedSeconds() const
+  {
+    return std::chrono::duration<float64>(ClockType::now() - m_Start).count();
+  }
+
+private:
+  ClockType::time_point m_Start;
+};
+
+/**
+ * @brief A single timed iteration. The setup function runs outside of the timed region and
+ * prepares the inputs for the timed function. Both return an empty string on success and an
+ * error message otherwise.
+ */
+struct BenchmarkIteration
+{
+  std::function<std::string()> setup;
+  std::function<std::string()> run;
+};
+
+/**
+ * @brief Runs the benchmark the given number of times and summarizes the timings. The
+ * iteration factory is called once per repetition so every timed run starts from fresh inputs.
+ * @param name
+ * @param category
+ * @param problemSize
+ * @param itemsProcessed
+ * @param repetitions
+ * @param createIteration
+ * @return BenchmarkResult
+ */
+BenchmarkResult RunBenchmark(const std::string& name, const std::string& category, usize problemSize, usize itemsProcessed, usize repetitions,
+                             const std::function<BenchmarkIteration()>& createIteration);
+} // namespace complex::Benchmark
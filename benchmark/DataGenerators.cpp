@@ -0,0 +1,292 @@
+#include "DataGenerators.hpp"
+
+#include "complex/Common/Constants.hpp"
+#include "complex/Common/Range.hpp"
+#include "complex/Common/StringLiteral.hpp"
+#include "complex/DataStructure/AttributeMatrix.hpp"
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/DataGroup.hpp"
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/DataStructure/Geometry/ImageGeom.hpp"
+#include "complex/DataStructure/Geometry/TriangleGeom.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace complex;
+
+namespace
+{
+constexpr StringLiteral k_DataContainer = "DataContainer";
+constexpr StringLiteral k_CellData = "CellData";
+constexpr StringLiteral k_FeatureIds = "FeatureIds";
+constexpr StringLiteral k_CellFeatureData = "CellFeatureData";
+constexpr StringLiteral k_Phases = "Phases";
+constexpr StringLiteral k_CellEnsembleData = "CellEnsembleData";
+constexpr StringLiteral k_CrystalStructures = "CrystalStructures";
+
+constexpr uint32 k_CubicHigh = 1;
+constexpr uint32 k_UnknownCrystalStructure = 999;
+
+/**
+ * @brief Small stateless hash used to generate per voxel noise so that the parallel
+ * generators produce the same values independent of how the work is split.
+ */
+uint64 SplitMix64(uint64 value)
+{
+  value += 0x9E3779B97F4A7C15ULL;
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+  return value ^ (value >> 31);
+}
+
+float32 UnitNoise(uint64 seed, uint64 index)
+{
+  return static_cast<float32>(SplitMix64(seed ^ SplitMix64(index)) >> 40) / static_cast<float32>(1ULL << 24) * 2.0f - 1.0f;
+}
+
+template <typename T>
+DataArray<T>* CreateArray(DataStructure& dataStructure, const std::string& name, const std::vector<usize>& tupleShape, const std::vector<usize>& componentShape, DataObject::IdType parentId)
+{
+  auto store = std::make_shared<DataStore<T>>(tupleShape, componentShape, std::nullopt);
+  return DataArray<T>::Create(dataStructure, name, store, parentId);
+}
+} // namespace
+
+namespace complex::Benchmark
+{
+// -----------------------------------------------------------------------------
+LabelVolumePaths CreateLabelVolume(DataStructure& dataStructure, const SizeVec3& dims, usize grainSize, uint64 seed)
+{
+  grainSize = std::max<usize>(grainSize, 1);
+  const usize xPoints = dims[0];
+  const usize yPoints = dims[1];
+  const usize zPoints = dims[2];
+
+  auto* imageGeom = ImageGeom::Create(dataStructure, k_DataContainer);
+  imageGeom->setDimensions(dims);
+  imageGeom->setSpacing(1.0f, 1.0f, 1.0f);
+  imageGeom->setOrigin(0.0f, 0.0f, 0.0f);
+
+  const std::vector<usize> cellTupleShape = {zPoints, yPoints, xPoints};
+  auto* cellData = AttributeMatrix::Create(dataStructure, k_CellData, cellTupleShape, imageGeom->getId());
+  imageGeom->setCellData(*cellData);
+  auto* featureIdsArray = CreateArray<int32>(dataStructure, k_FeatureIds, cellTupleShape, {1}, cellData->getId());
+
+  // One jittered seed per coarse grid cell
+  const usize xSeeds = (xPoints + grainSize - 1) / grainSize;
+  const usize ySeeds = (yPoints + grainSize - 1) / grainSize;
+  const usize zSeeds = (zPoints + grainSize - 1) / grainSize;
+  const usize numFeatures = xSeeds * ySeeds * zSeeds;
+
+  std::mt19937_64 generator(seed);
+  std::uniform_real_distribution<float32> jitter(0.0f, static_cast<float32>(grainSize));
+  std::vector<float32> seedCoords(numFeatures * 3);
+  for(usize z = 0; z < zSeeds; z++)
+  {
+    for(usize y = 0; y < ySeeds; y++)
+    {
+      for(usize x = 0; x < xSeeds; x++)
+      {
+        const usize seedIndex = (z * ySeeds + y) * xSeeds + x;
+        seedCoords[seedIndex * 3 + 0] = static_cast<float32>(x * grainSize) + jitter(generator);
+        seedCoords[seedIndex * 3 + 1] = static_cast<float32>(y * grainSize) + jitter(generator);
+        seedCoords[seedIndex * 3 + 2] = static_cast<float32>(z * grainSize) + jitter(generator);
+      }
+    }
+  }
+
+  // Each voxel takes the id of the nearest seed. Seeds are at most one coarse cell away
+  // from the coarse cell holding the voxel so only the 27 surrounding seeds are searched.
+  auto& featureIds = featureIdsArray->getDataStoreRef();
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, zPoints);
+  dataAlg.execute([&](const Range& range) {
+    for(usize z = range.min(); z < range.max(); z++)
+    {
+      const int64 zCell = static_cast<int64>(z / grainSize);
+      for(usize y = 0; y < yPoints; y++)
+      {
+        const int64 yCell = static_cast<int64>(y / grainSize);
+        for(usize x = 0; x < xPoints; x++)
+        {
+          const int64 xCell = static_cast<int64>(x / grainSize);
+          float32 bestDistance = std::numeric_limits<float32>::max();
+          usize bestSeed = 0;
+          for(int64 k = std::max<int64>(zCell - 1, 0); k <= std::min<int64>(zCell + 1, static_cast<int64>(zSeeds) - 1); k++)
+          {
+            for(int64 j = std::max<int64>(yCell - 1, 0); j <= std::min<int64>(yCell + 1, static_cast<int64>(ySeeds) - 1); j++)
+            {
+              for(int64 i = std::max<int64>(xCell - 1, 0); i <= std::min<int64>(xCell + 1, static_cast<int64>(xSeeds) - 1); i++)
+              {
+                const usize seedIndex = (static_cast<usize>(k) * ySeeds + static_cast<usize>(j)) * xSeeds + static_cast<usize>(i);
+                const float32 dx = seedCoords[seedIndex * 3 + 0] - (static_cast<float32>(x) + 0.5f);
+                const float32 dy = seedCoords[seedIndex * 3 + 1] - (static_cast<float32>(y) + 0.5f);
+                const float32 dz = seedCoords[seedIndex * 3 + 2] - (static_cast<float32>(z) + 0.5f);
+                const float32 distance = dx * dx + dy * dy + dz * dz;
+                if(distance < bestDistance)
+                {
+                  bestDistance = distance;
+                  bestSeed = seedIndex;
+                }
+              }
+            }
+          }
+          featureIds[(z * yPoints + y) * xPoints + x] = static_cast<int32>(bestSeed + 1);
+        }
+      }
+    }
+  });
+
+  auto* cellFeatureData = AttributeMatrix::Create(dataStructure, k_CellFeatureData, {numFeatures + 1}, imageGeom->getId());
+
+  LabelVolumePaths paths;
+  paths.geometryPath = DataPath({k_DataContainer});
+  paths.cellDataPath = paths.geometryPath.createChildPath(cellData->getName());
+  paths.featureIdsPath = paths.cellDataPath.createChildPath(featureIdsArray->getName());
+  paths.cellFeatureDataPath = paths.geometryPath.createChildPath(cellFeatureData->getName());
+  paths.numFeatures = numFeatures;
+  return paths;
+}
+
+// -----------------------------------------------------------------------------
+void AddQuaternionField(DataStructure& dataStructure, LabelVolumePaths& paths, float32 noise, uint64 seed)
+{
+  auto& cellData = dataStructure.getDataRefAs<AttributeMatrix>(paths.cellDataPath);
+  const auto& featureIds = dataStructure.getDataRefAs<Int32Array>(paths.featureIdsPath).getDataStoreRef();
+  const std::vector<usize> cellTupleShape = cellData.getShape();
+  const usize numCells = featureIds.getNumberOfTuples();
+
+  // Uniformly distributed random orientation for each feature (Shoemake's method)
+  std::mt19937_64 generator(seed);
+  std::uniform_real_distribution<float32> distribution(0.0f, 1.0f);
+  std::vector<float32> featureQuats((paths.numFeatures + 1) * 4, 0.0f);
+  for(usize featureId = 1; featureId <= paths.numFeatures; featureId++)
+  {
+    const float32 u1 = distribution(generator);
+    const float32 u2 = distribution(generator) * 2.0f * Constants::k_PiF;
+    const float32 u3 = distribution(generator) * 2.0f * Constants::k_PiF;
+    featureQuats[featureId * 4 + 0] = std::sqrt(1.0f - u1) * std::sin(u2);
+    featureQuats[featureId * 4 + 1] = std::sqrt(1.0f - u1) * std::cos(u2);
+    featureQuats[featureId * 4 + 2] = std::sqrt(u1) * std::sin(u3);
+    featureQuats[featureId * 4 + 3] = std::sqrt(u1) * std::cos(u3);
+  }
+
+  auto* quatsArray = CreateArray<float32>(dataStructure, "Quats", cellTupleShape, {4}, cellData.getId());
+  auto* phasesArray = CreateArray<int32>(dataStructure, k_Phases, cellTupleShape, {1}, cellData.getId());
+  auto& quats = quatsArray->getDataStoreRef();
+  auto& phases = phasesArray->getDataStoreRef();
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numCells);
+  dataAlg.execute([&](const Range& range) {
+    for(usize cellIndex = range.min(); cellIndex < range.max(); cellIndex++)
+    {
+      const usize featureId = static_cast<usize>(featureIds[cellIndex]);
+      float32 quat[4];
+      float32 norm = 0.0f;
+      for(usize c = 0; c < 4; c++)
+      {
+        quat[c] = featureQuats[featureId * 4 + c] + noise * UnitNoise(seed, cellIndex * 4 + c);
+        norm += quat[c] * quat[c];
+      }
+      norm = std::sqrt(norm);
+      for(usize c = 0; c < 4; c++)
+      {
+        quats[cellIndex * 4 + c] = quat[c] / norm;
+      }
+      phases[cellIndex] = 1;
+    }
+  });
+
+  const DataObject::IdType geometryId = dataStructure.getId(paths.geometryPath).value();
+  auto* cellEnsembleData = AttributeMatrix::Create(dataStructure, k_CellEnsembleData, {2}, geometryId);
+  auto* crystalStructuresArray = CreateArray<uint32>(dataStructure, k_CrystalStructures, {2}, {1}, cellEnsembleData->getId());
+  crystalStructuresArray->getDataStoreRef()[0] = k_UnknownCrystalStructure;
+  crystalStructuresArray->getDataStoreRef()[1] = k_CubicHigh;
+
+  paths.quatsPath = paths.cellDataPath.createChildPath(quatsArray->getName());
+  paths.phasesPath = paths.cellDataPath.createChildPath(phasesArray->getName());
+  paths.cellEnsembleDataPath = paths.geometryPath.createChildPath(cellEnsembleData->getName());
+  paths.crystalStructuresPath = paths.cellEnsembleDataPath.createChildPath(crystalStructuresArray->getName());
+}
+
+// -----------------------------------------------------------------------------
+TriangleMeshPaths CreateTriangleMesh(DataStructure& dataStructure, usize resolution, uint64 seed)
+{
+  using MeshIndexType = IGeometry::MeshIndexType;
+  constexpr float32 k_MajorRadius = 100.0f;
+  constexpr float32 k_MinorRadius = 40.0f;
+  constexpr float32 k_NoiseRadius = 0.5f;
+
+  resolution = std::max<usize>(resolution, 3);
+  const usize numVertices = resolution * resolution;
+  const usize numTriangles = 2 * numVertices;
+
+  auto* geometryGroup = DataGroup::Create(dataStructure, "TriangleDataContainer");
+  auto* triangleGeom = TriangleGeom::Create(dataStructure, "TriangleGeometry", geometryGroup->getId());
+  auto* verticesArray = CreateArray<float32>(dataStructure, "SharedVertexList", {numVertices}, {3}, triangleGeom->getId());
+  auto* facesArray = CreateArray<MeshIndexType>(dataStructure, "SharedTriList", {numTriangles}, {3}, triangleGeom->getId());
+  triangleGeom->setVertices(*verticesArray);
+  triangleGeom->setFaceList(*facesArray);
+
+  auto& vertices = verticesArray->getDataStoreRef();
+  auto& faces = facesArray->getDataStoreRef();
+  const float32 step = 2.0f * Constants::k_PiF / static_cast<float32>(resolution);
+  for(usize u = 0; u < resolution; u++)
+  {
+    const float32 theta = static_cast<float32>(u) * step;
+    for(usize v = 0; v < resolution; v++)
+    {
+      const float32 phi = static_cast<float32>(v) * step;
+      const usize vertexIndex = u * resolution + v;
+      const float32 minorRadius = k_MinorRadius + k_NoiseRadius * UnitNoise(seed, vertexIndex);
+      const float32 ringRadius = k_MajorRadius + minorRadius * std::cos(phi);
+      vertices[vertexIndex * 3 + 0] = ringRadius * std::cos(theta);
+      vertices[vertexIndex * 3 + 1] = ringRadius * std::sin(theta);
+      vertices[vertexIndex * 3 + 2] = minorRadius * std::sin(phi);
+
+      // Split the quad between this vertex and its (wrapped) neighbors into two triangles
+      const MeshIndexType v0 = vertexIndex;
+      const MeshIndexType v1 = ((u + 1) % resolution) * resolution + v;
+      const MeshIndexType v2 = ((u + 1) % resolution) * resolution + (v + 1) % resolution;
+      const MeshIndexType v3 = u * resolution + (v + 1) % resolution;
+      const usize faceIndex = vertexIndex * 2;
+      faces[faceIndex * 3 + 0] = v0;
+      faces[faceIndex * 3 + 1] = v1;
+      faces[faceIndex * 3 + 2] = v2;
+      faces[faceIndex * 3 + 3] = v0;
+      faces[faceIndex * 3 + 4] = v2;
+      faces[faceIndex * 3 + 5] = v3;
+    }
+  }
+
+  auto* vertexData = AttributeMatrix::Create(dataStructure, "VertexData", {numVertices}, triangleGeom->getId());
+  triangleGeom->setVertexAttributeMatrix(*vertexData);
+  auto* nodeTypesArray = CreateArray<int8>(dataStructure, "NodeTypes", {numVertices}, {1}, vertexData->getId());
+  nodeTypesArray->fill(2);
+
+  auto* faceData = AttributeMatrix::Create(dataStructure, "FaceData", {numTriangles}, triangleGeom->getId());
+  triangleGeom->setFaceAttributeMatrix(*faceData);
+  auto* faceLabelsArray = CreateArray<int32>(dataStructure, "FaceLabels", {numTriangles}, {2}, faceData->getId());
+  auto& faceLabels = faceLabelsArray->getDataStoreRef();
+  for(usize faceIndex = 0; faceIndex < numTriangles; faceIndex++)
+  {
+    faceLabels[faceIndex * 2 + 0] = 1;
+    faceLabels[faceIndex * 2 + 1] = -1;
+  }
+
+  TriangleMeshPaths paths;
+  paths.geometryPath = DataPath({geometryGroup->getName(), triangleGeom->getName()});
+  paths.vertexDataPath = paths.geometryPath.createChildPath(vertexData->getName());
+  paths.nodeTypesPath = paths.vertexDataPath.createChildPath(nodeTypesArray->getName());
+  paths.faceDataPath = paths.geometryPath.createChildPath(faceData->getName());
+  paths.faceLabelsPath = paths.faceDataPath.createChildPath(faceLabelsArray->getName());
+  return paths;
+}
+} // namespace complex::Benchmark
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "complex/Common/Array.hpp"
+#include "complex/Common/Types.hpp"
+#include "complex/DataStructure/DataPath.hpp"
+#include "complex/DataStructure/DataStructure.hpp"
+
+namespace complex::Benchmark
+{
+/**
+ * @brief Paths of the objects created by CreateLabelVolume() and AddQuaternionField().
+ */
+struct LabelVolumePaths
+{
+  DataPath geometryPath;
+  DataPath cellDataPath;
+  DataPath featureIdsPath;
+  DataPath cellFeatureDataPath;
+  DataPath quatsPath;
+  DataPath phasesPath;
+  DataPath cellEnsembleDataPath;
+  DataPath crystalStructuresPath;
+  usize numFeatures = 0;
+};
+
+/**
+ * @brief Paths of the objects created by CreateTriangleMesh().
+ */
+struct TriangleMeshPaths
+{
+  DataPath geometryPath;
+  DataPath vertexDataPath;
+  DataPath nodeTypesPath;
+  DataPath faceDataPath;
+  DataPath faceLabelsPath;
+};
+
+/**
+ * @brief Creates an ImageGeom of the given dimensions holding an int32 "FeatureIds" cell array.
+ * The volume is split into a Voronoi tessellation whose seeds are jittered on a regular grid with a
+ * spacing of grainSize voxels, so the label volume looks like a grain structure with roughly
+ * (dims / grainSize)^3 features. An empty "CellFeatureData" AttributeMatrix sized to the number of
+ * features + 1 is created next to the cell data. The same seed always produces the same volume.
+ * @param dataStructure
+ * @param dims
+ * @param grainSize
+ * @param seed
+ * @return LabelVolumePaths
+ */
+LabelVolumePaths CreateLabelVolume(DataStructure& dataStructure, const SizeVec3& dims, usize grainSize, uint64 seed);
+
+/**
+ * @brief Adds a float32 "Quats" cell array, an int32 "Phases" cell array and a cubic "CrystalStructures"
+ * ensemble array to a volume created by CreateLabelVolume(). Every feature is given a random orientation
+ * and each voxel receives that orientation with per component noise of the given magnitude.
+ * @param dataStructure
+ * @param paths
+ * @param noise
+ * @param seed
+ */
+void AddQuaternionField(DataStructure& dataStructure, LabelVolumePaths& paths, float32 noise, uint64 seed);
+
+/**
+ * @brief Creates a closed torus shaped TriangleGeom with resolution x resolution quads, each split into
+ * two triangles, so the mesh holds resolution^2 vertices and 2 * resolution^2 triangles. The vertices are
+ * displaced radially by random noise. An int8 "NodeTypes" vertex array and an int32 "FaceLabels" face
+ * array with 2 components are created alongside the geometry.
+ * @param dataStructure
+ * @param resolution
+ * @param seed
+ * @return TriangleMeshPaths
+ */
+TriangleMeshPaths CreateTriangleMesh(DataStructure& dataStructure, usize resolution, uint64 seed);
+} // namespace complex::Benchmark
@@ -0,0 +1,449 @@
+#include "BenchmarkUtilities.hpp"
+#include "DataGenerators.hpp"
+
+#include "complex/Common/Result.hpp"
+#include "complex/Common/Uuid.hpp"
+#include "complex/Core/Application.hpp"
+#include "complex/DataStructure/IO/HDF5/DataStructureReader.hpp"
+#include "complex/DataStructure/IO/HDF5/DataStructureWriter.hpp"
+#include "complex/Filter/Arguments.hpp"
+#include "complex/Filter/FilterList.hpp"
+#include "complex/Filter/IFilter.hpp"
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace complex;
+using namespace complex::Benchmark;
+
+namespace
+{
+inline constexpr int k_InvalidArgumentError = -120;
+inline constexpr int k_OutputFileError = -121;
+
+inline constexpr StringLiteral k_HelpParamLong = "--help";
+inline constexpr StringLiteral k_SizeParamLong = "--size";
+inline constexpr StringLiteral k_GrainSizeParamLong = "--grain-size";
+inline constexpr StringLiteral k_RepetitionsParamLong = "--repetitions";
+inline constexpr StringLiteral k_FilterParamLong = "--filter";
+inline constexpr StringLiteral k_OutputParamLong = "--output";
+inline constexpr StringLiteral k_SeedParamLong = "--seed";
+
+const Uuid k_FindNeighborsId = *Uuid::FromString("7177e88c-c3ab-4169-abe9-1fdaff20e598");
+const Uuid k_QuickSurfaceMeshId = *Uuid::FromString("13dd00bd-ad49-4e04-95eb-3267952fd6e5");
+const Uuid k_TriangleNormalId = *Uuid::FromString("8133d419-1919-4dbf-a5bf-1c97282ba63f");
+const Uuid k_LaplacianSmoothingId = *Uuid::FromString("0dd0916e-9305-4a7b-98cf-a6cfb97cb501");
+const Uuid k_EBSDSegmentFeaturesId = *Uuid::FromString("1810c2c7-63e3-41db-b204-a5821e6271c0");
+
+/**
+ * @brief Command line options of the benchmark executable.
+ */
+struct BenchmarkOptions
+{
+  std::vector<usize> sizes = {64, 128};
+  usize grainSize = 8;
+  usize repetitions = 3;
+  uint64 seed = 5489;
+  std::string filter;
+  fs::path outputPath;
+};
+
+void LoadApp()
+{
+  auto app = Application::GetOrCreateInstance();
+  // Try loading plugins from the directory that the executable is in.
+  // This is the default for developer build trees and CI build trees
+  fs::path appPath = app->getCurrentDir();
+  app->loadPlugins(appPath, false);
+
+  // For non-windows platforms we need to look in the actual 'Plugins'
+  // directory which is up one directory from the executable.
+#ifndef _MSC_VER
+  {
+    appPath = appPath.parent_path();
+    if(fs::exists(appPath / "Plugins"))
+    {
+      appPath = appPath / "Plugins";
+      app->loadPlugins(appPath, false);
+    }
+  }
+#endif
+}
+
+void PrintHelp()
+{
+  std::cout << "complex_benchmarks times filters and the .dream3d IO on synthetic data and writes the results as json.\n\n";
+  std::cout << fmt::format("  {} <n>[,<n>...]    Edge length(s) of the generated cubic volumes (default 64,128)\n", k_SizeParamLong.view());
+  std::cout << fmt::format("  {} <n>      Approximate edge length of the generated grains in voxels (default 8)\n", k_GrainSizeParamLong.view());
+  std::cout << fmt::format("  {} <n>     Number of timed runs of each benchmark (default 3)\n", k_RepetitionsParamLong.view());
+  std::cout << fmt::format("  {} <text>        Only run benchmarks whose name contains the text\n", k_FilterParamLong.view());
+  std::cout << fmt::format("  {} <file>        Write the json results to the file instead of stdout\n", k_OutputParamLong.view());
+  std::cout << fmt::format("  {} <n>             Seed of the synthetic data generators (default 5489)\n", k_SeedParamLong.view());
+}
+
+std::optional<usize> ParseUnsigned(const std::string& text)
+{
+  try
+  {
+    usize count = 0;
+    const unsigned long long value = std::stoull(text, &count);
+    if(count != text.size())
+    {
+      return {};
+    }
+    return static_cast<usize>(value);
+  } catch(const std::exception&)
+  {
+    return {};
+  }
+}
+
+Result<BenchmarkOptions> ParseArguments(int argc, char* argv[])
+{
+  BenchmarkOptions options;
+  for(int i = 1; i < argc; i++)
+  {
+    const std::string argument = argv[i];
+    if(argument == k_HelpParamLong)
+    {
+      continue;
+    }
+    if(i + 1 >= argc)
+    {
+      return MakeErrorResult<BenchmarkOptions>(k_InvalidArgumentError, fmt::format("Missing value for argument '{}'", argument));
+    }
+    const std::string value = argv[++i];
+    if(argument == k_SizeParamLong)
+    {
+      options.sizes.clear();
+      std::string::size_type start = 0;
+      while(start <= value.size())
+      {
+        const std::string::size_type end = std::min(value.find(',', start), value.size());
+        std::optional<usize> size = ParseUnsigned(value.substr(start, end - start));
+        if(!size.has_value() || *size == 0)
+        {
+          return MakeErrorResult<BenchmarkOptions>(k_InvalidArgumentError, fmt::format("Invalid size list '{}'", value));
+        }
+        options.sizes.push_back(*size);
+        start = end + 1;
+      }
+      std::sort(options.sizes.begin(), options.sizes.end());
+    }
+    else if(argument == k_GrainSizeParamLong || argument == k_RepetitionsParamLong || argument == k_SeedParamLong)
+    {
+      std::optional<usize> number = ParseUnsigned(value);
+      if(!number.has_value())
+      {
+        return MakeErrorResult<BenchmarkOptions>(k_InvalidArgumentError, fmt::format("Invalid value '{}' for argument '{}'", value, argument));
+      }
+      if(argument == k_GrainSizeParamLong)
+      {
+        options.grainSize = *number;
+      }
+      else if(argument == k_RepetitionsParamLong)
+      {
+        options.repetitions = *number;
+      }
+      else
+      {
+        options.seed = *number;
+      }
+    }
+    else if(argument == k_FilterParamLong)
+    {
+      options.filter = value;
+    }
+    else if(argument == k_OutputParamLong)
+    {
+      options.outputPath = value;
+    }
+    else
+    {
+      return MakeErrorResult<BenchmarkOptions>(k_InvalidArgumentError, fmt::format("Unknown argument '{}'", argument));
+    }
+  }
+  return {std::move(options)};
+}
+
+std::string ErrorsToString(const Result<>& result)
+{
+  std::string message;
+  for(const auto& error : result.errors())
+  {
+    message += fmt::format("[{}] {} ", error.code, error.message);
+  }
+  return message;
+}
+
+/**
+ * @brief Executes the filter through IFilter::execute, the same entry point the pipeline uses.
+ */
+std::string ExecuteFilter(const Uuid& filterId, DataStructure& dataStructure, const Arguments& args)
+{
+  auto* filterList = Application::Instance()->getFilterList();
+  IFilter::UniquePointer filter = filterList->createFilter(filterId);
+  if(filter == nullptr)
+  {
+    return fmt::format("Filter '{}' is not available. Make sure the plugin providing it was built and loaded", filterId.str());
+  }
+  IFilter::ExecuteResult executeResult = filter->execute(dataStructure, args);
+  if(executeResult.result.invalid())
+  {
+    return fmt::format("{} failed: {}", filter->humanName(), ErrorsToString(executeResult.result));
+  }
+  return {};
+}
+
+/**
+ * @brief Registers every benchmark case and runs the ones selected by the options.
+ */
+class BenchmarkSuite
+{
+public:
+  explicit BenchmarkSuite(const BenchmarkOptions& options)
+  : m_Options(options)
+  {
+  }
+
+  std::vector<BenchmarkResult> run()
+  {
+    for(usize size : m_Options.sizes)
+    {
+      runVolumeBenchmarks(size);
+      runMeshBenchmarks(size);
+      runIOBenchmarks(size);
+    }
+    return std::move(m_Results);
+  }
+
+private:
+  bool isSelected(const std::string& name) const
+  {
+    return m_Options.filter.empty() || name.find(m_Options.filter) != std::string::npos;
+  }
+
+  void add(const std::string& name, const std::string& category, usize size, usize items, const std::function<BenchmarkIteration()>& createIteration)
+  {
+    if(!isSelected(name))
+    {
+      return;
+    }
+    std::cerr << fmt::format("Running {} [size {}]...", name, size) << std::flush;
+    BenchmarkResult result = RunBenchmark(name, category, size, items, m_Options.repetitions, createIteration);
+    if(result.valid)
+    {
+      std::cerr << fmt::format(" {:.4f} s\n", result.minSeconds);
+    }
+    else
+    {
+      std::cerr << fmt::format(" FAILED: {}\n", result.message);
+    }
+    m_Results.push_back(std::move(result));
+  }
+
+  LabelVolumePaths createVolume(DataStructure& dataStructure, usize size, bool withOrientations) const
+  {
+    LabelVolumePaths paths = CreateLabelVolume(dataStructure, SizeVec3{size, size, size}, m_Options.grainSize, m_Options.seed);
+    if(withOrientations)
+    {
+      AddQuaternionField(dataStructure, paths, 0.01f, m_Options.seed);
+    }
+    return paths;
+  }
+
+  void runVolumeBenchmarks(usize size)
+  {
+    const usize numVoxels = size * size * size;
+
+    add("FindNeighbors", "filter", size, numVoxels, [this, size]() {
+      auto dataStructure = std::make_shared<DataStructure>();
+      auto args = std::make_shared<Arguments>();
+      BenchmarkIteration iteration;
+      iteration.setup = [this, size, dataStructure, args]() {
+        LabelVolumePaths paths = createVolume(*dataStructure, size, false);
+        args->insertOrAssign("image_geometry", std::make_any<DataPath>(paths.geometryPath));
+        args->insertOrAssign("feature_ids", std::make_any<DataPath>(paths.featureIdsPath));
+        args->insertOrAssign("cell_feature_arrays", std::make_any<DataPath>(paths.cellFeatureDataPath));
+        args->insertOrAssign("store_boundary_cells", std::make_any<bool>(true));
+        args->insertOrAssign("store_surface_features", std::make_any<bool>(true));
+        return std::string{};
+      };
+      iteration.run = [dataStructure, args]() { return ExecuteFilter(k_FindNeighborsId, *dataStructure, *args); };
+      return iteration;
+    });
+
+    add("QuickSurfaceMesh", "filter", size, numVoxels, [this, size]() {
+      auto dataStructure = std::make_shared<DataStructure>();
+      auto args = std::make_shared<Arguments>();
+      BenchmarkIteration iteration;
+      iteration.setup = [this, size, dataStructure, args]() {
+        LabelVolumePaths paths = createVolume(*dataStructure, size, false);
+        args->insertOrAssign("grid_geometry_data_path", std::make_any<DataPath>(paths.geometryPath));
+        args->insertOrAssign("feature_ids_path", std::make_any<DataPath>(paths.featureIdsPath));
+        args->insertOrAssign("triangle_geometry_name", std::make_any<DataPath>(DataPath({"SurfaceMesh"})));
+        return std::string{};
+      };
+      iteration.run = [dataStructure, args]() { return ExecuteFilter(k_QuickSurfaceMeshId, *dataStructure, *args); };
+      return iteration;
+    });
+
+    add("EBSDSegmentFeatures", "filter", size, numVoxels, [this, size]() {
+      auto dataStructure = std::make_shared<DataStructure>();
+      auto args = std::make_shared<Arguments>();
+      BenchmarkIteration iteration;
+      iteration.setup = [this, size, dataStructure, args]() {
+        LabelVolumePaths paths = createVolume(*dataStructure, size, true);
+        args->insertOrAssign("grid_geometry_path", std::make_any<DataPath>(paths.geometryPath));
+        args->insertOrAssign("misorientation_tolerance", std::make_any<float32>(5.0f));
+        args->insertOrAssign("quats_array_path", std::make_any<DataPath>(paths.quatsPath));
+        args->insertOrAssign("cell_phases_array_path", std::make_any<DataPath>(paths.phasesPath));
+        args->insertOrAssign("crystal_structures_array_path", std::make_any<DataPath>(paths.crystalStructuresPath));
+        args->insertOrAssign("feature_ids_array_name", std::make_any<std::string>("SegmentedFeatureIds"));
+        args->insertOrAssign("cell_feature_attribute_matrix_name", std::make_any<std::string>("SegmentedFeatureData"));
+        return std::string{};
+      };
+      iteration.run = [dataStructure, args]() { return ExecuteFilter(k_EBSDSegmentFeaturesId, *dataStructure, *args); };
+      return iteration;
+    });
+  }
+
+  void runMeshBenchmarks(usize size)
+  {
+    // Scale the mesh so that the number of triangles is comparable to the number of surface
+    // triangles QuickSurfaceMesh produces for a volume of the same edge length
+    const usize resolution = size * 8;
+    const usize numTriangles = 2 * resolution * resolution;
+
+    add("TriangleNormals", "filter", size, numTriangles, [this, resolution]() {
+      auto dataStructure = std::make_shared<DataStructure>();
+      auto args = std::make_shared<Arguments>();
+      BenchmarkIteration iteration;
+      iteration.setup = [this, resolution, dataStructure, args]() {
+        TriangleMeshPaths paths = CreateTriangleMesh(*dataStructure, resolution, m_Options.seed);
+        args->insertOrAssign("tri_geometry_data_path", std::make_any<DataPath>(paths.geometryPath));
+        return std::string{};
+      };
+      iteration.run = [dataStructure, args]() { return ExecuteFilter(k_TriangleNormalId, *dataStructure, *args); };
+      return iteration;
+    });
+
+    add("LaplacianSmoothing", "filter", size, numTriangles, [this, resolution]() {
+      auto dataStructure = std::make_shared<DataStructure>();
+      auto args = std::make_shared<Arguments>();
+      BenchmarkIteration iteration;
+      iteration.setup = [this, resolution, dataStructure, args]() {
+        TriangleMeshPaths paths = CreateTriangleMesh(*dataStructure, resolution, m_Options.seed);
+        args->insertOrAssign("triangle_geometry_data_path", std::make_any<DataPath>(paths.geometryPath));
+        args->insertOrAssign("surface_mesh_node_type_array_path", std::make_any<DataPath>(paths.nodeTypesPath));
+        args->insertOrAssign("surface_mesh_face_labels_array_path", std::make_any<DataPath>(paths.faceLabelsPath));
+        args->insertOrAssign("iteration_steps", std::make_any<int32>(10));
+        return std::string{};
+      };
+      iteration.run = [dataStructure, args]() { return ExecuteFilter(k_LaplacianSmoothingId, *dataStructure, *args); };
+      return iteration;
+    });
+  }
+
+  void runIOBenchmarks(usize size)
+  {
+    const usize numVoxels = size * size * size;
+    const fs::path filePath = fs::temp_directory_path() / fmt::format("complex_benchmark_{}.dream3d", size);
+
+    add("DataStructureWriter", "io", size, numVoxels, [this, size, filePath]() {
+      auto dataStructure = std::make_shared<DataStructure>();
+      BenchmarkIteration iteration;
+      iteration.setup = [this, size, dataStructure]() {
+        createVolume(*dataStructure, size, true);
+        return std::string{};
+      };
+      iteration.run = [dataStructure, filePath]() {
+        Result<> result = HDF5::DataStructureWriter::WriteFile(*dataStructure, filePath);
+        return result.invalid() ? ErrorsToString(result) : std::string{};
+      };
+      return iteration;
+    });
+
+    add("DataStructureReader", "io", size, numVoxels, [this, size, filePath]() {
+      BenchmarkIteration iteration;
+      iteration.setup = [this, size, filePath]() {
+        DataStructure dataStructure;
+        createVolume(dataStructure, size, true);
+        Result<> result = HDF5::DataStructureWriter::WriteFile(dataStructure, filePath);
+        return result.invalid() ? ErrorsToString(result) : std::string{};
+      };
+      iteration.run = [filePath]() {
+        Result<DataStructure> result = HDF5::DataStructureReader::ReadFile(filePath);
+        return result.invalid() ? ErrorsToString(ConvertResult(std::move(result))) : std::string{};
+      };
+      return iteration;
+    });
+
+    std::error_code errorCode;
+    fs::remove(filePath, errorCode);
+  }
+
+  const BenchmarkOptions& m_Options;
+  std::vector<BenchmarkResult> m_Results;
+};
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  for(int i = 1; i < argc; i++)
+  {
+    if(std::string(argv[i]) == k_HelpParamLong)
+    {
+      PrintHelp();
+      return 0;
+    }
+  }
+
+  Result<BenchmarkOptions> optionsResult = ParseArguments(argc, argv);
+  if(optionsResult.invalid())
+  {
+    std::cerr << ErrorsToString(ConvertResult(std::move(optionsResult))) << "\n";
+    PrintHelp();
+    return k_InvalidArgumentError;
+  }
+  const BenchmarkOptions options = std::move(optionsResult.value());
+
+  LoadApp();
+
+  BenchmarkSuite suite(options);
+  std::vector<BenchmarkResult> results = suite.run();
+
+  nlohmann::json json;
+  json["system"] = GetSystemInfo();
+  json["options"] = {{"sizes", options.sizes}, {"grain_size", options.grainSize}, {"repetitions", options.repetitions}, {"seed", options.seed}};
+  nlohmann::json benchmarks = nlohmann::json::array();
+  for(const auto& result : results)
+  {
+    benchmarks.push_back(result.toJson());
+  }
+  json["benchmarks"] = benchmarks;
+
+  if(options.outputPath.empty())
+  {
+    std::cout << json.dump(2) << "\n";
+    return 0;
+  }
+
+  std::ofstream outputFile(options.outputPath, std::ios_base::out | std::ios_base::trunc);
+  if(!outputFile.is_open())
+  {
+    std::cerr << fmt::format("Could not open output file '{}'\n", options.outputPath.string());
+    return k_OutputFileError;
+  }
+  outputFile << json.dump(2) << "\n";
+  return 0;
+}
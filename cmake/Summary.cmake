@@ -62,6 +62,7 @@ message(STATUS "* reproc++ (${reproc_VERSION}) ${reproc++_DIR}")
 
 message(STATUS "* -------------- Complex Configuration Options -------------------------------------")
 message(STATUS "* COMPLEX_BUILD_TESTS: ${COMPLEX_BUILD_TESTS}")
+message(STATUS "* COMPLEX_BUILD_BENCHMARKS: ${COMPLEX_BUILD_BENCHMARKS}")
 message(STATUS "* COMPLEX_ENABLE_MULTICORE: ${COMPLEX_ENABLE_MULTICORE}")
 message(STATUS "* COMPLEX_ENABLE_COMPRESSORS: ${COMPLEX_ENABLE_COMPRESSORS}")
 message(STATUS "* COMPLEX_DOWNLOAD_TEST_FILES: ${COMPLEX_DOWNLOAD_TEST_FILES}")
@@ -31,9 +31,17 @@
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/Utilities/DataGroupUtilities.hpp"
 #include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 #include "complex/Utilities/StringUtilities.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <optional>
 #include <regex>
+#include <type_traits>
 
 using namespace complex;
 
@@ -50,36 +58,634 @@ struct CreateCalculatorArrayFunctor
   }
 };
 
-struct CopyArrayFunctor
+constexpr usize k_KernelBlockSize = 1024;
+
+enum class KernelOpCode : uint8
+{
+  Push,
+  Add,
+  Subtract,
+  Multiply,
+  Divide,
+  Pow,
+  Root,
+  Log,
+  Negate,
+  Abs,
+  Sqrt,
+  Exp,
+  Ln,
+  Log10,
+  Floor,
+  Ceil,
+  Sin,
+  Cos,
+  Tan,
+  ASin,
+  ACos,
+  ATan
+};
+
+struct KernelInstruction
+{
+  KernelOpCode OpCode = KernelOpCode::Push;
+  usize LeafIndex = 0;
+};
+
+/**
+ * @brief A value that is pushed onto the evaluation stack. Leaves either hold a numeric constant or
+ * read every Stride-th value of an input array starting at Offset. Single tuple arrays are broadcast.
+ */
+struct KernelLeaf
+{
+  const IDataArray* Array = nullptr;
+  float64 Value = 0.0;
+  usize Stride = 1;
+  usize Offset = 0;
+  usize NumValues = 1;
+  bool Broadcast = true;
+};
+
+/**
+ * @brief The RPN expression compiled into a flat program that is evaluated one block of values at a time,
+ * so only StackDepth blocks of scratch memory are needed per thread regardless of the array sizes.
+ */
+struct CompiledExpression
+{
+  std::vector<KernelInstruction> Program;
+  std::vector<KernelLeaf> Leaves;
+  usize StackDepth = 0;
+  usize NumValues = 0;
+  bool IsNumber = true;
+};
+
+template <typename AccumT>
+using BlockLoader = std::function<void(usize, usize, AccumT*)>;
+
+const std::map<std::string, KernelOpCode>& GetKernelOpCodes()
+{
+  static const std::map<std::string, KernelOpCode> opCodes = {
+      {"+", KernelOpCode::Add},
+      {"-", KernelOpCode::Subtract},
+      {"*", KernelOpCode::Multiply},
+      {"/", KernelOpCode::Divide},
+      {"^", KernelOpCode::Pow},
+      {"root", KernelOpCode::Root},
+      {"log", KernelOpCode::Log},
+      {"abs", KernelOpCode::Abs},
+      {"sqrt", KernelOpCode::Sqrt},
+      {"exp", KernelOpCode::Exp},
+      {"ln", KernelOpCode::Ln},
+      {"log10", KernelOpCode::Log10},
+      {"floor", KernelOpCode::Floor},
+      {"ceil", KernelOpCode::Ceil},
+      {"sin", KernelOpCode::Sin},
+      {"cos", KernelOpCode::Cos},
+      {"tan", KernelOpCode::Tan},
+      {"asin", KernelOpCode::ASin},
+      {"acos", KernelOpCode::ACos},
+      {"atan", KernelOpCode::ATan},
+  };
+  return opCodes;
+}
+
+bool IsBinaryOpCode(KernelOpCode opCode)
+{
+  switch(opCode)
+  {
+  case KernelOpCode::Add:
+  case KernelOpCode::Subtract:
+  case KernelOpCode::Multiply:
+  case KernelOpCode::Divide:
+  case KernelOpCode::Pow:
+  case KernelOpCode::Root:
+  case KernelOpCode::Log:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// -----------------------------------------------------------------------------
+Result<CompiledExpression> CompileExpression(const ArrayCalculatorParser& parser, const DataStructure& dataStructure, const std::vector<CalculatorItem::Pointer>& rpn)
+{
+  struct StackEntry
+  {
+    bool IsArray = false;
+    usize NumValues = 1;
+  };
+
+  const auto invalidEquation = MakeErrorResult<CompiledExpression>(static_cast<int>(CalculatorItem::ErrorCode::InvalidEquation), "The chosen infix equation is not a valid equation.");
+
+  CompiledExpression expression;
+  std::vector<StackEntry> stack;
+  for(const auto& rpnItem : rpn)
+  {
+    if(auto calcArray = std::dynamic_pointer_cast<ICalculatorArray>(rpnItem); calcArray != nullptr)
+    {
+      KernelLeaf leaf;
+      if(auto source = parser.getArraySource(calcArray.get()); source.has_value())
+      {
+        const auto* dataArray = dataStructure.getDataAs<IDataArray>(source->ArrayPath);
+        if(dataArray == nullptr)
+        {
+          return MakeErrorResult<CompiledExpression>(static_cast<int>(CalculatorItem::ErrorCode::InvalidArrayName), fmt::format("The array '{}' could not be found", source->ArrayPath.toString()));
+        }
+        const usize numComponents = dataArray->getNumberOfComponents();
+        leaf.Array = dataArray;
+        leaf.Stride = source->Component.has_value() ? numComponents : 1;
+        leaf.Offset = source->Component.value_or(0);
+        leaf.NumValues = source->Component.has_value() ? dataArray->getNumberOfTuples() : dataArray->getSize();
+        leaf.Broadcast = dataArray->getNumberOfTuples() <= 1;
+      }
+      else
+      {
+        const Float64Array* numberArray = calcArray->getArray();
+        leaf.Value = (numberArray != nullptr && numberArray->getSize() > 0) ? numberArray->at(0) : 0.0;
+      }
+      expression.Program.push_back({KernelOpCode::Push, expression.Leaves.size()});
+      expression.Leaves.push_back(leaf);
+      stack.push_back({calcArray->getType() == ICalculatorArray::Array, leaf.NumValues});
+      expression.StackDepth = std::max(expression.StackDepth, stack.size());
+      continue;
+    }
+
+    auto rpnOperator = std::dynamic_pointer_cast<CalculatorOperator>(rpnItem);
+    if(rpnOperator == nullptr)
+    {
+      return invalidEquation;
+    }
+    KernelOpCode opCode = KernelOpCode::Negate;
+    if(std::dynamic_pointer_cast<NegativeOperator>(rpnOperator) == nullptr)
+    {
+      const auto& opCodes = GetKernelOpCodes();
+      auto opCodeIter = opCodes.find(rpnOperator->getInfixToken());
+      if(opCodeIter == opCodes.end())
+      {
+        return MakeErrorResult<CompiledExpression>(static_cast<int>(CalculatorItem::ErrorCode::UnrecognizedItem), fmt::format("The operator '{}' can not be evaluated", rpnOperator->getInfixToken()));
+      }
+      opCode = opCodeIter->second;
+    }
+
+    if(IsBinaryOpCode(opCode))
+    {
+      if(stack.size() < 2)
+      {
+        return invalidEquation;
+      }
+      // The result takes the shape of the right hand operand unless only the left hand operand is an array
+      StackEntry right = stack.back();
+      stack.pop_back();
+      StackEntry left = stack.back();
+      stack.back() = {left.IsArray || right.IsArray, right.IsArray ? right.NumValues : left.NumValues};
+    }
+    else if(stack.empty())
+    {
+      return invalidEquation;
+    }
+    expression.Program.push_back({opCode, 0});
+  }
+
+  if(stack.size() != 1)
+  {
+    return invalidEquation;
+  }
+  expression.IsNumber = !stack.back().IsArray;
+  expression.NumValues = stack.back().NumValues;
+
+  for(const auto& leaf : expression.Leaves)
+  {
+    if(!leaf.Broadcast && leaf.NumValues < expression.NumValues)
+    {
+      return MakeErrorResult<CompiledExpression>(static_cast<int>(CalculatorItem::ErrorCode::InconsistentTuples), "Attribute Array symbols in the infix expression have mismatching number of tuples");
+    }
+  }
+
+  return {std::move(expression)};
+}
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief The smallest and largest value a term of an expression can take.
+ */
+struct ValueInterval
+{
+  float64 Min = 0.0;
+  float64 Max = 0.0;
+};
+
+// Integers with a magnitude below 2^53 are exact in float64, and so is every sum, difference or product below it
+constexpr float64 k_ExactIntegerLimit = 9007199254740992.0;
+
+struct IntegerIntervalFunctor
 {
   template <typename T>
-  void operator()(DataStructure& dataStructure, const DataPath& calculatedArrayPath, const Float64Array* inputArray)
+  std::optional<ValueInterval> operator()()
   {
-    if(nullptr != inputArray)
+    if constexpr(std::is_integral_v<T> && !std::is_same_v<T, bool>)
     {
-      DataArray<T>& convertedArray = dataStructure.getDataRefAs<DataArray<T>>(calculatedArrayPath);
+      return ValueInterval{static_cast<float64>(std::numeric_limits<T>::lowest()), static_cast<float64>(std::numeric_limits<T>::max())};
+    }
+    return {};
+  }
+};
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Returns true if evaluating the expression in 64 bit integer arithmetic writes exactly the values the float64
+ * evaluation writes. Only addition, subtraction, multiplication, negation and absolute values of integer arrays and
+ * integral constants are allowed. The range of every intermediate value is bounded from the input types and must stay
+ * below 2^53, where float64 arithmetic on integers is exact, and the final range must fit the output type so that
+ * neither path converts an out of range value.
+ */
+bool CanEvaluateAsInteger(const CompiledExpression& expression, DataType outputType)
+{
+  const std::optional<ValueInterval> outputInterval = ExecuteDataFunction(IntegerIntervalFunctor{}, outputType);
+  if(!outputInterval.has_value())
+  {
+    return false;
+  }
 
-      int count = inputArray->getSize();
-      for(int i = 0; i < count; i++)
+  std::vector<ValueInterval> stack;
+  for(const auto& instruction : expression.Program)
+  {
+    switch(instruction.OpCode)
+    {
+    case KernelOpCode::Push: {
+      const KernelLeaf& leaf = expression.Leaves[instruction.LeafIndex];
+      if(leaf.Array == nullptr)
+      {
+        if(std::trunc(leaf.Value) != leaf.Value)
+        {
+          return false;
+        }
+        stack.push_back({leaf.Value, leaf.Value});
+        break;
+      }
+      const std::optional<ValueInterval> arrayInterval = ExecuteDataFunction(IntegerIntervalFunctor{}, leaf.Array->getDataType());
+      if(!arrayInterval.has_value())
+      {
+        return false;
+      }
+      stack.push_back(*arrayInterval);
+      break;
+    }
+    case KernelOpCode::Add:
+    case KernelOpCode::Subtract:
+    case KernelOpCode::Multiply: {
+      const ValueInterval rhs = stack.back();
+      stack.pop_back();
+      const ValueInterval lhs = stack.back();
+      if(instruction.OpCode == KernelOpCode::Add)
       {
-        double val = (*inputArray)[i];
-        convertedArray[i] = val;
+        stack.back() = {lhs.Min + rhs.Min, lhs.Max + rhs.Max};
       }
+      else if(instruction.OpCode == KernelOpCode::Subtract)
+      {
+        stack.back() = {lhs.Min - rhs.Max, lhs.Max - rhs.Min};
+      }
+      else
+      {
+        const std::array<float64, 4> products = {lhs.Min * rhs.Min, lhs.Min * rhs.Max, lhs.Max * rhs.Min, lhs.Max * rhs.Max};
+        stack.back() = {*std::min_element(products.begin(), products.end()), *std::max_element(products.begin(), products.end())};
+      }
+      break;
+    }
+    case KernelOpCode::Negate:
+      stack.back() = {-stack.back().Max, -stack.back().Min};
+      break;
+    case KernelOpCode::Abs: {
+      const ValueInterval value = stack.back();
+      if(value.Max <= 0.0)
+      {
+        stack.back() = {-value.Max, -value.Min};
+      }
+      else if(value.Min < 0.0)
+      {
+        stack.back() = {0.0, std::max(-value.Min, value.Max)};
+      }
+      break;
+    }
+    default:
+      return false;
+    }
+    if(stack.back().Min <= -k_ExactIntegerLimit || stack.back().Max >= k_ExactIntegerLimit)
+    {
+      return false;
     }
   }
+  return stack.size() == 1 && stack.back().Min >= outputInterval->Min && stack.back().Max <= outputInterval->Max;
+}
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Returns true if the output and every input array are float32, in which case the expression is evaluated
+ * natively in float32. Every operation then rounds to float32 rather than only the final value, so results can
+ * differ from the float64 evaluation in the last bits of the float32 output.
+ */
+bool CanEvaluateAsFloat32(const CompiledExpression& expression, DataType outputType)
+{
+  if(outputType != DataType::float32)
+  {
+    return false;
+  }
+  bool hasArray = false;
+  for(const auto& leaf : expression.Leaves)
+  {
+    if(leaf.Array == nullptr)
+    {
+      continue;
+    }
+    if(leaf.Array->getDataType() != DataType::float32)
+    {
+      return false;
+    }
+    hasArray = true;
+  }
+  return hasArray;
+}
+
+// -----------------------------------------------------------------------------
+template <typename AccumT>
+struct CreateBlockLoaderFunctor
+{
+  template <typename T>
+  BlockLoader<AccumT> operator()(const KernelLeaf& leaf)
+  {
+    const auto& dataStore = dynamic_cast<const DataArray<T>*>(leaf.Array)->getDataStoreRef();
+    const usize stride = leaf.Stride;
+    const usize offset = leaf.Offset;
+    if(leaf.Broadcast)
+    {
+      const AccumT value = dataStore.getSize() > offset ? static_cast<AccumT>(dataStore.getValue(offset)) : AccumT{0};
+      return [value](usize start, usize count, AccumT* buffer) { std::fill_n(buffer, count, value); };
+    }
+    if(const auto* inMemoryStore = dynamic_cast<const DataStore<T>*>(&dataStore); inMemoryStore != nullptr)
+    {
+      const T* data = inMemoryStore->data() + offset;
+      return [data, stride](usize start, usize count, AccumT* buffer) {
+        const T* source = data + start * stride;
+        for(usize i = 0; i < count; i++)
+        {
+          buffer[i] = static_cast<AccumT>(source[i * stride]);
+        }
+      };
+    }
+    return [&dataStore, stride, offset](usize start, usize count, AccumT* buffer) {
+      for(usize i = 0; i < count; i++)
+      {
+        buffer[i] = static_cast<AccumT>(dataStore.getValue((start + i) * stride + offset));
+      }
+    };
+  }
 };
 
-struct InitializeArrayFunctor
+// -----------------------------------------------------------------------------
+template <typename AccumT>
+void ApplyBinaryOperator(KernelOpCode opCode, AccumT* lhs, const AccumT* rhs, usize count)
+{
+  switch(opCode)
+  {
+  case KernelOpCode::Add:
+    for(usize i = 0; i < count; i++)
+    {
+      lhs[i] = lhs[i] + rhs[i];
+    }
+    return;
+  case KernelOpCode::Subtract:
+    for(usize i = 0; i < count; i++)
+    {
+      lhs[i] = lhs[i] - rhs[i];
+    }
+    return;
+  case KernelOpCode::Multiply:
+    for(usize i = 0; i < count; i++)
+    {
+      lhs[i] = lhs[i] * rhs[i];
+    }
+    return;
+  default:
+    break;
+  }
+
+  if constexpr(std::is_floating_point_v<AccumT>)
+  {
+    switch(opCode)
+    {
+    case KernelOpCode::Divide:
+      for(usize i = 0; i < count; i++)
+      {
+        lhs[i] = lhs[i] / rhs[i];
+      }
+      break;
+    case KernelOpCode::Pow:
+      for(usize i = 0; i < count; i++)
+      {
+        lhs[i] = std::pow(lhs[i], rhs[i]);
+      }
+      break;
+    case KernelOpCode::Root:
+      for(usize i = 0; i < count; i++)
+      {
+        lhs[i] = rhs[i] == 0 ? std::numeric_limits<AccumT>::infinity() : std::pow(lhs[i], 1 / rhs[i]);
+      }
+      break;
+    case KernelOpCode::Log:
+      for(usize i = 0; i < count; i++)
+      {
+        lhs[i] = std::log(rhs[i]) / std::log(lhs[i]);
+      }
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+template <typename AccumT>
+void ApplyUnaryOperator(KernelOpCode opCode, CalculatorParameter::AngleUnits units, AccumT* values, usize count)
+{
+  if(opCode == KernelOpCode::Negate)
+  {
+    for(usize i = 0; i < count; i++)
+    {
+      values[i] = -values[i];
+    }
+    return;
+  }
+  if(opCode == KernelOpCode::Abs)
+  {
+    for(usize i = 0; i < count; i++)
+    {
+      if constexpr(std::is_floating_point_v<AccumT>)
+      {
+        values[i] = std::fabs(values[i]);
+      }
+      else
+      {
+        values[i] = values[i] < 0 ? -values[i] : values[i];
+      }
+    }
+    return;
+  }
+
+  if constexpr(std::is_floating_point_v<AccumT>)
+  {
+    const bool useDegrees = units == CalculatorParameter::AngleUnits::Degrees;
+    if(useDegrees && (opCode == KernelOpCode::Sin || opCode == KernelOpCode::Cos || opCode == KernelOpCode::Tan))
+    {
+      for(usize i = 0; i < count; i++)
+      {
+        values[i] = static_cast<AccumT>(CalculatorOperator::toRadians(values[i]));
+      }
+    }
+
+    switch(opCode)
+    {
+    case KernelOpCode::Sqrt:
+      std::transform(values, values + count, values, [](AccumT value) { return std::sqrt(value); });
+      break;
+    case KernelOpCode::Exp:
+      std::transform(values, values + count, values, [](AccumT value) { return std::exp(value); });
+      break;
+    case KernelOpCode::Ln:
+      std::transform(values, values + count, values, [](AccumT value) { return std::log(value); });
+      break;
+    case KernelOpCode::Log10:
+      std::transform(values, values + count, values, [](AccumT value) { return std::log10(value); });
+      break;
+    case KernelOpCode::Floor:
+      std::transform(values, values + count, values, [](AccumT value) { return std::floor(value); });
+      break;
+    case KernelOpCode::Ceil:
+      std::transform(values, values + count, values, [](AccumT value) { return std::ceil(value); });
+      break;
+    case KernelOpCode::Sin:
+      std::transform(values, values + count, values, [](AccumT value) { return std::sin(value); });
+      break;
+    case KernelOpCode::Cos:
+      std::transform(values, values + count, values, [](AccumT value) { return std::cos(value); });
+      break;
+    case KernelOpCode::Tan:
+      std::transform(values, values + count, values, [](AccumT value) { return std::tan(value); });
+      break;
+    case KernelOpCode::ASin:
+      std::transform(values, values + count, values, [](AccumT value) { return std::asin(value); });
+      break;
+    case KernelOpCode::ACos:
+      std::transform(values, values + count, values, [](AccumT value) { return std::acos(value); });
+      break;
+    case KernelOpCode::ATan:
+      std::transform(values, values + count, values, [](AccumT value) { return std::atan(value); });
+      break;
+    default:
+      break;
+    }
+
+    if(useDegrees && (opCode == KernelOpCode::ASin || opCode == KernelOpCode::ACos || opCode == KernelOpCode::ATan))
+    {
+      for(usize i = 0; i < count; i++)
+      {
+        values[i] = static_cast<AccumT>(CalculatorOperator::toDegrees(values[i]));
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Evaluates count values of the expression starting at value index start. The registers hold one block per
+ * stack entry and the result is left in the first block.
+ */
+template <typename AccumT>
+const AccumT* EvaluateBlock(const CompiledExpression& expression, const std::vector<BlockLoader<AccumT>>& loaders, CalculatorParameter::AngleUnits units, usize start, usize count,
+                            std::vector<AccumT>& registers)
+{
+  usize depth = 0;
+  for(const auto& instruction : expression.Program)
+  {
+    if(instruction.OpCode == KernelOpCode::Push)
+    {
+      loaders[instruction.LeafIndex](start, count, registers.data() + depth * k_KernelBlockSize);
+      depth++;
+    }
+    else if(IsBinaryOpCode(instruction.OpCode))
+    {
+      depth--;
+      ApplyBinaryOperator(instruction.OpCode, registers.data() + (depth - 1) * k_KernelBlockSize, registers.data() + depth * k_KernelBlockSize, count);
+    }
+    else
+    {
+      ApplyUnaryOperator(instruction.OpCode, units, registers.data() + (depth - 1) * k_KernelBlockSize, count);
+    }
+  }
+  return registers.data();
+}
+
+// -----------------------------------------------------------------------------
+template <typename AccumT>
+struct EvaluateExpressionFunctor
 {
   template <typename T>
-  void operator()(DataStructure& dataStructure, const DataPath& calculatedArrayPath, const Float64Array* inputArray)
+  void operator()(DataStructure& dataStructure, const DataPath& calculatedArrayPath, const CompiledExpression& expression, CalculatorParameter::AngleUnits units, bool fillWithNumber,
+                  const std::atomic_bool& shouldCancel)
   {
-    DataArray<T>& convertedArray = dataStructure.getDataRefAs<DataArray<T>>(calculatedArrayPath);
-    if(nullptr != inputArray && inputArray->getSize() == 1)
+    auto& outputArray = dataStructure.getDataRefAs<DataArray<T>>(calculatedArrayPath);
+    auto& outputStore = outputArray.getDataStoreRef();
+
+    IParallelAlgorithm::AlgorithmArrays algArrays = {&outputArray};
+    std::vector<BlockLoader<AccumT>> loaders;
+    for(const auto& leaf : expression.Leaves)
     {
-      const T& initializeValue = inputArray->at(0);
-      convertedArray.fill(initializeValue);
+      if(leaf.Array == nullptr)
+      {
+        const AccumT value = static_cast<AccumT>(leaf.Value);
+        loaders.push_back([value](usize start, usize count, AccumT* buffer) { std::fill_n(buffer, count, value); });
+        continue;
+      }
+      algArrays.push_back(leaf.Array);
+      loaders.push_back(ExecuteDataFunction(CreateBlockLoaderFunctor<AccumT>{}, leaf.Array->getDataType(), leaf));
     }
+
+    if(fillWithNumber)
+    {
+      std::vector<AccumT> registers(expression.StackDepth * k_KernelBlockSize);
+      outputStore.fill(static_cast<T>(*EvaluateBlock(expression, loaders, units, 0, 1, registers)));
+      return;
+    }
+
+    const usize numValues = std::min(expression.NumValues, outputStore.getSize());
+    auto* inMemoryStore = dynamic_cast<DataStore<T>*>(&outputStore);
+    T* outputData = inMemoryStore != nullptr ? inMemoryStore->data() : nullptr;
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, (numValues + k_KernelBlockSize - 1) / k_KernelBlockSize);
+    dataAlg.setParallelizationEnabled(IParallelAlgorithm::CheckArraysInMemory(algArrays));
+    dataAlg.execute([&](const Range& range) {
+      std::vector<AccumT> registers(expression.StackDepth * k_KernelBlockSize);
+      for(usize block = range.min(); block < range.max(); block++)
+      {
+        if(shouldCancel)
+        {
+          return;
+        }
+        const usize start = block * k_KernelBlockSize;
+        const usize count = std::min(k_KernelBlockSize, numValues - start);
+        const AccumT* result = EvaluateBlock(expression, loaders, units, start, count, registers);
+        if(outputData != nullptr)
+        {
+          std::transform(result, result + count, outputData + start, [](AccumT value) { return static_cast<T>(value); });
+        }
+        else
+        {
+          for(usize i = 0; i < count; i++)
+          {
+            outputStore.setValue(start + i, static_cast<T>(result[i]));
+          }
+        }
+      }
+    });
   }
 };
 } // namespace
@@ -132,65 +738,29 @@ Result<> ArrayCalculator::operator()()
     return results;
   }
 
-  // Execute the RPN expression
-  DataPath temporaryCalculatedArrayPath = DataPath({m_InputValues->CalculatedArray.getTargetName() + "_TEMPORARY"});
-  std::stack<ICalculatorArray::Pointer> executionStack;
-  int totalItems = rpn.size();
-  for(int rpnCount = 0; rpnCount < totalItems; rpnCount++)
+  // Compile the RPN expression into a single kernel that is evaluated block by block without temporary arrays
+  m_MessageHandler({IFilter::Message::Type::Info, fmt::format("Computing {} Operators", rpn.size())});
+  Result<CompiledExpression> compileResults = CompileExpression(parser, m_DataStructure, rpn);
+  if(compileResults.invalid())
   {
-    m_MessageHandler({IFilter::Message::Type::Info, "Computing Operator " + StringUtilities::number(rpnCount + 1) + "/" + StringUtilities::number(totalItems)});
-
-    CalculatorItem::Pointer rpnItem = rpn[rpnCount];
-    ICalculatorArray::Pointer calcArray = std::dynamic_pointer_cast<ICalculatorArray>(rpnItem);
-    if(nullptr != calcArray)
-    {
-      // This is an array
-      executionStack.push(calcArray);
-    }
-    else
-    {
-      // This is an operator
-      CalculatorOperator::Pointer rpnOperator = std::dynamic_pointer_cast<CalculatorOperator>(rpnItem);
-
-      rpnOperator->calculate(parser.m_TemporaryDataStructure, m_InputValues->Units, temporaryCalculatedArrayPath, executionStack);
-    }
-
-    if(getCancel())
-    {
-      return results;
-    }
+    results.errors() = compileResults.errors();
+    return results;
   }
+  const CompiledExpression& expression = compileResults.value();
 
-  // Grab the result from the stack
-  ICalculatorArray::Pointer arrayItem = ICalculatorArray::NullPointer();
-  if(executionStack.size() != 1)
+  const DataType outputType = ConvertNumericTypeToDataType(m_InputValues->ScalarType);
+  const bool fillWithNumber = expression.IsNumber && m_DataStructure.getDataAs<AttributeMatrix>(m_InputValues->CalculatedArray.getParent()) != nullptr;
+  if(CanEvaluateAsInteger(expression, outputType))
   {
-    results.errors().push_back(Error{static_cast<int>(CalculatorItem::ErrorCode::InvalidEquation), "The chosen infix equation is not a valid equation."});
-    return results;
+    ExecuteDataFunction(EvaluateExpressionFunctor<int64>{}, outputType, m_DataStructure, m_InputValues->CalculatedArray, expression, m_InputValues->Units, fillWithNumber, m_ShouldCancel);
   }
-  if(!executionStack.empty())
+  else if(CanEvaluateAsFloat32(expression, outputType))
   {
-    arrayItem = executionStack.top();
-    executionStack.pop();
-  }
-
-  if(arrayItem != ICalculatorArray::NullPointer())
-  {
-    const Float64Array* resultArray = arrayItem->getArray();
-    if(arrayItem->isNumber() && m_DataStructure.getDataAs<AttributeMatrix>(m_InputValues->CalculatedArray.getParent()) != nullptr)
-    {
-      ExecuteDataFunction(InitializeArrayFunctor{}, ConvertNumericTypeToDataType(m_InputValues->ScalarType), m_DataStructure, m_InputValues->CalculatedArray, resultArray);
-    }
-    else
-    {
-      ExecuteDataFunction(CopyArrayFunctor{}, ConvertNumericTypeToDataType(m_InputValues->ScalarType), m_DataStructure, m_InputValues->CalculatedArray, resultArray);
-    }
+    ExecuteDataFunction(EvaluateExpressionFunctor<float32>{}, outputType, m_DataStructure, m_InputValues->CalculatedArray, expression, m_InputValues->Units, fillWithNumber, m_ShouldCancel);
   }
   else
   {
-    results.errors().push_back(Error{static_cast<int>(CalculatorItem::ErrorCode::UnexpectedOutput), "Unexpected output item from chosen infix expression; the output item must be an array\n"
-                                                                                                    "Please contact the DREAM.3D developers for more information"});
-    return results;
+    ExecuteDataFunction(EvaluateExpressionFunctor<float64>{}, outputType, m_DataStructure, m_InputValues->CalculatedArray, expression, m_InputValues->Units, fillWithNumber, m_ShouldCancel);
   }
 
   return {};
@@ -417,8 +987,17 @@ Result<> ArrayCalculatorParser::parseIndexOperator(std::string token, std::vecto
 
   parsedInfix.pop_back();
 
-  Float64Array* reducedArray = calcArray->reduceToOneComponent(index, !m_IsPreflight);
-  CalculatorItem::Pointer itemPtr = CalculatorArray<float64>::New(m_TemporaryDataStructure, reducedArray, ICalculatorArray::Array, !m_IsPreflight);
+  // Single component arrays are not reduced since the selected component is the whole array
+  CalculatorItem::Pointer itemPtr = calcArray;
+  if(Float64Array* reducedArray = calcArray->reduceToOneComponent(index, false); reducedArray != nullptr)
+  {
+    itemPtr = CalculatorArray<float64>::New(m_TemporaryDataStructure, reducedArray, ICalculatorArray::Array, false);
+    if(auto sourceIter = m_ArraySources.find(calcArray.get()); sourceIter != m_ArraySources.end())
+    {
+      m_ArraySources[itemPtr.get()] = {sourceIter->second.ArrayPath, static_cast<usize>(index)};
+      m_ArraySources.erase(sourceIter);
+    }
+  }
   parsedInfix.push_back(itemPtr);
 
   std::string ss = fmt::format("Item '{}' in the infix expression is the name of an array in the selected Attribute Matrix, but it is currently being used as an indexing operator", token);
@@ -485,11 +1064,24 @@ Result<> ArrayCalculatorParser::parseArray(std::string token, std::vector<Calcul
     return MakeErrorResult(static_cast<int>(CalculatorItem::ErrorCode::InconsistentTuples), ss);
   }
 
-  CalculatorItem::Pointer itemPtr = ExecuteDataFunction(CreateCalculatorArrayFunctor{}, dataArray->getDataType(), m_TemporaryDataStructure, !m_IsPreflight, dataArray);
+  // The values are read directly from the input array when the expression is evaluated, so only the shape is recorded here
+  CalculatorItem::Pointer itemPtr = ExecuteDataFunction(CreateCalculatorArrayFunctor{}, dataArray->getDataType(), m_TemporaryDataStructure, false, dataArray);
+  m_ArraySources[itemPtr.get()] = {tokenArrayPath, std::nullopt};
   parsedInfix.push_back(itemPtr);
   return {};
 }
 
+// -----------------------------------------------------------------------------
+std::optional<ArrayCalculatorParser::ArraySource> ArrayCalculatorParser::getArraySource(const CalculatorItem* item) const
+{
+  auto sourceIter = m_ArraySources.find(item);
+  if(sourceIter == m_ArraySources.end())
+  {
+    return {};
+  }
+  return sourceIter->second;
+}
+
 // -----------------------------------------------------------------------------
 Result<> ArrayCalculatorParser::checkForAmbiguousArrayName(std::string strItem, std::string warningMsg)
 {
@@ -10,6 +10,9 @@
 #include "complex/Parameters/CalculatorParameter.hpp"
 #include "complex/Parameters/NumericTypeParameter.hpp"
 
+#include <map>
+#include <optional>
+
 namespace complex
 {
 
@@ -27,12 +30,29 @@ class COMPLEXCORE_EXPORT ArrayCalculatorParser
 public:
   using ParsedEquation = std::vector<CalculatorItem::Pointer>;
 
+  /**
+   * @brief Identifies the input array, and optionally the single component of it, that a parsed array item reads from.
+   */
+  struct ArraySource
+  {
+    DataPath ArrayPath;
+    std::optional<usize> Component;
+  };
+
   ArrayCalculatorParser(const DataStructure& dataStruct, const DataPath& selectedGroupPath, const std::string& infixEquation, bool isPreflight);
 
   Result<> parseInfixEquation(ParsedEquation& parsedInfix);
 
   static Result<ArrayCalculatorParser::ParsedEquation> ToRPN(const std::string& unparsedInfixExpression, std::vector<CalculatorItem::Pointer> infixEquation);
 
+  /**
+   * @brief Returns the input array that the parsed item reads its values from or an empty optional if the item is a numeric value.
+   * Parsed array items only carry the shape of their input array so that no temporary copies of the input data are made.
+   * @param item
+   * @return std::optional<ArraySource>
+   */
+  std::optional<ArraySource> getArraySource(const CalculatorItem* item) const;
+
   friend class ArrayCalculator;
 
 protected:
@@ -52,6 +72,7 @@ private:
   bool m_IsPreflight;
 
   std::map<std::string, std::shared_ptr<CalculatorItem>> m_SymbolMap;
+  std::map<const CalculatorItem*, ArraySource> m_ArraySources;
 
   void createSymbolMap();
 };
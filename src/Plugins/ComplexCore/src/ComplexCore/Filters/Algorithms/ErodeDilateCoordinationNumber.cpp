@@ -13,7 +13,7 @@ struct DataArrayCopyTupleFunctor
   void operator()(IDataArray& outputIDataArray, size_t sourceIndex, size_t targetIndex)
   {
     using DataArrayType = DataArray<T>;
-    DataArrayType outputArray = dynamic_cast<DataArrayType&>(outputIDataArray);
+    auto& outputArray = dynamic_cast<DataArrayType&>(outputIDataArray);
     outputArray.copyTuple(sourceIndex, targetIndex);
   }
 };
@@ -3,6 +3,7 @@
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/DataStructure/Geometry/ImageGeom.hpp"
+#include "complex/Utilities/ImageSlabStreamer.hpp"
 
 using namespace complex;
 
@@ -27,88 +28,101 @@ const std::atomic_bool& ErodeDilateMask::getCancel()
 // -----------------------------------------------------------------------------
 Result<> ErodeDilateMask::operator()()
 {
-
   auto& mask = m_DataStructure.getDataRefAs<BoolArray>(m_InputValues->MaskArrayPath);
-  const size_t totalPoints = mask.getNumberOfTuples();
-
-  std::vector<bool> maskCopy(totalPoints, false);
-
   const auto& selectedImageGeom = m_DataStructure.getDataRefAs<ImageGeom>(m_InputValues->InputImageGeometry);
 
-  SizeVec3 udims = selectedImageGeom.getDimensions();
-
-  std::array<int64, 3> dims = {
-      static_cast<int64>(udims[0]),
-      static_cast<int64>(udims[1]),
-      static_cast<int64>(udims[2]),
-  };
-
-  std::array<int64, 6> neighpoints = {-dims[0] * dims[1], -dims[0], -1, 1, dims[0], dims[0] * dims[1]};
-
-  for(int32_t iteration = 0; iteration < m_InputValues->NumIterations; iteration++)
-  {
-    for(size_t j = 0; j < totalPoints; j++)
-    {
-      maskCopy[j] = mask[j];
-    }
-    for(int64 zIndex = 0; zIndex < dims[2]; zIndex++)
-    {
-      const int64 zStride = dims[0] * dims[1] * zIndex;
-      for(int64 yIndex = 0; yIndex < dims[1]; yIndex++)
-      {
-        const int64 yStride = dims[0] * yIndex;
-        for(int64 xIndex = 0; xIndex < dims[0]; xIndex++)
+  // Every iteration only reads the direct neighbors, so each Z slab is processed on its own.
+  // Voxels within HaloWidth layers of a slab edge may be wrong after the last iteration, but
+  // only the slab layers are written back.
+  ImageSlabStreamer streamer(selectedImageGeom, m_InputValues->HaloWidth);
+  streamer.setSlabDepth(m_InputValues->SlabDepth);
+  const usize maskIndex = streamer.addOutput(mask.getDataStoreRef(), true);
+
+  std::vector<bool> maskCopy;
+  return streamer.execute(
+      [this, maskIndex, &maskCopy](ImageSlabStreamer::Slab& slab) -> Result<> {
+        auto& slabMask = slab.getBuffer<bool>(maskIndex);
+        const SizeVec3 udims = slab.getDimensions();
+
+        std::array<int64, 3> dims = {
+            static_cast<int64>(udims[0]),
+            static_cast<int64>(udims[1]),
+            static_cast<int64>(udims[2]),
+        };
+        const usize totalPoints = udims[0] * udims[1] * udims[2];
+        maskCopy.resize(totalPoints);
+
+        std::array<int64, 6> neighpoints = {-dims[0] * dims[1], -dims[0], -1, 1, dims[0], dims[0] * dims[1]};
+
+        for(int32_t iteration = 0; iteration < m_InputValues->NumIterations; iteration++)
         {
-          const int64 voxelIndex = zStride + yStride + xIndex;
-
-          if(!mask[voxelIndex])
+          if(m_ShouldCancel)
           {
-            for(int32_t neighPointIdx = 0; neighPointIdx < 6; neighPointIdx++)
+            return {};
+          }
+          for(size_t j = 0; j < totalPoints; j++)
+          {
+            maskCopy[j] = slabMask[j];
+          }
+          for(int64 zIndex = 0; zIndex < dims[2]; zIndex++)
+          {
+            const int64 zStride = dims[0] * dims[1] * zIndex;
+            for(int64 yIndex = 0; yIndex < dims[1]; yIndex++)
             {
-              const int64 neighpoint = voxelIndex + neighpoints[neighPointIdx];
-              if(neighPointIdx == 0 && (zIndex == 0 || !m_InputValues->ZDirOn))
-              {
-                continue;
-              }
-              if(neighPointIdx == 5 && (zIndex == (dims[2] - 1) || !m_InputValues->ZDirOn))
-              {
-                continue;
-              }
-              if(neighPointIdx == 1 && (yIndex == 0 || !m_InputValues->YDirOn))
+              const int64 yStride = dims[0] * yIndex;
+              for(int64 xIndex = 0; xIndex < dims[0]; xIndex++)
               {
-                continue;
-              }
-              if(neighPointIdx == 4 && (yIndex == (dims[1] - 1) || !m_InputValues->YDirOn))
-              {
-                continue;
-              }
-              if(neighPointIdx == 2 && (xIndex == 0 || !m_InputValues->XDirOn))
-              {
-                continue;
-              }
-              if(neighPointIdx == 3 && (xIndex == (dims[0] - 1) || !m_InputValues->XDirOn))
-              {
-                continue;
-              }
-
-              if(m_InputValues->Operation == k_DilateIndex && mask[neighpoint])
-              {
-                maskCopy[voxelIndex] = true;
-              }
-              if(m_InputValues->Operation == k_ErodeIndex && mask[neighpoint])
-              {
-                maskCopy[neighpoint] = false;
+                const int64 voxelIndex = zStride + yStride + xIndex;
+
+                if(!slabMask[voxelIndex])
+                {
+                  for(int32_t neighPointIdx = 0; neighPointIdx < 6; neighPointIdx++)
+                  {
+                    const int64 neighpoint = voxelIndex + neighpoints[neighPointIdx];
+                    if(neighPointIdx == 0 && (zIndex == 0 || !m_InputValues->ZDirOn))
+                    {
+                      continue;
+                    }
+                    if(neighPointIdx == 5 && (zIndex == (dims[2] - 1) || !m_InputValues->ZDirOn))
+                    {
+                      continue;
+                    }
+                    if(neighPointIdx == 1 && (yIndex == 0 || !m_InputValues->YDirOn))
+                    {
+                      continue;
+                    }
+                    if(neighPointIdx == 4 && (yIndex == (dims[1] - 1) || !m_InputValues->YDirOn))
+                    {
+                      continue;
+                    }
+                    if(neighPointIdx == 2 && (xIndex == 0 || !m_InputValues->XDirOn))
+                    {
+                      continue;
+                    }
+                    if(neighPointIdx == 3 && (xIndex == (dims[0] - 1) || !m_InputValues->XDirOn))
+                    {
+                      continue;
+                    }
+
+                    if(m_InputValues->Operation == k_DilateIndex && slabMask[neighpoint])
+                    {
+                      maskCopy[voxelIndex] = true;
+                    }
+                    if(m_InputValues->Operation == k_ErodeIndex && slabMask[neighpoint])
+                    {
+                      maskCopy[neighpoint] = false;
+                    }
+                  }
+                }
               }
             }
           }
+          for(size_t j = 0; j < totalPoints; j++)
+          {
+            slabMask[j] = maskCopy[j];
+          }
         }
-      }
-    }
-    for(size_t j = 0; j < totalPoints; j++)
-    {
-      mask[j] = maskCopy[j];
-    }
-  }
-
-  return {};
+        return {};
+      },
+      m_ShouldCancel);
 }
@@ -32,6 +32,8 @@ struct COMPLEXCORE_EXPORT ErodeDilateMaskInputValues
   bool ZDirOn;
   DataPath MaskArrayPath;
   DataPath InputImageGeometry;
+  usize HaloWidth;
+  usize SlabDepth; // Number of Z layers processed at once, 0 picks the depth automatically
 };
 
 /**
@@ -19,7 +19,7 @@ struct FillBadDataUpdateTuplesFunctor
   {
     using DataArrayType = DataArray<T>;
 
-    DataArrayType outputArray = dynamic_cast<DataArrayType&>(outputIDataArray);
+    auto& outputArray = dynamic_cast<DataArrayType&>(outputIDataArray);
     size_t start = 0;
     size_t stop = outputArray.getNumberOfTuples();
     for(size_t tupleIndex = start; tupleIndex < stop; tupleIndex++)
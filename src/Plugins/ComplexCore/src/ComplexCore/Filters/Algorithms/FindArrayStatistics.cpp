@@ -6,20 +6,36 @@
 #include "complex/Utilities/Math/StatisticsCalculations.hpp"
 #include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
-#include <unordered_map>
+#include <algorithm>
+#include <type_traits>
 
 using namespace complex;
 
 namespace
 {
+/**
+ * @brief The FindArrayStatisticsByIndexImpl class computes all of the "by index" statistics with a single
+ * grouped reduction over the tuples instead of one pass over the tuples per feature range.
+ *
+ * 1. The tuples are split into one chunk per thread and each chunk accumulates the length, min, max and
+ *    sum of every feature into its own accumulator. The accumulators are merged per feature afterwards.
+ * 2. If any order statistic is requested, the values are grouped by feature id with a counting sort
+ *    (the per chunk lengths from step 1 become the write offsets) so each feature's values are contiguous.
+ * 3. Every feature is then finalized in parallel from its own values. Modes, medians and unique counts use a
+ *    histogram of the values for integer types with a small value range and an in place sort otherwise.
+ */
 template <typename T>
 class FindArrayStatisticsByIndexImpl
 {
 public:
+  // Avoid std::vector<bool> so that the grouped values can be sorted and shared between threads
+  using StorageType = std::conditional_t<std::is_same_v<T, bool>, uint8, T>;
+
   FindArrayStatisticsByIndexImpl(bool length, bool min, bool max, bool mean, bool mode, bool stdDeviation, bool summation, bool hist, float64 histmin, float64 histmax, bool histfullrange,
-                                 int32 numBins, bool modalBinRanges, const std::unique_ptr<MaskCompare>& mask, const Int32Array* featureIds, const DataArray<T>& source, BoolArray* featureHasDataArray,
-                                 UInt64Array* lengthArray, DataArray<T>* minArray, DataArray<T>* maxArray, Float32Array* meanArray, NeighborList<T>* modeArray, Float32Array* stdDevArray,
-                                 Float32Array* summationArray, UInt64Array* histArray, UInt64Array* mostPopulatedBinArray, NeighborList<float32>* modalBinRangesArray, FindArrayStatistics* filter)
+                                 int32 numBins, bool modalBinRanges, bool median, bool numUniqueValues, const std::unique_ptr<MaskCompare>& mask, const Int32Array* featureIds,
+                                 const DataArray<T>& source, BoolArray* featureHasDataArray, UInt64Array* lengthArray, DataArray<T>* minArray, DataArray<T>* maxArray, Float32Array* meanArray,
+                                 NeighborList<T>* modeArray, Float32Array* stdDevArray, Float32Array* summationArray, UInt64Array* histArray, UInt64Array* mostPopulatedBinArray,
+                                 NeighborList<float32>* modalBinRangesArray, Float32Array* medianArray, Int32Array* numUniqueValuesArray, bool runParallel, FindArrayStatistics* filter)
   : m_Length(length)
   , m_Min(min)
   , m_Max(max)
@@ -28,11 +44,13 @@ public:
   , m_StdDeviation(stdDeviation)
   , m_Summation(summation)
   , m_Histogram(hist)
+  , m_ModalBinRanges(modalBinRanges)
+  , m_Median(median)
+  , m_NumUniqueValues(numUniqueValues)
   , m_HistMin(histmin)
   , m_HistMax(histmax)
   , m_HistFullRange(histfullrange)
   , m_NumBins(numBins)
-  , m_ModalBinRanges(modalBinRanges)
   , m_Mask(mask)
   , m_FeatureIds(featureIds)
   , m_Source(source)
@@ -47,320 +65,459 @@ public:
   , m_HistArray(histArray)
   , m_MostPopulatedBinArray(mostPopulatedBinArray)
   , m_ModalBinRangesArray(modalBinRangesArray)
+  , m_MedianArray(medianArray)
+  , m_NumUniqueValuesArray(numUniqueValuesArray)
+  , m_RunParallel(runParallel)
   , m_Filter(filter)
   {
   }
 
-  virtual ~FindArrayStatisticsByIndexImpl() = default;
+  ~FindArrayStatisticsByIndexImpl() = default;
 
-  FindArrayStatisticsByIndexImpl(const FindArrayStatisticsByIndexImpl&) = default;           // Copy Constructor Not Implemented
+  FindArrayStatisticsByIndexImpl(const FindArrayStatisticsByIndexImpl&) = delete;            // Copy Constructor Not Implemented
   FindArrayStatisticsByIndexImpl(FindArrayStatisticsByIndexImpl&&) = delete;                 // Move Constructor Not Implemented
   FindArrayStatisticsByIndexImpl& operator=(const FindArrayStatisticsByIndexImpl&) = delete; // Copy Assignment Not Implemented
   FindArrayStatisticsByIndexImpl& operator=(FindArrayStatisticsByIndexImpl&&) = delete;      // Move Assignment Not Implemented
 
-  void compute(usize start, usize end) const
+  void compute(usize numFeatures)
   {
-    std::chrono::steady_clock::time_point initialTime = std::chrono::steady_clock::now();
-    auto now = std::chrono::steady_clock::now();
-    const usize milliDelay = 1000;
-
     const std::atomic_bool& shouldCancel = m_Filter->getCancel();
-    const usize numTuples = m_FeatureIds->getNumberOfTuples();
-    const usize numCurrentFeatures = end - start;
+    const auto& featureIds = m_FeatureIds->getDataStoreRef();
+    const auto& source = m_Source.getDataStoreRef();
+    const usize numTuples = featureIds.getNumberOfTuples();
 
-    std::vector<uint64> length(numCurrentFeatures, 0);
-    std::vector<T> min(numCurrentFeatures, std::numeric_limits<T>::max());
-    std::vector<T> max(numCurrentFeatures, std::numeric_limits<T>::min());
-    std::vector<float32> summation(numCurrentFeatures, 0);
-    std::vector<std::map<T, uint64>> modalMaps(numCurrentFeatures);
-    usize progressCount = 0;
+    ParallelDataAlgorithm accumulateAlg;
+    accumulateAlg.setParallelizationEnabled(m_RunParallel);
 
-    usize progressIncrement = numTuples / 100;
+    // Thread local accumulators are only used while all of them together are smaller than the input
+    const usize chunkCount = std::clamp<usize>(numTuples / std::max<usize>(numFeatures, 1), 1, accumulateAlg.getMaxThreads());
+    const usize chunkSize = (numTuples + chunkCount - 1) / chunkCount;
 
-    for(usize i = 0; i < numTuples; ++i)
+    std::vector<Accumulator> accumulators(chunkCount);
+    for(auto& accumulator : accumulators)
     {
-      if(shouldCancel)
-      {
-        return;
-      }
-      if(m_Mask != nullptr && !m_Mask->isTrue(i))
+      accumulator.resize(numFeatures);
+    }
+
+    m_Filter->sendThreadSafeInfoMessage("Accumulating Feature/Ensemble Statistics...");
+    accumulateAlg.setRange(0, chunkCount);
+    accumulateAlg.execute([&](const Range& range) {
+      for(usize chunk = range.min(); chunk < range.max(); chunk++)
       {
-        continue;
+        Accumulator& accumulator = accumulators[chunk];
+        const usize chunkEnd = std::min(numTuples, (chunk + 1) * chunkSize);
+        for(usize tupleIndex = chunk * chunkSize; tupleIndex < chunkEnd; tupleIndex++)
+        {
+          if(m_Mask != nullptr && !m_Mask->isTrue(tupleIndex))
+          {
+            continue;
+          }
+          const int32 featureId = featureIds[tupleIndex];
+          if(featureId < 0 || static_cast<usize>(featureId) >= numFeatures)
+          {
+            continue;
+          }
+          const auto value = static_cast<StorageType>(source[tupleIndex]);
+          accumulator.length[featureId]++;
+          accumulator.min[featureId] = std::min(accumulator.min[featureId], value);
+          accumulator.max[featureId] = std::max(accumulator.max[featureId], value);
+          accumulator.summation[featureId] += static_cast<float64>(value);
+        }
+        if(shouldCancel)
+        {
+          return;
+        }
       }
-      for(usize j = 0; j < numCurrentFeatures; j++)
+    });
+    if(shouldCancel)
+    {
+      return;
+    }
+
+    // Merge everything into the first accumulator. The per chunk lengths are replaced by the
+    // offset of the chunk's values within the feature so the values can be grouped below.
+    Accumulator& totals = accumulators[0];
+    std::vector<uint64> lengths(numFeatures, 0);
+    ParallelDataAlgorithm mergeAlg;
+    mergeAlg.setParallelizationEnabled(m_RunParallel);
+    mergeAlg.setRange(0, numFeatures);
+    mergeAlg.execute([&](const Range& range) {
+      for(usize featureId = range.min(); featureId < range.max(); featureId++)
       {
-        if((*m_FeatureIds)[i] != static_cast<int32>(start + j))
+        uint64 featureLength = 0;
+        for(usize chunk = 0; chunk < chunkCount; chunk++)
         {
-          continue;
+          Accumulator& accumulator = accumulators[chunk];
+          if(chunk > 0)
+          {
+            totals.min[featureId] = std::min(totals.min[featureId], accumulator.min[featureId]);
+            totals.max[featureId] = std::max(totals.max[featureId], accumulator.max[featureId]);
+            totals.summation[featureId] += accumulator.summation[featureId];
+          }
+          const uint64 chunkLength = accumulator.length[featureId];
+          accumulator.length[featureId] = featureLength;
+          featureLength += chunkLength;
         }
+        lengths[featureId] = featureLength;
+      }
+    });
 
-        ++length[j];
+    std::vector<uint64> offsets(numFeatures + 1, 0);
+    for(usize featureId = 0; featureId < numFeatures; featureId++)
+    {
+      offsets[featureId + 1] = offsets[featureId] + lengths[featureId];
+    }
 
-        if(m_Source[i] < min[j])
+    std::vector<StorageType> groupedValues;
+    if(m_StdDeviation || m_Histogram || m_Mode || m_Median || m_NumUniqueValues)
+    {
+      m_Filter->sendThreadSafeInfoMessage("Grouping Values by Feature/Ensemble...");
+      groupedValues.resize(offsets[numFeatures]);
+      ParallelDataAlgorithm groupAlg;
+      groupAlg.setParallelizationEnabled(m_RunParallel);
+      groupAlg.setRange(0, chunkCount);
+      groupAlg.execute([&](const Range& range) {
+        for(usize chunk = range.min(); chunk < range.max(); chunk++)
         {
-          min[j] = m_Source[i];
+          std::vector<uint64>& cursors = accumulators[chunk].length;
+          const usize chunkEnd = std::min(numTuples, (chunk + 1) * chunkSize);
+          for(usize tupleIndex = chunk * chunkSize; tupleIndex < chunkEnd; tupleIndex++)
+          {
+            if(m_Mask != nullptr && !m_Mask->isTrue(tupleIndex))
+            {
+              continue;
+            }
+            const int32 featureId = featureIds[tupleIndex];
+            if(featureId < 0 || static_cast<usize>(featureId) >= numFeatures)
+            {
+              continue;
+            }
+            groupedValues[offsets[featureId] + cursors[featureId]] = static_cast<StorageType>(source[tupleIndex]);
+            cursors[featureId]++;
+          }
         }
+      });
+    }
 
-        if(m_Source[i] > max[j])
+    m_Filter->sendThreadSafeInfoMessage("Storing Feature/Ensemble Statistics...");
+    ParallelDataAlgorithm storeAlg;
+    storeAlg.setParallelizationEnabled(m_RunParallel);
+    storeAlg.setRange(0, numFeatures);
+    storeAlg.execute([&](const Range& range) {
+      std::vector<uint64> valueCounts;
+      for(usize featureId = range.min(); featureId < range.max(); featureId++)
+      {
+        if(shouldCancel)
         {
-          max[j] = m_Source[i];
+          return;
         }
-
-        summation[j] = summation[j] + m_Source[i];
-
-        modalMaps[j][m_Source[i]]++;
+        StorageType* values = groupedValues.empty() ? nullptr : groupedValues.data() + offsets[featureId];
+        storeFeature(featureId, lengths[featureId], totals.min[featureId], totals.max[featureId], totals.summation[featureId], numTuples, values, valueCounts);
       }
+    });
+  } // end of compute
 
-      progressCount++;
-      now = std::chrono::steady_clock::now();
-      if(progressCount > progressIncrement && std::chrono::duration_cast<std::chrono::milliseconds>(now - initialTime).count() > milliDelay)
-      {
-        m_Filter->sendThreadSafeInfoMessage(fmt::format("Calculating FeatureHasData Array [{}-{}]: {:.2f}%", start, end, 100.0f * static_cast<float>(i) / static_cast<float>(numTuples)));
-        progressCount = 0;
-        initialTime = std::chrono::steady_clock::now();
-      }
+private:
+  /**
+   * @brief Per feature accumulators for one chunk of tuples
+   */
+  struct Accumulator
+  {
+    std::vector<uint64> length;
+    std::vector<StorageType> min;
+    std::vector<StorageType> max;
+    std::vector<float64> summation;
+
+    void resize(usize numFeatures)
+    {
+      length.assign(numFeatures, 0);
+      min.assign(numFeatures, static_cast<StorageType>(std::numeric_limits<T>::max()));
+      max.assign(numFeatures, static_cast<StorageType>(std::numeric_limits<T>::lowest()));
+      summation.assign(numFeatures, 0.0);
     }
+  };
 
-    m_Filter->sendThreadSafeInfoMessage(fmt::format("Storing Results Feature/Ensemble Range [{}-{}]", start, end));
-    progressIncrement = numCurrentFeatures / 100;
-    progressCount = 0;
-    std::vector<float32> meanArray;
-    if(m_StdDeviation && !m_Mean)
+  /**
+   * @brief Writes all requested statistics of a single feature. The feature's values are
+   * reordered when the modes, median or unique values are computed.
+   */
+  void storeFeature(usize featureId, uint64 length, StorageType minValue, StorageType maxValue, float64 summation, usize numTuples, StorageType* values, std::vector<uint64>& valueCounts) const
+  {
+    const auto summationValue = static_cast<float32>(summation);
+    m_FeatureHasDataArray->initializeTuple(featureId, (length > 0));
+    if(m_Length)
     {
-      meanArray.resize(numCurrentFeatures);
+      m_LengthArray->initializeTuple(featureId, length);
     }
-    for(usize j = start; j < end; j++)
+    if(m_Min)
     {
-      if(shouldCancel)
-      {
-        return;
-      }
-      const usize localFeatureIndex = j - start;
+      m_MinArray->initializeTuple(featureId, static_cast<T>(minValue));
+    }
+    if(m_Max)
+    {
+      m_MaxArray->initializeTuple(featureId, static_cast<T>(maxValue));
+    }
+    if(m_Summation)
+    {
+      m_SummationArray->initializeTuple(featureId, summationValue);
+    }
 
-      m_FeatureHasDataArray->initializeTuple(j, (length[localFeatureIndex] > 0));
-      if(m_Length)
-      {
-        m_LengthArray->initializeTuple(j, length[localFeatureIndex]);
-      }
-      if(m_Min)
-      {
-        m_MinArray->initializeTuple(j, min[localFeatureIndex]);
-      }
-      if(m_Max)
+    float32 meanValue = 0.0f;
+    if(length > 0)
+    {
+      if constexpr(std::is_same_v<T, bool>)
       {
-        m_MaxArray->initializeTuple(j, max[localFeatureIndex]);
+        meanValue = static_cast<float32>(summationValue >= (numTuples - summationValue));
       }
-      if(m_Summation)
+      else
       {
-        m_SummationArray->initializeTuple(j, summation[localFeatureIndex]);
+        meanValue = summationValue / static_cast<float32>(length);
       }
+    }
+    if(m_Mean)
+    {
+      m_MeanArray->initializeTuple(featureId, meanValue);
+    }
 
-      float32 meanValue = 0.0f;
-      if(length[localFeatureIndex] > 0)
+    if(m_StdDeviation)
+    {
+      // This should probably be done with Kahan Summation instead
+      float64 sumOfDiffs = 0.0;
+      for(uint64 i = 0; i < length; i++)
       {
-        if constexpr(std::is_same_v<T, bool>)
-        {
-          meanValue = static_cast<float32>(summation[localFeatureIndex] >= (numTuples - summation[localFeatureIndex]));
-        }
-        else
-        {
-          meanValue = summation[localFeatureIndex] / static_cast<float32>(length[localFeatureIndex]);
-        }
+        sumOfDiffs += static_cast<float64>((values[i] - meanValue) * (values[i] - meanValue));
       }
+      m_StdDevArray->operator[](featureId) = static_cast<float32>(std::sqrt(sumOfDiffs / static_cast<float64>(length)));
+    }
 
-      if(m_Mean)
-      {
-        m_MeanArray->initializeTuple(j, meanValue);
-      }
-      else if(m_StdDeviation)
-      {
-        meanArray[localFeatureIndex] = meanValue;
-      }
+    if(m_Histogram && m_HistArray != nullptr)
+    {
+      storeHistogram(featureId, length, minValue, maxValue, values);
+    }
 
-      if(m_Mode)
-      {
-        if(!modalMaps[localFeatureIndex].empty())
-        {
-          // Find the maximum occurrence
-          auto pr = std::max_element(modalMaps[localFeatureIndex].begin(), modalMaps[localFeatureIndex].end(), [](const auto& x, const auto& y) { return x.second < y.second; });
-          int maxCount = pr->second;
+    if(m_Mode || m_Median || m_NumUniqueValues)
+    {
+      storeOrderStatistics(featureId, length, minValue, maxValue, values, valueCounts);
+    }
 
-          // Store all values that have this maximum occurrence under the proper feature id
-          for(const auto& modalPair : modalMaps[localFeatureIndex])
-          {
-            if(modalPair.second == maxCount)
-            {
-              m_ModeArray->addEntry(j, modalPair.first);
-            }
-          }
-        }
-      }
+    if(m_Histogram && m_HistArray != nullptr && m_ModalBinRanges && length > 0)
+    {
+      storeModalBinRanges(featureId, minValue, maxValue);
+    }
+  }
 
-      AbstractDataStore<uint64>* histDataStorePtr = nullptr;
-      if(m_HistArray != nullptr)
-      {
-        histDataStorePtr = m_HistArray->getDataStore();
-      }
+  std::pair<float32, float32> histogramRange(StorageType minValue, StorageType maxValue) const
+  {
+    if(m_HistFullRange)
+    {
+      return {static_cast<float32>(minValue), static_cast<float32>(maxValue)};
+    }
+    return {static_cast<float32>(m_HistMin), static_cast<float32>(m_HistMax)};
+  }
 
-      AbstractDataStore<uint64>* mostPopulatedBinDataStorePtr = nullptr;
-      if(m_MostPopulatedBinArray != nullptr)
+  void storeHistogram(usize featureId, uint64 length, StorageType minValue, StorageType maxValue, const StorageType* values) const
+  {
+    std::vector<uint64> histogram(m_NumBins, 0);
+    if(length > 0)
+    {
+      const auto [histMin, histMax] = histogramRange(minValue, maxValue);
+      const float32 increment = (histMax - histMin) / (m_NumBins);
+      if(std::fabs(increment) < 1E-10)
       {
-        mostPopulatedBinDataStorePtr = m_MostPopulatedBinArray->getDataStore();
+        histogram[0] = length;
       }
-
-      if(m_Histogram && histDataStorePtr != nullptr)
+      else
       {
-        std::vector<uint64> histogram(m_NumBins, 0);
-        if(length[localFeatureIndex] > 0)
+        for(uint64 i = 0; i < length; i++)
         {
-          float32 histMin = m_HistMin;
-          float32 histMax = m_HistMax;
-          if(m_HistFullRange)
-          {
-            histMin = static_cast<float32>(min[localFeatureIndex]);
-            histMax = static_cast<float32>(max[localFeatureIndex]);
-          }
-
-          const float32 increment = (histMax - histMin) / (m_NumBins);
-          if(std::fabs(increment) < 1E-10)
+          const auto value = static_cast<float32>(values[i]);
+          const auto bin = static_cast<int32>((value - histMin) / increment); // find bin for this input array value
+          if((bin >= 0) && (bin < m_NumBins))                                 // make certain bin is in range
           {
-            histogram[0] = length[localFeatureIndex];
+            ++histogram[bin]; // increment histogram element corresponding to this input array value
           }
-          else
+          else if(value == histMax)
           {
-            for(usize i = 0; i < numTuples; ++i)
-            {
-              if(shouldCancel)
-              {
-                return;
-              }
-              if(m_Mask != nullptr && !m_Mask->isTrue(i))
-              {
-                continue;
-              }
-              if((*m_FeatureIds)[i] != static_cast<int32>(j))
-              {
-                continue;
-              }
-              const auto value = static_cast<float32>(m_Source[i]);
-              const auto bin = static_cast<int32>((value - histMin) / increment); // find bin for this input array value
-              if((bin >= 0) && (bin < m_NumBins))                                 // make certain bin is in range
-              {
-                ++histogram[bin]; // increment histogram element corresponding to this input array value
-              }
-              else if(value == histMax)
-              {
-                histogram[m_NumBins - 1]++;
-              }
-            } // end of numTuples loop
-          }   // end of increment else
-
-          if(m_ModalBinRanges)
-          {
-            if(std::fabs(increment) < 1E-10)
-            {
-              m_ModalBinRangesArray->addEntry(j, histMin);
-              m_ModalBinRangesArray->addEntry(j, histMax);
-            }
-            else
-            {
-              auto modeList = m_ModeArray->getList(j);
-              for(int i = 0; i < modeList->size(); i++)
-              {
-                const float32 mode = modeList->at(i);
-                const auto modalBin = static_cast<int32>((mode - histMin) / increment);
-                float32 minBinValue = 0.0f;
-                float32 maxBinValue = 0.0f;
-                if((modalBin >= 0) && (modalBin < m_NumBins)) // make certain bin is in range
-                {
-                  minBinValue = static_cast<float32>(histMin + (modalBin * increment));
-                  maxBinValue = static_cast<float32>(histMin + ((modalBin + 1) * increment));
-                }
-                else if(mode == histMax)
-                {
-                  minBinValue = static_cast<float32>(histMin + ((modalBin - 1) * increment));
-                  maxBinValue = static_cast<float32>(histMin + (modalBin * increment));
-                }
-                m_ModalBinRangesArray->addEntry(j, minBinValue);
-                m_ModalBinRangesArray->addEntry(j, maxBinValue);
-              }
-            }
+            histogram[m_NumBins - 1]++;
           }
-        } // end of length if
+        }
+      }
+    }
 
-        histDataStorePtr->setTuple(j, histogram);
+    m_HistArray->getDataStore()->setTuple(featureId, histogram);
+
+    auto maxElementIt = std::max_element(histogram.begin(), histogram.end());
+    uint64 index = std::distance(histogram.begin(), maxElementIt);
+    AbstractDataStore<uint64>* mostPopulatedBinDataStorePtr = m_MostPopulatedBinArray->getDataStore();
+    mostPopulatedBinDataStorePtr->setComponent(featureId, 0, index);
+    mostPopulatedBinDataStorePtr->setComponent(featureId, 1, histogram[index]);
+  }
 
-        auto maxElementIt = std::max_element(histogram.begin(), histogram.end());
-        uint64 index = std::distance(histogram.begin(), maxElementIt);
-        mostPopulatedBinDataStorePtr->setComponent(j, 0, index);
-        mostPopulatedBinDataStorePtr->setComponent(j, 1, histogram[index]);
-      } // end of m_Histogram if
+  void storeModalBinRanges(usize featureId, StorageType minValue, StorageType maxValue) const
+  {
+    const auto [histMin, histMax] = histogramRange(minValue, maxValue);
+    const float32 increment = (histMax - histMin) / (m_NumBins);
+    if(std::fabs(increment) < 1E-10)
+    {
+      m_ModalBinRangesArray->addEntry(featureId, histMin);
+      m_ModalBinRangesArray->addEntry(featureId, histMax);
+      return;
+    }
 
-      progressCount++;
-      now = std::chrono::steady_clock::now();
-      if(progressCount > progressIncrement && std::chrono::duration_cast<std::chrono::milliseconds>(now - initialTime).count() > milliDelay)
+    auto modeList = m_ModeArray->getList(featureId);
+    if(modeList == nullptr)
+    {
+      return;
+    }
+    for(usize i = 0; i < modeList->size(); i++)
+    {
+      const float32 mode = modeList->at(i);
+      const auto modalBin = static_cast<int32>((mode - histMin) / increment);
+      float32 minBinValue = 0.0f;
+      float32 maxBinValue = 0.0f;
+      if((modalBin >= 0) && (modalBin < m_NumBins)) // make certain bin is in range
+      {
+        minBinValue = static_cast<float32>(histMin + (modalBin * increment));
+        maxBinValue = static_cast<float32>(histMin + ((modalBin + 1) * increment));
+      }
+      else if(mode == histMax)
       {
-        m_Filter->sendThreadSafeInfoMessage(fmt::format("Storing data for feature/ensembles [{}-{}] {}/{}", start, end, j, end));
-        progressCount = 0;
-        initialTime = std::chrono::steady_clock::now();
+        minBinValue = static_cast<float32>(histMin + ((modalBin - 1) * increment));
+        maxBinValue = static_cast<float32>(histMin + (modalBin * increment));
       }
+      m_ModalBinRangesArray->addEntry(featureId, minBinValue);
+      m_ModalBinRangesArray->addEntry(featureId, maxBinValue);
     }
+  }
 
-    if(m_StdDeviation)
+  /**
+   * @brief Stores the modes, median and number of unique values of a feature. The modes are
+   * stored in ascending order.
+   */
+  void storeOrderStatistics(usize featureId, uint64 length, StorageType minValue, StorageType maxValue, StorageType* values, std::vector<uint64>& valueCounts) const
+  {
+    if(length == 0)
     {
-      // https://www.khanacademy.org/math/statistics-probability/summarizing-quantitative-data/variance-standard-deviation-population/a/calculating-standard-deviation-step-by-step
-      m_Filter->sendThreadSafeInfoMessage(fmt::format("Computing StdDev Feature/Ensemble [{}-{}]", start, end));
-      // This should probably be done with Kahan Summation instead
-      std::vector<float64> sumOfDiffs(numCurrentFeatures, 0.0f);
-      progressCount = 0;
+      if(m_Median)
+      {
+        m_MedianArray->initializeTuple(featureId, 0.0f);
+      }
+      if(m_NumUniqueValues)
+      {
+        m_NumUniqueValuesArray->initializeTuple(featureId, 0);
+      }
+      return;
+    }
+
+    // Middle positions of the sorted values
+    const uint64 lowIndex = (length % 2 == 1) ? length / 2 : (length / 2) - 1;
+    const uint64 highIndex = length / 2;
+    StorageType lowValue = minValue;
+    StorageType highValue = minValue;
+    int32 numUniqueValues = 0;
 
-      for(usize tupleIndex = 0; tupleIndex < numTuples; tupleIndex++)
+    if(useValueHistogram(length, minValue, maxValue))
+    {
+      // Count every value between the min and max
+      const auto valueRange = static_cast<usize>(static_cast<uint64>(maxValue) - static_cast<uint64>(minValue)) + 1;
+      valueCounts.assign(valueRange, 0);
+      for(uint64 i = 0; i < length; i++)
       {
-        if(shouldCancel)
+        valueCounts[static_cast<usize>(static_cast<uint64>(values[i]) - static_cast<uint64>(minValue))]++;
+      }
+
+      const uint64 maxCount = *std::max_element(valueCounts.cbegin(), valueCounts.cend());
+      uint64 cumulativeCount = 0;
+      for(usize bin = 0; bin < valueRange; bin++)
+      {
+        const uint64 count = valueCounts[bin];
+        if(count == 0)
         {
-          return;
+          continue;
         }
-        // Is the value in a mask and if so, is that mask TRUE
-        if(m_Mask != nullptr && !m_Mask->isTrue(tupleIndex))
+        const auto value = static_cast<StorageType>(static_cast<uint64>(minValue) + bin);
+        numUniqueValues++;
+        if(m_Mode && count == maxCount)
         {
-          continue;
+          m_ModeArray->addEntry(featureId, static_cast<T>(value));
         }
-        // Is the featureId within our range that we care about
-        const int32 featureId = (*m_FeatureIds)[tupleIndex];
-        if(featureId < start || featureId >= end)
+        if(cumulativeCount <= lowIndex && lowIndex < cumulativeCount + count)
         {
-          continue;
+          lowValue = value;
         }
-
-        const float32 meanVal = m_Mean ? m_MeanArray->operator[](featureId) : meanArray[featureId - start];
-        sumOfDiffs[featureId - start] += static_cast<float64>((m_Source[tupleIndex] - meanVal) * (m_Source[tupleIndex] - meanVal));
-
-        progressCount++;
-        now = std::chrono::steady_clock::now();
-        if(progressCount > progressIncrement && std::chrono::duration_cast<std::chrono::milliseconds>(now - initialTime).count() > milliDelay)
+        if(cumulativeCount <= highIndex && highIndex < cumulativeCount + count)
         {
-          m_Filter->sendThreadSafeInfoMessage(fmt::format("StdDev Calculation Feature/Ensemble [{}-{}]: {:.2f}%", start, end, 100.0f * static_cast<float>(tupleIndex) / static_cast<float>(numTuples)));
-          progressCount = 0;
-          initialTime = std::chrono::steady_clock::now();
+          highValue = value;
         }
+        cumulativeCount += count;
       }
+    }
+    else
+    {
+      std::sort(values, values + length);
+      lowValue = values[lowIndex];
+      highValue = values[highIndex];
 
-      for(usize j = 0; j < numCurrentFeatures; j++)
+      // Find the maximum occurrence first, then store every value that occurs that often
+      uint64 maxCount = 0;
+      for(uint64 runStart = 0; runStart < length;)
       {
-        // Set the value into the output array
-        const uint64 lengthVal = m_Length ? m_LengthArray->operator[](j + start) : length[j];
-        m_StdDevArray->operator[](j + start) = static_cast<float32>(std::sqrt(sumOfDiffs[j] / static_cast<float64>(lengthVal)));
+        uint64 runEnd = runStart + 1;
+        while(runEnd < length && values[runEnd] == values[runStart])
+        {
+          runEnd++;
+        }
+        maxCount = std::max(maxCount, runEnd - runStart);
+        numUniqueValues++;
+        runStart = runEnd;
+      }
+      if(m_Mode)
+      {
+        for(uint64 runStart = 0; runStart < length;)
+        {
+          uint64 runEnd = runStart + 1;
+          while(runEnd < length && values[runEnd] == values[runStart])
+          {
+            runEnd++;
+          }
+          if(runEnd - runStart == maxCount)
+          {
+            m_ModeArray->addEntry(featureId, static_cast<T>(values[runStart]));
+          }
+          runStart = runEnd;
+        }
       }
     }
 
-  } // end of compute
+    if(m_Median)
+    {
+      const float32 medianValue = (length % 2 == 1) ? static_cast<float32>(lowValue) : (lowValue + highValue) * 0.5f;
+      m_MedianArray->initializeTuple(featureId, medianValue);
+    }
+    if(m_NumUniqueValues)
+    {
+      m_NumUniqueValuesArray->initializeTuple(featureId, numUniqueValues);
+    }
+  }
 
-  void operator()(const Range& range) const
+  /**
+   * @brief Returns true if the values of a feature should be counted with a histogram of every
+   * value between the min and max instead of being sorted. Only used for integer types whose
+   * value range is small compared to the number of values.
+   */
+  static bool useValueHistogram(uint64 length, StorageType minValue, StorageType maxValue)
   {
-    compute(range.min(), range.max());
+    if constexpr(std::is_integral_v<StorageType>)
+    {
+      const uint64 valueSpan = static_cast<uint64>(maxValue) - static_cast<uint64>(minValue);
+      return valueSpan < std::max<uint64>(2 * length, 256);
+    }
+    else
+    {
+      return false;
+    }
   }
 
-private:
   bool m_Length;
   bool m_Min;
   bool m_Max;
@@ -370,6 +527,8 @@ private:
   bool m_Summation;
   bool m_Histogram;
   bool m_ModalBinRanges;
+  bool m_Median;
+  bool m_NumUniqueValues;
   float64 m_HistMin;
   float64 m_HistMax;
   bool m_HistFullRange;
@@ -388,97 +547,9 @@ private:
   UInt64Array* m_HistArray = nullptr;
   UInt64Array* m_MostPopulatedBinArray = nullptr;
   NeighborList<float32>* m_ModalBinRangesArray = nullptr;
-  FindArrayStatistics* m_Filter = nullptr;
-};
-
-template <typename T>
-class FindArrayMedianUniqueByIndexImpl
-{
-public:
-  FindArrayMedianUniqueByIndexImpl(const std::unique_ptr<MaskCompare>& mask, const Int32Array* featureIds, const DataArray<T>& source, bool findMedian, bool findNumUnique, Float32Array* medianArray,
-                                   Int32Array* numUniqueValuesArray, DataArray<uint64>* lengthArray, FindArrayStatistics* filter)
-  : m_FindMedian(findMedian)
-  , m_FindNumUniqueValues(findNumUnique)
-  , m_MedianArray(medianArray)
-  , m_NumUniqueValuesArray(numUniqueValuesArray)
-  , m_Mask(mask)
-  , m_FeatureIds(featureIds)
-  , m_Source(source)
-  , m_LengthArray(lengthArray)
-  , m_Filter(filter)
-  {
-  }
-
-  virtual ~FindArrayMedianUniqueByIndexImpl() = default;
-
-  FindArrayMedianUniqueByIndexImpl(const FindArrayMedianUniqueByIndexImpl&) = default;           // Copy Constructor Not Implemented
-  FindArrayMedianUniqueByIndexImpl(FindArrayMedianUniqueByIndexImpl&&) noexcept = default;       // Move Constructor Not Implemented
-  FindArrayMedianUniqueByIndexImpl& operator=(const FindArrayMedianUniqueByIndexImpl&) = delete; // Copy Assignment Not Implemented
-  FindArrayMedianUniqueByIndexImpl& operator=(FindArrayMedianUniqueByIndexImpl&&) = delete;      // Move Assignment Not Implemented
-
-  void compute(usize start, usize end) const
-  {
-    m_Filter->sendThreadSafeInfoMessage(fmt::format("Starting Median Array Calculation: Feature/Ensemble [{}-{}]", start, end));
-
-    const usize numFeatureSources = end - start;
-    // Create the arrays that will collect the values from the arrays. allocate them to the correct size based on the length array
-    std::vector<std::vector<T>> featureSources(numFeatureSources);
-    for(usize featureSourceIndex = 0; featureSourceIndex < numFeatureSources; featureSourceIndex++)
-    {
-      featureSources[featureSourceIndex].reserve(m_LengthArray->operator[](featureSourceIndex + start));
-    }
-    const usize numTuples = m_Source.getNumberOfTuples();
-    const auto& featureIds = m_FeatureIds->getDataStoreRef();
-    const auto& source = m_Source.getDataStoreRef();
-
-    for(usize tupleIndex = 0; tupleIndex < numTuples; tupleIndex++)
-    {
-      // Is the value in a mask and if so, is that mask TRUE
-      if(m_Mask != nullptr && !m_Mask->isTrue(tupleIndex))
-      {
-        continue;
-      }
-      // Is the featureId within our range that we care about
-      const int32 featureId = featureIds[tupleIndex];
-      if(featureId < start || featureId >= end)
-      {
-        continue;
-      }
-      featureSources[featureId - start].push_back(source[tupleIndex]);
-    }
-
-    auto& medianArray = m_MedianArray->getDataStoreRef();
-    auto& numUniqueValuesArray = m_NumUniqueValuesArray->getDataStoreRef();
-
-    for(usize featureSourceIndex = 0; featureSourceIndex < numFeatureSources; featureSourceIndex++)
-    {
-      if(m_FindMedian)
-      {
-        const float32 val = StatisticsCalculations::findMedian(featureSources[featureSourceIndex]);
-        medianArray.setValue(featureSourceIndex + start, val);
-      }
-      if(m_FindNumUniqueValues)
-      {
-        const auto val = StatisticsCalculations::findNumUniqueValues(featureSources[featureSourceIndex]);
-        numUniqueValuesArray.setValue(featureSourceIndex + start, val);
-      }
-    }
-  }
-
-  void operator()(const Range& range) const
-  {
-    compute(range.min(), range.max());
-  }
-
-private:
-  bool m_FindMedian;
-  bool m_FindNumUniqueValues;
-  Float32Array* m_MedianArray;
-  Int32Array* m_NumUniqueValuesArray;
-  const std::unique_ptr<MaskCompare>& m_Mask = nullptr;
-  const Int32Array* m_FeatureIds = nullptr;
-  const DataArray<T>& m_Source;
-  const DataArray<uint64>* m_LengthArray = nullptr;
+  Float32Array* m_MedianArray = nullptr;
+  Int32Array* m_NumUniqueValuesArray = nullptr;
+  bool m_RunParallel = false;
   FindArrayStatistics* m_Filter = nullptr;
 };
 
@@ -660,64 +731,30 @@ void FindStatistics(const DataArray<T>& source, const Int32Array* featureIds, co
     auto* modalBinsArrayPtr = dynamic_cast<NeighborList<float32>*>(arrays[11]);
     auto* featureHasDataPtr = dynamic_cast<BoolArray*>(arrays[12]);
 
+    auto* medianArrayPtr = dynamic_cast<Float32Array*>(arrays[4]);
+    auto* numUniqueValuesArrayPtr = dynamic_cast<Int32Array*>(arrays[9]);
+
     IParallelAlgorithm::AlgorithmArrays indexAlgArrays;
     indexAlgArrays.push_back(&source);
+    indexAlgArrays.push_back(featureIds);
     indexAlgArrays.push_back(featureHasDataPtr);
     indexAlgArrays.push_back(lengthArrayPtr);
     indexAlgArrays.push_back(minArrayPtr);
     indexAlgArrays.push_back(maxArrayPtr);
     indexAlgArrays.push_back(meanArrayPtr);
+    indexAlgArrays.push_back(medianArrayPtr);
     indexAlgArrays.push_back(stdDevArrayPtr);
     indexAlgArrays.push_back(summationArrayPtr);
     indexAlgArrays.push_back(histArrayPtr);
+    indexAlgArrays.push_back(numUniqueValuesArrayPtr);
     indexAlgArrays.push_back(mostPopulatedBinPtr);
 
-#ifdef COMPLEX_ENABLE_MULTICORE
-    if(IParallelAlgorithm::CheckArraysInMemory(indexAlgArrays))
-    {
-      const tbb::simple_partitioner simplePartitioner;
-      const size_t grainSize = 500;
-      const tbb::blocked_range<size_t> tbbRange(0, numFeatures, grainSize);
-      tbb::parallel_for(tbbRange,
-                        FindArrayStatisticsByIndexImpl<T>(inputValues->FindLength, inputValues->FindMin, inputValues->FindMax, inputValues->FindMean, inputValues->FindMode,
-                                                          inputValues->FindStdDeviation, inputValues->FindSummation, inputValues->FindHistogram, inputValues->MinRange, inputValues->MaxRange,
-                                                          inputValues->UseFullRange, inputValues->NumBins, inputValues->FindModalBinRanges, mask, featureIds, source, featureHasDataPtr, lengthArrayPtr,
-                                                          minArrayPtr, maxArrayPtr, meanArrayPtr, modeArrayPtr, stdDevArrayPtr, summationArrayPtr, histArrayPtr, mostPopulatedBinPtr, modalBinsArrayPtr,
-                                                          filter),
-                        simplePartitioner);
-    }
-    else
-    {
-      ParallelDataAlgorithm indexAlg;
-      indexAlg.setRange(0, numFeatures);
-      indexAlg.requireArraysInMemory(indexAlgArrays);
-      indexAlg.execute(FindArrayStatisticsByIndexImpl<T>(
-          inputValues->FindLength, inputValues->FindMin, inputValues->FindMax, inputValues->FindMean, inputValues->FindMode, inputValues->FindStdDeviation, inputValues->FindSummation,
-          inputValues->FindHistogram, inputValues->MinRange, inputValues->MaxRange, inputValues->UseFullRange, inputValues->NumBins, inputValues->FindModalBinRanges, mask, featureIds, source,
-          featureHasDataPtr, lengthArrayPtr, minArrayPtr, maxArrayPtr, meanArrayPtr, modeArrayPtr, stdDevArrayPtr, summationArrayPtr, histArrayPtr, mostPopulatedBinPtr, modalBinsArrayPtr, filter));
-    }
-#endif
-
-    if(inputValues->FindMedian || inputValues->FindNumUniqueValues)
-    {
-      filter->sendThreadSafeInfoMessage("Starting Median Calculation..");
-
-      auto* medianArrayPtr = dynamic_cast<Float32Array*>(arrays[4]);
-      auto* numUniqueValuesArrayPtr = dynamic_cast<Int32Array*>(arrays[9]);
-
-      IParallelAlgorithm::AlgorithmArrays medianAlgArrays;
-      medianAlgArrays.push_back(featureIds);
-      medianAlgArrays.push_back(&source);
-      medianAlgArrays.push_back(medianArrayPtr);
-      medianAlgArrays.push_back(numUniqueValuesArrayPtr);
-      medianAlgArrays.push_back(lengthArrayPtr);
-
-      ParallelDataAlgorithm medianDataAlg;
-      medianDataAlg.requireArraysInMemory(medianAlgArrays);
-      medianDataAlg.setRange(0, numFeatures);
-      medianDataAlg.execute(
-          FindArrayMedianUniqueByIndexImpl<T>(mask, featureIds, source, inputValues->FindMedian, inputValues->FindNumUniqueValues, medianArrayPtr, numUniqueValuesArrayPtr, lengthArrayPtr, filter));
-    }
+    FindArrayStatisticsByIndexImpl<T> indexImpl(inputValues->FindLength, inputValues->FindMin, inputValues->FindMax, inputValues->FindMean, inputValues->FindMode, inputValues->FindStdDeviation,
+                                                inputValues->FindSummation, inputValues->FindHistogram, inputValues->MinRange, inputValues->MaxRange, inputValues->UseFullRange, inputValues->NumBins,
+                                                inputValues->FindModalBinRanges, inputValues->FindMedian, inputValues->FindNumUniqueValues, mask, featureIds, source, featureHasDataPtr,
+                                                lengthArrayPtr, minArrayPtr, maxArrayPtr, meanArrayPtr, modeArrayPtr, stdDevArrayPtr, summationArrayPtr, histArrayPtr, mostPopulatedBinPtr,
+                                                modalBinsArrayPtr, medianArrayPtr, numUniqueValuesArrayPtr, IParallelAlgorithm::CheckArraysInMemory(indexAlgArrays), filter);
+    indexImpl.compute(numFeatures);
   }
   else
   {
@@ -867,7 +904,7 @@ struct FindArrayStatisticsFunctor
       {
         return MakeErrorResult(-563505, "FindArrayStatisticsFunctor could not dynamic_cast 'Max' array to needed type. Check input array selection.");
       }
-      arrayPtr->fill(static_cast<T>(std::numeric_limits<T>::min()));
+      arrayPtr->fill(static_cast<T>(std::numeric_limits<T>::lowest()));
     }
     if(inputValues->FindMean)
     {
@@ -5,9 +5,10 @@
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
 #include "complex/DataStructure/Geometry/VertexGeom.hpp"
 #include "complex/Utilities/ParallelDataAlgorithm.hpp"
-#include "complex/Utilities/RTree.hpp"
+#include "complex/Utilities/TriangleBVH.hpp"
 
-using RTreeType = RTree<size_t, float, 3, float>;
+#include <limits>
+#include <numeric>
 
 using namespace complex;
 
@@ -304,7 +305,7 @@ class FindVertexToTriangleDistancesImpl
 {
 public:
   FindVertexToTriangleDistancesImpl(FindVertexToTriangleDistances* filter, const IGeometry::SharedTriList& triangles, const IGeometry::SharedVertexList& vertices,
-                                    IGeometry::SharedVertexList& sourcePoints, Float32Array& distances, Int64Array& closestTri, const Float64Array& normals, const RTreeType rtree)
+                                    IGeometry::SharedVertexList& sourcePoints, Float32Array& distances, Int64Array& closestTri, const Float64Array& normals, const TriangleBVH& bvh)
   : m_Filter(filter)
   , m_SharedTriangleList(triangles)
   , m_TriangleVertices(vertices)
@@ -312,7 +313,7 @@ public:
   , m_Distances(distances)
   , m_ClosestTri(closestTri)
   , m_Normals(normals)
-  , m_RTree(rtree)
+  , m_Bvh(bvh)
   {
   }
   virtual ~FindVertexToTriangleDistancesImpl() = default;
@@ -327,80 +328,37 @@ public:
     int64 counter = 0;
     auto progIncrement = static_cast<int64>((end - start) / 100);
 
-    size_t numTuples = m_SharedTriangleList.getNumberOfTuples(); // allocate vector of all possible indexes
     for(usize v = start; v < end; v++)
     {
-      Vec3fa sourcePoint(m_SourcePoints[3 * v], m_SourcePoints[3 * v + 1], m_SourcePoints[3 * v + 2]);
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
 
-      std::vector<size_t> hitTriangleIds;
-      std::function<bool(size_t)> func = [&](size_t triangleIndex) {
-        hitTriangleIds.push_back(triangleIndex);
-        return true; // keep going
+      const Vec3fa point = {m_SourcePoints[3 * v + 0], m_SourcePoints[3 * v + 1], m_SourcePoints[3 * v + 2]};
+      auto triangleDistanceSquared = [this, &point](int32 triangle) {
+        const Vec3fa diffPoint = point - closestPointTriangle(point, triangleVertex(triangle, 0), triangleVertex(triangle, 1), triangleVertex(triangle, 2));
+        return diffPoint.dot(diffPoint);
       };
 
-      int32 nhits = m_RTree.Search(sourcePoint.data(), sourcePoint.data(), func);
-      if(nhits > 0) // Point is within the RTree bounding box so just loop over those triangles that are in the RTree
-      {
-        for(const auto t : hitTriangleIds)
-        {
-          if(m_Filter->getCancel())
-          {
-            return;
-          }
-
-          auto p = static_cast<int64>(m_SharedTriangleList[t * 3 + 0]);
-          auto q = static_cast<int64>(m_SharedTriangleList[t * 3 + 1]);
-          auto r = static_cast<int64>(m_SharedTriangleList[t * 3 + 2]);
-          const Vec3fa point = {m_SourcePoints[3 * v + 0], m_SourcePoints[3 * v + 1], m_SourcePoints[3 * v + 2]};
-          const Vec3fa v0(m_TriangleVertices[p * 3 + 0], m_TriangleVertices[p * 3 + 1], m_TriangleVertices[p * 3 + 2]);
-          const Vec3fa v1(m_TriangleVertices[q * 3 + 0], m_TriangleVertices[q * 3 + 1], m_TriangleVertices[q * 3 + 2]);
-          const Vec3fa v2(m_TriangleVertices[r * 3 + 0], m_TriangleVertices[r * 3 + 1], m_TriangleVertices[r * 3 + 2]);
-
-          float32 d = PointTriangleDistance(point, v0, v1, v2, static_cast<int64>(t), m_Normals);
-
-          if(std::abs(d) < std::abs(m_Distances[v]))
-          {
-            m_Distances[v] = d;
-            m_ClosestTri[v] = static_cast<int64>(t);
-          }
-        }
-      }
-      else // Point was not in the RTree, so we need to search against every triangle
+      // The squared distance is unsigned here, the sign only depends on the normal of the closest triangle
+      float32 distanceSquared = std::numeric_limits<float32>::max();
+      const int32 closestTriangle = m_Bvh.findNearest(Point3Df(point[0], point[1], point[2]), triangleDistanceSquared, distanceSquared);
+
+      float32 distance = std::numeric_limits<float32>::max();
+      if(closestTriangle >= 0)
       {
-        for(size_t t = 0; t < numTuples; t++)
-        {
-          if(m_Filter->getCancel())
-          {
-            return;
-          }
-
-          auto p = static_cast<int64>(m_SharedTriangleList[t * 3 + 0]);
-          auto q = static_cast<int64>(m_SharedTriangleList[t * 3 + 1]);
-          auto r = static_cast<int64>(m_SharedTriangleList[t * 3 + 2]);
-          const Vec3fa point = {m_SourcePoints[3 * v + 0], m_SourcePoints[3 * v + 1], m_SourcePoints[3 * v + 2]};
-          const Vec3fa v0(m_TriangleVertices[p * 3 + 0], m_TriangleVertices[p * 3 + 1], m_TriangleVertices[p * 3 + 2]);
-          const Vec3fa v1(m_TriangleVertices[q * 3 + 0], m_TriangleVertices[q * 3 + 1], m_TriangleVertices[q * 3 + 2]);
-          const Vec3fa v2(m_TriangleVertices[r * 3 + 0], m_TriangleVertices[r * 3 + 1], m_TriangleVertices[r * 3 + 2]);
-
-          float32 d = PointTriangleDistance(point, v0, v1, v2, static_cast<int64>(t), m_Normals);
-
-          if(std::abs(d) < std::abs(m_Distances[v]))
-          {
-            m_Distances[v] = d;
-            m_ClosestTri[v] = static_cast<int64>(t);
-          }
-        }
+        distance = PointTriangleDistance(point, triangleVertex(closestTriangle, 0), triangleVertex(closestTriangle, 1), triangleVertex(closestTriangle, 2), closestTriangle, m_Normals);
+        m_ClosestTri[v] = closestTriangle;
       }
 
-      if(m_Distances[v] >= 0.0f)
+      if(distance >= 0.0f)
       {
-        m_Distances[v] = std::sqrt(m_Distances[v]);
+        m_Distances[v] = std::sqrt(distance);
       }
       else
       {
-        m_Distances[v] *= -1.0f;
-        m_Distances[v] = std::sqrt(m_Distances[v]);
-        m_Distances[v] *= -1.0f;
+        m_Distances[v] = -std::sqrt(-distance);
       }
 
       if(counter > progIncrement)
@@ -414,6 +372,12 @@ public:
   }
 
 private:
+  Vec3fa triangleVertex(int32 triangle, usize corner) const
+  {
+    const auto vertex = static_cast<usize>(m_SharedTriangleList[static_cast<usize>(triangle) * 3 + corner]);
+    return {m_TriangleVertices[vertex * 3 + 0], m_TriangleVertices[vertex * 3 + 1], m_TriangleVertices[vertex * 3 + 2]};
+  }
+
   FindVertexToTriangleDistances* m_Filter;
   const IGeometry::SharedTriList& m_SharedTriangleList;
   const IGeometry::SharedVertexList& m_TriangleVertices;
@@ -421,7 +385,7 @@ private:
   Float32Array& m_Distances;
   Int64Array& m_ClosestTri;
   const Float64Array& m_Normals;
-  const RTreeType m_RTree;
+  const TriangleBVH& m_Bvh;
 };
 } // namespace
 
@@ -463,7 +427,7 @@ void FindVertexToTriangleDistances::sendThreadSafeProgressMessage(usize counter)
   m_LastProgressInt = progressInt;
 }
 
-void GetBoundingBoxAtTri(const IGeometry::SharedTriList& triList, const IGeometry::SharedVertexList& vertList, size_t triId, nonstd::span<float> bounds)
+BoundingBox3Df GetBoundingBoxAtTri(const IGeometry::SharedTriList& triList, const IGeometry::SharedVertexList& vertList, size_t triId)
 {
   size_t v0Index = triList[triId * 3 + 0] * 3;
   size_t v1Index = triList[triId * 3 + 1] * 3;
@@ -472,12 +436,7 @@ void GetBoundingBoxAtTri(const IGeometry::SharedTriList& triList, const IGeometr
   auto xMinMax = std::minmax({vertList[v0Index + 0], vertList[v1Index + 0], vertList[v2Index + 0]});
   auto yMinMax = std::minmax({vertList[v0Index + 1], vertList[v1Index + 1], vertList[v2Index + 1]});
   auto zMinMax = std::minmax({vertList[v0Index + 2], vertList[v1Index + 2], vertList[v2Index + 2]});
-  bounds[0] = xMinMax.first;
-  bounds[1] = yMinMax.first;
-  bounds[2] = zMinMax.first;
-  bounds[3] = xMinMax.second;
-  bounds[4] = yMinMax.second;
-  bounds[5] = zMinMax.second;
+  return {Point3Df(xMinMax.first, yMinMax.first, zMinMax.first), Point3Df(xMinMax.second, yMinMax.second, zMinMax.second)};
 }
 
 // -----------------------------------------------------------------------------
@@ -492,14 +451,16 @@ Result<> FindVertexToTriangleDistances::operator()()
   IGeometry::SharedTriList& triangles = triangleGeom.getFacesRef();
   IGeometry::SharedVertexList& vertices = triangleGeom.getVerticesRef();
 
-  RTreeType m_RTree;
-  // Populate the RTree
-  std::vector<float> triBoundsArray(numTris * 6, 0.0F);
+  // Build the hierarchy once, every task queries the same instance
+  std::vector<BoundingBox3Df> triBounds;
+  triBounds.reserve(numTris);
   for(size_t triIndex = 0; triIndex < numTris; triIndex++)
   {
-    GetBoundingBoxAtTri(triangles, vertices, triIndex, {triBoundsArray.data() + (6 * triIndex), 6});
-    m_RTree.Insert(triBoundsArray.data() + (6 * triIndex), triBoundsArray.data() + (6 * triIndex) + 3, triIndex); // Note, all values including zero are fine in this version
+    triBounds.push_back(GetBoundingBoxAtTri(triangles, vertices, triIndex));
   }
+  std::vector<int32> triIds(numTris);
+  std::iota(triIds.begin(), triIds.end(), 0);
+  const TriangleBVH bvh(triIds, triBounds);
 
   const auto& normalsArray = m_DataStructure.getDataRefAs<Float64Array>(m_InputValues->TriangleNormalsArrayPath);
   auto& distancesArray = m_DataStructure.getDataRefAs<Float32Array>(m_InputValues->DistancesArrayPath);
@@ -511,7 +472,7 @@ Result<> FindVertexToTriangleDistances::operator()()
   ParallelDataAlgorithm dataAlg;
   dataAlg.setParallelizationEnabled(true);
   dataAlg.setRange(0, m_TotalElements);
-  dataAlg.execute(FindVertexToTriangleDistancesImpl(this, triangles, vertices, sourceVertices, distancesArray, closestTriangleIdsArray, normalsArray, m_RTree));
+  dataAlg.execute(FindVertexToTriangleDistancesImpl(this, triangles, vertices, sourceVertices, distancesArray, closestTriangleIdsArray, normalsArray, bvh));
 
   return {};
 }
@@ -3,19 +3,32 @@
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/Utilities/FilterUtilities.hpp"
 #include "complex/Utilities/KUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
+#include <algorithm>
 #include <random>
 
 using namespace complex;
 
 namespace
 {
+/**
+ * @brief Per block results of one assignment pass. The blocks are reduced in
+ * order so the means do not depend on how the blocks were scheduled.
+ */
+struct AssignmentSums
+{
+  std::vector<float64> sums;
+  std::vector<usize> counts;
+  std::vector<usize> changed;
+};
+
 template <typename T>
 class KMeansTemplate
 {
 public:
   KMeansTemplate(KMeans* filter, const IDataArray& inputIDataArray, IDataArray& meansIDataArray, const BoolArray& maskDataArray, usize numClusters, Int32Array& fIds,
-                 KUtilities::DistanceMetric distMetric, std::mt19937_64::result_type seed)
+                 KUtilities::DistanceMetric distMetric, KUtilities::InitializationMethod initMethod, std::mt19937_64::result_type seed)
   : m_Filter(filter)
   , m_InputArray(dynamic_cast<const DataArrayT&>(inputIDataArray))
   , m_Means(dynamic_cast<DataArrayT&>(meansIDataArray))
@@ -23,6 +36,7 @@ public:
   , m_NumClusters(numClusters)
   , m_FeatureIds(fIds)
   , m_DistMetric(distMetric)
+  , m_InitMethod(initMethod)
   , m_Seed(seed)
   {
   }
@@ -34,147 +48,264 @@ public:
   // -----------------------------------------------------------------------------
   void operator()()
   {
-    usize numTuples = m_InputArray.getNumberOfTuples();
-    int32 numCompDims = m_InputArray.getNumberOfComponents();
+    KUtilities::RunWithDistanceMetric(m_DistMetric, [this](auto metric) { cluster<decltype(metric)::value>(); });
+  }
 
-    const usize rangeMax = numTuples - 1;
+private:
+  using DataArrayT = DataArray<T>;
+  KMeans* m_Filter;
+  const DataArrayT& m_InputArray;
+  DataArrayT& m_Means;
+  const BoolArray& m_Mask;
+  usize m_NumClusters;
+  Int32Array& m_FeatureIds;
+  KUtilities::DistanceMetric m_DistMetric;
+  KUtilities::InitializationMethod m_InitMethod;
+  std::mt19937_64::result_type m_Seed;
 
-    std::mt19937_64 gen(m_Seed);
-    std::uniform_real_distribution<float64> dist(0.0, 1.0);
+  // -----------------------------------------------------------------------------
+  template <KUtilities::DistanceMetric Metric>
+  void cluster()
+  {
+    // Euclidean distances obey the triangle inequality, so Hamerly's bounds can skip
+    // most distance computations. Squared Euclidean has the same closest center.
+    constexpr bool k_UseBounds = Metric == KUtilities::Euclidean || Metric == KUtilities::SquaredEuclidean;
 
-    std::vector<usize> clusterIdxs(m_NumClusters);
+    const usize numTuples = m_InputArray.getNumberOfTuples();
+    const usize numCompDims = m_InputArray.getNumberOfComponents();
+    const auto inputValues = m_InputArray.getDataStoreRef().borrowRange(0, numTuples * numCompDims);
+    const auto maskValues = m_Mask.getDataStoreRef().borrowRange(0, numTuples);
+    const T* values = inputValues.data();
+    const bool* mask = maskValues.data();
 
-    usize clusterChoices = 0;
-    while(clusterChoices < m_NumClusters)
+    std::mt19937_64 gen(m_Seed);
+    std::vector<usize> clusterIdxs(m_NumClusters);
+    if(m_InitMethod == KUtilities::KMeansPlusPlus)
     {
-      usize index = std::floor(dist(gen) * static_cast<float64>(rangeMax));
-      if(m_Mask[index])
+      clusterIdxs = KUtilities::SelectKMeansPlusPlusSeeds<Metric>(values, mask, numTuples, numCompDims, m_NumClusters, gen);
+      if(clusterIdxs.size() != m_NumClusters)
       {
-        clusterIdxs[clusterChoices] = index;
-        clusterChoices++;
+        return;
       }
     }
-
-    for(usize i = 0; i < m_NumClusters; i++)
+    else
     {
-      for(int32 j = 0; j < numCompDims; j++)
+      const usize rangeMax = numTuples - 1;
+      std::uniform_real_distribution<float64> dist(0.0, 1.0);
+      usize clusterChoices = 0;
+      while(clusterChoices < m_NumClusters)
       {
-        m_Means[numCompDims * (i + 1) + j] = m_InputArray[numCompDims * clusterIdxs[i] + j];
+        usize index = std::floor(dist(gen) * static_cast<float64>(rangeMax));
+        if(mask[index])
+        {
+          clusterIdxs[clusterChoices] = index;
+          clusterChoices++;
+        }
       }
     }
 
-    std::vector<float64> oldMeans(m_NumClusters);
-    std::vector<float64> differences(m_NumClusters);
+    std::vector<T> means(numCompDims * (m_NumClusters + 1), static_cast<T>(0));
+    for(usize i = 0; i < m_NumClusters; i++)
+    {
+      std::copy_n(values + numCompDims * clusterIdxs[i], numCompDims, means.begin() + numCompDims * (i + 1));
+    }
+
+    auto featureIdValues = m_FeatureIds.getDataStoreRef().borrowRange(0, numTuples);
+    int32* featureIds = featureIdValues.data();
+
+    const usize blockSize = KUtilities::GetBlockSize(numTuples);
+    const usize numBlocks = (numTuples + blockSize - 1) / blockSize;
+    AssignmentSums blockSums;
+    blockSums.sums.resize(numBlocks * (m_NumClusters + 1) * numCompDims);
+    blockSums.counts.resize(numBlocks * (m_NumClusters + 1));
+    blockSums.changed.resize(numBlocks);
+
+    // Upper bound on the distance to the assigned center and lower bound on the distance to every other center
+    std::vector<float64> upperBounds(k_UseBounds ? numTuples : 0, 0.0);
+    std::vector<float64> lowerBounds(k_UseBounds ? numTuples : 0, 0.0);
+    std::vector<float64> centerShifts(m_NumClusters + 1, 0.0);
+    std::vector<float64> halfCenterGaps(m_NumClusters + 1, 0.0);
+
+    std::vector<T> oldMeans(means.size());
     usize iteration = 1;
-    usize updateCheck = 0;
-    while(updateCheck != m_NumClusters)
+    while(true)
     {
       if(m_Filter->getCancel())
       {
         return;
       }
-      findClusters(numTuples, numCompDims);
 
-      for(usize i = 0; i < m_NumClusters; i++)
+      if constexpr(k_UseBounds)
       {
-        oldMeans[i] = m_Means[i + 1];
+        findHalfCenterGaps(means, numCompDims, halfCenterGaps);
       }
-
-      findMeans(numTuples, numCompDims);
-
-      updateCheck = 0;
-      for(usize i = 0; i < m_NumClusters; i++)
+      // Largest and second largest center shift, so each tuple can exclude its own center
+      usize maxShiftCluster = 0;
+      float64 maxShift = 0.0;
+      float64 secondMaxShift = 0.0;
+      for(usize j = 1; j <= m_NumClusters; j++)
       {
-        differences[i] = oldMeans[i] - m_Means[i + 1];
-        if(closeEnough<float64>(differences[i], 0.0))
+        if(centerShifts[j] > maxShift)
         {
-          updateCheck++;
+          secondMaxShift = maxShift;
+          maxShift = centerShifts[j];
+          maxShiftCluster = j;
+        }
+        else if(centerShifts[j] > secondMaxShift)
+        {
+          secondMaxShift = centerShifts[j];
+        }
+      }
+
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, numBlocks);
+      dataAlg.execute([&](const Range& range) {
+        for(usize block = range.min(); block < range.max(); block++)
+        {
+          if(m_Filter->getCancel())
+          {
+            return;
+          }
+          float64* sums = blockSums.sums.data() + block * (m_NumClusters + 1) * numCompDims;
+          usize* counts = blockSums.counts.data() + block * (m_NumClusters + 1);
+          std::fill_n(sums, (m_NumClusters + 1) * numCompDims, 0.0);
+          std::fill_n(counts, m_NumClusters + 1, 0);
+          usize changed = 0;
+
+          const usize end = std::min(numTuples, (block + 1) * blockSize);
+          for(usize i = block * blockSize; i < end; i++)
+          {
+            const T* point = values + numCompDims * i;
+            int32 featureId = featureIds[i];
+            if(mask[i])
+            {
+              bool assigned = false;
+              if constexpr(k_UseBounds)
+              {
+                if(featureId > 0)
+                {
+                  upperBounds[i] += centerShifts[featureId];
+                  lowerBounds[i] -= (static_cast<usize>(featureId) == maxShiftCluster ? secondMaxShift : maxShift);
+                  const float64 bound = std::max(halfCenterGaps[featureId], lowerBounds[i]);
+                  if(upperBounds[i] < bound)
+                  {
+                    assigned = true;
+                  }
+                  else
+                  {
+                    upperBounds[i] = KUtilities::GetDistance<KUtilities::Euclidean>(point, 0, means, numCompDims * featureId, numCompDims);
+                    assigned = upperBounds[i] < bound;
+                  }
+                }
+              }
+              if(!assigned)
+              {
+                float64 minDist = 0.0;
+                float64 secondDist = 0.0;
+                const int32 closest = KUtilities::FindClosestCenter<Metric>(point, means.data(), m_NumClusters, numCompDims, minDist, secondDist);
+                if(closest > 0)
+                {
+                  if(closest != featureId)
+                  {
+                    changed++;
+                  }
+                  featureId = closest;
+                  featureIds[i] = closest;
+                }
+                if constexpr(k_UseBounds)
+                {
+                  if constexpr(Metric == KUtilities::SquaredEuclidean)
+                  {
+                    minDist = std::sqrt(minDist);
+                    secondDist = std::sqrt(secondDist);
+                  }
+                  upperBounds[i] = minDist;
+                  lowerBounds[i] = secondDist;
+                }
+              }
+            }
+
+            // Tuples outside the mask keep their id and are averaged into cluster 0
+            counts[featureId]++;
+            for(usize j = 0; j < numCompDims; j++)
+            {
+              sums[numCompDims * featureId + j] += static_cast<float64>(point[j]);
+            }
+          }
+          blockSums.changed[block] = changed;
         }
+      });
+      if(m_Filter->getCancel())
+      {
+        return;
       }
 
-      float64 sum = std::accumulate(std::begin(differences), std::end(differences), 0.0);
+      oldMeans = means;
+      const usize changed = findMeans(blockSums, numBlocks, numCompDims, means);
+
+      float64 sum = 0.0;
+      for(usize j = 1; j <= m_NumClusters; j++)
+      {
+        centerShifts[j] = KUtilities::GetDistance<KUtilities::Euclidean>(oldMeans, numCompDims * j, means, numCompDims * j, numCompDims);
+        sum += centerShifts[j];
+      }
       m_Filter->updateProgress(fmt::format("Clustering Data || Iteration {} || Total Mean Shift: {}", iteration, sum));
       iteration++;
-    }
-  }
 
-private:
-  using DataArrayT = DataArray<T>;
-  KMeans* m_Filter;
-  const DataArrayT& m_InputArray;
-  DataArrayT& m_Means;
-  const BoolArray& m_Mask;
-  usize m_NumClusters;
-  Int32Array& m_FeatureIds;
-  KUtilities::DistanceMetric m_DistMetric;
-  std::mt19937_64::result_type m_Seed;
+      // The means only move when a tuple changed cluster
+      if(changed == 0)
+      {
+        break;
+      }
+    }
 
-  // -----------------------------------------------------------------------------
-  template <typename K>
-  bool closeEnough(const K& a, const K& b, const K& epsilon = std::numeric_limits<K>::epsilon())
-  {
-    return (epsilon > fabs(a - b));
+    m_Means.getDataStoreRef().copyFromBuffer(0, nonstd::span<const T>(means.data(), means.size()));
   }
 
   // -----------------------------------------------------------------------------
-  void findClusters(usize tuples, int32 dims)
+  void findHalfCenterGaps(const std::vector<T>& means, usize dims, std::vector<float64>& halfCenterGaps) const
   {
-    for(usize i = 0; i < tuples; i++)
+    std::fill(halfCenterGaps.begin(), halfCenterGaps.end(), std::numeric_limits<float64>::max());
+    for(usize i = 1; i <= m_NumClusters; i++)
     {
-      if(m_Filter->getCancel())
+      for(usize j = i + 1; j <= m_NumClusters; j++)
       {
-        return;
-      }
-      if(m_Mask[i])
-      {
-        float64 minDist = std::numeric_limits<float64>::max();
-        for(int32 j = 0; j < m_NumClusters; j++)
-        {
-          float64 dist = KUtilities::GetDistance(m_InputArray, (dims * i), m_Means, (dims * (j + 1)), dims, m_DistMetric);
-          if(dist < minDist)
-          {
-            minDist = dist;
-            m_FeatureIds[i] = j + 1;
-          }
-        }
+        const float64 halfDist = 0.5 * KUtilities::GetDistance<KUtilities::Euclidean>(means, dims * i, means, dims * j, dims);
+        halfCenterGaps[i] = std::min(halfCenterGaps[i], halfDist);
+        halfCenterGaps[j] = std::min(halfCenterGaps[j], halfDist);
       }
     }
   }
 
   // -----------------------------------------------------------------------------
-  void findMeans(usize tuples, int32 dims)
+  usize findMeans(const AssignmentSums& blockSums, usize numBlocks, usize dims, std::vector<T>& means) const
   {
+    std::vector<float64> sums((m_NumClusters + 1) * dims, 0.0);
     std::vector<usize> counts(m_NumClusters + 1, 0);
-
-    for(usize i = 0; i <= m_NumClusters; i++)
+    usize changed = 0;
+    for(usize block = 0; block < numBlocks; block++)
     {
-      for(usize j = 0; j < dims; j++)
+      const float64* blockSum = blockSums.sums.data() + block * (m_NumClusters + 1) * dims;
+      const usize* blockCount = blockSums.counts.data() + block * (m_NumClusters + 1);
+      for(usize i = 0; i < sums.size(); i++)
+      {
+        sums[i] += blockSum[i];
+      }
+      for(usize i = 0; i <= m_NumClusters; i++)
       {
-        m_Means[dims * i + j] = 0.0;
+        counts[i] += blockCount[i];
       }
+      changed += blockSums.changed[block];
     }
 
-    for(usize i = 0; i < dims; i++)
+    for(usize i = 0; i <= m_NumClusters; i++)
     {
-      for(usize j = 0; j < tuples; j++)
-      {
-        int32 feature = m_FeatureIds[j];
-        m_Means[dims * feature + i] += static_cast<float64>(m_InputArray[dims * j + i]);
-        counts[feature] += 1;
-      }
-      for(usize j = 0; j <= m_NumClusters; j++)
+      for(usize j = 0; j < dims; j++)
       {
-        if(counts[j] == 0)
-        {
-          m_Means[dims * j + i] = 0.0;
-        }
-        else
-        {
-          m_Means[dims * j + i] /= static_cast<float64>(counts[j]);
-        }
+        means[dims * i + j] = counts[i] == 0 ? static_cast<T>(0) : static_cast<T>(sums[dims * i + j] / static_cast<float64>(counts[i]));
       }
-      std::fill(std::begin(counts), std::end(counts), 0);
     }
+    return changed;
   }
 };
 } // namespace
@@ -209,7 +340,8 @@ Result<> KMeans::operator()()
   auto& clusteringArray = m_DataStructure.getDataRefAs<IDataArray>(m_InputValues->ClusteringArrayPath);
   RunTemplateClass<KMeansTemplate, types::NoBooleanType>(clusteringArray.getDataType(), this, clusteringArray, m_DataStructure.getDataRefAs<IDataArray>(m_InputValues->MeansArrayPath),
                                                          m_DataStructure.getDataRefAs<BoolArray>(m_InputValues->MaskArrayPath), m_InputValues->InitClusters,
-                                                         m_DataStructure.getDataRefAs<Int32Array>(m_InputValues->FeatureIdsArrayPath), m_InputValues->DistanceMetric, m_InputValues->Seed);
+                                                         m_DataStructure.getDataRefAs<Int32Array>(m_InputValues->FeatureIdsArrayPath), m_InputValues->DistanceMetric, m_InputValues->InitializationMethod,
+                                                         m_InputValues->Seed);
 
   return {};
 }
@@ -18,6 +18,7 @@ struct COMPLEXCORE_EXPORT KMeansInputValues
 {
   uint64 InitClusters;
   KUtilities::DistanceMetric DistanceMetric;
+  KUtilities::InitializationMethod InitializationMethod;
   DataPath ClusteringArrayPath;
   DataPath MaskArrayPath;
   DataPath FeatureIdsArrayPath;
@@ -3,7 +3,10 @@
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/Utilities/FilterUtilities.hpp"
 #include "complex/Utilities/KUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
+#include <algorithm>
+#include <numeric>
 #include <random>
 
 using namespace complex;
@@ -15,7 +18,7 @@ class KMedoidsTemplate
 {
 public:
   KMedoidsTemplate(KMedoids* filter, const IDataArray& inputIDataArray, IDataArray& medoidsIDataArray, const BoolArray& maskDataArray, usize numClusters, Int32Array& fIds,
-                   KUtilities::DistanceMetric distMetric, std::mt19937_64::result_type seed)
+                   KUtilities::DistanceMetric distMetric, KUtilities::InitializationMethod initMethod, std::mt19937_64::result_type seed)
   : m_Filter(filter)
   , m_InputArray(dynamic_cast<const DataArrayT&>(inputIDataArray))
   , m_Medoids(dynamic_cast<DataArrayT&>(medoidsIDataArray))
@@ -23,6 +26,7 @@ public:
   , m_NumClusters(numClusters)
   , m_FeatureIds(fIds)
   , m_DistMetric(distMetric)
+  , m_InitMethod(initMethod)
   , m_Seed(seed)
   {
   }
@@ -34,49 +38,90 @@ public:
   // -----------------------------------------------------------------------------
   void operator()()
   {
-    usize numTuples = m_InputArray.getNumberOfTuples();
-    int32 numCompDims = m_InputArray.getNumberOfComponents();
+    KUtilities::RunWithDistanceMetric(m_DistMetric, [this](auto metric) { cluster<decltype(metric)::value>(); });
+  }
 
-    std::mt19937_64 gen(m_Seed);
-    std::uniform_int_distribution<usize> dist(0, numTuples - 1);
+private:
+  using DataArrayT = DataArray<T>;
+  KMedoids* m_Filter;
+  const DataArrayT& m_InputArray;
+  DataArrayT& m_Medoids;
+  const BoolArray& m_Mask;
+  usize m_NumClusters;
+  Int32Array& m_FeatureIds;
+  KUtilities::DistanceMetric m_DistMetric;
+  KUtilities::InitializationMethod m_InitMethod;
+  std::mt19937_64::result_type m_Seed;
 
-    std::vector<usize> clusterIdxs(m_NumClusters);
+  const T* m_Values = nullptr;
+  const bool* m_MaskValues = nullptr;
+  int32* m_FeatureIdValues = nullptr;
+  std::vector<T> m_MedoidValues;
+
+  // -----------------------------------------------------------------------------
+  template <KUtilities::DistanceMetric Metric>
+  void cluster()
+  {
+    const usize numTuples = m_InputArray.getNumberOfTuples();
+    const usize numCompDims = m_InputArray.getNumberOfComponents();
+    const auto inputValues = m_InputArray.getDataStoreRef().borrowRange(0, numTuples * numCompDims);
+    const auto maskValues = m_Mask.getDataStoreRef().borrowRange(0, numTuples);
+    auto featureIdValues = m_FeatureIds.getDataStoreRef().borrowRange(0, numTuples);
+    m_Values = inputValues.data();
+    m_MaskValues = maskValues.data();
+    m_FeatureIdValues = featureIdValues.data();
 
-    usize clusterChoices = 0;
-    while(clusterChoices < m_NumClusters)
+    std::mt19937_64 gen(m_Seed);
+    std::vector<usize> clusterIdxs(m_NumClusters);
+    if(m_InitMethod == KUtilities::KMeansPlusPlus)
     {
-      usize index = dist(gen);
-      if(m_Mask[index])
+      clusterIdxs = KUtilities::SelectKMeansPlusPlusSeeds<Metric>(m_Values, m_MaskValues, numTuples, numCompDims, m_NumClusters, gen);
+      if(clusterIdxs.size() != m_NumClusters)
       {
-        clusterIdxs[clusterChoices] = index;
-        clusterChoices++;
+        return;
       }
     }
-
-    for(usize i = 0; i < m_NumClusters; i++)
+    else
     {
-      for(int32 j = 0; j < numCompDims; j++)
+      std::uniform_int_distribution<usize> dist(0, numTuples - 1);
+      usize clusterChoices = 0;
+      while(clusterChoices < m_NumClusters)
       {
-        m_Medoids[numCompDims * (i + 1) + j] = m_InputArray[numCompDims * clusterIdxs[i] + j];
+        usize index = dist(gen);
+        if(m_MaskValues[index])
+        {
+          clusterIdxs[clusterChoices] = index;
+          clusterChoices++;
+        }
       }
     }
 
-    findClusters(numTuples, numCompDims);
+    m_MedoidValues.assign(numCompDims * (m_NumClusters + 1), static_cast<T>(0));
+    for(usize i = 0; i < m_NumClusters; i++)
+    {
+      std::copy_n(m_Values + numCompDims * clusterIdxs[i], numCompDims, m_MedoidValues.begin() + numCompDims * (i + 1));
+    }
+
+    findClusters<Metric>(numTuples, numCompDims);
 
     std::vector<usize> optClusterIdxs(clusterIdxs);
 
-    std::vector<float64> costs = optimizeClusters(numTuples, numCompDims, clusterIdxs);
+    std::vector<float64> costs = optimizeClusters<Metric>(numTuples, numCompDims, clusterIdxs);
 
     bool update = optClusterIdxs == clusterIdxs ? false : true;
     usize iteration = 1;
 
     while(update)
     {
-      findClusters(numTuples, numCompDims);
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      findClusters<Metric>(numTuples, numCompDims);
 
       optClusterIdxs = clusterIdxs;
 
-      costs = optimizeClusters(numTuples, numCompDims, clusterIdxs);
+      costs = optimizeClusters<Metric>(numTuples, numCompDims, clusterIdxs);
 
       update = optClusterIdxs == clusterIdxs ? false : true;
 
@@ -84,94 +129,113 @@ public:
       m_Filter->updateProgress(fmt::format("Clustering Data || Iteration {} || Total Cost: {}", iteration, sum));
       iteration++;
     }
-  }
 
-private:
-  using DataArrayT = DataArray<T>;
-  KMedoids* m_Filter;
-  const DataArrayT& m_InputArray;
-  DataArrayT& m_Medoids;
-  const BoolArray& m_Mask;
-  usize m_NumClusters;
-  Int32Array& m_FeatureIds;
-  KUtilities::DistanceMetric m_DistMetric;
-  std::mt19937_64::result_type m_Seed;
+    m_Medoids.getDataStoreRef().copyFromBuffer(0, nonstd::span<const T>(m_MedoidValues.data(), m_MedoidValues.size()));
+  }
 
   // -----------------------------------------------------------------------------
-  void findClusters(usize tuples, int32 dims)
+  template <KUtilities::DistanceMetric Metric>
+  void findClusters(usize tuples, usize dims)
   {
-    for(usize i = 0; i < tuples; i++)
-    {
-      if(m_Filter->getCancel())
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, tuples);
+    dataAlg.execute([this, dims](const Range& range) {
+      float64 minDist = 0.0;
+      float64 secondDist = 0.0;
+      for(usize i = range.min(); i < range.max(); i++)
       {
-        return;
-      }
-      if(m_Mask[i])
-      {
-        float64 minDist = std::numeric_limits<float64>::max();
-        for(int32 j = 0; j < m_NumClusters; j++)
+        if(m_Filter->getCancel())
+        {
+          return;
+        }
+        if(m_MaskValues[i])
         {
-          float64 dist = KUtilities::GetDistance(m_InputArray, (dims * i), m_Medoids, (dims * (j + 1)), dims, m_DistMetric);
-          if(dist < minDist)
+          const int32 closest = KUtilities::FindClosestCenter<Metric>(m_Values + dims * i, m_MedoidValues.data(), m_NumClusters, dims, minDist, secondDist);
+          if(closest > 0)
           {
-            minDist = dist;
-            m_FeatureIds[i] = j + 1;
+            m_FeatureIdValues[i] = closest;
           }
         }
       }
-    }
+    });
   }
 
   // -----------------------------------------------------------------------------
-  std::vector<float64> optimizeClusters(usize tuples, int32 dims, std::vector<usize>& clusterIdxs)
+  template <KUtilities::DistanceMetric Metric>
+  std::vector<float64> optimizeClusters(usize tuples, usize dims, std::vector<usize>& clusterIdxs)
   {
     std::vector<float64> minCosts(m_NumClusters, std::numeric_limits<float64>::max());
 
+    // Group the masked tuples by cluster so each cost only visits the members of its cluster
+    std::vector<usize> memberOffsets(m_NumClusters + 2, 0);
+    for(usize i = 0; i < tuples; i++)
+    {
+      if(m_MaskValues[i])
+      {
+        memberOffsets[m_FeatureIdValues[i] + 1]++;
+      }
+    }
+    for(usize i = 1; i < memberOffsets.size(); i++)
+    {
+      memberOffsets[i] += memberOffsets[i - 1];
+    }
+    std::vector<usize> members(memberOffsets.back());
+    std::vector<usize> insertPositions(memberOffsets.begin(), memberOffsets.end() - 1);
+    for(usize i = 0; i < tuples; i++)
+    {
+      if(m_MaskValues[i])
+      {
+        members[insertPositions[m_FeatureIdValues[i]]++] = i;
+      }
+    }
+
+    std::vector<float64> costs;
     for(usize i = 0; i < m_NumClusters; i++)
     {
       if(m_Filter->getCancel())
       {
         return {};
       }
-      for(usize j = 0; j < tuples; j++)
-      {
-        if(m_Filter->getCancel())
-        {
-          return {};
-        }
-        if(m_Mask[j])
+      const usize* clusterMembers = members.data() + memberOffsets[i + 1];
+      const usize numMembers = memberOffsets[i + 2] - memberOffsets[i + 1];
+      costs.assign(numMembers, 0.0);
+
+      // The cost of each candidate medoid is the sum of the distances to every member of the cluster
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, numMembers);
+      dataAlg.execute([&](const Range& range) {
+        for(usize j = range.min(); j < range.max(); j++)
         {
-          if(m_FeatureIds[j] == i + 1)
+          if(m_Filter->getCancel())
+          {
+            return;
+          }
+          float64 cost = 0.0;
+          for(usize k = 0; k < numMembers; k++)
           {
-            float64 cost = 0.0;
-            for(usize k = 0; k < tuples; k++)
-            {
-              if(m_Filter->getCancel())
-              {
-                return {};
-              }
-              if(m_FeatureIds[k] == i + 1 && m_Mask[k])
-              {
-                cost += KUtilities::GetDistance(m_InputArray, (dims * k), m_InputArray, (dims * j), dims, m_DistMetric);
-              }
-            }
-
-            if(cost < minCosts[i])
-            {
-              minCosts[i] = cost;
-              clusterIdxs[i] = j;
-            }
+            cost += KUtilities::GetDistance<Metric>(m_Values, dims * clusterMembers[k], m_Values, dims * clusterMembers[j], dims);
           }
+          costs[j] = cost;
+        }
+      });
+      if(m_Filter->getCancel())
+      {
+        return {};
+      }
+
+      for(usize j = 0; j < numMembers; j++)
+      {
+        if(costs[j] < minCosts[i])
+        {
+          minCosts[i] = costs[j];
+          clusterIdxs[i] = clusterMembers[j];
         }
       }
     }
 
     for(usize i = 0; i < m_NumClusters; i++)
     {
-      for(int32 j = 0; j < dims; j++)
-      {
-        m_Medoids[dims * (i + 1) + j] = m_InputArray[dims * clusterIdxs[i] + j];
-      }
+      std::copy_n(m_Values + dims * clusterIdxs[i], dims, m_MedoidValues.begin() + dims * (i + 1));
     }
 
     return minCosts;
@@ -209,7 +273,8 @@ Result<> KMedoids::operator()()
   auto& clusteringArray = m_DataStructure.getDataRefAs<IDataArray>(m_InputValues->ClusteringArrayPath);
   RunTemplateClass<KMedoidsTemplate, types::NoBooleanType>(clusteringArray.getDataType(), this, clusteringArray, m_DataStructure.getDataRefAs<IDataArray>(m_InputValues->MedoidsArrayPath),
                                                            m_DataStructure.getDataRefAs<BoolArray>(m_InputValues->MaskArrayPath), m_InputValues->InitClusters,
-                                                           m_DataStructure.getDataRefAs<Int32Array>(m_InputValues->FeatureIdsArrayPath), m_InputValues->DistanceMetric, m_InputValues->Seed);
+                                                           m_DataStructure.getDataRefAs<Int32Array>(m_InputValues->FeatureIdsArrayPath), m_InputValues->DistanceMetric,
+                                                           m_InputValues->InitializationMethod, m_InputValues->Seed);
 
   return {};
 }
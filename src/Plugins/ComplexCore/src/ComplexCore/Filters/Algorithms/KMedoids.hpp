@@ -14,6 +14,7 @@ struct COMPLEXCORE_EXPORT KMedoidsInputValues
 {
   uint64 InitClusters;
   KUtilities::DistanceMetric DistanceMetric;
+  KUtilities::InitializationMethod InitializationMethod;
   DataPath ClusteringArrayPath;
   DataPath MaskArrayPath;
   DataPath FeatureIdsArrayPath;
@@ -7,7 +7,9 @@
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
 #include "complex/Utilities/ParallelData3DAlgorithm.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
+#include <algorithm>
 #include <array>
 #include <unordered_map>
 
@@ -229,6 +231,143 @@ private:
   mutable std::set<int32_t> uFeatures;
 };
 
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Describes one of the square faces of a voxel that can be written to the surface mesh. NodeOffsets are
+ * the x, y, z offsets of the face corners from the lowest corner of the voxel and Triangles index into
+ * NodeOffsets. The corner and triangle order defines the node numbering and winding of the generated mesh.
+ */
+struct VoxelFaceCase
+{
+  std::array<std::array<usize, 3>, 4> NodeOffsets;
+  std::array<std::array<usize, 3>, 2> Triangles;
+};
+
+constexpr VoxelFaceCase k_MinXFace = {{{{0, 0, 0}, {0, 1, 0}, {0, 0, 1}, {0, 1, 1}}}, {{{0, 2, 1}, {1, 2, 3}}}};
+constexpr VoxelFaceCase k_MinYFace = {{{{0, 0, 0}, {1, 0, 0}, {0, 0, 1}, {1, 0, 1}}}, {{{0, 1, 2}, {1, 3, 2}}}};
+constexpr VoxelFaceCase k_MinZFace = {{{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}}}, {{{0, 2, 1}, {1, 2, 3}}}};
+constexpr VoxelFaceCase k_MaxXFace = {{{{1, 0, 0}, {1, 1, 0}, {1, 0, 1}, {1, 1, 1}}}, {{{0, 1, 2}, {1, 3, 2}}}};
+constexpr VoxelFaceCase k_InteriorXFace = k_MaxXFace;
+constexpr VoxelFaceCase k_MaxYFace = {{{{1, 1, 0}, {0, 1, 0}, {1, 1, 1}, {0, 1, 1}}}, {{{0, 1, 2}, {1, 3, 2}}}};
+constexpr VoxelFaceCase k_InteriorYFace = {k_MaxYFace.NodeOffsets, {{{0, 2, 1}, {1, 2, 3}}}};
+constexpr VoxelFaceCase k_MaxZFace = {{{{1, 0, 1}, {0, 0, 1}, {1, 1, 1}, {0, 1, 1}}}, {{{0, 2, 1}, {1, 2, 3}}}};
+constexpr VoxelFaceCase k_InteriorZFace = {k_MaxZFace.NodeOffsets, {{{0, 1, 2}, {1, 3, 2}}}};
+
+/**
+ * @brief Calls faceFunc(faceCase, x, y, point, neighbor, isBoundary) for every voxel face in layer z that is part
+ * of the surface mesh, in the order the faces are written to the mesh. The neighbor is the voxel on the other side
+ * of an interior face and the voxel itself for faces on the outside of the volume.
+ */
+template <typename FuncT>
+void ForEachSurfaceFaceInLayer(const Int32AbstractDataStore& featureIds, const SizeVec3& dims, usize z, FuncT&& faceFunc)
+{
+  const usize xP = dims[0];
+  const usize yP = dims[1];
+  const usize zP = dims[2];
+  for(usize y = 0; y < yP; y++)
+  {
+    for(usize x = 0; x < xP; x++)
+    {
+      const usize point = (z * xP * yP) + (y * xP) + x;
+      if(x == 0)
+      {
+        faceFunc(k_MinXFace, x, y, point, point, true);
+      }
+      if(y == 0)
+      {
+        faceFunc(k_MinYFace, x, y, point, point, true);
+      }
+      if(z == 0)
+      {
+        faceFunc(k_MinZFace, x, y, point, point, true);
+      }
+      if(x == xP - 1)
+      {
+        faceFunc(k_MaxXFace, x, y, point, point, true);
+      }
+      else if(featureIds[point] != featureIds[point + 1])
+      {
+        faceFunc(k_InteriorXFace, x, y, point, point + 1, false);
+      }
+      if(y == yP - 1)
+      {
+        faceFunc(k_MaxYFace, x, y, point, point, true);
+      }
+      else if(featureIds[point] != featureIds[point + xP])
+      {
+        faceFunc(k_InteriorYFace, x, y, point, point + xP, false);
+      }
+      if(z == zP - 1)
+      {
+        faceFunc(k_MaxZFace, x, y, point, point, true);
+      }
+      else if(featureIds[point] != featureIds[point + (xP * yP)])
+      {
+        faceFunc(k_InteriorZFace, x, y, point, point + (xP * yP), false);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Returns the node grid indices of the four corners of the face of voxel (x, y, z).
+ */
+std::array<usize, 4> GetFaceNodes(const VoxelFaceCase& faceCase, usize x, usize y, usize z, usize nodeRowSize, usize nodePlaneSize)
+{
+  std::array<usize, 4> nodes = {};
+  for(usize n = 0; n < 4; n++)
+  {
+    const auto& offset = faceCase.NodeOffsets[n];
+    nodes[n] = ((z + offset[2]) * nodePlaneSize) + ((y + offset[1]) * nodeRowSize) + (x + offset[0]);
+  }
+  return nodes;
+}
+
+/**
+ * @brief Computes the node type from the features of the (up to 8) voxels surrounding the node at node grid
+ * position (x, y, z). The type is the number of distinct owners (capped at 4) where the outside of the volume
+ * counts as an owner, plus 10 if the node lies on the outside of the volume.
+ */
+int8 ComputeNodeType(const Int32AbstractDataStore& featureIds, const SizeVec3& dims, usize x, usize y, usize z)
+{
+  std::array<int32, 9> owners = {};
+  usize numOwners = 0;
+  bool onBoundary = false;
+  auto addOwner = [&](int32 owner) {
+    if(std::find(owners.begin(), owners.begin() + numOwners, owner) == owners.begin() + numOwners)
+    {
+      owners[numOwners++] = owner;
+    }
+  };
+  for(usize dz = 0; dz < 2; dz++)
+  {
+    for(usize dy = 0; dy < 2; dy++)
+    {
+      for(usize dx = 0; dx < 2; dx++)
+      {
+        if(x + dx == 0 || y + dy == 0 || z + dz == 0 || x + dx > dims[0] || y + dy > dims[1] || z + dz > dims[2])
+        {
+          onBoundary = true;
+          continue;
+        }
+        const usize voxel = ((z + dz - 1) * dims[0] * dims[1]) + ((y + dy - 1) * dims[0]) + (x + dx - 1);
+        addOwner(featureIds[voxel]);
+      }
+    }
+  }
+  if(onBoundary)
+  {
+    addOwner(-1);
+  }
+  auto nodeType = static_cast<int8>(std::min<usize>(numOwners, 4));
+  if(onBoundary)
+  {
+    nodeType += 10;
+  }
+  return nodeType;
+}
+
 } // namespace
 
 // -----------------------------------------------------------------------------
@@ -259,20 +398,19 @@ Result<> QuickSurfaceMesh::operator()()
   size_t yP = udims[1];
   size_t zP = udims[2];
 
-  std::vector<std::set<int32_t>> ownerLists;
-
   size_t possibleNumNodes = (xP + 1) * (yP + 1) * (zP + 1);
   std::vector<MeshIndexType> nodeIds(possibleNumNodes, std::numeric_limits<size_t>::max());
 
   MeshIndexType nodeCount = 0;
   MeshIndexType triangleCount = 0;
+  std::vector<MeshIndexType> layerTriangleOffsets;
 
   if(m_InputValues->FixProblemVoxels)
   {
     correctProblemVoxels();
   }
 
-  determineActiveNodes(nodeIds, nodeCount, triangleCount);
+  determineActiveNodes(nodeIds, nodeCount, triangleCount, layerTriangleOffsets);
 
   // now create node and triangle arrays knowing the number that will be needed
   std::vector<usize> tupleShape = {triangleCount};
@@ -287,7 +425,7 @@ Result<> QuickSurfaceMesh::operator()()
     Result<> result = complex::ResizeAndReplaceDataArray(m_DataStructure, dataPath, tupleShape, complex::IDataAction::Mode::Execute);
   }
 
-  createNodesAndTriangles(nodeIds, nodeCount, triangleCount);
+  createNodesAndTriangles(nodeIds, nodeCount, triangleCount, layerTriangleOffsets);
 
 #ifdef QSM_CREATE_TRIPLE_LINES
   if(m_InputValues->pGenerateTripleLines)
@@ -618,7 +756,7 @@ void QuickSurfaceMesh::correctProblemVoxels()
 }
 
 // -----------------------------------------------------------------------------
-void QuickSurfaceMesh::determineActiveNodes(std::vector<MeshIndexType>& nodeIds, MeshIndexType& nodeCount, MeshIndexType& triangleCount)
+void QuickSurfaceMesh::determineActiveNodes(std::vector<MeshIndexType>& nodeIds, MeshIndexType& nodeCount, MeshIndexType& triangleCount, std::vector<MeshIndexType>& layerTriangleOffsets)
 {
   m_MessageHandler(IFilter::Message::Type::Info, "Determining active Nodes");
 
@@ -633,311 +771,91 @@ void QuickSurfaceMesh::determineActiveNodes(std::vector<MeshIndexType>& nodeIds,
   MeshIndexType yP = udims[1];
   MeshIndexType zP = udims[2];
 
-  std::vector<std::set<int32_t>> ownerLists;
-
-  MeshIndexType point = 0, neigh1 = 0, neigh2 = 0, neigh3 = 0;
-
-  MeshIndexType nodeId1 = 0, nodeId2 = 0, nodeId3 = 0, nodeId4 = 0;
-
-  // first determining which nodes are actually boundary nodes and
-  // count number of nodes and triangles that will be created
-  for(MeshIndexType k = 0; k < zP; k++)
-  {
-    for(MeshIndexType j = 0; j < yP; j++)
+  const MeshIndexType nodeRowSize = xP + 1;
+  const MeshIndexType nodePlaneSize = nodeRowSize * (yP + 1);
+
+  // Each voxel layer k only touches node planes k and k + 1, so the layers are processed independently. Node and
+  // triangle ids are handed out per layer in the same order a serial scan over the volume would assign them.
+  const bool runParallel = IParallelAlgorithm::CheckArraysInMemory({&featureIdsArray});
+
+  // Mark the nodes on each plane that are already used by the layer below and count the triangles in each layer
+  std::vector<uint8> touchedFromBelow(nodeIds.size(), 0);
+  std::vector<MeshIndexType> layerTriangleCounts(zP, 0);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, zP);
+  dataAlg.setParallelizationEnabled(runParallel);
+  dataAlg.execute([&](const Range& range) {
+    for(usize k = range.min(); k < range.max(); k++)
     {
-      for(MeshIndexType i = 0; i < xP; i++)
-      {
-        point = (k * xP * yP) + (j * xP) + i;
-        neigh1 = point + 1;
-        neigh2 = point + xP;
-        neigh3 = point + (xP * yP);
-
-        if(i == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(j == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(k == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(i == (xP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(featureIds[point] != featureIds[neigh1])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(j == (yP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(featureIds[point] != featureIds[neigh2])
+      ForEachSurfaceFaceInLayer(featureIds, udims, k, [&](const VoxelFaceCase& faceCase, usize x, usize y, usize point, usize neighbor, bool isBoundary) {
+        for(usize nodeIndex : GetFaceNodes(faceCase, x, y, k, nodeRowSize, nodePlaneSize))
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
+          if(nodeIndex >= (k + 1) * nodePlaneSize)
           {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
+            touchedFromBelow[nodeIndex] = 1;
           }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
         }
-        if(k == (zP - 1))
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(k < zP - 1 && featureIds[point] != featureIds[neigh3])
+        layerTriangleCounts[k] += 2;
+      });
+    }
+  });
+
+  // A layer owns the nodes on its upper plane and the nodes on its lower plane that the layer below did not use
+  std::vector<MeshIndexType> layerNodeCounts(zP, 0);
+  auto forEachOwnedNode = [&](usize k, std::vector<uint8>& seen, auto&& nodeFunc) {
+    std::fill(seen.begin(), seen.end(), 0);
+    ForEachSurfaceFaceInLayer(featureIds, udims, k, [&](const VoxelFaceCase& faceCase, usize x, usize y, usize point, usize neighbor, bool isBoundary) {
+      for(usize nodeIndex : GetFaceNodes(faceCase, x, y, k, nodeRowSize, nodePlaneSize))
+      {
+        const usize localIndex = nodeIndex - (k * nodePlaneSize);
+        if(seen[localIndex] != 0 || (localIndex < nodePlaneSize && touchedFromBelow[nodeIndex] != 0))
         {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
+          continue;
         }
+        seen[localIndex] = 1;
+        nodeFunc(nodeIndex);
       }
+    });
+  };
+
+  dataAlg.execute([&](const Range& range) {
+    std::vector<uint8> seen(2 * nodePlaneSize, 0);
+    for(usize k = range.min(); k < range.max(); k++)
+    {
+      forEachOwnedNode(k, seen, [&](usize nodeIndex) { layerNodeCounts[k]++; });
     }
+  });
+
+  std::vector<MeshIndexType> layerNodeOffsets(zP, 0);
+  layerTriangleOffsets.assign(zP, 0);
+  nodeCount = 0;
+  triangleCount = 0;
+  for(usize k = 0; k < zP; k++)
+  {
+    layerNodeOffsets[k] = nodeCount;
+    layerTriangleOffsets[k] = triangleCount;
+    nodeCount += layerNodeCounts[k];
+    triangleCount += layerTriangleCounts[k];
   }
+
+  dataAlg.execute([&](const Range& range) {
+    std::vector<uint8> seen(2 * nodePlaneSize, 0);
+    for(usize k = range.min(); k < range.max(); k++)
+    {
+      MeshIndexType nextNodeId = layerNodeOffsets[k];
+      forEachOwnedNode(k, seen, [&](usize nodeIndex) { nodeIds[nodeIndex] = nextNodeId++; });
+    }
+  });
 }
 
 // -----------------------------------------------------------------------------
-void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType>& m_NodeIds, MeshIndexType nodeCount, MeshIndexType triangleCount)
+void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType>& m_NodeIds, MeshIndexType nodeCount, MeshIndexType triangleCount, const std::vector<MeshIndexType>& layerTriangleOffsets)
 {
   m_MessageHandler(IFilter::Message::Type::Info, "Creating mesh");
 
   Int32Array& featureIdsArray = m_DataStructure.getDataRefAs<Int32Array>(m_InputValues->FeatureIdsArrayPath);
   auto& featureIds = featureIdsArray.getDataStoreRef();
 
-  size_t numFeatures = 0;
-  size_t numTuples = featureIdsArray.getNumberOfTuples();
-  for(size_t i = 0; i < numTuples; i++)
-  // for(const auto& featureId : featureIds)
-  {
-    const size_t featureId = featureIds[i];
-    if(featureId > numFeatures)
-    {
-      numFeatures = static_cast<size_t>(featureId);
-    }
-  }
-
   auto* grid = m_DataStructure.getDataAs<IGridGeometry>(m_InputValues->GridGeomDataPath);
 
   SizeVec3 udims = grid->getDimensions();
@@ -946,17 +864,8 @@ void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType>& m_Nod
   MeshIndexType yP = udims[1];
   MeshIndexType zP = udims[2];
 
-  std::vector<std::set<int32_t>> ownerLists;
-
-  MeshIndexType point = 0;
-  MeshIndexType neigh1 = 0;
-  MeshIndexType neigh2 = 0;
-  MeshIndexType neigh3 = 0;
-
-  MeshIndexType nodeId1 = 0;
-  MeshIndexType nodeId2 = 0;
-  MeshIndexType nodeId3 = 0;
-  MeshIndexType nodeId4 = 0;
+  const MeshIndexType nodeRowSize = xP + 1;
+  const MeshIndexType nodePlaneSize = nodeRowSize * (yP + 1);
 
   auto* triangleGeom = m_DataStructure.getDataAs<TriangleGeom>(m_InputValues->TriangleGeometryPath);
   LinkedGeometryData& linkedGeometryData = triangleGeom->getLinkedGeometryData();
@@ -978,7 +887,7 @@ void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType>& m_Nod
   IGeometry::SharedVertexList& vertex = *(triangleGeom->getVertices());
   IGeometry::SharedTriList& triangle = *(triangleGeom->getFaces());
 
-  ownerLists.resize(nodeCount);
+  IParallelAlgorithm::AlgorithmArrays algArrays = {&featureIdsArray, &faceLabels, &nodeTypes, &vertex, &triangle};
 
   // Create a vector of TupleTransferFunctions for each of the Triangle Face to VertexType Data Arrays
   std::vector<std::shared_ptr<AbstractTupleTransfer>> tupleTransferFunctions;
@@ -987,527 +896,72 @@ void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType>& m_Nod
     // Associate these arrays with the Triangle Face Data.
     linkedGeometryData.addFaceData(m_InputValues->SelectedDataArrayPaths[i]);
     ::AddTupleTransferInstance(m_DataStructure, m_InputValues->SelectedDataArrayPaths[i], m_InputValues->CreatedDataArrayPaths[i], tupleTransferFunctions);
+    algArrays.push_back(m_DataStructure.getDataAs<IDataArray>(m_InputValues->SelectedDataArrayPaths[i]));
+    algArrays.push_back(m_DataStructure.getDataAs<IDataArray>(m_InputValues->CreatedDataArrayPaths[i]));
   }
-
-  // Cycle through again assigning coordinates to each node and assigning node numbers and feature labels to each triangle
-  MeshIndexType triangleIndex = 0;
-  for(MeshIndexType k = 0; k < zP; k++)
-  {
-    for(MeshIndexType j = 0; j < yP; j++)
+  const bool runParallel = IParallelAlgorithm::CheckArraysInMemory(algArrays);
+
+  // Assign coordinates and node types to each active node, one node plane at a time
+  ParallelDataAlgorithm nodeAlg;
+  nodeAlg.setRange(0, zP + 1);
+  nodeAlg.setParallelizationEnabled(runParallel);
+  nodeAlg.execute([&](const Range& range) {
+    for(usize k = range.min(); k < range.max(); k++)
     {
-      for(MeshIndexType i = 0; i < xP; i++)
+      for(usize j = 0; j <= yP; j++)
       {
-
-        point = (k * xP * yP) + (j * xP) + i;
-        neigh1 = point + 1; // <== What happens if we are at the end of a row?
-        neigh2 = point + xP;
-        neigh3 = point + (xP * yP);
-
-        if(i == 0)
+        for(usize i = 0; i <= xP; i++)
         {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_InputValues->SelectedDataArrayPaths.size(); dataVectorIndex++)
+          const MeshIndexType nodeId = m_NodeIds[(k * nodePlaneSize) + (j * nodeRowSize) + i];
+          if(nodeId == std::numeric_limits<MeshIndexType>::max())
           {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, faceLabels);
+            continue;
           }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_InputValues->SelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, faceLabels);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(j == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_InputValues->SelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, faceLabels);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_InputValues->SelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, faceLabels);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(k == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_InputValues->SelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, faceLabels);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_InputValues->SelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, faceLabels);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(i == (xP - 1)) // Takes care of the end of a Row...
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_InputValues->SelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, faceLabels);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_InputValues->SelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, faceLabels);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(featureIds[point] != featureIds[neigh1])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = featureIds[neigh1];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          if(featureIds[point] < featureIds[neigh1])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh1];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_InputValues->SelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh1, point, faceLabels);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = featureIds[neigh1];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh1])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh1];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_InputValues->SelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh1, point, faceLabels);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[neigh1]);
+          getGridCoordinates(grid, i, j, k, vertex, nodeId * 3);
+          nodeTypes[nodeId] = ComputeNodeType(featureIds, udims, i, j, k);
         }
-        if(j == (yP - 1)) // Takes care of the end of a column
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_InputValues->SelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, faceLabels);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_InputValues->SelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, faceLabels);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(featureIds[point] != featureIds[neigh2])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          faceLabels[triangleIndex * 2] = featureIds[neigh2];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh2])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh2];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_InputValues->SelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh2, point, faceLabels);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          faceLabels[triangleIndex * 2] = featureIds[neigh2];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh2])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh2];
-          }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_InputValues->SelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh2, point, faceLabels);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[neigh2]);
-        }
-        if(k == (zP - 1)) // Takes care of the end of a Pillar
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_InputValues->SelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, faceLabels);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          faceLabels[triangleIndex * 2] = -1;
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_InputValues->SelectedDataArrayPaths.size(); dataVectorIndex++)
-          {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, point, point, faceLabels);
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(featureIds[point] != featureIds[neigh3])
+      }
+    }
+  });
+
+  // Assign node numbers and feature labels to each triangle. Every layer starts at its precomputed triangle offset
+  ParallelDataAlgorithm triangleAlg;
+  triangleAlg.setRange(0, zP);
+  triangleAlg.setParallelizationEnabled(runParallel);
+  triangleAlg.execute([&](const Range& range) {
+    for(usize k = range.min(); k < range.max(); k++)
+    {
+      MeshIndexType triangleIndex = layerTriangleOffsets[k];
+      ForEachSurfaceFaceInLayer(featureIds, udims, k, [&](const VoxelFaceCase& faceCase, usize x, usize y, usize point, usize neighbor, bool isBoundary) {
+        const std::array<usize, 4> faceNodes = GetFaceNodes(faceCase, x, y, k, nodeRowSize, nodePlaneSize);
+        // Interior faces are wound so that the normal points away from the lower feature id
+        const bool flipWinding = !isBoundary && featureIds[point] < featureIds[neighbor];
+        for(const auto& corners : faceCase.Triangles)
         {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex, (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex, (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex, (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex, (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = featureIds[neigh3];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh3])
+          triangle[triangleIndex * 3 + 0] = m_NodeIds[faceNodes[corners[0]]];
+          triangle[triangleIndex * 3 + 1] = m_NodeIds[faceNodes[flipWinding ? corners[2] : corners[1]]];
+          triangle[triangleIndex * 3 + 2] = m_NodeIds[faceNodes[flipWinding ? corners[1] : corners[2]]];
+          if(isBoundary)
           {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh3];
+            faceLabels[triangleIndex * 2] = -1;
+            faceLabels[triangleIndex * 2 + 1] = featureIds[point];
           }
-
-          for(size_t dataVectorIndex = 0; dataVectorIndex < m_InputValues->SelectedDataArrayPaths.size(); dataVectorIndex++)
+          else
           {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh3, point, faceLabels);
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          faceLabels[triangleIndex * 2] = featureIds[neigh3];
-          faceLabels[triangleIndex * 2 + 1] = featureIds[point];
-          if(featureIds[point] < featureIds[neigh3])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-            faceLabels[triangleIndex * 2] = featureIds[point];
-            faceLabels[triangleIndex * 2 + 1] = featureIds[neigh3];
+            faceLabels[triangleIndex * 2] = flipWinding ? featureIds[point] : featureIds[neighbor];
+            faceLabels[triangleIndex * 2 + 1] = flipWinding ? featureIds[neighbor] : featureIds[point];
           }
 
           for(size_t dataVectorIndex = 0; dataVectorIndex < m_InputValues->SelectedDataArrayPaths.size(); dataVectorIndex++)
           {
-            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neigh3, point, faceLabels);
+            tupleTransferFunctions[dataVectorIndex]->transfer(triangleIndex, neighbor, point, faceLabels);
           }
 
           triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(featureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(featureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(featureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(featureIds[neigh3]);
         }
-      }
+      });
     }
-  }
-
-  Int8Array& m_NodeTypesArray = m_DataStructure.getDataRefAs<Int8Array>(m_InputValues->NodeTypesDataPath);
-  Int8AbstractDataStore& m_NodeTypes = m_NodeTypesArray.getDataStoreRef();
-
-  for(size_t i = 0; i < nodeCount; i++)
-  {
-    auto& ownerList = ownerLists[i];
-
-    m_NodeTypes[i] = static_cast<int8_t>(ownerList.size());
-    if(m_NodeTypes[i] > 4)
-    {
-      m_NodeTypes[i] = 4;
-    }
-    if(ownerList.find(-1) != ownerList.end())
-    {
-      m_NodeTypes[i] += 10;
-    }
-  }
+  });
 }
 
 // -----------------------------------------------------------------------------
@@ -1571,7 +1025,7 @@ void QuickSurfaceMesh::generateTripleLines()
   if(featureIds.getChunkShape().has_value())
   {
     const auto chunkShape = featureIds.getChunkShape().value();
-    algorithm.setChunkSize(Range3D(chunkShape[0], chunkShape[1], chunkShape[2]));
+    algorithm.setChunkSize(Range3D(chunkShape[2], chunkShape[1], chunkShape[0]));
   }
   algorithm.setParallelizationEnabled(false);
   algorithm.execute(GenerateTripleLinesImpl(imageGeom, featureIds, vertexMap, edgeMap));
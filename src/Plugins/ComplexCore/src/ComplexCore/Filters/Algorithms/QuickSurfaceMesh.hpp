@@ -92,20 +92,23 @@ public:
   void correctProblemVoxels();
 
   /**
-   * @brief
+   * @brief Assigns an id to every node used by the surface mesh and counts the nodes and triangles that will be
+   * created. The voxel layers are processed in parallel and the ids match a serial scan over the volume.
    * @param m_NodeIds
    * @param nodeCount
    * @param triangleCount
+   * @param layerTriangleOffsets Index of the first triangle created by each voxel layer
    */
-  void determineActiveNodes(std::vector<MeshIndexType>& m_NodeIds, MeshIndexType& nodeCount, MeshIndexType& triangleCount);
+  void determineActiveNodes(std::vector<MeshIndexType>& m_NodeIds, MeshIndexType& nodeCount, MeshIndexType& triangleCount, std::vector<MeshIndexType>& layerTriangleOffsets);
 
   /**
-   * @brief
+   * @brief Writes the vertex coordinates, node types, triangles and face data of the surface mesh.
    * @param m_NodeIds
    * @param nodeCount
    * @param triangleCount
+   * @param layerTriangleOffsets Index of the first triangle created by each voxel layer
    */
-  void createNodesAndTriangles(std::vector<MeshIndexType>& m_NodeIds, MeshIndexType nodeCount, MeshIndexType triangleCount);
+  void createNodesAndTriangles(std::vector<MeshIndexType>& m_NodeIds, MeshIndexType nodeCount, MeshIndexType triangleCount, const std::vector<MeshIndexType>& layerTriangleOffsets);
 
   /**
    * @brief
@@ -4,10 +4,9 @@
 #include "complex/DataStructure/Geometry/IGeometry.hpp"
 #include "complex/DataStructure/Geometry/INodeGeometry0D.hpp"
 #include "complex/DataStructure/Geometry/QuadGeom.hpp"
+#include "complex/Utilities/Parsing/Text/TextTokenizer.hpp"
 #include "complex/Utilities/StringUtilities.hpp"
 
-#include <fstream>
-
 using namespace complex;
 
 namespace
@@ -29,11 +28,11 @@ const std::vector<std::string> k_DataForObject = {"Data", "for", "Object", "#"};
 class IOHandler
 {
 public:
-  IOHandler(ReadDeformKeyFileV12* filter, DataStructure& dataStructure, std::ifstream& inStream, const DataPath& quadGeomPath, const DataPath& vertexAMPath, const DataPath& cellAMPath,
+  IOHandler(ReadDeformKeyFileV12* filter, DataStructure& dataStructure, const TextTokenizer& tokenizer, const DataPath& quadGeomPath, const DataPath& vertexAMPath, const DataPath& cellAMPath,
             const bool allocate)
   : m_Filter(filter)
   , m_DataStructure(dataStructure)
-  , m_InStream(inStream)
+  , m_Tokenizer(tokenizer)
   , m_QuadGeomPath(quadGeomPath)
   , m_VertexAMPath(vertexAMPath)
   , m_CellAMPath(cellAMPath)
@@ -52,7 +51,7 @@ public:
   {
     std::vector<std::string> tokens; /* vector to store the split data */
 
-    while(m_InStream.peek() != EOF)
+    while(!m_Tokenizer.isEnd(m_Offset))
     {
       if(m_Filter->getCancel())
       {
@@ -186,7 +185,8 @@ private:
   // member variables
   ReadDeformKeyFileV12* m_Filter;
   DataStructure& m_DataStructure;
-  std::ifstream& m_InStream;
+  const TextTokenizer& m_Tokenizer;
+  usize m_Offset = 0;
   const DataPath& m_QuadGeomPath;
   const DataPath& m_VertexAMPath;
   const DataPath& m_CellAMPath;
@@ -208,13 +208,9 @@ private:
     for(usize comp = 0; comp < numComp; comp++)
     {
       float32 value = 0.0f;
-      try
-      {
-        value = std::stof(tokens[comp]);
-      } catch(const std::exception& e)
+      if(TextTokenizer::FromChars(tokens[comp], value) != std::errc{})
       {
-        std::string msg = fmt::format("Error at line {}: Unable to convert data array {}'s string value \"{}\" to float.  Threw standard exception with text: \"{}\"", m_LineCount, data.getName(),
-                                      tokens[comp], e.what());
+        std::string msg = fmt::format("Error at line {}: Unable to convert data array {}'s string value \"{}\" to float.", m_LineCount, data.getName(), tokens[comp]);
         return MakeErrorResult(-2008, msg);
       }
       data[tuple * numComp + comp] = value;
@@ -224,13 +220,9 @@ private:
 
   inline Result<> parse_ull(const std::string& token, usize& value) const
   {
-    try
-    {
-      value = std::stoull(token);
-    } catch(const std::exception& e)
+    if(TextTokenizer::FromChars(token, value) != std::errc{})
     {
-      std::string msg = fmt::format("Error at line {}: Unable to convert string value \"{}\" to unsigned long long.  Threw standard exception with text: \"{}\"", StringUtilities::number(m_LineCount),
-                                    token, e.what());
+      std::string msg = fmt::format("Error at line {}: Unable to convert string value \"{}\" to unsigned long long.", StringUtilities::number(m_LineCount), token);
       return MakeErrorResult(-2000, msg);
     }
 
@@ -241,7 +233,7 @@ private:
   {
     std::vector<std::string> tokens; /* vector to store the split data */
     std::string buf;
-    std::getline(m_InStream, buf);
+    buf = m_Tokenizer.readLine(m_Offset);
     buf = StringUtilities::trimmed(buf);
     buf = StringUtilities::simplified(buf);
     tokens = StringUtilities::split(buf, ' ');
@@ -250,10 +242,20 @@ private:
     return tokens;
   }
 
+  /**
+   * @brief Splits the next line on whitespace without copying it. Used by the loops
+   * that read one vertex or cell per line.
+   */
+  void getNextLineTokens(std::vector<std::string_view>& tokens)
+  {
+    TextTokenizer::Split(m_Tokenizer.readLine(m_Offset), TextTokenizer::k_Whitespace, tokens);
+    m_LineCount++;
+  }
+
   void findNextSection()
   {
     std::vector<std::string> tokens;
-    while(m_InStream.peek() != EOF)
+    while(!m_Tokenizer.isEnd(m_Offset))
     {
       tokens = getNextLineTokens();
       if(!tokens.empty() && tokens.at(0) == k_Star)
@@ -308,7 +310,7 @@ private:
   [[nodiscard]] Result<> readUserDefinedVariables()
   {
     std::string buf;
-    std::getline(m_InStream, buf);
+    buf = m_Tokenizer.readLine(m_Offset);
     buf = StringUtilities::trimmed(buf);
     buf = StringUtilities::simplified(buf);
     auto tokens = StringUtilities::split(buf, ' ');
@@ -330,7 +332,7 @@ private:
     m_UserDefinedVariables.resize(12);
     for(usize i = 0; i < numVars; i++)
     {
-      std::getline(m_InStream, buf);
+      buf = m_Tokenizer.readLine(m_Offset);
       buf = StringUtilities::trimmed(buf);
       m_LineCount++;
       std::string cleanedString = StringUtilities::replace(buf, "/", "|");
@@ -363,7 +365,7 @@ private:
       std::vector<std::string> tokens;
       std::string line;
 
-      std::getline(m_InStream, line);
+      line = m_Tokenizer.readLine(m_Offset);
       m_LineCount++;
       // First Scan the first 8 characters to see if there are any non-space characters
       for(usize i = 0; i < 8; i++)
@@ -385,16 +387,16 @@ private:
       bool keepGoing = true;
       while(keepGoing)
       {
-        auto currentFilePos = m_InStream.tellg();
+        const usize currentOffset = m_Offset;
         // Read the next line
-        std::getline(m_InStream, line);
+        line = m_Tokenizer.readLine(m_Offset);
         m_LineCount++;
         // Figure out if there is anything in the first 8 chars
         for(usize i = 0; i < 8; i++)
         {
           if(line[i] != ' ')
           {
-            m_InStream.seekg(currentFilePos); // Roll back the m_InStream to just before we read this line.
+            m_Offset = currentOffset; // Roll back to just before we read this line.
             keepGoing = false;
             break;
           }
@@ -468,7 +470,7 @@ private:
       usize totalLinesToRead = (arrayTupleSize - 1) * tupleLineCount;
       for(usize i = 0; i < totalLinesToRead; i++)
       {
-        std::getline(m_InStream, line);
+        line = m_Tokenizer.readLine(m_Offset);
         m_LineCount++;
       }
     }
@@ -488,7 +490,7 @@ private:
         {
           // Now read the line
           std::string compLineData;
-          std::getline(m_InStream, compLineData);
+          compLineData = m_Tokenizer.readLine(m_Offset);
           m_LineCount++;
           usize offset = (compLine == 0 ? 1 : 0);
           compLineData = StringUtilities::trimmed(compLineData);
@@ -522,8 +524,8 @@ private:
 
   Result<> readVertexCoordinates(IGeometry::SharedVertexList* vertex, usize numVerts)
   {
-    std::string buf;
-    std::vector<std::string> tokens; /* vector to store the split data */
+    const std::array<std::string_view, 2> ordinals = {"1st", "2nd"};
+    std::vector<std::string_view> tokens; /* vector to store the split data */
 
     // Read or Skip past all the vertex data
     for(usize i = 0; i < numVerts; i++)
@@ -533,26 +535,19 @@ private:
         return {};
       }
 
-      tokens = getNextLineTokens();
+      getNextLineTokens(tokens);
 
-      try
-      {
-        vertex->operator[](3 * i) = std::stof(tokens[1]);
-      } catch(const std::exception& e)
+      for(usize comp = 0; comp < ordinals.size(); comp++)
       {
-        std::string msg = fmt::format("Error at line {}: Unable to convert vertex coordinate {}'s 1st string value \"{}\" to float.  Threw standard exception with text: \"{}\"",
-                                      StringUtilities::number(m_LineCount), StringUtilities::number(i + 1), tokens[1], e.what());
-        return MakeErrorResult(-2001, std::move(msg));
-      }
-
-      try
-      {
-        vertex->operator[](3 * i + 1) = std::stof(tokens[2]);
-      } catch(const std::exception& e)
-      {
-        std::string msg = fmt::format("Error at line {}: Unable to convert vertex coordinate {}'s 2nd string value \"{}\" to float.  Threw standard exception with text: \"{}\"",
-                                      StringUtilities::number(m_LineCount), StringUtilities::number(i + 1), tokens[2], e.what());
-        return MakeErrorResult(-2002, std::move(msg));
+        const std::string_view token = comp + 1 < tokens.size() ? tokens[comp + 1] : std::string_view{};
+        float32 value = 0.0f;
+        if(TextTokenizer::FromChars(token, value) != std::errc{})
+        {
+          std::string msg = fmt::format("Error at line {}: Unable to convert vertex coordinate {}'s {} string value \"{}\" to float.", StringUtilities::number(m_LineCount),
+                                        StringUtilities::number(i + 1), ordinals[comp], token);
+          return MakeErrorResult(-2001 - static_cast<int32>(comp), std::move(msg));
+        }
+        vertex->operator[](3 * i + comp) = value;
       }
 
       vertex->operator[](3 * i + 2) = 0.0f;
@@ -563,8 +558,8 @@ private:
 
   Result<> readQuadGeometry(IGeometry::MeshIndexArrayType& quads, usize numCells)
   {
-    std::string buf;
-    std::vector<std::string> tokens; /* vector to store the split data */
+    const std::array<std::string_view, 4> ordinals = {"1st", "2nd", "3rd", "4th"};
+    std::vector<std::string_view> tokens; /* vector to store the split data */
 
     for(usize i = 0; i < numCells; i++)
     {
@@ -573,47 +568,19 @@ private:
         return {};
       }
 
-      tokens = getNextLineTokens();
-
-      // Subtract one from the node number because DEFORM starts at node 1, and we start at node 0
-      try
-      {
-        quads[4 * i] = std::stoi(tokens[1]) - 1;
-      } catch(const std::exception& e)
-      {
-        std::string msg =
-            fmt::format("Error at line {}: Unable to convert quad {}'s 1st string value \"{}\" to integer.  Threw standard exception with text: \"{}\"", m_LineCount, (i + 1), tokens[1], e.what());
-        return MakeErrorResult(-2004, msg);
-      }
-
-      try
-      {
-        quads[4 * i + 1] = std::stoi(tokens[2]) - 1;
-      } catch(const std::exception& e)
-      {
-        std::string msg =
-            fmt::format("Error at line {}: Unable to convert quad {}'s 2nd string value \"{}\" to integer.  Threw standard exception with text: \"{}\"", m_LineCount, (i + 1), tokens[2], e.what());
-        return MakeErrorResult(-2005, msg);
-      }
-
-      try
-      {
-        quads[4 * i + 2] = std::stoi(tokens[3]) - 1;
-      } catch(const std::exception& e)
-      {
-        std::string msg =
-            fmt::format("Error at line {}: Unable to convert quad {}'s 3rd string value \"{}\" to integer.  Threw standard exception with text: \"{}\"", m_LineCount, (i + 1), tokens[3], e.what());
-        return MakeErrorResult(-2006, msg);
-      }
+      getNextLineTokens(tokens);
 
-      try
-      {
-        quads[4 * i + 3] = std::stoi(tokens[4]) - 1;
-      } catch(const std::exception& e)
+      for(usize comp = 0; comp < ordinals.size(); comp++)
       {
-        std::string msg =
-            fmt::format("Error at line {}: Unable to convert quad {}'s 4th string value \"{}\" to integer.  Threw standard exception with text: \"{}\"", m_LineCount, (i + 1), tokens[4], e.what());
-        return MakeErrorResult(-2007, msg);
+        const std::string_view token = comp + 1 < tokens.size() ? tokens[comp + 1] : std::string_view{};
+        int32 node = 0;
+        if(TextTokenizer::FromChars(token, node) != std::errc{})
+        {
+          std::string msg = fmt::format("Error at line {}: Unable to convert quad {}'s {} string value \"{}\" to integer.", m_LineCount, (i + 1), ordinals[comp], token);
+          return MakeErrorResult(-2004 - static_cast<int32>(comp), msg);
+        }
+        // Subtract one from the node number because DEFORM starts at node 1, and we start at node 0
+        quads[4 * i + comp] = node - 1;
       }
     }
 
@@ -625,7 +592,7 @@ private:
     bool quadHit = false;
     bool vertHit = false;
 
-    while(m_InStream.peek() != EOF)
+    while(!m_Tokenizer.isEnd(m_Offset))
     {
       if(m_Filter->getCancel())
       {
@@ -636,7 +603,7 @@ private:
       // Read the line. This line _Should_ be the start of "section" of data.
       {
         std::string buf;
-        std::getline(m_InStream, buf);
+        buf = m_Tokenizer.readLine(m_Offset);
         isWord = (buf[0] > 64 /*@ character */ && buf[0] < 91);
         buf = StringUtilities::trimmed(buf);
         buf = StringUtilities::simplified(buf);
@@ -825,13 +792,13 @@ Result<> ReadDeformKeyFileV12::operator()(bool allocate)
    * have been passed in within inputValues are not valid as they have
    * not been created.
    */
-  std::ifstream inStream(m_InputValues->InputFilePath, std::ios_base::binary);
-  if(!inStream.is_open())
+  std::unique_ptr<TextTokenizer> tokenizer = TextTokenizer::Open(m_InputValues->InputFilePath);
+  if(tokenizer == nullptr)
   {
     return MakeErrorResult(-2013, fmt::format("Unable to open the provided file to read at path : {}", m_InputValues->InputFilePath.string()));
   }
 
-  IOHandler handler = IOHandler(this, m_DataStructure, inStream, m_InputValues->QuadGeomPath, m_InputValues->VertexAMPath, m_InputValues->CellAMPath, allocate);
+  IOHandler handler = IOHandler(this, m_DataStructure, *tokenizer, m_InputValues->QuadGeomPath, m_InputValues->VertexAMPath, m_InputValues->CellAMPath, allocate);
 
   // Read from the file
   return handler.readDEFORMFile();
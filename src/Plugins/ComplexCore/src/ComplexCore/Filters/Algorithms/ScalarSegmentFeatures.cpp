@@ -5,6 +5,7 @@
 #include "complex/Filter/Actions/CreateArrayAction.hpp"
 #include "complex/Parameters/BoolParameter.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
 
 using namespace complex;
 
@@ -122,6 +123,68 @@ private:
   AbstractDataStore<int32>* m_FeatureIdsArray = nullptr; // The Feature Ids
   DataStoreType& m_Data;                                 // The data that is being compared
 };
+
+/**
+ * @brief The ScalarGroupingFunctor class performs the same comparison as the compare functors above
+ * without modifying the feature ids so that it can be used by SegmentFeatures::executeParallel()
+ */
+template <class T>
+class ScalarGroupingFunctor
+{
+public:
+  ScalarGroupingFunctor(const AbstractDataStore<T>& data, int64 length, T tolerance, const AbstractDataStore<bool>* goodVoxels, bool compareValues)
+  : m_Data(data)
+  , m_Length(length)
+  , m_Tolerance(tolerance)
+  , m_GoodVoxels(goodVoxels)
+  , m_CompareValues(compareValues)
+  {
+  }
+
+  bool isValid(int64 point) const
+  {
+    return m_GoodVoxels == nullptr || m_GoodVoxels->getValue(point);
+  }
+
+  bool areGrouped(int64 referencePoint, int64 neighborPoint) const
+  {
+    if(!m_CompareValues || referencePoint >= m_Length || neighborPoint >= m_Length)
+    {
+      return false;
+    }
+
+    const T referenceValue = m_Data.getValue(referencePoint);
+    const T neighborValue = m_Data.getValue(neighborPoint);
+    if constexpr(std::is_same_v<T, bool>)
+    {
+      return referenceValue == neighborValue;
+    }
+    else
+    {
+      return (referenceValue >= neighborValue) ? (referenceValue - neighborValue) <= m_Tolerance : (neighborValue - referenceValue) <= m_Tolerance;
+    }
+  }
+
+private:
+  const AbstractDataStore<T>& m_Data;
+  int64 m_Length = 0;
+  T m_Tolerance = static_cast<T>(0);
+  const AbstractDataStore<bool>* m_GoodVoxels = nullptr;
+  bool m_CompareValues = true;
+};
+
+struct ExecuteParallelSegmentationFunctor
+{
+  template <class T>
+  Result<int32> operator()(SegmentFeatures& segmentFeatures, IGridGeometry* gridGeom, AbstractDataStore<int32>& featureIds, IDataArray* inputDataArray, int32 tolerance,
+                           const AbstractDataStore<bool>* goodVoxels)
+  {
+    const auto& inputStore = dynamic_cast<DataArray<T>*>(inputDataArray)->getDataStoreRef();
+    const ScalarGroupingFunctor<T> grouping(inputStore, static_cast<int64>(inputDataArray->getNumberOfTuples()), static_cast<T>(tolerance), goodVoxels,
+                                            inputDataArray->getNumberOfComponents() == 1);
+    return segmentFeatures.executeParallel(gridGeom, featureIds, grouping);
+  }
+};
 } // namespace
 
 ScalarSegmentFeatures::ScalarSegmentFeatures(DataStructure& dataStructure, ScalarSegmentFeaturesInputValues* inputValues, const std::atomic_bool& shouldCancel,
@@ -214,7 +277,20 @@ Result<> ScalarSegmentFeatures::operator()()
   //  Arguments newArgs = args;
   //  newArgs.insert(k_CompareFunctKey, compare.get());
 
-  execute(gridGeom);
+  if(IParallelAlgorithm::CheckArraysInMemory({inputDataArray, m_FeatureIdsArray, m_GoodVoxelsArray}))
+  {
+    auto featureCountResult = ExecuteDataFunction(ExecuteParallelSegmentationFunctor{}, dataType, *this, gridGeom, *featureIds, inputDataArray, m_InputValues->pScalarTolerance, goodVoxels);
+    if(featureCountResult.invalid())
+    {
+      return ConvertResult(std::move(featureCountResult));
+    }
+    auto& cellFeaturesAM = m_DataStructure.getDataRefAs<AttributeMatrix>(m_InputValues->pCellFeaturesPath);
+    cellFeaturesAM.resizeTuples({static_cast<usize>(featureCountResult.value()) + 1}); // This will resize the active array
+  }
+  else
+  {
+    execute(gridGeom);
+  }
 
   auto* activeArray = m_DataStructure.getDataAs<UInt8Array>(m_InputValues->pActiveArrayPath);
   auto totalFeatures = activeArray->getNumberOfTuples();
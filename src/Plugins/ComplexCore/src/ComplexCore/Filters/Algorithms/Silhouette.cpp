@@ -3,13 +3,119 @@
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/Utilities/FilterUtilities.hpp"
 #include "complex/Utilities/KUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
+#include <algorithm>
+#include <random>
 #include <unordered_set>
 
 using namespace complex;
 
 namespace
 {
+// Number of points whose cluster sums are accumulated together
+constexpr usize k_RowBlockSize = 32;
+// Number of points compared against a row block before moving on, sized so the block stays in cache
+constexpr usize k_ColumnBlockSize = 1024;
+
+/**
+ * @brief The points each silhouette is measured against. In the exact mode these
+ * are all masked points. When sampling, they are a random subset of each cluster.
+ */
+struct SilhouetteColumns
+{
+  const float64* points = nullptr;
+  const int32* clusterIds = nullptr;
+  usize count = 0;
+  // Number of columns in each cluster, used to turn the distance sums into averages
+  std::vector<float64> clusterSizes;
+};
+
+/**
+ * @brief Computes the silhouette of each row point against the columns in
+ * blocks. Only the per cluster distance sums of a block of rows are kept.
+ */
+template <KUtilities::DistanceMetric Metric>
+class ComputeSilhouetteImpl
+{
+public:
+  ComputeSilhouetteImpl(const std::vector<float64>& points, const std::vector<int32>& clusterIds, const SilhouetteColumns& columns, usize numComps, usize totalClusters,
+                        std::vector<float64>& silhouette, const std::atomic_bool& shouldCancel)
+  : m_Points(points)
+  , m_ClusterIds(clusterIds)
+  , m_Columns(columns)
+  , m_NumComps(numComps)
+  , m_TotalClusters(totalClusters)
+  , m_Silhouette(silhouette)
+  , m_ShouldCancel(shouldCancel)
+  {
+  }
+
+  void compute(usize start, usize end) const
+  {
+    std::vector<float64> clusterDist(k_RowBlockSize * m_TotalClusters);
+    for(usize rowStart = start; rowStart < end; rowStart += k_RowBlockSize)
+    {
+      if(m_ShouldCancel)
+      {
+        return;
+      }
+      const usize rowEnd = std::min(rowStart + k_RowBlockSize, end);
+      std::fill(clusterDist.begin(), clusterDist.end(), 0.0);
+
+      for(usize columnStart = 0; columnStart < m_Columns.count; columnStart += k_ColumnBlockSize)
+      {
+        const usize columnEnd = std::min(columnStart + k_ColumnBlockSize, m_Columns.count);
+        for(usize i = rowStart; i < rowEnd; i++)
+        {
+          float64* rowDist = clusterDist.data() + (i - rowStart) * m_TotalClusters;
+          for(usize j = columnStart; j < columnEnd; j++)
+          {
+            rowDist[m_Columns.clusterIds[j]] += KUtilities::GetDistance<Metric>(m_Points, m_NumComps * i, m_Columns.points, m_NumComps * j, m_NumComps);
+          }
+        }
+      }
+
+      for(usize i = rowStart; i < rowEnd; i++)
+      {
+        float64* rowDist = clusterDist.data() + (i - rowStart) * m_TotalClusters;
+        for(usize j = 1; j < m_TotalClusters; j++)
+        {
+          rowDist[j] /= m_Columns.clusterSizes[j];
+        }
+
+        const int32 cluster = m_ClusterIds[i];
+        const float64 inClusterDist = rowDist[cluster];
+        float64 outClusterMinDist = 0.0;
+        float64 minDist = std::numeric_limits<float64>::max();
+        for(usize j = 1; j < m_TotalClusters; j++)
+        {
+          if(cluster != j && rowDist[j] < minDist)
+          {
+            minDist = rowDist[j];
+            outClusterMinDist = rowDist[j];
+          }
+        }
+        m_Silhouette[i] = (outClusterMinDist - inClusterDist) / (std::max(outClusterMinDist, inClusterDist));
+      }
+    }
+  }
+
+  void operator()(const Range& range) const
+  {
+    compute(range.min(), range.max());
+  }
+
+private:
+  const std::vector<float64>& m_Points;
+  const std::vector<int32>& m_ClusterIds;
+  const SilhouetteColumns& m_Columns;
+  usize m_NumComps;
+  usize m_TotalClusters;
+  std::vector<float64>& m_Silhouette;
+  const std::atomic_bool& m_ShouldCancel;
+};
+
 template <typename T>
 class SilhouetteTemplate
 {
@@ -26,13 +132,14 @@ public:
   }
 
   SilhouetteTemplate(const IDataArray& inputIDataArray, Float64Array& outputDataArray, const BoolArray& maskDataArray, usize numClusters, const Int32Array& featureIds,
-                     KUtilities::DistanceMetric distMetric)
+                     const SilhouetteInputValues& inputValues, const std::atomic_bool& shouldCancel)
   : m_InputData(dynamic_cast<const DataArrayT&>(inputIDataArray))
   , m_OutputData(outputDataArray)
   , m_Mask(maskDataArray)
   , m_NumClusters(numClusters)
   , m_FeatureIds(featureIds)
-  , m_DistMetric(distMetric)
+  , m_InputValues(inputValues)
+  , m_ShouldCancel(shouldCancel)
   {
   }
   ~SilhouetteTemplate() = default;
@@ -49,73 +156,106 @@ public:
     usize numTuples = m_InputData.getNumberOfTuples();
     usize numCompDims = m_InputData.getNumberOfComponents();
     usize totalClusters = m_NumClusters + 1;
-    std::vector<float64> inClusterDist(numTuples, 0.0);
-    std::vector<float64> outClusterMinDist(numTuples, 0.0);
-    std::vector<float64> numTuplesPerFeature(totalClusters, 0.0);
-    std::vector<std::vector<float64>> clusterDist(numTuples, std::vector<float64>(totalClusters, 0.0));
 
+    // Copy the masked points into contiguous memory once so the all pairs loop does not go through the DataStore
+    std::vector<usize> tupleIndices;
     for(usize i = 0; i < numTuples; i++)
     {
       if(m_Mask[i])
       {
-        numTuplesPerFeature[m_FeatureIds[i]]++;
+        tupleIndices.push_back(i);
       }
     }
-
-    for(usize i = 0; i < numTuples; i++)
+    const usize numPoints = tupleIndices.size();
+    std::vector<float64> points(numPoints * numCompDims);
+    std::vector<int32> clusterIds(numPoints);
+    std::vector<float64> numTuplesPerFeature(totalClusters, 0.0);
+    for(usize i = 0; i < numPoints; i++)
     {
-      if(m_Mask[i])
+      const usize tupleIndex = tupleIndices[i];
+      for(usize comp = 0; comp < numCompDims; comp++)
       {
-        for(usize j = 0; j < numTuples; j++)
-        {
-          if(m_Mask[j])
-          {
-            clusterDist[i][m_FeatureIds[j]] += KUtilities::GetDistance(m_InputData, (numCompDims * i), m_InputData, (numCompDims * j), numCompDims, m_DistMetric);
-          }
-        }
+        points[i * numCompDims + comp] = static_cast<float64>(m_InputData[tupleIndex * numCompDims + comp]);
       }
+      clusterIds[i] = m_FeatureIds[tupleIndex];
+      numTuplesPerFeature[clusterIds[i]]++;
     }
 
-    for(usize i = 0; i < numTuples; i++)
+    SilhouetteColumns columns;
+    std::vector<float64> sampledPoints;
+    std::vector<int32> sampledClusterIds;
+    if(m_InputValues.UseSampling)
     {
-      if(m_Mask[i])
+      // Compare against at most SampleSize random points from each cluster
+      std::vector<std::vector<usize>> clusterMembers(totalClusters);
+      for(usize i = 0; i < numPoints; i++)
+      {
+        clusterMembers[clusterIds[i]].push_back(i);
+      }
+      std::mt19937_64 generator(m_InputValues.Seed);
+      columns.clusterSizes.resize(totalClusters, 0.0);
+      for(usize cluster = 0; cluster < totalClusters; cluster++)
       {
-        for(usize j = 1; j < totalClusters; j++)
+        std::vector<usize>& members = clusterMembers[cluster];
+        const usize sampleSize = std::min(members.size(), m_InputValues.SampleSize);
+        for(usize i = 0; i < sampleSize; i++)
         {
-          clusterDist[i][j] /= numTuplesPerFeature[j];
+          std::uniform_int_distribution<usize> distribution(i, members.size() - 1);
+          std::swap(members[i], members[distribution(generator)]);
+          const usize member = members[i];
+          sampledPoints.insert(sampledPoints.end(), points.begin() + member * numCompDims, points.begin() + (member + 1) * numCompDims);
+          sampledClusterIds.push_back(static_cast<int32>(cluster));
         }
+        columns.clusterSizes[cluster] = static_cast<float64>(sampleSize);
       }
+      columns.points = sampledPoints.data();
+      columns.clusterIds = sampledClusterIds.data();
+      columns.count = sampledClusterIds.size();
     }
-
-    for(usize i = 0; i < numTuples; i++)
+    else
     {
-      if(m_Mask[i])
-      {
-        int32 cluster = m_FeatureIds[i];
-        inClusterDist[i] = clusterDist[i][cluster];
+      columns.points = points.data();
+      columns.clusterIds = clusterIds.data();
+      columns.count = numPoints;
+      columns.clusterSizes = numTuplesPerFeature;
+    }
 
-        float64 minDist = std::numeric_limits<float64>::max();
-        for(usize j = 1; j < totalClusters; j++)
-        {
-          if(cluster != j)
-          {
-            float64 dist = clusterDist[i][j];
-            if(dist < minDist)
-            {
-              minDist = dist;
-              outClusterMinDist[i] = dist;
-            }
-          }
-        }
-      }
+    std::vector<float64> silhouette(numPoints, 0.0);
+    switch(m_InputValues.DistanceMetric)
+    {
+    case KUtilities::DistanceMetric::Euclidean: {
+      computeSilhouette<KUtilities::DistanceMetric::Euclidean>(points, clusterIds, columns, numCompDims, totalClusters, silhouette);
+      break;
+    }
+    case KUtilities::DistanceMetric::SquaredEuclidean: {
+      computeSilhouette<KUtilities::DistanceMetric::SquaredEuclidean>(points, clusterIds, columns, numCompDims, totalClusters, silhouette);
+      break;
+    }
+    case KUtilities::DistanceMetric::Manhattan: {
+      computeSilhouette<KUtilities::DistanceMetric::Manhattan>(points, clusterIds, columns, numCompDims, totalClusters, silhouette);
+      break;
+    }
+    case KUtilities::DistanceMetric::Cosine: {
+      computeSilhouette<KUtilities::DistanceMetric::Cosine>(points, clusterIds, columns, numCompDims, totalClusters, silhouette);
+      break;
+    }
+    case KUtilities::DistanceMetric::Pearson: {
+      computeSilhouette<KUtilities::DistanceMetric::Pearson>(points, clusterIds, columns, numCompDims, totalClusters, silhouette);
+      break;
+    }
+    case KUtilities::DistanceMetric::SquaredPearson: {
+      computeSilhouette<KUtilities::DistanceMetric::SquaredPearson>(points, clusterIds, columns, numCompDims, totalClusters, silhouette);
+      break;
+    }
+    }
+    if(m_ShouldCancel)
+    {
+      return;
     }
 
-    for(usize i = 0; i < numTuples; i++)
+    for(usize i = 0; i < numPoints; i++)
     {
-      if(m_Mask[i])
-      {
-        m_OutputData[i] = (outClusterMinDist[i] - inClusterDist[i]) / (std::max(outClusterMinDist[i], inClusterDist[i]));
-      }
+      m_OutputData[tupleIndices[i]] = silhouette[i];
     }
   }
 
@@ -126,7 +266,17 @@ private:
   const Int32Array& m_FeatureIds;
   const BoolArray& m_Mask;
   usize m_NumClusters;
-  KUtilities::DistanceMetric m_DistMetric;
+  const SilhouetteInputValues& m_InputValues;
+  const std::atomic_bool& m_ShouldCancel;
+
+  template <KUtilities::DistanceMetric Metric>
+  void computeSilhouette(const std::vector<float64>& points, const std::vector<int32>& clusterIds, const SilhouetteColumns& columns, usize numCompDims, usize totalClusters,
+                         std::vector<float64>& silhouette) const
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, clusterIds.size());
+    dataAlg.execute(ComputeSilhouetteImpl<Metric>(points, clusterIds, columns, numCompDims, totalClusters, silhouette, m_ShouldCancel));
+  }
 };
 } // namespace
 
@@ -168,6 +318,6 @@ Result<> Silhouette::operator()()
 
   auto& clusteringArray = m_DataStructure.getDataRefAs<IDataArray>(m_InputValues->ClusteringArrayPath);
   RunTemplateClass<SilhouetteTemplate, types::NoBooleanType>(clusteringArray.getDataType(), clusteringArray, m_DataStructure.getDataRefAs<Float64Array>(m_InputValues->SilhouetteArrayPath),
-                                                             m_DataStructure.getDataRefAs<BoolArray>(m_InputValues->MaskArrayPath), uniqueIds.size(), featureIds, m_InputValues->DistanceMetric);
+                                                             m_DataStructure.getDataRefAs<BoolArray>(m_InputValues->MaskArrayPath), uniqueIds.size(), featureIds, *m_InputValues, m_ShouldCancel);
   return {};
 }
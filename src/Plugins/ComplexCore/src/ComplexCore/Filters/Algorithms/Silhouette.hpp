@@ -19,6 +19,9 @@ struct COMPLEXCORE_EXPORT SilhouetteInputValues
   DataPath MaskArrayPath;
   DataPath FeatureIdsArrayPath;
   DataPath SilhouetteArrayPath;
+  bool UseSampling = false;
+  usize SampleSize = 0;
+  uint64 Seed = 0;
 };
 
 /**
@@ -10,6 +10,8 @@
 #include "complex/Parameters/GeometrySelectionParameter.hpp"
 #include "complex/Parameters/NumberParameter.hpp"
 
+#include <algorithm>
+
 using namespace complex;
 
 namespace complex
@@ -73,6 +75,20 @@ IFilter::UniquePointer ErodeDilateMaskFilter::clone() const
   return std::make_unique<ErodeDilateMaskFilter>();
 }
 
+//------------------------------------------------------------------------------
+std::optional<usize> ErodeDilateMaskFilter::slabHaloWidth(const Arguments& args) const
+{
+  if(!args.contains(k_ZDirOn_Key) || !args.contains(k_NumIterations_Key))
+  {
+    return {};
+  }
+  if(!args.value<bool>(k_ZDirOn_Key))
+  {
+    return 0;
+  }
+  return static_cast<usize>(std::max(args.value<int32>(k_NumIterations_Key), 0));
+}
+
 //------------------------------------------------------------------------------
 IFilter::PreflightResult ErodeDilateMaskFilter::preflightImpl(const DataStructure& dataStructure, const Arguments& filterArgs, const MessageHandler& messageHandler,
                                                               const std::atomic_bool& shouldCancel) const
@@ -107,6 +123,8 @@ Result<> ErodeDilateMaskFilter::executeImpl(DataStructure& dataStructure, const
   inputValues.ZDirOn = filterArgs.value<bool>(k_ZDirOn_Key);
   inputValues.MaskArrayPath = filterArgs.value<DataPath>(k_MaskArrayPath_Key);
   inputValues.InputImageGeometry = filterArgs.value<DataPath>(k_SelectedImageGeometry_Key);
+  inputValues.HaloWidth = slabHaloWidth(filterArgs).value_or(0);
+  inputValues.SlabDepth = 0;
 
   return ErodeDilateMask(dataStructure, messageHandler, shouldCancel, &inputValues)();
 }
@@ -76,6 +76,14 @@ public:
    */
   UniquePointer clone() const override;
 
+  /**
+   * @brief Each iteration reads the direct neighbors of a voxel, so a slab needs
+   * one halo layer per iteration when the Z direction is enabled.
+   * @param args
+   * @return
+   */
+  std::optional<usize> slabHaloWidth(const Arguments& args) const override;
+
 protected:
   /**
    * @brief Takes in a DataStructure and checks that the filter can be run on it with the given arguments.
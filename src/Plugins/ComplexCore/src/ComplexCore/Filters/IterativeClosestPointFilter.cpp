@@ -6,12 +6,26 @@
 #include "complex/DataStructure/Geometry/VertexGeom.hpp"
 #include "complex/Filter/Actions/CreateArrayAction.hpp"
 #include "complex/Parameters/ArrayCreationParameter.hpp"
+#include "complex/Parameters/ArraySelectionParameter.hpp"
 #include "complex/Parameters/BoolParameter.hpp"
+#include "complex/Parameters/ChoicesParameter.hpp"
+#include "complex/Parameters/DataObjectNameParameter.hpp"
 #include "complex/Parameters/DataPathSelectionParameter.hpp"
 #include "complex/Parameters/NumberParameter.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 
+#include <Eigen/Dense>
 #include <Eigen/Geometry>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <numeric>
+#include <random>
+
 namespace complex
 {
 namespace
@@ -20,6 +34,11 @@ constexpr int32 k_MissingMovingVertex = -4500;
 constexpr int32 k_MissingTargetVertex = -4501;
 constexpr int32 k_BadNumIterations = -4502;
 constexpr int32 k_MissingVertices = -4503;
+constexpr int32 k_MissingNormals = -4504;
+constexpr int32 k_BadNormals = -4505;
+constexpr int32 k_BadSampleFraction = -4506;
+constexpr int32 k_BadVoxelSize = -4507;
+constexpr int32 k_BadSamplingMethod = -4508;
 
 template <typename Derived>
 struct VertexGeomAdaptor
@@ -60,6 +79,91 @@ struct VertexGeomAdaptor
     return false;
   }
 };
+
+using Adaptor = VertexGeomAdaptor<VertexGeom*>;
+using KDtree = nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Adaptor<float32, Adaptor>, Adaptor, 3>;
+using Transform = Eigen::Matrix<float, 4, 4, Eigen::ColMajor>;
+
+/**
+ * @brief Returns the ids of the moving vertices used to estimate the transform in ascending order.
+ * Random sampling keeps the given fraction of the vertices and voxel grid sampling keeps the
+ * first vertex in every occupied cell of a grid with the given spacing.
+ */
+std::vector<usize> SampleMovingVertices(const Float32Array& vertices, uint64 samplingMethod, float32 sampleFraction, uint64 seed, float32 voxelSize)
+{
+  std::vector<usize> vertexIds(vertices.getNumberOfTuples());
+  std::iota(vertexIds.begin(), vertexIds.end(), 0);
+
+  if(samplingMethod == IterativeClosestPointFilter::k_RandomSampling)
+  {
+    const auto sampleCount = std::max<usize>(1, static_cast<usize>(std::llround(static_cast<float64>(sampleFraction) * vertexIds.size())));
+    std::vector<usize> sampledIds;
+    sampledIds.reserve(sampleCount);
+    std::sample(vertexIds.begin(), vertexIds.end(), std::back_inserter(sampledIds), sampleCount, std::mt19937_64(seed));
+    return sampledIds;
+  }
+
+  if(samplingMethod == IterativeClosestPointFilter::k_VoxelGridSampling)
+  {
+    auto cellOf = [&vertices, voxelSize](usize vertexId) {
+      return std::array<int64, 3>{static_cast<int64>(std::floor(vertices[3 * vertexId + 0] / voxelSize)), static_cast<int64>(std::floor(vertices[3 * vertexId + 1] / voxelSize)),
+                                  static_cast<int64>(std::floor(vertices[3 * vertexId + 2] / voxelSize))};
+    };
+    // The stable sort keeps the lowest vertex id at the front of every cell
+    std::stable_sort(vertexIds.begin(), vertexIds.end(), [&cellOf](usize lhs, usize rhs) { return cellOf(lhs) < cellOf(rhs); });
+    vertexIds.erase(std::unique(vertexIds.begin(), vertexIds.end(), [&cellOf](usize lhs, usize rhs) { return cellOf(lhs) == cellOf(rhs); }), vertexIds.end());
+    std::sort(vertexIds.begin(), vertexIds.end());
+  }
+  return vertexIds;
+}
+
+/**
+ * @brief Solves for the rigid transform that minimizes the distances from the moving points to
+ * the planes through their corresponding target points. The rotation is linearized for small
+ * angles, which makes this a 6x6 linear least squares problem.
+ */
+template <typename T>
+Transform SolvePointToPlane(const std::vector<float32>& moving, const std::vector<float32>& matched, const std::vector<usize>& correspondences, const DataArray<T>& normals)
+{
+  Eigen::Matrix<float64, 6, 6> lhs = Eigen::Matrix<float64, 6, 6>::Zero();
+  Eigen::Matrix<float64, 6, 1> rhs = Eigen::Matrix<float64, 6, 1>::Zero();
+  for(usize j = 0; j < correspondences.size(); j++)
+  {
+    const Eigen::Vector3d point(moving[3 * j + 0], moving[3 * j + 1], moving[3 * j + 2]);
+    const Eigen::Vector3d target(matched[3 * j + 0], matched[3 * j + 1], matched[3 * j + 2]);
+    const usize targetId = correspondences[j];
+    const Eigen::Vector3d normal(normals[3 * targetId + 0], normals[3 * targetId + 1], normals[3 * targetId + 2]);
+
+    Eigen::Matrix<float64, 6, 1> row;
+    row << point.cross(normal), normal;
+    lhs += row * row.transpose();
+    rhs += row * (target - point).dot(normal);
+  }
+
+  // Flat or otherwise degenerate targets leave some motions unconstrained, those get the minimum norm solution
+  const Eigen::Matrix<float64, 6, 1> solution = lhs.completeOrthogonalDecomposition().solve(rhs);
+  const Eigen::Matrix3d rotation =
+      (Eigen::AngleAxisd(solution[2], Eigen::Vector3d::UnitZ()) * Eigen::AngleAxisd(solution[1], Eigen::Vector3d::UnitY()) * Eigen::AngleAxisd(solution[0], Eigen::Vector3d::UnitX()))
+          .toRotationMatrix();
+
+  Transform transform = Transform::Identity();
+  transform.block<3, 3>(0, 0) = rotation.cast<float32>();
+  transform.block<3, 1>(0, 3) = solution.tail<3>().cast<float32>();
+  return transform;
+}
+
+/**
+ * @brief Applies the transform to the points of the given range in place.
+ */
+void TransformPoints(const Transform& transform, float32* points, const Range& range)
+{
+  for(usize j = range.min(); j < range.max(); j++)
+  {
+    Eigen::Vector4f position(points[3 * j + 0], points[3 * j + 1], points[3 * j + 2], 1);
+    Eigen::Vector4f transformedPosition = transform * position;
+    std::memcpy(points + (3 * j), transformedPosition.data(), sizeof(float) * 3);
+  }
+}
 } // namespace
 
 //------------------------------------------------------------------------------
@@ -98,15 +202,41 @@ Parameters IterativeClosestPointFilter::parameters() const
   Parameters params;
 
   params.insertSeparator(Parameters::Separator{"Input Parameters"});
-  params.insert(std::make_unique<UInt64Parameter>(k_NumIterations_Key, "Number of Iterations", "The number of times to run the algorithm [more increases accuracy]", 1));
+  params.insert(std::make_unique<UInt64Parameter>(k_NumIterations_Key, "Number of Iterations", "The maximum number of times to run the algorithm [more increases accuracy]", 1));
+  params.insert(std::make_unique<Float32Parameter>(k_ConvergenceTolerance_Key, "Convergence Tolerance",
+                                                   "Stops iterating once the RMS distance between corresponding points changes by less than this value. 0 runs every iteration", 0.0f));
   params.insert(std::make_unique<BoolParameter>(k_ApplyTransformation_Key, "Apply Transformation to Moving Geometry", "If checked, geometry will be updated implicitly", false));
+  params.insertLinkableParameter(std::make_unique<BoolParameter>(k_UsePointToPlane_Key, "Use Point to Plane Distance",
+                                                                 "If checked, the distance from each moving point to the plane through its closest target point is minimized instead of "
+                                                                 "the distance between the points. Requires normals for the target vertices",
+                                                                 false));
+
+  params.insertSeparator(Parameters::Separator{"Moving Geometry Sampling"});
+  params.insertLinkableParameter(std::make_unique<ChoicesParameter>(k_SamplingMethod_Key, "Sampling Method",
+                                                                    "Which moving vertices are used to estimate the transform. The transform is still applied to every vertex", k_NoSampling,
+                                                                    ChoicesParameter::Choices{"None", "Random", "Voxel Grid"})); // sequence dependent DO NOT REORDER
+  params.insert(std::make_unique<Float32Parameter>(k_SampleFraction_Key, "Sample Fraction", "The fraction of the moving vertices that is randomly selected (0, 1]", 0.1f));
+  params.insert(std::make_unique<Float32Parameter>(k_VoxelSize_Key, "Voxel Size", "The edge length of the grid cells, one vertex is kept per occupied cell", 1.0f));
+
+  params.insertSeparator(Parameters::Separator{"Seeded Randomness"});
+  params.insertLinkableParameter(std::make_unique<BoolParameter>(k_UseSeed_Key, "Use Seed for Random Generation", "When true the user will be able to put in a seed for random generation", false));
+  params.insert(std::make_unique<NumberParameter<uint64>>(k_SeedValue_Key, "Seed Value", "The seed fed into the random generator", std::mt19937_64::default_seed));
+  params.insert(std::make_unique<DataObjectNameParameter>(k_SeedArrayName_Key, "Stored Seed Value Array Name", "Name of array holding the seed value", "IterativeClosestPoint SeedValue"));
 
   params.insertSeparator(Parameters::Separator{"Required Data Objects"});
   params.insert(std::make_unique<DataPathSelectionParameter>(k_MovingVertexPath_Key, "Moving Vertex Geometry", "The geometry to align [mutable]", DataPath()));
   params.insert(std::make_unique<DataPathSelectionParameter>(k_TargetVertexPath_Key, "Target Vertex Geometry", "The geometry to be matched against [immutable]", DataPath()));
+  params.insert(std::make_unique<ArraySelectionParameter>(k_TargetNormalsArrayPath_Key, "Target Vertex Normals", "The normals of the target vertices, used for the point to plane distance",
+                                                          DataPath{}, ArraySelectionParameter::AllowedTypes{DataType::float32, DataType::float64}));
 
   params.insertSeparator(Parameters::Separator{"Created Data Objects"});
   params.insert(std::make_unique<ArrayCreationParameter>(k_TransformArrayPath_Key, "Output Transform Array", "This is the array to store the transform matrix in", DataPath()));
+
+  // Associate the Linkable Parameter(s) to the children parameters that they control
+  params.linkParameters(k_UsePointToPlane_Key, k_TargetNormalsArrayPath_Key, true);
+  params.linkParameters(k_SamplingMethod_Key, k_SampleFraction_Key, std::make_any<ChoicesParameter::ValueType>(k_RandomSampling));
+  params.linkParameters(k_SamplingMethod_Key, k_VoxelSize_Key, std::make_any<ChoicesParameter::ValueType>(k_VoxelGridSampling));
+  params.linkParameters(k_UseSeed_Key, k_SeedValue_Key, true);
   return params;
 }
 
@@ -123,6 +253,7 @@ IFilter::PreflightResult IterativeClosestPointFilter::preflightImpl(const DataSt
   auto targetVertexPath = args.value<DataPath>(k_TargetVertexPath_Key);
   auto numIterations = args.value<uint64>(k_NumIterations_Key);
   auto transformArrayPath = args.value<DataPath>(k_TransformArrayPath_Key);
+  auto seedArrayName = args.value<std::string>(k_SeedArrayName_Key);
 
   if(data.getDataAs<VertexGeom>(movingVertexPath) == nullptr)
   {
@@ -141,11 +272,54 @@ IFilter::PreflightResult IterativeClosestPointFilter::preflightImpl(const DataSt
     return {nonstd::make_unexpected(std::vector<Error>{Error{k_BadNumIterations, ss}})};
   }
 
+  auto samplingMethod = args.value<ChoicesParameter::ValueType>(k_SamplingMethod_Key);
+  if(samplingMethod == k_RandomSampling)
+  {
+    auto sampleFraction = args.value<float32>(k_SampleFraction_Key);
+    if(sampleFraction <= 0.0f || sampleFraction > 1.0f)
+    {
+      auto ss = fmt::format("Sample Fraction must be larger than 0 and at most 1, but is {}", sampleFraction);
+      return {nonstd::make_unexpected(std::vector<Error>{Error{k_BadSampleFraction, ss}})};
+    }
+  }
+  else if(samplingMethod == k_VoxelGridSampling)
+  {
+    auto voxelSize = args.value<float32>(k_VoxelSize_Key);
+    if(voxelSize <= 0.0f)
+    {
+      auto ss = fmt::format("Voxel Size must be larger than 0, but is {}", voxelSize);
+      return {nonstd::make_unexpected(std::vector<Error>{Error{k_BadVoxelSize, ss}})};
+    }
+  }
+  else if(samplingMethod != k_NoSampling)
+  {
+    auto ss = fmt::format("Unknown sampling method {}", samplingMethod);
+    return {nonstd::make_unexpected(std::vector<Error>{Error{k_BadSamplingMethod, ss}})};
+  }
+
+  if(args.value<bool>(k_UsePointToPlane_Key))
+  {
+    auto targetNormalsPath = args.value<DataPath>(k_TargetNormalsArrayPath_Key);
+    const auto* targetNormals = data.getDataAs<IDataArray>(targetNormalsPath);
+    if(targetNormals == nullptr)
+    {
+      auto ss = fmt::format("Target Vertex Normals not found at path: {}", targetNormalsPath.toString());
+      return {nonstd::make_unexpected(std::vector<Error>{Error{k_MissingNormals, ss}})};
+    }
+    const auto* targetVertices = data.getDataRefAs<VertexGeom>(targetVertexPath).getVertices();
+    if(targetNormals->getNumberOfComponents() != 3 || (targetVertices != nullptr && targetNormals->getNumberOfTuples() != targetVertices->getNumberOfTuples()))
+    {
+      auto ss = fmt::format("Target Vertex Normals must have 3 components and one tuple per target vertex");
+      return {nonstd::make_unexpected(std::vector<Error>{Error{k_BadNormals, ss}})};
+    }
+  }
+
   usize numTuples = 1;
   auto action = std::make_unique<CreateArrayAction>(DataType::float32, std::vector<usize>{numTuples}, std::vector<usize>{16}, transformArrayPath);
 
   OutputActions actions;
   actions.appendAction(std::move(action));
+  actions.appendAction(std::make_unique<CreateArrayAction>(DataType::uint64, std::vector<usize>{1}, std::vector<usize>{1}, DataPath({seedArrayName})));
 
   return {std::move(actions)};
 }
@@ -159,6 +333,17 @@ Result<> IterativeClosestPointFilter::executeImpl(DataStructure& data, const Arg
   auto numIterations = args.value<uint64>(k_NumIterations_Key);
   auto applyTransformation = args.value<bool>(k_ApplyTransformation_Key);
   auto transformArrayPath = args.value<DataPath>(k_TransformArrayPath_Key);
+  auto convergenceTolerance = args.value<float32>(k_ConvergenceTolerance_Key);
+  auto samplingMethod = args.value<ChoicesParameter::ValueType>(k_SamplingMethod_Key);
+  auto sampleFraction = args.value<float32>(k_SampleFraction_Key);
+  auto seed = args.value<uint64>(k_SeedValue_Key);
+  if(!args.value<bool>(k_UseSeed_Key))
+  {
+    seed = static_cast<uint64>(std::chrono::steady_clock::now().time_since_epoch().count());
+  }
+  auto voxelSize = args.value<float32>(k_VoxelSize_Key);
+  auto usePointToPlane = args.value<bool>(k_UsePointToPlane_Key);
+  auto targetNormalsPath = args.value<DataPath>(k_TargetNormalsArrayPath_Key);
 
   auto movingVertexGeom = data.getDataAs<VertexGeom>(movingVertexPath);
   auto targetVertexGeom = data.getDataAs<VertexGeom>(targetVertexPath);
@@ -185,34 +370,71 @@ Result<> IterativeClosestPointFilter::executeImpl(DataStructure& data, const Arg
     return {nonstd::make_unexpected(std::vector<Error>{Error{k_MissingVertices, ss}})};
   }
 
+  if(movingVertexGeom->getNumberOfVertices() == 0 || targetVertexGeom->getNumberOfVertices() == 0)
+  {
+    auto ss = fmt::format("Moving and Target Vertex Geometries must contain at least one vertex");
+    return {nonstd::make_unexpected(std::vector<Error>{Error{k_MissingVertices, ss}})};
+  }
+
+  // Store Seed Value in Top Level Array
+  data.getDataRefAs<UInt64Array>(DataPath({args.value<std::string>(k_SeedArrayName_Key)}))[0] = seed;
+
   auto* movingPtr = movingVertexGeom->getVertices();
   Float32Array& targetPtr = *(targetVertexGeom->getVertices());
+  const IDataArray* targetNormals = usePointToPlane ? data.getDataAs<IDataArray>(targetNormalsPath) : nullptr;
 
-  auto* movingStore = movingPtr->getDataStore();
-  std::vector<float32> movingVector(movingStore->begin(), movingStore->end());
+  // The transform is estimated on a working copy of the sampled moving vertices
+  const std::vector<usize> sampledIds = SampleMovingVertices(*movingPtr, samplingMethod, sampleFraction, seed, voxelSize);
+  const usize numSamples = sampledIds.size();
+  std::vector<float32> movingVector(numSamples * 3, 0.0F);
+  for(usize j = 0; j < numSamples; j++)
+  {
+    for(usize k = 0; k < 3; k++)
+    {
+      movingVector[3 * j + k] = (*movingPtr)[3 * sampledIds[j] + k];
+    }
+  }
   float32* movingCopyPtr = movingVector.data();
-  DataStructure tmp;
+  if(numSamples != movingVertexGeom->getNumberOfVertices())
+  {
+    messageHandler(fmt::format("Registering {} of {} moving vertices", numSamples, movingVertexGeom->getNumberOfVertices()));
+  }
 
-  usize numMovingVerts = movingVertexGeom->getNumberOfVertices();
-  std::vector<float32> dynTarget(numMovingVerts * 3, 0.0F);
+  std::vector<float32> dynTarget(numSamples * 3, 0.0F);
   float* dynTargetPtr = dynTarget.data();
+  std::vector<usize> correspondences(numSamples, 0);
+  std::vector<float32> squaredDistances(numSamples, 0.0F);
 
-  using Adaptor = VertexGeomAdaptor<VertexGeom*>;
   const Adaptor adaptor(targetVertexGeom);
 
   messageHandler("Building kd-tree index...");
 
-  using KDtree = nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Adaptor<float32, Adaptor>, Adaptor, 3>;
   KDtree index(3, adaptor, nanoflann::KDTreeSingleIndexAdaptorParams(30));
   index.buildIndex();
 
+  // Queries on the built index are read-only, so every vertex searches for its correspondence concurrently
+  const bool targetInMemory = IParallelAlgorithm::CheckArraysInMemory({&targetPtr, targetNormals});
+  auto findCorrespondences = [&](const Range& range) {
+    for(usize j = range.min(); j < range.max(); j++)
+    {
+      usize identifier;
+      float dist;
+      nanoflann::KNNResultSet<float> results(1);
+      results.init(&identifier, &dist);
+      index.findNeighbors(results, movingCopyPtr + (3 * j), nanoflann::SearchParams());
+      correspondences[j] = identifier;
+      squaredDistances[j] = dist;
+      dynTargetPtr[3 * j + 0] = targetPtr[3 * identifier + 0];
+      dynTargetPtr[3 * j + 1] = targetPtr[3 * identifier + 1];
+      dynTargetPtr[3 * j + 2] = targetPtr[3 * identifier + 2];
+    }
+  };
+
   usize iters = numIterations;
-  const usize nn = 1;
 
   typedef Eigen::Matrix<float, 3, Eigen::Dynamic, Eigen::ColMajor> PointCloud;
-  typedef Eigen::Matrix<float, 4, 4, Eigen::ColMajor> UmeyamaTransform;
 
-  UmeyamaTransform globalTransform;
+  Transform globalTransform;
   globalTransform << 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1;
 
   int64 progIncrement = iters / 100;
@@ -220,6 +442,7 @@ Result<> IterativeClosestPointFilter::executeImpl(DataStructure& data, const Arg
   int64 progressInt = 0;
   int64 counter = 0;
 
+  float64 previousRms = 0.0;
   for(usize i = 0; i < iters; i++)
   {
     if(shouldCancel)
@@ -227,29 +450,42 @@ Result<> IterativeClosestPointFilter::executeImpl(DataStructure& data, const Arg
       return {};
     }
 
-    for(usize j = 0; j < numMovingVerts; j++)
+    ParallelDataAlgorithm correspondenceAlg;
+    correspondenceAlg.setRange(0, numSamples);
+    correspondenceAlg.setParallelizationEnabled(targetInMemory);
+    correspondenceAlg.execute(findCorrespondences);
+
+    const float64 rms = std::sqrt(std::accumulate(squaredDistances.begin(), squaredDistances.end(), 0.0) / static_cast<float64>(numSamples));
+    if(i > 0 && std::abs(previousRms - rms) < convergenceTolerance)
     {
-      usize identifier;
-      float dist;
-      nanoflann::KNNResultSet<float> results(nn);
-      results.init(&identifier, &dist);
-      index.findNeighbors(results, movingCopyPtr + (3 * j), nanoflann::SearchParams());
-      dynTargetPtr[3 * j + 0] = targetPtr[3 * identifier + 0];
-      dynTargetPtr[3 * j + 1] = targetPtr[3 * identifier + 1];
-      dynTargetPtr[3 * j + 2] = targetPtr[3 * identifier + 2];
+      messageHandler(fmt::format("Converged after {} iterations with an RMS distance of {}", i, rms));
+      break;
     }
+    previousRms = rms;
 
-    Eigen::Map<PointCloud> moving_(movingCopyPtr, 3, numMovingVerts);
-    Eigen::Map<PointCloud> target_(dynTargetPtr, 3, numMovingVerts);
-
-    UmeyamaTransform transform = Eigen::umeyama(moving_, target_, false);
-
-    for(usize j = 0; j < numMovingVerts; j++)
+    Transform transform;
+    if(usePointToPlane)
     {
-      Eigen::Vector4f position(movingCopyPtr[3 * j + 0], movingCopyPtr[3 * j + 1], movingCopyPtr[3 * j + 2], 1);
-      Eigen::Vector4f transformedPosition = transform * position;
-      std::memcpy(movingCopyPtr + (3 * j), transformedPosition.data(), sizeof(float) * 3);
+      if(targetNormals->getDataType() == DataType::float64)
+      {
+        transform = SolvePointToPlane(movingVector, dynTarget, correspondences, dynamic_cast<const Float64Array&>(*targetNormals));
+      }
+      else
+      {
+        transform = SolvePointToPlane(movingVector, dynTarget, correspondences, dynamic_cast<const Float32Array&>(*targetNormals));
+      }
+    }
+    else
+    {
+      Eigen::Map<PointCloud> moving_(movingCopyPtr, 3, numSamples);
+      Eigen::Map<PointCloud> target_(dynTargetPtr, 3, numSamples);
+      transform = Eigen::umeyama(moving_, target_, false);
     }
+
+    ParallelDataAlgorithm transformAlg;
+    transformAlg.setRange(0, numSamples);
+    transformAlg.execute([&transform, movingCopyPtr](const Range& range) { TransformPoints(transform, movingCopyPtr, range); });
+
     // Update the global transform
     globalTransform = transform * globalTransform;
 
@@ -267,15 +503,20 @@ Result<> IterativeClosestPointFilter::executeImpl(DataStructure& data, const Arg
 
   if(applyTransformation)
   {
-    for(usize j = 0; j < numMovingVerts; j++)
-    {
-      Eigen::Vector4f position((*movingPtr)[3 * j + 0], (*movingPtr)[3 * j + 1], (*movingPtr)[3 * j + 2], 1);
-      Eigen::Vector4f transformedPosition = globalTransform * position;
-      for(usize k = 0; k < 3; k++)
+    ParallelDataAlgorithm applyAlg;
+    applyAlg.setRange(0, movingVertexGeom->getNumberOfVertices());
+    applyAlg.requireArraysInMemory({movingPtr});
+    applyAlg.execute([&globalTransform, movingPtr](const Range& range) {
+      for(usize j = range.min(); j < range.max(); j++)
       {
-        (*movingPtr)[3 * j + k] = transformedPosition.data()[k];
+        Eigen::Vector4f position((*movingPtr)[3 * j + 0], (*movingPtr)[3 * j + 1], (*movingPtr)[3 * j + 2], 1);
+        Eigen::Vector4f transformedPosition = globalTransform * position;
+        for(usize k = 0; k < 3; k++)
+        {
+          (*movingPtr)[3 * j + k] = transformedPosition.data()[k];
+        }
       }
-    }
+    });
   }
 
   globalTransform.transposeInPlace();
@@ -26,6 +26,20 @@ public:
   static inline constexpr StringLiteral k_NumIterations_Key = "num_iterations";
   static inline constexpr StringLiteral k_ApplyTransformation_Key = "apply_transformation";
   static inline constexpr StringLiteral k_TransformArrayPath_Key = "transform_array";
+  static inline constexpr StringLiteral k_ConvergenceTolerance_Key = "convergence_tolerance";
+  static inline constexpr StringLiteral k_SamplingMethod_Key = "sampling_method";
+  static inline constexpr StringLiteral k_SampleFraction_Key = "sample_fraction";
+  static inline constexpr StringLiteral k_UseSeed_Key = "use_seed";
+  static inline constexpr StringLiteral k_SeedValue_Key = "seed_value";
+  static inline constexpr StringLiteral k_SeedArrayName_Key = "seed_array_name";
+  static inline constexpr StringLiteral k_VoxelSize_Key = "voxel_size";
+  static inline constexpr StringLiteral k_UsePointToPlane_Key = "use_point_to_plane";
+  static inline constexpr StringLiteral k_TargetNormalsArrayPath_Key = "target_normals";
+
+  // Sampling Methods
+  static inline constexpr uint64 k_NoSampling = 0;
+  static inline constexpr uint64 k_RandomSampling = 1;
+  static inline constexpr uint64 k_VoxelGridSampling = 2;
 
   /**
    * @brief
@@ -77,6 +77,9 @@ Parameters KMedoidsFilter::parameters() const
   params.insert(
       std::make_unique<ChoicesParameter>(k_DistanceMetric_Key, "Distance Metric", "Distance Metric type to be used for calculations", to_underlying(KUtilities::DistanceMetric::Euclidean),
                                          ChoicesParameter::Choices{"Euclidean", "Squared Euclidean", "Manhattan", "Cosine", "Pearson", "Squared Pearson"})); // sequence dependent DO NOT REORDER
+  params.insert(std::make_unique<ChoicesParameter>(k_InitializationMethod_Key, "Initialization Method",
+                                                   "How the initial clusters are chosen. K-Means++ spreads the initial clusters apart, which usually needs fewer iterations",
+                                                   to_underlying(KUtilities::InitializationMethod::Random), ChoicesParameter::Choices{"Random", "K-Means++"})); // sequence dependent DO NOT REORDER
 
   params.insertSeparator(Parameters::Separator{"Required Data Objects"});
   params.insert(std::make_unique<ArraySelectionParameter>(k_SelectedArrayPath_Key, "Attribute Array to Cluster", "The array to find the medoids for", DataPath{}, complex::GetAllNumericTypes()));
@@ -183,6 +186,7 @@ Result<> KMedoidsFilter::executeImpl(DataStructure& dataStructure, const Argumen
 
   inputValues.InitClusters = filterArgs.value<uint64>(k_InitClusters_Key);
   inputValues.DistanceMetric = static_cast<KUtilities::DistanceMetric>(filterArgs.value<ChoicesParameter::ValueType>(k_DistanceMetric_Key));
+  inputValues.InitializationMethod = static_cast<KUtilities::InitializationMethod>(filterArgs.value<ChoicesParameter::ValueType>(k_InitializationMethod_Key));
   inputValues.MaskArrayPath = maskPath;
   inputValues.MedoidsArrayPath = filterArgs.value<DataPath>(k_FeatureAMPath_Key).createChildPath(filterArgs.value<std::string>(k_MedoidsArrayName_Key));
   inputValues.Seed = seed;
@@ -17,9 +17,10 @@
 #include "complex/Parameters/ReadCSVFileParameter.hpp"
 #include "complex/Utilities/FileUtilities.hpp"
 #include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/IParallelAlgorithm.hpp"
+#include "complex/Utilities/Parsing/Text/TextTokenizer.hpp"
 #include "complex/Utilities/StringUtilities.hpp"
 
-#include <fstream>
 
 using namespace complex;
 
@@ -35,6 +36,7 @@ namespace
 struct ReadCSVFileFilterCache
 {
   std::string FilePath;
+  fs::file_time_type LastWriteTime;
   usize TotalLines = 0;
   usize HeadersLine = 0;
   std::string Headers;
@@ -195,49 +197,45 @@ Result<ParsersVector> createParsers(const DataTypeVector& dataTypes, const std::
 }
 
 // -----------------------------------------------------------------------------
-Result<> parseLine(std::fstream& inStream, const ParsersVector& dataParsers, const StringVector& headers, const CharVector& delimiters, bool consecutiveDelimiters, usize lineNumber, usize beginIndex)
+Result<> parseLine(std::string_view line, const ParsersVector& dataParsers, const StringVector& headers, const CharVector& delimiters, usize lineNumber, usize beginIndex)
 {
-  std::string line;
-  std::getline(inStream, line);
-
-  StringVector tokens = StringUtilities::split(line, delimiters, consecutiveDelimiters);
-  if(tokens.empty())
+  const usize numTokens = TextTokenizer::CountTokens(line, delimiters);
+  if(numTokens == 0)
   {
     // This is an empty line in the middle of the CSV file, which just shouldn't happen
     return MakeErrorResult(to_underlying(IssueCodes::EMPTY_LINE), fmt::format("Line #{} is empty!  You should not have any empty lines in the file.", std::to_string(lineNumber)));
   }
 
-  if(dataParsers.size() != tokens.size())
+  if(dataParsers.size() != numTokens)
   {
     return MakeErrorResult(to_underlying(IssueCodes::INCONSISTENT_COLS),
                            fmt::format("Expecting {} tokens but found {} tokens in the file at line #{}.\n\nInput line was:\n{}\n\nThis is because the data-"
                                        "types/headers/skipped-array-mask all have a size of {} but the file data at line #{} has a column count of {}.",
-                                       std::to_string(dataParsers.size()), std::to_string(tokens.size()), std::to_string(lineNumber), line, std::to_string(dataParsers.size()),
-                                       std::to_string(lineNumber), std::to_string(tokens.size())));
+                                       std::to_string(dataParsers.size()), std::to_string(numTokens), std::to_string(lineNumber), line, std::to_string(dataParsers.size()),
+                                       std::to_string(lineNumber), std::to_string(numTokens)));
   }
 
-  for(int i = 0; i < dataParsers.size(); i++)
-  {
-    const auto& dataParser = dataParsers[i];
+  Result<> result = {};
+  TextTokenizer::ForEachToken(line, delimiters, [&](usize index, std::string_view token) {
+    const auto& dataParser = dataParsers[index];
     if(dataParser == nullptr)
     {
-      continue;
+      return true;
     }
 
-    usize index = dataParser->columnIndex();
-
-    Result<> result = dataParser->parse(tokens[index], lineNumber - beginIndex);
+    result = dataParser->parse(token, lineNumber - beginIndex);
     if(result.invalid())
     {
       for(Error& error : result.errors())
       {
-        error.message = fmt::format("Array \"{}\", Line {}: ", headers[i], lineNumber) + error.message;
+        error.message = fmt::format("Array \"{}\", Line {}: ", headers[index], lineNumber) + error.message;
       }
-      return result;
+      return false;
     }
-  }
+    return true;
+  });
 
-  return {};
+  return result;
 }
 
 // -----------------------------------------------------------------------------
@@ -256,23 +254,6 @@ void notifyProgress(const IFilter::MessageHandler& messageHandler, usize lineNum
   }
 }
 
-// -----------------------------------------------------------------------------
-bool skipNumberOfLines(std::fstream& inStream, usize numberOfLines)
-{
-  for(usize i = 1; i < numberOfLines; i++)
-  {
-    if(inStream.eof())
-    {
-      return false;
-    }
-
-    std::string line;
-    std::getline(inStream, line);
-  }
-
-  return true;
-}
-
 std::string tupleDimsToString(const std::vector<usize>& tupleDims)
 {
   std::string tupleDimsStr;
@@ -290,20 +271,18 @@ std::string tupleDimsToString(const std::vector<usize>& tupleDims)
 //------------------------------------------------------------------------------
 IFilter::PreflightResult readHeaders(const std::string& inputFilePath, usize headersLineNum, ReadCSVFileFilterCache& headerCache)
 {
-  std::fstream in(inputFilePath.c_str(), std::ios_base::in);
-  if(!in.is_open())
+  std::unique_ptr<TextTokenizer> tokenizer = TextTokenizer::Open(inputFilePath);
+  if(tokenizer == nullptr)
   {
     return {MakeErrorResult<OutputActions>(to_underlying(IssueCodes::FILE_NOT_OPEN), fmt::format("Could not open file for reading: {}", inputFilePath)), {}};
   }
 
-  // Skip to the headers line
-  if(!skipNumberOfLines(in, headersLineNum))
+  if(headersLineNum == 0 || headersLineNum > tokenizer->getNumberOfLines())
   {
     return {MakeErrorResult<OutputActions>(to_underlying(IssueCodes::CANNOT_SKIP_TO_LINE), fmt::format("Could not skip to the chosen header line ({}).", headersLineNum)), {}};
   }
 
-  // Read the headers line
-  std::getline(in, headerCache.Headers);
+  headerCache.Headers = tokenizer->getLine(headersLineNum - 1);
   headerCache.HeadersLine = headersLineNum;
   return {};
 }
@@ -417,45 +396,43 @@ IFilter::PreflightResult ReadCSVFileFilter::preflightImpl(const DataStructure& d
   }
 
   StringVector headers;
-  if(readCSVData.inputFilePath != s_HeaderCache[s_InstanceId].FilePath)
-  {
-    std::fstream in(inputFilePath.c_str(), std::ios_base::in);
-    if(!in.is_open())
+  ReadCSVFileFilterCache& headerCache = s_HeaderCache[m_InstanceId];
+  std::error_code errorCode;
+  const fs::file_time_type lastWriteTime = fs::last_write_time(inputFilePath, errorCode);
+  if(readCSVData.inputFilePath != headerCache.FilePath || lastWriteTime != headerCache.LastWriteTime)
+  {
+    // The tokenizer finds the line boundaries in parallel blocks
+    std::unique_ptr<TextTokenizer> tokenizer = TextTokenizer::Open(inputFilePath);
+    if(tokenizer == nullptr)
     {
       return {MakeErrorResult<OutputActions>(to_underlying(IssueCodes::FILE_NOT_OPEN), fmt::format("Could not open file for reading: {}", inputFilePath)), {}};
     }
 
-    s_HeaderCache[s_InstanceId].FilePath = readCSVData.inputFilePath;
-
-    usize lineCount = 0;
-    while(!in.eof())
+    headerCache.FilePath = readCSVData.inputFilePath;
+    headerCache.LastWriteTime = lastWriteTime;
+    headerCache.TotalLines = tokenizer->getNumberOfLines();
+    headerCache.Headers.clear();
+    headerCache.HeadersLine = 0;
+    if(headerMode == ReadCSVData::HeaderMode::LINE && readCSVData.headersLine > 0 && readCSVData.headersLine <= headerCache.TotalLines)
     {
-      std::string line;
-      std::getline(in, line);
-      lineCount++;
-
-      if(headerMode == ReadCSVData::HeaderMode::LINE && lineCount == readCSVData.headersLine)
-      {
-        s_HeaderCache[s_InstanceId].Headers = line;
-        s_HeaderCache[s_InstanceId].HeadersLine = readCSVData.headersLine;
-      }
+      headerCache.Headers = tokenizer->getLine(readCSVData.headersLine - 1);
+      headerCache.HeadersLine = readCSVData.headersLine;
     }
 
-    headers = StringUtilities::split(s_HeaderCache[s_InstanceId].Headers, readCSVData.delimiters, readCSVData.consecutiveDelimiters);
-    s_HeaderCache[s_InstanceId].TotalLines = lineCount;
+    headers = StringUtilities::split(headerCache.Headers, readCSVData.delimiters, readCSVData.consecutiveDelimiters);
   }
   else if(headerMode == ReadCSVData::HeaderMode::LINE)
   {
-    if(readCSVData.headersLine != s_HeaderCache[s_InstanceId].HeadersLine)
+    if(readCSVData.headersLine != headerCache.HeadersLine)
     {
-      IFilter::PreflightResult result = readHeaders(readCSVData.inputFilePath, readCSVData.headersLine, s_HeaderCache[s_InstanceId]);
+      IFilter::PreflightResult result = readHeaders(readCSVData.inputFilePath, readCSVData.headersLine, headerCache);
       if(result.outputActions.invalid())
       {
         return result;
       }
     }
 
-    headers = StringUtilities::split(s_HeaderCache[s_InstanceId].Headers, readCSVData.delimiters, readCSVData.consecutiveDelimiters);
+    headers = StringUtilities::split(headerCache.Headers, readCSVData.delimiters, readCSVData.consecutiveDelimiters);
   }
 
   if(headerMode == ReadCSVData::HeaderMode::CUSTOM)
@@ -463,7 +440,7 @@ IFilter::PreflightResult ReadCSVFileFilter::preflightImpl(const DataStructure& d
     headers = readCSVData.customHeaders;
   }
 
-  usize totalLines = s_HeaderCache[s_InstanceId].TotalLines;
+  usize totalLines = headerCache.TotalLines;
 
   // Check that we have a valid start import row
   if(readCSVData.startImportRow == 0)
@@ -634,10 +611,9 @@ Result<> ReadCSVFileFilter::executeImpl(DataStructure& dataStructure, const Argu
   DataPath createdDataGroup = filterArgs.value<DataPath>(k_CreatedDataGroup_Key);
 
   std::string inputFilePath = readCSVData.inputFilePath;
-  StringVector headers = StringUtilities::split(s_HeaderCache[s_InstanceId].Headers, readCSVData.delimiters, readCSVData.consecutiveDelimiters);
+  StringVector headers = StringUtilities::split(s_HeaderCache[m_InstanceId].Headers, readCSVData.delimiters, readCSVData.consecutiveDelimiters);
   DataTypeVector dataTypes = readCSVData.dataTypes;
   std::vector<bool> skippedArrays = readCSVData.skippedArrayMask;
-  bool consecutiveDelimiters = readCSVData.consecutiveDelimiters;
   usize startImportRow = readCSVData.startImportRow;
 
   if(readCSVData.headerMode == ReadCSVData::HeaderMode::CUSTOM)
@@ -657,14 +633,15 @@ Result<> ReadCSVFileFilter::executeImpl(DataStructure& dataStructure, const Argu
     return ConvertResult(std::move(parsersResult));
   }
 
-  std::fstream in(inputFilePath.c_str(), std::ios_base::in);
-  if(!in.is_open())
+  std::unique_ptr<TextTokenizer> tokenizer = TextTokenizer::Open(inputFilePath);
+  if(tokenizer == nullptr)
   {
     return MakeErrorResult(to_underlying(IssueCodes::FILE_NOT_OPEN), fmt::format("Could not open file for reading: {}", inputFilePath));
   }
 
   // Skip to the first data line
-  if(!skipNumberOfLines(in, startImportRow))
+  const usize firstLine = startImportRow > 0 ? startImportRow - 1 : 0;
+  if(firstLine > tokenizer->getNumberOfLines())
   {
     return MakeErrorResult(to_underlying(IssueCodes::CANNOT_SKIP_TO_LINE), fmt::format("Could not skip to the first line in the file to import ({}).", startImportRow));
   }
@@ -676,22 +653,39 @@ Result<> ReadCSVFileFilter::executeImpl(DataStructure& dataStructure, const Argu
     const AttributeMatrix& am = dataStructure.getDataRefAs<AttributeMatrix>(groupPath);
     numTuples = std::accumulate(am.getShape().cbegin(), am.getShape().cend(), static_cast<usize>(1), std::multiplies<>());
   }
-  usize lineNum = startImportRow;
-  for(usize i = 0; i < numTuples && !in.eof(); i++)
+
+  // The parsers write into the arrays from multiple threads
+  const ParsersVector& dataParsers = parsersResult.value();
+  IParallelAlgorithm::AlgorithmArrays dataArrays;
+  for(const auto& dataParser : dataParsers)
+  {
+    if(dataParser != nullptr)
+    {
+      dataArrays.push_back(&dataParser->dataArray());
+    }
+  }
+  tokenizer->setParallelizationEnabled(IParallelAlgorithm::CheckArraysInMemory(dataArrays));
+
+  // Parse the lines in steps of 5% so that the progress is reported and canceling is checked in between
+  const usize stepSize = std::max(numTuples / 20, static_cast<usize>(1));
+  for(usize stepStart = 0; stepStart < numTuples; stepStart += stepSize)
   {
     if(shouldCancel)
     {
       return {};
     }
 
-    Result<> parsingResult = parseLine(in, parsersResult.value(), headers, readCSVData.delimiters, consecutiveDelimiters, lineNum, startImportRow);
-    if(parsingResult.invalid())
+    const usize stepLines = std::min(stepSize, numTuples - stepStart);
+    const usize failedLine = tokenizer->forEachLine(firstLine + stepStart, stepLines, [&](usize lineIndex, std::string_view line) {
+      return parseLine(line, dataParsers, headers, readCSVData.delimiters, lineIndex + 1, firstLine + 1).valid();
+    });
+    if(failedLine != TextTokenizer::k_AllLines)
     {
-      return std::move(parsingResult);
+      // Parse the first line that failed again to get its error
+      return parseLine(tokenizer->getLine(failedLine), dataParsers, headers, readCSVData.delimiters, failedLine + 1, firstLine + 1);
     }
 
-    notifyProgress(messageHandler, lineNum, numTuples, threshold);
-    lineNum++;
+    notifyProgress(messageHandler, stepStart + stepLines, numTuples, threshold);
   }
 
   return {};
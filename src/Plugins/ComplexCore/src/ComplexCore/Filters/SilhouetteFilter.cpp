@@ -12,8 +12,13 @@
 #include "complex/Parameters/ArraySelectionParameter.hpp"
 #include "complex/Parameters/BoolParameter.hpp"
 #include "complex/Parameters/ChoicesParameter.hpp"
+#include "complex/Parameters/DataObjectNameParameter.hpp"
+#include "complex/Parameters/NumberParameter.hpp"
 #include "complex/Utilities/KUtilities.hpp"
 
+#include <chrono>
+#include <random>
+
 using namespace complex;
 
 namespace
@@ -69,6 +74,16 @@ Parameters SilhouetteFilter::parameters() const
       std::make_unique<ChoicesParameter>(k_DistanceMetric_Key, "Distance Metric", "Distance Metric type to be used for calculations", to_underlying(KUtilities::DistanceMetric::Euclidean),
                                          ChoicesParameter::Choices{"Euclidean", "Squared Euclidean", "Manhattan", "Cosine", "Pearson", "Squared Pearson"})); // sequence dependent DO NOT REORDER
 
+  params.insertSeparator(Parameters::Separator{"Sampling"});
+  params.insertLinkableParameter(std::make_unique<BoolParameter>(
+      k_UseSampling_Key, "Approximate Using Sampled Points",
+      "When true each point is only compared against a random sample of each cluster instead of every point. This approximates the silhouette for very large data sets.", false));
+  params.insert(std::make_unique<NumberParameter<uint64>>(k_SampleSize_Key, "Points Sampled Per Cluster", "The maximum number of randomly chosen points of each cluster that every point is compared to",
+                                                          1000));
+  params.insertLinkableParameter(std::make_unique<BoolParameter>(k_UseSeed_Key, "Use Seed for Random Generation", "When true the user will be able to put in a seed for random generation", false));
+  params.insert(std::make_unique<NumberParameter<uint64>>(k_SeedValue_Key, "Seed Value", "The seed fed into the random generator", std::mt19937::default_seed));
+  params.insert(std::make_unique<DataObjectNameParameter>(k_SeedArrayName_Key, "Stored Seed Value Array Name", "Name of array holding the seed value", "Silhouette SeedValue"));
+
   params.insertSeparator(Parameters::Separator{"Required Objects"});
   params.insert(std::make_unique<ArraySelectionParameter>(k_SelectedArrayPath_Key, "Attribute Array to Silhouette", "The DataPath to the input DataArray", DataPath{}, complex::GetAllNumericTypes()));
   params.insert(std::make_unique<ArraySelectionParameter>(k_FeatureIdsArrayPath_Key, "Cluster Ids", "The DataPath to the DataArray that specifies which cluster each point belongs", DataPath{},
@@ -79,6 +94,8 @@ Parameters SilhouetteFilter::parameters() const
 
   // Associate the Linkable Parameter(s) to the children parameters that they control
   params.linkParameters(k_UseMask_Key, k_MaskArrayPath_Key, true);
+  params.linkParameters(k_UseSampling_Key, k_SampleSize_Key, true);
+  params.linkParameters(k_UseSeed_Key, k_SeedValue_Key, true);
 
   return params;
 }
@@ -98,6 +115,9 @@ IFilter::PreflightResult SilhouetteFilter::preflightImpl(const DataStructure& da
   auto pMaskArrayPathValue = filterArgs.value<DataPath>(k_MaskArrayPath_Key);
   auto pFeatureIdsArrayPathValue = filterArgs.value<DataPath>(k_FeatureIdsArrayPath_Key);
   auto pSilhouetteArrayPathValue = filterArgs.value<DataPath>(k_SilhouetteArrayPath_Key);
+  auto pUseSamplingValue = filterArgs.value<bool>(k_UseSampling_Key);
+  auto pSampleSizeValue = filterArgs.value<uint64>(k_SampleSize_Key);
+  auto pSeedArrayNameValue = filterArgs.value<std::string>(k_SeedArrayName_Key);
 
   PreflightResult preflightResult;
   complex::Result<OutputActions> resultOutputActions;
@@ -111,6 +131,11 @@ IFilter::PreflightResult SilhouetteFilter::preflightImpl(const DataStructure& da
                                                        clusterIds->getName(), clusterIds->getNumberOfTuples()));
   }
 
+  if(pUseSamplingValue && pSampleSizeValue == 0)
+  {
+    return MakePreflightErrorResult(-8977, "The number of points sampled per cluster must be greater than 0");
+  }
+
   if(!pUseMaskValue)
   {
     DataPath tempPath = DataPath({k_MaskName});
@@ -127,6 +152,11 @@ IFilter::PreflightResult SilhouetteFilter::preflightImpl(const DataStructure& da
     resultOutputActions.value().appendAction(std::move(createAction));
   }
 
+  {
+    auto createAction = std::make_unique<CreateArrayAction>(DataType::uint64, std::vector<usize>{1}, std::vector<usize>{1}, DataPath({pSeedArrayNameValue}));
+    resultOutputActions.value().appendAction(std::move(createAction));
+  }
+
   // Return both the resultOutputActions and the preflightUpdatedValues via std::move()
   return {std::move(resultOutputActions), std::move(preflightUpdatedValues)};
 }
@@ -149,6 +179,16 @@ Result<> SilhouetteFilter::executeImpl(DataStructure& dataStructure, const Argum
   inputValues.MaskArrayPath = maskPath;
   inputValues.FeatureIdsArrayPath = filterArgs.value<DataPath>(k_FeatureIdsArrayPath_Key);
   inputValues.SilhouetteArrayPath = filterArgs.value<DataPath>(k_SilhouetteArrayPath_Key);
+  inputValues.UseSampling = filterArgs.value<bool>(k_UseSampling_Key);
+  inputValues.SampleSize = filterArgs.value<uint64>(k_SampleSize_Key);
+  inputValues.Seed = filterArgs.value<uint64>(k_SeedValue_Key);
+  if(!filterArgs.value<bool>(k_UseSeed_Key))
+  {
+    inputValues.Seed = static_cast<uint64>(std::chrono::steady_clock::now().time_since_epoch().count());
+  }
+
+  // Store Seed Value in Top Level Array
+  dataStructure.getDataRefAs<UInt64Array>(DataPath({filterArgs.value<std::string>(k_SeedArrayName_Key)}))[0] = inputValues.Seed;
 
   return Silhouette(dataStructure, messageHandler, shouldCancel, &inputValues)();
 }
@@ -2,6 +2,7 @@
 
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/Parameters/BoolParameter.hpp"
+#include "complex/Parameters/ChoicesParameter.hpp"
 #include "complex/Parameters/FileSystemPathParameter.hpp"
 #include "complex/Pipeline/Pipeline.hpp"
 #include "complex/Pipeline/PipelineFilter.hpp"
@@ -12,6 +13,9 @@ namespace
 {
 constexpr complex::int32 k_NoExportPathError = -1;
 constexpr complex::int32 k_FailedFindPipelineError = -15;
+
+// Order must match CompressionOptions::Method
+const complex::ChoicesParameter::Choices k_CompressionChoices = {"None", "Deflate", "Blosc"};
 } // namespace
 
 namespace complex
@@ -55,6 +59,8 @@ Parameters WriteDREAM3DFilter::parameters() const
   params.insert(std::make_unique<FileSystemPathParameter>(k_ExportFilePath, "Export File Path", "The file path the DataStructure should be written to as an HDF5 file.", "",
                                                           FileSystemPathParameter::ExtensionsType{".dream3d"}, FileSystemPathParameter::PathType::OutputFile));
   params.insert(std::make_unique<BoolParameter>(k_WriteXdmf, "Write Xdmf File", "Whether or not to write the data out an xdmf file", true));
+  params.insert(std::make_unique<ChoicesParameter>(k_CompressionType, "Compression",
+                                                   "The compression applied to the data arrays. Blosc falls back to Deflate if the HDF5 Blosc filter is unavailable.", 0, k_CompressionChoices));
   return params;
 }
 
@@ -81,6 +87,10 @@ Result<> WriteDREAM3DFilter::executeImpl(DataStructure& dataStructure, const Arg
 {
   auto exportFilePath = args.value<std::filesystem::path>(k_ExportFilePath);
   auto writeXdmf = args.value<bool>(k_WriteXdmf);
+  auto compressionType = args.value<ChoicesParameter::ValueType>(k_CompressionType);
+
+  HDF5::CompressionOptions compression;
+  compression.method = static_cast<HDF5::CompressionOptions::Method>(compressionType);
 
   Pipeline pipeline;
 
@@ -95,7 +105,7 @@ Result<> WriteDREAM3DFilter::executeImpl(DataStructure& dataStructure, const Arg
     pipeline = *pipelinePtr;
   }
 
-  auto results = DREAM3D::WriteFile(exportFilePath, dataStructure, pipeline, writeXdmf);
+  auto results = DREAM3D::WriteFile(exportFilePath, dataStructure, pipeline, writeXdmf, compression);
   return results;
 }
 } // namespace complex
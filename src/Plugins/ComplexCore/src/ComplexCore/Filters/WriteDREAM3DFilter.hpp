@@ -29,6 +29,7 @@ public:
   // Parameter Keys
   static inline constexpr StringLiteral k_ExportFilePath = "export_file_path";
   static inline constexpr StringLiteral k_WriteXdmf = "write_xdmf_file";
+  static inline constexpr StringLiteral k_CompressionType = "compression_type";
 
   /**
    * @brief Returns the name of the filter class.
@@ -32,6 +32,9 @@
 #include "complex/Common/Types.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
+#include "complex/Utilities/Parsing/Text/TextTokenizer.hpp"
+
+#include <string_view>
 
 using namespace complex;
 
@@ -60,7 +63,7 @@ public:
     return m_DataArray;
   }
 
-  virtual Result<> parse(const std::string& token, size_t index) = 0;
+  virtual Result<> parse(std::string_view token, size_t index) = 0;
 
 protected:
   AbstractDataParser(IDataArray& array, const std::string& columnName, usize columnIndex)
@@ -86,6 +89,7 @@ public:
   CSVDataParser(ArrayType& array, const std::string& name, usize index)
   : AbstractDataParser(array, name, index)
   , m_Array(array)
+  , m_Values(array.getDataStoreRef().getContiguousValues(0))
   {
   }
   ~CSVDataParser() override = default;
@@ -95,19 +99,28 @@ public:
   CSVDataParser& operator=(const CSVDataParser&) = delete; // Copy Assignment Not Implemented
   CSVDataParser& operator=(CSVDataParser&&) = delete;      // Move Assignment
 
-  Result<> parse(const std::string& token, size_t index) override
+  Result<> parse(std::string_view token, size_t index) override
   {
-    Result<T> parseResult = ConvertTo<T>::convert(token);
-    if(parseResult.valid())
+    T value = {};
+    if(TextTokenizer::FromChars(token, value) != std::errc{})
     {
-      m_Array[index] = parseResult.value();
+      return ConvertResult(TextTokenizer::Convert<T>(token));
     }
 
-    return ConvertResult(std::move(parseResult));
+    if(m_Values != nullptr)
+    {
+      m_Values[index] = value;
+    }
+    else
+    {
+      m_Array[index] = value;
+    }
+    return {};
   }
 
 private:
   ArrayType& m_Array;
+  T* m_Values = nullptr;
 };
 
 using Int8Parser = CSVDataParser<Int8Array, int8>;
@@ -100,13 +100,15 @@ public:
       if(numComponents > 1)
       {
         DataPath reducedArrayPath = GetUniquePathName(m_DataStructure, array->getDataPaths()[0]); // doesn't matter which path since we only use the target name
+        if(!allocate)
+        {
+          return Float64Array::Create(m_DataStructure, reducedArrayPath.getTargetName(), std::make_shared<Float64DataStore>(Float64DataStore(nullptr, array->getTupleShape(), {1})));
+        }
+
         Float64Array* newArray = Float64Array::CreateWithStore<Float64DataStore>(m_DataStructure, reducedArrayPath.getTargetName(), array->getTupleShape(), {1});
-        if(allocate)
+        for(int i = 0; i < array->getNumberOfTuples(); i++)
         {
-          for(int i = 0; i < array->getNumberOfTuples(); i++)
-          {
-            (*newArray)[i] = (*array)[i * numComponents + c];
-          }
+          (*newArray)[i] = (*array)[i * numComponents + c];
         }
 
         return newArray;
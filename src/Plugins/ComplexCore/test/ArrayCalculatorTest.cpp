@@ -13,6 +13,8 @@
 
 #include <catch2/catch.hpp>
 
+#include <limits>
+
 using namespace complex;
 
 namespace
@@ -808,6 +810,146 @@ void SingleComponentArrayCalculatorTest2()
   }
 }
 
+// -----------------------------------------------------------------------------
+IFilter::ExecuteResult executeArrayCalculatorFilter(const std::string& equation, const DataPath& selectedGroupPath, const DataPath& calculatedPath, NumericType scalarType,
+                                                    DataStructure& dataStructure)
+{
+  ArrayCalculatorFilter filter;
+  Arguments args;
+  args.insertOrAssign(ArrayCalculatorFilter::k_CalculatorParameter_Key,
+                      std::make_any<CalculatorParameter::ValueType>(CalculatorParameter::ValueType{selectedGroupPath, equation, CalculatorParameter::AngleUnits::Radians}));
+  args.insertOrAssign(ArrayCalculatorFilter::k_ScalarType_Key, std::make_any<NumericTypeParameter::ValueType>(scalarType));
+  args.insertOrAssign(ArrayCalculatorFilter::k_CalculatedArray_Key, std::make_any<DataPath>(calculatedPath));
+
+  return filter.execute(dataStructure, args);
+}
+
+// -----------------------------------------------------------------------------
+void OutputTypeArrayCalculatorTest()
+{
+  SECTION("Integer Output From Integer Arrays")
+  {
+    DataStructure dataStructure = ::createDataStructure();
+    IFilter::ExecuteResult results = executeArrayCalculatorFilter("InputArray2 * 3 - MultiComponent Array1[1]", k_AttributeMatrixPath, k_AttributeArrayPath, NumericType::uint32, dataStructure);
+    COMPLEX_RESULT_REQUIRE_VALID(results.result);
+
+    UInt32Array* inputArray2 = dataStructure.getDataAs<UInt32Array>(k_InputArray2Path);
+    UInt32Array* mcArray1 = dataStructure.getDataAs<UInt32Array>(k_MultiComponentArray1Path);
+    UInt32Array* arrayPtr = dataStructure.getDataAs<UInt32Array>(k_AttributeArrayPath);
+    REQUIRE(arrayPtr != nullptr);
+    REQUIRE(arrayPtr->getNumberOfTuples() == inputArray2->getNumberOfTuples());
+    for(usize i = 0; i < arrayPtr->getNumberOfTuples(); i++)
+    {
+      REQUIRE(arrayPtr->at(i) == inputArray2->at(i) * 3 - mcArray1->at(i * 3 + 1));
+    }
+  }
+
+  SECTION("Integer Output From Mixed Arrays")
+  {
+    DataStructure dataStructure = ::createDataStructure();
+    IFilter::ExecuteResult results = executeArrayCalculatorFilter("InputArray1 * 2.5 + InputArray2", k_AttributeMatrixPath, k_AttributeArrayPath, NumericType::int32, dataStructure);
+    COMPLEX_RESULT_REQUIRE_VALID(results.result);
+
+    Int32Array* arrayPtr = dataStructure.getDataAs<Int32Array>(k_AttributeArrayPath);
+    REQUIRE(arrayPtr != nullptr);
+    for(usize i = 0; i < arrayPtr->getNumberOfTuples(); i++)
+    {
+      REQUIRE(arrayPtr->at(i) == -20);
+    }
+  }
+
+  SECTION("Multiple Blocks")
+  {
+    const usize numTuples = 5000;
+    DataStructure dataStructure;
+    AttributeMatrix* attributeMatrix = AttributeMatrix::Create(dataStructure, k_AttributeMatrix, {numTuples});
+    Float32Array* inputArray = Float32Array::CreateWithStore<Float32DataStore>(dataStructure, k_InputArray1, {numTuples}, {1}, attributeMatrix->getId());
+    for(usize i = 0; i < numTuples; i++)
+    {
+      (*inputArray)[i] = static_cast<float32>(i) * 0.5f;
+    }
+
+    IFilter::ExecuteResult results = executeArrayCalculatorFilter("sin(InputArray1) * 2 + InputArray1 ^ 2", k_AttributeMatrixPath, k_AttributeArrayPath, NumericType::float64, dataStructure);
+    COMPLEX_RESULT_REQUIRE_VALID(results.result);
+
+    Float64Array* arrayPtr = dataStructure.getDataAs<Float64Array>(k_AttributeArrayPath);
+    REQUIRE(arrayPtr != nullptr);
+    REQUIRE(arrayPtr->getNumberOfTuples() == numTuples);
+    for(usize i = 0; i < numTuples; i++)
+    {
+      const float64 value = static_cast<float64>(inputArray->at(i));
+      REQUIRE(UnitTest::CloseEnough<float64>(arrayPtr->at(i), std::sin(value) * 2 + std::pow(value, 2), 0.0001));
+    }
+  }
+
+  SECTION("Integer Output From Narrower Integer Arrays")
+  {
+    DataStructure dataStructure;
+    AttributeMatrix* attributeMatrix = AttributeMatrix::Create(dataStructure, k_AttributeMatrix, {10});
+    UInt8Array* inputArray1 = UInt8Array::CreateWithStore<UInt8DataStore>(dataStructure, k_InputArray1, {10}, {1}, attributeMatrix->getId());
+    inputArray1->fill(10);
+    UInt8Array* inputArray2 = UInt8Array::CreateWithStore<UInt8DataStore>(dataStructure, k_InputArray2, {10}, {1}, attributeMatrix->getId());
+    inputArray2->fill(250);
+
+    IFilter::ExecuteResult results = executeArrayCalculatorFilter("InputArray1 - InputArray2 * 2", k_AttributeMatrixPath, k_AttributeArrayPath, NumericType::int16, dataStructure);
+    COMPLEX_RESULT_REQUIRE_VALID(results.result);
+
+    Int16Array* arrayPtr = dataStructure.getDataAs<Int16Array>(k_AttributeArrayPath);
+    REQUIRE(arrayPtr != nullptr);
+    for(usize i = 0; i < arrayPtr->getNumberOfTuples(); i++)
+    {
+      REQUIRE(arrayPtr->at(i) == -490);
+    }
+  }
+
+  SECTION("Integer Output Beyond Exact Double Range")
+  {
+    // The product needs 62 bits, so it is rounded exactly like the double computation rather than evaluated in int64
+    DataStructure dataStructure;
+    AttributeMatrix* attributeMatrix = AttributeMatrix::Create(dataStructure, k_AttributeMatrix, {10});
+    Int32Array* inputArray1 = Int32Array::CreateWithStore<Int32DataStore>(dataStructure, k_InputArray1, {10}, {1}, attributeMatrix->getId());
+    inputArray1->fill(std::numeric_limits<int32>::max());
+    Int32Array* inputArray2 = Int32Array::CreateWithStore<Int32DataStore>(dataStructure, k_InputArray2, {10}, {1}, attributeMatrix->getId());
+    inputArray2->fill(std::numeric_limits<int32>::max() - 2);
+
+    IFilter::ExecuteResult results = executeArrayCalculatorFilter("InputArray1 * InputArray2", k_AttributeMatrixPath, k_AttributeArrayPath, NumericType::int64, dataStructure);
+    COMPLEX_RESULT_REQUIRE_VALID(results.result);
+
+    const auto expectedValue = static_cast<int64>(static_cast<float64>(std::numeric_limits<int32>::max()) * static_cast<float64>(std::numeric_limits<int32>::max() - 2));
+    REQUIRE(expectedValue != static_cast<int64>(std::numeric_limits<int32>::max()) * static_cast<int64>(std::numeric_limits<int32>::max() - 2));
+    Int64Array* arrayPtr = dataStructure.getDataAs<Int64Array>(k_AttributeArrayPath);
+    REQUIRE(arrayPtr != nullptr);
+    for(usize i = 0; i < arrayPtr->getNumberOfTuples(); i++)
+    {
+      REQUIRE(arrayPtr->at(i) == expectedValue);
+    }
+  }
+
+  SECTION("Float Output From Float Arrays")
+  {
+    const usize numTuples = 5000;
+    DataStructure dataStructure;
+    AttributeMatrix* attributeMatrix = AttributeMatrix::Create(dataStructure, k_AttributeMatrix, {numTuples});
+    Float32Array* inputArray = Float32Array::CreateWithStore<Float32DataStore>(dataStructure, k_InputArray1, {numTuples}, {1}, attributeMatrix->getId());
+    for(usize i = 0; i < numTuples; i++)
+    {
+      (*inputArray)[i] = static_cast<float32>(i) * 0.001f;
+    }
+
+    IFilter::ExecuteResult results = executeArrayCalculatorFilter("sin(InputArray1) * 2 + InputArray1 ^ 2 / 3", k_AttributeMatrixPath, k_AttributeArrayPath, NumericType::float32, dataStructure);
+    COMPLEX_RESULT_REQUIRE_VALID(results.result);
+
+    Float32Array* arrayPtr = dataStructure.getDataAs<Float32Array>(k_AttributeArrayPath);
+    REQUIRE(arrayPtr != nullptr);
+    REQUIRE(arrayPtr->getNumberOfTuples() == numTuples);
+    for(usize i = 0; i < numTuples; i++)
+    {
+      const float64 value = static_cast<float64>(inputArray->at(i));
+      REQUIRE(UnitTest::CloseEnough<float64>(arrayPtr->at(i), std::sin(value) * 2 + std::pow(value, 2) / 3, 0.0001));
+    }
+  }
+}
+
 TEST_CASE("ComplexCore::ArrayCalculatorFilter: Filter Execution")
 {
   std::cout << "#### ArrayCalculatorTest Starting ####" << std::endl;
@@ -815,4 +957,5 @@ TEST_CASE("ComplexCore::ArrayCalculatorFilter: Filter Execution")
   SingleComponentArrayCalculatorTest1();
   SingleComponentArrayCalculatorTest2();
   MultiComponentArrayCalculatorTest();
+  OutputTypeArrayCalculatorTest();
 }
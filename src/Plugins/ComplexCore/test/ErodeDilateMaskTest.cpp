@@ -1,6 +1,7 @@
 #include <catch2/catch.hpp>
 
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
+#include "ComplexCore/Filters/Algorithms/ErodeDilateMask.hpp"
 #include "ComplexCore/Filters/ErodeDilateMaskFilter.hpp"
 
 #include "complex/Parameters/ArraySelectionParameter.hpp"
@@ -9,6 +10,7 @@
 #include "complex/UnitTest/UnitTestCommon.hpp"
 
 #include <filesystem>
+#include <random>
 
 namespace fs = std::filesystem;
 using namespace complex;
@@ -26,6 +28,53 @@ const DataPath k_InputData({"Input Data"});
 const DataPath k_EbsdScanDataDataPath = k_InputData.createChildPath(k_EbsdScanDataName);
 const DataPath k_MaskArrayDataPath = k_EbsdScanDataDataPath.createChildPath("Mask");
 
+/**
+ * @brief Runs ErodeDilateMask on a checkerboard of blocks with a few random voxels flipped, processing
+ * slabDepth Z layers at a time, and returns the result.
+ */
+std::vector<bool> RunOnRandomMask(ChoicesParameter::ValueType operation, int32 numIterations, usize slabDepth)
+{
+  const SizeVec3 dims = {17, 13, 23};
+  DataStructure dataStructure;
+  auto* imageGeom = ImageGeom::Create(dataStructure, k_InputData.getTargetName());
+  imageGeom->setDimensions(dims);
+  auto* cellData = AttributeMatrix::Create(dataStructure, k_EbsdScanDataName, {dims[2], dims[1], dims[0]}, imageGeom->getId());
+  imageGeom->setCellData(*cellData);
+  auto* mask = UnitTest::CreateTestDataArray<bool>(dataStructure, "Mask", {dims[2], dims[1], dims[0]}, {1}, cellData->getId());
+
+  std::mt19937_64 generator(std::mt19937_64::default_seed);
+  std::bernoulli_distribution flipDistribution(0.05);
+  usize index = 0;
+  for(usize z = 0; z < dims[2]; z++)
+  {
+    for(usize y = 0; y < dims[1]; y++)
+    {
+      for(usize x = 0; x < dims[0]; x++)
+      {
+        (*mask)[index] = ((x / 6 + y / 5 + z / 7) % 2 == 0) != flipDistribution(generator);
+        index++;
+      }
+    }
+  }
+
+  ErodeDilateMaskInputValues inputValues;
+  inputValues.Operation = operation;
+  inputValues.NumIterations = numIterations;
+  inputValues.XDirOn = true;
+  inputValues.YDirOn = true;
+  inputValues.ZDirOn = true;
+  inputValues.MaskArrayPath = k_MaskArrayDataPath;
+  inputValues.InputImageGeometry = k_InputData;
+  inputValues.HaloWidth = static_cast<usize>(numIterations);
+  inputValues.SlabDepth = slabDepth;
+
+  const std::atomic_bool shouldCancel = false;
+  const IFilter::MessageHandler messageHandler{};
+  auto result = ErodeDilateMask(dataStructure, messageHandler, shouldCancel, &inputValues)();
+  COMPLEX_RESULT_REQUIRE_VALID(result)
+
+  return {mask->begin(), mask->end()};
+}
 } // namespace
 
 TEST_CASE("ComplexCore::ErodeDilateMaskFilter(Dilate)", "[ComplexCore][ErodeDilateMaskFilter]")
@@ -106,3 +155,16 @@ TEST_CASE("ComplexCore::ErodeDilateMaskFilter(Erode)", "[ComplexCore][ErodeDilat
 
   UnitTest::CompareExemplarToGeneratedData(dataStructure, dataStructure, k_EbsdScanDataDataPath, k_ExemplarDataContainerName);
 }
+
+TEST_CASE("ComplexCore::ErodeDilateMaskFilter: Slabs Match Whole Volume", "[ComplexCore][ErodeDilateMaskFilter]")
+{
+  const ChoicesParameter::ValueType operation = GENERATE(k_Dilate, k_Erode);
+  const int32 numIterations = GENERATE(2, 3);
+
+  // A slab depth of 0 processes the whole volume as one slab, the halo sets the smallest depth of the other slabs
+  const std::vector<bool> wholeVolume = RunOnRandomMask(operation, numIterations, 0);
+  const std::vector<bool> slabs = RunOnRandomMask(operation, numIterations, 1);
+  REQUIRE(std::find(wholeVolume.begin(), wholeVolume.end(), true) != wholeVolume.end());
+  REQUIRE(std::find(wholeVolume.begin(), wholeVolume.end(), false) != wholeVolume.end());
+  REQUIRE(slabs == wholeVolume);
+}
@@ -503,3 +503,149 @@ TEST_CASE("ComplexCore::FindArrayStatisticsFilter: Test Algorithm By Index", "[C
     REQUIRE(std::fabs(modalBinRange2[3] - 22.0f) < UnitTest::EPSILON);
   }
 }
+
+TEMPLATE_TEST_CASE("ComplexCore::FindArrayStatisticsFilter: Test Algorithm By Index - Empty Features", "[ComplexCore][FindArrayStatisticsFilter]", int16, float32)
+{
+  // int16 values are counted with a histogram of the value range while float32 values are sorted
+  using T = TestType;
+  // Modes can only be found for integer types
+  constexpr bool findMode = std::is_integral_v<T>;
+
+  Application::GetOrCreateInstance()->loadPlugins(unit_test::k_BuildDir.view(), true);
+
+  DataStructure dataStructure;
+  DataGroup* topLevelGroup = DataGroup::Create(dataStructure, "TestData");
+  const DataPath statsDataPath({"TestData", "Statistics"});
+  const DataPath inputArrayPath({"TestData", "InputArray"});
+
+  // Feature 2 has no tuples and every tuple of feature 3 is masked out. All values of feature 4 are negative.
+  const std::vector<T> values = {-3, 7, 7, 100, -5, -9, -5, -1, 50, 2, 99, 0};
+  const std::vector<bool> mask = {true, true, true, false, true, true, true, true, false, true, false, true};
+  const std::vector<int32> featureIds = {1, 1, 1, 1, 4, 4, 4, 4, 3, 0, 0, 1};
+
+  auto* inputArray = DataArray<T>::template CreateWithStore<DataStore<T>>(dataStructure, "InputArray", {values.size()}, {1}, topLevelGroup->getId());
+  auto* maskArray = BoolArray::CreateWithStore<DataStore<bool>>(dataStructure, "Mask", {values.size()}, {1}, topLevelGroup->getId());
+  auto* featureIdsArray = Int32Array::CreateWithStore<DataStore<int32>>(dataStructure, "FeatureIds", {values.size()}, {1}, topLevelGroup->getId());
+  for(usize i = 0; i < values.size(); i++)
+  {
+    (*inputArray)[i] = values[i];
+    (*maskArray)[i] = mask[i];
+    (*featureIdsArray)[i] = featureIds[i];
+  }
+
+  const std::string featureHasData = "FeatureHasData";
+  const std::string length = "Length";
+  const std::string min = "Minimum";
+  const std::string max = "Maximum";
+  const std::string mean = "Mean";
+  const std::string median = "Median";
+  const std::string mode = "Mode";
+  const std::string std = "Standard Deviation";
+  const std::string sum = "Summation";
+  const std::string numUniqueValues = "NumUniqueValues";
+
+  // Execute the Find Array Statistics Filter
+  {
+    FindArrayStatisticsFilter filter;
+    Arguments args;
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FindHistogram_Key, std::make_any<bool>(false));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FindLength_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FindMin_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FindMax_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FindMean_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FindMedian_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FindMode_Key, std::make_any<bool>(findMode));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FindStdDeviation_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FindSummation_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FindUniqueValues_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_UseMask_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_ComputeByIndex_Key, std::make_any<bool>(true));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_StandardizeData_Key, std::make_any<bool>(false));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_SelectedArrayPath_Key, std::make_any<DataPath>(inputArrayPath));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_CellFeatureIdsArrayPath_Key, std::make_any<DataPath>(DataPath({"TestData", "FeatureIds"})));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_MaskArrayPath_Key, std::make_any<DataPath>(DataPath({"TestData", "Mask"})));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_DestinationAttributeMatrix_Key, std::make_any<DataPath>(statsDataPath));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_FeatureHasDataArrayName_Key, std::make_any<std::string>(featureHasData));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_LengthArrayName_Key, std::make_any<std::string>(length));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_MinimumArrayName_Key, std::make_any<std::string>(min));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_MaximumArrayName_Key, std::make_any<std::string>(max));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_MeanArrayName_Key, std::make_any<std::string>(mean));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_MedianArrayName_Key, std::make_any<std::string>(median));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_ModeArrayName_Key, std::make_any<std::string>(mode));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_StdDeviationArrayName_Key, std::make_any<std::string>(std));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_SummationArrayName_Key, std::make_any<std::string>(sum));
+    args.insertOrAssign(FindArrayStatisticsFilter::k_NumUniqueValues_Key, std::make_any<std::string>(numUniqueValues));
+
+    // Preflight the filter and check result
+    auto preflightResult = filter.preflight(dataStructure, args);
+    COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+
+    // Execute the filter and check the result
+    auto executeResult = filter.execute(dataStructure, args);
+    COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+  }
+
+  // Check resulting values
+  {
+    const auto& featureHasDataArray = dataStructure.getDataRefAs<BoolArray>(statsDataPath.createChildPath(featureHasData));
+    const auto& lengthArray = dataStructure.getDataRefAs<UInt64Array>(statsDataPath.createChildPath(length));
+    const auto& minArray = dataStructure.getDataRefAs<DataArray<T>>(statsDataPath.createChildPath(min));
+    const auto& maxArray = dataStructure.getDataRefAs<DataArray<T>>(statsDataPath.createChildPath(max));
+    const auto& meanArray = dataStructure.getDataRefAs<Float32Array>(statsDataPath.createChildPath(mean));
+    const auto& medianArray = dataStructure.getDataRefAs<Float32Array>(statsDataPath.createChildPath(median));
+    const auto& stdArray = dataStructure.getDataRefAs<Float32Array>(statsDataPath.createChildPath(std));
+    const auto& sumArray = dataStructure.getDataRefAs<Float32Array>(statsDataPath.createChildPath(sum));
+    const auto& numUniqueValuesArray = dataStructure.getDataRefAs<Int32Array>(statsDataPath.createChildPath(numUniqueValues));
+    REQUIRE(lengthArray.getNumberOfTuples() == 5);
+
+    // Features without any unmasked tuples
+    for(usize featureId : {2, 3})
+    {
+      REQUIRE(featureHasDataArray[featureId] == false);
+      REQUIRE(lengthArray[featureId] == 0);
+      REQUIRE(meanArray[featureId] == 0.0f);
+      REQUIRE(medianArray[featureId] == 0.0f);
+      REQUIRE(sumArray[featureId] == 0.0f);
+      REQUIRE(numUniqueValuesArray[featureId] == 0);
+    }
+
+    REQUIRE(featureHasDataArray[0] == true);
+    REQUIRE(lengthArray[0] == 1);
+    REQUIRE(minArray[0] == static_cast<T>(2));
+    REQUIRE(maxArray[0] == static_cast<T>(2));
+    REQUIRE(std::fabs(meanArray[0] - 2.0f) < UnitTest::EPSILON);
+    REQUIRE(std::fabs(medianArray[0] - 2.0f) < UnitTest::EPSILON);
+    REQUIRE(std::fabs(stdArray[0] - 0.0f) < UnitTest::EPSILON);
+    REQUIRE(numUniqueValuesArray[0] == 1);
+
+    REQUIRE(featureHasDataArray[1] == true);
+    REQUIRE(lengthArray[1] == 4);
+    REQUIRE(minArray[1] == static_cast<T>(-3));
+    REQUIRE(maxArray[1] == static_cast<T>(7));
+    REQUIRE(std::fabs(meanArray[1] - 2.75f) < UnitTest::EPSILON);
+    REQUIRE(std::fabs(medianArray[1] - 3.5f) < UnitTest::EPSILON);
+    REQUIRE(std::fabs(stdArray[1] - 4.380354f) < UnitTest::EPSILON);
+    REQUIRE(std::fabs(sumArray[1] - 11.0f) < UnitTest::EPSILON);
+    REQUIRE(numUniqueValuesArray[1] == 3);
+
+    REQUIRE(featureHasDataArray[4] == true);
+    REQUIRE(lengthArray[4] == 4);
+    REQUIRE(minArray[4] == static_cast<T>(-9));
+    REQUIRE(maxArray[4] == static_cast<T>(-1));
+    REQUIRE(std::fabs(meanArray[4] - -5.0f) < UnitTest::EPSILON);
+    REQUIRE(std::fabs(medianArray[4] - -5.0f) < UnitTest::EPSILON);
+    REQUIRE(std::fabs(stdArray[4] - 2.828427f) < UnitTest::EPSILON);
+    REQUIRE(std::fabs(sumArray[4] - -20.0f) < UnitTest::EPSILON);
+    REQUIRE(numUniqueValuesArray[4] == 3);
+
+    if constexpr(findMode)
+    {
+      const auto& modeArray = dataStructure.getDataRefAs<NeighborList<T>>(statsDataPath.createChildPath(mode));
+      REQUIRE(modeArray.getListReference(0) == std::vector<T>{2});
+      REQUIRE(modeArray.getListReference(1) == std::vector<T>{7});
+      REQUIRE(modeArray.getListReference(2).empty());
+      REQUIRE(modeArray.getListReference(3).empty());
+      REQUIRE(modeArray.getListReference(4) == std::vector<T>{-5});
+    }
+  }
+}
@@ -1,12 +1,15 @@
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
 #include "ComplexCore/Filters/IterativeClosestPointFilter.hpp"
 
+#include "complex/Parameters/ChoicesParameter.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
 
 #include <catch2/catch.hpp>
 
+#include <array>
 #include <limits>
 #include <string>
+#include <tuple>
 
 namespace fs = std::filesystem;
 using namespace complex;
@@ -69,3 +72,105 @@ TEST_CASE("ComplexCore::IterativeClosestPointFilter: Test Algorithm", "[DREAM3DR
   auto executeResult = filter.execute(dataStructure, args);
   REQUIRE(executeResult.result.valid());
 }
+
+namespace
+{
+/**
+ * @brief Creates a vertex geometry with points on the surface of the cube [0, 4]^3 spaced 0.5 apart,
+ * offset by the given translation, together with the outward normals of the points.
+ */
+VertexGeom* CreateCubeSurface(DataStructure& dataStructure, const std::string& name, const std::array<float32, 3>& offset)
+{
+  std::vector<float32> coords;
+  std::vector<float32> normals;
+  for(usize axis = 0; axis < 3; axis++)
+  {
+    for(float32 side : {0.0f, 4.0f})
+    {
+      for(usize j = 0; j <= 8; j++)
+      {
+        for(usize i = 0; i <= 8; i++)
+        {
+          std::array<float32, 3> point = {0.0f, 0.0f, 0.0f};
+          point[axis] = side;
+          point[(axis + 1) % 3] = 0.5f * i;
+          point[(axis + 2) % 3] = 0.5f * j;
+          std::array<float32, 3> normal = {0.0f, 0.0f, 0.0f};
+          normal[axis] = side > 0.0f ? 1.0f : -1.0f;
+          for(usize k = 0; k < 3; k++)
+          {
+            coords.push_back(point[k] + offset[k]);
+            normals.push_back(normal[k]);
+          }
+        }
+      }
+    }
+  }
+
+  auto* geom = VertexGeom::Create(dataStructure, name);
+  auto* vertices = Float32Array::CreateWithStore<DataStore<float32>>(dataStructure, "Vertices", {coords.size() / 3}, {3}, geom->getId());
+  std::copy(coords.begin(), coords.end(), vertices->getDataStoreRef().begin());
+  geom->setVertices(*vertices);
+  auto* normalsArray = Float32Array::CreateWithStore<DataStore<float32>>(dataStructure, "Normals", {normals.size() / 3}, {3}, geom->getId());
+  std::copy(normals.begin(), normals.end(), normalsArray->getDataStoreRef().begin());
+  return geom;
+}
+} // namespace
+
+TEST_CASE("ComplexCore::IterativeClosestPointFilter: Recover Translation", "[DREAM3DReview][IterativeClosestPointFilter]")
+{
+  const std::array<float32, 3> offset = {0.1f, -0.15f, 0.05f};
+
+  auto [usePointToPlane, samplingMethod] = GENERATE(std::make_tuple(false, IterativeClosestPointFilter::k_NoSampling), std::make_tuple(false, IterativeClosestPointFilter::k_RandomSampling),
+                                                    std::make_tuple(true, IterativeClosestPointFilter::k_NoSampling), std::make_tuple(true, IterativeClosestPointFilter::k_VoxelGridSampling));
+
+  IterativeClosestPointFilter filter;
+  DataStructure dataStructure;
+  CreateCubeSurface(dataStructure, "Moving", offset);
+  CreateCubeSurface(dataStructure, "Target", {0.0f, 0.0f, 0.0f});
+  const DataPath transformArrayPath({"Transform"});
+
+  Arguments args;
+  args.insertOrAssign(IterativeClosestPointFilter::k_MovingVertexPath_Key, std::make_any<DataPath>(DataPath({"Moving"})));
+  args.insertOrAssign(IterativeClosestPointFilter::k_TargetVertexPath_Key, std::make_any<DataPath>(DataPath({"Target"})));
+  args.insertOrAssign(IterativeClosestPointFilter::k_NumIterations_Key, std::make_any<uint64>(50));
+  args.insertOrAssign(IterativeClosestPointFilter::k_ConvergenceTolerance_Key, std::make_any<float32>(1.0e-6f));
+  args.insertOrAssign(IterativeClosestPointFilter::k_ApplyTransformation_Key, std::make_any<bool>(true));
+  args.insertOrAssign(IterativeClosestPointFilter::k_UsePointToPlane_Key, std::make_any<bool>(usePointToPlane));
+  args.insertOrAssign(IterativeClosestPointFilter::k_TargetNormalsArrayPath_Key, std::make_any<DataPath>(DataPath({"Target", "Normals"})));
+  args.insertOrAssign(IterativeClosestPointFilter::k_SamplingMethod_Key, std::make_any<ChoicesParameter::ValueType>(samplingMethod));
+  args.insertOrAssign(IterativeClosestPointFilter::k_SampleFraction_Key, std::make_any<float32>(0.5f));
+  args.insertOrAssign(IterativeClosestPointFilter::k_VoxelSize_Key, std::make_any<float32>(0.9f));
+  args.insertOrAssign(IterativeClosestPointFilter::k_UseSeed_Key, std::make_any<bool>(true));
+  args.insertOrAssign(IterativeClosestPointFilter::k_SeedValue_Key, std::make_any<uint64>(5489));
+  args.insertOrAssign(IterativeClosestPointFilter::k_SeedArrayName_Key, std::make_any<std::string>("IterativeClosestPoint SeedValue"));
+  args.insertOrAssign(IterativeClosestPointFilter::k_TransformArrayPath_Key, std::make_any<DataPath>(transformArrayPath));
+
+  auto preflightResult = filter.preflight(dataStructure, args);
+  REQUIRE(preflightResult.outputActions.valid());
+  auto executeResult = filter.execute(dataStructure, args);
+  REQUIRE(executeResult.result.valid());
+
+  REQUIRE(dataStructure.getDataRefAs<UInt64Array>(DataPath({"IterativeClosestPoint SeedValue"}))[0] == 5489);
+
+  // The transform is stored in row-major order, the translation is in the last column
+  const auto& transform = dataStructure.getDataRefAs<Float32Array>(transformArrayPath);
+  for(usize k = 0; k < 3; k++)
+  {
+    REQUIRE(std::abs(transform[4 * k + 3] + offset[k]) < 1.0e-3f);
+    REQUIRE(std::abs(transform[4 * k + k] - 1.0f) < 1.0e-3f);
+  }
+
+  // The moving vertices now coincide with the target vertices
+  const auto& movingVertices = dataStructure.getDataRefAs<Float32Array>(DataPath({"Moving", "Vertices"}));
+  const auto& targetVertices = dataStructure.getDataRefAs<Float32Array>(DataPath({"Target", "Vertices"}));
+  for(usize i = 0; i < movingVertices.getSize(); i++)
+  {
+    REQUIRE(std::abs(movingVertices[i] - targetVertices[i]) < 1.0e-3f);
+  }
+
+  // Point to plane needs one normal per target vertex
+  args.insertOrAssign(IterativeClosestPointFilter::k_UsePointToPlane_Key, std::make_any<bool>(true));
+  args.insertOrAssign(IterativeClosestPointFilter::k_TargetNormalsArrayPath_Key, std::make_any<DataPath>(transformArrayPath));
+  REQUIRE(filter.preflight(dataStructure, args).outputActions.invalid());
+}
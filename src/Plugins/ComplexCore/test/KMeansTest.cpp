@@ -1,12 +1,17 @@
 #include <catch2/catch.hpp>
 
+#include "complex/DataStructure/AttributeMatrix.hpp"
 #include "complex/DataStructure/DataArray.hpp"
+#include "complex/Parameters/ChoicesParameter.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
+#include "complex/Utilities/KUtilities.hpp"
 
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
 #include "ComplexCore/Filters/KMeansFilter.hpp"
 
 #include <filesystem>
+#include <random>
+#include <set>
 namespace fs = std::filesystem;
 
 using namespace complex;
@@ -30,6 +35,94 @@ const std::string k_ClusterIdsNameNX = k_ClusterIdsName + "NX";
 const std::string k_MeansNameNX = k_MeansName + "NX";
 
 const DataPath k_ClusterIdsPathNX = k_CellPath.createChildPath(k_ClusterIdsNameNX);
+
+const std::string k_GeneratedData = "Generated Data";
+const std::string k_GeneratedValues = "Values";
+const DataPath k_GeneratedValuesPath = DataPath({k_GeneratedData, k_GeneratedValues});
+const DataPath k_GeneratedClusterIdsPath = DataPath({k_GeneratedData, k_ClusterIdsName});
+const DataPath k_GeneratedClusterDataPath = DataPath({k_ClusterData});
+
+/**
+ * @brief Creates numClusters * pointsPerCluster points of 3 components around random centers.
+ * The points of the clusters are interleaved. The spread is given relative to the distance
+ * between the centers, so small spreads give well separated clusters.
+ */
+std::vector<float64> CreateClusteredValues(usize numClusters, usize pointsPerCluster, float64 spread, std::mt19937_64& generator)
+{
+  constexpr usize k_NumComps = 3;
+  std::uniform_real_distribution<float64> centerDistribution(-100.0, 100.0);
+  std::normal_distribution<float64> pointDistribution(0.0, spread);
+  std::vector<float64> centers(numClusters * k_NumComps);
+  for(float64& value : centers)
+  {
+    value = centerDistribution(generator);
+  }
+
+  std::vector<float64> values(numClusters * pointsPerCluster * k_NumComps);
+  for(usize i = 0; i < numClusters * pointsPerCluster; i++)
+  {
+    const usize cluster = i % numClusters;
+    for(usize j = 0; j < k_NumComps; j++)
+    {
+      values[i * k_NumComps + j] = centers[cluster * k_NumComps + j] + pointDistribution(generator);
+    }
+  }
+  return values;
+}
+
+/**
+ * @brief Plain Lloyd iterations without any bounds, started from the same k-means++ seeds
+ * the filter chooses for the seed value.
+ */
+template <KUtilities::DistanceMetric Metric>
+std::vector<int32> RunLloyd(const std::vector<float64>& values, usize numCompDims, usize numClusters, uint64 seed)
+{
+  const usize numTuples = values.size() / numCompDims;
+  const std::vector<uint8> mask(numTuples, 1);
+  std::mt19937_64 generator(seed);
+  const std::vector<usize> seeds =
+      KUtilities::SelectKMeansPlusPlusSeeds<Metric>(values.data(), reinterpret_cast<const bool*>(mask.data()), numTuples, numCompDims, numClusters, generator);
+  REQUIRE(seeds.size() == numClusters);
+
+  std::vector<float64> means(numCompDims * (numClusters + 1), 0.0);
+  for(usize i = 0; i < numClusters; i++)
+  {
+    std::copy_n(values.begin() + numCompDims * seeds[i], numCompDims, means.begin() + numCompDims * (i + 1));
+  }
+
+  std::vector<int32> featureIds(numTuples, 0);
+  bool changed = true;
+  while(changed)
+  {
+    changed = false;
+    std::vector<float64> sums(means.size(), 0.0);
+    std::vector<usize> counts(numClusters + 1, 0);
+    for(usize i = 0; i < numTuples; i++)
+    {
+      float64 minDist = 0.0;
+      float64 secondDist = 0.0;
+      const int32 closest = KUtilities::FindClosestCenter<Metric>(values.data() + numCompDims * i, means.data(), numClusters, numCompDims, minDist, secondDist);
+      if(closest != featureIds[i])
+      {
+        changed = true;
+        featureIds[i] = closest;
+      }
+      counts[closest]++;
+      for(usize j = 0; j < numCompDims; j++)
+      {
+        sums[numCompDims * closest + j] += values[numCompDims * i + j];
+      }
+    }
+    for(usize i = 0; i <= numClusters; i++)
+    {
+      for(usize j = 0; j < numCompDims; j++)
+      {
+        means[numCompDims * i + j] = counts[i] == 0 ? 0.0 : sums[numCompDims * i + j] / static_cast<float64>(counts[i]);
+      }
+    }
+  }
+  return featureIds;
+}
 } // namespace
 
 TEST_CASE("ComplexCore::KMeans: Valid Filter Execution", "[ComplexCore][KMeans]")
@@ -121,3 +214,100 @@ TEST_CASE("ComplexCore::KMeans: Valid Filter Execution", "[ComplexCore][KMeans]"
   WriteTestDataStructure(dataStructure, fs::path(fmt::format("{}/7_0_k_means_0_test.dream3d", unit_test::k_BinaryTestOutputDir)));
 #endif
 }
+
+TEST_CASE("ComplexCore::KMeans: K-Means++ Seeds", "[ComplexCore][KMeans]")
+{
+  constexpr usize k_NumClusters = 5;
+  constexpr usize k_PointsPerCluster = 200;
+  constexpr usize k_NumComps = 3;
+  std::mt19937_64 dataGenerator(1234u);
+  const std::vector<float64> values = CreateClusteredValues(k_NumClusters + 1, k_PointsPerCluster, 0.5, dataGenerator);
+  const usize numTuples = values.size() / k_NumComps;
+
+  // The last cluster and every third tuple of the other clusters are masked out. The last
+  // cluster would always be chosen when the mask is ignored because it is a cluster of its own.
+  std::vector<uint8> maskValues(numTuples, 1);
+  for(usize i = 0; i < numTuples; i++)
+  {
+    maskValues[i] = (i % (k_NumClusters + 1) != k_NumClusters && (i / (k_NumClusters + 1)) % 3 != 0) ? 1 : 0;
+  }
+  const bool* mask = reinterpret_cast<const bool*>(maskValues.data());
+
+  auto checkSeeds = [&](const std::vector<usize>& seeds) {
+    REQUIRE(seeds.size() == k_NumClusters);
+    std::set<usize> seededClusters;
+    for(usize seed : seeds)
+    {
+      REQUIRE(seed < numTuples);
+      REQUIRE(mask[seed]);
+      seededClusters.insert(seed % (k_NumClusters + 1));
+    }
+    // Well separated clusters each receive exactly one seed
+    REQUIRE(seededClusters.size() == k_NumClusters);
+  };
+
+  for(uint64 seedValue : {5489ULL, 42ULL, 987654321ULL})
+  {
+    INFO(fmt::format("Seed = {}", seedValue));
+
+    std::mt19937_64 generator(seedValue);
+    const std::vector<usize> euclideanSeeds = KUtilities::SelectKMeansPlusPlusSeeds<KUtilities::Euclidean>(values.data(), mask, numTuples, k_NumComps, k_NumClusters, generator);
+    checkSeeds(euclideanSeeds);
+
+    // The same generator state selects the same seeds
+    std::mt19937_64 repeatGenerator(seedValue);
+    REQUIRE(KUtilities::SelectKMeansPlusPlusSeeds<KUtilities::Euclidean>(values.data(), mask, numTuples, k_NumComps, k_NumClusters, repeatGenerator) == euclideanSeeds);
+
+    std::mt19937_64 squaredGenerator(seedValue);
+    checkSeeds(KUtilities::SelectKMeansPlusPlusSeeds<KUtilities::SquaredEuclidean>(values.data(), mask, numTuples, k_NumComps, k_NumClusters, squaredGenerator));
+  }
+}
+
+TEST_CASE("ComplexCore::KMeans: Bounded Iterations Match Lloyd", "[ComplexCore][KMeans]")
+{
+  constexpr usize k_NumClusters = 4;
+  constexpr usize k_NumComps = 3;
+  constexpr uint64 k_SeedValue = 5489;
+  const auto metric = GENERATE(KUtilities::Euclidean, KUtilities::SquaredEuclidean);
+  INFO(fmt::format("Distance Metric = {}", static_cast<int32>(metric)));
+
+  // Overlapping clusters need several iterations in which tuples change cluster
+  std::mt19937_64 dataGenerator(4321u);
+  const std::vector<float64> values = CreateClusteredValues(k_NumClusters, 750, 40.0, dataGenerator);
+  const usize numTuples = values.size() / k_NumComps;
+
+  DataStructure dataStructure;
+  auto* attributeMatrix = AttributeMatrix::Create(dataStructure, k_GeneratedData, {numTuples});
+  auto* valuesArray = UnitTest::CreateTestDataArray<float64>(dataStructure, k_GeneratedValues, {numTuples}, {k_NumComps}, attributeMatrix->getId());
+  std::copy(values.begin(), values.end(), valuesArray->begin());
+
+  KMeansFilter filter;
+  Arguments args;
+  args.insertOrAssign(KMeansFilter::k_UseSeed_Key, std::make_any<bool>(true));
+  args.insertOrAssign(KMeansFilter::k_SeedValue_Key, std::make_any<uint64>(k_SeedValue));
+  args.insertOrAssign(KMeansFilter::k_InitClusters_Key, std::make_any<uint64>(k_NumClusters));
+  args.insertOrAssign(KMeansFilter::k_DistanceMetric_Key, std::make_any<ChoicesParameter::ValueType>(to_underlying(metric)));
+  args.insertOrAssign(KMeansFilter::k_InitializationMethod_Key, std::make_any<ChoicesParameter::ValueType>(to_underlying(KUtilities::KMeansPlusPlus)));
+  args.insertOrAssign(KMeansFilter::k_UseMask_Key, std::make_any<bool>(false));
+  args.insertOrAssign(KMeansFilter::k_SelectedArrayPath_Key, std::make_any<DataPath>(k_GeneratedValuesPath));
+  args.insertOrAssign(KMeansFilter::k_FeatureIdsArrayName_Key, std::make_any<std::string>(k_ClusterIdsName));
+  args.insertOrAssign(KMeansFilter::k_FeatureAMPath_Key, std::make_any<DataPath>(k_GeneratedClusterDataPath));
+  args.insertOrAssign(KMeansFilter::k_MeansArrayName_Key, std::make_any<std::string>(k_MeansName));
+
+  auto preflightResult = filter.preflight(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions)
+
+  auto executeResult = filter.execute(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result)
+
+  const std::vector<int32> expectedIds =
+      metric == KUtilities::Euclidean ? RunLloyd<KUtilities::Euclidean>(values, k_NumComps, k_NumClusters, k_SeedValue) : RunLloyd<KUtilities::SquaredEuclidean>(values, k_NumComps, k_NumClusters, k_SeedValue);
+  const auto& clusterIds = dataStructure.getDataRefAs<Int32Array>(k_GeneratedClusterIdsPath);
+  REQUIRE(clusterIds.getNumberOfTuples() == expectedIds.size());
+  usize mismatches = 0;
+  for(usize i = 0; i < expectedIds.size(); i++)
+  {
+    mismatches += clusterIds[i] != expectedIds[i] ? 1 : 0;
+  }
+  REQUIRE(mismatches == 0);
+}
@@ -1,15 +1,26 @@
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
+#include "ComplexCore/Filters/ConditionalSetValue.hpp"
+#include "ComplexCore/Filters/ConvertDataFilter.hpp"
+#include "ComplexCore/Filters/CreateDataArray.hpp"
+#include "ComplexCore/Filters/DeleteData.hpp"
+#include "ComplexCore/Filters/MultiThresholdObjects.hpp"
 
 #include "complex/Core/Application.hpp"
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/IO/Generic/IOConstants.hpp"
 #include "complex/Filter/Actions/CreateArrayAction.hpp"
 #include "complex/Filter/Actions/DeleteDataAction.hpp"
 #include "complex/Filter/Arguments.hpp"
 #include "complex/Filter/FilterHandle.hpp"
 #include "complex/Parameters/ChoicesParameter.hpp"
+#include "complex/Parameters/DataObjectNameParameter.hpp"
+#include "complex/Parameters/DynamicTableParameter.hpp"
 #include "complex/Parameters/GeneratedFileListParameter.hpp"
+#include "complex/Parameters/MultiPathSelectionParameter.hpp"
 #include "complex/Pipeline/Pipeline.hpp"
 #include "complex/Pipeline/PipelineFilter.hpp"
 #include "complex/Plugin/AbstractPlugin.hpp"
+#include "complex/Utilities/ArrayThreshold.hpp"
 
 #include <catch2/catch.hpp>
 
@@ -104,6 +115,47 @@ protected:
     return {};
   }
 };
+
+const DataPath k_ReleasedArrayPath({"A"});
+constexpr usize k_ReleasedArrayTuples = 10;
+
+/**
+ * @brief Returns the CreateDataArray arguments for an int32 array at k_ReleasedArrayPath filled with 5.
+ * @return Arguments
+ */
+Arguments CreateArrayArguments()
+{
+  Arguments createArgs;
+  createArgs.insert(CreateDataArray::k_NumericType_Key, std::make_any<NumericType>(NumericType::int32));
+  createArgs.insert(CreateDataArray::k_NumComps_Key, std::make_any<uint64>(1));
+  createArgs.insert(CreateDataArray::k_AdvancedOptions_Key, std::make_any<bool>(true));
+  createArgs.insert(CreateDataArray::k_TupleDims_Key, std::make_any<DynamicTableParameter::ValueType>(DynamicTableInfo::TableDataType{{static_cast<float64>(k_ReleasedArrayTuples)}}));
+  createArgs.insert(CreateDataArray::k_DataPath_Key, std::make_any<DataPath>(k_ReleasedArrayPath));
+  createArgs.insert(CreateDataArray::k_InitilizationValue_Key, std::make_any<std::string>("5"));
+  return createArgs;
+}
+
+/**
+ * @brief Returns a pipeline that creates the array at k_ReleasedArrayPath filled with 5,
+ * runs the given filter on it and then deletes it.
+ * @param filter
+ * @param args
+ * @return Pipeline
+ */
+Pipeline CreateReleasePipeline(IFilter::UniquePointer&& filter, const Arguments& args)
+{
+  Arguments createArgs = CreateArrayArguments();
+
+  Arguments deleteArgs;
+  deleteArgs.insert(DeleteData::k_DataPath_Key, std::make_any<MultiPathSelectionParameter::ValueType>({k_ReleasedArrayPath}));
+
+  Pipeline pipeline("Release Test Pipeline");
+  pipeline.setReleaseUnusedData(true);
+  REQUIRE(pipeline.push_back(std::make_unique<CreateDataArray>(), createArgs));
+  REQUIRE(pipeline.push_back(std::move(filter), args));
+  REQUIRE(pipeline.push_back(std::make_unique<DeleteData>(), deleteArgs));
+  return pipeline;
+}
 } // namespace
 
 TEST_CASE("PipelineTest:Execute Pipeline")
@@ -379,3 +431,137 @@ TEST_CASE("PipelineTest:PipelineDeferredActionTest")
   DataObject* executeObject = dataStructure.getData(k_DeferredActionPath);
   REQUIRE(executeObject == nullptr);
 }
+
+TEST_CASE("PipelineTest:Release Unused Data")
+{
+  // The array may only be released after the filter between its creation and deletion has read it
+  SECTION("Array Thresholds Argument")
+  {
+    const std::string maskName = "Mask";
+    ArrayThresholdSet thresholdSet;
+    auto threshold = std::make_shared<ArrayThreshold>();
+    threshold->setArrayPath(k_ReleasedArrayPath);
+    threshold->setComparisonType(ArrayThreshold::ComparisonType::GreaterThan);
+    threshold->setComparisonValue(2.0);
+    thresholdSet.setArrayThresholds({threshold});
+
+    Arguments args;
+    args.insert(MultiThresholdObjects::k_ArrayThresholds_Key, std::make_any<ArrayThresholdSet>(thresholdSet));
+    args.insert(MultiThresholdObjects::k_CreatedDataPath_Key, std::make_any<std::string>(maskName));
+    args.insert(MultiThresholdObjects::k_CreatedMaskType_Key, std::make_any<DataType>(DataType::boolean));
+
+    Pipeline pipeline = CreateReleasePipeline(std::make_unique<MultiThresholdObjects>(), args);
+    REQUIRE(pipeline.preflight());
+    DataStructure dataStructure;
+    REQUIRE(pipeline.execute(dataStructure, false));
+
+    REQUIRE(dataStructure.getData(k_ReleasedArrayPath) == nullptr);
+    const auto* mask = dataStructure.getDataAs<BoolArray>(DataPath({maskName}));
+    REQUIRE(mask != nullptr);
+    REQUIRE(mask->getNumberOfTuples() == k_ReleasedArrayTuples);
+    for(usize i = 0; i < k_ReleasedArrayTuples; i++)
+    {
+      REQUIRE(mask->at(i));
+    }
+  }
+
+  SECTION("DataPath Argument")
+  {
+    const std::string convertedName = "B";
+    Arguments args;
+    args.insert(ConvertDataFilter::k_ScalarType_Key, std::make_any<ChoicesParameter::ValueType>(static_cast<uint8>(DataType::float32)));
+    args.insert(ConvertDataFilter::k_ArrayToConvert_Key, std::make_any<DataPath>(k_ReleasedArrayPath));
+    args.insert(ConvertDataFilter::k_ConvertedArray_Key, std::make_any<DataObjectNameParameter::ValueType>(convertedName));
+
+    Pipeline pipeline = CreateReleasePipeline(std::make_unique<ConvertDataFilter>(), args);
+    REQUIRE(pipeline.preflight());
+    DataStructure dataStructure;
+    REQUIRE(pipeline.execute(dataStructure, false));
+
+    REQUIRE(dataStructure.getData(k_ReleasedArrayPath) == nullptr);
+    const auto* converted = dataStructure.getDataAs<Float32Array>(DataPath({convertedName}));
+    REQUIRE(converted != nullptr);
+    REQUIRE(converted->getNumberOfTuples() == k_ReleasedArrayTuples);
+    for(usize i = 0; i < k_ReleasedArrayTuples; i++)
+    {
+      REQUIRE(converted->at(i) == 5.0f);
+    }
+  }
+
+  // Arrays that are part of the final DataStructure keep their values in a memory mapped file after their last use
+  SECTION("Kept Arrays Are Spilled")
+  {
+    const std::string convertedName = "B";
+    const DataPath laterArrayPath({"C"});
+    Arguments convertArgs;
+    convertArgs.insert(ConvertDataFilter::k_ScalarType_Key, std::make_any<ChoicesParameter::ValueType>(static_cast<uint8>(DataType::float32)));
+    convertArgs.insert(ConvertDataFilter::k_ArrayToConvert_Key, std::make_any<DataPath>(k_ReleasedArrayPath));
+    convertArgs.insert(ConvertDataFilter::k_ConvertedArray_Key, std::make_any<DataObjectNameParameter::ValueType>(convertedName));
+    Arguments laterArgs = CreateArrayArguments();
+    laterArgs.insertOrAssign(CreateDataArray::k_DataPath_Key, std::make_any<DataPath>(laterArrayPath));
+
+    Pipeline pipeline("Spill Test Pipeline");
+    pipeline.setReleaseUnusedData(true);
+    REQUIRE(pipeline.push_back(std::make_unique<CreateDataArray>(), CreateArrayArguments()));
+    REQUIRE(pipeline.push_back(std::make_unique<ConvertDataFilter>(), convertArgs));
+    REQUIRE(pipeline.push_back(std::make_unique<CreateDataArray>(), laterArgs));
+    REQUIRE(pipeline.preflight());
+    DataStructure dataStructure;
+    REQUIRE(pipeline.execute(dataStructure, false));
+
+    const auto* spilledArray = dataStructure.getDataAs<Int32Array>(k_ReleasedArrayPath);
+    REQUIRE(spilledArray != nullptr);
+    REQUIRE(spilledArray->getDataFormat() == IOConstants::k_MmapDataFormat);
+    const auto* converted = dataStructure.getDataAs<Float32Array>(DataPath({convertedName}));
+    REQUIRE(converted != nullptr);
+    REQUIRE(converted->getDataFormat() == IOConstants::k_MmapDataFormat);
+    const auto* laterArray = dataStructure.getDataAs<Int32Array>(laterArrayPath);
+    REQUIRE(laterArray != nullptr);
+    REQUIRE(laterArray->getDataFormat().empty());
+    for(usize i = 0; i < k_ReleasedArrayTuples; i++)
+    {
+      REQUIRE(spilledArray->at(i) == 5);
+      REQUIRE(converted->at(i) == 5.0f);
+    }
+
+    // Nodes do not keep the released or spilled values alive
+    REQUIRE(pipeline[0]->getDataStructure().getSize() == 0);
+  }
+}
+
+TEST_CASE("PipelineTest:Node Snapshots")
+{
+  REQUIRE(!Pipeline().storesNodeSnapshots());
+  const bool storeSnapshots = GENERATE(false, true);
+
+  Arguments replaceArgs;
+  replaceArgs.insert(ConditionalSetValue::k_UseConditional_Key, std::make_any<bool>(false));
+  replaceArgs.insert(ConditionalSetValue::k_RemoveValue_Key, std::make_any<std::string>("5"));
+  replaceArgs.insert(ConditionalSetValue::k_ReplaceValue_Key, std::make_any<std::string>("7"));
+  replaceArgs.insert(ConditionalSetValue::k_SelectedArrayPath_Key, std::make_any<DataPath>(k_ReleasedArrayPath));
+
+  Pipeline pipeline("Snapshot Test Pipeline");
+  pipeline.setStoreNodeSnapshots(storeSnapshots);
+  REQUIRE(pipeline.push_back(std::make_unique<CreateDataArray>(), CreateArrayArguments()));
+  REQUIRE(pipeline.push_back(std::make_unique<ConditionalSetValue>(), replaceArgs));
+  REQUIRE(pipeline.execute());
+
+  // Without snapshots the first node references the array the second filter changed in place
+  const auto* createdArray = pipeline[0]->getDataStructure().getDataAs<Int32Array>(k_ReleasedArrayPath);
+  REQUIRE(createdArray != nullptr);
+  const int32 expectedValue = storeSnapshots ? 5 : 7;
+  for(usize i = 0; i < k_ReleasedArrayTuples; i++)
+  {
+    REQUIRE(createdArray->at(i) == expectedValue);
+  }
+
+  // Resuming needs the snapshot of the previous node and must leave it unchanged
+  REQUIRE(pipeline.executeFrom(1) == storeSnapshots);
+  if(storeSnapshots)
+  {
+    REQUIRE(createdArray->at(0) == 5);
+    const auto* replacedArray = pipeline[1]->getDataStructure().getDataAs<Int32Array>(k_ReleasedArrayPath);
+    REQUIRE(replacedArray != nullptr);
+    REQUIRE(replacedArray->at(0) == 7);
+  }
+}
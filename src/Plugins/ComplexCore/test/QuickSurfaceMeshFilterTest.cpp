@@ -15,6 +15,10 @@ using namespace complex::Constants;
 
 TEST_CASE("ComplexCore::QuickSurfaceMeshFilter", "[ComplexCore][QuickSurfaceMeshFilter]")
 {
+  // The mesh of every feature has to match the exemplar whether the layers are meshed in parallel or serially
+  const bool serial = GENERATE(false, true);
+  INFO(fmt::format("Serial = {}", serial));
+
   const complex::UnitTest::TestFileSentinel testDataSentinel(complex::unit_test::k_CMakeExecutable, complex::unit_test::k_TestFilesDir, "SurfaceMeshTest.tar.gz", "SurfaceMeshTest");
 
   // Read the Small IN100 Data set
@@ -28,6 +32,19 @@ TEST_CASE("ComplexCore::QuickSurfaceMeshFilter", "[ComplexCore][QuickSurfaceMesh
   DataPath triangleGeometryPath({"QuickSurface Mesh Test"});
   const std::string exemplarGeometryPath("QuickSurface Mesh");
 
+  if(serial)
+  {
+    // The filter only meshes in parallel when its arrays are thread safe
+    auto& featureIds = dataStructure.getDataRefAs<Int32Array>(featureIdsDataPath);
+    const auto& featureIdsStore = featureIds.getDataStoreRef();
+    auto serialStore = std::make_shared<SerialDataStore<int32>>(featureIds.getTupleShape(), featureIds.getComponentShape());
+    for(usize i = 0; i < featureIdsStore.getSize(); i++)
+    {
+      (*serialStore)[i] = featureIdsStore[i];
+    }
+    featureIds.setDataStore(serialStore);
+  }
+
   {
     // DataStructure dataStructure;
     Arguments args;
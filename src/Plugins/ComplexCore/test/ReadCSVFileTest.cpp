@@ -8,6 +8,7 @@
 #include "complex/Parameters/ReadCSVFileParameter.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
+#include "complex/Utilities/Parsing/Text/TextTokenizer.hpp"
 #include "complex/Utilities/StringUtilities.hpp"
 
 #include <catch2/catch.hpp>
@@ -576,3 +577,82 @@ TEST_CASE("ComplexCore::ReadCSVFileFilter (Case 6): Invalid filter execution - B
   v = {std::to_string(std::numeric_limits<bool>::min()), std::to_string(std::numeric_limits<bool>::max()), ""};
   TestCase_TestPrimitives_Error<bool>(v, k_BlankLineErrorCode);
 }
+
+TEST_CASE("ComplexCore::ReadCSVFileFilter (Case 7): Invalid filter execution - Multiple Blocks")
+{
+  fs::create_directories(k_TestInput.parent_path());
+
+  // Every line is 8 bytes long so the lines of one progress step span two blocks of the file
+  constexpr usize k_LinesPerBlock = TextTokenizer::k_BlockSize / 8;
+  std::vector<std::string> values(k_LinesPerBlock * 3);
+  for(usize index = 0; index < values.size(); index++)
+  {
+    values[index] = fmt::format("{:07}", index);
+  }
+  // Both invalid values are parsed in the same step but in different blocks
+  const usize firstInvalid = k_LinesPerBlock - 1000;
+  values[firstInvalid] = "first";
+  values[k_LinesPerBlock + 1000] = "second";
+
+  std::string newGroupName = "New Group";
+  std::string arrayName = "Array";
+  ReadCSVFileFilter filter;
+  DataStructure dataStructure;
+  Arguments args =
+      createArguments(k_TestInput.string(), 2, ReadCSVData::HeaderMode::LINE, 1, {','}, {arrayName}, {DataType::int32}, {false}, {static_cast<usize>(values.size())}, values, newGroupName);
+  CreateTestDataFile(k_TestInput, values, {arrayName});
+
+  auto preflightResult = filter.preflight(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+
+  auto executeResult = filter.execute(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_INVALID(executeResult.result);
+  REQUIRE(executeResult.result.errors().size() == 1);
+  REQUIRE(executeResult.result.errors()[0].code == k_InvalidArgumentErrorCode);
+  // The header is line 1, so the value at index i is on line i + 2
+  REQUIRE(executeResult.result.errors()[0].message.find(fmt::format("Line {}:", firstInvalid + 2)) != std::string::npos);
+}
+
+TEST_CASE("ComplexCore::ReadCSVFileFilter (Case 8): Valid filter execution - Rewritten File")
+{
+  fs::create_directories(k_TestInput.parent_path());
+
+  const std::string newGroupName = "New Group";
+  ReadCSVFileFilter filter;
+
+  // The same filter instance reads the headers and line count again when the file changes
+  const std::vector<std::pair<std::vector<std::string>, usize>> fileContents = {{{"A", "B"}, 3}, {{"C", "D"}, 5}};
+  for(usize fileIndex = 0; fileIndex < fileContents.size(); fileIndex++)
+  {
+    const auto& [headers, numRows] = fileContents[fileIndex];
+    {
+      std::ofstream file(k_TestInput, std::ios_base::trunc);
+      REQUIRE(file.is_open());
+      file << "# Comment\r\n# Comment\r\n" << headers[0] << "," << headers[1] << "\r\n";
+      for(usize row = 0; row < numRows; row++)
+      {
+        file << row << "," << row * 10 << "\r\n";
+      }
+    }
+    // Make sure the modification time differs even on file systems with coarse timestamps
+    fs::last_write_time(k_TestInput, fs::last_write_time(k_TestInput) + std::chrono::seconds(static_cast<int64>(fileIndex) * 10));
+
+    std::vector<std::string> values;
+    DataStructure dataStructure;
+    Arguments args = createArguments(k_TestInput.string(), 4, ReadCSVData::HeaderMode::LINE, 3, {','}, {}, {DataType::int32, DataType::int32}, {false, false}, {numRows}, values, newGroupName);
+
+    auto executeResult = filter.execute(dataStructure, args);
+    COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+    const auto* firstArray = dataStructure.getDataAs<Int32Array>(DataPath({newGroupName, headers[0]}));
+    const auto* secondArray = dataStructure.getDataAs<Int32Array>(DataPath({newGroupName, headers[1]}));
+    REQUIRE(firstArray != nullptr);
+    REQUIRE(secondArray != nullptr);
+    REQUIRE(firstArray->getNumberOfTuples() == numRows);
+    for(usize row = 0; row < numRows; row++)
+    {
+      REQUIRE(firstArray->at(row) == static_cast<int32>(row));
+      REQUIRE(secondArray->at(row) == static_cast<int32>(row * 10));
+    }
+  }
+}
@@ -8,11 +8,13 @@
 #include "complex/Parameters/ReadCSVFileParameter.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
+#include "complex/Utilities/Parsing/Text/TextTokenizer.hpp"
 #include "complex/Utilities/StringUtilities.hpp"
 
 #include <catch2/catch.hpp>
 
 #include <fstream>
+#include <map>
 
 namespace fs = std::filesystem;
 using namespace complex;
@@ -243,6 +245,27 @@ void RunTest(char sep, int delimiter)
   }
 }
 
+// -----------------------------------------------------------------------------
+Result<> ReadLargeFile(const std::string& filePath, usize numTuples, DataStructure& dataStructure, const DataPath& createdArrayPath)
+{
+  ReadTextDataArrayFilter filter;
+  AttributeMatrix::Create(dataStructure, k_GroupAName, std::vector<usize>{numTuples});
+  Arguments args;
+  args.insertOrAssign(ReadTextDataArrayFilter::k_InputFileKey, std::make_any<fs::path>(fs::path(filePath)));
+  args.insertOrAssign(ReadTextDataArrayFilter::k_ScalarTypeKey, std::make_any<NumericType>(NumericType::int32));
+  args.insertOrAssign(ReadTextDataArrayFilter::k_NCompKey, std::make_any<uint64>(1));
+  args.insertOrAssign(ReadTextDataArrayFilter::k_NSkipLinesKey, std::make_any<uint64>(0));
+  args.insertOrAssign(ReadTextDataArrayFilter::k_DelimiterChoiceKey, std::make_any<uint64>(0));
+  args.insertOrAssign(ReadTextDataArrayFilter::k_DataArrayKey, std::make_any<DataPath>(createdArrayPath));
+  args.insertOrAssign(ReadTextDataArrayFilter::k_DataFormat_Key, std::make_any<std::string>(""));
+  args.insertOrAssign(ReadTextDataArrayFilter::k_AdvancedOptions_Key, std::make_any<bool>(false));
+
+  auto preflightResult = filter.preflight(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions)
+
+  return filter.execute(dataStructure, args).result;
+}
+
 TEST_CASE("ComplexCore::ReadTextDataArrayFilter: Valid filter execution", "[ComplexCore][ReadTextDataArrayFilter]")
 {
   RunTest<int8_t>(',', 0);
@@ -367,3 +390,63 @@ TEST_CASE("ComplexCore::ReadTextDataArrayFilter: Invalid filter execution", "[Co
     COMPLEX_RESULT_REQUIRE_INVALID(executeResult.result)
   }
 }
+
+TEST_CASE("ComplexCore::ReadTextDataArrayFilter: Multiple blocks", "[ComplexCore][ReadTextDataArrayFilter]")
+{
+  // Every line is 8 bytes long so the file is split into several blocks that are read in parallel
+  constexpr usize k_LineSize = 8;
+  constexpr usize k_LinesPerBlock = TextTokenizer::k_BlockSize / k_LineSize;
+  constexpr usize k_NumTuples = k_LinesPerBlock * 3 + 1000;
+  const std::string inputFilePath = fmt::format("{}/TestFile_MultipleBlocks.txt", unit_test::k_BinaryTestOutputDir);
+  const DataPath createdArrayPath({k_GroupAName, k_DataArrayName});
+
+  // Writes the values 0..numLines with the given tokens replaced
+  auto writeLargeFile = [&inputFilePath](usize numLines, const std::map<usize, std::string>& replacedTokens) {
+    std::ofstream outfile(inputFilePath, std::ios_base::binary);
+    for(usize index = 0; index < numLines; index++)
+    {
+      auto iter = replacedTokens.find(index);
+      outfile << (iter != replacedTokens.end() ? iter->second : fmt::format("{:07}", index)) << '\n';
+    }
+  };
+
+  SECTION("Valid")
+  {
+    // The lines after the array is filled are never read, even if they are not numbers
+    writeLargeFile(k_NumTuples + k_LinesPerBlock, {{k_NumTuples, "invalid"}, {k_NumTuples + k_LinesPerBlock - 1, "invalid"}});
+
+    DataStructure dataStructure;
+    Result<> result = ReadLargeFile(inputFilePath, k_NumTuples, dataStructure, createdArrayPath);
+    COMPLEX_RESULT_REQUIRE_VALID(result)
+
+    const auto& createdArray = dataStructure.getDataRefAs<Int32Array>(createdArrayPath);
+    for(usize index = 0; index < k_NumTuples; index++)
+    {
+      if(createdArray[index] != static_cast<int32>(index))
+      {
+        REQUIRE(createdArray[index] == static_cast<int32>(index));
+      }
+    }
+  }
+
+  SECTION("First invalid token in file order")
+  {
+    // The invalid tokens are in different blocks, the first one has to be reported
+    writeLargeFile(k_NumTuples, {{k_LinesPerBlock + 10, "first"}, {k_LinesPerBlock * 2 + 10, "second"}});
+
+    DataStructure dataStructure;
+    Result<> result = ReadLargeFile(inputFilePath, k_NumTuples, dataStructure, createdArrayPath);
+    COMPLEX_RESULT_REQUIRE_INVALID(result)
+    REQUIRE(result.errors().size() == 1);
+    REQUIRE(result.errors()[0].message.find("'first'") != std::string::npos);
+  }
+
+  SECTION("Too few values")
+  {
+    writeLargeFile(k_NumTuples - 1, {});
+
+    DataStructure dataStructure;
+    Result<> result = ReadLargeFile(inputFilePath, k_NumTuples, dataStructure, createdArrayPath);
+    COMPLEX_RESULT_REQUIRE_INVALID(result)
+  }
+}
@@ -10,10 +10,85 @@
 
 #include <catch2/catch.hpp>
 
+#include <random>
+
 using namespace complex;
 using namespace complex::UnitTest;
 using namespace complex::Constants;
 
+namespace
+{
+const SizeVec3 k_GeneratedDims = {41, 29, 13};
+const std::string k_InputArrayName = "Values";
+const std::string k_OutputFeatureIdsName = "Output_Feature_Ids";
+const std::string k_ComputedCellDataName = "Computed_CellData";
+
+/**
+ * @brief Creates an image geometry whose int32 values form blocks of nearly constant value.
+ * Neighboring blocks may share a value so features also span several blocks. If serial is
+ * true the values are stored in a SerialDataStore so the filter uses the serial flood fill.
+ */
+DataStructure CreateGeneratedData(bool serial)
+{
+  DataStructure dataStructure;
+  auto* imageGeom = ImageGeom::Create(dataStructure, k_DataContainer);
+  imageGeom->setDimensions(k_GeneratedDims);
+  const std::vector<usize> tupleShape = {k_GeneratedDims[2], k_GeneratedDims[1], k_GeneratedDims[0]};
+  auto* cellData = AttributeMatrix::Create(dataStructure, k_CellData, tupleShape, imageGeom->getId());
+  imageGeom->setCellData(*cellData);
+
+  Int32Array* values = serial ? Int32Array::CreateWithStore<SerialDataStore<int32>>(dataStructure, k_InputArrayName, tupleShape, {1}, cellData->getId())
+                              : CreateTestDataArray<int32>(dataStructure, k_InputArrayName, tupleShape, {1}, cellData->getId());
+  BoolArray* mask = CreateTestDataArray<bool>(dataStructure, k_Mask, tupleShape, {1}, cellData->getId());
+
+  std::mt19937_64 generator(1234u);
+  std::uniform_int_distribution<int32> noise(0, 1);
+  std::uniform_int_distribution<int32> maskDistribution(0, 9);
+  usize index = 0;
+  for(usize z = 0; z < k_GeneratedDims[2]; z++)
+  {
+    for(usize y = 0; y < k_GeneratedDims[1]; y++)
+    {
+      for(usize x = 0; x < k_GeneratedDims[0]; x++)
+      {
+        const auto block = static_cast<int32>(x / 7 + 2 * (y / 5) + 3 * (z / 4));
+        (*values)[index] = (block % 6) * 10 + noise(generator);
+        (*mask)[index] = maskDistribution(generator) != 0;
+        index++;
+      }
+    }
+  }
+  return dataStructure;
+}
+
+/**
+ * @brief Segments the generated data and returns the number of features found.
+ */
+usize SegmentGeneratedData(DataStructure& dataStructure, bool useMask)
+{
+  ScalarSegmentFeaturesFilter filter;
+  Arguments args;
+  const DataPath cellDataPath({k_DataContainer, k_CellData});
+  args.insertOrAssign(ScalarSegmentFeaturesFilter::k_GridGeomPath_Key, std::make_any<DataPath>(DataPath({k_DataContainer})));
+  args.insertOrAssign(ScalarSegmentFeaturesFilter::k_UseMask_Key, std::make_any<bool>(useMask));
+  args.insertOrAssign(ScalarSegmentFeaturesFilter::k_MaskArrayPath_Key, std::make_any<DataPath>(cellDataPath.createChildPath(k_Mask)));
+  args.insertOrAssign(ScalarSegmentFeaturesFilter::k_InputArrayPathKey, std::make_any<DataPath>(cellDataPath.createChildPath(k_InputArrayName)));
+  args.insertOrAssign(ScalarSegmentFeaturesFilter::k_ScalarToleranceKey, std::make_any<int>(1));
+  args.insertOrAssign(ScalarSegmentFeaturesFilter::k_FeatureIdsPathKey, std::make_any<std::string>(k_OutputFeatureIdsName));
+  args.insertOrAssign(ScalarSegmentFeaturesFilter::k_CellFeaturePathKey, std::make_any<std::string>(k_ComputedCellDataName));
+  args.insertOrAssign(ScalarSegmentFeaturesFilter::k_ActiveArrayPathKey, std::make_any<std::string>(k_ActiveName));
+  args.insertOrAssign(ScalarSegmentFeaturesFilter::k_RandomizeFeatures_Key, std::make_any<bool>(false));
+
+  auto preflightResult = filter.preflight(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions)
+
+  auto executeResult = filter.execute(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result)
+
+  return dataStructure.getDataRefAs<UInt8Array>(DataPath({k_DataContainer, k_ComputedCellDataName, k_ActiveName})).getNumberOfTuples();
+}
+} // namespace
+
 TEST_CASE("ComplexCore::ScalarSegmentFeatures", "[Reconstruction][ScalarSegmentFeatures]")
 {
   const complex::UnitTest::TestFileSentinel testDataSentinel(complex::unit_test::k_CMakeExecutable, complex::unit_test::k_TestFilesDir, "6_5_test_data_1.tar.gz", "6_5_test_data_1");
@@ -78,3 +153,19 @@ TEST_CASE("ComplexCore::ScalarSegmentFeatures", "[Reconstruction][ScalarSegmentF
     COMPLEX_RESULT_REQUIRE_VALID(resultH5);
   }
 }
+
+TEST_CASE("ComplexCore::ScalarSegmentFeatures: Parallel matches serial", "[Reconstruction][ScalarSegmentFeatures]")
+{
+  const bool useMask = GENERATE(false, true);
+  INFO(fmt::format("Use Mask = {}", useMask));
+
+  DataStructure parallelDataStructure = CreateGeneratedData(false);
+  DataStructure serialDataStructure = CreateGeneratedData(true);
+  const usize parallelFeatureCount = SegmentGeneratedData(parallelDataStructure, useMask);
+  const usize serialFeatureCount = SegmentGeneratedData(serialDataStructure, useMask);
+  REQUIRE(parallelFeatureCount > 2);
+  REQUIRE(parallelFeatureCount == serialFeatureCount);
+
+  const DataPath featureIdsPath({k_DataContainer, k_CellData, k_OutputFeatureIdsName});
+  ComparePartitions(parallelDataStructure.getDataRefAs<Int32Array>(featureIdsPath).getDataStoreRef(), serialDataStructure.getDataRefAs<Int32Array>(featureIdsPath).getDataStoreRef());
+}
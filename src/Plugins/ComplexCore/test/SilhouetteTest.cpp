@@ -1,10 +1,14 @@
 #include <catch2/catch.hpp>
 
+#include "complex/DataStructure/AttributeMatrix.hpp"
+#include "complex/DataStructure/DataArray.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
 
 #include "ComplexCore/ComplexCore_test_dirs.hpp"
 #include "ComplexCore/Filters/SilhouetteFilter.hpp"
 
+#include <random>
+
 using namespace complex;
 
 namespace
@@ -23,6 +27,40 @@ const DataPath k_MeansSilhouettePath = k_CellPath.createChildPath(k_MeansSilhoue
 
 const DataPath k_MedoidsSilhouettePathNX = k_CellPath.createChildPath(k_MedoidsSilhouetteName + "NX");
 const DataPath k_MeansSilhouettePathNX = k_CellPath.createChildPath(k_MeansSilhouetteName + "NX");
+
+const std::string k_ClusterData = "ClusterData";
+const DataPath k_ClusterDataPath = DataPath({k_ClusterData});
+const DataPath k_ValuesPath = k_ClusterDataPath.createChildPath("Values");
+const DataPath k_ClusterIdsPath = k_ClusterDataPath.createChildPath("ClusterIds");
+const DataPath k_FullSilhouettePath = k_ClusterDataPath.createChildPath("FullSilhouette");
+const DataPath k_SampledSilhouettePath = k_ClusterDataPath.createChildPath("SampledSilhouette");
+const std::string k_SeedArrayName = "Silhouette SeedValue";
+
+/**
+ * @brief Creates well separated 2D clusters, numbered from 1, so the sampled silhouette
+ * should closely match the exact one.
+ */
+DataStructure CreateSeparatedClusters(usize numClusters, usize pointsPerCluster)
+{
+  constexpr usize k_NumComps = 2;
+  const usize numTuples = numClusters * pointsPerCluster;
+
+  DataStructure dataStructure;
+  auto* clusterData = AttributeMatrix::Create(dataStructure, k_ClusterData, {numTuples});
+  auto* values = UnitTest::CreateTestDataArray<float32>(dataStructure, "Values", {numTuples}, {k_NumComps}, clusterData->getId());
+  auto* clusterIds = UnitTest::CreateTestDataArray<int32>(dataStructure, "ClusterIds", {numTuples}, {1}, clusterData->getId());
+
+  std::mt19937_64 generator(std::mt19937_64::default_seed);
+  std::uniform_real_distribution<float32> pointDistribution(-1.0f, 1.0f);
+  for(usize i = 0; i < numTuples; i++)
+  {
+    const usize cluster = i % numClusters;
+    (*values)[i * k_NumComps] = 50.0f * static_cast<float32>(cluster) + pointDistribution(generator);
+    (*values)[i * k_NumComps + 1] = pointDistribution(generator);
+    (*clusterIds)[i] = static_cast<int32>(cluster + 1);
+  }
+  return dataStructure;
+}
 } // namespace
 
 TEST_CASE("ComplexCore::SilhouetteFilter: Medoids Test", "[ComplexCore][SilhouetteFilter]")
@@ -80,3 +118,47 @@ TEST_CASE("ComplexCore::SilhouetteFilter: Means Test", "[ComplexCore][Silhouette
 
   UnitTest::CompareArrays<float64>(dataStructure, k_MeansSilhouettePath, k_MeansSilhouettePathNX);
 }
+
+TEST_CASE("ComplexCore::SilhouetteFilter: Sampled Matches Full", "[ComplexCore][SilhouetteFilter]")
+{
+  constexpr usize k_NumClusters = 3;
+  constexpr usize k_PointsPerCluster = 400;
+  constexpr uint64 k_Seed = 5489;
+
+  DataStructure dataStructure = CreateSeparatedClusters(k_NumClusters, k_PointsPerCluster);
+
+  auto runSilhouette = [&](bool useSampling, const DataPath& silhouettePath) {
+    SilhouetteFilter filter;
+    Arguments args;
+
+    args.insertOrAssign(SilhouetteFilter::k_UseMask_Key, std::make_any<bool>(false));
+    args.insertOrAssign(SilhouetteFilter::k_SelectedArrayPath_Key, std::make_any<DataPath>(k_ValuesPath));
+    args.insertOrAssign(SilhouetteFilter::k_FeatureIdsArrayPath_Key, std::make_any<DataPath>(k_ClusterIdsPath));
+    args.insertOrAssign(SilhouetteFilter::k_SilhouetteArrayPath_Key, std::make_any<DataPath>(silhouettePath));
+    args.insertOrAssign(SilhouetteFilter::k_UseSampling_Key, std::make_any<bool>(useSampling));
+    args.insertOrAssign(SilhouetteFilter::k_SampleSize_Key, std::make_any<uint64>(50));
+    args.insertOrAssign(SilhouetteFilter::k_UseSeed_Key, std::make_any<bool>(true));
+    args.insertOrAssign(SilhouetteFilter::k_SeedValue_Key, std::make_any<uint64>(k_Seed));
+    args.insertOrAssign(SilhouetteFilter::k_SeedArrayName_Key, std::make_any<std::string>(k_SeedArrayName + (useSampling ? "Sampled" : "Full")));
+
+    auto preflightResult = filter.preflight(dataStructure, args);
+    COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+
+    auto executeResult = filter.execute(dataStructure, args);
+    COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+  };
+
+  runSilhouette(false, k_FullSilhouettePath);
+  runSilhouette(true, k_SampledSilhouettePath);
+
+  REQUIRE(dataStructure.getDataRefAs<UInt64Array>(DataPath({k_SeedArrayName + "Sampled"}))[0] == k_Seed);
+
+  const auto& fullSilhouette = dataStructure.getDataRefAs<Float64Array>(k_FullSilhouettePath);
+  const auto& sampledSilhouette = dataStructure.getDataRefAs<Float64Array>(k_SampledSilhouettePath);
+  REQUIRE(fullSilhouette.getNumberOfTuples() == sampledSilhouette.getNumberOfTuples());
+  for(usize i = 0; i < fullSilhouette.getNumberOfTuples(); i++)
+  {
+    REQUIRE(fullSilhouette[i] > 0.9);
+    REQUIRE(std::abs(fullSilhouette[i] - sampledSilhouette[i]) < 0.01);
+  }
+}
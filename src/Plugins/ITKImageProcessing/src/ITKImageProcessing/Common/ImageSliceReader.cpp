@@ -0,0 +1,238 @@
+#include "ImageSliceReader.hpp"
+
+#include "ITKImageProcessing/Common/ITKArrayHelper.hpp"
+
+#include "complex/Common/TypesUtility.hpp"
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/ParallelTaskAlgorithm.hpp"
+
+#include <itkImageIOBase.h>
+#include <itkImageIOFactory.h>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <mutex>
+
+using namespace complex;
+
+namespace
+{
+/**
+ * @brief Opens the image and checks that it can be read into the destination without conversion.
+ */
+template <class T>
+Result<> ReadImageInformation(itk::ImageIOBase& imageIO, const cxItkImageReader::ImageSliceTask& task, usize numComponents)
+{
+  imageIO.SetFileName(task.filePath);
+  imageIO.ReadImageInformation();
+
+  std::optional<NumericType> numericType = ITK::ConvertIOComponentToNumericType(imageIO.GetComponentType());
+  if(!numericType.has_value() || *numericType != GetNumericType<T>())
+  {
+    return MakeErrorResult(-64512, fmt::format("The pixel type '{}' of image '{}' does not match the destination array.", imageIO.GetComponentTypeAsString(imageIO.GetComponentType()), task.filePath));
+  }
+  if(imageIO.GetNumberOfComponents() != numComponents)
+  {
+    return MakeErrorResult(-64513,
+                           fmt::format("Image '{}' has {} components per pixel but the destination array has {}.", task.filePath, imageIO.GetNumberOfComponents(), numComponents));
+  }
+
+  const uint32 numDimensions = imageIO.GetNumberOfDimensions();
+  const usize width = numDimensions > 0 ? imageIO.GetDimensions(0) : 1;
+  const usize height = numDimensions > 1 ? imageIO.GetDimensions(1) : 1;
+  const usize depth = numDimensions > 2 ? imageIO.GetDimensions(2) : 1;
+  if(width != task.width || height != task.height || depth != 1)
+  {
+    return MakeErrorResult(-64510, fmt::format("Image '{}' dimensions are different than the destination.\n  Destination Dims are:  {} x {}\n  Image Dims are:{} x {} x {}\n", task.filePath,
+                                               task.width, task.height, width, height, depth));
+  }
+
+  // Read the whole image
+  itk::ImageIORegion region(numDimensions);
+  for(uint32 i = 0; i < numDimensions; i++)
+  {
+    region.SetIndex(i, 0);
+    region.SetSize(i, imageIO.GetDimensions(i));
+  }
+  imageIO.SetIORegion(region);
+  return {};
+}
+
+struct ReadSliceFunctor
+{
+  template <class T>
+  Result<> operator()(const cxItkImageReader::ImageSliceTask& task, cxItkImageReader::SliceTransform transform, std::vector<uint8>& buffer, std::mutex& storeMutex) const
+  {
+    if constexpr(std::is_same_v<T, bool>)
+    {
+      return MakeErrorResult(-64514, fmt::format("Images cannot be read into the boolean array '{}'.", task.destination->getName()));
+    }
+    else
+    {
+      auto& store = dynamic_cast<DataArray<T>*>(task.destination)->getDataStoreRef();
+      const usize numComponents = store.getNumberOfComponents();
+      const usize rowSize = task.width * numComponents;
+      const usize sliceSize = rowSize * task.height;
+      const usize startIndex = task.tupleOffset * numComponents;
+      if(startIndex + sliceSize > store.getSize())
+      {
+        return MakeErrorResult(-64511, fmt::format("Image '{}' does not fit into the destination array.\n  TupleIndex:{}\n  MaxTupleIndex:{}", task.filePath, task.tupleOffset,
+                                                   store.getNumberOfTuples()));
+      }
+
+      itk::ImageIOBase::Pointer imageIO = itk::ImageIOFactory::CreateImageIO(task.filePath.c_str(), itk::CommonEnums::IOFileMode::ReadMode);
+      if(imageIO == nullptr)
+      {
+        return MakeErrorResult(-5, fmt::format("ITK could not read the given file \"{}\". Format is likely unsupported.", task.filePath));
+      }
+      Result<> result = ReadImageInformation<T>(*imageIO, task, numComponents);
+      if(result.invalid())
+      {
+        return result;
+      }
+
+      // Decode straight into the destination when no copy is needed
+      T* destination = store.isThreadSafe() ? store.getContiguousValues(startIndex) : nullptr;
+      if(destination != nullptr && transform == cxItkImageReader::SliceTransform::None)
+      {
+        imageIO->Read(destination);
+        return {};
+      }
+
+      buffer.resize(sliceSize * sizeof(T));
+      imageIO->Read(buffer.data());
+      const auto* values = reinterpret_cast<const T*>(buffer.data());
+
+      std::unique_lock<std::mutex> lock(storeMutex, std::defer_lock);
+      if(!store.isThreadSafe())
+      {
+        lock.lock();
+      }
+      if(transform == cxItkImageReader::SliceTransform::None)
+      {
+        if(!store.copyFromBuffer(startIndex, nonstd::span<const T>(values, sliceSize)))
+        {
+          return MakeErrorResult(-64511, fmt::format("Error copying image '{}' into the destination array at tuple {}.", task.filePath, task.tupleOffset));
+        }
+        return {};
+      }
+
+      // Apply the flip while copying each row into the destination
+      std::vector<T> flippedRow(transform == cxItkImageReader::SliceTransform::FlipAboutYAxis ? rowSize : 0);
+      for(usize row = 0; row < task.height; row++)
+      {
+        const usize sourceRow = transform == cxItkImageReader::SliceTransform::FlipAboutXAxis ? task.height - 1 - row : row;
+        nonstd::span<const T> rowValues(values + sourceRow * rowSize, rowSize);
+        if(transform == cxItkImageReader::SliceTransform::FlipAboutYAxis)
+        {
+          for(usize x = 0; x < task.width; x++)
+          {
+            std::copy_n(rowValues.data() + (task.width - 1 - x) * numComponents, numComponents, flippedRow.data() + x * numComponents);
+          }
+          rowValues = nonstd::span<const T>(flippedRow.data(), rowSize);
+        }
+
+        const usize rowIndex = startIndex + row * rowSize;
+        if(destination != nullptr)
+        {
+          std::copy(rowValues.begin(), rowValues.end(), destination + row * rowSize);
+        }
+        else if(!store.copyFromBuffer(rowIndex, rowValues))
+        {
+          return MakeErrorResult(-64511, fmt::format("Error copying image '{}' into the destination array at tuple {}.", task.filePath, task.tupleOffset));
+        }
+      }
+      return {};
+    }
+  }
+};
+} // namespace
+
+namespace cxItkImageReader
+{
+// -----------------------------------------------------------------------------
+ImageSliceReader::ImageSliceReader(std::vector<ImageSliceTask> tasks, SliceTransform transform)
+: m_Tasks(std::move(tasks))
+, m_Transform(transform)
+{
+}
+
+// -----------------------------------------------------------------------------
+ImageSliceReader::~ImageSliceReader() noexcept = default;
+
+// -----------------------------------------------------------------------------
+void ImageSliceReader::setReadAhead(usize readAhead)
+{
+  m_ReadAhead = readAhead;
+}
+
+// -----------------------------------------------------------------------------
+void ImageSliceReader::setStopOnError(bool stopOnError)
+{
+  m_StopOnError = stopOnError;
+}
+
+// -----------------------------------------------------------------------------
+void ImageSliceReader::setProgressCallback(ProgressCallback callback)
+{
+  m_ProgressCallback = std::move(callback);
+}
+
+// -----------------------------------------------------------------------------
+std::vector<Result<>> ImageSliceReader::execute(const std::atomic_bool& shouldCancel)
+{
+  std::vector<Result<>> results(m_Tasks.size());
+  std::atomic<usize> nextTask = 0;
+  std::atomic_bool stop = false;
+  usize completed = 0;
+  std::mutex progressMutex;
+  std::mutex storeMutex;
+
+  // Each reader takes the next unread image until all images are read
+  auto readImages = [&]() {
+    std::vector<uint8> buffer;
+    while(!shouldCancel && !stop)
+    {
+      const usize taskIndex = nextTask++;
+      if(taskIndex >= m_Tasks.size())
+      {
+        break;
+      }
+      const ImageSliceTask& task = m_Tasks[taskIndex];
+      Result<> result;
+      try
+      {
+        result = ExecuteDataFunction(ReadSliceFunctor{}, task.destination->getDataType(), task, m_Transform, buffer, storeMutex);
+      } catch(const itk::ExceptionObject& err)
+      {
+        result = MakeErrorResult(-55557, fmt::format("ITK exception was thrown while processing input file: {}", err.what()));
+      }
+      if(result.invalid() && m_StopOnError)
+      {
+        stop = true;
+      }
+      results[taskIndex] = std::move(result);
+
+      std::lock_guard<std::mutex> lock(progressMutex);
+      completed++;
+      if(m_ProgressCallback)
+      {
+        m_ProgressCallback(taskIndex, completed);
+      }
+    }
+  };
+
+  ParallelTaskAlgorithm taskRunner;
+  const usize numReaders = std::max<usize>(std::min<usize>(m_ReadAhead > 0 ? m_ReadAhead : taskRunner.getMaxThreads(), m_Tasks.size()), 1);
+  taskRunner.setMaxThreads(static_cast<uint32>(numReaders));
+  for(usize i = 0; i < numReaders; i++)
+  {
+    taskRunner.execute(readImages);
+  }
+  taskRunner.wait();
+
+  return results;
+}
+} // namespace cxItkImageReader
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "ITKImageProcessing/ITKImageProcessing_export.hpp"
+
+#include "complex/Common/Result.hpp"
+#include "complex/Common/Types.hpp"
+#include "complex/DataStructure/IDataArray.hpp"
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace complex;
+
+namespace cxItkImageReader
+{
+/**
+ * @brief Transform applied to each image while it is copied into the destination array.
+ */
+enum class SliceTransform : uint8
+{
+  None = 0,
+  FlipAboutXAxis = 1,
+  FlipAboutYAxis = 2
+};
+
+/**
+ * @brief A single 2D image file and the location in an existing array it is decoded into.
+ */
+struct ImageSliceTask
+{
+  std::string filePath;
+  IDataArray* destination = nullptr;
+  usize tupleOffset = 0;
+  usize width = 0;
+  usize height = 0;
+};
+
+/**
+ * @class ImageSliceReader
+ * @brief The ImageSliceReader class decodes a list of 2D images into preallocated
+ * arrays using a pool of reader threads. Every image is read with its own
+ * itk::ImageIOBase directly into the destination tuples when the destination is
+ * an in-memory store and no transform is requested. Otherwise the image is read
+ * into a per-thread buffer and the transform is applied while copying the rows
+ * into the destination. Each thread reads the next unread image as soon as it is
+ * done with the previous one, so file latency is overlapped across the pool.
+ *
+ * The pixel type, number of components, and dimensions of every image must match
+ * the destination, as no conversion is performed.
+ */
+class ITKIMAGEPROCESSING_EXPORT ImageSliceReader
+{
+public:
+  /**
+   * @brief Called after each image is read with the index of the task and the
+   * number of completed tasks. Calls are serialized.
+   */
+  using ProgressCallback = std::function<void(usize taskIndex, usize completed)>;
+
+  /**
+   * @param tasks
+   * @param transform
+   */
+  ImageSliceReader(std::vector<ImageSliceTask> tasks, SliceTransform transform = SliceTransform::None);
+  ~ImageSliceReader() noexcept;
+
+  ImageSliceReader(const ImageSliceReader&) = delete;
+  ImageSliceReader(ImageSliceReader&&) noexcept = delete;
+  ImageSliceReader& operator=(const ImageSliceReader&) = delete;
+  ImageSliceReader& operator=(ImageSliceReader&&) noexcept = delete;
+
+  /**
+   * @brief Sets the number of images read at the same time. 0 uses the
+   * maximum number of threads of the parallel algorithms. Defaults to 0.
+   * @param readAhead
+   */
+  void setReadAhead(usize readAhead);
+
+  /**
+   * @brief Sets whether the remaining images are skipped once an image fails
+   * to read. Defaults to true.
+   * @param stopOnError
+   */
+  void setStopOnError(bool stopOnError);
+
+  /**
+   * @brief Sets the callback that is notified after each image is read.
+   * @param callback
+   */
+  void setProgressCallback(ProgressCallback callback);
+
+  /**
+   * @brief Reads all images. Returns one Result per task in task order. Tasks
+   * skipped because of cancellation or an earlier error have a valid Result.
+   * @param shouldCancel
+   * @return std::vector<Result<>>
+   */
+  std::vector<Result<>> execute(const std::atomic_bool& shouldCancel);
+
+private:
+  std::vector<ImageSliceTask> m_Tasks;
+  SliceTransform m_Transform = SliceTransform::None;
+  usize m_ReadAhead = 0;
+  bool m_StopOnError = true;
+  ProgressCallback m_ProgressCallback;
+};
+} // namespace cxItkImageReader
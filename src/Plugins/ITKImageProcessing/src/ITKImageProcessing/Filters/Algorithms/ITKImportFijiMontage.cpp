@@ -1,6 +1,7 @@
 #include "ITKImportFijiMontage.hpp"
 
 #include "ITKImageProcessing/Common/ITKArrayHelper.hpp"
+#include "ITKImageProcessing/Common/ImageSliceReader.hpp"
 #include "ITKImageProcessing/Common/ReadImageUtils.hpp"
 #include "ITKImageProcessing/Filters/ITKImageReader.hpp"
 
@@ -185,10 +186,10 @@ private:
     auto* filterListPtr = Application::Instance()->getFilterList();
     auto imageImportFilter = ITKImageReader();
 
+    std::vector<DataPath> imageDataPaths;
+    std::vector<cxItkImageReader::ImageSliceTask> tasks;
     for(const auto& bound : m_Cache.bounds)
     {
-      m_Filter->sendUpdate(("Importing " + bound.Filepath.filename().string()));
-
       DataPath imageDataPath = {};
       if(m_InputValues->parentDataGroup)
       {
@@ -200,7 +201,7 @@ private:
       }
 
       // Ensure that we are dealing with in-core memory ONLY
-      const IDataArray* inputArrayPtr = m_DataStructure.getDataAs<IDataArray>(imageDataPath);
+      auto* inputArrayPtr = m_DataStructure.getDataAs<IDataArray>(imageDataPath);
       if(inputArrayPtr->getDataFormat() != "")
       {
         return MakeErrorResult(-9999, fmt::format("Input Array '{}' utilizes out-of-core data. This is not supported within ITK filters.", imageDataPath.toString()));
@@ -212,8 +213,25 @@ private:
       image->setOrigin(bound.Origin);
       image->setSpacing(FloatVec3(1.0f, 1.0f, 1.0f));
 
-      // Use ITKUtils to read the image into the DataStructure
-      Result<> imageReaderResult = cxItkImageReader::ReadImageExecute<cxItkImageReader::ReadImageIntoArrayFunctor>(bound.Filepath.string(), m_DataStructure, imageDataPath, bound.Filepath.string());
+      const SizeVec3 dims = image->getDimensions();
+      tasks.push_back({bound.Filepath.string(), inputArrayPtr, 0, dims[0], dims[1]});
+      imageDataPaths.push_back(imageDataPath);
+    }
+
+    // Read all tiles in parallel before any of them is converted
+    cxItkImageReader::ImageSliceReader tileReader(std::move(tasks));
+    tileReader.setStopOnError(false);
+    tileReader.setProgressCallback([this](usize tileIndex, usize) { m_Filter->sendUpdate(("Imported " + m_Cache.bounds[tileIndex].Filepath.filename().string())); });
+    std::vector<Result<>> readResults = tileReader.execute(m_Filter->getCancel());
+    if(m_Filter->getCancel())
+    {
+      return outputResult;
+    }
+
+    for(usize tileIndex = 0; tileIndex < imageDataPaths.size(); tileIndex++)
+    {
+      const DataPath& imageDataPath = imageDataPaths[tileIndex];
+      const Result<>& imageReaderResult = readResults[tileIndex];
       if(imageReaderResult.invalid())
       {
         for(const auto& error : imageReaderResult.errors())
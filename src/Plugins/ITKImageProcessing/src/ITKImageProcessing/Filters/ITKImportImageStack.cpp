@@ -1,6 +1,7 @@
 #include "ITKImportImageStack.hpp"
 
 #include "ITKImageProcessing/Common/ITKArrayHelper.hpp"
+#include "ITKImageProcessing/Common/ImageSliceReader.hpp"
 #include "ITKImageProcessing/Filters/ITKImageReader.hpp"
 
 #include "complex/Core/Application.hpp"
@@ -63,73 +64,11 @@ std::unique_ptr<IFilter> CreateRotateSampleRefFrameFilter()
   auto filter = filterListPtr->createFilter(k_RotateSampleRefFrameFilterHandle);
   return filter;
 }
-
-template <class T>
-void FlipAboutYAxis(DataArray<T>& dataArray, Vec3<usize>& dims)
-{
-  auto& tempDataStore = dataArray.getDataStoreRef();
-
-  usize numComp = tempDataStore.getNumberOfComponents();
-  std::vector<T> currentRowBuffer(dims[0] * dataArray.getNumberOfComponents());
-
-  // We could _in theory_ parallelize over the rows, not sure how the out-of-core
-  // would handle that though.
-  for(usize row = 0; row < dims[1]; row++)
-  {
-    // Copy the current row into a temp buffer
-    auto startIter = tempDataStore.begin() + (dims[0] * numComp * row);
-    auto endIter = startIter + dims[0] * numComp;
-    std::copy(startIter, endIter, currentRowBuffer.begin());
-
-    // Starting at the last tuple in the buffer
-    usize bufferIndex = (dims[0] - 1) * numComp;
-    usize dataStoreIndex = row * dims[0] * numComp;
-
-    for(usize tupleIdx = 0; tupleIdx < dims[0]; tupleIdx++)
-    {
-      for(usize cIdx = 0; cIdx < numComp; cIdx++)
-      {
-        tempDataStore.setValue(dataStoreIndex, currentRowBuffer[bufferIndex + cIdx]);
-        dataStoreIndex++;
-      }
-      bufferIndex = bufferIndex - numComp;
-    }
-  }
-}
-
-template <class T>
-void FlipAboutXAxis(DataArray<T>& dataArray, Vec3<usize>& dims)
-{
-  auto& tempDataStore = dataArray.getDataStoreRef();
-  usize numComp = tempDataStore.getNumberOfComponents();
-  size_t rowLCV = (dims[1] % 2 == 1) ? (dims[1] - 1 / 2) : dims[1] / 2;
-  usize bottomRow = dims[1] - 1;
-
-  for(usize row = 0; row < rowLCV; row++)
-  {
-    // Copy the "top" row into a temp buffer
-    auto topStartIter = 0 + (dims[0] * numComp * row);
-    auto topEndIter = topStartIter + dims[0] * numComp;
-    auto bottomStartIter = 0 + (dims[0] * numComp * bottomRow);
-
-    // Copy from bottom to top and then temp to bottom
-    for(usize eleIndex = topStartIter; eleIndex < topEndIter; eleIndex++)
-    {
-      T value = tempDataStore.getValue(eleIndex);
-      tempDataStore[eleIndex] = tempDataStore[bottomStartIter];
-      tempDataStore[bottomStartIter] = value;
-      bottomStartIter++;
-    }
-    bottomRow--;
-  }
-}
-
 } // namespace
 
 namespace cxITKImportImageStack
 {
-template <class T>
-Result<> ReadImageStack(DataStructure& dataStructure, const DataPath& imageGeomPath, const std::string& cellDataName, const DataPath& imageDataPath, const std::vector<std::string>& files,
+Result<> ReadImageStack(DataStructure& dataStructure, const DataPath& imageGeomPath, const DataPath& imageDataPath, const std::vector<std::string>& files,
                         ChoicesParameter::ValueType transformType, const IFilter::MessageHandler& messageHandler, const std::atomic_bool& shouldCancel)
 {
   auto& imageGeom = dataStructure.getDataRefAs<ImageGeom>(imageGeomPath);
@@ -137,74 +76,37 @@ Result<> ReadImageStack(DataStructure& dataStructure, const DataPath& imageGeomP
   SizeVec3 dims = imageGeom.getDimensions();
   const usize tuplesPerSlice = dims[0] * dims[1];
 
-  auto& outputData = dataStructure.getDataRefAs<DataArray<T>>(imageDataPath);
-  auto& outputDataStore = outputData.getDataStoreRef();
+  auto& outputData = dataStructure.getDataRefAs<IDataArray>(imageDataPath);
 
   imageGeom.getLinkedGeometryData().addCellData(imageDataPath);
 
-  // Variables for the progress Reporting
-  usize slice = 0;
-
-  // Loop over all the files importing them one by one and copying the data into the data array
-  for(const auto& filePath : files)
+  // Each file is decoded directly into its Z slice of the output array
+  std::vector<cxItkImageReader::ImageSliceTask> tasks(files.size());
+  for(usize slice = 0; slice < files.size(); slice++)
   {
-    messageHandler(IFilter::Message::Type::Info, fmt::format("Importing: {}", filePath));
-
-    DataStructure importedDataStructure;
-
-    {
-      // Create a sub-filter to read each image, although for preflight we are going to read the first image in the
-      // list and hope the rest are correct.
-      const ITKImageReader imageReader;
-
-      Arguments args;
-      args.insertOrAssign(ITKImageReader::k_ImageGeometryPath_Key, std::make_any<DataPath>(imageGeomPath));
-      args.insertOrAssign(ITKImageReader::k_CellDataName_Key, std::make_any<std::string>(cellDataName));
-      args.insertOrAssign(ITKImageReader::k_ImageDataArrayPath_Key, std::make_any<DataPath>(imageDataPath));
-      args.insertOrAssign(ITKImageReader::k_FileName_Key, std::make_any<fs::path>(filePath));
-
-      auto executeResult = imageReader.execute(importedDataStructure, args);
-      if(executeResult.result.invalid())
-      {
-        return executeResult.result;
-      }
-    }
-    // Check the ImageGeometry of the imported Image matches the destination
-    const auto& importedImageGeom = importedDataStructure.getDataRefAs<ImageGeom>(imageGeomPath);
-    SizeVec3 importedDims = importedImageGeom.getDimensions();
-    if(dims[0] != importedDims[0] || dims[1] != importedDims[1])
-    {
-      return MakeErrorResult(-64510, fmt::format("Slice {} image dimensions are different than the first slice.\n  First Slice Dims are:  {} x {}\n  Current Slice Dims are:{} x {}\n", slice,
-                                                 importedDims[0], importedDims[1], dims[0], dims[1]));
-    }
-
-    // Compute the Tuple Index we are at:
-    const usize tupleIndex = (slice * dims[0] * dims[1]);
-    // get the current Slice data...
-    auto& tempData = importedDataStructure.getDataRefAs<DataArray<T>>(imageDataPath);
-    auto& tempDataStore = tempData.getDataStoreRef();
-
-    if(transformType == k_FlipAboutYAxis)
-    {
-      FlipAboutYAxis<T>(tempData, dims);
-    }
-    else if(transformType == k_FlipAboutXAxis)
-    {
-      FlipAboutXAxis<T>(tempData, dims);
-    }
-
-    // Copy that into the output array...
-    if(!outputDataStore.copyFrom(tupleIndex, tempDataStore, 0, tuplesPerSlice))
-    {
-      return MakeErrorResult(-64511, fmt::format("Error copying source image data into destination array.\n  Slice:{}\n  TupleIndex:{}\n  MaxTupleIndex:{}", slice, tupleIndex, outputData.getSize()));
-    }
+    tasks[slice] = {files[slice], &outputData, slice * tuplesPerSlice, dims[0], dims[1]};
+  }
 
-    slice++;
+  cxItkImageReader::SliceTransform transform = cxItkImageReader::SliceTransform::None;
+  if(transformType == k_FlipAboutYAxis)
+  {
+    transform = cxItkImageReader::SliceTransform::FlipAboutYAxis;
+  }
+  else if(transformType == k_FlipAboutXAxis)
+  {
+    transform = cxItkImageReader::SliceTransform::FlipAboutXAxis;
+  }
 
-    // Check to see if the filter got canceled.
-    if(shouldCancel)
+  cxItkImageReader::ImageSliceReader sliceReader(std::move(tasks), transform);
+  sliceReader.setProgressCallback([&messageHandler, &files](usize slice, usize completed) {
+    messageHandler(IFilter::Message::Type::Info, fmt::format("Imported {}/{}: {}", completed, files.size(), files[slice]));
+  });
+  std::vector<Result<>> results = sliceReader.execute(shouldCancel);
+  for(auto& result : results)
+  {
+    if(result.invalid())
     {
-      return {};
+      return std::move(result);
     }
   }
 
@@ -378,54 +280,7 @@ Result<> ITKImportImageStack::executeImpl(DataStructure& dataStructure, const Ar
   {
     return MakeErrorResult(-4, fmt::format("Unsupported pixel component: {}", imageIO->GetComponentTypeAsString(component)));
   }
-  Result<> readResult;
-  switch(*numericType)
-  {
-  case NumericType::uint8: {
-    readResult = cxITKImportImageStack::ReadImageStack<uint8>(dataStructure, imageGeomPath, cellDataName, imageDataPath, files, imageTransformValue, messageHandler, shouldCancel);
-    break;
-  }
-  case NumericType::int8: {
-    readResult = cxITKImportImageStack::ReadImageStack<int8>(dataStructure, imageGeomPath, cellDataName, imageDataPath, files, imageTransformValue, messageHandler, shouldCancel);
-    break;
-  }
-  case NumericType::uint16: {
-    readResult = cxITKImportImageStack::ReadImageStack<uint16>(dataStructure, imageGeomPath, cellDataName, imageDataPath, files, imageTransformValue, messageHandler, shouldCancel);
-    break;
-  }
-  case NumericType::int16: {
-    readResult = cxITKImportImageStack::ReadImageStack<int16>(dataStructure, imageGeomPath, cellDataName, imageDataPath, files, imageTransformValue, messageHandler, shouldCancel);
-    break;
-  }
-  case NumericType::uint32: {
-    readResult = cxITKImportImageStack::ReadImageStack<uint32>(dataStructure, imageGeomPath, cellDataName, imageDataPath, files, imageTransformValue, messageHandler, shouldCancel);
-    break;
-  }
-  case NumericType::int32: {
-    readResult = cxITKImportImageStack::ReadImageStack<int32>(dataStructure, imageGeomPath, cellDataName, imageDataPath, files, imageTransformValue, messageHandler, shouldCancel);
-    break;
-  }
-  case NumericType::uint64: {
-    readResult = cxITKImportImageStack::ReadImageStack<uint64>(dataStructure, imageGeomPath, cellDataName, imageDataPath, files, imageTransformValue, messageHandler, shouldCancel);
-    break;
-  }
-  case NumericType::int64: {
-    readResult = cxITKImportImageStack::ReadImageStack<int64>(dataStructure, imageGeomPath, cellDataName, imageDataPath, files, imageTransformValue, messageHandler, shouldCancel);
-    break;
-  }
-  case NumericType::float32: {
-    readResult = cxITKImportImageStack::ReadImageStack<float32>(dataStructure, imageGeomPath, cellDataName, imageDataPath, files, imageTransformValue, messageHandler, shouldCancel);
-    break;
-  }
-  case NumericType::float64: {
-    readResult = cxITKImportImageStack::ReadImageStack<float64>(dataStructure, imageGeomPath, cellDataName, imageDataPath, files, imageTransformValue, messageHandler, shouldCancel);
-    break;
-  }
-  default: {
-    throw std::runtime_error("Unsupported array type");
-  }
-  }
 
-  return readResult;
+  return cxITKImportImageStack::ReadImageStack(dataStructure, imageGeomPath, imageDataPath, files, imageTransformValue, messageHandler, shouldCancel);
 }
 } // namespace complex
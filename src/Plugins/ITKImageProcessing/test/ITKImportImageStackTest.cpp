@@ -1,14 +1,20 @@
 #include <catch2/catch.hpp>
 
+#include "ITKImageProcessing/Common/ImageSliceReader.hpp"
 #include "ITKImageProcessing/Filters/ITKImportImageStack.hpp"
 #include "ITKImageProcessing/ITKImageProcessing_test_dirs.hpp"
 #include "ITKTestBase.hpp"
 
+#include "complex/Core/Application.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/Geometry/ImageGeom.hpp"
+#include "complex/Parameters/ChoicesParameter.hpp"
 #include "complex/Parameters/GeneratedFileListParameter.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
 
+#include <itkImageFileWriter.h>
+#include <itkVectorImage.h>
+
 #include <filesystem>
 
 using namespace complex;
@@ -20,6 +26,138 @@ namespace
 const std::string k_ImageStackDir = unit_test::k_DataDir.str() + "/ImageStack";
 const DataPath k_ImageGeomPath = {{"ImageGeometry"}};
 const DataPath k_ImageDataPath = k_ImageGeomPath.createChildPath(ImageGeom::k_CellDataName).createChildPath("ImageData");
+
+const std::string k_GeneratedStackDir = fmt::format("{}/ITKImportImageStackTest", unit_test::k_BinaryTestOutputDir.view());
+constexpr usize k_GeneratedWidth = 7;
+constexpr usize k_GeneratedHeight = 5;
+const ChoicesParameter::ValueType k_FlipAboutXAxis = 1;
+const ChoicesParameter::ValueType k_FlipAboutYAxis = 2;
+
+/**
+ * @brief Value of a pixel component in the generated images. Every position, component and slice has a different value.
+ */
+uint8 GeneratedValue(usize x, usize y, usize component, usize slice)
+{
+  return static_cast<uint8>(x + 10 * y + 60 * component + 3 * slice);
+}
+
+/**
+ * @brief Writes a stack of small tif images filled with GeneratedValue() and returns the file list that generates their paths.
+ */
+GeneratedFileListParameter::ValueType WriteGeneratedStack(usize numSlices, usize numComponents)
+{
+  using ImageType = itk::VectorImage<uint8, 2>;
+
+  fs::create_directories(k_GeneratedStackDir);
+
+  GeneratedFileListParameter::ValueType fileListInfo;
+  fileListInfo.inputPath = k_GeneratedStackDir;
+  fileListInfo.startIndex = 0;
+  fileListInfo.endIndex = static_cast<int32>(numSlices) - 1;
+  fileListInfo.incrementIndex = 1;
+  fileListInfo.fileExtension = ".tif";
+  fileListInfo.filePrefix = fmt::format("slice_{}_", numComponents);
+  fileListInfo.fileSuffix = "";
+  fileListInfo.paddingDigits = 2;
+  fileListInfo.ordering = GeneratedFileListParameter::Ordering::LowToHigh;
+
+  const std::vector<std::string> files = fileListInfo.generate();
+  for(usize slice = 0; slice < numSlices; slice++)
+  {
+    ImageType::SizeType size;
+    size[0] = k_GeneratedWidth;
+    size[1] = k_GeneratedHeight;
+    auto image = ImageType::New();
+    image->SetRegions(ImageType::RegionType(size));
+    image->SetNumberOfComponentsPerPixel(static_cast<uint32>(numComponents));
+    image->Allocate();
+
+    ImageType::PixelType pixel(static_cast<uint32>(numComponents));
+    for(usize y = 0; y < k_GeneratedHeight; y++)
+    {
+      for(usize x = 0; x < k_GeneratedWidth; x++)
+      {
+        for(usize component = 0; component < numComponents; component++)
+        {
+          pixel[component] = GeneratedValue(x, y, component, slice);
+        }
+        ImageType::IndexType index;
+        index[0] = static_cast<itk::IndexValueType>(x);
+        index[1] = static_cast<itk::IndexValueType>(y);
+        image->SetPixel(index, pixel);
+      }
+    }
+
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetFileName(files[slice]);
+    writer->SetInput(image);
+    writer->Update();
+  }
+  return fileListInfo;
+}
+
+/**
+ * @brief Creates a destination array for the generated images with a store that reports that it is not thread safe.
+ */
+UInt8Array* CreateSerialImageArray(DataStructure& dataStructure, usize numSlices, usize numComponents)
+{
+  return UInt8Array::CreateWithStore<UnitTest::SerialDataStore<uint8>>(dataStructure, "ImageData", {numSlices, k_GeneratedHeight, k_GeneratedWidth}, {numComponents});
+}
+
+/**
+ * @brief Creates one read task per file. Each file is decoded into its own Z slice of the destination.
+ */
+std::vector<cxItkImageReader::ImageSliceTask> CreateSliceTasks(const std::vector<std::string>& files, IDataArray& destination)
+{
+  std::vector<cxItkImageReader::ImageSliceTask> tasks(files.size());
+  for(usize slice = 0; slice < files.size(); slice++)
+  {
+    tasks[slice] = {files[slice], &destination, slice * k_GeneratedWidth * k_GeneratedHeight, k_GeneratedWidth, k_GeneratedHeight};
+  }
+  return tasks;
+}
+
+/**
+ * @brief Checks a slice of the imported data against the generated image, with the given transform applied.
+ */
+void CheckGeneratedSlice(const AbstractDataStore<uint8>& store, usize slice, cxItkImageReader::SliceTransform transform)
+{
+  const usize numComponents = store.getNumberOfComponents();
+  for(usize y = 0; y < k_GeneratedHeight; y++)
+  {
+    for(usize x = 0; x < k_GeneratedWidth; x++)
+    {
+      const usize sourceX = transform == cxItkImageReader::SliceTransform::FlipAboutYAxis ? k_GeneratedWidth - 1 - x : x;
+      const usize sourceY = transform == cxItkImageReader::SliceTransform::FlipAboutXAxis ? k_GeneratedHeight - 1 - y : y;
+      const usize tupleIndex = (slice * k_GeneratedHeight + y) * k_GeneratedWidth + x;
+      for(usize component = 0; component < numComponents; component++)
+      {
+        INFO(fmt::format("Slice = {}, X = {}, Y = {}, Component = {}", slice, x, y, component));
+        REQUIRE(store[tupleIndex * numComponents + component] == GeneratedValue(sourceX, sourceY, component, slice));
+      }
+    }
+  }
+}
+
+/**
+ * @brief Imports the generated stack with the filter and the given slice operation.
+ */
+Result<> ImportGeneratedStack(DataStructure& dataStructure, const GeneratedFileListParameter::ValueType& fileListInfo, ChoicesParameter::ValueType transformChoice)
+{
+  ITKImportImageStack filter;
+  Arguments args;
+  args.insertOrAssign(ITKImportImageStack::k_InputFileListInfo_Key, std::make_any<GeneratedFileListParameter::ValueType>(fileListInfo));
+  args.insertOrAssign(ITKImportImageStack::k_Origin_Key, std::make_any<std::vector<float32>>({0.0f, 0.0f, 0.0f}));
+  args.insertOrAssign(ITKImportImageStack::k_Spacing_Key, std::make_any<std::vector<float32>>({1.0f, 1.0f, 1.0f}));
+  args.insertOrAssign(ITKImportImageStack::k_ImageGeometryPath_Key, std::make_any<DataPath>(k_ImageGeomPath));
+  args.insertOrAssign(ITKImportImageStack::k_ImageTransformChoice_Key, std::make_any<ChoicesParameter::ValueType>(transformChoice));
+
+  auto preflightResult = filter.preflight(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions)
+
+  auto executeResult = filter.execute(dataStructure, args);
+  return executeResult.result;
+}
 } // namespace
 
 TEST_CASE("ITKImageProcessing::ITKImportImageStack: NoInput", "[ITKImageProcessing][ITKImportImageStack]")
@@ -154,3 +292,125 @@ TEST_CASE("ITKImageProcessing::ITKImportImageStack: CompareImage", "[ITKImagePro
   const std::string md5Hash = ITKTestBase::ComputeMd5Hash(dataStructure, k_ImageDataPath);
   REQUIRE(md5Hash == "2620b39f0dcaa866602c2591353116a4");
 }
+
+TEST_CASE("ITKImageProcessing::ITKImportImageStack: FlipAboutXAxis", "[ITKImageProcessing][ITKImportImageStack]")
+{
+  // The slice operations require the RotateSampleRefFrame filter from the ComplexCore plugin
+  Application::GetOrCreateInstance()->loadPlugins(unit_test::k_BuildDir.view(), true);
+
+  const usize numSlices = 3;
+  const GeneratedFileListParameter::ValueType fileListInfo = WriteGeneratedStack(numSlices, 1);
+
+  DataStructure dataStructure;
+  auto executeResult = ImportGeneratedStack(dataStructure, fileListInfo, k_FlipAboutXAxis);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult)
+
+  const auto& imageData = dataStructure.getDataRefAs<UInt8Array>(k_ImageDataPath);
+  REQUIRE(imageData.getNumberOfComponents() == 1);
+  REQUIRE(imageData.getNumberOfTuples() == numSlices * k_GeneratedHeight * k_GeneratedWidth);
+  for(usize slice = 0; slice < numSlices; slice++)
+  {
+    CheckGeneratedSlice(imageData.getDataStoreRef(), slice, cxItkImageReader::SliceTransform::FlipAboutXAxis);
+  }
+}
+
+TEST_CASE("ITKImageProcessing::ITKImportImageStack: FlipAboutYAxis Multiple Components", "[ITKImageProcessing][ITKImportImageStack]")
+{
+  // The slice operations require the RotateSampleRefFrame filter from the ComplexCore plugin
+  Application::GetOrCreateInstance()->loadPlugins(unit_test::k_BuildDir.view(), true);
+
+  const usize numSlices = 3;
+  const usize numComponents = 3;
+  const GeneratedFileListParameter::ValueType fileListInfo = WriteGeneratedStack(numSlices, numComponents);
+
+  DataStructure dataStructure;
+  auto executeResult = ImportGeneratedStack(dataStructure, fileListInfo, k_FlipAboutYAxis);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult)
+
+  const auto& imageData = dataStructure.getDataRefAs<UInt8Array>(k_ImageDataPath);
+  REQUIRE(imageData.getNumberOfComponents() == numComponents);
+  REQUIRE(imageData.getNumberOfTuples() == numSlices * k_GeneratedHeight * k_GeneratedWidth);
+  for(usize slice = 0; slice < numSlices; slice++)
+  {
+    CheckGeneratedSlice(imageData.getDataStoreRef(), slice, cxItkImageReader::SliceTransform::FlipAboutYAxis);
+  }
+}
+
+TEST_CASE("ITKImageProcessing::ITKImportImageStack: Non Thread Safe Destination", "[ITKImageProcessing][ITKImportImageStack]")
+{
+  // Stores that are not thread safe are written with copyFromBuffer while holding the reader's store mutex
+  const auto transform = GENERATE(cxItkImageReader::SliceTransform::None, cxItkImageReader::SliceTransform::FlipAboutXAxis, cxItkImageReader::SliceTransform::FlipAboutYAxis);
+  INFO(fmt::format("Transform = {}", static_cast<int32>(transform)));
+
+  const usize numSlices = 4;
+  const usize numComponents = 3;
+  const std::vector<std::string> files = WriteGeneratedStack(numSlices, numComponents).generate();
+
+  DataStructure dataStructure;
+  UInt8Array* imageData = CreateSerialImageArray(dataStructure, numSlices, numComponents);
+  REQUIRE_FALSE(imageData->getDataStoreRef().isThreadSafe());
+
+  cxItkImageReader::ImageSliceReader sliceReader(CreateSliceTasks(files, *imageData), transform);
+  sliceReader.setReadAhead(numSlices);
+  const std::atomic_bool shouldCancel = false;
+  std::vector<Result<>> results = sliceReader.execute(shouldCancel);
+  REQUIRE(results.size() == numSlices);
+  for(usize slice = 0; slice < numSlices; slice++)
+  {
+    COMPLEX_RESULT_REQUIRE_VALID(results[slice])
+    CheckGeneratedSlice(imageData->getDataStoreRef(), slice, transform);
+  }
+}
+
+TEST_CASE("ITKImageProcessing::ITKImportImageStack: Stop On Error", "[ITKImageProcessing][ITKImportImageStack]")
+{
+  const bool stopOnError = GENERATE(true, false);
+  INFO(fmt::format("Stop On Error = {}", stopOnError));
+
+  const usize numSlices = 3;
+  const usize numComponents = 1;
+  std::vector<std::string> files = WriteGeneratedStack(numSlices, numComponents).generate();
+  files[1] = fmt::format("{}/doesNotExist.tif", k_GeneratedStackDir);
+
+  DataStructure dataStructure;
+  UInt8Array* imageData = CreateSerialImageArray(dataStructure, numSlices, numComponents);
+
+  // A single reader reads the images in order, so no image after the missing one has been started when it fails
+  cxItkImageReader::ImageSliceReader sliceReader(CreateSliceTasks(files, *imageData));
+  sliceReader.setReadAhead(1);
+  sliceReader.setStopOnError(stopOnError);
+  const std::atomic_bool shouldCancel = false;
+  std::vector<Result<>> results = sliceReader.execute(shouldCancel);
+  REQUIRE(results.size() == numSlices);
+
+  COMPLEX_RESULT_REQUIRE_VALID(results[0])
+  CheckGeneratedSlice(imageData->getDataStoreRef(), 0, cxItkImageReader::SliceTransform::None);
+  COMPLEX_RESULT_REQUIRE_INVALID(results[1])
+
+  // Skipped images have a valid result and leave their slice untouched
+  COMPLEX_RESULT_REQUIRE_VALID(results[2])
+  if(stopOnError)
+  {
+    const auto& store = imageData->getDataStoreRef();
+    const usize sliceSize = k_GeneratedWidth * k_GeneratedHeight * numComponents;
+    for(usize index = 2 * sliceSize; index < 3 * sliceSize; index++)
+    {
+      REQUIRE(store[index] == 0);
+    }
+  }
+  else
+  {
+    CheckGeneratedSlice(imageData->getDataStoreRef(), 2, cxItkImageReader::SliceTransform::None);
+  }
+}
+
+TEST_CASE("ITKImageProcessing::ITKImportImageStack: Missing Slice", "[ITKImageProcessing][ITKImportImageStack]")
+{
+  // Preflight only reads the first image. Executing fails on the first slice that cannot be read.
+  GeneratedFileListParameter::ValueType fileListInfo = WriteGeneratedStack(2, 1);
+  fileListInfo.endIndex = 2;
+
+  DataStructure dataStructure;
+  auto executeResult = ImportGeneratedStack(dataStructure, fileListInfo, 0);
+  COMPLEX_RESULT_REQUIRE_INVALID(executeResult)
+}
@@ -1,14 +1,16 @@
 #include "AlignSectionsMisorientation.hpp"
 
+#include "OrientationAnalysis/Math/MisorientationEngine.hpp"
+
 #include "complex/Common/Numbers.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/DataStructure/Geometry/IGridGeometry.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
 #include "complex/Utilities/FilterUtilities.hpp"
 
-#include "EbsdLib/LaueOps/LaueOps.h"
-
+#include <array>
 #include <iostream>
+#include <limits>
 
 using namespace complex;
 
@@ -108,129 +110,130 @@ Result<> AlignSectionsMisorientation::findShifts(std::vector<int64_t>& xShifts,
       static_cast<int64_t>(udims[2]),
   };
 
-  std::vector<LaueOps::Pointer> orientationOps = LaueOps::GetAllOrientationOps();
-
-  int32_t progInt = 0;
+  const std::vector<MisorientationEngine> misorientationEngines = MisorientationEngine::CreateAll();
 
-  // Allocate a 2D Array which will be reused from slice to slice
-  std::vector<bool> misorients(dims[0] * dims[1], false);
+  double deg2Rad = (complex::numbers::pi / 180.0);
+  const auto misorientationTolerance = static_cast<float>(m_InputValues->misorientationTolerance * deg2Rad);
+  const float64 halfAngleCosine = MisorientationEngine::HalfAngleCosine(misorientationTolerance);
 
   const auto halfDim0 = static_cast<int64_t>(dims[0] * 0.5f);
   const auto halfDim1 = static_cast<int64_t>(dims[1] * 0.5f);
 
-  double deg2Rad = (complex::numbers::pi / 180.0);
-  auto start = std::chrono::steady_clock::now();
-  // Loop over the Z Direction
-  for(int64_t iter = 1; iter < dims[2]; iter++)
-  {
-    progInt = static_cast<float>(iter) / static_cast<float>(dims[2]) * 100.0f;
-    auto now = std::chrono::steady_clock::now();
-    // Only send updates every 1 second
-    if(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() > 1000)
-    {
-      std::string message = fmt::format("Determining Shifts || {}% Complete", progInt);
-      m_MessageHandler(complex::IFilter::ProgressMessage{complex::IFilter::Message::Type::Info, message, progInt});
-      start = std::chrono::steady_clock::now();
-    }
-    if(getCancel())
-    {
-      return {};
-    }
-    float minDisorientation = std::numeric_limits<float>::max();
-    // Work from the largest Slice Value to the lowest Slice Value.
-    int64_t slice = (dims[2] - 1) - iter;
-    int64_t oldxshift = -1;
-    int64_t oldyshift = -1;
-    int64_t newxshift = 0;
-    int64_t newyshift = 0;
+  const int32 coarseLevels = m_InputValues->useCoarseToFineSearch ? GetCoarseSearchLevels(dims[0], dims[1]) : 0;
 
-    // Initialize everything to false
-    std::fill(misorients.begin(), misorients.end(), false);
-
-    float misorientationTolerance = static_cast<float>(m_InputValues->misorientationTolerance * deg2Rad);
-
-    while(newxshift != oldxshift || newyshift != oldyshift)
+  // Returns the fraction of the sampled cells that are misoriented when the slice is shifted by (xShift, yShift) against the slice above it
+  auto disorientationFraction = [&](int64_t slice, int64_t xShift, int64_t yShift, int64_t sampleStep) {
+    float disorientation = 0.0f;
+    float count = 0.0f;
+    for(int64_t l = 0; l < dims[1]; l = l + sampleStep)
     {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for(int32_t j = -3; j < 4; j++)
+      for(int64_t n = 0; n < dims[0]; n = n + sampleStep)
       {
-        for(int32_t k = -3; k < 4; k++)
+        if((l + yShift) >= 0 && (l + yShift) < dims[1] && (n + xShift) >= 0 && (n + xShift) < dims[0])
         {
-          float disorientation = 0.0f;
-          float count = 0.0f;
-          int64_t xIdx = k + oldxshift + halfDim0;
-          int64_t yIdx = j + oldyshift + halfDim1;
-          int64_t idx = (dims[0] * yIdx) + xIdx;
-          if(!misorients[idx] && llabs(k + oldxshift) < halfDim0 && llabs(j + oldyshift) < halfDim1)
+          count++;
+          int64_t refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
+          int64_t curposition = (slice * dims[0] * dims[1]) + ((l + yShift) * dims[0]) + (n + xShift);
+          if(!m_InputValues->useGoodVoxels || maskCompare->bothTrue(refposition, curposition))
           {
-            for(int64_t l = 0; l < dims[1]; l = l + 4)
+            bool misoriented = true;
+            if(cellPhases[refposition] > 0 && cellPhases[curposition] > 0)
             {
-              for(int64_t n = 0; n < dims[0]; n = n + 4)
+              auto phase1 = static_cast<int32_t>(crystalStructures[cellPhases[refposition]]);
+              auto phase2 = static_cast<int32_t>(crystalStructures[cellPhases[curposition]]);
+              if(phase1 == phase2 && phase1 < static_cast<uint32_t>(misorientationEngines.size()))
               {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  count++;
-                  int64_t refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  int64_t curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  if(!m_InputValues->useGoodVoxels || maskCompare->bothTrue(refposition, curposition))
-                  {
-                    float angle = std::numeric_limits<float>::max();
-                    if(cellPhases[refposition] > 0 && cellPhases[curposition] > 0)
-                    {
-                      QuatF quat1(quats[refposition * 4], quats[refposition * 4 + 1], quats[refposition * 4 + 2], quats[refposition * 4 + 3]); // Makes a copy into voxQuat!!!!
-                      auto phase1 = static_cast<int32_t>(crystalStructures[cellPhases[refposition]]);
-                      QuatF quat2(quats[curposition * 4], quats[curposition * 4 + 1], quats[curposition * 4 + 2], quats[curposition * 4 + 3]); // Makes a copy into voxQuat!!!!
-                      auto phase2 = static_cast<int32_t>(crystalStructures[cellPhases[curposition]]);
-                      if(phase1 == phase2 && phase1 < static_cast<uint32_t>(orientationOps.size()))
-                      {
-                        OrientationF axisAngle = orientationOps[phase1]->calculateMisorientation(quat1, quat2);
-                        angle = axisAngle[3];
-                      }
-                    }
-                    if(angle > misorientationTolerance)
-                    {
-                      disorientation++;
-                    }
-                  }
-                  if(m_InputValues->useGoodVoxels)
-                  {
-                    if(maskCompare->isTrue(refposition) && !maskCompare->isTrue(curposition))
-                    {
-                      disorientation++;
-                    }
-                    if(!maskCompare->isTrue(refposition) && maskCompare->isTrue(curposition))
-                    {
-                      disorientation++;
-                    }
-                  }
-                }
+                const std::array<float32, 4> quat1 = {quats[refposition * 4], quats[refposition * 4 + 1], quats[refposition * 4 + 2], quats[refposition * 4 + 3]};
+                const std::array<float32, 4> quat2 = {quats[curposition * 4], quats[curposition * 4 + 1], quats[curposition * 4 + 2], quats[curposition * 4 + 3]};
+                misoriented = !misorientationEngines[phase1].isLessThan(quat1.data(), quat2.data(), halfAngleCosine);
               }
             }
-            disorientation = disorientation / count;
-            xIdx = k + oldxshift + halfDim0;
-            yIdx = j + oldyshift + halfDim1;
-            idx = (dims[0] * yIdx) + xIdx;
-            misorients[idx] = true;
-            if(disorientation < minDisorientation || (disorientation == minDisorientation && ((llabs(k + oldxshift) < llabs(newxshift)) || (llabs(j + oldyshift) < llabs(newyshift)))))
+            if(misoriented)
             {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              minDisorientation = disorientation;
+              disorientation++;
+            }
+          }
+          if(m_InputValues->useGoodVoxels)
+          {
+            if(maskCompare->isTrue(refposition) && !maskCompare->isTrue(curposition))
+            {
+              disorientation++;
+            }
+            if(!maskCompare->isTrue(refposition) && maskCompare->isTrue(curposition))
+            {
+              disorientation++;
             }
           }
         }
       }
     }
-    xShifts[iter] = xShifts[iter - 1] + newxshift;
-    yShifts[iter] = yShifts[iter - 1] + newyshift;
-    if(m_InputValues->writeAlignmentShifts)
+    return disorientation / count;
+  };
+
+  // Hill climbs over a 7x7 neighborhood of shifts until the best shift stops moving. With the coarse-to-fine
+  // search the climb starts on a coarse grid of shifts and samples, and each finer level starts from the
+  // shift found on the level above it.
+  auto findSliceShift = [&](int64_t slice) -> SliceShift {
+    // Marks the shifts that were already evaluated on the current level
+    std::vector<bool> misorients(dims[0] * dims[1], false);
+    int64_t newxshift = 0;
+    int64_t newyshift = 0;
+    for(int32 level = coarseLevels; level >= 0; level--)
     {
-      outFile << slice << "\t" << slice + 1 << "\t" << newxshift << "\t" << newyshift << "\t" << xShifts[iter] << "\t" << yShifts[iter] << "\n";
+      const int64_t shiftStep = int64_t{1} << level;
+      const int64_t sampleStep = 4 * shiftStep;
+      std::fill(misorients.begin(), misorients.end(), false);
+      float minDisorientation = std::numeric_limits<float>::max();
+      int64_t oldxshift = 0;
+      int64_t oldyshift = 0;
+      do
+      {
+        oldxshift = newxshift;
+        oldyshift = newyshift;
+        for(int32_t j = -3; j < 4; j++)
+        {
+          for(int32_t k = -3; k < 4; k++)
+          {
+            const int64_t xShift = oldxshift + k * shiftStep;
+            const int64_t yShift = oldyshift + j * shiftStep;
+            if(llabs(xShift) >= halfDim0 || llabs(yShift) >= halfDim1)
+            {
+              continue;
+            }
+            const int64_t idx = (dims[0] * (yShift + halfDim1)) + (xShift + halfDim0);
+            if(misorients[idx])
+            {
+              continue;
+            }
+            misorients[idx] = true;
+            const float disorientation = disorientationFraction(slice, xShift, yShift, sampleStep);
+            if(disorientation < minDisorientation || (disorientation == minDisorientation && ((llabs(xShift) < llabs(newxshift)) || (llabs(yShift) < llabs(newyshift)))))
+            {
+              newxshift = xShift;
+              newyshift = yShift;
+              minDisorientation = disorientation;
+            }
+          }
+        }
+      } while(newxshift != oldxshift || newyshift != oldyshift);
     }
+    return {newxshift, newyshift};
+  };
+
+  const IDataArray* maskArray = m_InputValues->useGoodVoxels ? m_DataStructure.getDataAs<IDataArray>(m_InputValues->goodVoxelsArrayPath) : nullptr;
+  const std::vector<SliceShift> relativeShifts = findSlicePairShifts(dims[2], findSliceShift, {&cellPhases, &quats, &crystalStructures, maskArray}, xShifts, yShifts);
+  if(getCancel())
+  {
+    return {};
   }
+
   if(m_InputValues->writeAlignmentShifts)
   {
+    for(int64_t iter = 1; iter < dims[2]; iter++)
+    {
+      int64_t slice = (dims[2] - 1) - iter;
+      outFile << slice << "\t" << slice + 1 << "\t" << relativeShifts[iter][0] << "\t" << relativeShifts[iter][1] << "\t" << xShifts[iter] << "\t" << yShifts[iter] << "\n";
+    }
     outFile.close();
   }
 
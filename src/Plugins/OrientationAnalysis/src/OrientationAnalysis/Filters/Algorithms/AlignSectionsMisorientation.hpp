@@ -21,6 +21,7 @@ struct ORIENTATIONANALYSIS_EXPORT AlignSectionsMisorientationInputValues
   bool writeAlignmentShifts;
   FileSystemPathParameter::ValueType alignmentShiftFileName;
   float32 misorientationTolerance;
+  bool useCoarseToFineSearch;
   bool useGoodVoxels;
   DataPath inputImageGeometry;
   DataPath cellDataGroupPath;
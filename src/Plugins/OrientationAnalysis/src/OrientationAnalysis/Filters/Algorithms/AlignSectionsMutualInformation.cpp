@@ -1,14 +1,19 @@
 #include "AlignSectionsMutualInformation.hpp"
 
+#include "OrientationAnalysis/Math/MisorientationEngine.hpp"
+
 #include "complex/Common/Constants.hpp"
 #include "complex/DataStructure/AttributeMatrix.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/Geometry/ImageGeom.hpp"
 #include "complex/Utilities/FilterUtilities.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 #include "complex/Utilities/StringUtilities.hpp"
 
-#include "EbsdLib/LaueOps/LaueOps.h"
-
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
 #include <vector>
 
 using namespace complex;
@@ -96,67 +101,73 @@ Result<> AlignSectionsMutualInformation::findShifts(std::vector<int64>& xShifts,
   std::vector<int32> miFeatureIds(totalPoints, 0);
   std::vector<int32> featureCounts(dims[2], 0);
 
-  std::vector<std::vector<float32>> mutualInfo12;
-  std::vector<float32> mutualInfo1;
-  std::vector<float32> mutualInfo2;
-
   // Segment each slice
   formFeaturesSections(miFeatureIds, featureCounts);
-
-  std::vector<std::vector<float32>> misorientations(dims[0]);
-  for(int64 i = 0; i < dims[0]; i++)
+  if(m_ShouldCancel)
   {
-    misorientations[i].assign(dims[1], 0.0f);
+    return {};
   }
 
-  for(int64 iter = 1; iter < dims[2]; iter++)
-  {
-    m_MessageHandler(IFilter::Message::Type::Info, fmt::format("Determining Shifts: Slice {}/{} complete", iter, dims[2]));
+  const int32 coarseLevels = m_InputValues->UseCoarseToFineSearch ? GetCoarseSearchLevels(dims[0], dims[1]) : 0;
 
-    float32 minDisorientation = std::numeric_limits<float32>::max();
-    int64 slice = (dims[2] - 1) - iter;
+  // Hill climbs over a 7x7 neighborhood of shifts until the best shift stops moving. With the coarse-to-fine
+  // search the climb starts on a coarse grid of shifts and samples, and each finer level starts from the
+  // shift found on the level above it.
+  auto findSliceShift = [&](int64 slice) -> SliceShift {
     int32 featureCount1 = featureCounts[slice];
     int32 featureCount2 = featureCounts[slice + 1];
-    mutualInfo12 = std::vector<std::vector<float32>>(featureCount1, std::vector<float32>(featureCount2, 0.0f));
-    mutualInfo1 = std::vector<float32>(featureCount1, 0.0f);
-    mutualInfo2 = std::vector<float32>(featureCount2, 0.0f);
+    std::vector<float32> mutualInfo12(static_cast<usize>(featureCount1) * featureCount2, 0.0f);
+    std::vector<float32> mutualInfo1(featureCount1, 0.0f);
+    std::vector<float32> mutualInfo2(featureCount2, 0.0f);
+
+    // Holds the value of every shift evaluated on the current level, 0 marks a shift that was not evaluated yet
+    std::vector<float32> misorientations(dims[0] * dims[1], 0.0f);
 
-    int64 oldXShift = -1;
-    int64 oldYShift = -1;
     int64 newXShift = 0;
     int64 newYShift = 0;
-    for(int64 i = 0; i < dims[0]; i++)
-    {
-      for(int64 j = 0; j < dims[1]; j++)
-      {
-        misorientations[i][j] = 0.0F;
-      }
-    }
-    while(newXShift != oldXShift || newYShift != oldYShift)
+    for(int32 level = coarseLevels; level >= 0; level--)
     {
-      oldXShift = newXShift;
-      oldYShift = newYShift;
-      for(int32 j = -3; j < 4; j++)
+      const int64 shiftStep = int64{1} << level;
+      const int64 sampleStep = 4 * shiftStep;
+      std::fill(misorientations.begin(), misorientations.end(), 0.0f);
+      float32 minDisorientation = std::numeric_limits<float32>::max();
+      int64 oldXShift = 0;
+      int64 oldYShift = 0;
+      do
       {
-        for(int32 k = -3; k < 4; k++)
+        oldXShift = newXShift;
+        oldYShift = newYShift;
+        for(int32 j = -3; j < 4; j++)
         {
-          float32 disorientation = 0.0F;
-          float32 count = 0.0F;
-          if(misorientations[k + oldXShift + dims[0] / 2][j + oldYShift + dims[1] / 2] == 0 && llabs(k + oldXShift) < (dims[0] / 2) && (j + oldYShift) < (dims[1] / 2))
+          for(int32 k = -3; k < 4; k++)
           {
-            for(int64 dim1Index = 0; dim1Index < dims[1]; dim1Index = dim1Index + 4)
+            const int64 xShift = oldXShift + k * shiftStep;
+            const int64 yShift = oldYShift + j * shiftStep;
+            if(llabs(xShift) >= (dims[0] / 2) || llabs(yShift) >= (dims[1] / 2))
             {
-              for(int64 dim0Index = 0; dim0Index < dims[0]; dim0Index = dim0Index + 4)
+              continue;
+            }
+            float32& misorientation = misorientations[(xShift + dims[0] / 2) * dims[1] + (yShift + dims[1] / 2)];
+            if(misorientation != 0)
+            {
+              continue;
+            }
+
+            float32 disorientation = 0.0F;
+            float32 count = 0.0F;
+            for(int64 dim1Index = 0; dim1Index < dims[1]; dim1Index = dim1Index + sampleStep)
+            {
+              for(int64 dim0Index = 0; dim0Index < dims[0]; dim0Index = dim0Index + sampleStep)
               {
-                if((dim1Index + j + oldYShift) >= 0 && (dim1Index + j + oldYShift) < dims[1] && (dim0Index + k + oldXShift) >= 0 && (dim0Index + k + oldXShift) < dims[0])
+                if((dim1Index + yShift) >= 0 && (dim1Index + yShift) < dims[1] && (dim0Index + xShift) >= 0 && (dim0Index + xShift) < dims[0])
                 {
                   int64 refPosition = ((slice + 1) * dims[0] * dims[1]) + (dim1Index * dims[0]) + dim0Index;
-                  int64 curPosition = (slice * dims[0] * dims[1]) + ((dim1Index + j + oldYShift) * dims[0]) + (dim0Index + k + oldXShift);
+                  int64 curPosition = (slice * dims[0] * dims[1]) + ((dim1Index + yShift) * dims[0]) + (dim0Index + xShift);
                   int32 refGNum = miFeatureIds[refPosition];
                   int32 curGNum = miFeatureIds[curPosition];
                   if(curGNum >= 0 && refGNum >= 0)
                   {
-                    mutualInfo12[curGNum][refGNum]++;
+                    mutualInfo12[curGNum * featureCount2 + refGNum]++;
                     mutualInfo1[curGNum]++;
                     mutualInfo2[refGNum]++;
                     count++;
@@ -164,7 +175,7 @@ Result<> AlignSectionsMutualInformation::findShifts(std::vector<int64>& xShifts,
                 }
                 else
                 {
-                  mutualInfo12[0][0]++;
+                  mutualInfo12[0]++;
                   mutualInfo1[0]++;
                   mutualInfo2[0]++;
                 }
@@ -182,50 +193,52 @@ Result<> AlignSectionsMutualInformation::findShifts(std::vector<int64>& xShifts,
             {
               for(int32 featureCount2Index = 0; featureCount2Index < featureCount2; featureCount2Index++)
               {
-                mutualInfo12[featureCount1Index][featureCount2Index] = mutualInfo12[featureCount1Index][featureCount2Index] / count;
+                float32& jointInfo = mutualInfo12[featureCount1Index * featureCount2 + featureCount2Index];
+                jointInfo = jointInfo / count;
 
                 float32 value = 0.0f;
                 if(mutualInfo1[featureCount1Index] > 0 && mutualInfo2[featureCount2Index] > 0)
                 {
-                  value = (mutualInfo12[featureCount1Index][featureCount2Index] / (mutualInfo1[featureCount1Index] * mutualInfo2[featureCount2Index]));
+                  value = (jointInfo / (mutualInfo1[featureCount1Index] * mutualInfo2[featureCount2Index]));
                 }
                 if(value != 0)
                 {
-                  disorientation = disorientation + (mutualInfo12[featureCount1Index][featureCount2Index] * logf(value));
+                  disorientation = disorientation + (jointInfo * logf(value));
                 }
               }
             }
-            for(int32 featureCount1Index = 0; featureCount1Index < featureCount1; featureCount1Index++)
-            {
-              for(int32 featureCount2Index = 0; featureCount2Index < featureCount2; featureCount2Index++)
-              {
-                mutualInfo12[featureCount1Index][featureCount2Index] = 0.0f;
-                mutualInfo1[featureCount1Index] = 0.0f;
-                mutualInfo2[featureCount2Index] = 0.0f;
-              }
-            }
+            std::fill(mutualInfo12.begin(), mutualInfo12.end(), 0.0f);
+            std::fill(mutualInfo1.begin(), mutualInfo1.end(), 0.0f);
+            std::fill(mutualInfo2.begin(), mutualInfo2.end(), 0.0f);
+
             disorientation = 1.0f / disorientation;
-            misorientations[k + oldXShift + dims[0] / 2][j + oldYShift + dims[1] / 2] = disorientation;
+            misorientation = disorientation;
             if(disorientation < minDisorientation)
             {
-              newXShift = k + oldXShift;
-              newYShift = j + oldYShift;
+              newXShift = xShift;
+              newYShift = yShift;
               minDisorientation = disorientation;
             }
           }
         }
-      }
-    }
-    xShifts[iter] = xShifts[iter - 1] + newXShift;
-    yShifts[iter] = yShifts[iter - 1] + newYShift;
-    if(m_InputValues->WriteAlignmentShifts)
-    {
-      outFile << slice << "\t" << slice + 1 << "\t" << newXShift << "\t" << newYShift << "\t" << xShifts[iter] << "\t" << yShifts[iter] << "\n";
+      } while(newXShift != oldXShift || newYShift != oldYShift);
     }
+    return {newXShift, newYShift};
+  };
+
+  const std::vector<SliceShift> relativeShifts = findSlicePairShifts(dims[2], findSliceShift, {}, xShifts, yShifts);
+  if(m_ShouldCancel)
+  {
+    return {};
   }
 
   if(m_InputValues->WriteAlignmentShifts)
   {
+    for(int64 iter = 1; iter < dims[2]; iter++)
+    {
+      int64 slice = (dims[2] - 1) - iter;
+      outFile << slice << "\t" << slice + 1 << "\t" << relativeShifts[iter][0] << "\t" << relativeShifts[iter][1] << "\t" << xShifts[iter] << "\t" << yShifts[iter] << "\n";
+    }
     outFile.close();
   }
 
@@ -244,7 +257,7 @@ void AlignSectionsMutualInformation::formFeaturesSections(std::vector<int32>& mi
       static_cast<int64>(udims[2]),
   };
 
-  auto orientationOps = LaueOps::GetAllOrientationOps();
+  const std::vector<MisorientationEngine> misorientationEngines = MisorientationEngine::CreateAll();
 
   Float32Array& quats = m_DataStructure.getDataRefAs<Float32Array>(m_InputValues->QuatsArrayPath);
   BoolArray* goodVoxelsPtr = m_DataStructure.getDataAs<BoolArray>(m_InputValues->MaskArrayPath);
@@ -254,112 +267,125 @@ void AlignSectionsMutualInformation::formFeaturesSections(std::vector<int32>& mi
   size_t initialVoxelsListSize = 1000;
 
   float misorientationTolerance = m_InputValues->MisorientationTolerance * complex::Constants::k_PiOver180F;
+  const float64 halfAngleCosine = MisorientationEngine::HalfAngleCosine(misorientationTolerance);
 
   featureCounts.resize(dims[2]);
 
-  std::vector<int64_t> voxelList(initialVoxelsListSize, -1);
   int64_t neighborPoints[4] = {-dims[0], -1, 1, dims[0]};
 
-  for(int64_t slice = 0; slice < dims[2]; slice++)
-  {
-    m_MessageHandler(IFilter::Message::Type::Info, fmt::format("Identifying Features: Slice {}/{} complete", slice, dims[2]));
-
-    int64 startPoint = slice * dims[0] * dims[1];
-    int64 endPoint = (slice + 1) * dims[0] * dims[1];
-    int64 currentStartPoint = startPoint;
-
-    int32 featureCount = 1;
-    bool noSeeds = false;
-    while(!noSeeds)
+  // Features are grown within a single slice, so the slices are segmented concurrently
+  std::atomic<usize> completed = 0;
+  auto segmentSlices = [&](const Range& range) {
+    std::vector<int64_t> voxelList(initialVoxelsListSize, -1);
+    for(auto slice = static_cast<int64_t>(range.min()); slice < static_cast<int64_t>(range.max()); slice++)
     {
-      int64 seed = -1;
+      if(m_ShouldCancel)
+      {
+        return;
+      }
 
-      for(int64 point = currentStartPoint; point < endPoint; point++)
+      int64 startPoint = slice * dims[0] * dims[1];
+      int64 endPoint = (slice + 1) * dims[0] * dims[1];
+      int64 currentStartPoint = startPoint;
+
+      int32 featureCount = 1;
+      bool noSeeds = false;
+      while(!noSeeds)
       {
-        if((!m_InputValues->UseMask || (goodVoxelsPtr != nullptr && (*goodVoxelsPtr)[point])) && miFeatureIds[point] == 0 && m_CellPhases[point] > 0)
+        int64 seed = -1;
+
+        for(int64 point = currentStartPoint; point < endPoint; point++)
         {
-          seed = point;
-          currentStartPoint = point;
+          if((!m_InputValues->UseMask || (goodVoxelsPtr != nullptr && (*goodVoxelsPtr)[point])) && miFeatureIds[point] == 0 && m_CellPhases[point] > 0)
+          {
+            seed = point;
+            currentStartPoint = point;
+          }
+          if(seed > -1)
+          {
+            break;
+          }
         }
-        if(seed > -1)
+
+        if(seed == -1)
         {
-          break;
+          noSeeds = true;
         }
-      }
-
-      if(seed == -1)
-      {
-        noSeeds = true;
-      }
-      if(seed >= 0)
-      {
-        usize size = 0;
-        miFeatureIds[seed] = featureCount;
-        voxelList[size] = seed;
-        size++;
-        for(size_t j = 0; j < size; ++j)
+        if(seed >= 0)
         {
-          int64_t currentpoint = voxelList[j];
-          int64 col = currentpoint % dims[0];
-          int64 row = (currentpoint / dims[0]) % dims[1];
-
-          auto q1TupleIndex = currentpoint * 4;
-          QuatF quat1(quats[q1TupleIndex], quats[q1TupleIndex + 1], quats[q1TupleIndex + 2], quats[q1TupleIndex + 3]);
-          uint32_t phase1 = m_CrystalStructures[m_CellPhases[currentpoint]];
-          for(int32_t i = 0; i < 4; i++)
+          usize size = 0;
+          miFeatureIds[seed] = featureCount;
+          voxelList[size] = seed;
+          size++;
+          for(size_t j = 0; j < size; ++j)
           {
-            int64 neighbor = currentpoint + neighborPoints[i];
-            if((i == 0) && row == 0)
-            {
-              continue;
-            }
-            if((i == 3) && row == (dims[1] - 1))
+            int64_t currentpoint = voxelList[j];
+            int64 col = currentpoint % dims[0];
+            int64 row = (currentpoint / dims[0]) % dims[1];
+
+            auto q1TupleIndex = currentpoint * 4;
+            const std::array<float32, 4> quat1 = {quats[q1TupleIndex], quats[q1TupleIndex + 1], quats[q1TupleIndex + 2], quats[q1TupleIndex + 3]};
+            uint32_t phase1 = m_CrystalStructures[m_CellPhases[currentpoint]];
+            for(int32_t i = 0; i < 4; i++)
             {
-              continue;
-            }
-            if((i == 1) && col == 0)
-            {
-              continue;
-            }
-            if((i == 2) && col == (dims[0] - 1))
-            {
-              continue;
-            }
-            if(miFeatureIds[neighbor] <= 0 && m_CellPhases[neighbor] > 0)
-            {
-              float32 angle = std::numeric_limits<float>::max();
-              auto q2TupleIndex = neighbor * 4;
-              QuatF quat2(quats[q2TupleIndex], quats[q2TupleIndex + 1], quats[q2TupleIndex + 2], quats[q2TupleIndex + 3]);
-              uint32_t phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-
-              if(phase1 == phase2)
+              int64 neighbor = currentpoint + neighborPoints[i];
+              if((i == 0) && row == 0)
+              {
+                continue;
+              }
+              if((i == 3) && row == (dims[1] - 1))
+              {
+                continue;
+              }
+              if((i == 1) && col == 0)
+              {
+                continue;
+              }
+              if((i == 2) && col == (dims[0] - 1))
               {
-                OrientationF axisAngle = orientationOps[phase1]->calculateMisorientation(quat1, quat2);
-                angle = axisAngle[3];
+                continue;
               }
-              if(angle < misorientationTolerance)
+              if(miFeatureIds[neighbor] <= 0 && m_CellPhases[neighbor] > 0)
               {
-                miFeatureIds[neighbor] = featureCount;
-                voxelList[size] = neighbor;
-                size++;
-                if(std::vector<int64_t>::size_type(size) >= voxelList.size())
+                bool similar = false;
+                auto q2TupleIndex = neighbor * 4;
+                const std::array<float32, 4> quat2 = {quats[q2TupleIndex], quats[q2TupleIndex + 1], quats[q2TupleIndex + 2], quats[q2TupleIndex + 3]};
+                uint32_t phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
+
+                if(phase1 == phase2 && phase1 < misorientationEngines.size())
                 {
-                  size = voxelList.size();
-                  voxelList.resize(size + initialVoxelsListSize);
-                  for(std::vector<int64_t>::size_type v = size; v < voxelList.size(); ++v)
+                  similar = misorientationEngines[phase1].isLessThan(quat1.data(), quat2.data(), halfAngleCosine);
+                }
+                if(similar)
+                {
+                  miFeatureIds[neighbor] = featureCount;
+                  voxelList[size] = neighbor;
+                  size++;
+                  if(std::vector<int64_t>::size_type(size) >= voxelList.size())
                   {
-                    voxelList[v] = -1;
+                    size = voxelList.size();
+                    voxelList.resize(size + initialVoxelsListSize);
+                    for(std::vector<int64_t>::size_type v = size; v < voxelList.size(); ++v)
+                    {
+                      voxelList[v] = -1;
+                    }
                   }
                 }
               }
             }
           }
+          voxelList.erase(std::remove(voxelList.begin(), voxelList.end(), -1), voxelList.end());
+          featureCount++;
+          voxelList.assign(initialVoxelsListSize, -1);
         }
-        voxelList.erase(std::remove(voxelList.begin(), voxelList.end(), -1), voxelList.end());
-        featureCount++;
-        voxelList.assign(initialVoxelsListSize, -1);
       }
+      featureCounts[slice] = featureCount;
+      updateProgress(fmt::format("Identifying Features: Slice {}/{} complete", ++completed, dims[2]));
     }
-    featureCounts[slice] = featureCount;
-  }
+  };
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, static_cast<usize>(dims[2]));
+  dataAlg.requireArraysInMemory({&quats, goodVoxelsPtr, &m_CellPhases, &m_CrystalStructures});
+  dataAlg.execute(segmentSlices);
 }
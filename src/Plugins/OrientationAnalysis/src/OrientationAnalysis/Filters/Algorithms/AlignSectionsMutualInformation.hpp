@@ -18,6 +18,7 @@ struct ORIENTATIONANALYSIS_EXPORT AlignSectionsMutualInformationInputValues
   bool WriteAlignmentShifts;
   FileSystemPathParameter::ValueType AlignmentShiftFileName;
   float32 MisorientationTolerance;
+  bool UseCoarseToFineSearch;
   bool UseMask;
   DataPath ImageGeometryPath;
   DataPath QuatsArrayPath;
@@ -1,13 +1,14 @@
 #include "BadDataNeighborOrientationCheck.hpp"
 
+#include "OrientationAnalysis/Math/MisorientationEngine.hpp"
+
 #include "complex/Common/Numbers.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/DataStructure/Geometry/ImageGeom.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
 
-#include "EbsdLib/Core/Orientation.hpp"
-#include "EbsdLib/LaueOps/LaueOps.h"
+#include <array>
 
 using namespace complex;
 
@@ -72,11 +73,12 @@ Result<> BadDataNeighborOrientationCheck::operator()()
   neighpoints[4] = static_cast<int64_t>(dims[0]);
   neighpoints[5] = static_cast<int64_t>(dims[0] * dims[1]);
 
-  float w = 10000.0f;
+  bool similar = false;
 
   uint32_t phase1 = 0;
 
-  std::vector<LaueOps::Pointer> orientationOps = LaueOps::GetAllOrientationOps();
+  const std::vector<MisorientationEngine> misorientationEngines = MisorientationEngine::CreateAll();
+  const float64 halfAngleCosine = MisorientationEngine::HalfAngleCosine(misorientationTolerance);
 
   std::vector<int32_t> neighborCount(totalPoints, 0);
 
@@ -129,15 +131,14 @@ Result<> BadDataNeighborOrientationCheck::operator()()
         if(good == 1 && maskCompare->isTrue(neighbor))
         {
           phase1 = crystalStructures[cellPhases[i]];
-          QuatF quat1(quats[i * 4], quats[i * 4 + 1], quats[i * 4 + 2], quats[i * 4 + 3]);
-          QuatF quat2(quats[neighbor * 4], quats[neighbor * 4 + 1], quats[neighbor * 4 + 2], quats[neighbor * 4 + 3]);
+          const std::array<float32, 4> quat1 = {quats[i * 4], quats[i * 4 + 1], quats[i * 4 + 2], quats[i * 4 + 3]};
+          const std::array<float32, 4> quat2 = {quats[neighbor * 4], quats[neighbor * 4 + 1], quats[neighbor * 4 + 2], quats[neighbor * 4 + 3]};
 
           if(cellPhases[i] == cellPhases[neighbor] && cellPhases[i] > 0)
           {
-            OrientationD axisAngle = orientationOps[phase1]->calculateMisorientation(quat1, quat2);
-            w = axisAngle[3];
+            similar = misorientationEngines[phase1].isLessThan(quat1.data(), quat2.data(), halfAngleCosine);
           }
-          if(w < misorientationTolerance)
+          if(similar)
           {
             neighborCount[i]++;
           }
@@ -208,15 +209,14 @@ Result<> BadDataNeighborOrientationCheck::operator()()
             }
             if(good == 1 && !maskCompare->isTrue(neighbor))
             {
-              QuatF quat1(quats[i * 4], quats[i * 4 + 1], quats[i * 4 + 2], quats[i * 4 + 3]);
-              QuatF quat2(quats[neighbor * 4], quats[neighbor * 4 + 1], quats[neighbor * 4 + 2], quats[neighbor * 4 + 3]);
+              const std::array<float32, 4> quat1 = {quats[i * 4], quats[i * 4 + 1], quats[i * 4 + 2], quats[i * 4 + 3]};
+              const std::array<float32, 4> quat2 = {quats[neighbor * 4], quats[neighbor * 4 + 1], quats[neighbor * 4 + 2], quats[neighbor * 4 + 3]};
 
               if(cellPhases[i] == cellPhases[neighbor] && cellPhases[i] > 0)
               {
-                OrientationD axisAngle = orientationOps[phase1]->calculateMisorientation(quat1, quat2);
-                w = axisAngle[3];
+                similar = misorientationEngines[phase1].isLessThan(quat1.data(), quat2.data(), halfAngleCosine);
               }
-              if(w < misorientationTolerance)
+              if(similar)
               {
                 neighborCount[neighbor]++;
               }
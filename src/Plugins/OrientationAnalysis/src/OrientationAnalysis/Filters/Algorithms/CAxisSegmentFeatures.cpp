@@ -12,6 +12,69 @@
 using namespace complex;
 using namespace complex::OrientationUtilities;
 
+namespace
+{
+/**
+ * @brief The CAxisGroupingFunctor class groups neighboring voxels of the same phase whose c-axes are
+ * aligned within the tolerance. It does not modify any data so it can be used by both the serial flood
+ * fill and SegmentFeatures::executeParallel().
+ */
+class CAxisGroupingFunctor
+{
+public:
+  CAxisGroupingFunctor(const Float32Array& quats, const Int32Array& cellPhases, const MaskCompare* goodVoxels, float32 misorientationTolerance)
+  : m_Quats(quats)
+  , m_CellPhases(cellPhases)
+  , m_GoodVoxels(goodVoxels)
+  , m_MisorientationTolerance(misorientationTolerance)
+  {
+  }
+
+  bool isValid(int64 point) const
+  {
+    return (m_GoodVoxels == nullptr || m_GoodVoxels->isTrue(point)) && m_CellPhases[point] > 0;
+  }
+
+  bool areGrouped(int64 referencePoint, int64 neighborPoint) const
+  {
+    if(m_CellPhases[referencePoint] != m_CellPhases[neighborPoint])
+    {
+      return false;
+    }
+
+    const Eigen::Vector3f cAxis{0.0f, 0.0f, 1.0f};
+    const QuatF q1(m_Quats[referencePoint * 4], m_Quats[referencePoint * 4 + 1], m_Quats[referencePoint * 4 + 2], m_Quats[referencePoint * 4 + 3]);
+    const QuatF q2(m_Quats[neighborPoint * 4 + 0], m_Quats[neighborPoint * 4 + 1], m_Quats[neighborPoint * 4 + 2], m_Quats[neighborPoint * 4 + 3]);
+
+    const OrientationF oMatrix1 = OrientationTransformation::qu2om<QuatF, Orientation<float32>>(q1);
+    const OrientationF oMatrix2 = OrientationTransformation::qu2om<QuatF, Orientation<float32>>(q2);
+
+    // Convert the quaternion matrices to transposed g matrices so when caxis is multiplied by it, it will give the sample direction that the caxis is along
+    const Matrix3fR g1T = OrientationMatrixToGMatrixTranspose(oMatrix1);
+    const Matrix3fR g2T = OrientationMatrixToGMatrixTranspose(oMatrix2);
+
+    Eigen::Vector3f c1 = g1T * cAxis;
+    Eigen::Vector3f c2 = g2T * cAxis;
+
+    // normalize so that the dot product can be taken below without
+    // dividing by the magnitudes (they would be 1)
+    c1.normalize();
+    c2.normalize();
+
+    // Validate value of w falls between [-1, 1] to ensure that acos returns a valid value
+    float32 w = std::clamp(((c1[0] * c2[0]) + (c1[1] * c2[1]) + (c1[2] * c2[2])), -1.0F, 1.0F);
+    w = acosf(w);
+    return w <= m_MisorientationTolerance || (Constants::k_PiD - w) <= m_MisorientationTolerance;
+  }
+
+private:
+  const Float32Array& m_Quats;
+  const Int32Array& m_CellPhases;
+  const MaskCompare* m_GoodVoxels = nullptr;
+  float32 m_MisorientationTolerance = 0.0f;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 CAxisSegmentFeatures::CAxisSegmentFeatures(DataStructure& dataStructure, const IFilter::MessageHandler& mesgHandler, const std::atomic_bool& shouldCancel, CAxisSegmentFeaturesInputValues* inputValues)
 : SegmentFeatures(dataStructure, shouldCancel, mesgHandler)
@@ -69,7 +132,23 @@ Result<> CAxisSegmentFeatures::operator()()
   Int64Distribution distribution;
   initializeStaticVoxelSeedGenerator(distribution, rangeMin, rangeMax);
 
-  execute(imageGeometry);
+  const auto* maskArray = m_InputValues->UseMask ? m_DataStructure.getDataAs<IDataArray>(m_InputValues->MaskArrayPath) : nullptr;
+  if(IParallelAlgorithm::CheckArraysInMemory({m_QuatsArray, m_CellPhases, m_FeatureIdsArray, maskArray}))
+  {
+    const CAxisGroupingFunctor grouping(*m_QuatsArray, *m_CellPhases, m_InputValues->UseMask ? m_GoodVoxelsArray.get() : nullptr, m_InputValues->MisorientationTolerance);
+    auto featureCountResult = executeParallel(imageGeometry, m_FeatureIdsArray->getDataStoreRef(), grouping);
+    if(featureCountResult.invalid())
+    {
+      return ConvertResult(std::move(featureCountResult));
+    }
+    auto& cellFeatureAM = m_DataStructure.getDataRefAs<AttributeMatrix>(m_InputValues->CellFeatureAttributeMatrixName);
+    cellFeatureAM.resizeTuples({static_cast<usize>(featureCountResult.value()) + 1}); // This will resize the active array
+    active->fill(1);
+  }
+  else
+  {
+    execute(imageGeometry);
+  }
 
   const auto totalFeatures = static_cast<int64>(active->getNumberOfTuples());
   if(totalFeatures < 2)
@@ -127,55 +206,17 @@ int64 CAxisSegmentFeatures::getSeed(int32 gnum, int64 nextSeed) const
 // -----------------------------------------------------------------------------
 bool CAxisSegmentFeatures::determineGrouping(int64 referencepoint, int64 neighborpoint, int32 gnum) const
 {
-  bool group = false;
-  float32 w = std::numeric_limits<float32>::max();
-
-  Matrix3fR g1T;
-  g1T.fill(0.0f);
-  Matrix3fR g2T;
-  g2T.fill(0.0f);
-  const Eigen::Vector3f cAxis{0.0f, 0.0f, 1.0f};
-  Eigen::Vector3f c1{0.0f, 0.0f, 0.0f};
-  Eigen::Vector3f c2{0.0f, 0.0f, 0.0f};
-  Float32Array& currentQuat = *m_QuatsArray;
   Int32Array& featureIds = *m_FeatureIdsArray;
-  Int32Array& cellPhases = *m_CellPhases;
-  bool neighborPointIsGood = false;
-  if(m_GoodVoxelsArray != nullptr)
+  if(featureIds[neighborpoint] != 0 || (m_InputValues->UseMask && !m_GoodVoxelsArray->isTrue(neighborpoint)))
   {
-    neighborPointIsGood = m_GoodVoxelsArray->isTrue(neighborpoint);
+    return false;
   }
-  if(featureIds[neighborpoint] == 0 && (!m_InputValues->UseMask || neighborPointIsGood))
-  {
-    const QuatF q1(currentQuat[referencepoint * 4], currentQuat[referencepoint * 4 + 1], currentQuat[referencepoint * 4 + 2], currentQuat[referencepoint * 4 + 3]);
-    const QuatF q2(currentQuat[neighborpoint * 4 + 0], currentQuat[neighborpoint * 4 + 1], currentQuat[neighborpoint * 4 + 2], currentQuat[neighborpoint * 4 + 3]);
 
-    if(cellPhases[referencepoint] == cellPhases[neighborpoint])
-    {
-      const OrientationF oMatrix1 = OrientationTransformation::qu2om<QuatF, Orientation<float32>>(q1);
-      const OrientationF oMatrix2 = OrientationTransformation::qu2om<QuatF, Orientation<float32>>(q2);
-
-      // Convert the quaternion matrices to transposed g matrices so when caxis is multiplied by it, it will give the sample direction that the caxis is along
-      g1T = OrientationMatrixToGMatrixTranspose(oMatrix1);
-      g2T = OrientationMatrixToGMatrixTranspose(oMatrix2);
-
-      c1 = g1T * cAxis;
-      c2 = g2T * cAxis;
-
-      // normalize so that the dot product can be taken below without
-      // dividing by the magnitudes (they would be 1)
-      c1.normalize();
-      c2.normalize();
-
-      // Validate value of w falls between [-1, 1] to ensure that acos returns a valid value
-      w = std::clamp(((c1[0] * c2[0]) + (c1[1] * c2[1]) + (c1[2] * c2[2])), -1.0F, 1.0F);
-      w = acosf(w);
-      if(w <= m_InputValues->MisorientationTolerance || (Constants::k_PiD - w) <= m_InputValues->MisorientationTolerance)
-      {
-        group = true;
-        featureIds[neighborpoint] = gnum;
-      }
-    }
+  const CAxisGroupingFunctor grouping(*m_QuatsArray, *m_CellPhases, m_InputValues->UseMask ? m_GoodVoxelsArray.get() : nullptr, m_InputValues->MisorientationTolerance);
+  if(grouping.areGrouped(referencepoint, neighborpoint))
+  {
+    featureIds[neighborpoint] = gnum;
+    return true;
   }
-  return group;
+  return false;
 }
@@ -3,16 +3,72 @@
 #include "complex/DataStructure/DataStore.hpp"
 #include "complex/DataStructure/Geometry/IGridGeometry.hpp"
 
+#include <array>
 #include <chrono>
 
 using namespace complex;
 
+namespace
+{
+/**
+ * @brief The EBSDGroupingFunctor class groups neighboring voxels of the same phase whose misorientation
+ * is below the tolerance. It does not modify any data so it can be used by both the serial flood fill
+ * and SegmentFeatures::executeParallel().
+ */
+class EBSDGroupingFunctor
+{
+public:
+  EBSDGroupingFunctor(const Float32Array& quats, const Int32Array& cellPhases, const UInt32Array& crystalStructures, const MaskCompare* goodVoxels,
+                      const std::vector<MisorientationEngine>& misorientationEngines, float32 misorientationTolerance)
+  : m_Quats(quats)
+  , m_CellPhases(cellPhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_GoodVoxels(goodVoxels)
+  , m_MisorientationEngines(misorientationEngines)
+  , m_HalfAngleCosine(MisorientationEngine::HalfAngleCosine(misorientationTolerance))
+  {
+  }
+
+  bool isValid(int64 point) const
+  {
+    return (m_GoodVoxels == nullptr || m_GoodVoxels->isTrue(point)) && m_CellPhases[point] > 0;
+  }
+
+  bool areGrouped(int64 referencePoint, int64 neighborPoint) const
+  {
+    const int32 referencePhase = m_CellPhases[referencePoint];
+    if(referencePhase != m_CellPhases[neighborPoint])
+    {
+      return false;
+    }
+    // If the crystal structure is unknown (999) we bail out now.
+    const uint32 crystalStructure = m_CrystalStructures[referencePhase];
+    if(crystalStructure >= m_MisorientationEngines.size())
+    {
+      return false;
+    }
+
+    const std::array<float32, 4> q1 = {m_Quats[referencePoint * 4], m_Quats[referencePoint * 4 + 1], m_Quats[referencePoint * 4 + 2], m_Quats[referencePoint * 4 + 3]};
+    const std::array<float32, 4> q2 = {m_Quats[neighborPoint * 4 + 0], m_Quats[neighborPoint * 4 + 1], m_Quats[neighborPoint * 4 + 2], m_Quats[neighborPoint * 4 + 3]};
+    return m_MisorientationEngines[crystalStructure].isLessThan(q1.data(), q2.data(), m_HalfAngleCosine);
+  }
+
+private:
+  const Float32Array& m_Quats;
+  const Int32Array& m_CellPhases;
+  const UInt32Array& m_CrystalStructures;
+  const MaskCompare* m_GoodVoxels = nullptr;
+  const std::vector<MisorientationEngine>& m_MisorientationEngines;
+  float64 m_HalfAngleCosine = 1.0;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 EBSDSegmentFeatures::EBSDSegmentFeatures(DataStructure& dataStructure, const IFilter::MessageHandler& mesgHandler, const std::atomic_bool& shouldCancel, EBSDSegmentFeaturesInputValues* inputValues)
 : SegmentFeatures(dataStructure, shouldCancel, mesgHandler)
 , m_InputValues(inputValues)
 {
-  m_OrientationOps = LaueOps::GetAllOrientationOps();
+  m_MisorientationEngines = MisorientationEngine::CreateAll();
 }
 
 // -----------------------------------------------------------------------------
@@ -43,7 +99,28 @@ Result<> EBSDSegmentFeatures::operator()()
   m_FeatureIdsArray = m_DataStructure.getDataAs<Int32Array>(m_InputValues->featureIdsArrayPath);
   m_FeatureIdsArray->fill(0); // initialize the output array with zeros
 
-  execute(gridGeom);
+  const auto* goodVoxelsArray = m_InputValues->useGoodVoxels ? m_DataStructure.getDataAs<IDataArray>(m_InputValues->goodVoxelsArrayPath) : nullptr;
+  if(IParallelAlgorithm::CheckArraysInMemory({m_QuatsArray, m_CellPhases, m_FeatureIdsArray, goodVoxelsArray}))
+  {
+    const EBSDGroupingFunctor grouping(*m_QuatsArray, *m_CellPhases, *m_CrystalStructures, m_GoodVoxelsArray.get(), m_MisorientationEngines, m_InputValues->misorientationTolerance);
+    auto featureCountResult = executeParallel(gridGeom, m_FeatureIdsArray->getDataStoreRef(), grouping);
+    if(featureCountResult.invalid())
+    {
+      return ConvertResult(std::move(featureCountResult));
+    }
+    const auto featureCount = static_cast<usize>(featureCountResult.value());
+    auto& cellFeatureAM = m_DataStructure.getDataRefAs<AttributeMatrix>(m_InputValues->cellFeatureAttributeMatrixPath);
+    cellFeatureAM.resizeTuples({featureCount + 1}); // This will resize the actives array
+    auto& activeArray = m_DataStructure.getDataRefAs<UInt8Array>(m_InputValues->activeArrayPath);
+    for(usize featureId = 1; featureId <= featureCount; featureId++)
+    {
+      activeArray[featureId] = 1;
+    }
+  }
+  else
+  {
+    execute(gridGeom);
+  }
 
   IDataArray* activeArray = m_DataStructure.getDataAs<IDataArray>(m_InputValues->activeArrayPath);
   auto totalFeatures = activeArray->getNumberOfTuples();
@@ -115,44 +192,17 @@ int64_t EBSDSegmentFeatures::getSeed(int32 gnum, int64 nextSeed) const
 // -----------------------------------------------------------------------------
 bool EBSDSegmentFeatures::determineGrouping(int64 referencepoint, int64 neighborpoint, int32 gnum) const
 {
-  bool group = false;
-
-  // Get the phases for each voxel
-  complex::AbstractDataStore<int32>* cellPhases = m_CellPhases->getDataStore();
-
-  int32_t phase1 = (*m_CrystalStructures)[(*cellPhases)[referencepoint]];
-  int32_t phase2 = (*m_CrystalStructures)[(*cellPhases)[neighborpoint]];
-  // If either of the phases is 999 then we bail out now.
-  if(phase1 >= m_OrientationOps.size() || phase2 >= m_OrientationOps.size())
-  {
-    return group;
-  }
-  Float32Array& currentQuatPtr = *m_QuatsArray;
   Int32Array& featureIds = *m_FeatureIdsArray;
-
-  bool neighborPointIsGood = false;
-  if(m_GoodVoxelsArray != nullptr)
+  if(featureIds[neighborpoint] != 0 || (m_GoodVoxelsArray != nullptr && !m_GoodVoxelsArray->isTrue(neighborpoint)))
   {
-    neighborPointIsGood = m_GoodVoxelsArray->isTrue(neighborpoint);
+    return false;
   }
 
-  if(featureIds[neighborpoint] == 0 && (m_GoodVoxelsArray == nullptr || neighborPointIsGood))
+  const EBSDGroupingFunctor grouping(*m_QuatsArray, *m_CellPhases, *m_CrystalStructures, m_GoodVoxelsArray.get(), m_MisorientationEngines, m_InputValues->misorientationTolerance);
+  if(grouping.areGrouped(referencepoint, neighborpoint))
   {
-    float w = std::numeric_limits<float>::max();
-    QuatF q1(currentQuatPtr[referencepoint * 4], currentQuatPtr[referencepoint * 4 + 1], currentQuatPtr[referencepoint * 4 + 2], currentQuatPtr[referencepoint * 4 + 3]);
-    QuatF q2(currentQuatPtr[neighborpoint * 4 + 0], currentQuatPtr[neighborpoint * 4 + 1], currentQuatPtr[neighborpoint * 4 + 2], currentQuatPtr[neighborpoint * 4 + 3]);
-
-    if((*cellPhases)[referencepoint] == (*cellPhases)[neighborpoint])
-    {
-      OrientationF axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-      w = axisAngle[3];
-    }
-    if(w < m_InputValues->misorientationTolerance)
-    {
-      group = true;
-      featureIds[neighborpoint] = gnum;
-    }
+    featureIds[neighborpoint] = gnum;
+    return true;
   }
-
-  return group;
+  return false;
 }
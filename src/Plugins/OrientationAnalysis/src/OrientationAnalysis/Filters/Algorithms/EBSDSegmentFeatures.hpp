@@ -1,5 +1,6 @@
 #pragma once
 
+#include "OrientationAnalysis/Math/MisorientationEngine.hpp"
 #include "OrientationAnalysis/OrientationAnalysis_export.hpp"
 
 #include "complex/DataStructure/DataArray.hpp"
@@ -84,7 +85,7 @@ private:
 
   FeatureIdsArrayType* m_FeatureIdsArray = nullptr;
 
-  std::vector<LaueOps::Pointer> m_OrientationOps;
+  std::vector<MisorientationEngine> m_MisorientationEngines;
 };
 
 } // namespace complex
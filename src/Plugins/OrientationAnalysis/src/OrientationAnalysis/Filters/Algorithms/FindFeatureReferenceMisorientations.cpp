@@ -1,12 +1,12 @@
 #include "FindFeatureReferenceMisorientations.hpp"
 
+#include "OrientationAnalysis/Math/MisorientationEngine.hpp"
+
 #include "complex/Common/Numbers.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
 
-#include "EbsdLib/LaueOps/LaueOps.h"
-
 using namespace complex;
 
 // -----------------------------------------------------------------------------
@@ -51,7 +51,7 @@ Result<> FindFeatureReferenceMisorientations::operator()()
     return validateNumFeatResult;
   }
 
-  std::vector<LaueOps::Pointer> m_OrientationOps = LaueOps::GetAllOrientationOps();
+  const std::vector<MisorientationEngine> misorientationEngines = MisorientationEngine::CreateAll();
 
   size_t totalPoints = featureIds.getNumberOfTuples();
   size_t totalFeatures = avgQuats.getNumberOfTuples();
@@ -94,9 +94,9 @@ Result<> FindFeatureReferenceMisorientations::operator()()
         q2 = QuatF(avgQuats[centerGNum * 4 + 0], avgQuats[centerGNum * 4 + 1], avgQuats[centerGNum * 4 + 2], avgQuats[centerGNum * 4 + 3]);
       }
 
-      OrientationD axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
+      const float64 angle = misorientationEngines[phase1].angle(q1, q2);
 
-      featureReferenceMisorientations[point] = static_cast<float>((180.0 / complex::numbers::pi) * axisAngle[3]); // convert to degrees
+      featureReferenceMisorientations[point] = static_cast<float>((180.0 / complex::numbers::pi) * angle); // convert to degrees
       int32_t idx = featureIds[point] * 2;
       avgMiso[idx + 0]++;
       avgMiso[idx + 1] = avgMiso[idx + 1] + featureReferenceMisorientations[point];
@@ -1,13 +1,15 @@
 #include "FindKernelAvgMisorientations.hpp"
 
+#include "OrientationAnalysis/Math/MisorientationEngine.hpp"
+
 #include "complex/Common/Constants.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/DataStructure/Geometry/ImageGeom.hpp"
+#include "complex/Utilities/ImageSlabStreamer.hpp"
 #include "complex/Utilities/ParallelData3DAlgorithm.hpp"
 
-#include "EbsdLib/LaueOps/LaueOps.h"
-
+#include <array>
 #include <chrono>
 
 using namespace complex;
@@ -17,38 +19,38 @@ namespace
 class FindKernelAvgMisorientationsImpl
 {
 public:
-  FindKernelAvgMisorientationsImpl(FindKernelAvgMisorientations* filter, DataStructure& dataStructure, const FindKernelAvgMisorientationsInputValues* inputValues, const std::atomic_bool& shouldCancel)
+  FindKernelAvgMisorientationsImpl(FindKernelAvgMisorientations* filter, const AbstractDataStore<int32>& featureIds, const AbstractDataStore<int32>& cellPhases, const AbstractDataStore<float32>& quats,
+                                   const std::vector<uint32>& crystalStructures, AbstractDataStore<float32>& kernelAvgMisorientations, const SizeVec3& dims, const std::vector<int32>& kernelSize,
+                                   const std::atomic_bool& shouldCancel)
   : m_Filter(filter)
-  , m_DataStructure(dataStructure)
-  , m_InputValues(inputValues)
+  , m_FeatureIds(featureIds)
+  , m_CellPhases(cellPhases)
+  , m_Quats(quats)
+  , m_CrystalStructures(crystalStructures)
+  , m_KernelAvgMisorientations(kernelAvgMisorientations)
+  , m_Dims(dims)
+  , m_KernelSize(kernelSize)
   , m_ShouldCancel(shouldCancel)
   {
   }
 
   void convert(size_t zStart, size_t zEnd, size_t yStart, size_t yEnd, size_t xStart, size_t xEnd) const
   {
-    // Input Arrays / Parameter Data
-    const auto& cellPhasesArray = m_DataStructure.getDataRefAs<Int32Array>(m_InputValues->CellPhasesArrayPath);
-    const auto& cellPhases = cellPhasesArray.getDataStoreRef();
-    const auto& featureIdsArray = m_DataStructure.getDataRefAs<Int32Array>(m_InputValues->FeatureIdsArrayPath);
-    const auto& featureIds = featureIdsArray.getDataStoreRef();
-    const auto& quatsArray = m_DataStructure.getDataRefAs<Float32Array>(m_InputValues->QuatsArrayPath);
-    const auto& quats = quatsArray.getDataStoreRef();
-    const auto& crystalStructuresArray = m_DataStructure.getDataRefAs<UInt32Array>(m_InputValues->CrystalStructuresArrayPath);
-    const auto& crystalStructures = crystalStructuresArray.getDataStoreRef();
-    const auto kernelSize = m_InputValues->KernelSize;
+    const auto& cellPhases = m_CellPhases;
+    const auto& featureIds = m_FeatureIds;
+    const auto& quats = m_Quats;
+    const auto& crystalStructures = m_CrystalStructures;
+    const auto& kernelSize = m_KernelSize;
+    auto& kernelAvgMisorientations = m_KernelAvgMisorientations;
 
-    // Output Arrays
-    auto& kernelAvgMisorientationsArray = m_DataStructure.getDataRefAs<Float32Array>(m_InputValues->KernelAverageMisorientationsArrayName);
-    auto& kernelAvgMisorientations = kernelAvgMisorientationsArray.getDataStoreRef();
+    const std::vector<MisorientationEngine> misorientationEngines = MisorientationEngine::CreateAll();
 
-    std::vector<LaueOps::Pointer> m_OrientationOps = LaueOps::GetAllOrientationOps();
+    const SizeVec3& udims = m_Dims;
 
-    auto* gridGeom = m_DataStructure.getDataAs<ImageGeom>(m_InputValues->InputImageGeometry);
-    SizeVec3 udims = gridGeom->getDimensions();
-
-    QuatD q1;
-    QuatD q2;
+    std::array<float32, 4> q1 = {};
+    // Quaternions of the kernel neighbors in the same feature, evaluated as one batch
+    std::vector<float32> neighborQuats;
+    std::vector<float64> neighborAngles;
 
     // messenger values
     usize counter = 0;
@@ -91,6 +93,7 @@ public:
             q1[1] = quats[quatIndex + 1];
             q1[2] = quats[quatIndex + 2];
             q1[3] = quats[quatIndex + 3];
+            neighborQuats.clear();
 
             uint32_t phase1 = crystalStructures[cellPhases[point]];
             for(int32_t j = -kernelSize[2]; j < kernelSize[2] + 1; j++)
@@ -117,17 +120,21 @@ public:
                   if(featureIds[point] == featureIds[neighbor])
                   {
                     quatIndex = neighbor * 4;
-                    q2[0] = quats[quatIndex];
-                    q2[1] = quats[quatIndex + 1];
-                    q2[2] = quats[quatIndex + 2];
-                    q2[3] = quats[quatIndex + 3];
-                    OrientationF axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-                    totalMisorientation = totalMisorientation + (axisAngle[3] * complex::Constants::k_180OverPiD);
+                    neighborQuats.push_back(quats[quatIndex]);
+                    neighborQuats.push_back(quats[quatIndex + 1]);
+                    neighborQuats.push_back(quats[quatIndex + 2]);
+                    neighborQuats.push_back(quats[quatIndex + 3]);
                     numVoxel++;
                   }
                 }
               }
             }
+            neighborAngles.resize(numVoxel);
+            misorientationEngines[phase1].angles(q1, neighborQuats, neighborAngles);
+            for(const float64 angle : neighborAngles)
+            {
+              totalMisorientation = totalMisorientation + (angle * complex::Constants::k_180OverPiD);
+            }
             kernelAvgMisorientations[point] = totalMisorientation / static_cast<float>(numVoxel);
             if(numVoxel == 0)
             {
@@ -153,8 +160,13 @@ public:
 
 private:
   FindKernelAvgMisorientations* m_Filter = nullptr;
-  DataStructure& m_DataStructure;
-  const FindKernelAvgMisorientationsInputValues* m_InputValues = nullptr;
+  const AbstractDataStore<int32>& m_FeatureIds;
+  const AbstractDataStore<int32>& m_CellPhases;
+  const AbstractDataStore<float32>& m_Quats;
+  const std::vector<uint32>& m_CrystalStructures;
+  AbstractDataStore<float32>& m_KernelAvgMisorientations;
+  const SizeVec3 m_Dims;
+  const std::vector<int32>& m_KernelSize;
   const std::atomic_bool& m_ShouldCancel;
 };
 
@@ -208,17 +220,35 @@ Result<> FindKernelAvgMisorientations::operator()()
   // set up threadsafe messenger
   m_TotalElements = udims[2] * udims[1] * udims[0];
 
-  typename IParallelAlgorithm::AlgorithmArrays algArrays;
-  algArrays.push_back(m_DataStructure.getDataAs<IDataArray>(m_InputValues->CellPhasesArrayPath));
-  algArrays.push_back(m_DataStructure.getDataAs<IDataArray>(m_InputValues->CrystalStructuresArrayPath));
-  algArrays.push_back(m_DataStructure.getDataAs<IDataArray>(m_InputValues->FeatureIdsArrayPath));
-  algArrays.push_back(m_DataStructure.getDataAs<IDataArray>(m_InputValues->KernelAverageMisorientationsArrayName));
-  algArrays.push_back(m_DataStructure.getDataAs<IDataArray>(m_InputValues->QuatsArrayPath));
-
-  ParallelData3DAlgorithm parallelAlgorithm;
-  parallelAlgorithm.setRange(Range3D(0, udims[0], 0, udims[1], 0, udims[2]));
-  parallelAlgorithm.requireArraysInMemory(algArrays);
-  parallelAlgorithm.execute(FindKernelAvgMisorientationsImpl(this, m_DataStructure, m_InputValues, m_ShouldCancel));
-
-  return {};
+  const auto& featureIds = m_DataStructure.getDataRefAs<Int32Array>(m_InputValues->FeatureIdsArrayPath).getDataStoreRef();
+  const auto& cellPhases = m_DataStructure.getDataRefAs<Int32Array>(m_InputValues->CellPhasesArrayPath).getDataStoreRef();
+  const auto& quats = m_DataStructure.getDataRefAs<Float32Array>(m_InputValues->QuatsArrayPath).getDataStoreRef();
+  auto& kernelAvgMisorientations = m_DataStructure.getDataRefAs<Float32Array>(m_InputValues->KernelAverageMisorientationsArrayName).getDataStoreRef();
+
+  // The ensemble array is small and read for every voxel, so keep a copy in memory
+  const auto& crystalStructuresStore = m_DataStructure.getDataRefAs<UInt32Array>(m_InputValues->CrystalStructuresArrayPath).getDataStoreRef();
+  const std::vector<uint32> crystalStructures(crystalStructuresStore.begin(), crystalStructuresStore.end());
+
+  // Every voxel reads the kernel around it, so each Z slab is processed with a halo of KernelSize[2] layers
+  ImageSlabStreamer streamer(*gridGeom, m_InputValues->HaloWidth);
+  streamer.setSlabDepth(m_InputValues->SlabDepth);
+  const usize featureIdsIndex = streamer.addInput(featureIds);
+  const usize cellPhasesIndex = streamer.addInput(cellPhases);
+  const usize quatsIndex = streamer.addInput(quats);
+  const usize kernelAvgMisorientationsIndex = streamer.addOutput(kernelAvgMisorientations);
+
+  return streamer.execute(
+      [&](ImageSlabStreamer::Slab& slab) -> Result<> {
+        const SizeVec3 slabDims = slab.getDimensions();
+
+        // The slab buffers are always in memory, either as copies or as the in-memory arrays themselves
+        ParallelData3DAlgorithm parallelAlgorithm;
+        parallelAlgorithm.setRange(Range3D(0, slabDims[0], 0, slabDims[1], slab.getCoreStart(), slab.getCoreEnd()));
+        parallelAlgorithm.setParallelizationEnabled(true);
+        parallelAlgorithm.execute(FindKernelAvgMisorientationsImpl(this, slab.getBuffer<int32>(featureIdsIndex), slab.getBuffer<int32>(cellPhasesIndex), slab.getBuffer<float32>(quatsIndex),
+                                                                    crystalStructures, slab.getBuffer<float32>(kernelAvgMisorientationsIndex), slabDims, m_InputValues->KernelSize,
+                                                                    m_ShouldCancel));
+        return {};
+      },
+      m_ShouldCancel);
 }
@@ -21,6 +21,8 @@ struct ORIENTATIONANALYSIS_EXPORT FindKernelAvgMisorientationsInputValues
   DataPath CrystalStructuresArrayPath;
   DataPath KernelAverageMisorientationsArrayName;
   DataPath InputImageGeometry;
+  usize HaloWidth;
+  usize SlabDepth; // Number of Z layers processed at once, 0 picks the depth automatically
 };
 
 /**
@@ -1,11 +1,13 @@
 #include "FindMisorientations.hpp"
 
+#include "OrientationAnalysis/Math/MisorientationEngine.hpp"
+
 #include "complex/Common/Constants.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/DataStructure/NeighborList.hpp"
 
-#include "EbsdLib/LaueOps/LaueOps.h"
+#include <array>
 
 using namespace complex;
 
@@ -31,7 +33,7 @@ const std::atomic_bool& FindMisorientations::getCancel()
 Result<> FindMisorientations::operator()()
 {
 
-  std::vector<LaueOps::Pointer> orientationOps = LaueOps::GetAllOrientationOps();
+  const std::vector<MisorientationEngine> misorientationEngines = MisorientationEngine::CreateAll();
 
   // Input Arrays
   const auto& inFeaturePhases = m_DataStructure.getDataRefAs<Int32Array>(m_InputValues->FeaturePhasesArrayPath);
@@ -48,30 +50,47 @@ Result<> FindMisorientations::operator()()
   size_t totalFeatures = inFeaturePhases.getNumberOfTuples();
 
   std::vector<std::vector<float>> tempMisorientationLists(totalFeatures);
+  std::vector<float32> neighborQuats;
+  std::vector<float64> neighborAngles;
   usize quatIndex = 0;
   for(size_t i = 1; i < totalFeatures; i++)
   {
     quatIndex = i * 4;
 
-    QuatF q1(inAvgQuats[quatIndex], inAvgQuats[quatIndex + 1], inAvgQuats[quatIndex + 2], inAvgQuats[quatIndex + 3]);
+    const std::array<float32, 4> q1 = {inAvgQuats[quatIndex], inAvgQuats[quatIndex + 1], inAvgQuats[quatIndex + 2], inAvgQuats[quatIndex + 3]};
     uint32_t xtalType1 = inXtalStruct[inFeaturePhases[i]];
 
     const NeighborList<int32_t>::VectorType& featureNeighborList = inNeighborList.getListReference(static_cast<int32_t>(i));
 
     tempMisorientationLists[i].assign(featureNeighborList.size(), -1.0);
 
+    // Gather the neighbors with the same crystal structure and compute their angles as one batch
+    auto isComparable = [&](int32_t neighborFeatureId) {
+      uint32_t xtalType2 = inXtalStruct[inFeaturePhases[neighborFeatureId]];
+      return xtalType1 == xtalType2 && static_cast<int64_t>(xtalType1) < static_cast<int64_t>(misorientationEngines.size());
+    };
+    neighborQuats.clear();
+    for(int32_t neighborFeatureId : featureNeighborList)
+    {
+      if(isComparable(neighborFeatureId))
+      {
+        quatIndex = neighborFeatureId * 4;
+        neighborQuats.insert(neighborQuats.end(), {inAvgQuats[quatIndex], inAvgQuats[quatIndex + 1], inAvgQuats[quatIndex + 2], inAvgQuats[quatIndex + 3]});
+      }
+    }
+    neighborAngles.resize(neighborQuats.size() / 4);
+    if(!neighborAngles.empty())
+    {
+      misorientationEngines[xtalType1].angles(q1, neighborQuats, neighborAngles);
+    }
+
+    usize angleIndex = 0;
     for(size_t j = 0; j < featureNeighborList.size(); j++)
     {
-      int32_t neighborFeatureId = featureNeighborList[j];
-      quatIndex = neighborFeatureId * 4;
-      QuatF q2(inAvgQuats[quatIndex], inAvgQuats[quatIndex + 1], inAvgQuats[quatIndex + 2], inAvgQuats[quatIndex + 3]);
-      uint32_t xtalType2 = inXtalStruct[inFeaturePhases[neighborFeatureId]];
       tempMisoList = featureNeighborList.size();
-      if(xtalType1 == xtalType2 && static_cast<int64_t>(xtalType1) < static_cast<int64_t>(orientationOps.size()))
+      if(isComparable(featureNeighborList[j]))
       {
-        OrientationD axisAngle = orientationOps[xtalType1]->calculateMisorientation(q1, q2);
-
-        tempMisorientationLists[i][j] = static_cast<float>(axisAngle[3] * complex::Constants::k_180OverPiF);
+        tempMisorientationLists[i][j] = static_cast<float>(neighborAngles[angleIndex++] * complex::Constants::k_180OverPiF);
         if(m_InputValues->FindAvgMisors)
         {
           (*avgMisorientations)[i] += tempMisorientationLists[i][j];
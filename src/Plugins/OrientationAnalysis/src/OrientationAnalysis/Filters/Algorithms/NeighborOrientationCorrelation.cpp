@@ -1,5 +1,7 @@
 #include "NeighborOrientationCorrelation.hpp"
 
+#include "OrientationAnalysis/Math/MisorientationEngine.hpp"
+
 #include "complex/Common/Numbers.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
@@ -13,7 +15,7 @@
 #define RUN_TASK
 #endif
 
-#include "EbsdLib/LaueOps/LaueOps.h"
+#include <array>
 
 using namespace complex;
 
@@ -95,7 +97,7 @@ Result<> NeighborOrientationCorrelation::operator()()
   size_t progress = 0;
   size_t totalProgress = 0;
 
-  std::vector<LaueOps::Pointer> orientationOps = LaueOps::GetAllOrientationOps();
+  const std::vector<MisorientationEngine> misorientationEngines = MisorientationEngine::CreateAll();
 
   const auto& confidenceIndex = m_DataStructure.getDataRefAs<Float32Array>(m_InputValues->ConfidenceIndexArrayPath);
   const auto& cellPhases = m_DataStructure.getDataRefAs<Int32Array>(m_InputValues->CellPhasesArrayPath);
@@ -104,6 +106,7 @@ Result<> NeighborOrientationCorrelation::operator()()
   size_t totalPoints = confidenceIndex.getNumberOfTuples();
 
   float misorientationToleranceR = m_InputValues->MisorientationTolerance * numbers::pi_v<float> / 180.0f;
+  const float64 halfAngleCosine = MisorientationEngine::HalfAngleCosine(misorientationToleranceR);
 
   auto& imageGeom = m_DataStructure.getDataRefAs<ImageGeom>(m_InputValues->ImageGeomPath);
   SizeVec3 udims = imageGeom.getDimensions();
@@ -195,14 +198,14 @@ Result<> NeighborOrientationCorrelation::operator()()
           if(good)
           {
             phase1 = crystalStructures[cellPhases[i]];
-            QuatF quat1(quats[i * 4], quats[i * 4 + 1], quats[i * 4 + 2], quats[i * 4 + 3]);
-            QuatF quat2(quats[neighbor * 4], quats[neighbor * 4 + 1], quats[neighbor * 4 + 2], quats[neighbor * 4 + 3]);
-            OrientationD axisAngle(0.0, 0.0, 0.0, std::numeric_limits<double>::max());
+            std::array<float32, 4> quat1 = {quats[i * 4], quats[i * 4 + 1], quats[i * 4 + 2], quats[i * 4 + 3]};
+            std::array<float32, 4> quat2 = {quats[neighbor * 4], quats[neighbor * 4 + 1], quats[neighbor * 4 + 2], quats[neighbor * 4 + 3]};
+            bool similar = false;
             if(cellPhases[i] == cellPhases[neighbor] && cellPhases[i] > 0)
             {
-              axisAngle = orientationOps[phase1]->calculateMisorientation(quat1, quat2);
+              similar = misorientationEngines[phase1].isLessThan(quat1.data(), quat2.data(), halfAngleCosine);
             }
-            if(axisAngle[3] > misorientationToleranceR)
+            if(!similar)
             {
               neighborDiffCount[i]++;
             }
@@ -237,14 +240,14 @@ Result<> NeighborOrientationCorrelation::operator()()
               if(good2)
               {
                 phase1 = crystalStructures[cellPhases[neighbor2]];
-                quat1 = QuatF(quats[neighbor2 * 4], quats[neighbor2 * 4 + 1], quats[neighbor2 * 4 + 2], quats[neighbor2 * 4 + 3]);
-                quat2 = QuatF(quats[neighbor * 4], quats[neighbor * 4 + 1], quats[neighbor * 4 + 2], quats[neighbor * 4 + 3]);
-                axisAngle = OrientationD(0.0, 0.0, 0.0, std::numeric_limits<double>::max());
+                quat1 = {quats[neighbor2 * 4], quats[neighbor2 * 4 + 1], quats[neighbor2 * 4 + 2], quats[neighbor2 * 4 + 3]};
+                quat2 = {quats[neighbor * 4], quats[neighbor * 4 + 1], quats[neighbor * 4 + 2], quats[neighbor * 4 + 3]};
+                similar = false;
                 if(cellPhases[neighbor2] == cellPhases[neighbor] && cellPhases[neighbor2] > 0)
                 {
-                  axisAngle = orientationOps[phase1]->calculateMisorientation(quat1, quat2);
+                  similar = misorientationEngines[phase1].isLessThan(quat1.data(), quat2.data(), halfAngleCosine);
                 }
-                if(axisAngle[3] < misorientationToleranceR)
+                if(similar)
                 {
                   neighborSimCount[j]++;
                   neighborSimCount[k]++;
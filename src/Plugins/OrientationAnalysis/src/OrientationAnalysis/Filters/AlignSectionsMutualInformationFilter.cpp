@@ -59,6 +59,9 @@ Parameters AlignSectionsMutualInformationFilter::parameters() const
                                                    "Tolerance used to decide if Cells above/below one another should be considered to be the same. The value selected should be similar to the "
                                                    "tolerance one would use to define Features (i.e., 2-10 degrees).",
                                                    5.0f));
+  params.insert(std::make_unique<BoolParameter>(k_UseCoarseToFineSearch_Key, "Use Coarse-to-Fine Search",
+                                               "Whether to search for the shifts on a coarse grid first and refine them on finer grids. This finds larger misalignments than the local search around the previous shift.",
+                                               false));
 
   params.insertSeparator(Parameters::Separator{"Optional Data Mask"});
   params.insertLinkableParameter(std::make_unique<BoolParameter>(k_UseMask_Key, "Use Mask Array", "Whether to remove some Cells from consideration in the alignment process.", true));
@@ -148,6 +151,7 @@ Result<> AlignSectionsMutualInformationFilter::executeImpl(DataStructure& dataSt
   inputValues.WriteAlignmentShifts = filterArgs.value<bool>(k_WriteAlignmentShifts_Key);
   inputValues.AlignmentShiftFileName = filterArgs.value<FileSystemPathParameter::ValueType>(k_AlignmentShiftFileName_Key);
   inputValues.MisorientationTolerance = filterArgs.value<float32>(k_MisorientationTolerance_Key);
+  inputValues.UseCoarseToFineSearch = filterArgs.value<bool>(k_UseCoarseToFineSearch_Key);
   inputValues.UseMask = filterArgs.value<bool>(k_UseMask_Key);
   inputValues.ImageGeometryPath = filterArgs.value<DataPath>(k_SelectedImageGeometry_Key);
   inputValues.QuatsArrayPath = filterArgs.value<DataPath>(k_QuatsArrayPath_Key);
@@ -28,6 +28,7 @@ public:
   static inline constexpr StringLiteral k_WriteAlignmentShifts_Key = "write_alignment_shifts";
   static inline constexpr StringLiteral k_AlignmentShiftFileName_Key = "alignment_shift_file_name";
   static inline constexpr StringLiteral k_MisorientationTolerance_Key = "misorientation_tolerance";
+  static inline constexpr StringLiteral k_UseCoarseToFineSearch_Key = "use_coarse_to_fine_search";
   static inline constexpr StringLiteral k_UseMask_Key = "use_mask";
   static inline constexpr StringLiteral k_QuatsArrayPath_Key = "quats_array_path";
   static inline constexpr StringLiteral k_CellPhasesArrayPath_Key = "cell_phases_array_path";
@@ -16,6 +16,8 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+
 #ifndef _MSC_VER
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "UnusedValue"
@@ -154,6 +156,27 @@ struct StereographicCheck
   }
 };
 
+/**
+ * @brief Walks the tuples in range one block at a time and calls kernel with pointers
+ * to the input and output values of each tuple. In-memory stores are accessed in place,
+ * other stores are copied through a temporary buffer one block at a time.
+ */
+template <typename T, typename KernelFunc>
+void ForEachTupleBlock(const AbstractDataStore<T>& inDataStore, usize inCompSize, AbstractDataStore<T>& outDataStore, usize outCompSize, const Range& range, KernelFunc&& kernel)
+{
+  const usize blockTuples = std::max<usize>(outDataStore.getPreferredBlockSize() / std::max<usize>(outCompSize, 1), 1);
+  for(usize blockStart = range.min(); blockStart < range.max(); blockStart += blockTuples)
+  {
+    const usize blockSize = std::min(blockTuples, range.max() - blockStart);
+    auto inValues = inDataStore.borrowRange(blockStart * inCompSize, blockSize * inCompSize);
+    auto outValues = outDataStore.borrowRange(blockStart * outCompSize, blockSize * outCompSize);
+    for(usize i = 0; i < blockSize; i++)
+    {
+      kernel(inValues.data() + i * inCompSize, outValues.data() + i * outCompSize);
+    }
+  }
+}
+
 /**
  *
  */
@@ -175,22 +198,17 @@ public:
     auto& outDataStore = m_OutputArray.getDataStoreRef();
 
     Orientation<T> input(InCompSize);
-    for(size_t tIndex = range.min(); tIndex < range.max(); tIndex++)
-    {
-
-      for(size_t cIndex = 0; cIndex < InCompSize; cIndex++)
-      {
-        input[cIndex] = inDataStore.getValue(tIndex * InCompSize + cIndex);
-      }
+    ForEachTupleBlock(inDataStore, InCompSize, outDataStore, OutCompSize, range, [&](const T* inTuple, T* outTuple) {
+      std::copy_n(inTuple, InCompSize, input.data());
 
       m_CheckFunc(input.data());
 
       Orientation<T> output = m_TransformFunc(input); // Do the actual Conversion
       for(size_t cIndex = 0; cIndex < OutCompSize; cIndex++)
       {
-        outDataStore.setValue(tIndex * OutCompSize + cIndex, output[cIndex]);
+        outTuple[cIndex] = output[cIndex];
       }
-    }
+    });
   }
 
 private:
@@ -219,24 +237,19 @@ public:
   void operator()(const Range& range) const
   {
     using QuaterionType = Quaternion<float>;
-    size_t numTuples = m_InputArray.getNumberOfTuples();
     auto& inDataStore = m_InputArray.getDataStoreRef();
     auto& outDataStore = m_OutputArray.getDataStoreRef();
 
     Orientation<T> input(InCompSize);
-    for(size_t tIndex = range.min(); tIndex < range.max(); tIndex++)
-    {
-      for(size_t cIndex = 0; cIndex < InCompSize; cIndex++)
-      {
-        input[cIndex] = inDataStore.getValue(tIndex * InCompSize + cIndex);
-      }
+    ForEachTupleBlock(inDataStore, InCompSize, outDataStore, OutCompSize, range, [&](const T* inTuple, T* outTuple) {
+      std::copy_n(inTuple, InCompSize, input.data());
       m_CheckFunc(input.data());
       QuaterionType output = m_TransformFunc(input, m_Layout); // Do the actual Conversion
       for(size_t cIndex = 0; cIndex < OutCompSize; cIndex++)
       {
-        outDataStore.setValue(tIndex * OutCompSize + cIndex, output[cIndex]);
+        outTuple[cIndex] = output[cIndex];
       }
-    }
+    });
   }
 
 private:
@@ -270,20 +283,16 @@ public:
     auto& outDataStore = m_OutputArray.getDataStoreRef();
 
     std::array<T, 4> input;
-    for(size_t tIndex = range.min(); tIndex < range.max(); tIndex++)
-    {
-      for(size_t cIndex = 0; cIndex < InCompSize; cIndex++)
-      {
-        input[cIndex] = inDataStore.getValue(tIndex * InCompSize + cIndex);
-      }
+    ForEachTupleBlock(inDataStore, InCompSize, outDataStore, OutCompSize, range, [&](const T* inTuple, T* outTuple) {
+      std::copy_n(inTuple, InCompSize, input.data());
       m_CheckFunc(input.data());
 
       Orientation<T> output = m_TransformFunc(QuaterionType(input[0], input[1], input[2], input[3]), m_Layout); // Do the actual Conversion
       for(size_t cIndex = 0; cIndex < OutCompSize; cIndex++)
       {
-        outDataStore.setValue(tIndex * OutCompSize + cIndex, output[cIndex]);
+        outTuple[cIndex] = output[cIndex];
       }
-    }
+    });
   }
 
 private:
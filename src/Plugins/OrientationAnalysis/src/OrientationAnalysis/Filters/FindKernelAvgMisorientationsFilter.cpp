@@ -9,6 +9,8 @@
 #include "complex/Parameters/GeometrySelectionParameter.hpp"
 #include "complex/Parameters/VectorParameter.hpp"
 
+#include <algorithm>
+
 using namespace complex;
 
 namespace complex
@@ -79,6 +81,17 @@ IFilter::UniquePointer FindKernelAvgMisorientationsFilter::clone() const
   return std::make_unique<FindKernelAvgMisorientationsFilter>();
 }
 
+//------------------------------------------------------------------------------
+std::optional<usize> FindKernelAvgMisorientationsFilter::slabHaloWidth(const Arguments& args) const
+{
+  if(!args.contains(k_KernelSize_Key))
+  {
+    return {};
+  }
+  const auto kernelSize = args.value<VectorInt32Parameter::ValueType>(k_KernelSize_Key);
+  return static_cast<usize>(std::max(kernelSize[2], 0));
+}
+
 //------------------------------------------------------------------------------
 IFilter::PreflightResult FindKernelAvgMisorientationsFilter::preflightImpl(const DataStructure& dataStructure, const Arguments& filterArgs, const MessageHandler& messageHandler,
                                                                            const std::atomic_bool& shouldCancel) const
@@ -122,6 +135,8 @@ Result<> FindKernelAvgMisorientationsFilter::executeImpl(DataStructure& dataStru
   inputValues.CrystalStructuresArrayPath = filterArgs.value<DataPath>(k_CrystalStructuresArrayPath_Key);
   inputValues.KernelAverageMisorientationsArrayName = inputValues.CellPhasesArrayPath.getParent().createChildPath(filterArgs.value<std::string>(k_KernelAverageMisorientationsArrayName_Key));
   inputValues.InputImageGeometry = filterArgs.value<DataPath>(k_SelectedImageGeometry_Key);
+  inputValues.HaloWidth = slabHaloWidth(filterArgs).value_or(0);
+  inputValues.SlabDepth = 0;
 
   return FindKernelAvgMisorientations(dataStructure, messageHandler, shouldCancel, &inputValues)();
 }
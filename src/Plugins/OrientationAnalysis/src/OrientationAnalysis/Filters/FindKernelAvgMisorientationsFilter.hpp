@@ -74,6 +74,14 @@ public:
    */
   UniquePointer clone() const override;
 
+  /**
+   * @brief Each voxel reads the kernel around it, so a slab needs one halo layer
+   * per kernel step in Z.
+   * @param args
+   * @return
+   */
+  std::optional<usize> slabHaloWidth(const Arguments& args) const override;
+
 protected:
   /**
    * @brief Takes in a DataStructure and checks that the filter can be run on it with the given arguments.
@@ -0,0 +1,212 @@
+#include "MisorientationEngine.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+using namespace complex;
+
+namespace
+{
+/**
+ * @brief Scalar and vector parts of q1 * q2^-1.
+ */
+struct Delta
+{
+  float64 w;
+  float64 x;
+  float64 y;
+  float64 z;
+};
+
+template <typename T>
+Delta ComputeDelta(const T* q1, const T* q2, float64 crossSign)
+{
+  const float64 x1 = q1[0];
+  const float64 y1 = q1[1];
+  const float64 z1 = q1[2];
+  const float64 w1 = q1[3];
+  const float64 x2 = q2[0];
+  const float64 y2 = q2[1];
+  const float64 z2 = q2[2];
+  const float64 w2 = q2[3];
+
+  Delta delta;
+  delta.w = w1 * w2 + x1 * x2 + y1 * y2 + z1 * z2;
+  delta.x = w2 * x1 - w1 * x2 - crossSign * (y1 * z2 - z1 * y2);
+  delta.y = w2 * y1 - w1 * y2 - crossSign * (z1 * x2 - x1 * z2);
+  delta.z = w2 * z1 - w1 * z2 - crossSign * (x1 * y2 - y1 * x2);
+  return delta;
+}
+
+float64 AngleFromScalar(float64 maxW)
+{
+  return 2.0 * std::acos(std::min(maxW, 1.0));
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+MisorientationEngine::MisorientationEngine(LaueOps::Pointer ops)
+: m_Ops(std::move(ops))
+{
+  const int numSymOps = m_Ops->getNumSymOps();
+  m_SymW.reserve(numSymOps);
+  m_SymX.reserve(numSymOps);
+  m_SymY.reserve(numSymOps);
+  m_SymZ.reserve(numSymOps);
+  for(int i = 0; i < numSymOps; i++)
+  {
+    const QuatD symOp = m_Ops->getQuatSymOp(i);
+    m_SymW.push_back(symOp.w());
+    m_SymX.push_back(symOp.x());
+    m_SymY.push_back(symOp.y());
+    m_SymZ.push_back(symOp.z());
+  }
+
+  // EbsdLib can be built with either sign convention for the quaternion product, i * j = +/-k
+  const QuatD product = QuatD(1.0, 0.0, 0.0, 0.0) * QuatD(0.0, 1.0, 0.0, 0.0);
+  m_CrossSign = product.z() < 0.0 ? -1.0 : 1.0;
+}
+
+// -----------------------------------------------------------------------------
+std::vector<MisorientationEngine> MisorientationEngine::CreateAll()
+{
+  std::vector<MisorientationEngine> engines;
+  for(const auto& ops : LaueOps::GetAllOrientationOps())
+  {
+    engines.emplace_back(ops);
+  }
+  return engines;
+}
+
+// -----------------------------------------------------------------------------
+float64 MisorientationEngine::HalfAngleCosine(float64 angle)
+{
+  return std::cos(angle * 0.5);
+}
+
+// -----------------------------------------------------------------------------
+float64 MisorientationEngine::angle(const QuatF& q1, const QuatF& q2) const
+{
+  const std::array<float32, 4> values1 = {q1.x(), q1.y(), q1.z(), q1.w()};
+  const std::array<float32, 4> values2 = {q2.x(), q2.y(), q2.z(), q2.w()};
+  return angle(values1.data(), values2.data());
+}
+
+// -----------------------------------------------------------------------------
+float64 MisorientationEngine::angle(const QuatD& q1, const QuatD& q2) const
+{
+  if(m_SymW.empty())
+  {
+    return m_Ops->calculateMisorientation(q1, q2)[3];
+  }
+  const std::array<float64, 4> values1 = {q1.x(), q1.y(), q1.z(), q1.w()};
+  const std::array<float64, 4> values2 = {q2.x(), q2.y(), q2.z(), q2.w()};
+  const Delta delta = ComputeDelta(values1.data(), values2.data(), m_CrossSign);
+  float64 maxW = 0.0;
+  for(usize i = 0; i < m_SymW.size(); i++)
+  {
+    maxW = std::max(maxW, std::abs(m_SymW[i] * delta.w - m_SymX[i] * delta.x - m_SymY[i] * delta.y - m_SymZ[i] * delta.z));
+  }
+  return AngleFromScalar(maxW);
+}
+
+// -----------------------------------------------------------------------------
+float64 MisorientationEngine::angle(const float32* q1, const float32* q2) const
+{
+  if(m_SymW.empty())
+  {
+    return fallbackAngle(q1, q2);
+  }
+  const Delta delta = ComputeDelta(q1, q2, m_CrossSign);
+  float64 maxW = 0.0;
+  for(usize i = 0; i < m_SymW.size(); i++)
+  {
+    maxW = std::max(maxW, std::abs(m_SymW[i] * delta.w - m_SymX[i] * delta.x - m_SymY[i] * delta.y - m_SymZ[i] * delta.z));
+  }
+  return AngleFromScalar(maxW);
+}
+
+// -----------------------------------------------------------------------------
+bool MisorientationEngine::isLessThan(const float32* q1, const float32* q2, float64 halfAngleCosine) const
+{
+  if(m_SymW.empty())
+  {
+    return HalfAngleCosine(fallbackAngle(q1, q2)) > halfAngleCosine;
+  }
+  const Delta delta = ComputeDelta(q1, q2, m_CrossSign);
+  for(usize i = 0; i < m_SymW.size(); i++)
+  {
+    if(std::abs(m_SymW[i] * delta.w - m_SymX[i] * delta.x - m_SymY[i] * delta.y - m_SymZ[i] * delta.z) > halfAngleCosine)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+void MisorientationEngine::angles(nonstd::span<const float32> quats1, nonstd::span<const float32> quats2, nonstd::span<float64> angles) const
+{
+  const usize count = angles.size();
+  const bool singleReference = quats1.size() == 4;
+  if(m_SymW.empty())
+  {
+    for(usize j = 0; j < count; j++)
+    {
+      angles[j] = fallbackAngle(singleReference ? quats1.data() : quats1.data() + j * 4, quats2.data() + j * 4);
+    }
+    return;
+  }
+
+  std::array<float64, k_BatchSize> deltaW = {};
+  std::array<float64, k_BatchSize> deltaX = {};
+  std::array<float64, k_BatchSize> deltaY = {};
+  std::array<float64, k_BatchSize> deltaZ = {};
+  std::array<float64, k_BatchSize> maxW = {};
+  for(usize start = 0; start < count; start += k_BatchSize)
+  {
+    const usize batchSize = std::min(k_BatchSize, count - start);
+    for(usize j = 0; j < k_BatchSize; j++)
+    {
+      Delta delta = {0.0, 0.0, 0.0, 0.0};
+      if(j < batchSize)
+      {
+        const usize index = start + j;
+        delta = ComputeDelta(singleReference ? quats1.data() : quats1.data() + index * 4, quats2.data() + index * 4, m_CrossSign);
+      }
+      deltaW[j] = delta.w;
+      deltaX[j] = delta.x;
+      deltaY[j] = delta.y;
+      deltaZ[j] = delta.z;
+      maxW[j] = 0.0;
+    }
+
+    // Every operator is applied to the whole batch; the fixed trip count keeps the lanes full
+    for(usize i = 0; i < m_SymW.size(); i++)
+    {
+      const float64 symW = m_SymW[i];
+      const float64 symX = m_SymX[i];
+      const float64 symY = m_SymY[i];
+      const float64 symZ = m_SymZ[i];
+      for(usize j = 0; j < k_BatchSize; j++)
+      {
+        const float64 w = std::abs(symW * deltaW[j] - symX * deltaX[j] - symY * deltaY[j] - symZ * deltaZ[j]);
+        maxW[j] = maxW[j] < w ? w : maxW[j];
+      }
+    }
+
+    for(usize j = 0; j < batchSize; j++)
+    {
+      angles[start + j] = AngleFromScalar(maxW[j]);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+float64 MisorientationEngine::fallbackAngle(const float32* q1, const float32* q2) const
+{
+  const QuatD quat1(q1[0], q1[1], q1[2], q1[3]);
+  const QuatD quat2(q2[0], q2[1], q2[2], q2[3]);
+  return m_Ops->calculateMisorientation(quat1, quat2)[3];
+}
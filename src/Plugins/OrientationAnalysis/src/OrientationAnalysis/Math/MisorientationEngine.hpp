@@ -0,0 +1,125 @@
+#pragma once
+
+#include "complex/Common/Types.hpp"
+
+#include "EbsdLib/LaueOps/LaueOps.h"
+
+#include <nonstd/span.hpp>
+
+#include <vector>
+
+namespace complex
+{
+/**
+ * @class MisorientationEngine
+ * @brief The MisorientationEngine class computes misorientation angles between
+ * quaternions of the same Laue class without going through the virtual
+ * LaueOps::calculateMisorientation() call for every pair.
+ *
+ * The misorientation angle is the smallest rotation angle of S * q1 * q2^-1 over
+ * all symmetry operators S, i.e. 2 * acos(max |w|) where w is the scalar part of
+ * the product. Only the scalar part is needed, so each operator costs four
+ * multiply-adds. The operators are stored as structure of arrays and the batched
+ * overload evaluates k_BatchSize pairs per operator so the inner loop maps onto
+ * SIMD lanes.
+ *
+ * Quaternions are in the EbsdLib (x, y, z, w) layout and angles are in radians.
+ * An engine is read-only after construction and can be shared between threads.
+ */
+class MisorientationEngine
+{
+public:
+  /**
+   * @brief Number of quaternion pairs evaluated together by angles().
+   */
+  static constexpr usize k_BatchSize = 16;
+
+  /**
+   * @brief Copies the symmetry operators of the given Laue class.
+   * @param ops
+   */
+  explicit MisorientationEngine(LaueOps::Pointer ops);
+
+  ~MisorientationEngine() noexcept = default;
+
+  MisorientationEngine(const MisorientationEngine&) = default;
+  MisorientationEngine(MisorientationEngine&&) noexcept = default;
+  MisorientationEngine& operator=(const MisorientationEngine&) = default;
+  MisorientationEngine& operator=(MisorientationEngine&&) noexcept = default;
+
+  /**
+   * @brief Creates one engine per entry of LaueOps::GetAllOrientationOps() so the
+   * result can be indexed with the crystal structure.
+   * @return std::vector<MisorientationEngine>
+   */
+  static std::vector<MisorientationEngine> CreateAll();
+
+  /**
+   * @brief Converts a misorientation angle into the threshold used by isLessThan().
+   * @param angle Radians
+   * @return float64
+   */
+  static float64 HalfAngleCosine(float64 angle);
+
+  /**
+   * @brief Returns the misorientation angle between two quaternions.
+   * @param q1
+   * @param q2
+   * @return float64 Radians
+   */
+  float64 angle(const QuatF& q1, const QuatF& q2) const;
+
+  /**
+   * @brief Returns the misorientation angle between two quaternions.
+   * @param q1
+   * @param q2
+   * @return float64 Radians
+   */
+  float64 angle(const QuatD& q1, const QuatD& q2) const;
+
+  /**
+   * @brief Returns the misorientation angle between the quaternions at q1 and q2.
+   * @param q1 Pointer to 4 values
+   * @param q2 Pointer to 4 values
+   * @return float64 Radians
+   */
+  float64 angle(const float32* q1, const float32* q2) const;
+
+  /**
+   * @brief Returns true if the misorientation angle is below the angle that was
+   * passed to HalfAngleCosine(). Stops at the first symmetry operator that brings
+   * the quaternions within the threshold, so similar orientations are accepted
+   * after the identity operator.
+   * @param q1 Pointer to 4 values
+   * @param q2 Pointer to 4 values
+   * @param halfAngleCosine
+   * @return bool
+   */
+  bool isLessThan(const float32* q1, const float32* q2, float64 halfAngleCosine) const;
+
+  /**
+   * @brief Computes the misorientation angles of n quaternion pairs. quats2 holds
+   * 4 * n values and quats1 holds either 4 * n values or a single quaternion that
+   * is compared against every quaternion of quats2.
+   * @param quats1
+   * @param quats2
+   * @param angles Receives n angles in radians
+   */
+  void angles(nonstd::span<const float32> quats1, nonstd::span<const float32> quats2, nonstd::span<float64> angles) const;
+
+private:
+  /**
+   * @brief Computes the misorientation angle with the LaueOps for Laue classes
+   * without symmetry operators.
+   */
+  float64 fallbackAngle(const float32* q1, const float32* q2) const;
+
+  LaueOps::Pointer m_Ops;
+  std::vector<float64> m_SymW;
+  std::vector<float64> m_SymX;
+  std::vector<float64> m_SymY;
+  std::vector<float64> m_SymZ;
+  // Sign of the cross product term of the EbsdLib quaternion product
+  float64 m_CrossSign = 1.0;
+};
+} // namespace complex
@@ -116,6 +116,7 @@ TEST_CASE("OrientationAnalysis::AlignSectionsMisorientation Small IN100 Pipeline
     args.insertOrAssign(AlignSectionsMisorientationFilter::k_AlignmentShiftFileName_Key, std::make_any<FileSystemPathParameter::ValueType>(computedShiftsFile));
 
     args.insertOrAssign(AlignSectionsMisorientationFilter::k_MisorientationTolerance_Key, std::make_any<float32>(5.0F));
+    args.insertOrAssign(AlignSectionsMisorientationFilter::k_UseCoarseToFineSearch_Key, std::make_any<bool>(false));
 
     args.insertOrAssign(AlignSectionsMisorientationFilter::k_UseMask_Key, std::make_any<bool>(true));
     args.insertOrAssign(AlignSectionsMisorientationFilter::k_MaskArrayPath_Key, std::make_any<DataPath>(k_MaskArrayPath));
@@ -177,3 +178,39 @@ TEST_CASE("OrientationAnalysis::AlignSectionsMisorientation Small IN100 Pipeline
   // Compare the shift values
   CompareArrays<int32>(dataStructure, k_CalculatedShiftsPath, k_ExemplarShiftsPath);
 }
+
+TEST_CASE("OrientationAnalysis::AlignSectionsMisorientation Coarse To Fine Search", "[OrientationAnalysis][AlignSectionsMisorientation]")
+{
+  const SizeVec3 dims = {256, 256, 4};
+  DataStructure dataStructure = ShiftedGrainStack::CreateDataStructure(dims, 6);
+  const fs::path shiftsFile = fmt::format("{}/align_sections_misorientation_coarse_to_fine.txt", unit_test::k_BinaryTestOutputDir);
+
+  {
+    Arguments args;
+    AlignSectionsMisorientationFilter filter;
+    args.insertOrAssign(AlignSectionsMisorientationFilter::k_WriteAlignmentShifts_Key, std::make_any<bool>(true));
+    args.insertOrAssign(AlignSectionsMisorientationFilter::k_AlignmentShiftFileName_Key, std::make_any<FileSystemPathParameter::ValueType>(shiftsFile));
+    args.insertOrAssign(AlignSectionsMisorientationFilter::k_MisorientationTolerance_Key, std::make_any<float32>(5.0F));
+    args.insertOrAssign(AlignSectionsMisorientationFilter::k_UseCoarseToFineSearch_Key, std::make_any<bool>(true));
+    args.insertOrAssign(AlignSectionsMisorientationFilter::k_UseMask_Key, std::make_any<bool>(false));
+    args.insertOrAssign(AlignSectionsMisorientationFilter::k_MaskArrayPath_Key, std::make_any<DataPath>(k_MaskArrayPath));
+    args.insertOrAssign(AlignSectionsMisorientationFilter::k_QuatsArrayPath_Key, std::make_any<DataPath>(k_QuatsArrayPath));
+    args.insertOrAssign(AlignSectionsMisorientationFilter::k_CellPhasesArrayPath_Key, std::make_any<DataPath>(k_PhasesArrayPath));
+    args.insertOrAssign(AlignSectionsMisorientationFilter::k_CrystalStructuresArrayPath_Key, std::make_any<DataPath>(k_CrystalStructuresArrayPath));
+    args.insertOrAssign(AlignSectionsMisorientationFilter::k_SelectedImageGeometry_Key, std::make_any<DataPath>(k_DataContainerPath));
+
+    auto preflightResult = filter.preflight(dataStructure, args);
+    COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions)
+
+    auto executeResult = filter.execute(dataStructure, args);
+    COMPLEX_RESULT_REQUIRE_VALID(executeResult.result)
+  }
+
+  // Every slice is shifted by more than the 7x7 neighborhood of a single search level
+  const std::vector<std::array<int64, 2>> shifts = ShiftedGrainStack::ReadRelativeShifts(shiftsFile);
+  REQUIRE(shifts.size() == dims[2] - 1);
+  for(const std::array<int64, 2>& shift : shifts)
+  {
+    REQUIRE(shift == ShiftedGrainStack::k_SliceShift);
+  }
+}
@@ -55,6 +55,7 @@ TEST_CASE("OrientationAnalysis::AlignSectionsMutualInformationFilter: Valid filt
     args.insertOrAssign(AlignSectionsMutualInformationFilter::k_WriteAlignmentShifts_Key, std::make_any<bool>(true));
     args.insertOrAssign(AlignSectionsMutualInformationFilter::k_AlignmentShiftFileName_Key, std::make_any<FileSystemPathParameter::ValueType>(computedShiftsFile));
     args.insertOrAssign(AlignSectionsMutualInformationFilter::k_MisorientationTolerance_Key, std::make_any<float32>(5.0f));
+    args.insertOrAssign(AlignSectionsMutualInformationFilter::k_UseCoarseToFineSearch_Key, std::make_any<bool>(false));
     args.insertOrAssign(AlignSectionsMutualInformationFilter::k_UseMask_Key, std::make_any<bool>(true));
     args.insertOrAssign(AlignSectionsMutualInformationFilter::k_SelectedImageGeometry_Key, std::make_any<DataPath>(Constants::k_DataContainerPath));
     args.insertOrAssign(AlignSectionsMutualInformationFilter::k_QuatsArrayPath_Key, std::make_any<DataPath>(Constants::k_QuatsArrayPath));
@@ -185,3 +186,40 @@ TEST_CASE("OrientationAnalysis::AlignSectionsMutualInformationFilter: InValid fi
   COMPLEX_RESULT_REQUIRE_INVALID(preflightResult.outputActions);
   REQUIRE(preflightResult.outputActions.errors()[0].code == -3542);
 }
+
+TEST_CASE("OrientationAnalysis::AlignSectionsMutualInformationFilter: Coarse to fine search")
+{
+  const SizeVec3 dims = {256, 256, 4};
+  // The grains are larger than for the misorientation search since the mutual information needs several samples per grain on the coarsest level
+  DataStructure dataStructure = ShiftedGrainStack::CreateDataStructure(dims, 24);
+  const fs::path shiftsFile = fmt::format("{}/align_sections_mutual_information_coarse_to_fine.txt", unit_test::k_BinaryTestOutputDir);
+
+  {
+    AlignSectionsMutualInformationFilter filter;
+    Arguments args;
+    args.insertOrAssign(AlignSectionsMutualInformationFilter::k_WriteAlignmentShifts_Key, std::make_any<bool>(true));
+    args.insertOrAssign(AlignSectionsMutualInformationFilter::k_AlignmentShiftFileName_Key, std::make_any<FileSystemPathParameter::ValueType>(shiftsFile));
+    args.insertOrAssign(AlignSectionsMutualInformationFilter::k_MisorientationTolerance_Key, std::make_any<float32>(5.0f));
+    args.insertOrAssign(AlignSectionsMutualInformationFilter::k_UseCoarseToFineSearch_Key, std::make_any<bool>(true));
+    args.insertOrAssign(AlignSectionsMutualInformationFilter::k_UseMask_Key, std::make_any<bool>(false));
+    args.insertOrAssign(AlignSectionsMutualInformationFilter::k_SelectedImageGeometry_Key, std::make_any<DataPath>(Constants::k_DataContainerPath));
+    args.insertOrAssign(AlignSectionsMutualInformationFilter::k_QuatsArrayPath_Key, std::make_any<DataPath>(Constants::k_QuatsArrayPath));
+    args.insertOrAssign(AlignSectionsMutualInformationFilter::k_CellPhasesArrayPath_Key, std::make_any<DataPath>(Constants::k_PhasesArrayPath));
+    args.insertOrAssign(AlignSectionsMutualInformationFilter::k_MaskArrayPath_Key, std::make_any<DataPath>(Constants::k_MaskArrayPath));
+    args.insertOrAssign(AlignSectionsMutualInformationFilter::k_CrystalStructuresArrayPath_Key, std::make_any<DataPath>(Constants::k_CrystalStructuresArrayPath));
+
+    auto preflightResult = filter.preflight(dataStructure, args);
+    COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions)
+
+    auto executeResult = filter.execute(dataStructure, args);
+    COMPLEX_RESULT_REQUIRE_VALID(executeResult.result)
+  }
+
+  // Every slice is shifted by more than the 7x7 neighborhood of a single search level
+  const std::vector<std::array<int64, 2>> shifts = ShiftedGrainStack::ReadRelativeShifts(shiftsFile);
+  REQUIRE(shifts.size() == dims[2] - 1);
+  for(const std::array<int64, 2>& shift : shifts)
+  {
+    REQUIRE(shift == ShiftedGrainStack::k_SliceShift);
+  }
+}
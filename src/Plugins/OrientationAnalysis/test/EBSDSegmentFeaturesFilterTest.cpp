@@ -10,12 +10,125 @@
 #include "complex/Parameters/GeometrySelectionParameter.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
 
+#include "EbsdLib/Core/EbsdLibConstants.h"
+
+#include <cmath>
 #include <filesystem>
+#include <random>
 
 namespace fs = std::filesystem;
 using namespace complex;
 using namespace complex::Constants;
 
+namespace
+{
+const SizeVec3 k_GeneratedDims = {37, 31, 11};
+const std::string k_GeneratedFeatureIdsName = "Generated FeatureIds";
+const std::string k_GeneratedFeatureDataName = "Generated Feature Data";
+
+/**
+ * @brief Creates an image geometry made of blocks that each hold a slightly perturbed copy of
+ * one of a few orientations. Neighboring blocks may share an orientation so features also span
+ * several blocks. If serial is true the quaternions are stored in a SerialDataStore so the filter
+ * uses the serial flood fill.
+ */
+DataStructure CreateGeneratedData(bool serial)
+{
+  DataStructure dataStructure;
+  auto* imageGeom = ImageGeom::Create(dataStructure, k_DataContainer);
+  imageGeom->setDimensions(k_GeneratedDims);
+  const std::vector<usize> tupleShape = {k_GeneratedDims[2], k_GeneratedDims[1], k_GeneratedDims[0]};
+  auto* cellData = AttributeMatrix::Create(dataStructure, k_CellData, tupleShape, imageGeom->getId());
+  imageGeom->setCellData(*cellData);
+
+  Float32Array* quats = serial ? Float32Array::CreateWithStore<UnitTest::SerialDataStore<float32>>(dataStructure, k_Quats, tupleShape, {4}, cellData->getId())
+                               : UnitTest::CreateTestDataArray<float32>(dataStructure, k_Quats, tupleShape, {4}, cellData->getId());
+  Int32Array* phases = UnitTest::CreateTestDataArray<int32>(dataStructure, k_Phases, tupleShape, {1}, cellData->getId());
+  BoolArray* mask = UnitTest::CreateTestDataArray<bool>(dataStructure, k_Mask, tupleShape, {1}, cellData->getId());
+
+  auto* ensembleData = AttributeMatrix::Create(dataStructure, k_CellEnsembleData, {2}, imageGeom->getId());
+  UInt32Array* crystalStructures = UnitTest::CreateTestDataArray<uint32>(dataStructure, k_CrystalStructures, {2}, {1}, ensembleData->getId());
+  (*crystalStructures)[0] = EbsdLib::CrystalStructure::UnknownCrystalStructure;
+  (*crystalStructures)[1] = EbsdLib::CrystalStructure::Cubic_High;
+
+  std::mt19937_64 generator(4321u);
+  std::normal_distribution<float64> normalDistribution(0.0, 1.0);
+  std::uniform_int_distribution<int32> maskDistribution(0, 9);
+  auto randomQuat = [&](float64 scale, const std::array<float64, 4>& base) {
+    std::array<float64, 4> quat = {};
+    float64 norm = 0.0;
+    for(usize i = 0; i < 4; i++)
+    {
+      quat[i] = base[i] + scale * normalDistribution(generator);
+      norm += quat[i] * quat[i];
+    }
+    for(float64& value : quat)
+    {
+      value /= std::sqrt(norm);
+    }
+    return quat;
+  };
+  std::vector<std::array<float64, 4>> orientations;
+  for(usize i = 0; i < 5; i++)
+  {
+    orientations.push_back(randomQuat(1.0, {0.0, 0.0, 0.0, 0.0}));
+  }
+
+  usize index = 0;
+  for(usize z = 0; z < k_GeneratedDims[2]; z++)
+  {
+    for(usize y = 0; y < k_GeneratedDims[1]; y++)
+    {
+      for(usize x = 0; x < k_GeneratedDims[0]; x++)
+      {
+        const usize block = x / 6 + 2 * (y / 5) + 3 * (z / 4);
+        // Roughly half a degree of noise keeps the voxels of a block within the tolerance
+        const std::array<float64, 4> quat = randomQuat(0.002, orientations[block % orientations.size()]);
+        for(usize i = 0; i < 4; i++)
+        {
+          (*quats)[index * 4 + i] = static_cast<float32>(quat[i]);
+        }
+        (*phases)[index] = 1;
+        (*mask)[index] = maskDistribution(generator) != 0;
+        index++;
+      }
+    }
+  }
+  return dataStructure;
+}
+
+/**
+ * @brief Segments the generated data and returns the number of features found.
+ */
+usize SegmentGeneratedData(DataStructure& dataStructure, bool useMask)
+{
+  EBSDSegmentFeaturesFilter filter;
+  Arguments args;
+  const DataPath geometryPath({k_DataContainer});
+  const DataPath cellDataPath = geometryPath.createChildPath(k_CellData);
+  args.insertOrAssign(EBSDSegmentFeaturesFilter::k_MisorientationTolerance_Key, std::make_any<float32>(5.0F));
+  args.insertOrAssign(EBSDSegmentFeaturesFilter::k_UseMask_Key, std::make_any<bool>(useMask));
+  args.insertOrAssign(EBSDSegmentFeaturesFilter::k_GridGeomPath_Key, std::make_any<DataPath>(geometryPath));
+  args.insertOrAssign(EBSDSegmentFeaturesFilter::k_QuatsArrayPath_Key, std::make_any<DataPath>(cellDataPath.createChildPath(k_Quats)));
+  args.insertOrAssign(EBSDSegmentFeaturesFilter::k_CellPhasesArrayPath_Key, std::make_any<DataPath>(cellDataPath.createChildPath(k_Phases)));
+  args.insertOrAssign(EBSDSegmentFeaturesFilter::k_MaskArrayPath_Key, std::make_any<DataPath>(cellDataPath.createChildPath(k_Mask)));
+  args.insertOrAssign(EBSDSegmentFeaturesFilter::k_CrystalStructuresArrayPath_Key,
+                      std::make_any<DataPath>(geometryPath.createChildPath(k_CellEnsembleData).createChildPath(k_CrystalStructures)));
+  args.insertOrAssign(EBSDSegmentFeaturesFilter::k_FeatureIdsArrayName_Key, std::make_any<std::string>(k_GeneratedFeatureIdsName));
+  args.insertOrAssign(EBSDSegmentFeaturesFilter::k_CellFeatureAttributeMatrixName_Key, std::make_any<std::string>(k_GeneratedFeatureDataName));
+  args.insertOrAssign(EBSDSegmentFeaturesFilter::k_ActiveArrayName_Key, std::make_any<std::string>(k_ActiveName));
+  args.insertOrAssign(EBSDSegmentFeaturesFilter::k_RandomizeFeatures_Key, std::make_any<bool>(false));
+
+  auto preflightResult = filter.preflight(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(preflightResult.outputActions);
+
+  auto executeResult = filter.execute(dataStructure, args);
+  COMPLEX_RESULT_REQUIRE_VALID(executeResult.result);
+
+  return dataStructure.getDataRefAs<UInt8Array>(geometryPath.createChildPath(k_GeneratedFeatureDataName).createChildPath(k_ActiveName)).getNumberOfTuples();
+}
+} // namespace
+
 TEST_CASE("OrientationAnalysis::EBSDSegmentFeatures: Valid Execution", "[OrientationAnalysis][EBSDSegmentFeatures]")
 {
   Application::GetOrCreateInstance()->loadPlugins(unit_test::k_BuildDir.view(), true);
@@ -92,3 +205,20 @@ TEST_CASE("OrientationAnalysis::EBSDSegmentFeatures: Valid Execution", "[Orienta
     UnitTest::CompareDataArrays<int32>(generatedDataArray, exemplarDataArray);
   }
 }
+
+TEST_CASE("OrientationAnalysis::EBSDSegmentFeatures: Parallel matches serial", "[OrientationAnalysis][EBSDSegmentFeatures]")
+{
+  const bool useMask = GENERATE(false, true);
+  INFO(fmt::format("Use Mask = {}", useMask));
+
+  DataStructure parallelDataStructure = CreateGeneratedData(false);
+  DataStructure serialDataStructure = CreateGeneratedData(true);
+  const usize parallelFeatureCount = SegmentGeneratedData(parallelDataStructure, useMask);
+  const usize serialFeatureCount = SegmentGeneratedData(serialDataStructure, useMask);
+  REQUIRE(parallelFeatureCount > 2);
+  REQUIRE(parallelFeatureCount == serialFeatureCount);
+
+  const DataPath featureIdsPath({k_DataContainer, k_CellData, k_GeneratedFeatureIdsName});
+  UnitTest::ComparePartitions(parallelDataStructure.getDataRefAs<Int32Array>(featureIdsPath).getDataStoreRef(),
+                              serialDataStructure.getDataRefAs<Int32Array>(featureIdsPath).getDataStoreRef());
+}
@@ -1,6 +1,9 @@
+#include "OrientationAnalysis/Filters/Algorithms/FindKernelAvgMisorientations.hpp"
 #include "OrientationAnalysis/Filters/FindKernelAvgMisorientationsFilter.hpp"
 #include "OrientationAnalysis/OrientationAnalysis_test_dirs.hpp"
 
+#include "complex/DataStructure/AttributeMatrix.hpp"
+#include "complex/DataStructure/Geometry/ImageGeom.hpp"
 #include "complex/Parameters/ArrayCreationParameter.hpp"
 #include "complex/Parameters/ChoicesParameter.hpp"
 #include "complex/Parameters/VectorParameter.hpp"
@@ -8,7 +11,12 @@
 
 #include <catch2/catch.hpp>
 
+#include "EbsdLib/Core/EbsdLibConstants.h"
+
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
+#include <random>
 
 namespace fs = std::filesystem;
 using namespace complex;
@@ -19,6 +27,70 @@ namespace
 {
 const std::string k_KernelAverageMisorientationsArrayName_Exemplar("KernelAverageMisorientations");
 const std::string k_KernelAverageMisorientationsArrayName("CalculatedKernelAverageMisorientations");
+
+std::vector<float32> RunOnRandomOrientations(const std::vector<int32>& kernelSize, usize slabDepth)
+{
+  const SizeVec3 dims = {11, 9, 13};
+  const std::vector<usize> cellShape = {dims[2], dims[1], dims[0]};
+  const DataPath geomPath({k_DataContainer});
+  const DataPath cellDataPath = geomPath.createChildPath(k_CellData);
+  const DataPath ensembleDataPath = geomPath.createChildPath(k_EnsembleAttributeMatrix);
+
+  DataStructure dataStructure;
+  auto* imageGeom = ImageGeom::Create(dataStructure, k_DataContainer);
+  imageGeom->setDimensions(dims);
+  auto* cellData = AttributeMatrix::Create(dataStructure, k_CellData, cellShape, imageGeom->getId());
+  imageGeom->setCellData(*cellData);
+  auto* featureIds = UnitTest::CreateTestDataArray<int32>(dataStructure, k_FeatureIds, cellShape, {1}, cellData->getId());
+  auto* phases = UnitTest::CreateTestDataArray<int32>(dataStructure, k_Phases, cellShape, {1}, cellData->getId());
+  auto* quats = UnitTest::CreateTestDataArray<float32>(dataStructure, k_Quats, cellShape, {4}, cellData->getId());
+  UnitTest::CreateTestDataArray<float32>(dataStructure, k_KernelAverageMisorientationsArrayName, cellShape, {1}, cellData->getId());
+  auto* ensembleData = AttributeMatrix::Create(dataStructure, k_EnsembleAttributeMatrix, {2}, imageGeom->getId());
+  auto* crystalStructures = UnitTest::CreateTestDataArray<uint32>(dataStructure, k_CrystalStructures, {2}, {1}, ensembleData->getId());
+  (*crystalStructures)[0] = EbsdLib::CrystalStructure::UnknownCrystalStructure;
+  (*crystalStructures)[1] = EbsdLib::CrystalStructure::Cubic_High;
+
+  std::mt19937_64 generator(std::mt19937_64::default_seed);
+  std::uniform_real_distribution<float32> distribution(-1.0f, 1.0f);
+  usize index = 0;
+  for(usize z = 0; z < dims[2]; z++)
+  {
+    for(usize y = 0; y < dims[1]; y++)
+    {
+      for(usize x = 0; x < dims[0]; x++)
+      {
+        (*featureIds)[index] = static_cast<int32>(1 + x / 4 + 3 * (y / 4) + 9 * (z / 5));
+        (*phases)[index] = 1;
+        std::array<float32, 4> quat = {distribution(generator), distribution(generator), distribution(generator), distribution(generator)};
+        const float32 norm = std::sqrt(quat[0] * quat[0] + quat[1] * quat[1] + quat[2] * quat[2] + quat[3] * quat[3]);
+        for(usize comp = 0; comp < 4; comp++)
+        {
+          quats->getDataStoreRef().setComponent(index, comp, quat[comp] / norm);
+        }
+        index++;
+      }
+    }
+  }
+
+  FindKernelAvgMisorientationsInputValues inputValues;
+  inputValues.KernelSize = kernelSize;
+  inputValues.FeatureIdsArrayPath = cellDataPath.createChildPath(k_FeatureIds);
+  inputValues.CellPhasesArrayPath = cellDataPath.createChildPath(k_Phases);
+  inputValues.QuatsArrayPath = cellDataPath.createChildPath(k_Quats);
+  inputValues.CrystalStructuresArrayPath = ensembleDataPath.createChildPath(k_CrystalStructures);
+  inputValues.KernelAverageMisorientationsArrayName = cellDataPath.createChildPath(k_KernelAverageMisorientationsArrayName);
+  inputValues.InputImageGeometry = geomPath;
+  inputValues.HaloWidth = static_cast<usize>(kernelSize[2]);
+  inputValues.SlabDepth = slabDepth;
+
+  const std::atomic_bool shouldCancel = false;
+  const IFilter::MessageHandler messageHandler{};
+  auto result = FindKernelAvgMisorientations(dataStructure, messageHandler, shouldCancel, &inputValues)();
+  COMPLEX_RESULT_REQUIRE_VALID(result)
+
+  const auto& kernelAvgMisorientations = dataStructure.getDataRefAs<Float32Array>(inputValues.KernelAverageMisorientationsArrayName);
+  return {kernelAvgMisorientations.begin(), kernelAvgMisorientations.end()};
+}
 } // namespace
 
 TEST_CASE("OrientationAnalysis::FindKernelAvgMisorientationsFilter", "[OrientationAnalysis][FindKernelAvgMisorientationsFilter]")
@@ -72,3 +144,13 @@ TEST_CASE("OrientationAnalysis::FindKernelAvgMisorientationsFilter", "[Orientati
   WriteTestDataStructure(dataStructure, fs::path(fmt::format("{}/find_kernel_average_misorientations.dream3d", unit_test::k_BinaryTestOutputDir)));
 #endif
 }
+
+TEST_CASE("OrientationAnalysis::FindKernelAvgMisorientationsFilter: Slabs Match Whole Volume", "[OrientationAnalysis][FindKernelAvgMisorientationsFilter]")
+{
+  const std::vector<int32> kernelSize = GENERATE(std::vector<int32>{1, 1, 1}, std::vector<int32>{2, 1, 3});
+
+  const std::vector<float32> wholeVolume = RunOnRandomOrientations(kernelSize, 0);
+  const std::vector<float32> slabs = RunOnRandomOrientations(kernelSize, 2);
+  REQUIRE(std::find_if(wholeVolume.begin(), wholeVolume.end(), [](float32 value) { return value > 0.0f; }) != wholeVolume.end());
+  REQUIRE(slabs == wholeVolume);
+}
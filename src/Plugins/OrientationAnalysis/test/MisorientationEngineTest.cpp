@@ -0,0 +1,136 @@
+#include <catch2/catch.hpp>
+
+#include "OrientationAnalysis/Math/MisorientationEngine.hpp"
+
+#include "complex/Common/Numbers.hpp"
+
+#include "EbsdLib/LaueOps/LaueOps.h"
+
+#include <fmt/format.h>
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace complex;
+
+namespace
+{
+constexpr float64 k_Tolerance = 1.0E-4;
+constexpr usize k_NumQuats = 3 * MisorientationEngine::k_BatchSize + 5;
+
+/**
+ * @brief Returns numQuats random unit quaternions in the (x, y, z, w) layout.
+ */
+std::vector<float32> CreateRandomQuats(usize numQuats, std::mt19937_64& generator)
+{
+  std::normal_distribution<float64> distribution(0.0, 1.0);
+  std::vector<float32> quats(numQuats * 4);
+  for(usize i = 0; i < numQuats; i++)
+  {
+    std::array<float64, 4> values = {distribution(generator), distribution(generator), distribution(generator), distribution(generator)};
+    const float64 norm = std::sqrt(values[0] * values[0] + values[1] * values[1] + values[2] * values[2] + values[3] * values[3]);
+    for(usize j = 0; j < 4; j++)
+    {
+      quats[i * 4 + j] = static_cast<float32>(values[j] / norm);
+    }
+  }
+  return quats;
+}
+
+float64 ExpectedAngle(const LaueOps::Pointer& ops, const float32* q1, const float32* q2)
+{
+  const QuatD quat1(q1[0], q1[1], q1[2], q1[3]);
+  const QuatD quat2(q2[0], q2[1], q2[2], q2[3]);
+  return ops->calculateMisorientation(quat1, quat2)[3];
+}
+} // namespace
+
+TEST_CASE("OrientationAnalysis::MisorientationEngine: Matches LaueOps", "[OrientationAnalysis][MisorientationEngine]")
+{
+  std::mt19937_64 generator(5489u);
+  const std::vector<LaueOps::Pointer> orientationOps = LaueOps::GetAllOrientationOps();
+  const std::vector<MisorientationEngine> engines = MisorientationEngine::CreateAll();
+  REQUIRE(engines.size() == orientationOps.size());
+
+  // Counts that are not a multiple of the batch size leave a partial batch
+  const std::vector<usize> counts = {1, MisorientationEngine::k_BatchSize - 1, MisorientationEngine::k_BatchSize, k_NumQuats};
+
+  for(usize phase = 0; phase < orientationOps.size(); phase++)
+  {
+    const LaueOps::Pointer& ops = orientationOps[phase];
+    const MisorientationEngine& engine = engines[phase];
+    INFO(fmt::format("Laue class = {}", ops->getSymmetryName()));
+
+    const std::vector<float32> quats1 = CreateRandomQuats(k_NumQuats, generator);
+    const std::vector<float32> quats2 = CreateRandomQuats(k_NumQuats, generator);
+    std::vector<float64> expected(k_NumQuats);
+    std::vector<float64> expectedToFirst(k_NumQuats);
+    for(usize i = 0; i < k_NumQuats; i++)
+    {
+      expected[i] = ExpectedAngle(ops, quats1.data() + i * 4, quats2.data() + i * 4);
+      expectedToFirst[i] = ExpectedAngle(ops, quats1.data(), quats2.data() + i * 4);
+    }
+
+    SECTION("angle")
+    {
+      for(usize i = 0; i < k_NumQuats; i++)
+      {
+        const float32* q1 = quats1.data() + i * 4;
+        const float32* q2 = quats2.data() + i * 4;
+        REQUIRE(std::abs(engine.angle(q1, q2) - expected[i]) < k_Tolerance);
+        REQUIRE(std::abs(engine.angle(QuatF(q1[0], q1[1], q1[2], q1[3]), QuatF(q2[0], q2[1], q2[2], q2[3])) - expected[i]) < k_Tolerance);
+        REQUIRE(std::abs(engine.angle(QuatD(q1[0], q1[1], q1[2], q1[3]), QuatD(q2[0], q2[1], q2[2], q2[3])) - expected[i]) < k_Tolerance);
+      }
+    }
+
+    SECTION("angles")
+    {
+      for(usize count : counts)
+      {
+        INFO(fmt::format("Count = {}", count));
+        const nonstd::span<const float32> quats2Span(quats2.data(), count * 4);
+        std::vector<float64> angles(count, -1.0);
+        engine.angles(nonstd::span<const float32>(quats1.data(), count * 4), quats2Span, angles);
+        for(usize i = 0; i < count; i++)
+        {
+          REQUIRE(std::abs(angles[i] - expected[i]) < k_Tolerance);
+        }
+
+        // A single quaternion is compared against every quaternion of quats2
+        std::vector<float64> anglesToFirst(count, -1.0);
+        engine.angles(nonstd::span<const float32>(quats1.data(), 4), quats2Span, anglesToFirst);
+        for(usize i = 0; i < count; i++)
+        {
+          REQUIRE(std::abs(anglesToFirst[i] - expectedToFirst[i]) < k_Tolerance);
+        }
+      }
+    }
+
+    SECTION("isLessThan")
+    {
+      for(float64 thresholdDegrees : {5.0, 15.0, 45.0})
+      {
+        const float64 threshold = thresholdDegrees * numbers::pi / 180.0;
+        const float64 halfAngleCosine = MisorientationEngine::HalfAngleCosine(threshold);
+        for(usize i = 0; i < k_NumQuats; i++)
+        {
+          // Angles within the tolerance of the threshold may fall on either side of it
+          if(std::abs(expected[i] - threshold) < k_Tolerance)
+          {
+            continue;
+          }
+          REQUIRE(engine.isLessThan(quats1.data() + i * 4, quats2.data() + i * 4, halfAngleCosine) == (expected[i] < threshold));
+        }
+      }
+
+      // An orientation is always within the threshold of itself
+      const float64 halfAngleCosine = MisorientationEngine::HalfAngleCosine(5.0 * numbers::pi / 180.0);
+      for(usize i = 0; i < k_NumQuats; i++)
+      {
+        REQUIRE(engine.isLessThan(quats1.data() + i * 4, quats1.data() + i * 4, halfAngleCosine));
+      }
+    }
+  }
+}
@@ -3,6 +3,9 @@
 #include <catch2/catch.hpp>
 
 #include "complex/Common/Uuid.hpp"
+#include "complex/DataStructure/AttributeMatrix.hpp"
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/Geometry/ImageGeom.hpp"
 #include "complex/Filter/FilterHandle.hpp"
 #include "complex/Parameters/ArrayThresholdsParameter.hpp"
 #include "complex/Parameters/ChoicesParameter.hpp"
@@ -10,9 +13,13 @@
 #include "complex/Parameters/GeometrySelectionParameter.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
 
+#include "EbsdLib/Core/EbsdLibConstants.h"
+
 #include <fmt/format.h>
 
 #include <filesystem>
+#include <fstream>
+#include <random>
 
 namespace fs = std::filesystem;
 
@@ -328,3 +335,124 @@ inline void ExecuteNeighborOrientationCorrelation(DataStructure& dataStructure,
   COMPLEX_RESULT_REQUIRE_VALID(executeResult.result)
 }
 } // namespace SmallIn100
+
+namespace ShiftedGrainStack
+{
+// Shift of every slice against the slice above it, larger than the 7x7 neighborhood the alignment filters search
+inline constexpr std::array<int64, 2> k_SliceShift = {13, -11};
+
+//------------------------------------------------------------------------------
+/**
+ * @brief Creates an image geometry whose slices are all cut from the same map of randomly
+ * oriented grains, with every slice shifted by k_SliceShift against the slice above it.
+ * @param dims
+ * @param grainSize The approximate edge length of the grains in cells
+ * @return DataStructure
+ */
+inline DataStructure CreateDataStructure(const SizeVec3& dims, int64 grainSize)
+{
+  DataStructure dataStructure;
+  auto* imageGeom = ImageGeom::Create(dataStructure, Constants::k_DataContainer);
+  imageGeom->setDimensions(dims);
+  const std::vector<usize> tupleShape = {dims[2], dims[1], dims[0]};
+  auto* cellData = AttributeMatrix::Create(dataStructure, Constants::k_CellData, tupleShape, imageGeom->getId());
+  imageGeom->setCellData(*cellData);
+
+  Float32Array* quats = UnitTest::CreateTestDataArray<float32>(dataStructure, Constants::k_Quats, tupleShape, {4}, cellData->getId());
+  Int32Array* phases = UnitTest::CreateTestDataArray<int32>(dataStructure, Constants::k_Phases, tupleShape, {1}, cellData->getId());
+  BoolArray* mask = UnitTest::CreateTestDataArray<bool>(dataStructure, Constants::k_Mask, tupleShape, {1}, cellData->getId());
+  phases->fill(1);
+  mask->fill(true);
+
+  auto* ensembleData = AttributeMatrix::Create(dataStructure, Constants::k_EnsembleAttributeMatrix, {2}, imageGeom->getId());
+  UInt32Array* crystalStructures = UnitTest::CreateTestDataArray<uint32>(dataStructure, Constants::k_CrystalStructures, {2}, {1}, ensembleData->getId());
+  (*crystalStructures)[0] = EbsdLib::CrystalStructure::UnknownCrystalStructure;
+  (*crystalStructures)[1] = EbsdLib::CrystalStructure::Cubic_High;
+
+  // One grain center is placed at random inside every cell of a coarse grid that covers the shifted slices
+  const int64 offsetX = k_SliceShift[0] < 0 ? -k_SliceShift[0] * static_cast<int64>(dims[2] - 1) : 0;
+  const int64 offsetY = k_SliceShift[1] < 0 ? -k_SliceShift[1] * static_cast<int64>(dims[2] - 1) : 0;
+  const int64 mapDimX = static_cast<int64>(dims[0]) + std::abs(k_SliceShift[0]) * static_cast<int64>(dims[2] - 1);
+  const int64 mapDimY = static_cast<int64>(dims[1]) + std::abs(k_SliceShift[1]) * static_cast<int64>(dims[2] - 1);
+  const int64 gridDimX = mapDimX / grainSize + 1;
+  const int64 gridDimY = mapDimY / grainSize + 1;
+
+  std::mt19937_64 generator(1234u);
+  std::uniform_real_distribution<float64> centerDistribution(0.0, static_cast<float64>(grainSize));
+  std::normal_distribution<float64> normalDistribution(0.0, 1.0);
+  std::vector<std::array<float64, 2>> centers(gridDimX * gridDimY);
+  std::vector<std::array<float32, 4>> orientations(gridDimX * gridDimY);
+  for(int64 i = 0; i < gridDimX * gridDimY; i++)
+  {
+    centers[i] = {static_cast<float64>((i % gridDimX) * grainSize) + centerDistribution(generator), static_cast<float64>((i / gridDimX) * grainSize) + centerDistribution(generator)};
+    std::array<float64, 4> quat = {normalDistribution(generator), normalDistribution(generator), normalDistribution(generator), normalDistribution(generator)};
+    const float64 norm = std::sqrt(quat[0] * quat[0] + quat[1] * quat[1] + quat[2] * quat[2] + quat[3] * quat[3]);
+    for(usize j = 0; j < 4; j++)
+    {
+      orientations[i][j] = static_cast<float32>(quat[j] / norm);
+    }
+  }
+
+  // Each cell takes the orientation of the closest grain center
+  auto grainAt = [&](int64 mapX, int64 mapY) {
+    const int64 gridX = mapX / grainSize;
+    const int64 gridY = mapY / grainSize;
+    int64 closest = 0;
+    float64 minDistance = std::numeric_limits<float64>::max();
+    for(int64 y = std::max<int64>(gridY - 1, 0); y <= std::min(gridY + 1, gridDimY - 1); y++)
+    {
+      for(int64 x = std::max<int64>(gridX - 1, 0); x <= std::min(gridX + 1, gridDimX - 1); x++)
+      {
+        const std::array<float64, 2>& center = centers[y * gridDimX + x];
+        const float64 distance = std::pow(center[0] - static_cast<float64>(mapX), 2) + std::pow(center[1] - static_cast<float64>(mapY), 2);
+        if(distance < minDistance)
+        {
+          minDistance = distance;
+          closest = y * gridDimX + x;
+        }
+      }
+    }
+    return closest;
+  };
+
+  usize index = 0;
+  for(int64 z = 0; z < static_cast<int64>(dims[2]); z++)
+  {
+    for(int64 y = 0; y < static_cast<int64>(dims[1]); y++)
+    {
+      for(int64 x = 0; x < static_cast<int64>(dims[0]); x++)
+      {
+        const std::array<float32, 4>& quat = orientations[grainAt(x + z * k_SliceShift[0] + offsetX, y + z * k_SliceShift[1] + offsetY)];
+        for(usize j = 0; j < 4; j++)
+        {
+          (*quats)[index * 4 + j] = quat[j];
+        }
+        index++;
+      }
+    }
+  }
+  return dataStructure;
+}
+
+//------------------------------------------------------------------------------
+/**
+ * @brief Reads the shift of every slice against the slice above it from a shifts file written by an alignment filter.
+ * @param shiftsFile
+ * @return std::vector<std::array<int64, 2>>
+ */
+inline std::vector<std::array<int64, 2>> ReadRelativeShifts(const fs::path& shiftsFile)
+{
+  std::ifstream inStream(shiftsFile);
+  REQUIRE(inStream.is_open());
+  std::vector<std::array<int64, 2>> shifts;
+  int64 slice = 0;
+  int64 sliceAbove = 0;
+  std::array<int64, 2> shift = {};
+  std::array<int64, 2> totalShift = {};
+  while(inStream >> slice >> sliceAbove >> shift[0] >> shift[1] >> totalShift[0] >> totalShift[1])
+  {
+    shifts.push_back(shift);
+  }
+  return shifts;
+}
+} // namespace ShiftedGrainStack
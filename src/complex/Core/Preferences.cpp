@@ -75,6 +75,7 @@ void Preferences::setDefaultValues()
 
   m_DefaultValues[k_LargeDataSize_Key] = k_LargeDataSize;
   m_DefaultValues[k_PreferredLargeDataFormat_Key] = k_LargeDataFormat;
+  m_DefaultValues[k_MmapDirectory_Key] = "";
 
   updateMemoryDefaults();
 
@@ -238,7 +239,7 @@ Result<> Preferences::loadFromFile(const std::filesystem::path& filepath)
 
 void Preferences::checkUseOoc()
 {
-  m_UseOoc = !value(k_PreferredLargeDataFormat_Key).empty();
+  m_UseOoc = !largeDataFormat().empty();
 }
 
 bool Preferences::useOocData() const
@@ -264,6 +265,21 @@ void Preferences::setForceOocData(bool forceOoc)
   setValue(k_ForceOocData_Key, forceOoc);
 }
 
+std::filesystem::path Preferences::mmapDirectory() const
+{
+  const auto directory = valueAs<std::string>(k_MmapDirectory_Key);
+  if(directory.empty())
+  {
+    return std::filesystem::temp_directory_path();
+  }
+  return directory;
+}
+
+void Preferences::setMmapDirectory(const std::filesystem::path& directory)
+{
+  setValue(k_MmapDirectory_Key, directory.string());
+}
+
 void Preferences::updateMemoryDefaults()
 {
   const uint64 minimumRemaining = 2 * defaultValueAs<uint64>(k_LargeDataSize_Key);
@@ -23,6 +23,7 @@ public:
   static inline constexpr StringLiteral k_PreferredLargeDataFormat_Key = "large_data_format";
   static inline constexpr StringLiteral k_LargeDataStructureSize_Key = "large_datastructure_size";
   static inline constexpr StringLiteral k_ForceOocData_Key = "force_ooc_data";
+  static inline constexpr StringLiteral k_MmapDirectory_Key = "mmap_directory";
 
   static std::filesystem::path DefaultFilePath(const std::string& applicationName);
 
@@ -85,6 +86,14 @@ public:
 
   void setForceOocData(bool forceOoc);
 
+  /**
+   * @brief Returns the directory memory mapped data stores create their backing
+   * files in. Returns the system temp directory if no directory was set.
+   * @return std::filesystem::path
+   */
+  std::filesystem::path mmapDirectory() const;
+  void setMmapDirectory(const std::filesystem::path& directory);
+
   void updateMemoryDefaults();
   uint64 largeDataStructureSize() const;
 
@@ -5,11 +5,15 @@
 #include "complex/DataStructure/DataObject.hpp"
 #include "complex/DataStructure/IDataStore.hpp"
 
+#include <fmt/core.h>
 #include <nonstd/span.hpp>
 
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
 #include <vector>
 
 namespace complex
@@ -27,6 +31,9 @@ class AbstractDataStore : public IDataStore
 {
 public:
   using value_type = T;
+
+  // Number of values borrowed at a time from stores that are neither contiguous nor chunked
+  static constexpr usize k_DefaultBlockSize = 1024 * 1024;
   using reference = T&;
   using const_reference = const T&;
   using ShapeType = typename IDataStore::ShapeType;
@@ -678,6 +685,7 @@ public:
    */
   Iterator begin()
   {
+    prepareForWrite();
     return Iterator(*this, 0);
   }
 
@@ -814,13 +822,264 @@ public:
       return false;
     }
 
-    auto srcBegin = source.begin() + (srcTupleOffset * sourceNumComponents);
-    auto srcEnd = srcBegin + (totalSrcTuples * sourceNumComponents);
-    auto dstBegin = begin() + (destTupleOffset * numComponents);
+    const usize srcIndex = srcTupleOffset * sourceNumComponents;
+    const usize destIndex = destTupleOffset * numComponents;
+    const usize count = totalSrcTuples * sourceNumComponents;
+    if(count == 0)
+    {
+      return true;
+    }
+    if(T* destValues = getContiguousValues(destIndex); destValues != nullptr)
+    {
+      return source.copyIntoBuffer(srcIndex, nonstd::span<T>(destValues, count));
+    }
+    if(const T* srcValues = source.getContiguousValues(srcIndex); srcValues != nullptr)
+    {
+      return copyFromBuffer(destIndex, nonstd::span<const T>(srcValues, count));
+    }
+
+    auto srcBegin = source.begin() + srcIndex;
+    auto srcEnd = srcBegin + count;
+    auto dstBegin = begin() + destIndex;
     std::copy(srcBegin, srcEnd, dstBegin);
     return true;
   }
 
+  /**
+   * @brief Returns a pointer to the value at startIndex if the DataStore keeps
+   * its values in a single contiguous buffer in memory. Returns nullptr otherwise.
+   * @param startIndex
+   * @return const T*
+   */
+  virtual const T* getContiguousValues(usize startIndex) const
+  {
+    return nullptr;
+  }
+
+  /**
+   * @brief Returns a pointer to the value at startIndex if the DataStore keeps
+   * its values in a single contiguous buffer in memory. Returns nullptr otherwise.
+   * @param startIndex
+   * @return T*
+   */
+  virtual T* getContiguousValues(usize startIndex)
+  {
+    return nullptr;
+  }
+
+  /**
+   * @brief Copies buffer.size() values starting at startIndex into the buffer.
+   * Returns false without copying if the range is out of bounds.
+   * @param startIndex
+   * @param buffer
+   * @return bool
+   */
+  virtual bool copyIntoBuffer(usize startIndex, nonstd::span<T> buffer) const
+  {
+    if(startIndex + buffer.size() > getSize())
+    {
+      return false;
+    }
+    if(const T* values = getContiguousValues(startIndex); values != nullptr)
+    {
+      std::copy(values, values + buffer.size(), buffer.begin());
+      return true;
+    }
+    for(usize i = 0; i < buffer.size(); i++)
+    {
+      buffer[i] = getValue(startIndex + i);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Copies the values in the buffer into the DataStore starting at startIndex.
+   * Returns false without copying if the range is out of bounds.
+   * @param startIndex
+   * @param buffer
+   * @return bool
+   */
+  virtual bool copyFromBuffer(usize startIndex, nonstd::span<const T> buffer)
+  {
+    if(startIndex + buffer.size() > getSize())
+    {
+      return false;
+    }
+    if(T* values = getContiguousValues(startIndex); values != nullptr)
+    {
+      std::copy(buffer.begin(), buffer.end(), values);
+      return true;
+    }
+    for(usize i = 0; i < buffer.size(); i++)
+    {
+      setValue(startIndex + i, buffer[i]);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Returns the number of values to borrow at a time when walking over the
+   * whole DataStore. Contiguous stores return their size. Chunked stores return
+   * whole rows of chunks along the slowest dimension.
+   * @return usize
+   */
+  usize getPreferredBlockSize() const
+  {
+    const usize size = getSize();
+    if(getContiguousValues(0) != nullptr)
+    {
+      return std::max<usize>(size, 1);
+    }
+    const std::optional<ShapeType> chunkShape = getChunkShape();
+    const ShapeType& tupleShape = getTupleShape();
+    if(chunkShape.has_value() && !chunkShape->empty() && !tupleShape.empty() && tupleShape[0] > 0)
+    {
+      return std::max<usize>((*chunkShape)[0] * (size / tupleShape[0]), 1);
+    }
+    return std::clamp<usize>(size, 1, k_DefaultBlockSize);
+  }
+
+  /**
+   * @brief Read-only view of a range of values. Contiguous stores hand out a pointer
+   * into their buffer. Other stores copy the range into a temporary buffer.
+   */
+  class ConstBorrowedRange
+  {
+  public:
+    ConstBorrowedRange(const AbstractDataStore& dataStore, usize startIndex, usize count)
+    : m_Size(count)
+    {
+      if(startIndex + count > dataStore.getSize())
+      {
+        throw std::out_of_range(fmt::format("Cannot borrow {} values starting at {} from a DataStore of size {}", count, startIndex, dataStore.getSize()));
+      }
+      m_Data = dataStore.getContiguousValues(startIndex);
+      if(m_Data == nullptr && count > 0)
+      {
+        m_Buffer = std::make_unique<T[]>(count);
+        dataStore.copyIntoBuffer(startIndex, nonstd::span<T>(m_Buffer.get(), count));
+        m_Data = m_Buffer.get();
+      }
+    }
+
+    const T* data() const
+    {
+      return m_Data;
+    }
+
+    usize size() const
+    {
+      return m_Size;
+    }
+
+    const T& operator[](usize index) const
+    {
+      return m_Data[index];
+    }
+
+    nonstd::span<const T> span() const
+    {
+      return {m_Data, m_Size};
+    }
+
+  private:
+    std::unique_ptr<T[]> m_Buffer;
+    const T* m_Data = nullptr;
+    usize m_Size = 0;
+  };
+
+  /**
+   * @brief Writable view of a range of values. Contiguous stores hand out a pointer
+   * into their buffer. Other stores copy the range into a temporary buffer that is
+   * written back when the view is destroyed.
+   */
+  class BorrowedRange
+  {
+  public:
+    BorrowedRange(AbstractDataStore& dataStore, usize startIndex, usize count)
+    : m_DataStore(&dataStore)
+    , m_StartIndex(startIndex)
+    , m_Size(count)
+    {
+      if(startIndex + count > dataStore.getSize())
+      {
+        throw std::out_of_range(fmt::format("Cannot borrow {} values starting at {} from a DataStore of size {}", count, startIndex, dataStore.getSize()));
+      }
+      m_Data = dataStore.getContiguousValues(startIndex);
+      if(m_Data == nullptr && count > 0)
+      {
+        m_Buffer = std::make_unique<T[]>(count);
+        dataStore.copyIntoBuffer(startIndex, nonstd::span<T>(m_Buffer.get(), count));
+        m_Data = m_Buffer.get();
+      }
+    }
+
+    ~BorrowedRange() noexcept
+    {
+      if(m_Buffer != nullptr)
+      {
+        m_DataStore->copyFromBuffer(m_StartIndex, nonstd::span<const T>(m_Buffer.get(), m_Size));
+      }
+    }
+
+    BorrowedRange(const BorrowedRange&) = delete;
+    BorrowedRange(BorrowedRange&& other) noexcept = default;
+    BorrowedRange& operator=(const BorrowedRange&) = delete;
+    BorrowedRange& operator=(BorrowedRange&&) noexcept = delete;
+
+    T* data() const
+    {
+      return m_Data;
+    }
+
+    usize size() const
+    {
+      return m_Size;
+    }
+
+    T& operator[](usize index) const
+    {
+      return m_Data[index];
+    }
+
+    nonstd::span<T> span() const
+    {
+      return {m_Data, m_Size};
+    }
+
+  private:
+    AbstractDataStore* m_DataStore = nullptr;
+    usize m_StartIndex = 0;
+    usize m_Size = 0;
+    std::unique_ptr<T[]> m_Buffer;
+    T* m_Data = nullptr;
+  };
+
+  /**
+   * @brief Borrows count values starting at startIndex for reading.
+   * Throws std::out_of_range if the range does not fit in the DataStore.
+   * @param startIndex
+   * @param count
+   * @return ConstBorrowedRange
+   */
+  ConstBorrowedRange borrowRange(usize startIndex, usize count) const
+  {
+    return ConstBorrowedRange(*this, startIndex, count);
+  }
+
+  /**
+   * @brief Borrows count values starting at startIndex for reading and writing.
+   * Values written through the range are visible in the DataStore once the range
+   * is destroyed. Throws std::out_of_range if the range does not fit in the DataStore.
+   * @param startIndex
+   * @param count
+   * @return BorrowedRange
+   */
+  BorrowedRange borrowRange(usize startIndex, usize count)
+  {
+    return BorrowedRange(*this, startIndex, count);
+  }
+
   /**
    * @brief Sets all the components of tuple i to value.
    * @param i
@@ -961,6 +1220,30 @@ public:
     return sizeof(T) * getSize();
   }
 
+  /**
+   * @brief Returns a new DataStore that shares its values with this DataStore
+   * until either of them is prepared for writing with prepareForWrite(), which
+   * copies the values so writes never become visible through the other store.
+   * Returns nullptr if the store type cannot share its values. In that case
+   * copies of the owning DataArray continue to reference this DataStore.
+   * @return std::shared_ptr<AbstractDataStore>
+   */
+  virtual std::shared_ptr<AbstractDataStore> createCopyOnWrite() const
+  {
+    return nullptr;
+  }
+
+  /**
+   * @brief Makes sure that values written through operator[], setValue() and
+   * iterators are not visible through DataStores created by createCopyOnWrite().
+   * Element access does not check this itself, so call it once before writing.
+   * The non-const accessors of DataArray call it. Does nothing for store types
+   * that do not share their values.
+   */
+  virtual void prepareForWrite()
+  {
+  }
+
 protected:
   /**
    * @brief Default constructor
@@ -1,6 +1,7 @@
 #include "BaseGroup.hpp"
 
 #include "complex/DataStructure/DataPath.hpp"
+#include "complex/DataStructure/DataStructure.hpp"
 #include "complex/Utilities/StringUtilities.hpp"
 
 using namespace complex;
@@ -143,6 +144,10 @@ bool BaseGroup::insert(const std::weak_ptr<DataObject>& obj)
   if(m_DataMap.insert(ptr))
   {
     ptr->addParent(this);
+    if(auto* dataStructure = getDataStructure(); dataStructure != nullptr)
+    {
+      dataStructure->invalidatePathIndex();
+    }
     return true;
   }
   return false;
@@ -155,6 +160,10 @@ bool BaseGroup::remove(DataObject* obj)
     return false;
   }
   obj->removeParent(this);
+  if(auto* dataStructure = getDataStructure(); dataStructure != nullptr)
+  {
+    dataStructure->invalidatePathIndex();
+  }
   return m_DataMap.remove(obj->getId());
 }
 
@@ -166,6 +175,10 @@ bool BaseGroup::remove(const std::string& name)
     {
       (*iter).second->removeParent(this);
       m_DataMap.erase(iter);
+      if(auto* dataStructure = getDataStructure(); dataStructure != nullptr)
+      {
+        dataStructure->invalidatePathIndex();
+      }
       return true;
     }
   }
@@ -175,6 +188,10 @@ bool BaseGroup::remove(const std::string& name)
 void BaseGroup::clear()
 {
   m_DataMap.clear();
+  if(auto* dataStructure = getDataStructure(); dataStructure != nullptr)
+  {
+    dataStructure->invalidatePathIndex();
+  }
 }
 
 BaseGroup::Iterator BaseGroup::begin()
@@ -9,6 +9,7 @@
 #include "complex/DataStructure/EmptyDataStore.hpp"
 #include "complex/DataStructure/IDataArray.hpp"
 
+#include <algorithm>
 #include <vector>
 
 namespace complex
@@ -194,11 +195,17 @@ public:
   /**
    * @brief Returns a shallow copy of the DataArray without copying data. THE CALLING CODE
    * MUST DISPOSE OF THE RETURNED OBJECT.
+   *
+   * If the DataStore supports it, the copy references a copy-on-write DataStore
+   * so that values written through either DataArray are not visible through
+   * the other. Otherwise both DataArrays reference the same DataStore.
    * @return DataObject*
    */
   DataObject* shallowCopy() override
   {
-    return new DataArray(*this);
+    auto* copy = new DataArray(*this);
+    copy->m_DataStore = CreateSharedStore(m_DataStore);
+    return copy;
   }
 
   /**
@@ -285,6 +292,7 @@ public:
       throw std::runtime_error("DataArray::operator[] requires a valid DataStore");
     }
 
+    m_DataStore->prepareForWrite();
     return (*m_DataStore.get())[index];
   }
 
@@ -321,6 +329,11 @@ public:
       return;
     }
     const auto numComponents = getNumberOfComponents();
+    if(T* values = m_DataStore->getContiguousValues(0); values != nullptr)
+    {
+      std::copy_n(values + from * numComponents, numComponents, values + to * numComponents);
+      return;
+    }
     for(usize i = 0; i < numComponents; i++)
     {
       usize fromCompIndex = from * numComponents + i;
@@ -388,11 +401,13 @@ public:
   void setComponent(usize tupleIndex, usize componentIndex, value_type value)
   {
     const usize index = tupleIndex * getNumberOfComponents() + componentIndex;
+    m_DataStore->prepareForWrite();
     m_DataStore->setValue(index, value);
   }
 
   void setValue(usize index, value_type value)
   {
+    m_DataStore->prepareForWrite();
     m_DataStore->setValue(index, value);
   }
 
@@ -407,21 +422,25 @@ public:
   }
 
   /**
-   * @brief Returns a raw pointer to the DataStore.
+   * @brief Returns a raw pointer to the DataStore after preparing it for writing.
    * @return DataStore<T>*
    */
   store_type* getDataStore()
   {
+    if(m_DataStore != nullptr)
+    {
+      m_DataStore->prepareForWrite();
+    }
     return m_DataStore.get();
   }
 
   /**
-   * @brief Returns a pointer to the array's IDataStore.
+   * @brief Returns a pointer to the array's IDataStore after preparing it for writing.
    * @return const IDataStore*
    */
   IDataStore* getIDataStore() override
   {
-    return m_DataStore.get();
+    return getDataStore();
   }
 
   /**
@@ -434,7 +453,8 @@ public:
   }
 
   /**
-   * @brief Returns a reference to the DataStore.
+   * @brief Returns a reference to the DataStore after preparing it for writing.
+   * Take the reference before starting worker threads that write to the DataStore.
    * @return DataStore<T>&
    */
   store_type& getDataStoreRef()
@@ -443,6 +463,7 @@ public:
     {
       throw std::runtime_error("DataArray: Null DataStore");
     }
+    m_DataStore->prepareForWrite();
     return *m_DataStore;
   }
 
@@ -479,8 +500,8 @@ public:
 
   /**
    * @brief Sets a new DataStore for the DataArray to handle. The existing DataStore
-   * is deleted if there are no other references. To save the existing DataStore
-   * before replacing it, call releaseDataStore() before setting the new DataStore.
+   * is deleted if there are no other references. To keep the existing DataStore,
+   * hold a reference to it before setting the new DataStore.
    * @param store
    */
   void setDataStore(std::shared_ptr<store_type> store)
@@ -492,6 +513,29 @@ public:
     }
   }
 
+  /**
+   * @brief Replaces the DataStore with an EmptyDataStore of the same shape and
+   * data format. The values are freed once no other DataArray shares them.
+   */
+  void releaseValues() override
+  {
+    m_DataStore = std::make_shared<EmptyDataStore<T>>(getTupleShape(), getComponentShape(), getDataFormat());
+  }
+
+  /**
+   * @brief Makes the array reference the DataStore of source, so writes through
+   * either array are visible through both. Does nothing if source does not hold
+   * the same value type.
+   * @param source
+   */
+  void shareDataStore(const IDataArray& source) override
+  {
+    if(const auto* sourceArray = dynamic_cast<const DataArray*>(&source); sourceArray != nullptr)
+    {
+      m_DataStore = sourceArray->m_DataStore;
+    }
+  }
+
   /**
    * @brief Returns the data format used for storing the array data.
    * @return data format as string
@@ -726,6 +770,22 @@ protected:
   }
 
 private:
+  /**
+   * @brief Returns a copy-on-write DataStore sharing the values of store or
+   * store itself if its type cannot share values.
+   * @param store
+   * @return std::shared_ptr<store_type>
+   */
+  static std::shared_ptr<store_type> CreateSharedStore(const std::shared_ptr<store_type>& store)
+  {
+    if(store == nullptr)
+    {
+      return nullptr;
+    }
+    std::shared_ptr<store_type> copy = store->createCopyOnWrite();
+    return copy != nullptr ? copy : store;
+  }
+
   std::shared_ptr<store_type> m_DataStore = nullptr;
 };
 
@@ -199,6 +199,10 @@ bool DataObject::rename(const std::string& name)
   }
 
   m_Name = name;
+  if(m_DataStructure != nullptr)
+  {
+    m_DataStructure->invalidatePathIndex();
+  }
   return true;
 }
 
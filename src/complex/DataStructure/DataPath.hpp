@@ -3,6 +3,7 @@
 #include "complex/Common/Types.hpp"
 #include "complex/complex_export.hpp"
 
+#include <functional>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -174,3 +175,26 @@ private:
   std::vector<std::string> m_Path;
 };
 } // namespace complex
+
+namespace std
+{
+template <>
+struct hash<::complex::DataPath>
+{
+  /**
+   * @brief Hash operator for placing in a collection that requires hashing values.
+   * @param value
+   * @return std::size_t
+   */
+  std::size_t operator()(const ::complex::DataPath& value) const noexcept
+  {
+    std::hash<std::string> hasher;
+    std::size_t seed = value.getLength();
+    for(::complex::usize i = 0; i < value.getLength(); i++)
+    {
+      seed ^= hasher(value[i]) + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+  }
+};
+} // namespace std
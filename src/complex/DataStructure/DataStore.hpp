@@ -6,10 +6,12 @@
 #include <nonstd/span.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <optional>
 #include <stdexcept>
@@ -21,6 +23,23 @@ namespace complex
  * @class DataStore
  * @brief The DataStore class handles the storing and retrieval of data for
  * use in DataArrays.
+ *
+ * Copies made with createCopyOnWrite() share the value buffer with the source
+ * DataStore. prepareForWrite() copies the values into a buffer owned by the
+ * DataStore if they are shared, so the values seen through the other DataStore
+ * never change. Element access through operator[] and setValue() indexes the
+ * current buffer directly and relies on prepareForWrite() having been called
+ * since the last copy on write. The non-const accessors of DataArray, data(),
+ * getContiguousValues(), createSpan() and begin() call it.
+ *
+ * Values are shared per DataStore, not per chunk: the first write after a copy
+ * on write copies the whole buffer, even if only a single value changes.
+ *
+ * Creating a copy on write is not thread safe. prepareForWrite() may be called
+ * from several threads at once but not while other threads access the values,
+ * so call it before handing the DataStore to the worker threads of a parallel
+ * algorithm. Raw pointers and spans returned by data(), getContiguousValues()
+ * and createSpan() are invalidated by prepareForWrite() and resizeTuples().
  * @tparam T
  */
 template <typename T>
@@ -98,7 +117,7 @@ public:
     const usize count = other.getSize();
     auto* data = new value_type[count];
     std::memcpy(data, other.m_Data.get(), count * sizeof(T));
-    m_Data.reset(data);
+    setBuffer(std::shared_ptr<value_type[]>(data));
   }
 
   /**
@@ -110,6 +129,7 @@ public:
   , m_ComponentShape(std::move(other.m_ComponentShape))
   , m_TupleShape(std::move(other.m_TupleShape))
   , m_Data(std::move(other.m_Data))
+  , m_IsShared(other.m_IsShared.load())
   , m_NumComponents(std::move(other.m_NumComponents))
   , m_NumTuples(std::move(other.m_NumTuples))
   {
@@ -127,7 +147,16 @@ public:
    * @param rhs
    * @return
    */
-  DataStore& operator=(DataStore&& rhs) = default;
+  DataStore& operator=(DataStore&& rhs) noexcept
+  {
+    m_ComponentShape = std::move(rhs.m_ComponentShape);
+    m_TupleShape = std::move(rhs.m_TupleShape);
+    m_Data = std::move(rhs.m_Data);
+    m_IsShared = rhs.m_IsShared.load();
+    m_NumComponents = rhs.m_NumComponents;
+    m_NumTuples = rhs.m_NumTuples;
+    return *this;
+  }
 
   ~DataStore() override = default;
 
@@ -141,7 +170,8 @@ public:
   }
 
   /**
-   * @brief Returns the pointer to the allocated data. Const version
+   * @brief Returns the pointer to the allocated data. Const version.
+   * The pointer is invalidated by the next non-const access to the DataStore.
    * @return
    */
   const T* data() const
@@ -150,14 +180,58 @@ public:
   }
 
   /**
-   * @brief Returns the pointer to the allocated data. Non-const version
+   * @brief Returns the pointer to the allocated data. Non-const version.
+   * Copies the values first if they are shared with another DataStore.
+   * The pointer is invalidated by resizing the DataStore.
    * @return
    */
   T* data()
   {
+    prepareForWrite();
     return m_Data.get();
   }
 
+  /**
+   * @brief Returns true if the values are currently shared with a DataStore
+   * created by createCopyOnWrite().
+   * @return bool
+   */
+  bool isSharingData() const
+  {
+    if(!m_IsShared.load(std::memory_order_acquire))
+    {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(m_DetachMutex);
+    return m_Data.use_count() > 1;
+  }
+
+  /**
+   * @brief Copies the values into a buffer owned by this DataStore if the
+   * current buffer is shared with another DataStore. The buffer is only
+   * copied once even if several threads call this at the same time.
+   */
+  void prepareForWrite() override
+  {
+    if(!m_IsShared.load(std::memory_order_acquire))
+    {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(m_DetachMutex);
+    if(!m_IsShared.load(std::memory_order_relaxed))
+    {
+      return;
+    }
+    if(m_Data.use_count() > 1)
+    {
+      const usize count = this->getSize();
+      std::shared_ptr<value_type[]> buffer(new value_type[count]);
+      std::memcpy(buffer.get(), m_Data.get(), count * sizeof(T));
+      m_Data = std::move(buffer);
+    }
+    m_IsShared.store(false, std::memory_order_release);
+  }
+
   /**
    * @brief Returns the number of elements in each Tuple.
    * @return usize
@@ -224,8 +298,7 @@ public:
 
     if(m_Data.get() == nullptr) // Data was never allocated
     {
-      auto data = new value_type[newSize];
-      m_Data.reset(data);
+      setBuffer(std::shared_ptr<value_type[]>(new value_type[newSize]));
       return;
     }
 
@@ -240,11 +313,12 @@ public:
     // copy the old data into the newly allocated data array or as much or as little
     // as possible
     auto data = new value_type[newSize];
+    const value_type* oldData = m_Data.get();
     for(usize i = 0; i < newSize && i < oldSize; i++)
     {
-      data[i] = m_Data.get()[i];
+      data[i] = oldData[i];
     }
-    m_Data.reset(data);
+    setBuffer(std::shared_ptr<value_type[]>(data));
   }
 
   /**
@@ -255,17 +329,18 @@ public:
    */
   value_type getValue(usize index) const override
   {
-    return m_Data.get()[index];
+    return m_Data[index];
   }
 
   /**
    * @brief Sets the value stored at the specified index.
+   * Call prepareForWrite() first if the DataStore may share its values.
    * @param index
    * @param value
    */
   void setValue(usize index, value_type value) override
   {
-    m_Data.get()[index] = value;
+    m_Data[index] = value;
   }
 
   /**
@@ -276,18 +351,19 @@ public:
    */
   const_reference operator[](usize index) const override
   {
-    return m_Data.get()[index];
+    return m_Data[index];
   }
 
   /**
    * @brief Returns the value found at the specified index of the DataStore.
    * This can be used to edit the value found at the specified index.
+   * Call prepareForWrite() first if the DataStore may share its values.
    * @param  index
    * @return reference
    */
   reference operator[](usize index) override
   {
-    return m_Data.get()[index];
+    return m_Data[index];
   }
 
   /**
@@ -302,7 +378,7 @@ public:
     {
       throw std::runtime_error("");
     }
-    return m_Data.get()[index];
+    return m_Data[index];
   }
 
   /**
@@ -314,6 +390,16 @@ public:
     return std::make_unique<DataStore<T>>(*this);
   }
 
+  /**
+   * @brief Returns a DataStore that shares the values of this DataStore until
+   * either of them is written to.
+   * @return std::shared_ptr<AbstractDataStore<T>>
+   */
+  std::shared_ptr<AbstractDataStore<T>> createCopyOnWrite() const override
+  {
+    return std::shared_ptr<DataStore<T>>(new DataStore<T>(*this, SharedBufferTag{}));
+  }
+
   /**
    * @brief Returns a data store of the same type as this but with default initialized data.
    * @return std::unique_ptr<IDataStore>
@@ -333,6 +419,28 @@ public:
     return {data(), this->getSize()};
   }
 
+  /**
+   * @brief Returns a pointer to the value at startIndex.
+   * The pointer is invalidated by the next non-const access to the DataStore.
+   * @param startIndex
+   * @return const T*
+   */
+  const T* getContiguousValues(usize startIndex) const override
+  {
+    return data() + startIndex;
+  }
+
+  /**
+   * @brief Returns a pointer to the value at startIndex.
+   * Copies the values first if they are shared with another DataStore.
+   * @param startIndex
+   * @return T*
+   */
+  T* getContiguousValues(usize startIndex) override
+  {
+    return data() + startIndex;
+  }
+
   std::pair<int32, std::string> writeBinaryFile(const std::string& absoluteFilePath) const override
   {
     FILE* file = fopen(absoluteFilePath.c_str(), "wb");
@@ -353,9 +461,39 @@ public:
   }
 
 private:
+  struct SharedBufferTag
+  {
+  };
+
+  /**
+   * @brief Creates a DataStore that shares the value buffer of other. Both
+   * DataStores are marked as shared so that whichever is prepared for writing
+   * first copies the values.
+   * @param other
+   */
+  DataStore(const DataStore& other, SharedBufferTag)
+  : parent_type()
+  , m_ComponentShape(other.m_ComponentShape)
+  , m_TupleShape(other.m_TupleShape)
+  , m_Data(other.m_Data)
+  , m_IsShared(true)
+  , m_NumComponents(other.m_NumComponents)
+  , m_NumTuples(other.m_NumTuples)
+  {
+    other.m_IsShared.store(true, std::memory_order_release);
+  }
+
+  void setBuffer(std::shared_ptr<value_type[]> buffer)
+  {
+    m_Data = std::move(buffer);
+    m_IsShared.store(false, std::memory_order_release);
+  }
+
   ShapeType m_ComponentShape;
   ShapeType m_TupleShape;
-  std::unique_ptr<value_type[]> m_Data = nullptr;
+  std::shared_ptr<value_type[]> m_Data = nullptr;
+  mutable std::atomic_bool m_IsShared = false;
+  mutable std::mutex m_DetachMutex;
   size_t m_NumComponents = {0};
   size_t m_NumTuples = {0};
 };
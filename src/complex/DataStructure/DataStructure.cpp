@@ -69,6 +69,7 @@ DataStructure::DataStructure(DataStructure&& dataStructure) noexcept
 , m_NextId(dataStructure.m_NextId)
 {
   m_RootGroup.setDataStructure(this);
+  dataStructure.invalidatePathIndex();
 }
 
 DataStructure::~DataStructure()
@@ -109,6 +110,7 @@ void DataStructure::clear()
     removeData(dataId);
   }
   m_DataObjects.clear();
+  invalidatePathIndex();
 }
 
 std::optional<DataObject::IdType> DataStructure::getId(const DataPath& path) const
@@ -288,23 +290,7 @@ DataObject* traversePath(DataObject* obj, const DataPath& path, usize index)
 
 DataObject* DataStructure::getData(const DataPath& path)
 {
-  if(path.empty())
-  {
-    return nullptr;
-  }
-  auto topLevel = getTopLevelData();
-  for(DataObject* obj : topLevel)
-  {
-    if(obj == nullptr)
-    {
-      continue;
-    }
-    if(obj->getName() == path[0])
-    {
-      return traversePath(obj, path, 1);
-    }
-  }
-  return nullptr;
+  return findData(path);
 }
 
 DataObject& DataStructure::getDataRef(const DataPath& path)
@@ -358,25 +344,57 @@ const DataObject* DataStructure::getData(const std::optional<DataObject::IdType>
 }
 
 const DataObject* DataStructure::getData(const DataPath& path) const
+{
+  return findData(path);
+}
+
+DataObject* DataStructure::findData(const DataPath& path) const
 {
   if(path.empty())
   {
     return nullptr;
   }
 
-  auto topLevel = getTopLevelData();
-  for(DataObject* obj : topLevel)
+  std::optional<DataObject::IdType> indexedId;
   {
-    if(obj == nullptr)
+    std::lock_guard<std::mutex> lock(m_PathIndexMutex);
+    auto iter = m_PathIndex.find(path);
+    if(iter != m_PathIndex.end())
     {
-      continue;
+      indexedId = iter->second;
     }
-    if(obj->getName() == path[0])
+  }
+  if(indexedId.has_value())
+  {
+    auto iter = m_DataObjects.find(*indexedId);
+    if(iter != m_DataObjects.end())
     {
-      return traversePath(obj, path, 1);
+      DataObject* dataObject = iter->second.lock().get();
+      if(dataObject != nullptr && dataObject->getName() == path.getTargetName())
+      {
+        return dataObject;
+      }
     }
   }
-  return nullptr;
+
+  auto* topLevel = const_cast<DataObject*>(m_RootGroup[path[0]]);
+  if(topLevel == nullptr)
+  {
+    return nullptr;
+  }
+  DataObject* dataObject = traversePath(topLevel, path, 1);
+  if(dataObject != nullptr)
+  {
+    std::lock_guard<std::mutex> lock(m_PathIndexMutex);
+    m_PathIndex[path] = dataObject->getId();
+  }
+  return dataObject;
+}
+
+void DataStructure::invalidatePathIndex()
+{
+  std::lock_guard<std::mutex> lock(m_PathIndexMutex);
+  m_PathIndex.clear();
 }
 
 const DataObject& DataStructure::getDataRef(const DataPath& path) const
@@ -457,6 +475,7 @@ void DataStructure::setData(DataObject::IdType identifier, std::shared_ptr<DataO
   }
 
   m_DataObjects[identifier] = dataObject;
+  invalidatePathIndex();
 }
 
 bool DataStructure::removeData(const std::optional<DataObject::IdType>& identifier)
@@ -508,6 +527,7 @@ void DataStructure::dataDeleted(DataObject::IdType identifier, const std::string
   {
     return;
   }
+  invalidatePathIndex();
 
   auto msg = std::make_shared<DataRemovedMessage>(this, identifier, name);
   notify(msg);
@@ -547,6 +567,7 @@ bool DataStructure::insertTopLevel(const std::shared_ptr<DataObject>& obj)
     return false;
   }
 
+  invalidatePathIndex();
   return m_RootGroup.insert(obj);
 }
 
@@ -557,6 +578,7 @@ bool DataStructure::removeTopLevel(DataObject* data)
   {
     return false;
   }
+  invalidatePathIndex();
 
   DataPath path({name});
   std::vector<DataPath> paths({path});
@@ -653,6 +675,7 @@ bool DataStructure::insertIntoRoot(const std::shared_ptr<DataObject>& dataObject
   {
     return false;
   }
+  invalidatePathIndex();
   trackDataObject(dataObject);
   return true;
 }
@@ -759,6 +782,7 @@ DataStructure& DataStructure::operator=(const DataStructure& rhs)
   // Updates all DataMaps with the corresponding m_DataObjects pointers.
   // Updates all DataObjects with their new DataStructure
   applyAllDataStructure();
+  invalidatePathIndex();
   return *this;
 }
 
@@ -770,6 +794,8 @@ DataStructure& DataStructure::operator=(DataStructure&& rhs) noexcept
   m_NextId = std::move(rhs.m_NextId);
 
   applyAllDataStructure();
+  invalidatePathIndex();
+  rhs.invalidatePathIndex();
   return *this;
 }
 
@@ -868,6 +894,7 @@ void DataStructure::resetIds(DataObject::IdType startingId)
     }
   }
   m_RootGroup.updateIds(updatedIds);
+  invalidatePathIndex();
 }
 
 void DataStructure::exportHierarchyAsGraphViz(std::ostream& outputStream) const
@@ -12,10 +12,12 @@
 #include <filesystem>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 namespace complex
@@ -60,6 +62,7 @@ public:
   using Iterator = DataMap::Iterator;
   using ConstIterator = DataMap::ConstIterator;
 
+  friend class BaseGroup;
   friend class DataMap;
   friend class DataObject;
 
@@ -818,6 +821,20 @@ private:
    */
   void notify(const std::shared_ptr<AbstractDataStructureMessage>& msg);
 
+  /**
+   * @brief Finds the DataObject at the given path through the path index. Paths
+   * missing from the index are resolved through the DataMaps and then indexed.
+   * @param path
+   * @return DataObject*
+   */
+  DataObject* findData(const DataPath& path) const;
+
+  /**
+   * @brief Clears the path index. Called whenever DataObjects are added, removed,
+   * renamed, reparented, or given new IDs.
+   */
+  void invalidatePathIndex();
+
   ////////////
   // Variables
   SignalType m_Signal;
@@ -825,5 +842,8 @@ private:
   DataMap m_RootGroup;
   bool m_IsValid = false;
   DataObject::IdType m_NextId = 1;
+  // Cache of resolved DataPaths. Filled on lookup so const methods can use it from several threads.
+  mutable std::unordered_map<DataPath, DataObject::IdType> m_PathIndex;
+  mutable std::mutex m_PathIndexMutex;
 };
 } // namespace complex
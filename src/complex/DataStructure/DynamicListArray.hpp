@@ -3,10 +3,12 @@
 #include "complex/Common/StringLiteral.hpp"
 #include "complex/DataStructure/DataObject.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace complex
 {
@@ -16,6 +18,19 @@ namespace DynamicListArrayConstants
 inline constexpr StringLiteral k_TypeName = "DynamicListArray";
 }
 
+/**
+ * @class DynamicListArray
+ * @brief The DynamicListArray class stores a variable length list of K values for
+ * each entry, for example the ids of the elements that share a vertex. All of the
+ * lists are stored back to back in a single values array and an offsets array of
+ * size() + 1 entries marks where each list starts (compressed sparse row layout).
+ *
+ * Lists should be filled in bulk, either with setLists() or by calling
+ * allocateLists() followed by insertCellReference(). Changing the length of a
+ * single list with setElementList() moves all of the lists stored after it.
+ * @tparam T Type used to report the number of values in a list
+ * @tparam K Value type
+ */
 template <typename T, typename K>
 class DynamicListArray : public DataObject
 {
@@ -23,6 +38,8 @@ public:
   friend class DataStructure;
 
   using Self = DynamicListArray<T, K>;
+  using count_type = T;
+  using value_type = K;
 
   struct ElementList
   {
@@ -85,8 +102,8 @@ public:
    */
   DynamicListArray(const DynamicListArray& other)
   : DataObject(other)
-  , m_Array(other.m_Array)
-  , m_Size(other.m_Size)
+  , m_Offsets(other.m_Offsets)
+  , m_Values(other.m_Values)
   {
   }
 
@@ -97,30 +114,12 @@ public:
    */
   DynamicListArray(DynamicListArray&& other)
   : DataObject(std::move(other))
-  , m_Array(std::move(other.m_Array))
-  , m_Size(std::move(other.m_Size))
+  , m_Offsets(std::move(other.m_Offsets))
+  , m_Values(std::move(other.m_Values))
   {
   }
 
-  // -----------------------------------------------------------------------------
-  //
-  // -----------------------------------------------------------------------------
-  ~DynamicListArray() override
-  {
-    // This makes sure we deallocate any lists that have been created
-    for(usize i = 0; i < this->m_Size; i++)
-    {
-      if(this->m_Array[i].cells != nullptr)
-      {
-        delete[] this->m_Array[i].cells;
-      }
-    }
-    // Now delete all the "ElementList" structures
-    if(this->m_Array != nullptr)
-    {
-      delete[] this->m_Array;
-    }
-  }
+  ~DynamicListArray() override = default;
 
   DataObject::Type getDataObjectType() const override
   {
@@ -137,12 +136,21 @@ public:
   }
 
   /**
-   * @brief Returns the current array size.
+   * @brief Returns the number of lists.
    * @return usize
    */
   usize size() const
   {
-    return m_Size;
+    return m_Offsets.empty() ? 0 : m_Offsets.size() - 1;
+  }
+
+  /**
+   * @brief Returns the total number of values stored across all lists.
+   * @return usize
+   */
+  usize getNumberOfValues() const
+  {
+    return m_Values.size();
   }
 
   /**
@@ -159,21 +167,8 @@ public:
     }
     // Don't construct with identifier since it will get created when inserting into data structure
     std::shared_ptr<DynamicListArray<T, K>> copy = std::shared_ptr<DynamicListArray<T, K>>(new DynamicListArray<T, K>(dataStruct, copyPath.getTargetName()));
-    std::vector<T> linkCounts(m_Size, 0);
-
-    // Figure out how many entries, and for each entry, how many cells
-    for(usize pointId = 0; pointId < m_Size; pointId++)
-    {
-      linkCounts[pointId] = this->m_Array[pointId].numCells;
-    }
-    // Allocate all that in the copy
-    copy->allocateLists(linkCounts);
-    // Copy the data from the original to the new
-    for(usize ptId = 0; ptId < m_Size; ptId++)
-    {
-      ElementList& elementList = getElementList(ptId);
-      copy->setElementList(ptId, elementList);
-    }
+    copy->m_Offsets = m_Offsets;
+    copy->m_Values = m_Values;
     if(dataStruct.insert(copy, copyPath.getParent()))
     {
       return copy;
@@ -182,12 +177,14 @@ public:
   }
 
   /**
-   * @brief The DynamicListArray cannot be shallow copied.
+   * @brief Returns a copy of the DynamicListArray. The lists are stored in two
+   * flat arrays, so they are copied along with the object.
+   * THE CALLING CODE MUST DISPOSE OF THE RETURNED OBJECT.
    * @return DataObject*
    */
   DataObject* shallowCopy() override
   {
-    throw std::runtime_error("");
+    return new DynamicListArray(*this);
   }
 
   /**
@@ -198,42 +195,53 @@ public:
    */
   inline void insertCellReference(usize pointId, usize pos, usize cellId)
   {
-    this->m_Array[pointId].cells[pos] = cellId;
+    m_Values[m_Offsets[pointId] + pos] = static_cast<K>(cellId);
   }
 
   /**
-   * @brief Get a link structure given a point identifier.
+   * @brief Get a link structure given a point identifier. The returned cells
+   * pointer is invalidated when the lists are reallocated.
    * @param pointId
-   * @return ElementList&
+   * @return ElementList
    */
-  ElementList& getElementList(usize pointId) const
+  ElementList getElementList(usize pointId) const
   {
-    return this->m_Array[pointId];
+    return {getNumberOfElements(pointId), const_cast<K*>(getElementListPointer(pointId))};
   }
 
   /**
-   * @brief setElementList
+   * @brief Replaces the list for the specified point with a copy of the
+   * numCells values pointed to by data.
    * @param pointId
    * @param numCells
    * @param data
    * @return bool
    */
-  bool setElementList(usize pointId, T numCells, K* data)
+  bool setElementList(usize pointId, T numCells, const K* data)
   {
-    if(pointId >= m_Size)
+    if(pointId >= size())
     {
       return false;
     }
-    if(m_Array[pointId].cells != nullptr && m_Array[pointId].numCells > 0)
+    const usize newCount = static_cast<usize>(numCells);
+    const usize oldCount = m_Offsets[pointId + 1] - m_Offsets[pointId];
+    auto listStart = m_Values.begin() + static_cast<std::ptrdiff_t>(m_Offsets[pointId]);
+    if(newCount > oldCount)
     {
-      delete[] this->m_Array[pointId].cells;
-      m_Array[pointId].cells = nullptr;
-      m_Array[pointId].numCells = 0;
+      m_Values.insert(listStart + static_cast<std::ptrdiff_t>(oldCount), newCount - oldCount, static_cast<K>(0));
     }
-    m_Array[pointId].numCells = numCells;
-    // If numCells is huge then there could be problems with this
-    this->m_Array[pointId].cells = new K[numCells];
-    std::memcpy(m_Array[pointId].cells, data, sizeof(K) * numCells);
+    else if(newCount < oldCount)
+    {
+      m_Values.erase(listStart + static_cast<std::ptrdiff_t>(newCount), listStart + static_cast<std::ptrdiff_t>(oldCount));
+    }
+    if(newCount != oldCount)
+    {
+      for(usize i = pointId + 1; i < m_Offsets.size(); i++)
+      {
+        m_Offsets[i] = m_Offsets[i] + newCount - oldCount;
+      }
+    }
+    std::copy(data, data + newCount, m_Values.begin() + static_cast<std::ptrdiff_t>(m_Offsets[pointId]));
     return true;
   }
 
@@ -243,25 +251,9 @@ public:
    * @param list
    * @return bool
    */
-  bool setElementList(usize pointId, ElementList& list)
+  bool setElementList(usize pointId, const ElementList& list)
   {
-    T nCells = list.numCells;
-    K* data = list.cells;
-    if(pointId >= m_Size)
-    {
-      return false;
-    }
-    if(m_Array[pointId].cells != nullptr && m_Array[pointId].numCells > 0)
-    {
-      delete[] this->m_Array[pointId].cells;
-      m_Array[pointId].cells = nullptr;
-      m_Array[pointId].numCells = 0;
-    }
-    m_Array[pointId].numCells = nCells;
-    // If numCells is huge then there could be problems with this
-    this->m_Array[pointId].cells = new K[nCells];
-    std::memcpy(m_Array[pointId].cells, data, sizeof(K) * nCells);
-    return true;
+    return setElementList(pointId, list.numCells, list.cells);
   }
 
   /**
@@ -271,7 +263,7 @@ public:
    */
   T getNumberOfElements(usize pointId) const
   {
-    return this->m_Array[pointId].numCells;
+    return static_cast<T>(m_Offsets[pointId + 1] - m_Offsets[pointId]);
   }
 
   /**
@@ -279,9 +271,57 @@ public:
    * @param pointId
    * @return K*
    */
-  K* getElementListPointer(usize pointId) const
+  K* getElementListPointer(usize pointId)
+  {
+    return m_Values.data() + m_Offsets[pointId];
+  }
+
+  /**
+   * @brief Return a list of cell ids using the point.
+   * @param pointId
+   * @return const K*
+   */
+  const K* getElementListPointer(usize pointId) const
   {
-    return this->m_Array[pointId].cells;
+    return m_Values.data() + m_Offsets[pointId];
+  }
+
+  /**
+   * @brief Returns the offsets array. List i is stored in the values array
+   * starting at getOffsets()[i] and ending before getOffsets()[i + 1].
+   * @return const std::vector<usize>&
+   */
+  const std::vector<usize>& getOffsets() const
+  {
+    return m_Offsets;
+  }
+
+  /**
+   * @brief Returns the values of all lists stored back to back.
+   * @return const std::vector<K>&
+   */
+  const std::vector<K>& getValues() const
+  {
+    return m_Values;
+  }
+
+  /**
+   * @brief Replaces all lists with the given offsets and values arrays. The
+   * offsets must start at 0, be non-decreasing and end at values.size().
+   * Returns false and leaves the lists untouched if the arrays are inconsistent.
+   * @param offsets
+   * @param values
+   * @return bool
+   */
+  bool setLists(std::vector<usize> offsets, std::vector<K> values)
+  {
+    if(offsets.empty() || offsets.front() != 0 || offsets.back() != values.size() || !std::is_sorted(offsets.begin(), offsets.end()))
+    {
+      return false;
+    }
+    m_Offsets = std::move(offsets);
+    m_Values = std::move(values);
+    return true;
   }
 
   /**
@@ -291,40 +331,46 @@ public:
    */
   void deserializeLinks(std::vector<uint8>& buffer, usize numElements)
   {
+    uint8* bufPtr = buffer.data();
+
+    // First walk the buffer to find the size of each list
+    std::vector<T> linkCounts(numElements, 0);
     usize offset = 0;
-    allocate(numElements); // Allocate all the links with 0 and nullptr;
-    uint8* bufPtr = &(buffer.front());
+    for(usize i = 0; i < numElements; ++i)
+    {
+      T numCells = 0;
+      std::memcpy(&numCells, bufPtr + offset, sizeof(T));
+      linkCounts[i] = numCells;
+      offset += 2;
+      offset += numCells * sizeof(K);
+    }
+    allocateLists(linkCounts);
 
-    // Walk the array and allocate all the array links to Zero and nullptr
-    T* numCells = nullptr;
-    // int32* cells = nullptr;
+    // Then copy each list out of the buffer
+    offset = 0;
     for(usize i = 0; i < numElements; ++i)
     {
-      numCells = reinterpret_cast<T*>(bufPtr + offset);
-      this->m_Array[i].numCells = *numCells; // Set the number of cells in this link
       offset += 2;
-      this->m_Array[i].cells = new K[(*numCells)];                                   // Allocate a new chunk of memory to store the list
-      std::memcpy(this->m_Array[i].cells, bufPtr + offset, (*numCells) * sizeof(K)); // Copy from the buffer into the new list memory
-      offset += (*numCells) * sizeof(K);                                             // Increment the offset
+      std::memcpy(getElementListPointer(i), bufPtr + offset, linkCounts[i] * sizeof(K));
+      offset += linkCounts[i] * sizeof(K);
     }
   }
 
   /**
-   * @brief
+   * @brief Allocates zero initialized lists with the specified number of
+   * values in each list.
    * @param linkCounts
    */
   template <typename Container>
   void allocateLists(const Container& linkCounts)
   {
-    allocate(linkCounts.size());
-    for(typename std::vector<T>::size_type i = 0; i < linkCounts.size(); i++)
+    const usize numLists = linkCounts.size();
+    m_Offsets.assign(numLists + 1, 0);
+    for(usize i = 0; i < numLists; i++)
     {
-      this->m_Array[i].numCells = linkCounts[i];
-      if(linkCounts[i] > 0)
-      {
-        this->m_Array[i].cells = new K[this->m_Array[i].numCells];
-      }
+      m_Offsets[i + 1] = m_Offsets[i] + static_cast<usize>(linkCounts[i]);
     }
+    m_Values.assign(m_Offsets.back(), static_cast<K>(0));
   }
 
 protected:
@@ -349,41 +395,9 @@ protected:
   {
   }
 
-  //----------------------------------------------------------------------------
-  // This will allocate memory to hold all the NeighborList structures where each
-  // structure is initialized to Zero Entries and a nullptr Pointer
-  void allocate(usize size)
-  {
-    static typename DynamicListArray<T, K>::ElementList linkInit = {0, nullptr};
-
-    // This makes sure we deallocate any lists that have been created
-    for(usize i = 0; i < this->m_Size; i++)
-    {
-      if(this->m_Array[i].cells != nullptr)
-      {
-        delete[] this->m_Array[i].cells;
-      }
-    }
-    // Now delete all the "ElementList" structures
-    if(this->m_Array != nullptr)
-    {
-      delete[] this->m_Array;
-    }
-
-    this->m_Size = size;
-    // Allocate a whole new set of structures
-    this->m_Array = new typename DynamicListArray<T, K>::ElementList[size];
-
-    // Initialize each structure to have 0 entries and nullptr pointer.
-    for(usize i = 0; i < size; i++)
-    {
-      this->m_Array[i] = linkInit;
-    }
-  }
-
 private:
-  ElementList* m_Array = nullptr; // pointer to data
-  usize m_Size = 0;
+  std::vector<usize> m_Offsets;
+  std::vector<K> m_Values;
 };
 
 using Int32Int32DynamicListArray = DynamicListArray<int32, int32>;
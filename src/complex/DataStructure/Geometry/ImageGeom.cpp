@@ -5,6 +5,7 @@
 #include "complex/Utilities/GeometryHelpers.hpp"
 #include "complex/Utilities/StringUtilities.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 
 using namespace complex;
@@ -470,3 +471,27 @@ ImageGeom::ErrorType ImageGeom::computeCellIndex(const Point3D<float32>& coords,
   }
   return err;
 }
+
+// -----------------------------------------------------------------------------
+std::vector<ImageGeom::ZSlab> ImageGeom::getZSlabs(usize slabDepth, usize haloWidth) const
+{
+  std::vector<ZSlab> slabs;
+  const usize numZ = m_Dimensions[2];
+  if(numZ == 0)
+  {
+    return slabs;
+  }
+
+  slabDepth = std::clamp<usize>(slabDepth, 1, numZ);
+  slabs.reserve((numZ + slabDepth - 1) / slabDepth);
+  for(usize zStart = 0; zStart < numZ; zStart += slabDepth)
+  {
+    ZSlab slab;
+    slab.zStart = zStart;
+    slab.zEnd = std::min(zStart + slabDepth, numZ);
+    slab.haloStart = zStart > haloWidth ? zStart - haloWidth : 0;
+    slab.haloEnd = std::min(slab.zEnd + haloWidth, numZ);
+    slabs.push_back(slab);
+  }
+  return slabs;
+}
@@ -35,6 +35,18 @@ public:
     NoError = 7
   };
 
+  /**
+   * @brief Describes a range of Z layers [zStart, zEnd) and the layers
+   * [haloStart, haloEnd) that have to be read to process it.
+   */
+  struct ZSlab
+  {
+    usize zStart = 0;
+    usize zEnd = 0;
+    usize haloStart = 0;
+    usize haloEnd = 0;
+  };
+
   /**
    * @brief
    * @param dataStructure
@@ -340,6 +352,15 @@ public:
    */
   ErrorType computeCellIndex(const Point3D<float32>& coords, SizeVec3& index) const;
 
+  /**
+   * @brief Splits the Z dimension into slabs of at most slabDepth layers. Each slab
+   * also lists the haloWidth layers on either side of it, clamped to the geometry.
+   * @param slabDepth
+   * @param haloWidth
+   * @return std::vector<ZSlab>
+   */
+  std::vector<ZSlab> getZSlabs(usize slabDepth, usize haloWidth) const;
+
 protected:
   /**
    * @brief
@@ -53,6 +53,21 @@ public:
    */
   virtual const IDataStore* getIDataStore() const = 0;
 
+  /**
+   * @brief Replaces the array's DataStore with an EmptyDataStore of the same
+   * shape and data format. The values are freed once no other DataArray or
+   * DataStructure shares them. The array can no longer be read afterwards.
+   */
+  virtual void releaseValues() = 0;
+
+  /**
+   * @brief Makes the array reference the DataStore of source, so writes through
+   * either array are visible through both. Does nothing if source does not hold
+   * the same value type.
+   * @param source
+   */
+  virtual void shareDataStore(const IDataArray& source) = 0;
+
   /**
    * @brief Returns a reference to the array's IDataStore.
    * @return IDataStore&
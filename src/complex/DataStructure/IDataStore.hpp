@@ -100,6 +100,17 @@ public:
     return "";
   }
 
+  /**
+   * @brief Returns true if separate elements of the DataStore can be read and
+   * written from multiple threads at the same time. Stores that page or cache
+   * their data through a shared buffer must return false.
+   * @return bool
+   */
+  virtual bool isThreadSafe() const
+  {
+    return getDataFormat().empty();
+  }
+
   /**
    * @brief Returns the size of the stored type of the data store.
    * @return usize
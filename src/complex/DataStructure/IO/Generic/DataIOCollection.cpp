@@ -3,7 +3,10 @@
 #include "complex/Core/Application.hpp"
 #include "complex/DataStructure/IO/Generic/CoreDataIOManager.hpp"
 #include "complex/DataStructure/IO/Generic/IDataIOManager.hpp"
+#include "complex/DataStructure/IO/Generic/IOConstants.hpp"
+#include "complex/DataStructure/IO/Generic/MmapDataIOManager.hpp"
 #include "complex/DataStructure/IO/HDF5/DataIOManager.hpp"
+#include "complex/Utilities/MemoryUtilities.hpp"
 
 namespace complex
 {
@@ -11,6 +14,7 @@ DataIOCollection::DataIOCollection()
 {
   addIOManager(std::make_shared<complex::Generic::CoreDataIOManager>());
   addIOManager(std::make_shared<complex::HDF5::DataIOManager>());
+  addIOManager(std::make_shared<complex::Generic::MmapDataIOManager>());
 }
 DataIOCollection::~DataIOCollection() noexcept = default;
 
@@ -72,6 +76,11 @@ void DataIOCollection::checkStoreDataFormat(uint64 dataSize, std::string& dataFo
   {
     dataFormat = largeDataFormat;
   }
+  else if(dataSize >= Memory::GetTotalMemory() && hasDataStoreCreationFunction(IOConstants::k_MmapDataFormat))
+  {
+    // The array cannot fit in RAM so page it through a memory mapped file instead
+    dataFormat = IOConstants::k_MmapDataFormat;
+  }
 }
 
 std::vector<std::string> DataIOCollection::getFormatNames() const
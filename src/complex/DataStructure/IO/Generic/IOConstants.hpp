@@ -4,6 +4,9 @@
 
 namespace complex::IOConstants
 {
+// Data Formats
+inline constexpr StringLiteral k_MmapDataFormat = "Mmap";
+
 // DataArray
 inline constexpr StringLiteral k_TupleShapeTag = "TupleDimensions";
 inline constexpr StringLiteral k_ComponentShapeTag = "ComponentDimensions";
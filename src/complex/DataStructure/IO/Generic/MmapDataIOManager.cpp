@@ -0,0 +1,70 @@
+#include "MmapDataIOManager.hpp"
+
+#include "complex/Core/Application.hpp"
+#include "complex/DataStructure/IO/Generic/IOConstants.hpp"
+#include "complex/DataStructure/MmapDataStore.hpp"
+
+namespace complex::Generic
+{
+MmapDataIOManager::MmapDataIOManager()
+: IDataIOManager()
+{
+  addDataStoreFnc();
+}
+
+MmapDataIOManager::~MmapDataIOManager() noexcept = default;
+
+std::string MmapDataIOManager::formatName() const
+{
+  return IOConstants::k_MmapDataFormat;
+}
+
+void MmapDataIOManager::addDataStoreFnc()
+{
+  DataStoreCreateFnc dataStoreFnc = [](complex::DataType numericType, const typename IDataStore::ShapeType& tupleShape, const typename IDataStore::ShapeType& componentShape,
+                                       const std::optional<IDataStore::ShapeType>& /* chunkShape */) {
+    // The values are stored as one flat row-major file, so there is no chunk layout to honor.
+    // MmapDataStore::getChunkShape() derives the chunks from whole rows of the slowest tuple dimension instead.
+    const std::filesystem::path directory = Application::GetOrCreateInstance()->getPreferences()->mmapDirectory();
+    std::unique_ptr<IDataStore> dataStore = nullptr;
+    switch(numericType)
+    {
+    case DataType::int8:
+      dataStore = std::make_unique<Int8MmapDataStore>(tupleShape, componentShape, std::nullopt, directory);
+      break;
+    case DataType::int16:
+      dataStore = std::make_unique<Int16MmapDataStore>(tupleShape, componentShape, std::nullopt, directory);
+      break;
+    case DataType::int32:
+      dataStore = std::make_unique<Int32MmapDataStore>(tupleShape, componentShape, std::nullopt, directory);
+      break;
+    case DataType::int64:
+      dataStore = std::make_unique<Int64MmapDataStore>(tupleShape, componentShape, std::nullopt, directory);
+      break;
+    case DataType::uint8:
+      dataStore = std::make_unique<UInt8MmapDataStore>(tupleShape, componentShape, std::nullopt, directory);
+      break;
+    case DataType::uint16:
+      dataStore = std::make_unique<UInt16MmapDataStore>(tupleShape, componentShape, std::nullopt, directory);
+      break;
+    case DataType::uint32:
+      dataStore = std::make_unique<UInt32MmapDataStore>(tupleShape, componentShape, std::nullopt, directory);
+      break;
+    case DataType::uint64:
+      dataStore = std::make_unique<UInt64MmapDataStore>(tupleShape, componentShape, std::nullopt, directory);
+      break;
+    case DataType::float32:
+      dataStore = std::make_unique<Float32MmapDataStore>(tupleShape, componentShape, std::nullopt, directory);
+      break;
+    case DataType::float64:
+      dataStore = std::make_unique<Float64MmapDataStore>(tupleShape, componentShape, std::nullopt, directory);
+      break;
+    case DataType::boolean:
+      dataStore = std::make_unique<BoolMmapDataStore>(tupleShape, componentShape, std::nullopt, directory);
+      break;
+    }
+    return dataStore;
+  };
+  addDataStoreCreationFnc(formatName(), dataStoreFnc);
+}
+} // namespace complex::Generic
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "complex/DataStructure/IO/Generic/IDataIOManager.hpp"
+
+namespace complex
+{
+namespace Generic
+{
+/**
+ * @brief The MmapDataIOManager class provides creation functions for memory mapped
+ * DataStores that keep their values in temporary files instead of RAM.
+ */
+class COMPLEX_EXPORT MmapDataIOManager : public IDataIOManager
+{
+public:
+  /**
+   * @brief Constructs a MmapDataIOManager and adds the memory mapped DataStore creation function.
+   */
+  MmapDataIOManager();
+  virtual ~MmapDataIOManager() noexcept;
+
+  /**
+   * @brief Returns the format name for the IDataIOManager as a string.
+   * @return std::string
+   */
+  std::string formatName() const override;
+
+private:
+  void addDataStoreFnc();
+};
+} // namespace Generic
+} // namespace complex
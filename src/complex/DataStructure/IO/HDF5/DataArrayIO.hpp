@@ -152,6 +152,7 @@ public:
   Result<> writeData(DataStructureWriter& dataStructureWriter, const complex::DataArray<T>& dataArray, group_writer_type& parentGroup, bool importable) const
   {
     auto datasetWriter = parentGroup.createDatasetWriter(dataArray.getName());
+    datasetWriter.setCompression(dataStructureWriter.getCompression());
     Result<> result = DataStoreIO::WriteDataStore<T>(datasetWriter, dataArray.getDataStoreRef());
     if(result.invalid())
     {
@@ -3,6 +3,7 @@
 #include "complex/DataStructure/IO/HDF5/AttributeMatrixIO.hpp"
 #include "complex/DataStructure/IO/HDF5/DataArrayIO.hpp"
 #include "complex/DataStructure/IO/HDF5/DataGroupIO.hpp"
+#include "complex/DataStructure/IO/HDF5/DynamicListArrayIO.hpp"
 #include "complex/DataStructure/IO/HDF5/EdgeGeomIO.hpp"
 #include "complex/DataStructure/IO/HDF5/HexahedralGeomIO.hpp"
 #include "complex/DataStructure/IO/HDF5/ImageGeomIO.hpp"
@@ -56,6 +57,8 @@ void DataIOManager::addCoreFactories()
   addFactory<Float32NeighborIO>();
   addFactory<Float64NeighborIO>();
 
+  addFactory<ElementDynamicListIO>();
+
   addFactory<ScalarDataIO<uint8>>();
   addFactory<ScalarDataIO<uint16>>();
   addFactory<ScalarDataIO<uint32>>();
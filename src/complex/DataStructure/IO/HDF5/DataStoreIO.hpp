@@ -1,12 +1,20 @@
 #pragma once
 
 #include "complex/DataStructure/DataStore.hpp"
+#include "complex/DataStructure/IO/Generic/IOConstants.hpp"
 #include "complex/DataStructure/IO/HDF5/IDataStoreIO.hpp"
+#include "complex/Utilities/BoundedQueue.hpp"
 
 #include "complex/Utilities/Parsing/HDF5/Writers/DatasetWriter.hpp"
 
 #include "fmt/format.h"
 
+#include <algorithm>
+#include <exception>
+#include <optional>
+#include <thread>
+#include <vector>
+
 namespace complex
 {
 namespace HDF5
@@ -16,63 +24,81 @@ namespace DataStoreIO
 namespace Chunks
 {
 constexpr int32 k_DimensionMismatchError = -2654;
+constexpr int32 k_ChunkReadError = -2655;
 
-template <typename T>
-inline Result<> WriteDataStoreChunk(complex::HDF5::DatasetWriter& datasetWriter, const AbstractDataStore<T>& store, const std::vector<hsize_t>& h5dims,
-                                    const complex::HDF5::DatasetWriter::DimsType& chunkDims, const IDataStore::ShapeType& index)
-{
-  auto rank = chunkDims.size();
+// Number of chunks that may be read ahead of the HDF5 writes
+constexpr usize k_ChunkQueueSize = 4;
 
-  // Find and write chunk values to HDF5
-  std::vector<hsize_t> offset(rank);
-  for(uint64 i = 0; i < rank && i < index.size(); i++)
-  {
-    offset[i] = index[i] * chunkDims[i];
-  }
-  const std::vector<T> chunkVector = store.getChunkValues(index);
-  const usize cCount = chunkVector.size();
-  T* chunkPtr = new T[cCount];
-  for(usize i = 0; i < cCount; i++)
+/**
+ * @brief Returns the number of chunks along each dimension.
+ * @param shapeDims
+ * @param chunkDims
+ * @return std::vector<hsize_t>
+ */
+inline std::vector<hsize_t> ComputeChunkLayout(const IDataStore::ShapeType& shapeDims, const complex::HDF5::DatasetWriter::DimsType& chunkDims)
+{
+  const usize rank = shapeDims.size();
+  std::vector<hsize_t> chunkLayout(rank);
+  for(usize i = 0; i < rank; i++)
   {
-    chunkPtr[i] = chunkVector[i];
+    chunkLayout[i] = (shapeDims[i] + chunkDims[i] - 1) / chunkDims[i];
   }
-  if(chunkDims.size() != h5dims.size())
-  {
-    std::string ss = fmt::format("Dimension mismatch when writing DataStore chunk. Num Shape Dimensions: {} Num Chunk Dimensions: {}", h5dims.size(), chunkDims.size());
-    return MakeErrorResult(k_DimensionMismatchError, ss);
-  }
-  auto result = datasetWriter.writeChunk(h5dims, nonstd::span<const T>(chunkPtr, cCount), chunkDims, nonstd::span<const hsize_t>{offset.data(), offset.size()});
-  delete[] chunkPtr;
-  if(result.invalid())
+  return chunkLayout;
+}
+
+/**
+ * @brief Advances the chunk index to the next chunk in C order. Returns false
+ * once every chunk in the layout has been visited.
+ * @param index
+ * @param chunkLayout
+ * @return bool
+ */
+inline bool NextChunkIndex(IDataStore::ShapeType& index, const std::vector<hsize_t>& chunkLayout)
+{
+  for(usize i = index.size(); i-- > 0;)
   {
-    std::string ss = "Failed to write DataStore chunk to Dataset";
-    return MakeErrorResult(result.errors()[0].code, ss);
+    index[i]++;
+    if(index[i] < chunkLayout[i])
+    {
+      return true;
+    }
+    index[i] = 0;
   }
-
-  return {};
+  return false;
 }
 
-template <>
-inline Result<> WriteDataStoreChunk<bool>(complex::HDF5::DatasetWriter& datasetWriter, const AbstractDataStore<bool>& store, const std::vector<hsize_t>& h5dims,
-                                          const complex::HDF5::DatasetWriter::DimsType& chunkDims, const IDataStore::ShapeType& index)
+/**
+ * @brief Writes the values of a single chunk to HDF5. Bool values are converted
+ * into the reusable conversionBuffer since std::vector<bool> is not contiguous.
+ * @param datasetWriter
+ * @param h5dims
+ * @param chunkDims
+ * @param index
+ * @param chunkValues
+ * @param conversionBuffer
+ * @return Result<>
+ */
+template <typename T>
+inline Result<> WriteDataStoreChunk(complex::HDF5::DatasetWriter& datasetWriter, const std::vector<hsize_t>& h5dims, const complex::HDF5::DatasetWriter::DimsType& chunkDims,
+                                    const IDataStore::ShapeType& index, const std::vector<T>& chunkValues, std::vector<uint8>& conversionBuffer)
 {
-  auto rank = chunkDims.size();
-
-  // Find and write chunk values to HDF5
+  const usize rank = chunkDims.size();
   std::vector<hsize_t> offset(rank);
-  for(uint64 i = 0; i < rank; i++)
+  for(usize i = 0; i < rank; i++)
   {
     offset[i] = index[i] * chunkDims[i];
   }
-  const std::vector<bool> chunkVector = store.getChunkValues(index);
-  const usize cCount = chunkVector.size();
-  uint8* chunkPtr = new uint8[cCount];
-  for(usize i = 0; i < cCount; i++)
+
+  Result<> result;
+  if constexpr(std::is_same_v<T, bool>)
+  {
+    conversionBuffer.assign(chunkValues.cbegin(), chunkValues.cend());
+    result = datasetWriter.writeChunk(h5dims, nonstd::span<const uint8>(conversionBuffer.data(), conversionBuffer.size()), chunkDims, nonstd::span<const hsize_t>{offset.data(), offset.size()});
+  }
+  else
   {
-    chunkPtr[i] = chunkVector[i];
+    result = datasetWriter.writeChunk(h5dims, nonstd::span<const T>(chunkValues.data(), chunkValues.size()), chunkDims, nonstd::span<const hsize_t>{offset.data(), offset.size()});
   }
-  auto result = datasetWriter.writeChunk(h5dims, nonstd::span<const uint8>(chunkPtr, cCount), chunkDims, nonstd::span<const hsize_t>{offset.data(), offset.size()});
-  delete[] chunkPtr;
   if(result.invalid())
   {
     std::string ss = "Failed to write DataStore chunk to Dataset";
@@ -82,73 +108,181 @@ inline Result<> WriteDataStoreChunk<bool>(complex::HDF5::DatasetWriter& datasetW
   return {};
 }
 
+/**
+ * @brief Writes every chunk of the store to HDF5 exactly once. When multicore
+ * support is enabled, chunk values are read from the store on a separate thread
+ * and handed to the HDF5 writes through a bounded queue so that reading the next
+ * chunks overlaps with writing the current one. HDF5 calls are only made from
+ * the calling thread.
+ * @param datasetWriter
+ * @param store
+ * @param h5dims
+ * @return Result<>
+ */
 template <typename T>
-inline Result<> RecursivelyWriteChunks(complex::HDF5::DatasetWriter& datasetWriter, const AbstractDataStore<T>& store, const std::vector<hsize_t>& h5dims,
-                                       const complex::HDF5::DatasetWriter::DimsType& chunkDims, IDataStore::ShapeType index, const std::vector<hsize_t>& chunkLayout, uint64 i = 0)
+inline Result<> WriteDataStoreChunks(complex::HDF5::DatasetWriter& datasetWriter, const AbstractDataStore<T>& store, const std::vector<hsize_t>& h5dims)
 {
-  // uint64 rank = chunkLayout.size();
-  const uint64 rank = chunkDims.size();
-  if(i >= rank)
+  auto shapeDims = store.getTupleShape();
+  const auto componentDims = store.getComponentShape();
+  shapeDims.insert(shapeDims.end(), componentDims.begin(), componentDims.end());
+
+  const auto storeChunkShape = store.getChunkShape().value();
+  complex::HDF5::DatasetWriter::DimsType chunkDims(storeChunkShape.begin(), storeChunkShape.end());
+  if(chunkDims.size() != h5dims.size())
   {
-    return {};
+    std::string ss = fmt::format("Dimension mismatch when writing DataStore chunk. Num Shape Dimensions: {} Num Chunk Dimensions: {}", h5dims.size(), chunkDims.size());
+    return MakeErrorResult(k_DimensionMismatchError, ss);
   }
 
-  const auto maxValue = chunkLayout[i];
-  // const auto maxValue = rank;
-  const uint64 nextIndexPos = i + 1;
-  for(hsize_t value = 0; value < maxValue; value++)
+  const std::vector<hsize_t> chunkLayout = ComputeChunkLayout(shapeDims, chunkDims);
+  if(std::find(chunkLayout.cbegin(), chunkLayout.cend(), 0) != chunkLayout.cend())
   {
-    index[i] = value;
-    Result<> result = WriteDataStoreChunk<T>(datasetWriter, store, h5dims, chunkDims, index);
+    // Empty stores have no chunks to write
+    return datasetWriter.createDataset<T>(h5dims);
+  }
+
+  IDataStore::ShapeType index(chunkDims.size(), 0);
+  std::vector<uint8> conversionBuffer;
+
+#ifdef COMPLEX_ENABLE_MULTICORE
+  using ChunkItem = std::pair<IDataStore::ShapeType, std::vector<T>>;
+  BoundedQueue<ChunkItem> chunkQueue(k_ChunkQueueSize);
+  std::exception_ptr producerException = nullptr;
+
+  std::thread producer([&]() {
+    try
+    {
+      IDataStore::ShapeType producerIndex = index;
+      do
+      {
+        if(!chunkQueue.push({producerIndex, store.getChunkValues(producerIndex)}))
+        {
+          break;
+        }
+      } while(NextChunkIndex(producerIndex, chunkLayout));
+    } catch(...)
+    {
+      producerException = std::current_exception();
+    }
+    chunkQueue.close();
+  });
+
+  Result<> result = {};
+  while(std::optional<ChunkItem> chunk = chunkQueue.pop())
+  {
+    result = WriteDataStoreChunk<T>(datasetWriter, h5dims, chunkDims, chunk->first, chunk->second, conversionBuffer);
     if(result.invalid())
     {
-      return result;
+      // Unblocks the producer so that it can finish
+      chunkQueue.close();
+      break;
     }
+  }
+  producer.join();
 
-    result = RecursivelyWriteChunks<T>(datasetWriter, store, h5dims, chunkDims, index, chunkLayout, nextIndexPos);
+  if(producerException != nullptr)
+  {
+    try
+    {
+      std::rethrow_exception(producerException);
+    } catch(const std::exception& exception)
+    {
+      return MakeErrorResult(k_ChunkReadError, fmt::format("Failed to read DataStore chunk: {}", exception.what()));
+    }
+  }
+  return result;
+#else
+  do
+  {
+    Result<> result = WriteDataStoreChunk<T>(datasetWriter, h5dims, chunkDims, index, store.getChunkValues(index), conversionBuffer);
     if(result.invalid())
     {
       return result;
     }
-  }
+  } while(NextChunkIndex(index, chunkLayout));
 
   // Successfully wrote all chunks
   return {};
+#endif
 }
+} // namespace Chunks
+
+namespace Slabs
+{
+// Upper bound for the temporary buffer used when copying values out of non-contiguous stores
+constexpr usize k_SlabTargetBytes = 16 * 1024 * 1024;
 
+/**
+ * @brief Returns a pointer to the store's values if they are held in a single
+ * contiguous buffer that can be handed to HDF5 directly. Returns nullptr otherwise.
+ * @param store
+ * @return const T*
+ */
 template <typename T>
-inline Result<> WriteDataStoreChunks(complex::HDF5::DatasetWriter& datasetWriter, const AbstractDataStore<T>& store, const std::vector<hsize_t>& h5dims)
+inline const T* GetContiguousData(const AbstractDataStore<T>& store)
 {
-  auto shapeDims = store.getTupleShape();
-  const auto componentDims = store.getComponentShape();
-  shapeDims.insert(shapeDims.end(), componentDims.begin(), componentDims.end());
+  return store.getContiguousValues(0);
+}
 
-  const auto storeChunkShape = store.getChunkShape().value();
-  complex::HDF5::DatasetWriter::DimsType chunkDims(storeChunkShape.begin(), storeChunkShape.end());
+/**
+ * @brief Writes the store to HDF5 in slabs of whole rows along the slowest
+ * dimension. Only a single slab sized buffer is allocated regardless of the
+ * size of the store.
+ * @param datasetWriter
+ * @param store
+ * @param h5dims
+ * @return Result<>
+ */
+template <typename T>
+inline Result<> WriteDataStoreSlabs(complex::HDF5::DatasetWriter& datasetWriter, const AbstractDataStore<T>& store, const complex::HDF5::DatasetWriter::DimsType& h5dims)
+{
+  Result<> result = datasetWriter.createDataset<T>(h5dims);
+  if(result.invalid())
+  {
+    return MakeErrorResult(result.errors()[0].code, "Failed to create DataStore Dataset");
+  }
+
+  const usize totalSize = store.getSize();
+  if(h5dims.empty() || totalSize == 0)
+  {
+    return {};
+  }
 
-  usize rank = shapeDims.size();
+  const usize numRows = h5dims[0];
+  const usize rowSize = totalSize / numRows;
+  const usize rowsPerSlab = std::clamp<usize>(k_SlabTargetBytes / (rowSize * sizeof(T)), 1, numRows);
+  auto buffer = std::make_unique<T[]>(rowsPerSlab * rowSize);
 
-  std::vector<hsize_t> chunkLayout(rank);
-  for(usize i = 0; i < rank; i++)
+  complex::HDF5::DatasetWriter::DimsType offset(h5dims.size(), 0);
+  complex::HDF5::DatasetWriter::DimsType count = h5dims;
+  for(usize row = 0; row < numRows; row += rowsPerSlab)
   {
-    const bool hasRemainder = (shapeDims[i] % chunkDims[i] != 0);
-    chunkLayout[i] = shapeDims[i] / chunkDims[i];
-    if(hasRemainder)
+    const usize slabRows = std::min(rowsPerSlab, numRows - row);
+    const usize startIndex = row * rowSize;
+    const usize slabSize = slabRows * rowSize;
+    if(!store.copyIntoBuffer(startIndex, nonstd::span<T>{buffer.get(), slabSize}))
     {
-      chunkLayout[i]++;
+      return MakeErrorResult(-5020, "Failed to read DataStore values for slab");
     }
-  }
 
-  IDataStore::ShapeType index(chunkDims.size());
-  std::fill(index.begin(), index.end(), 0);
+    offset[0] = row;
+    count[0] = slabRows;
+    result = datasetWriter.writeHyperslab(nonstd::span<const T>{buffer.get(), slabSize}, offset, count);
+    if(result.invalid())
+    {
+      return MakeErrorResult(result.errors()[0].code, "Failed to write DataStore slab to Dataset");
+    }
+  }
 
-  return RecursivelyWriteChunks<T>(datasetWriter, store, h5dims, chunkDims, index, chunkLayout);
+  return {};
 }
-} // namespace Chunks
+} // namespace Slabs
 
 /**
  * @brief Writes the data store to HDF5. Returns the HDF5 error code should
  * one be encountered. Otherwise, returns 0.
+ *
+ * Newly created datasets use the compression options set on the datasetWriter.
  * @param datasetWriter
  * @return H5::ErrorType
  */
@@ -173,22 +307,24 @@ inline Result<> WriteDataStore(complex::HDF5::DatasetWriter& datasetWriter, cons
     h5dims.push_back(static_cast<hsize_t>(value));
   }
 
-  if(dataStore.getChunkShape().has_value() == false)
+  // Contiguous stores are written straight from their buffer without an intermediate copy
+  if(const T* contiguousData = Slabs::GetContiguousData(dataStore); contiguousData != nullptr || dataStore.getSize() == 0)
   {
-    usize count = dataStore.getSize();
-    auto dataPtr = std::make_unique<T[]>(count);
-    for(usize i = 0; i < count; ++i)
-    {
-      dataPtr[i] = dataStore[i];
-    }
-
-    Result<> result = datasetWriter.writeSpan(h5dims, nonstd::span<const T>{dataPtr.get(), count});
+    Result<> result = datasetWriter.writeSpan(h5dims, nonstd::span<const T>{contiguousData, dataStore.getSize()});
     if(result.invalid())
     {
       std::string ss = "Failed to write DataStore span to Dataset";
       return MakeErrorResult(result.errors()[0].code, ss);
     }
   }
+  else if(dataStore.getChunkShape().has_value() == false)
+  {
+    Result<> writeResult = Slabs::WriteDataStoreSlabs<T>(datasetWriter, dataStore, h5dims);
+    if(writeResult.invalid())
+    {
+      return writeResult;
+    }
+  }
   else
   {
     Result<> writeResult = Chunks::WriteDataStoreChunks<T>(datasetWriter, dataStore, h5dims);
@@ -219,7 +355,8 @@ inline Result<> WriteDataStore(complex::HDF5::DatasetWriter& datasetWriter, cons
 }
 
 /**
- * @brief Attempts to read a DataStore<T> from the dataset reader
+ * @brief Attempts to read a DataStore<T> from the dataset reader. The store is
+ * allocated without initializing its values since the dataset overwrites all of them.
  * @param datasetReader
  * @return std::unique_ptr<DataStore<T>>
  */
@@ -230,7 +367,7 @@ inline std::unique_ptr<DataStore<T>> ReadDataStore(const complex::HDF5::DatasetR
   auto componentShape = IDataStoreIO::ReadComponentShape(datasetReader);
 
   // Create DataStore
-  auto dataStore = std::make_unique<DataStore<T>>(tupleShape, componentShape, static_cast<T>(0));
+  auto dataStore = std::make_unique<DataStore<T>>(tupleShape, componentShape, std::nullopt);
   if(!datasetReader.readIntoSpan(dataStore->createSpan()))
   {
     throw std::runtime_error(fmt::format("Error reading data array from DataStore from HDF5 at {}/{}", complex::HDF5::Support::GetObjectPath(datasetReader.getParentId()), datasetReader.getName()));
@@ -9,6 +9,8 @@
 
 #include "fmt/format.h"
 
+#include <algorithm>
+
 namespace complex::HDF5
 {
 DataStructureReader::DataStructureReader(DataIOManager* factoryManager)
@@ -20,7 +22,7 @@ DataStructureReader::~DataStructureReader() noexcept = default;
 Result<DataStructure> DataStructureReader::ReadFile(const std::filesystem::path& path, bool useEmptyDataStores)
 {
   const complex::HDF5::FileReader fileReader(path);
-  return ReadFile(fileReader);
+  return ReadFile(fileReader, useEmptyDataStores);
 }
 Result<DataStructure> DataStructureReader::ReadFile(const complex::HDF5::FileReader& fileReader, bool useEmptyDataStores)
 {
@@ -29,6 +31,14 @@ Result<DataStructure> DataStructureReader::ReadFile(const complex::HDF5::FileRea
   return dataStructureReader.readGroup(groupReader, useEmptyDataStores);
 }
 
+Result<DataStructure> DataStructureReader::ReadFile(const complex::HDF5::FileReader& fileReader, const std::vector<DataPath>& importPaths, bool useEmptyDataStores)
+{
+  DataStructureReader dataStructureReader;
+  dataStructureReader.setImportPaths(importPaths);
+  auto groupReader = fileReader.openGroup(Constants::k_DataStructureTag);
+  return dataStructureReader.readGroup(groupReader, useEmptyDataStores);
+}
+
 Result<DataStructure> DataStructureReader::readGroup(const complex::HDF5::GroupReader& groupReader, bool useEmptyDataStores)
 {
   clearDataStructure();
@@ -47,6 +57,7 @@ Result<DataStructure> DataStructureReader::readGroup(const complex::HDF5::GroupR
   }
 
   m_CurrentStructure = DataStructure();
+  m_CurrentPath.clear();
   m_CurrentStructure.setNextId(idAttribute.readAsValue<DataObject::IdType>());
   Result<> result = HDF5::ReadDataMap(*this, m_CurrentStructure.getRootGroup(), groupReader, {}, useEmptyDataStores);
   if(result.invalid())
@@ -60,6 +71,12 @@ Result<DataStructure> DataStructureReader::readGroup(const complex::HDF5::GroupR
 Result<> DataStructureReader::readObjectFromGroup(const complex::HDF5::GroupReader& parentGroup, const std::string& objectName, const std::optional<DataObject::IdType>& parentId,
                                                   bool useEmptyDataStores)
 {
+  // Skip objects outside of the selected paths without opening them.
+  if(!isImportRequired(objectName))
+  {
+    return {};
+  }
+
   std::shared_ptr<IDataIO> factory = nullptr;
   DataObject::IdType objectId = 0;
 
@@ -113,7 +130,9 @@ Result<> DataStructureReader::readObjectFromGroup(const complex::HDF5::GroupRead
 
   // Read DataObject from Factory
   {
+    m_CurrentPath.push_back(objectName);
     auto errorCode = factory->readData(*this, parentGroup, objectName, objectId, parentId, useEmptyDataStores);
+    m_CurrentPath.pop_back();
     if(errorCode.invalid())
     {
       return errorCode;
@@ -123,6 +142,42 @@ Result<> DataStructureReader::readObjectFromGroup(const complex::HDF5::GroupRead
   return {};
 }
 
+void DataStructureReader::setImportPaths(std::optional<std::vector<DataPath>> importPaths)
+{
+  m_ImportPaths = std::move(importPaths);
+}
+
+const std::optional<std::vector<DataPath>>& DataStructureReader::getImportPaths() const
+{
+  return m_ImportPaths;
+}
+
+bool DataStructureReader::isImportRequired(const std::string& objectName) const
+{
+  if(!m_ImportPaths.has_value())
+  {
+    return true;
+  }
+
+  const usize objectDepth = m_CurrentPath.size() + 1;
+  for(const auto& importPath : *m_ImportPaths)
+  {
+    // The object is required if either path is a prefix of the other.
+    const usize sharedDepth = std::min(objectDepth, importPath.getLength());
+    bool matches = true;
+    for(usize i = 0; i < sharedDepth && matches; i++)
+    {
+      const std::string& name = (i < m_CurrentPath.size()) ? m_CurrentPath[i] : objectName;
+      matches = (importPath[i] == name);
+    }
+    if(matches)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
 DataStructure& DataStructureReader::getDataStructure()
 {
   return m_CurrentStructure;
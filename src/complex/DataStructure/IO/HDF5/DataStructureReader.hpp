@@ -37,6 +37,17 @@ public:
    */
   static Result<DataStructure> ReadFile(const complex::HDF5::FileReader& fileReader, bool useEmptyDataStores = false);
 
+  /**
+   * @brief Attempts to read the DataObjects at the specified paths from the corresponding HDF5 file.
+   * Only the selected DataObjects, their parents, and their children are read. HDF5 objects
+   * outside of the selected paths are never opened.
+   * @param fileReader
+   * @param importPaths
+   * @param useEmptyDataStores = false
+   * @return Result<DataStructure>
+   */
+  static Result<DataStructure> ReadFile(const complex::HDF5::FileReader& fileReader, const std::vector<DataPath>& importPaths, bool useEmptyDataStores = false);
+
   /**
    * @brief Imports and returns a DataStructure from a target complex::HDF5::GroupReader.
    * Returns any HDF5 error code that occur by reference. Otherwise, this value
@@ -58,6 +69,21 @@ public:
    */
   Result<> readObjectFromGroup(const complex::HDF5::GroupReader& parentGroup, const std::string& objectName, const std::optional<DataObject::IdType>& parentId = {}, bool useEmptyDataStores = false);
 
+  /**
+   * @brief Restricts subsequent reads to the specified DataPaths. DataObjects that are
+   * neither a parent nor a child of one of the paths are skipped without being opened.
+   * Passing std::nullopt reads all DataObjects.
+   * @param importPaths
+   */
+  void setImportPaths(std::optional<std::vector<DataPath>> importPaths);
+
+  /**
+   * @brief Returns the DataPaths that reads are restricted to. Returns std::nullopt
+   * if all DataObjects are read.
+   * @return const std::optional<std::vector<DataPath>>&
+   */
+  const std::optional<std::vector<DataPath>>& getImportPaths() const;
+
   /**
    * @brief Returns a reference to the current DataStructure. Returns an empty
    * DataStructure when not importing from HDF5 file.
@@ -86,8 +112,18 @@ protected:
    */
   std::shared_ptr<IDataIO> getDataFactory(typename IDataIOManager::factory_id_type typeName) const;
 
+  /**
+   * @brief Returns true if the child object with the specified name in the group
+   * currently being read lies on or below one of the import paths.
+   * @param objectName
+   * @return bool
+   */
+  bool isImportRequired(const std::string& objectName) const;
+
 private:
   std::shared_ptr<DataIOManager> m_IOManager = nullptr;
   DataStructure m_CurrentStructure;
+  std::optional<std::vector<DataPath>> m_ImportPaths;
+  std::vector<std::string> m_CurrentPath;
 };
 } // namespace complex::HDF5
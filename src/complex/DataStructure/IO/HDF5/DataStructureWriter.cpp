@@ -20,7 +20,7 @@ DataStructureWriter::DataStructureWriter()
 
 DataStructureWriter::~DataStructureWriter() noexcept = default;
 
-Result<> DataStructureWriter::WriteFile(const DataStructure& dataStructure, const std::filesystem::path& filepath)
+Result<> DataStructureWriter::WriteFile(const DataStructure& dataStructure, const std::filesystem::path& filepath, const CompressionOptions& compression)
 {
   auto fileWriterResult = complex::HDF5::FileWriter::CreateFile(filepath);
   if(fileWriterResult.invalid())
@@ -29,16 +29,27 @@ Result<> DataStructureWriter::WriteFile(const DataStructure& dataStructure, cons
     return MakeErrorResult(error.code, error.message);
   }
   complex::HDF5::FileWriter fileWriter = std::move(fileWriterResult.value());
-  return WriteFile(dataStructure, fileWriter);
+  return WriteFile(dataStructure, fileWriter, compression);
 }
 
-Result<> DataStructureWriter::WriteFile(const DataStructure& dataStructure, complex::HDF5::FileWriter& fileWriter)
+Result<> DataStructureWriter::WriteFile(const DataStructure& dataStructure, complex::HDF5::FileWriter& fileWriter, const CompressionOptions& compression)
 {
   HDF5::DataStructureWriter dataStructureWriter;
+  dataStructureWriter.setCompression(compression);
   auto groupWriter = fileWriter.createGroupWriter(Constants::k_DataStructureTag);
   return dataStructureWriter.writeDataStructure(dataStructure, groupWriter);
 }
 
+const CompressionOptions& DataStructureWriter::getCompression() const
+{
+  return m_Compression;
+}
+
+void DataStructureWriter::setCompression(const CompressionOptions& compression)
+{
+  m_Compression = compression;
+}
+
 Result<> DataStructureWriter::writeDataObject(const DataObject* dataObject, complex::HDF5::GroupWriter& parentGroup)
 {
   // Check if data has already been written
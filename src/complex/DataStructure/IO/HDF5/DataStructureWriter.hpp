@@ -35,8 +35,20 @@ public:
   DataStructureWriter();
   ~DataStructureWriter() noexcept;
 
-  static Result<> WriteFile(const DataStructure& dataStructure, const std::filesystem::path& filepath);
-  static Result<> WriteFile(const DataStructure& dataStructure, FileWriter& fileWriter);
+  static Result<> WriteFile(const DataStructure& dataStructure, const std::filesystem::path& filepath, const CompressionOptions& compression = {});
+  static Result<> WriteFile(const DataStructure& dataStructure, FileWriter& fileWriter, const CompressionOptions& compression = {});
+
+  /**
+   * @brief Returns the compression options applied to numeric datasets written by this writer.
+   * @return const CompressionOptions&
+   */
+  const CompressionOptions& getCompression() const;
+
+  /**
+   * @brief Sets the compression options applied to numeric datasets written by this writer.
+   * @param compression
+   */
+  void setCompression(const CompressionOptions& compression);
 
   /**
    * @brief Writes the DataObject under the given GroupWriter. If the
@@ -133,6 +145,7 @@ private:
   DataStructure m_DataStructure;
   DataMapType m_IdMap;
   std::shared_ptr<DataIOManager> m_IOManager;
+  CompressionOptions m_Compression;
 };
 } // namespace HDF5
 } // namespace complex
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "DataStructureReader.hpp"
+#include "DataStructureWriter.hpp"
+#include "complex/DataStructure/DynamicListArray.hpp"
+#include "complex/DataStructure/Geometry/IGeometry.hpp"
+#include "complex/DataStructure/IO/HDF5/IDataIO.hpp"
+
+#include <vector>
+
+namespace complex
+{
+namespace HDF5
+{
+/**
+ * @brief The DynamicListArrayIO class reads and writes a DynamicListArray<T, K> as an HDF5 group holding
+ * its flat offsets and values arrays. Both arrays are written and read with a single HDF5 call each.
+ * @tparam T
+ * @tparam K
+ */
+template <typename T, typename K>
+class DynamicListArrayIO : public IDataIO
+{
+public:
+  using data_type = DynamicListArray<T, K>;
+
+  static inline constexpr StringLiteral k_OffsetsTag = "Offsets";
+  static inline constexpr StringLiteral k_ValuesTag = "Values";
+
+  DynamicListArrayIO() = default;
+  virtual ~DynamicListArrayIO() noexcept = default;
+
+  /**
+   * @brief Attempts to read the DynamicListArray<T, K> from HDF5.
+   * Returns a Result<> with any errors or warnings encountered during the process.
+   * When useEmptyDataStore is true, the offsets and values are not read and the
+   * DynamicListArray is imported without any lists.
+   * @param dataStructureReader
+   * @param parentGroup
+   * @param objectName
+   * @param importId
+   * @param parentId
+   * @param useEmptyDataStore = false
+   * @return Result<>
+   */
+  Result<> readData(DataStructureReader& dataStructureReader, const group_reader_type& parentGroup, const std::string& objectName, DataObject::IdType importId,
+                    const std::optional<DataObject::IdType>& parentId, bool useEmptyDataStore = false) const override
+  {
+    auto* dataObject = data_type::Import(dataStructureReader.getDataStructure(), objectName, importId, parentId);
+    if(dataObject == nullptr)
+    {
+      return MakeErrorResult(-520, fmt::format("Failed to import DynamicListArray '{}' from HDF5", objectName));
+    }
+    if(useEmptyDataStore)
+    {
+      return {};
+    }
+
+    auto groupReader = parentGroup.openGroup(objectName);
+    auto offsetsReader = groupReader.openDataset(k_OffsetsTag);
+    auto valuesReader = groupReader.openDataset(k_ValuesTag);
+
+    std::vector<usize> offsets = offsetsReader.template readAsVector<usize>();
+    std::vector<K> values = valuesReader.template readAsVector<K>();
+    if(!dataObject->setLists(std::move(offsets), std::move(values)))
+    {
+      return MakeErrorResult(-521, fmt::format("The offsets and values of DynamicListArray '{}' are inconsistent", objectName));
+    }
+    return {};
+  }
+
+  /**
+   * @brief Attempts to write the DynamicListArray<T, K> to HDF5.
+   * @param dataStructureWriter
+   * @param dynamicListArray
+   * @param parentGroupWriter
+   * @param importable
+   * @return Result<>
+   */
+  Result<> writeData(DataStructureWriter& dataStructureWriter, const data_type& dynamicListArray, group_writer_type& parentGroupWriter, bool importable) const
+  {
+    auto groupWriter = parentGroupWriter.createGroupWriter(dynamicListArray.getName());
+
+    const std::vector<usize>& offsets = dynamicListArray.getOffsets();
+    auto offsetsWriter = groupWriter.createDatasetWriter(k_OffsetsTag);
+    offsetsWriter.setCompression(dataStructureWriter.getCompression());
+    Result<> result = offsetsWriter.writeSpan(DatasetWriter::DimsType{offsets.size()}, nonstd::span<const usize>(offsets.data(), offsets.size()));
+    if(result.invalid())
+    {
+      return result;
+    }
+
+    const std::vector<K>& values = dynamicListArray.getValues();
+    auto valuesWriter = groupWriter.createDatasetWriter(k_ValuesTag);
+    valuesWriter.setCompression(dataStructureWriter.getCompression());
+    result = valuesWriter.writeSpan(DatasetWriter::DimsType{values.size()}, nonstd::span<const K>(values.data(), values.size()));
+    if(result.invalid())
+    {
+      return result;
+    }
+
+    return WriteObjectAttributes(dataStructureWriter, dynamicListArray, groupWriter, importable);
+  }
+
+  /**
+   * @brief Attempts to write the DataObject to HDF5.
+   * Returns an error if the DataObject cannot be cast to a DynamicListArray<T, K>.
+   * Otherwise, this method returns writeData(...)
+   * Return Result<>
+   */
+  Result<> writeDataObject(DataStructureWriter& dataStructureWriter, const DataObject* dataObject, group_writer_type& parentWriter) const override
+  {
+    return WriteDataObjectImpl(this, dataStructureWriter, dataObject, parentWriter);
+  }
+
+  DataObject::Type getDataType() const override
+  {
+    return DataObject::Type::DynamicListArray;
+  }
+
+  std::string getTypeName() const override
+  {
+    return DynamicListArrayConstants::k_TypeName;
+  }
+
+  DynamicListArrayIO(const DynamicListArrayIO& other) = delete;
+  DynamicListArrayIO(DynamicListArrayIO&& other) = delete;
+  DynamicListArrayIO& operator=(const DynamicListArrayIO& rhs) = delete;
+  DynamicListArrayIO& operator=(DynamicListArrayIO&& rhs) = delete;
+};
+
+using ElementDynamicListIO = DynamicListArrayIO<uint16, IGeometry::MeshIndexType>;
+} // namespace HDF5
+} // namespace complex
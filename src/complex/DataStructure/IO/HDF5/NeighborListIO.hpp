@@ -8,6 +8,7 @@
 #include "complex/DataStructure/IO/HDF5/IDataIO.hpp"
 #include "complex/DataStructure/NeighborList.hpp"
 
+#include <algorithm>
 #include <vector>
 
 namespace complex
@@ -38,8 +39,7 @@ public:
 
     auto numNeighborsReader = parentGroup.openDataset(numNeighborsName);
 
-    auto numNeighborsPtr = DataStoreIO::ReadDataStore<int32>(numNeighborsReader);
-    auto& numNeighborsStore = *numNeighborsPtr.get();
+    std::vector<int32> numNeighbors = numNeighborsReader.template readAsVector<int32>();
 
     std::vector<T> flatDataStore = dataReader.template readAsVector<T>();
     if(flatDataStore.empty())
@@ -47,20 +47,15 @@ public:
       throw std::runtime_error(fmt::format("Error reading neighbor list from DataStore from HDF5 at {}/{}", complex::HDF5::Support::GetObjectPath(dataReader.getParentId()), dataReader.getName()));
     }
 
+    // Split the flat values into one list per tuple using the NumNeighbors counts
     std::vector<shared_vector_type> dataVector;
-    usize offset = 0;
-    const auto numTuples = numNeighborsStore.getNumberOfTuples();
-    for(usize i = 0; i < numTuples; i++)
+    dataVector.reserve(numNeighbors.size());
+    auto neighborListStart = flatDataStore.cbegin();
+    for(const int32 count : numNeighbors)
     {
-      const auto numNeighbors = numNeighborsStore[i];
-      auto sharedVector = std::make_shared<std::vector<T>>(numNeighbors);
-      std::vector<T>& vector = *sharedVector.get();
-
-      size_t neighborListStart = offset;
-      size_t neighborListEnd = offset + numNeighbors;
-      sharedVector->assign(flatDataStore.begin() + neighborListStart, flatDataStore.begin() + neighborListEnd);
-      offset += numNeighbors;
-      dataVector.push_back(sharedVector);
+      auto neighborListEnd = neighborListStart + count;
+      dataVector.push_back(std::make_shared<std::vector<T>>(neighborListStart, neighborListEnd));
+      neighborListStart = neighborListEnd;
     }
 
     return dataVector;
@@ -106,15 +101,15 @@ public:
     // Create NumNeighbors DataStore
     const auto& neighborData = neighborList.getValues();
     const usize arraySize = neighborData.size();
-    auto* numNeighborsArray = Int32Array::CreateWithStore<Int32DataStore>(tmp, neighborList.getNumNeighborsArrayName(), std::vector<usize>{arraySize}, std::vector<usize>{1});
-    auto& numNeighborsStore = numNeighborsArray->getDataStoreRef();
+    auto numNeighborsStore = std::make_unique<Int32DataStore>(std::vector<usize>{arraySize}, std::vector<usize>{1}, std::nullopt);
+    int32* numNeighbors = numNeighborsStore->data();
     usize totalItems = 0;
     for(usize i = 0; i < arraySize; i++)
     {
-      const auto numNeighbors = neighborData[i]->size();
-      numNeighborsStore[i] = static_cast<int32>(numNeighbors);
-      totalItems += numNeighbors;
+      numNeighbors[i] = static_cast<int32>(neighborData[i]->size());
+      totalItems += neighborData[i]->size();
     }
+    auto* numNeighborsArray = Int32Array::Create(tmp, neighborList.getNumNeighborsArrayName(), std::move(numNeighborsStore));
 
     // Write NumNeighbors data
     DataArrayIO<int32> dataArrayIO;
@@ -124,26 +119,17 @@ public:
       return result;
     }
 
-    // Create flattened neighbor DataStore
-    DataStore<T> flattenedData(totalItems, static_cast<T>(0));
-    usize offset = 0;
+    // Create flattened neighbor DataStore by copying each list into place
+    DataStore<T> flattenedData(std::vector<usize>{totalItems}, std::vector<usize>{1}, std::nullopt);
+    T* flattenedPtr = flattenedData.data();
     for(const auto& segment : neighborData)
     {
-      usize numElements = segment->size();
-      if(numElements == 0)
-      {
-        continue;
-      }
-      T* start = segment->data();
-      for(usize i = 0; i < numElements; i++)
-      {
-        flattenedData[offset + i] = start[i];
-      }
-      offset += numElements;
+      flattenedPtr = std::copy(segment->cbegin(), segment->cend(), flattenedPtr);
     }
 
     // Write flattened array to HDF5 as a separate array
     auto datasetWriter = parentGroupWriter.createDatasetWriter(neighborList.getName());
+    datasetWriter.setCompression(dataStructureWriter.getCompression());
     Result<> flattenedResult = DataStoreIO::WriteDataStore<T>(datasetWriter, flattenedData);
     if(flattenedResult.invalid())
     {
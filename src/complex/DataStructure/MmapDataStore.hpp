@@ -0,0 +1,461 @@
+#pragma once
+
+#include "complex/DataStructure/AbstractDataStore.hpp"
+#include "complex/DataStructure/IO/Generic/IOConstants.hpp"
+#include "complex/Utilities/MemoryMappedFile.hpp"
+
+#include <fmt/core.h>
+#include <nonstd/span.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace complex
+{
+/**
+ * @class MmapDataStore
+ * @brief The MmapDataStore class stores its values in a temporary file that is
+ * memory mapped into the process. The operating system pages values in and out
+ * as they are accessed which allows arrays larger than the available RAM while
+ * still providing direct pointer access to the data.
+ * @tparam T
+ */
+template <typename T>
+class MmapDataStore : public AbstractDataStore<T>
+{
+public:
+  using parent_type = AbstractDataStore<T>;
+  using value_type = typename AbstractDataStore<T>::value_type;
+  using reference = typename AbstractDataStore<T>::reference;
+  using const_reference = typename AbstractDataStore<T>::const_reference;
+  using ShapeType = typename IDataStore::ShapeType;
+
+  /**
+   * @brief Target number of bytes in a single chunk reported by getChunkShape().
+   */
+  static constexpr usize k_TargetChunkBytes = 8 * 1024 * 1024;
+
+  /**
+   * @brief Constructs a MmapDataStore with the specified tuple and component shapes.
+   * The backing file is created inside the target directory or the system temp
+   * directory if no directory is provided.
+   *
+   * Newly created backing files are zero filled so the initValue is only written
+   * when it differs from 0. Throws a runtime_error if the backing file could not be created.
+   * @param tupleShape The dimensions of the tuples
+   * @param componentShape The dimensions of the component at each tuple
+   * @param initValue = {}
+   * @param directory = {}
+   * @throw std::runtime_error
+   */
+  MmapDataStore(const ShapeType& tupleShape, const ShapeType& componentShape, std::optional<T> initValue = {}, std::filesystem::path directory = {})
+  : parent_type()
+  , m_ComponentShape(componentShape)
+  , m_TupleShape(tupleShape)
+  , m_NumComponents(std::accumulate(m_ComponentShape.cbegin(), m_ComponentShape.cend(), static_cast<size_t>(1), std::multiplies<>()))
+  , m_NumTuples(std::accumulate(m_TupleShape.cbegin(), m_TupleShape.cend(), static_cast<size_t>(1), std::multiplies<>()))
+  , m_Directory(directory.empty() ? std::filesystem::temp_directory_path() : std::move(directory))
+  {
+    m_File = MemoryMappedFile::CreateTemporary(m_Directory, this->getSize() * sizeof(T));
+    if(m_File == nullptr)
+    {
+      throw std::runtime_error(fmt::format("Could not create a memory mapped file with {} bytes in '{}'", this->getSize() * sizeof(T), m_Directory.string()));
+    }
+    if(initValue.has_value() && *initValue != static_cast<T>(0))
+    {
+      std::fill_n(data(), this->getSize(), *initValue);
+    }
+  }
+
+  /**
+   * @brief Copy constructor. The copy is backed by its own temporary file.
+   * @param other
+   */
+  MmapDataStore(const MmapDataStore& other)
+  : MmapDataStore(other.m_TupleShape, other.m_ComponentShape, std::nullopt, other.m_Directory)
+  {
+    if(this->getSize() > 0)
+    {
+      std::memcpy(data(), other.data(), this->getSize() * sizeof(T));
+    }
+  }
+
+  /**
+   * @brief Move constructor
+   * @param other
+   */
+  MmapDataStore(MmapDataStore&& other) noexcept
+  : parent_type()
+  , m_ComponentShape(std::move(other.m_ComponentShape))
+  , m_TupleShape(std::move(other.m_TupleShape))
+  , m_NumComponents(other.m_NumComponents)
+  , m_NumTuples(other.m_NumTuples)
+  , m_Directory(std::move(other.m_Directory))
+  , m_File(std::move(other.m_File))
+  {
+  }
+
+  MmapDataStore& operator=(const MmapDataStore& rhs) = delete;
+  MmapDataStore& operator=(MmapDataStore&& rhs) = default;
+
+  ~MmapDataStore() override = default;
+
+  /**
+   * @brief Returns the number of tuples in the DataStore.
+   * @return usize
+   */
+  usize getNumberOfTuples() const override
+  {
+    return m_NumTuples;
+  }
+
+  /**
+   * @brief Returns the number of elements in each Tuple.
+   * @return usize
+   */
+  usize getNumberOfComponents() const override
+  {
+    return m_NumComponents;
+  }
+
+  /**
+   * @brief Returns the dimensions of the Tuples
+   * @return
+   */
+  const ShapeType& getTupleShape() const override
+  {
+    return m_TupleShape;
+  }
+
+  /**
+   * @brief Returns the dimensions of the Components
+   * @return
+   */
+  const ShapeType& getComponentShape() const override
+  {
+    return m_ComponentShape;
+  }
+
+  /**
+   * @brief Returns the store type e.g. in memory, out of core, etc.
+   * @return StoreType
+   */
+  IDataStore::StoreType getStoreType() const override
+  {
+    return IDataStore::StoreType::OutOfCore;
+  }
+
+  /**
+   * @brief Returns the data format used for storing the array data.
+   * @return data format as string
+   */
+  std::string getDataFormat() const override
+  {
+    return IOConstants::k_MmapDataFormat;
+  }
+
+  /**
+   * @brief The mapped file is accessed through plain pointers, so separate
+   * elements can be accessed from multiple threads like in-memory data.
+   * @return bool
+   */
+  bool isThreadSafe() const override
+  {
+    return true;
+  }
+
+  /**
+   * @brief Returns the directory the backing file was created in.
+   * @return const std::filesystem::path&
+   */
+  const std::filesystem::path& getDirectory() const
+  {
+    return m_Directory;
+  }
+
+  /**
+   * @brief Returns the pointer to the mapped data. Const version
+   * @return
+   */
+  const T* data() const
+  {
+    return reinterpret_cast<const T*>(m_File->data());
+  }
+
+  /**
+   * @brief Returns the pointer to the mapped data. Non-const version
+   * @return
+   */
+  T* data()
+  {
+    return reinterpret_cast<T*>(m_File->data());
+  }
+
+  nonstd::span<T> createSpan()
+  {
+    return {data(), this->getSize()};
+  }
+
+  nonstd::span<const T> createSpan() const
+  {
+    return {data(), this->getSize()};
+  }
+
+  /**
+   * @brief Returns a pointer to the value at startIndex.
+   * @param startIndex
+   * @return const T*
+   */
+  const T* getContiguousValues(usize startIndex) const override
+  {
+    return data() + startIndex;
+  }
+
+  /**
+   * @brief Returns a pointer to the value at startIndex.
+   * @param startIndex
+   * @return T*
+   */
+  T* getContiguousValues(usize startIndex) override
+  {
+    return data() + startIndex;
+  }
+
+  /**
+   * @brief Resizes the backing file to fit the new tuple shape. Values are
+   * preserved up to the smaller of the two sizes and any new values are 0.
+   * Throws a runtime_error if the backing file could not be resized.
+   * @param tupleShape The new shape of the data where the dimensions are "C" ordered
+   * from *slowest* to *fastest*.
+   * @throw std::runtime_error
+   */
+  void resizeTuples(const ShapeType& tupleShape) override
+  {
+    const usize numTuples = std::accumulate(tupleShape.cbegin(), tupleShape.cend(), static_cast<size_t>(1), std::multiplies<>());
+    const usize newSize = numTuples * m_NumComponents;
+    if(newSize != this->getSize() && !m_File->resize(newSize * sizeof(T)))
+    {
+      // The file keeps its old mapping when it can, otherwise the store is left empty rather than with a shape it has no data for
+      if(m_File->size() != this->getSize() * sizeof(T))
+      {
+        m_TupleShape = ShapeType{0};
+        m_NumTuples = 0;
+      }
+      throw std::runtime_error(fmt::format("Could not resize memory mapped file to {} bytes", newSize * sizeof(T)));
+    }
+    m_TupleShape = tupleShape;
+    m_NumTuples = numTuples;
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This cannot be used to edit the value found at the specified index.
+   * @param index
+   * @return value_type
+   */
+  value_type getValue(usize index) const override
+  {
+    return data()[index];
+  }
+
+  /**
+   * @brief Sets the value stored at the specified index.
+   * @param index
+   * @param value
+   */
+  void setValue(usize index, value_type value) override
+  {
+    data()[index] = value;
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This cannot be used to edit the value found at the specified index.
+   * @param  index
+   * @return const_reference
+   */
+  const_reference operator[](usize index) const override
+  {
+    return data()[index];
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This can be used to edit the value found at the specified index.
+   * @param  index
+   * @return reference
+   */
+  reference operator[](usize index) override
+  {
+    return data()[index];
+  }
+
+  /**
+   * @brief Returns the value found at the specified index of the DataStore.
+   * This cannot be used to edit the value found at the specified index.
+   * @param index
+   * @return const_reference
+   */
+  const_reference at(usize index) const override
+  {
+    if(index >= this->getSize())
+    {
+      throw std::runtime_error(fmt::format("MmapDataStore index ({}) is out of range ({})", index, this->getSize()));
+    }
+    return data()[index];
+  }
+
+  /**
+   * @brief Fills the mapped values with the specified value.
+   * @param value
+   */
+  void fill(value_type value) override
+  {
+    std::fill_n(data(), this->getSize(), value);
+  }
+
+  /**
+   * @brief Returns the chunk shape used when writing the store. Each chunk
+   * covers whole rows of the slowest tuple dimension so that chunk values are
+   * contiguous in the mapped file.
+   * @return optional Shapetype
+   */
+  std::optional<ShapeType> getChunkShape() const override
+  {
+    if(m_TupleShape.empty() || this->getSize() == 0)
+    {
+      return {};
+    }
+
+    ShapeType chunkShape = m_TupleShape;
+    chunkShape.insert(chunkShape.end(), m_ComponentShape.begin(), m_ComponentShape.end());
+    const usize rowBytes = rowSize() * sizeof(T);
+    chunkShape[0] = std::clamp<usize>(k_TargetChunkBytes / std::max<usize>(rowBytes, 1), 1, m_TupleShape[0]);
+    return chunkShape;
+  }
+
+  /**
+   * @brief Returns the values for the chunk at the specified chunk position.
+   * Chunks overlapping the end of the store are padded with 0 so that every
+   * returned chunk has the full chunk size.
+   * @param chunkPosition
+   * @return std::vector<T>
+   */
+  std::vector<T> getChunkValues(const ShapeType& chunkPosition) const override
+  {
+    const auto chunkShape = getChunkShape();
+    if(!chunkShape.has_value() || chunkPosition.empty())
+    {
+      return {};
+    }
+
+    const usize rowsPerChunk = (*chunkShape)[0];
+    const usize rowCount = rowSize();
+    const usize startRow = chunkPosition[0] * rowsPerChunk;
+    std::vector<T> chunkValues(rowsPerChunk * rowCount, static_cast<T>(0));
+    if(startRow >= m_TupleShape[0])
+    {
+      return chunkValues;
+    }
+
+    const usize numRows = std::min(rowsPerChunk, m_TupleShape[0] - startRow);
+    const T* begin = data() + startRow * rowCount;
+    std::copy(begin, begin + numRows * rowCount, chunkValues.begin());
+    return chunkValues;
+  }
+
+  /**
+   * @brief Schedules modified pages to be written back to the backing file.
+   */
+  void flush() const override
+  {
+    m_File->flush();
+  }
+
+  /**
+   * @brief Mapped pages belong to the operating system's page cache and can be
+   * evicted at any time so they are not counted towards the memory usage.
+   * @return uint64
+   */
+  uint64 memoryUsage() const override
+  {
+    return 0;
+  }
+
+  /**
+   * @brief Returns a deep copy of the data store and all its data.
+   * @return std::unique_ptr<IDataStore>
+   */
+  std::unique_ptr<IDataStore> deepCopy() const override
+  {
+    return std::make_unique<MmapDataStore<T>>(*this);
+  }
+
+  /**
+   * @brief Returns a data store of the same type as this but with default initialized data.
+   * @return std::unique_ptr<IDataStore>
+   */
+  std::unique_ptr<IDataStore> createNewInstance() const override
+  {
+    return std::make_unique<MmapDataStore<T>>(this->getTupleShape(), this->getComponentShape(), static_cast<T>(0), m_Directory);
+  }
+
+  std::pair<int32, std::string> writeBinaryFile(const std::string& absoluteFilePath) const override
+  {
+    FILE* file = fopen(absoluteFilePath.c_str(), "wb");
+    if(nullptr == file)
+    {
+      return {-10170, fmt::format("File could not be opened for writing:\n  '{}'", absoluteFilePath)};
+    }
+
+    usize totalElements = this->getSize();
+    usize elementsWritten = fwrite(data(), sizeof(T), totalElements, file);
+    fclose(file);
+    if(totalElements != elementsWritten)
+    {
+      return {-10175, fmt::format("Error writing binary file:\n  Total Elements:'{}'\n  Elements Written:'{}'", absoluteFilePath, totalElements, elementsWritten)};
+    }
+
+    return {0, ""};
+  }
+
+private:
+  /**
+   * @brief Returns the number of values in a single row of the slowest tuple dimension.
+   * @return usize
+   */
+  usize rowSize() const
+  {
+    return m_TupleShape.empty() ? 0 : (this->getSize() / m_TupleShape[0]);
+  }
+
+  ShapeType m_ComponentShape;
+  ShapeType m_TupleShape;
+  size_t m_NumComponents = {0};
+  size_t m_NumTuples = {0};
+  std::filesystem::path m_Directory;
+  std::unique_ptr<MemoryMappedFile> m_File = nullptr;
+};
+
+// Declare aliases
+using UInt8MmapDataStore = MmapDataStore<uint8>;
+using UInt16MmapDataStore = MmapDataStore<uint16>;
+using UInt32MmapDataStore = MmapDataStore<uint32>;
+using UInt64MmapDataStore = MmapDataStore<uint64>;
+
+using Int8MmapDataStore = MmapDataStore<int8>;
+using Int16MmapDataStore = MmapDataStore<int16>;
+using Int32MmapDataStore = MmapDataStore<int32>;
+using Int64MmapDataStore = MmapDataStore<int64>;
+
+using BoolMmapDataStore = MmapDataStore<bool>;
+
+using Float32MmapDataStore = MmapDataStore<float32>;
+using Float64MmapDataStore = MmapDataStore<float64>;
+} // namespace complex
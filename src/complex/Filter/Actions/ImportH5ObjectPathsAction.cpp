@@ -51,7 +51,9 @@ Result<> ImportH5ObjectPathsAction::apply(DataStructure& dataStructure, Mode mod
   bool preflighting = (mode == Mode::Preflight);
 
   complex::HDF5::FileReader fileReader(m_H5FilePath);
-  Result<DataStructure> dataStructureResult = DREAM3D::ImportDataStructureFromFile(fileReader, preflighting);
+  // Only read the selected objects when specific paths were requested
+  Result<DataStructure> dataStructureResult =
+      m_Paths.has_value() ? DREAM3D::ImportDataStructureFromFile(fileReader, m_Paths.value(), preflighting) : DREAM3D::ImportDataStructureFromFile(fileReader, preflighting);
   if(dataStructureResult.invalid())
   {
     return ConvertResult(std::move(dataStructureResult));
@@ -285,4 +285,9 @@ std::vector<std::string> IFilter::defaultTags() const
 {
   return {};
 }
+
+std::optional<usize> IFilter::slabHaloWidth(const Arguments& args) const
+{
+  return {};
+}
 } // namespace complex
@@ -188,6 +188,16 @@ public:
    */
   Result<Arguments> fromJson(const nlohmann::json& json) const;
 
+  /**
+   * @brief Returns the number of Z layers on either side of a slab that the filter reads
+   * when it only uses a bounded neighborhood of each voxel of an ImageGeom. Filters that
+   * return a value process their data one Z slab at a time through ImageSlabStreamer.
+   * Returns an empty optional if the filter needs whole arrays at once.
+   * @param args
+   * @return std::optional<usize>
+   */
+  virtual std::optional<usize> slabHaloWidth(const Arguments& args) const;
+
 protected:
   IFilter() = default;
 
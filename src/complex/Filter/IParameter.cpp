@@ -6,4 +6,21 @@ std::any IParameter::construct(const Arguments& args) const
 {
   return args.at(name());
 }
+
+std::optional<std::vector<DataPath>> IParameter::getReferencedPaths(const std::any& value) const
+{
+  if(value.type() == typeid(DataPath))
+  {
+    return std::vector<DataPath>{std::any_cast<const DataPath&>(value)};
+  }
+  if(value.type() == typeid(std::vector<DataPath>))
+  {
+    return std::any_cast<const std::vector<DataPath>&>(value);
+  }
+  if(type() == Type::Value)
+  {
+    return std::vector<DataPath>{};
+  }
+  return std::nullopt;
+}
 } // namespace complex
@@ -3,6 +3,7 @@
 #include "complex/Common/Result.hpp"
 #include "complex/Common/Types.hpp"
 #include "complex/Common/Uuid.hpp"
+#include "complex/DataStructure/DataPath.hpp"
 #include "complex/Filter/AnyCloneable.hpp"
 #include "complex/Filter/Arguments.hpp"
 #include "complex/complex_export.hpp"
@@ -138,6 +139,18 @@ public:
    */
   virtual std::any construct(const Arguments& args) const;
 
+  /**
+   * @brief Returns the DataPaths the given value refers to. These are the paths a filter
+   * may read, modify, or use as a parent for created DataObjects through this parameter.
+   * By default, DataPath and std::vector<DataPath> values are returned as is, other values
+   * of a ValueParameter refer to nothing and other values of a DataParameter cannot be
+   * determined. Parameters whose values hold DataPaths inside of another type should
+   * override this.
+   * @param value
+   * @return The referenced DataPaths or std::nullopt if they cannot be determined.
+   */
+  virtual std::optional<std::vector<DataPath>> getReferencedPaths(const std::any& value) const;
+
 protected:
   IParameter() = default;
 };
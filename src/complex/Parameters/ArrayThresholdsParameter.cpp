@@ -139,4 +139,11 @@ Result<std::any> ArrayThresholdsParameter::resolve(DataStructure& dataStructure,
 {
   return {};
 }
+
+std::optional<std::vector<DataPath>> ArrayThresholdsParameter::getReferencedPaths(const std::any& value) const
+{
+  const auto& thresholds = GetAnyRef<ValueType>(value);
+  std::set<DataPath> paths = thresholds.getRequiredPaths();
+  return std::vector<DataPath>(paths.begin(), paths.end());
+}
 } // namespace complex
@@ -131,4 +131,11 @@ Result<std::any> CalculatorParameter::resolve(DataStructure& dataStructure, cons
   DataObject* object = dataStructure.getData(structValue.m_SelectedGroup);
   return {{object}};
 }
+
+std::optional<std::vector<DataPath>> CalculatorParameter::getReferencedPaths(const std::any& value) const
+{
+  // The equation refers to arrays by name inside of the selected group
+  const auto& structValue = GetAnyRef<ValueType>(value);
+  return std::vector<DataPath>{structValue.m_SelectedGroup};
+}
 } // namespace complex
@@ -93,6 +93,8 @@ public:
    */
   Result<std::any> resolve(DataStructure& dataStructure, const std::any& value) const override;
 
+  std::optional<std::vector<DataPath>> getReferencedPaths(const std::any& value) const override;
+
 private:
   ValueType m_DefaultValue = {};
 };
@@ -30,6 +30,8 @@
 
 #include "ReadHDF5DatasetParameter.hpp"
 
+#include "complex/Common/Any.hpp"
+
 using namespace complex;
 namespace
 {
@@ -143,4 +145,15 @@ Result<> ReadHDF5DatasetParameter::validate(const std::any& value) const
   [[maybe_unused]] auto data = std::any_cast<ValueType>(value);
   return {};
 }
+
+// -----------------------------------------------------------------------------
+std::optional<std::vector<DataPath>> ReadHDF5DatasetParameter::getReferencedPaths(const std::any& value) const
+{
+  const auto& importData = GetAnyRef<ValueType>(value);
+  if(!importData.parent.has_value())
+  {
+    return std::vector<DataPath>{};
+  }
+  return std::vector<DataPath>{*importData.parent};
+}
 } // namespace complex
@@ -169,6 +169,13 @@ public:
    */
   Result<> validate(const std::any& value) const override;
 
+  /**
+   * @brief Returns the parent the datasets are imported into, if any.
+   * @param value
+   * @return std::optional<std::vector<DataPath>>
+   */
+  std::optional<std::vector<DataPath>> getReferencedPaths(const std::any& value) const override;
+
 private:
   ValueType m_DefaultValue = {};
 };
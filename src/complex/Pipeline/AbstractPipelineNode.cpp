@@ -2,6 +2,7 @@
 
 #include "complex/Core/Application.hpp"
 #include "complex/Core/Preferences.hpp"
+#include "complex/DataStructure/IDataArray.hpp"
 #include "complex/Pipeline/Messaging/NodeStatusMessage.hpp"
 #include "complex/Pipeline/Pipeline.hpp"
 
@@ -116,7 +117,32 @@ bool AbstractPipelineNode::isPreflighted() const
 void AbstractPipelineNode::endExecution(DataStructure& dataStructure)
 {
   dataStructure.flush();
+  const Pipeline* parentPipeline = getParentPipeline();
+  if(parentPipeline == nullptr || parentPipeline->storesNodeSnapshots())
+  {
+    // The copy shares DataArray values copy-on-write with dataStructure so the
+    // snapshot only costs memory for values that later filters change.
+    setDataStructure(dataStructure);
+    return;
+  }
+  if(parentPipeline->releasesUnusedData())
+  {
+    // Keeping the DataStores alive here would keep released values in memory
+    clearDataStructure();
+    return;
+  }
+  // Without snapshots the node references the DataStores being executed, so the
+  // following filters write to them in place instead of copying the values.
   setDataStructure(dataStructure);
+  for(const auto& identifier : dataStructure.getAllDataObjectIds())
+  {
+    const auto* sourceArray = dynamic_cast<const IDataArray*>(dataStructure.getData(identifier));
+    auto* nodeArray = dynamic_cast<IDataArray*>(m_DataStructure.getData(identifier));
+    if(sourceArray != nullptr && nodeArray != nullptr)
+    {
+      nodeArray->shareDataStore(*sourceArray);
+    }
+  }
 }
 
 void AbstractPipelineNode::notify(const std::shared_ptr<AbstractPipelineMessage>& msg)
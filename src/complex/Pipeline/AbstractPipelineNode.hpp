@@ -298,8 +298,9 @@ protected:
 
   /**
    * @brief Called when ending pipeline node execution.
-   * Sets the DataStructure and clears the Executing flag.
-   * If there is a parent node, sets the Executed flag.
+   * Stores a copy-on-write snapshot of the DataStructure if the parent pipeline
+   * stores node snapshots. Otherwise the stored DataStructure references the
+   * executed DataStores, or is cleared if the pipeline releases unused data.
    */
   virtual void endExecution(DataStructure& dataStructure);
 
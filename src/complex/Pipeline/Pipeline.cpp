@@ -1,6 +1,9 @@
 #include "Pipeline.hpp"
 
 #include "complex/Core/Application.hpp"
+#include "complex/DataStructure/DataArray.hpp"
+#include "complex/DataStructure/IO/Generic/DataIOCollection.hpp"
+#include "complex/DataStructure/IO/Generic/IOConstants.hpp"
 #include "complex/Filter/FilterHandle.hpp"
 #include "complex/Filter/FilterList.hpp"
 #include "complex/Pipeline/Messaging/NodeAddedMessage.hpp"
@@ -8,12 +11,16 @@
 #include "complex/Pipeline/Messaging/NodeRemovedMessage.hpp"
 #include "complex/Pipeline/Messaging/PipelineNodeMessage.hpp"
 #include "complex/Pipeline/PipelineFilter.hpp"
+#include "complex/Utilities/FilterUtilities.hpp"
 
 #include <nlohmann/json.hpp>
 
 #include <algorithm>
 #include <fstream>
+#include <map>
+#include <optional>
 #include <stdexcept>
+#include <utility>
 
 using namespace complex;
 
@@ -23,6 +30,101 @@ constexpr StringLiteral k_PipelineNameKey = "name";
 constexpr StringLiteral k_PipelineItemsKey = "pipeline";
 constexpr StringLiteral k_PipelineVersionKey = "version";
 constexpr uint64 k_PipelineVersion = 1;
+
+/**
+ * @brief Tracks when a DataArray exists in the preflight results and when it is last used.
+ * Indices refer to the enabled filters being executed.
+ */
+struct ArrayLifetime
+{
+  ArrayLifetime() = default;
+
+  explicit ArrayLifetime(usize createdIndex)
+  : created(createdIndex)
+  {
+  }
+
+  usize created = 0;
+  std::optional<usize> lastUse;
+  std::optional<usize> removed;
+  bool kept = false;
+};
+
+using ArrayPaths = std::vector<std::pair<DataObject::IdType, DataPath>>;
+
+/**
+ * @brief Moves the values of an in memory DataArray into a memory mapped file so the
+ * operating system can page them out. The values stay in memory if the file cannot
+ * be created.
+ */
+struct SpillValuesFunctor
+{
+  template <class T>
+  void operator()(IDataArray& iDataArray, DataIOCollection& ioCollection)
+  {
+    auto& dataArray = dynamic_cast<DataArray<T>&>(iDataArray);
+    const AbstractDataStore<T>& dataStore = std::as_const(dataArray).getDataStoreRef();
+    if(dataStore.getStoreType() != IDataStore::StoreType::InMemory || dataStore.getNumberOfTuples() == 0)
+    {
+      return;
+    }
+    std::shared_ptr<AbstractDataStore<T>> spilledStore;
+    try
+    {
+      spilledStore = ioCollection.createDataStoreWithType<T>(IOConstants::k_MmapDataFormat, dataStore.getTupleShape(), dataStore.getComponentShape());
+    } catch(const std::runtime_error&)
+    {
+      return;
+    }
+    if(spilledStore == nullptr || !spilledStore->copyFrom(0, dataStore, 0, dataStore.getNumberOfTuples()))
+    {
+      return;
+    }
+    dataArray.setDataStore(std::move(spilledStore));
+  }
+};
+
+/**
+ * @brief Returns the id and path of every DataArray in the DataStructure.
+ * DataArrays with more than one parent are listed once per path.
+ * @param dataStructure
+ * @return ArrayPaths
+ */
+ArrayPaths FindArrayPaths(const DataStructure& dataStructure)
+{
+  ArrayPaths arrayPaths;
+  for(const auto& path : dataStructure.getAllDataPaths())
+  {
+    const auto* dataArray = dataStructure.getDataAs<IDataArray>(path);
+    if(dataArray != nullptr)
+    {
+      arrayPaths.emplace_back(dataArray->getId(), path);
+    }
+  }
+  return arrayPaths;
+}
+
+/**
+ * @brief Returns true if path is the parentPath or one of its descendants.
+ * @param parentPath
+ * @param path
+ * @return bool
+ */
+bool IsPathOrDescendant(const DataPath& parentPath, const DataPath& path)
+{
+  if(parentPath.getLength() > path.getLength())
+  {
+    return false;
+  }
+  for(usize i = 0; i < parentPath.getLength(); i++)
+  {
+    if(parentPath[i] != path[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
 } // namespace
 
 Pipeline::Pipeline(const std::string& name, FilterList* filterList)
@@ -37,6 +139,8 @@ Pipeline::Pipeline(const Pipeline& other)
 , m_Name(other.m_Name)
 , m_Collection(other.m_Collection)
 , m_FilterList(other.m_FilterList)
+, m_StoreNodeSnapshots(other.m_StoreNodeSnapshots)
+, m_ReleaseUnusedData(other.m_ReleaseUnusedData)
 {
   resetCollectionParent();
 }
@@ -46,6 +150,8 @@ Pipeline::Pipeline(Pipeline&& other) noexcept
 , m_Name(std::move(other.m_Name))
 , m_Collection(std::move(other.m_Collection))
 , m_FilterList(std::move(other.m_FilterList))
+, m_StoreNodeSnapshots(other.m_StoreNodeSnapshots)
+, m_ReleaseUnusedData(other.m_ReleaseUnusedData)
 {
   resetCollectionParent();
 }
@@ -63,6 +169,8 @@ Pipeline& Pipeline::operator=(const Pipeline& rhs) noexcept
   m_Name = rhs.m_Name;
   m_Collection = rhs.m_Collection;
   m_FilterList = rhs.m_FilterList;
+  m_StoreNodeSnapshots = rhs.m_StoreNodeSnapshots;
+  m_ReleaseUnusedData = rhs.m_ReleaseUnusedData;
   resetCollectionParent();
   return *this;
 }
@@ -72,6 +180,8 @@ Pipeline& Pipeline::operator=(Pipeline&& rhs) noexcept
   m_Name = std::move(rhs.m_Name);
   m_Collection = std::move(rhs.m_Collection);
   m_FilterList = std::move(rhs.m_FilterList);
+  m_StoreNodeSnapshots = rhs.m_StoreNodeSnapshots;
+  m_ReleaseUnusedData = rhs.m_ReleaseUnusedData;
   resetCollectionParent();
   return *this;
 }
@@ -289,6 +399,12 @@ bool Pipeline::executeFrom(index_type index, DataStructure& dataStructure, const
     }
   }
 
+  std::vector<std::vector<DataRelease>> releasePlan;
+  if(m_ReleaseUnusedData)
+  {
+    releasePlan = planDataRelease(index);
+  }
+
   clearFaultState();
   // Loop over each filter and execute the filter.
   for(auto iter = begin() + index; iter != end(); iter++)
@@ -314,6 +430,26 @@ bool Pipeline::executeFrom(index_type index, DataStructure& dataStructure, const
       returnValue = false;
       break;
     }
+
+    if(!releasePlan.empty())
+    {
+      for(const auto& release : releasePlan[iter - (begin() + index)])
+      {
+        auto* dataArray = dataStructure.getDataAs<IDataArray>(release.path);
+        if(dataArray == nullptr)
+        {
+          continue;
+        }
+        if(release.spill)
+        {
+          ExecuteDataFunction(SpillValuesFunctor{}, dataArray->getDataType(), *dataArray, *Application::GetOrCreateInstance()->getIOCollection());
+        }
+        else
+        {
+          dataArray->releaseValues();
+        }
+      }
+    }
   }
 
   // checkDataStructureSize(dataStructure);
@@ -331,16 +467,161 @@ bool Pipeline::executeFrom(index_type index, const std::atomic_bool& shouldCance
   {
     return execute(shouldCancel);
   }
-  if(!canExecuteFrom(index))
+  if(!canExecuteFrom(index) || !m_StoreNodeSnapshots)
   {
     return false;
   }
 
+  // Copying the snapshot shares its DataArray values copy-on-write, so the
+  // filters executed below cannot modify the previous node's snapshot.
   auto* node = at(index - 1);
   DataStructure dataStructure = node->getDataStructure();
   return executeFrom(index, dataStructure, shouldCancel);
 }
 
+void Pipeline::setStoreNodeSnapshots(bool storeSnapshots)
+{
+  m_StoreNodeSnapshots = storeSnapshots;
+}
+
+bool Pipeline::storesNodeSnapshots() const
+{
+  return m_StoreNodeSnapshots;
+}
+
+void Pipeline::setReleaseUnusedData(bool releaseData)
+{
+  m_ReleaseUnusedData = releaseData;
+}
+
+bool Pipeline::releasesUnusedData() const
+{
+  return m_ReleaseUnusedData;
+}
+
+std::vector<std::vector<Pipeline::DataRelease>> Pipeline::planDataRelease(index_type index) const
+{
+  std::vector<const PipelineFilter*> filters;
+  std::vector<usize> filterOffsets;
+  for(index_type i = index; i < size(); i++)
+  {
+    const auto* node = at(i);
+    if(node->isDisabled())
+    {
+      continue;
+    }
+    const auto* filter = dynamic_cast<const PipelineFilter*>(node);
+    if(filter == nullptr || !filter->isPreflighted())
+    {
+      return {};
+    }
+    filters.push_back(filter);
+    filterOffsets.push_back(i - index);
+  }
+  if(filters.empty())
+  {
+    return {};
+  }
+
+  // The DataStructure going into the first executed filter is the preflight
+  // result of the previous enabled node
+  const DataStructure emptyStructure;
+  const DataStructure* inputStructure = &emptyStructure;
+  for(index_type i = index; i > 0; i--)
+  {
+    const auto* node = at(i - 1);
+    if(node->isDisabled())
+    {
+      continue;
+    }
+    if(!node->isPreflighted())
+    {
+      return {};
+    }
+    inputStructure = &node->getPreflightStructure();
+    break;
+  }
+
+  std::map<DataObject::IdType, ArrayLifetime> lifetimes;
+  ArrayPaths inputArrays = FindArrayPaths(*inputStructure);
+  for(const auto& inputArray : inputArrays)
+  {
+    lifetimes.emplace(inputArray.first, ArrayLifetime());
+  }
+
+  for(usize i = 0; i < filters.size(); i++)
+  {
+    const PipelineFilter* filter = filters[i];
+    const DataStructure& filterInput = i == 0 ? *inputStructure : filters[i - 1]->getPreflightStructure();
+    const DataStructure& filterOutput = filter->getPreflightStructure();
+    ArrayPaths outputArrays = FindArrayPaths(filterOutput);
+    for(const auto& outputArray : outputArrays)
+    {
+      lifetimes.emplace(outputArray.first, ArrayLifetime(i));
+    }
+    for(const auto& inputArray : inputArrays)
+    {
+      ArrayLifetime& lifetime = lifetimes[inputArray.first];
+      if(!lifetime.removed.has_value() && !filterOutput.containsData(inputArray.first))
+      {
+        lifetime.removed = i;
+      }
+    }
+
+    const std::optional<std::vector<DataPath>> filterPaths = filter->getReferencedPaths();
+    const std::vector<DataPath> referencedPaths = filterPaths.value_or(std::vector<DataPath>{});
+    const std::vector<DataPath> createdPaths = filter->getCreatedPaths();
+
+    // A filter with an argument whose paths cannot be determined, or without
+    // DataPath arguments that creates nothing, such as a file writer, may read
+    // everything in the DataStructure.
+    const bool readsEverything = !filterPaths.has_value() || (referencedPaths.empty() && createdPaths.empty());
+    // A filter that only removes the DataObjects it references does not read them.
+    const bool onlyRemoves = !readsEverything && createdPaths.empty() && std::all_of(referencedPaths.cbegin(), referencedPaths.cend(), [&filterInput, &filterOutput](const DataPath& path) {
+                               std::optional<DataObject::IdType> id = filterInput.getId(path);
+                               return id.has_value() && !filterOutput.containsData(*id);
+                             });
+    if(!onlyRemoves)
+    {
+      for(const auto& inputArray : inputArrays)
+      {
+        const bool isReferenced = readsEverything || std::any_of(referencedPaths.cbegin(), referencedPaths.cend(),
+                                                                 [&inputArray](const DataPath& path) { return IsPathOrDescendant(path, inputArray.second); });
+        if(isReferenced)
+        {
+          lifetimes[inputArray.first].lastUse = i;
+        }
+      }
+    }
+
+    inputArrays = std::move(outputArrays);
+  }
+  for(const auto& outputArray : inputArrays)
+  {
+    lifetimes[outputArray.first].kept = true;
+  }
+
+  // Release each array that is removed later in the pipeline after its last use.
+  // Arrays in the final DataStructure are spilled unless their last use is the last filter.
+  std::vector<std::vector<DataRelease>> releasePlan(size() - index);
+  for(const auto& [id, lifetime] : lifetimes)
+  {
+    const bool spill = lifetime.kept || !lifetime.removed.has_value();
+    const usize endIndex = spill ? filters.size() - 1 : *lifetime.removed;
+    const usize releaseIndex = std::max(lifetime.created, lifetime.lastUse.value_or(0));
+    if(releaseIndex >= endIndex)
+    {
+      continue;
+    }
+    std::vector<DataPath> paths = filters[releaseIndex]->getPreflightStructure().getDataPathsForId(id);
+    if(!paths.empty())
+    {
+      releasePlan[filterOffsets[releaseIndex]].push_back({paths.front(), spill});
+    }
+  }
+  return releasePlan;
+}
+
 bool Pipeline::hasWarningsBeforeIndex(index_type index) const
 {
   for(usize i = 0; i < index; i++)
@@ -251,6 +251,50 @@ public:
    */
   bool executeFrom(index_type index, const std::atomic_bool& shouldCancel = false);
 
+  /**
+   * @brief Sets whether each node keeps a snapshot of the DataStructure as it
+   * was after the node executed. Snapshots share unchanged DataArray values
+   * with the DataStructure being executed and are required to resume execution
+   * with executeFrom(index). Each array a later filter writes to is copied
+   * once per snapshot. Without snapshots each node's DataStructure references
+   * the same DataStores as the executed DataStructure, so later filters modify
+   * it. Snapshots are disabled by default.
+   * @param storeSnapshots
+   */
+  void setStoreNodeSnapshots(bool storeSnapshots);
+
+  /**
+   * @brief Returns true if each node keeps a snapshot of the DataStructure
+   * after it executes.
+   * @return bool
+   */
+  bool storesNodeSnapshots() const;
+
+  /**
+   * @brief Sets whether executing the pipeline releases the values of DataArrays
+   * once no later filter uses them. The last use of each array is determined from
+   * the preflight results of the executed nodes: the DataPath arguments of each
+   * filter and the DataObjects present in each node's preflight DataStructure.
+   * Arrays that are removed before the end of the pipeline are released. Arrays
+   * that are part of the final DataStructure are spilled to a memory mapped file
+   * instead, so the final DataStructure keeps their values. Nothing is released
+   * unless every executed node is a preflighted filter.
+   *
+   * Node snapshots share the values of released arrays, so the memory is only
+   * freed while snapshots are disabled. Nodes do not keep their DataStructure
+   * in that case.
+   * Releasing data is disabled by default.
+   * @param releaseData
+   */
+  void setReleaseUnusedData(bool releaseData);
+
+  /**
+   * @brief Returns true if executing the pipeline releases the values of
+   * DataArrays after their last use.
+   * @return bool
+   */
+  bool releasesUnusedData() const;
+
   /**
    * @brief Returns the getSize of the pipeline segment.
    * @return usize
@@ -611,11 +655,34 @@ private:
    */
   bool hasErrorsBeforeIndex(index_type index) const;
 
+  /**
+   * @brief A DataArray whose values are no longer read after a node executes.
+   * Arrays that are part of the final DataStructure are spilled to a memory
+   * mapped file instead of being released.
+   */
+  struct DataRelease
+  {
+    DataPath path;
+    bool spill = false;
+  };
+
+  /**
+   * @brief Returns the DataArrays whose values can be released or spilled after
+   * each node starting at the specified index. The outer vector is indexed by the
+   * node's offset from index. Returns an empty vector if the lifetimes cannot be
+   * determined from the preflight results.
+   * @param index
+   * @return std::vector<std::vector<DataRelease>>
+   */
+  std::vector<std::vector<DataRelease>> planDataRelease(index_type index) const;
+
   ////////////
   // Variables
   std::string m_Name;
   collection_type m_Collection;
   FilterList* m_FilterList = nullptr;
   uint64 m_MemoryRequired = 0;
+  bool m_StoreNodeSnapshots = false;
+  bool m_ReleaseUnusedData = false;
 };
 } // namespace complex
@@ -537,6 +537,38 @@ bool attemptRenamePath(DataPath& path, const AbstractPipelineNode::RenamedPaths&
   return pathChanged;
 }
 
+std::optional<std::vector<DataPath>> PipelineFilter::getReferencedPaths() const
+{
+  if(m_Filter == nullptr)
+  {
+    return std::nullopt;
+  }
+
+  // Missing arguments fall back to their default values when the filter executes
+  const Parameters parameters = m_Filter->parameters();
+  Arguments args;
+  for(const auto& [name, parameter] : parameters)
+  {
+    args.insert(name, m_Arguments.contains(name) ? m_Arguments.at(name) : parameter->defaultValue());
+  }
+
+  std::vector<DataPath> referencedPaths;
+  for(const auto& [name, parameter] : parameters)
+  {
+    if(!parameters.isParameterActive(name, args))
+    {
+      continue;
+    }
+    std::optional<std::vector<DataPath>> paths = parameter->getReferencedPaths(args.at(name));
+    if(!paths.has_value())
+    {
+      return std::nullopt;
+    }
+    referencedPaths.insert(referencedPaths.end(), paths->begin(), paths->end());
+  }
+  return referencedPaths;
+}
+
 void PipelineFilter::renamePathArgs(const RenamedPaths& renamedPaths)
 {
   for(const auto& arg : m_Arguments)
@@ -146,6 +146,16 @@ public:
    */
   std::vector<DataPath> getCreatedPaths() const;
 
+  /**
+   * @brief Returns the DataPaths referenced by the active arguments of the node,
+   * including those held inside of composite values such as array thresholds.
+   * These are the paths the filter may read, modify, or use as a parent for
+   * created DataObjects. Returns std::nullopt if a parameter cannot determine
+   * the paths its argument refers to.
+   * @return std::optional<std::vector<DataPath>>
+   */
+  std::optional<std::vector<DataPath>> getReferencedPaths() const;
+
   /**
    * @brief Returns a vector of DataPaths that would be modified when executing the node
    * @return std::vector<DataPath>
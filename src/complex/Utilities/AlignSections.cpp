@@ -3,8 +3,11 @@
 #include "complex/Utilities/ParallelAlgorithmUtilities.hpp"
 #include "complex/Utilities/ParallelDataAlgorithm.hpp"
 #include "complex/Utilities/ParallelTaskAlgorithm.hpp"
+#include "complex/Utilities/Parsing/Text/TextTokenizer.hpp"
 #include "complex/Utilities/StringUtilities.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 
 using namespace complex;
@@ -35,20 +38,36 @@ public:
   AlignSectionsTransferDataImpl& operator=(AlignSectionsTransferDataImpl&&) = delete;      // Move Assignment Not Implemented
 
   void operator()() const
+  {
+    if(m_Dims[2] < 2)
+    {
+      return;
+    }
+
+    // Every slice is only shifted within itself, so the slices can be processed concurrently
+    std::atomic<usize> completed = 0;
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(1, m_Dims[2]);
+    dataAlg.requireArraysInMemory({&m_DataArray});
+    dataAlg.execute([this, &completed](const Range& range) { shiftSlices(range.min(), range.max(), completed); });
+  }
+
+private:
+  void shiftSlices(usize start, usize end, std::atomic<usize>& completed) const
   {
     T var = static_cast<T>(0);
 
-    auto start = std::chrono::steady_clock::now();
+    auto startTime = std::chrono::steady_clock::now();
 
-    for(size_t i = 1; i < m_Dims[2]; i++)
+    for(size_t i = start; i < end; i++)
     {
       auto now = std::chrono::steady_clock::now();
       // Only send updates every 1 second
-      if(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() > 1000)
+      if(std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime).count() > 1000)
       {
-        std::string message = fmt::format("Processing {}: {}% completed", m_DataArray.getName(), static_cast<int32>(100 * (static_cast<float>(i) / static_cast<float>(m_Dims[2]))));
+        std::string message = fmt::format("Processing {}: {}% completed", m_DataArray.getName(), static_cast<int32>(100 * (static_cast<float>(completed) / static_cast<float>(m_Dims[2]))));
         m_Filter->updateProgress(message);
-        start = std::chrono::steady_clock::now();
+        startTime = std::chrono::steady_clock::now();
       }
       if(m_Filter->getCancel())
       {
@@ -90,16 +109,62 @@ public:
           }
         }
       }
+      completed++;
     }
   }
 
-private:
   AlignSections* m_Filter = nullptr;
   SizeVec3 m_Dims;
   std::vector<int64_t> m_Xshifts;
   std::vector<int64_t> m_Yshifts;
   complex::DataArray<T>& m_DataArray;
 };
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Reads one line per slice pair from a shifts file and accumulates the X and Y
+ * shifts found in the columns xColumn and xColumn + 1.
+ */
+Result<> ReadShiftsFile(const std::filesystem::path& file, int64 zDim, usize numColumns, usize xColumn, std::string_view columnsDescription, std::vector<int64>& xShifts,
+                        std::vector<int64>& yShifts)
+{
+  std::unique_ptr<TextTokenizer> tokenizer = TextTokenizer::Open(file);
+  if(tokenizer == nullptr)
+  {
+    return MakeErrorResult(-84751, fmt::format("Could not open the Input Shifts File with file path '{}'", file.string()));
+  }
+
+  usize offset = 0;
+  std::vector<std::string_view> tokens;
+  for(int64 iter = 1; iter < zDim; iter++)
+  {
+    TextTokenizer::Split(tokenizer->readLine(offset), TextTokenizer::k_Whitespace, tokens);
+    if(tokens.size() < numColumns)
+    {
+      std::string message =
+          fmt::format("Error reading line {} of Input Shifts File with file path '{}'. {} are required but only {} were found", iter, file.string(), columnsDescription, tokens.size());
+      return MakeErrorResult(-84750, message);
+    }
+
+    Result<int64> newXShift = TextTokenizer::Convert<int64>(tokens[xColumn]);
+    Result<int64> newYShift = TextTokenizer::Convert<int64>(tokens[xColumn + 1]);
+    for(Result<int64>* shift : {&newXShift, &newYShift})
+    {
+      if(shift->invalid())
+      {
+        Result<> result = ConvertResult(std::move(*shift));
+        for(Error& error : result.errors())
+        {
+          error.message = fmt::format("Error reading line {} of Input Shifts File with file path '{}': {}", iter, file.string(), error.message);
+        }
+        return result;
+      }
+    }
+    xShifts[iter] = xShifts[iter - 1] + newXShift.value();
+    yShifts[iter] = yShifts[iter - 1] + newYShift.value();
+  }
+  return {};
+}
 } // namespace
 
 // -----------------------------------------------------------------------------
@@ -122,9 +187,62 @@ const std::atomic_bool& AlignSections::getCancel()
 // -----------------------------------------------------------------------------
 void AlignSections::updateProgress(const std::string& progMessage)
 {
+  std::lock_guard<std::mutex> lock(m_ProgressMutex);
   m_MessageHandler({IFilter::Message::Type::Info, progMessage});
 }
 
+// -----------------------------------------------------------------------------
+std::vector<AlignSections::SliceShift> AlignSections::findSlicePairShifts(int64 zDim, const std::function<SliceShift(int64)>& findSliceShift,
+                                                                           const IParallelAlgorithm::AlgorithmArrays& readArrays, std::vector<int64>& xShifts, std::vector<int64>& yShifts)
+{
+  std::vector<SliceShift> relativeShifts(std::max<int64>(zDim, 0), SliceShift{0, 0});
+  if(zDim < 2)
+  {
+    return relativeShifts;
+  }
+
+  const auto numPairs = static_cast<usize>(zDim - 1);
+  std::atomic<usize> completed = 0;
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(1, static_cast<usize>(zDim));
+  dataAlg.requireArraysInMemory(readArrays);
+  dataAlg.execute([&](const Range& range) {
+    for(usize iter = range.min(); iter < range.max(); iter++)
+    {
+      if(m_ShouldCancel)
+      {
+        return;
+      }
+      // Work from the largest slice index to the lowest
+      relativeShifts[iter] = findSliceShift(zDim - 1 - static_cast<int64>(iter));
+      const usize done = ++completed;
+      if(done * 100 / numPairs != (done - 1) * 100 / numPairs)
+      {
+        updateProgress(fmt::format("Determining Shifts || {}% Complete", done * 100 / numPairs));
+      }
+    }
+  });
+
+  for(int64 iter = 1; iter < zDim; iter++)
+  {
+    xShifts[iter] = xShifts[iter - 1] + relativeShifts[iter][0];
+    yShifts[iter] = yShifts[iter - 1] + relativeShifts[iter][1];
+  }
+  return relativeShifts;
+}
+
+// -----------------------------------------------------------------------------
+int32 AlignSections::GetCoarseSearchLevels(int64 xDim, int64 yDim)
+{
+  const int64 minDim = std::min(xDim, yDim);
+  int32 levels = 0;
+  while(minDim / (int64{8} << levels) >= k_MinSearchSamples)
+  {
+    levels++;
+  }
+  return levels;
+}
+
 // -----------------------------------------------------------------------------
 Result<> AlignSections::execute(const SizeVec3& udims)
 {
@@ -170,77 +288,12 @@ Result<> AlignSections::execute(const SizeVec3& udims)
 // -----------------------------------------------------------------------------
 Result<> AlignSections::readDream3dShiftsFile(const std::filesystem::path& file, int64 zDim, std::vector<int64_t>& xShifts, std::vector<int64_t>& yShifts) const
 {
-  std::ifstream inFile;
-  inFile.open(file);
-
-  int64 slice = 0;
-  int64 newXShift = 0, newYShift = 0;
-  // These are ignored from the input file since DREAM.3D wrote the file
-  int64 slice2 = 0;
-  float32 xShift = 0.0f;
-  float32 yShift = 0.0f;
-
-  for(int64 iter = 1; iter < zDim; iter++)
-  {
-    std::string line;
-    std::getline(inFile, line);
-    std::istringstream iss(line);
-    std::vector<std::string> tokens;
-    std::string token;
-    while(iss >> token)
-    {
-      tokens.push_back(token);
-    }
-    if(tokens.size() < 6)
-    {
-      std::string message = fmt::format(
-          "Error reading line {} of Input Shifts File with file path '{}'. 6 columns in the format <Slice_A,Slice_B,New X Shift,New Y Shift,X Shift, Y Shift> are required but only {} were found",
-          iter, file.string(), tokens.size());
-      inFile.close();
-      return MakeErrorResult(-84750, message);
-    }
-    std::istringstream temp(line);
-    iss.swap(temp); // reset the stream to beginning so we can read in the formatted tokens
-    iss >> slice >> slice2 >> newXShift >> newYShift >> xShift >> yShift;
-    xShifts[iter] = xShifts[iter - 1] + newXShift;
-    yShifts[iter] = yShifts[iter - 1] + newYShift;
-  }
-  inFile.close();
-  return {};
+  // The X and Y shifts of the last two columns are ignored since DREAM.3D wrote the file
+  return ReadShiftsFile(file, zDim, 6, 2, "6 columns in the format <Slice_A,Slice_B,New X Shift,New Y Shift,X Shift, Y Shift>", xShifts, yShifts);
 }
 
 // -----------------------------------------------------------------------------
 Result<> AlignSections::readUserShiftsFile(const std::filesystem::path& file, int64 zDim, std::vector<int64_t>& xShifts, std::vector<int64_t>& yShifts) const
 {
-  int64 slice = 0;
-  int64 newXShift = 0, newYShift = 0;
-
-  std::ifstream inFile;
-  inFile.open(file);
-  for(int64 iter = 1; iter < zDim; iter++)
-  {
-    std::string line;
-    std::getline(inFile, line);
-    std::istringstream iss(line);
-    std::vector<std::string> tokens;
-    std::string token;
-    while(iss >> token)
-    {
-      tokens.push_back(token);
-    }
-    if(tokens.size() < 3)
-    {
-      std::string message = fmt::format("Error reading line {} of Input Shifts File with file path '{}'. 3 columns in the format <Slice_Number,X Shift,Y Shift> are required but only {} were found",
-                                        iter, file.string(), tokens.size());
-      inFile.close();
-      return MakeErrorResult(-84750, message);
-    }
-    std::istringstream temp(line);
-    iss.swap(temp); // reset the stream to beginning so we can read in the formatted tokens
-    inFile >> slice >> newXShift >> newYShift;
-    xShifts[iter] = xShifts[iter - 1] + newXShift;
-    yShifts[iter] = yShifts[iter - 1] + newYShift;
-  }
-  inFile.close();
-  return {};
+  return ReadShiftsFile(file, zDim, 3, 1, "3 columns in the format <Slice_Number,X Shift,Y Shift>", xShifts, yShifts);
 }
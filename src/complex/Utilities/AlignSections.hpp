@@ -6,8 +6,13 @@
 #include "complex/DataStructure/IDataArray.hpp"
 #include "complex/Filter/Arguments.hpp"
 #include "complex/Filter/IFilter.hpp"
+#include "complex/Utilities/IParallelAlgorithm.hpp"
 #include "complex/complex_export.hpp"
 
+#include <array>
+#include <functional>
+#include <mutex>
+
 namespace complex
 {
 
@@ -16,6 +21,11 @@ class IGridGeometry;
 class COMPLEX_EXPORT AlignSections
 {
 public:
+  /**
+   * @brief X and Y shift of a slice in cells.
+   */
+  using SliceShift = std::array<int64, 2>;
+
   AlignSections(DataStructure& data, const std::atomic_bool& shouldCancel, const IFilter::MessageHandler& mesgHandler);
   virtual ~AlignSections() noexcept;
 
@@ -33,6 +43,10 @@ public:
 
   const std::atomic_bool& getCancel();
 
+  /**
+   * @brief Sends an info message. Can be called from multiple threads at the same time.
+   * @param progMessage
+   */
   void updateProgress(const std::string& progMessage);
 
 protected:
@@ -46,6 +60,33 @@ protected:
 
   virtual std::vector<DataPath> getSelectedDataPaths() const = 0;
 
+  /**
+   * @brief Finds the shift of every slice relative to the slice above it. Each slice pair only
+   * depends on its two slices, so findSliceShift is called for all pairs in parallel with the
+   * index of the lower slice of the pair. The relative shifts are then accumulated from the top
+   * slice down into xShifts and yShifts.
+   * @param zDim The z dimension of the geometry being shifted
+   * @param findSliceShift Returns the shift of the given slice relative to the slice above it
+   * @param readArrays The arrays read by findSliceShift. The pairs are processed serially unless all of them are in memory.
+   * @param xShifts
+   * @param yShifts
+   * @return The relative shift of each slice pair, indexed like xShifts
+   */
+  std::vector<SliceShift> findSlicePairShifts(int64 zDim, const std::function<SliceShift(int64)>& findSliceShift, const IParallelAlgorithm::AlgorithmArrays& readArrays,
+                                              std::vector<int64>& xShifts, std::vector<int64>& yShifts);
+
+  /**
+   * @brief Returns the number of coarse levels used by a coarse-to-fine shift search. At level n
+   * the shift moves in steps of 2^n cells and every (4 * 2^n)th cell is sampled. Levels are added
+   * while at least k_MinSearchSamples cells are sampled along both X and Y.
+   * @param xDim
+   * @param yDim
+   * @return int32
+   */
+  static int32 GetCoarseSearchLevels(int64 xDim, int64 yDim);
+
+  static inline constexpr int64 k_MinSearchSamples = 16;
+
   /**
    * @brief This will read in a shifts file written by another DREAM3D alignment filter and populate the shifts parameters with the values as int64 numbers.
    * @param file The DREAM3D formatted alignment file to read
@@ -70,6 +111,7 @@ private:
   DataStructure& m_DataStructure;
   const std::atomic_bool& m_ShouldCancel;
   const IFilter::MessageHandler& m_MessageHandler;
+  std::mutex m_ProgressMutex;
 };
 
 } // namespace complex
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "complex/Common/Types.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace complex
+{
+/**
+ * @class BoundedQueue
+ * @brief The BoundedQueue class is a thread safe FIFO queue with a fixed capacity
+ * used to hand items from producer threads to consumer threads. push() blocks
+ * while the queue is full and pop() blocks while it is empty so that producers
+ * can never run arbitrarily far ahead of consumers.
+ *
+ * Calling close() wakes all waiting threads. After the queue is closed push()
+ * rejects new items and pop() returns the remaining items followed by std::nullopt.
+ * @tparam T
+ */
+template <typename T>
+class BoundedQueue
+{
+public:
+  /**
+   * @brief Constructs a BoundedQueue holding at most capacity items. A capacity of 0 is treated as 1.
+   * @param capacity
+   */
+  explicit BoundedQueue(usize capacity)
+  : m_Capacity(capacity == 0 ? 1 : capacity)
+  {
+  }
+
+  ~BoundedQueue() = default;
+
+  BoundedQueue(const BoundedQueue&) = delete;
+  BoundedQueue(BoundedQueue&&) noexcept = delete;
+  BoundedQueue& operator=(const BoundedQueue&) = delete;
+  BoundedQueue& operator=(BoundedQueue&&) noexcept = delete;
+
+  /**
+   * @brief Adds the item to the back of the queue, blocking while the queue is full.
+   * Returns false without adding the item if the queue was closed.
+   * @param item
+   * @return bool
+   */
+  bool push(T item)
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_NotFull.wait(lock, [this]() { return m_Closed || m_Items.size() < m_Capacity; });
+    if(m_Closed)
+    {
+      return false;
+    }
+    m_Items.push_back(std::move(item));
+    lock.unlock();
+    m_NotEmpty.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Removes and returns the item at the front of the queue, blocking while
+   * the queue is empty. Returns std::nullopt once the queue is closed and empty.
+   * @return std::optional<T>
+   */
+  std::optional<T> pop()
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_NotEmpty.wait(lock, [this]() { return m_Closed || !m_Items.empty(); });
+    if(m_Items.empty())
+    {
+      return std::nullopt;
+    }
+    std::optional<T> item(std::move(m_Items.front()));
+    m_Items.pop_front();
+    lock.unlock();
+    m_NotFull.notify_one();
+    return item;
+  }
+
+  /**
+   * @brief Closes the queue and wakes all waiting producers and consumers.
+   */
+  void close()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Closed = true;
+    }
+    m_NotFull.notify_all();
+    m_NotEmpty.notify_all();
+  }
+
+  /**
+   * @brief Returns true if close() has been called.
+   * @return bool
+   */
+  bool isClosed() const
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Closed;
+  }
+
+  /**
+   * @brief Returns the maximum number of items the queue can hold.
+   * @return usize
+   */
+  usize capacity() const
+  {
+    return m_Capacity;
+  }
+
+private:
+  const usize m_Capacity;
+  std::deque<T> m_Items;
+  mutable std::mutex m_Mutex;
+  std::condition_variable m_NotFull;
+  std::condition_variable m_NotEmpty;
+  bool m_Closed = false;
+};
+} // namespace complex
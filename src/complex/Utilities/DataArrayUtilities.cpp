@@ -2,6 +2,7 @@
 
 #include "complex/Common/Types.hpp"
 #include "complex/Common/TypesUtility.hpp"
+#include "complex/DataStructure/IO/Generic/IOConstants.hpp"
 #include "complex/Utilities/FilterUtilities.hpp"
 
 #include <set>
@@ -164,7 +165,12 @@ bool CheckMemoryRequirement(DataStructure& dataStructure, uint64 requiredMemory,
     // Check if out-of-core is available / enabled
     if(largeDataFormat.empty() && memoryUsage >= k_AvailableMemory)
     {
-      return false;
+      // Fall back to memory mapped storage when no other out-of-core format is selected
+      if(!Application::GetOrCreateInstance()->getIOCollection()->hasDataStoreCreationFunction(IOConstants::k_MmapDataFormat))
+      {
+        return false;
+      }
+      largeDataFormat = IOConstants::k_MmapDataFormat;
     }
     // Use out-of-core
     format = largeDataFormat;
@@ -616,29 +616,26 @@ Result<> ImportFromBinaryFile(const fs::path& binaryFilePath, DataArray<T>& outp
     FSEEK64(inputFile, static_cast<int32>(startByte), SEEK_SET);
   }
 
-  const usize numElements = outputDataArray.getSize();
-  // Now start reading the data in chunks if needed.
-  usize chunkSize = std::min(numElements, defaultBufferSize);
-  std::vector<T> buffer(chunkSize);
+  AbstractDataStore<T>& outputStore = outputDataArray.getDataStoreRef();
+  const usize numElements = outputStore.getSize();
+  // Read straight into the store's memory when it is contiguous. Otherwise read one block at a time.
+  const usize chunkSize = std::max<usize>(std::min(outputStore.getPreferredBlockSize(), defaultBufferSize), 1);
 
   usize elementCounter = 0;
   while(elementCounter < numElements)
   {
-    usize elements_read = std::fread(buffer.data(), sizeof(T), chunkSize, inputFile);
-
-    for(usize i = 0; i < elements_read; i++)
+    const usize elementsToRead = std::min(chunkSize, numElements - elementCounter);
+    usize elementsRead = 0;
     {
-      outputDataArray[i + elementCounter] = buffer[i];
+      auto outputRange = outputStore.borrowRange(elementCounter, elementsToRead);
+      elementsRead = std::fread(outputRange.data(), sizeof(T), elementsToRead, inputFile);
     }
-
-    elementCounter += elements_read;
-
-    usize elementsLeft = numElements - elementCounter;
-
-    if(elementsLeft < chunkSize)
+    if(elementsRead == 0)
     {
-      chunkSize = elementsLeft;
+      std::fclose(inputFile);
+      return MakeErrorResult(-1001, fmt::format("Unable to read {} values from '{}'. Only {} values could be read.", numElements, binaryFilePath.string(), elementCounter));
     }
+    elementCounter += elementsRead;
   }
 
   std::fclose(inputFile);
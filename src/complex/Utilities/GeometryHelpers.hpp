@@ -9,6 +9,9 @@
 
 #include <Eigen/Dense>
 
+#include <numeric>
+#include <vector>
+
 namespace complex
 {
 namespace GeometryHelpers
@@ -33,7 +36,9 @@ COMPLEX_EXPORT std::string GenerateGeometryInfo(const complex::SizeVec3& dims, c
 namespace Connectivity
 {
 /**
- * @brief
+ * @brief Builds the list of elements that use each vertex. The lists are built in bulk
+ * directly into the offsets and values arrays of the DynamicListArray and each list is
+ * sorted by element id.
  * @tparam T
  * @tparam K
  * @param elemList
@@ -43,48 +48,42 @@ namespace Connectivity
 template <typename T, typename K>
 void FindElementsContainingVert(const DataArray<K>* elemList, DynamicListArray<T, K>* dynamicList, usize numVerts)
 {
-  DataStructure* dataStructure = dynamicList->getDataStructure();
-  auto parentId = dynamicList->getParentIds().front();
-
-  auto& elems = *elemList;
+  const auto& elems = *elemList;
   const usize numElems = elemList->getNumberOfTuples();
   const usize numVertsPerElem = elemList->getNumberOfComponents();
 
-  // Allocate the basic structures
-  std::vector<T> linkCount(numVerts, 0);
-
-  // Fill out lists with number of references to cells
-  auto dataStore = std::make_unique<DataStore<K>>(numVerts, static_cast<K>(0));
-  DataArray<K>* linkLocPtr = DataArray<K>::Create(*dataStructure, "_INTERNAL_USE_ONLY_Vertices", std::move(dataStore), parentId);
-  auto linkLoc = *linkLocPtr;
-  K* verts = nullptr;
-
-  // vtkPolyData *pdata = static_cast<vtkPolyData *>(data);
-  // Traverse data to determine number of uses of each point
+  // Count the number of elements that use each vertex and turn the counts into list offsets
+  std::vector<usize> offsets(numVerts + 1, 0);
   for(usize elemId = 0; elemId < numElems; elemId++)
   {
-    usize offset = elemId * numVertsPerElem;
+    const usize offset = elemId * numVertsPerElem;
     for(usize j = 0; j < numVertsPerElem; j++)
     {
-      linkCount[elems[offset + j]]++;
+      offsets[static_cast<usize>(elems[offset + j]) + 1]++;
     }
   }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
 
-  // Now allocate storage for the links
-  dynamicList->allocateLists(linkCount);
-
+  // Scatter the element ids into the lists
+  std::vector<K> values(offsets.back(), static_cast<K>(0));
+  std::vector<usize> insertPositions(offsets.begin(), offsets.end() - 1);
   for(usize elemId = 0; elemId < numElems; elemId++)
   {
-    usize offset = elemId * numVertsPerElem;
+    const usize offset = elemId * numVertsPerElem;
     for(usize j = 0; j < numVertsPerElem; j++)
     {
-      dynamicList->insertCellReference(elems[offset + j], (linkLoc[elems[offset + j]])++, elemId);
+      values[insertPositions[static_cast<usize>(elems[offset + j])]++] = static_cast<K>(elemId);
     }
   }
+
+  dynamicList->setLists(std::move(offsets), std::move(values));
 }
 
 /**
- * @brief
+ * @brief Builds the list of neighbors of each element. Two elements are neighbors if they
+ * share the number of vertices that make up a face of the geometry type (1 for edges, 2 for
+ * triangles and quads, 3 for tetrahedra and 4 for hexahedra). The lists are built in bulk
+ * directly into the offsets and values arrays of the DynamicListArray.
  * @tparam T
  * @tparam K
  * @param elemList
@@ -96,14 +95,10 @@ void FindElementsContainingVert(const DataArray<K>* elemList, DynamicListArray<T
 template <typename T, typename K>
 ErrorCode FindElementNeighbors(const DataArray<K>* elemList, const DynamicListArray<T, K>* elemsContainingVert, DynamicListArray<T, K>* dynamicList, IGeometry::Type geometryType)
 {
-  DataStructure* dataStructure = dynamicList->getDataStructure();
-  auto parentId = dynamicList->getParentIds().front();
-  auto& elems = *elemList;
+  const auto& elems = *elemList;
   const usize numElems = elemList->getNumberOfTuples();
   const usize numVertsPerElem = elemList->getNumberOfComponents();
   usize numSharedVerts = 0;
-  std::vector<T> linkCount(numElems, 0);
-  ErrorCode err = 0;
 
   switch(geometryType)
   {
@@ -142,80 +137,67 @@ ErrorCode FindElementNeighbors(const DataArray<K>* elemList, const DynamicListAr
     return -1;
   }
 
-  dynamicList->allocateLists(linkCount);
+  std::vector<usize> offsets(numElems + 1, 0);
+  std::vector<K> values;
 
-  // Allocate an array of bools that we use each iteration so that we don't put duplicates into the array
-  auto visitedDataStore = std::make_unique<DataStore<uint8>>(numElems, 0);
-  DataArray<uint8>* visitedPtr = DataArray<uint8>::Create(*dataStructure, "_INTERNAL_USE_ONLY_Visited", std::move(visitedDataStore), parentId);
-  auto& visited = *visitedPtr;
+  // Flags the elements already added to the current list so that we don't put duplicates into it
+  std::vector<uint8> visited(numElems, 0);
 
   // Reuse this vector for each loop. Avoids re-allocating the memory each time through the loop
-  std::vector<K> loop_neighbors(32, 0);
+  std::vector<K> loopNeighbors;
 
   // Build up the element adjacency list now that we have the element links
   for(usize t = 0; t < numElems; ++t)
   {
-    //   qDebug() << "Analyzing Cell " << t << "\n";
+    loopNeighbors.clear();
     const usize offset = t * numVertsPerElem;
     for(usize v = 0; v < numVertsPerElem; ++v)
     {
-      //   qDebug() << " vert " << v << "\n";
-      T nEs = elemsContainingVert->getNumberOfElements(elems[offset + v]);
-      K* vertIdxs = elemsContainingVert->getElementListPointer(elems[offset + v]);
+      const usize vertId = static_cast<usize>(elems[offset + v]);
+      const T nEs = elemsContainingVert->getNumberOfElements(vertId);
+      const K* vertIdxs = elemsContainingVert->getElementListPointer(vertId);
 
       for(T vt = 0; vt < nEs; ++vt)
       {
-        if(vertIdxs[vt] == static_cast<K>(t))
-        {
-          continue;
-        } // This is the same element as our "source"
-        if(visited[vertIdxs[vt]])
+        const K neighbor = vertIdxs[vt];
+        if(neighbor == static_cast<K>(t) || visited[neighbor] != 0)
         {
           continue;
-        } // We already added this element so loop again
-        //      qDebug() << "   Comparing Element " << vertIdxs[vt] << "\n";
+        }
+        // Count the vertices the two elements have in common. If they share numSharedVerts
+        // of them the candidate is a neighbor of the source element.
+        const usize neighborOffset = static_cast<usize>(neighbor) * numVertsPerElem;
         usize vCount = 0;
-        // Loop over all the vertex indices of this element and try to match numSharedVerts of them to the current loop element
-        // If there is numSharedVerts match then that element is a neighbor of the source. If there are more than numVertsPerElem
-        // matches then there is a real problem with the mesh and the program is going to return an error.
         for(usize i = 0; i < numVertsPerElem; i++)
         {
           for(usize j = 0; j < numVertsPerElem; j++)
           {
-            if(elems[offset + i] == elems[offset + j])
+            if(elems[offset + i] == elems[neighborOffset + j])
             {
               vCount++;
             }
           }
         }
 
-        // So if our vertex match count is numSharedVerts and we have not visited the element in question then add this element index
-        // into the list of vertex indices as neighbors for the source element.
         if(vCount == numSharedVerts)
         {
-          // qDebug() << "       Neighbor: " << vertIdxs[vt] << "\n";
-          // Use the current count of neighbors as the index
-          // into the loop_neighbors vector and place the value of the vertex element at that index
-          loop_neighbors[linkCount[t]] = vertIdxs[vt];
-          linkCount[t]++; // Increment the count for the next time through
-          if(linkCount[t] >= loop_neighbors.size())
-          {
-            loop_neighbors.resize(loop_neighbors.size() + 10);
-          }
-          visited[vertIdxs[vt]] = true; // Set this element as visited so we do NOT add it again
+          loopNeighbors.push_back(neighbor);
+          visited[neighbor] = 1;
         }
       }
     }
-    // Reset all the visited cell indexs back to false (zero)
-    for(int64 k = 0; k < linkCount[t]; ++k)
+    // Reset all the visited element indices back to false (zero)
+    for(K neighbor : loopNeighbors)
     {
-      visited[loop_neighbors[k]] = false;
+      visited[neighbor] = 0;
     }
-    // Allocate the array storage for the current edge to hold its vertex list
-    dynamicList->setElementList(t, linkCount[t], &(loop_neighbors[0]));
+    values.insert(values.end(), loopNeighbors.begin(), loopNeighbors.end());
+    offsets[t + 1] = values.size();
   }
 
-  return err;
+  dynamicList->setLists(std::move(offsets), std::move(values));
+
+  return 0;
 }
 
 /**
@@ -2,16 +2,41 @@
 
 #include "complex/Core/Application.hpp"
 
+#ifdef COMPLEX_ENABLE_MULTICORE
+#include <tbb/global_control.h>
+#include <tbb/task_arena.h>
+#endif
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <optional>
+
 namespace complex
 {
 // -----------------------------------------------------------------------------
 bool IParallelAlgorithm::CheckArraysInMemory(const AlgorithmArrays& arrays)
 {
-  if(arrays.empty())
+  for(const auto* arrayPtr : arrays)
   {
-    return true;
+    if(arrayPtr == nullptr)
+    {
+      continue;
+    }
+
+    if(!arrayPtr->getIDataStoreRef().isThreadSafe())
+    {
+      return false;
+    }
   }
 
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+IDataStore::ShapeType IParallelAlgorithm::GetChunkTupleShape(const AlgorithmArrays& arrays)
+{
+  IDataStore::ShapeType combinedShape;
   for(const auto* arrayPtr : arrays)
   {
     if(arrayPtr == nullptr)
@@ -19,20 +44,38 @@ bool IParallelAlgorithm::CheckArraysInMemory(const AlgorithmArrays& arrays)
       continue;
     }
 
-    if(!arrayPtr->getIDataStoreRef().getDataFormat().empty())
+    const IDataStore& dataStore = arrayPtr->getIDataStoreRef();
+    const std::optional<IDataStore::ShapeType> chunkShape = dataStore.getChunkShape();
+    const IDataStore::ShapeType& tupleShape = dataStore.getTupleShape();
+    if(!chunkShape.has_value() || chunkShape->size() < tupleShape.size() || tupleShape.empty())
     {
-      return false;
+      continue;
+    }
+
+    if(combinedShape.empty())
+    {
+      combinedShape.assign(chunkShape->cbegin(), chunkShape->cbegin() + tupleShape.size());
+      continue;
+    }
+    if(combinedShape.size() != tupleShape.size())
+    {
+      continue;
+    }
+    for(usize i = 0; i < tupleShape.size(); i++)
+    {
+      combinedShape[i] = std::min(std::lcm(combinedShape[i], std::max<usize>((*chunkShape)[i], 1)), std::max<usize>(tupleShape[i], 1));
     }
   }
 
-  return true;
+  return combinedShape;
 }
 
 // -----------------------------------------------------------------------------
 IParallelAlgorithm::IParallelAlgorithm()
 {
 #ifdef COMPLEX_ENABLE_MULTICORE
-  // Do not run OOC data in parallel by default.
+  // Do not run OOC data in parallel by default. Algorithms that declare their arrays
+  // through requireArraysInMemory run in parallel when those arrays are thread safe.
   m_RunParallel = !Application::GetOrCreateInstance()->getPreferences()->useOocData();
 #endif
 }
@@ -53,9 +96,55 @@ void IParallelAlgorithm::setParallelizationEnabled(bool doParallel)
   m_RunParallel = doParallel;
 #endif
 }
+
 // -----------------------------------------------------------------------------
 void IParallelAlgorithm::requireArraysInMemory(const AlgorithmArrays& arrays)
 {
-  setParallelizationEnabled(!CheckArraysInMemory(arrays));
+  setParallelizationEnabled(CheckArraysInMemory(arrays));
+
+  m_ChunkShape = GetChunkTupleShape(arrays);
+  m_TupleShape.clear();
+  for(const auto* arrayPtr : arrays)
+  {
+    if(arrayPtr != nullptr && arrayPtr->getTupleShape().size() == m_ChunkShape.size())
+    {
+      m_TupleShape = arrayPtr->getTupleShape();
+      break;
+    }
+  }
+  if(m_TupleShape.empty())
+  {
+    m_ChunkShape.clear();
+  }
+}
+
+// -----------------------------------------------------------------------------
+usize IParallelAlgorithm::getMaxThreads() const
+{
+#ifdef COMPLEX_ENABLE_MULTICORE
+  if(m_RunParallel)
+  {
+    const usize arenaThreads = static_cast<usize>(std::max(tbb::this_task_arena::max_concurrency(), 1));
+    const usize allowedThreads = tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism);
+    return std::max<usize>(std::min(arenaThreads, allowedThreads), 1);
+  }
+#endif
+  return 1;
+}
+
+// -----------------------------------------------------------------------------
+const IDataStore::ShapeType& IParallelAlgorithm::getChunkShape() const
+{
+  return m_ChunkShape;
+}
+
+// -----------------------------------------------------------------------------
+usize IParallelAlgorithm::getChunkTupleCount() const
+{
+  if(m_ChunkShape.empty())
+  {
+    return 0;
+  }
+  return std::accumulate(m_TupleShape.cbegin() + 1, m_TupleShape.cend(), m_ChunkShape[0], std::multiplies<>());
 }
 } // namespace complex
@@ -13,8 +13,25 @@ class COMPLEX_EXPORT IParallelAlgorithm
 public:
   using AlgorithmArrays = std::vector<const IDataArray*>;
 
+  /**
+   * @brief Returns true if every array can be accessed from multiple threads at
+   * the same time. In-memory and memory mapped arrays qualify. Other out-of-core
+   * formats do not. Null arrays are ignored.
+   * @param arrays
+   * @return bool
+   */
   static bool CheckArraysInMemory(const AlgorithmArrays& arrays);
 
+  /**
+   * @brief Returns the tuple shape of the chunks shared by the given arrays. The
+   * combined chunk is the smallest shape made up of whole chunks from every
+   * chunked array with a matching tuple rank. Returns an empty shape if none of
+   * the arrays are chunked.
+   * @param arrays
+   * @return ShapeType
+   */
+  static IDataStore::ShapeType GetChunkTupleShape(const AlgorithmArrays& arrays);
+
   IParallelAlgorithm(const IParallelAlgorithm&) = default;
   IParallelAlgorithm(IParallelAlgorithm&&) noexcept = default;
   IParallelAlgorithm& operator=(const IParallelAlgorithm&) = default;
@@ -32,17 +49,49 @@ public:
    */
   void setParallelizationEnabled(bool doParallel);
 
+  /**
+   * @brief Enables parallelization if every array can be accessed from multiple
+   * threads and disables it otherwise. Parallelization is off by default while an
+   * out-of-core format is in use, so algorithms should declare the arrays they
+   * access here. The chunk shape of the arrays is recorded so that the algorithm
+   * hands whole chunks to each worker.
+   * @param arrays
+   */
   void requireArraysInMemory(const AlgorithmArrays& arrays);
 
+  /**
+   * @brief Returns the number of threads the algorithm runs on. This is the
+   * concurrency of the current TBB task arena limited by any tbb::global_control
+   * thread limit, or 1 if parallelization is disabled.
+   * @return usize
+   */
+  usize getMaxThreads() const;
+
 protected:
   IParallelAlgorithm();
   ~IParallelAlgorithm();
 
+  /**
+   * @brief Returns the chunk tuple shape recorded by requireArraysInMemory.
+   * Returns an empty shape if the arrays are not chunked.
+   * @return const ShapeType&
+   */
+  const IDataStore::ShapeType& getChunkShape() const;
+
+  /**
+   * @brief Returns the number of consecutive tuples that covers whole rows of
+   * chunks along the slowest dimension. Returns 0 if the arrays are not chunked.
+   * @return usize
+   */
+  usize getChunkTupleCount() const;
+
 private:
 #ifdef COMPLEX_ENABLE_MULTICORE
   bool m_RunParallel = true;
 #else
   bool m_RunParallel = false;
 #endif
+  IDataStore::ShapeType m_TupleShape;
+  IDataStore::ShapeType m_ChunkShape;
 };
 } // namespace complex
@@ -0,0 +1,243 @@
+#include "ImageSlabStreamer.hpp"
+
+#include "complex/Core/Application.hpp"
+#include "complex/Core/Preferences.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <future>
+
+using namespace complex;
+
+// -----------------------------------------------------------------------------
+const ImageGeom::ZSlab& ImageSlabStreamer::Slab::getRange() const
+{
+  return m_Range;
+}
+
+// -----------------------------------------------------------------------------
+SizeVec3 ImageSlabStreamer::Slab::getDimensions() const
+{
+  return {m_VolumeDims[0], m_VolumeDims[1], m_Range.haloEnd - m_Range.haloStart};
+}
+
+// -----------------------------------------------------------------------------
+usize ImageSlabStreamer::Slab::getCoreStart() const
+{
+  return m_Range.zStart - m_Range.haloStart;
+}
+
+// -----------------------------------------------------------------------------
+usize ImageSlabStreamer::Slab::getCoreEnd() const
+{
+  return m_Range.zEnd - m_Range.haloStart;
+}
+
+// -----------------------------------------------------------------------------
+bool ImageSlabStreamer::Slab::isVolumeStart() const
+{
+  return m_Range.haloStart == 0;
+}
+
+// -----------------------------------------------------------------------------
+bool ImageSlabStreamer::Slab::isVolumeEnd() const
+{
+  return m_Range.haloEnd == m_VolumeDims[2];
+}
+
+// -----------------------------------------------------------------------------
+ImageSlabStreamer::ImageSlabStreamer(const ImageGeom& imageGeom, usize haloWidth)
+: m_Dims(imageGeom.getDimensions())
+, m_HaloWidth(haloWidth)
+, m_ImageGeom(imageGeom)
+{
+}
+
+// -----------------------------------------------------------------------------
+ImageSlabStreamer::~ImageSlabStreamer() noexcept = default;
+
+// -----------------------------------------------------------------------------
+usize ImageSlabStreamer::getSlabDepth() const
+{
+  if(m_SlabDepth > 0)
+  {
+    return std::max(m_SlabDepth, m_HaloWidth);
+  }
+
+  const bool allInMemory = std::all_of(m_Arrays.cbegin(), m_Arrays.cend(), [](const StreamedArray& array) { return array.inMemory; });
+  if(allInMemory)
+  {
+    return std::max<usize>(m_Dims[2], 1);
+  }
+
+  usize bytesPerLayer = 0;
+  for(const auto& array : m_Arrays)
+  {
+    bytesPerLayer += array.bytesPerTuple * m_Dims[0] * m_Dims[1];
+  }
+  bytesPerLayer = std::max<usize>(bytesPerLayer, 1);
+
+  // Two slabs including their halos are resident at the same time
+  const auto memoryBudget = Application::GetOrCreateInstance()->getPreferences()->valueAs<uint64>(Preferences::k_LargeDataSize_Key);
+  const usize layersPerSlab = static_cast<usize>(memoryBudget / (2 * bytesPerLayer));
+  const usize slabDepth = layersPerSlab > 2 * m_HaloWidth ? layersPerSlab - 2 * m_HaloWidth : 1;
+  return std::max<usize>(slabDepth, std::max<usize>(m_HaloWidth, 1));
+}
+
+// -----------------------------------------------------------------------------
+void ImageSlabStreamer::setSlabDepth(usize slabDepth)
+{
+  m_SlabDepth = slabDepth;
+}
+
+// -----------------------------------------------------------------------------
+bool ImageSlabStreamer::useArraysInPlace(Slab& slab, const ImageGeom::ZSlab& range) const
+{
+  slab.m_Range = range;
+  slab.m_VolumeDims = m_Dims;
+  slab.m_Buffers.clear();
+  for(const auto& array : m_Arrays)
+  {
+    std::shared_ptr<IDataStore> buffer = array.inPlaceBuffer();
+    if(buffer == nullptr)
+    {
+      slab.m_Buffers.clear();
+      return false;
+    }
+    slab.m_Buffers.push_back(std::move(buffer));
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+Result<> ImageSlabStreamer::loadSlab(Slab& slab, const ImageGeom::ZSlab& range) const
+{
+  const usize layerTuples = m_Dims[0] * m_Dims[1];
+  slab.m_Range = range;
+  slab.m_VolumeDims = m_Dims;
+  for(usize i = 0; i < m_Arrays.size(); i++)
+  {
+    const StreamedArray& array = m_Arrays[i];
+    if(!array.read)
+    {
+      continue;
+    }
+    if(!array.load(*slab.m_Buffers[i], range.haloStart * layerTuples, (range.haloEnd - range.haloStart) * layerTuples))
+    {
+      return MakeErrorResult(-4850, fmt::format("Failed to read Z layers {} to {} of streamed array {}", range.haloStart, range.haloEnd, i));
+    }
+  }
+  return {};
+}
+
+// -----------------------------------------------------------------------------
+Result<> ImageSlabStreamer::storeSlab(const Slab& slab) const
+{
+  const usize layerTuples = m_Dims[0] * m_Dims[1];
+  const ImageGeom::ZSlab& range = slab.m_Range;
+  for(usize i = 0; i < m_Arrays.size(); i++)
+  {
+    const StreamedArray& array = m_Arrays[i];
+    if(!array.write)
+    {
+      continue;
+    }
+    if(!array.store(*slab.m_Buffers[i], slab.getCoreStart() * layerTuples, range.zStart * layerTuples, (range.zEnd - range.zStart) * layerTuples))
+    {
+      return MakeErrorResult(-4851, fmt::format("Failed to write Z layers {} to {} of streamed array {}", range.zStart, range.zEnd, i));
+    }
+  }
+  return {};
+}
+
+// -----------------------------------------------------------------------------
+Result<> ImageSlabStreamer::execute(const SlabFunction& function, const std::atomic_bool& shouldCancel)
+{
+  const usize slabDepth = getSlabDepth();
+  const std::vector<ImageGeom::ZSlab> zSlabs = m_ImageGeom.getZSlabs(slabDepth, m_HaloWidth);
+  if(zSlabs.empty())
+  {
+    return {};
+  }
+
+  // A single slab of in-memory arrays needs no copies, the algorithm runs on the arrays directly
+  if(zSlabs.size() == 1)
+  {
+    Slab slab;
+    if(useArraysInPlace(slab, zSlabs[0]))
+    {
+      if(shouldCancel)
+      {
+        return {};
+      }
+      return function(slab);
+    }
+  }
+
+  // Allocate the buffers for two slabs once and reuse them for every slab
+  usize maxLayers = 0;
+  for(const auto& range : zSlabs)
+  {
+    maxLayers = std::max(maxLayers, range.haloEnd - range.haloStart);
+  }
+  const usize bufferTuples = maxLayers * m_Dims[0] * m_Dims[1];
+  std::array<Slab, 2> slabs;
+  for(auto& slab : slabs)
+  {
+    for(const auto& array : m_Arrays)
+    {
+      slab.m_Buffers.push_back(array.createBuffer(bufferTuples));
+    }
+    if(zSlabs.size() == 1)
+    {
+      break;
+    }
+  }
+
+  Result<> result = loadSlab(slabs[0], zSlabs[0]);
+  if(result.invalid())
+  {
+    return result;
+  }
+
+  for(usize i = 0; i < zSlabs.size(); i++)
+  {
+    if(shouldCancel)
+    {
+      return {};
+    }
+
+    Slab& currentSlab = slabs[i % 2];
+
+    // Read the next slab while the current slab is processed
+    std::future<Result<>> nextSlab;
+    if(i + 1 < zSlabs.size())
+    {
+      Slab& next = slabs[(i + 1) % 2];
+      const ImageGeom::ZSlab& nextRange = zSlabs[i + 1];
+      nextSlab = std::async(std::launch::async, [this, &next, &nextRange]() { return loadSlab(next, nextRange); });
+    }
+
+    result = function(currentSlab);
+    Result<> nextResult = nextSlab.valid() ? nextSlab.get() : Result<>{};
+    if(result.invalid())
+    {
+      return result;
+    }
+    if(nextResult.invalid())
+    {
+      return nextResult;
+    }
+
+    // The next slab's halo has been read, so the current slab can be written back
+    result = storeSlab(currentSlab);
+    if(result.invalid())
+    {
+      return result;
+    }
+  }
+
+  return {};
+}
@@ -0,0 +1,214 @@
+#pragma once
+
+#include "complex/Common/Result.hpp"
+#include "complex/Common/Types.hpp"
+#include "complex/DataStructure/AbstractDataStore.hpp"
+#include "complex/DataStructure/DataStore.hpp"
+#include "complex/DataStructure/Geometry/ImageGeom.hpp"
+#include "complex/complex_export.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace complex
+{
+/**
+ * @class ImageSlabStreamer
+ * @brief The ImageSlabStreamer class runs a voxel-local algorithm over an ImageGeom
+ * one Z slab at a time. Each slab is copied into in-memory buffers together with
+ * a halo of neighboring layers, processed, and the slab layers of the output
+ * arrays are copied back. Only two slabs are resident at any time and the next
+ * slab is read while the current one is processed, so out-of-core arrays larger
+ * than the available memory can be processed with bounded memory.
+ *
+ * An array may be both read and written. Writing a slab back is delayed until
+ * the halo of the next slab has been read, so the halo always holds the values
+ * from before the algorithm ran.
+ *
+ * When the whole geometry is a single slab and every array is an in-memory
+ * DataStore, nothing is copied and the buffers are the arrays themselves. The
+ * algorithm must therefore not write to the buffers of input arrays.
+ */
+class COMPLEX_EXPORT ImageSlabStreamer
+{
+public:
+  /**
+   * @brief The in-memory buffers for a single slab. Buffers cover the layers
+   * [haloStart, haloEnd) of the slab and are indexed like the ImageGeom with
+   * the Z index offset by haloStart.
+   */
+  class COMPLEX_EXPORT Slab
+  {
+  public:
+    /**
+     * @brief Returns the layers processed by this slab and its halo.
+     * @return const ImageGeom::ZSlab&
+     */
+    const ImageGeom::ZSlab& getRange() const;
+
+    /**
+     * @brief Returns the dimensions of the buffered region in X, Y, Z order.
+     * @return SizeVec3
+     */
+    SizeVec3 getDimensions() const;
+
+    /**
+     * @brief Returns the buffer Z index of the first layer owned by the slab.
+     * @return usize
+     */
+    usize getCoreStart() const;
+
+    /**
+     * @brief Returns the buffer Z index one past the last layer owned by the slab.
+     * @return usize
+     */
+    usize getCoreEnd() const;
+
+    /**
+     * @brief Returns true if the first buffered layer is the first layer of the geometry.
+     * @return bool
+     */
+    bool isVolumeStart() const;
+
+    /**
+     * @brief Returns true if the last buffered layer is the last layer of the geometry.
+     * @return bool
+     */
+    bool isVolumeEnd() const;
+
+    /**
+     * @brief Returns the buffer for the array at the index returned by addInput or addOutput.
+     * @param index
+     * @return DataStore<T>&
+     */
+    template <typename T>
+    DataStore<T>& getBuffer(usize index)
+    {
+      return dynamic_cast<DataStore<T>&>(*m_Buffers.at(index));
+    }
+
+  private:
+    friend class ImageSlabStreamer;
+
+    ImageGeom::ZSlab m_Range;
+    SizeVec3 m_VolumeDims;
+    std::vector<std::shared_ptr<IDataStore>> m_Buffers;
+  };
+
+  using SlabFunction = std::function<Result<>(Slab&)>;
+
+  /**
+   * @brief Creates a streamer over the given geometry. haloWidth is the number of
+   * layers on either side of a slab that the algorithm reads.
+   * @param imageGeom
+   * @param haloWidth
+   */
+  ImageSlabStreamer(const ImageGeom& imageGeom, usize haloWidth);
+  ~ImageSlabStreamer() noexcept;
+
+  ImageSlabStreamer(const ImageSlabStreamer&) = delete;
+  ImageSlabStreamer(ImageSlabStreamer&&) noexcept = delete;
+  ImageSlabStreamer& operator=(const ImageSlabStreamer&) = delete;
+  ImageSlabStreamer& operator=(ImageSlabStreamer&&) noexcept = delete;
+
+  /**
+   * @brief Adds an array that is read but not written. Returns the buffer index.
+   * @param store
+   * @return usize
+   */
+  template <typename T>
+  usize addInput(const AbstractDataStore<T>& store)
+  {
+    return addArray<T>(const_cast<AbstractDataStore<T>&>(store), true, false);
+  }
+
+  /**
+   * @brief Adds an array whose slab layers are written back after each slab.
+   * If readValues is true, the buffer is also filled from the array before the
+   * slab is processed. Returns the buffer index.
+   * @param store
+   * @param readValues
+   * @return usize
+   */
+  template <typename T>
+  usize addOutput(AbstractDataStore<T>& store, bool readValues = false)
+  {
+    return addArray<T>(store, readValues, true);
+  }
+
+  /**
+   * @brief Returns the number of Z layers per slab. If no depth was set, the
+   * depth is derived from the large data size preference when any of the arrays
+   * is stored out of core. Otherwise the whole geometry is one slab.
+   * @return usize
+   */
+  usize getSlabDepth() const;
+
+  /**
+   * @brief Sets the number of Z layers per slab. 0 selects the depth automatically.
+   * The depth is never smaller than the halo width.
+   * @param slabDepth
+   */
+  void setSlabDepth(usize slabDepth);
+
+  /**
+   * @brief Runs the function for every slab in increasing Z order.
+   * @param function
+   * @param shouldCancel
+   * @return Result<>
+   */
+  Result<> execute(const SlabFunction& function, const std::atomic_bool& shouldCancel);
+
+private:
+  struct StreamedArray
+  {
+    usize bytesPerTuple = 0;
+    bool read = false;
+    bool write = false;
+    bool inMemory = true;
+    std::function<std::shared_ptr<IDataStore>(usize)> createBuffer;
+    std::function<std::shared_ptr<IDataStore>()> inPlaceBuffer;
+    std::function<bool(IDataStore&, usize, usize)> load;
+    std::function<bool(const IDataStore&, usize, usize, usize)> store;
+  };
+
+  template <typename T>
+  usize addArray(AbstractDataStore<T>& store, bool read, bool write)
+  {
+    StreamedArray array;
+    array.bytesPerTuple = store.getNumberOfComponents() * sizeof(T);
+    array.read = read;
+    array.write = write;
+    array.inMemory = store.getDataFormat().empty();
+    const usize numComponents = store.getNumberOfComponents();
+    array.createBuffer = [numComponents](usize numTuples) { return std::make_shared<DataStore<T>>(IDataStore::ShapeType{numTuples}, IDataStore::ShapeType{numComponents}, std::nullopt); };
+    array.inPlaceBuffer = [&store, inMemory = array.inMemory]() -> std::shared_ptr<IDataStore> {
+      auto* dataStore = dynamic_cast<DataStore<T>*>(&store);
+      if(!inMemory || dataStore == nullptr)
+      {
+        return nullptr;
+      }
+      // Non-owning pointer, the streamer never outlives the arrays it was given
+      return std::shared_ptr<IDataStore>(std::shared_ptr<IDataStore>(), dataStore);
+    };
+    array.load = [&store](IDataStore& buffer, usize tupleOffset, usize numTuples) { return dynamic_cast<DataStore<T>&>(buffer).copyFrom(0, store, tupleOffset, numTuples); };
+    array.store = [&store](const IDataStore& buffer, usize bufferTupleOffset, usize tupleOffset, usize numTuples) {
+      return store.copyFrom(tupleOffset, dynamic_cast<const DataStore<T>&>(buffer), bufferTupleOffset, numTuples);
+    };
+    m_Arrays.push_back(std::move(array));
+    return m_Arrays.size() - 1;
+  }
+
+  bool useArraysInPlace(Slab& slab, const ImageGeom::ZSlab& range) const;
+  Result<> loadSlab(Slab& slab, const ImageGeom::ZSlab& range) const;
+  Result<> storeSlab(const Slab& slab) const;
+
+  SizeVec3 m_Dims;
+  usize m_HaloWidth = 0;
+  usize m_SlabDepth = 0;
+  const ImageGeom& m_ImageGeom;
+  std::vector<StreamedArray> m_Arrays;
+};
+} // namespace complex
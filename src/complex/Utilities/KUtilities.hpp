@@ -1,9 +1,15 @@
 #pragma once
 
 #include "complex/Common/Types.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 #include "complex/complex_export.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
 
 namespace complex::KUtilities
 {
@@ -17,13 +23,26 @@ enum COMPLEX_EXPORT DistanceMetric
   SquaredPearson
 };
 
+enum COMPLEX_EXPORT InitializationMethod
+{
+  Random,
+  KMeansPlusPlus
+};
+
+// Number of tuples per block when the tuples are processed in parallel blocks
+constexpr usize k_BlockSize = 16384;
+// Upper bound on the number of blocks so per block partial results stay small
+constexpr usize k_MaxBlockCount = 256;
+
 /**
- * @brief The DistanceTemplate class contains a templated function getDistance to find the distance, via a variety of
- * metrics, between two vectors of arbitrary dimensions. The developer should ensure that the pointers passed to
- * getDistance do indeed contain vectors of the same component dimensions and start at the desired tuples.
+ * @brief Finds the distance between two vectors of arbitrary dimensions using the metric
+ * selected at compile time. Use this overload in loops over many pairs of vectors so the
+ * metric is not selected for every pair. The developer should ensure that the vectors
+ * passed in contain the same component dimensions and that the offsets point at the
+ * start of the desired tuples.
  */
-template <typename leftDataType, typename rightDataType>
-float64 GetDistance(const leftDataType& leftVector, usize leftOffset, const rightDataType& rightVector, usize rightOffset, usize compDims, DistanceMetric distMetric)
+template <DistanceMetric Metric, typename leftDataType, typename rightDataType>
+float64 GetDistance(const leftDataType& leftVector, usize leftOffset, const rightDataType& rightVector, usize rightOffset, usize compDims)
 {
   float64 dist = 0.0;
   float64 lVal = 0.0;
@@ -31,38 +50,30 @@ float64 GetDistance(const leftDataType& leftVector, usize leftOffset, const righ
 
   float64 epsilon = std::numeric_limits<float64>::min();
 
-  switch(distMetric)
+  if constexpr(Metric == Euclidean || Metric == SquaredEuclidean)
   {
-  case Euclidean: {
     for(usize i = 0; i < compDims; i++)
     {
       lVal = static_cast<float64>(leftVector[i + leftOffset]);
       rVal = static_cast<float64>(rightVector[i + rightOffset]);
       dist += (lVal - rVal) * (lVal - rVal);
     }
-
-    dist = std::sqrt(dist);
-    break;
-  }
-  case SquaredEuclidean: {
-    for(usize i = 0; i < compDims; i++)
+    if constexpr(Metric == Euclidean)
     {
-      lVal = static_cast<float64>(leftVector[i + leftOffset]);
-      rVal = static_cast<float64>(rightVector[i + rightOffset]);
-      dist += (lVal - rVal) * (lVal - rVal);
+      dist = std::sqrt(dist);
     }
-    break;
   }
-  case Manhattan: {
+  else if constexpr(Metric == Manhattan)
+  {
     for(usize i = 0; i < compDims; i++)
     {
       lVal = static_cast<float64>(leftVector[i + leftOffset]);
       rVal = static_cast<float64>(rightVector[i + rightOffset]);
       dist += std::abs(lVal - rVal);
     }
-    break;
   }
-  case Cosine: {
+  else if constexpr(Metric == Cosine)
+  {
     float64 r = 0;
     float64 x = 0;
     float64 y = 0;
@@ -75,9 +86,9 @@ float64 GetDistance(const leftDataType& leftVector, usize leftOffset, const righ
       y += rVal * rVal;
     }
     dist = 1 - (r / (sqrt(x * y) + epsilon));
-    break;
   }
-  case Pearson: {
+  else if constexpr(Metric == Pearson || Metric == SquaredPearson)
+  {
     float64 r = 0;
     float64 x = 0;
     float64 y = 0;
@@ -100,38 +111,233 @@ float64 GetDistance(const leftDataType& leftVector, usize leftOffset, const righ
       x += (lVal - xAvg) * (lVal - xAvg);
       y += (rVal - yAvg) * (rVal - yAvg);
     }
-    dist = 1 - (r / (sqrt(x * y) + epsilon));
-    break;
+    if constexpr(Metric == Pearson)
+    {
+      dist = 1 - (r / (sqrt(x * y) + epsilon));
+    }
+    else
+    {
+      dist = 1 - ((r * r) / ((x * y) + epsilon));
+    }
+  }
+
+  // Return the correct primitive type for distance
+  return dist;
+}
+
+/**
+ * @brief The DistanceTemplate class contains a templated function getDistance to find the distance, via a variety of
+ * metrics, between two vectors of arbitrary dimensions. The developer should ensure that the pointers passed to
+ * getDistance do indeed contain vectors of the same component dimensions and start at the desired tuples.
+ */
+template <typename leftDataType, typename rightDataType>
+float64 GetDistance(const leftDataType& leftVector, usize leftOffset, const rightDataType& rightVector, usize rightOffset, usize compDims, DistanceMetric distMetric)
+{
+  switch(distMetric)
+  {
+  case Euclidean: {
+    return GetDistance<Euclidean>(leftVector, leftOffset, rightVector, rightOffset, compDims);
+  }
+  case SquaredEuclidean: {
+    return GetDistance<SquaredEuclidean>(leftVector, leftOffset, rightVector, rightOffset, compDims);
+  }
+  case Manhattan: {
+    return GetDistance<Manhattan>(leftVector, leftOffset, rightVector, rightOffset, compDims);
+  }
+  case Cosine: {
+    return GetDistance<Cosine>(leftVector, leftOffset, rightVector, rightOffset, compDims);
+  }
+  case Pearson: {
+    return GetDistance<Pearson>(leftVector, leftOffset, rightVector, rightOffset, compDims);
   }
   case SquaredPearson: {
-    float64 r = 0;
-    float64 x = 0;
-    float64 y = 0;
-    float64 xAvg = 0;
-    float64 yAvg = 0;
-    for(usize i = 0; i < compDims; i++)
+    return GetDistance<SquaredPearson>(leftVector, leftOffset, rightVector, rightOffset, compDims);
+  }
+  }
+  return 0.0;
+}
+
+/**
+ * @brief Calls func with a std::integral_constant holding the given metric so kernels
+ * templated on the metric are selected once instead of for every pair of vectors.
+ */
+template <typename FuncT>
+decltype(auto) RunWithDistanceMetric(DistanceMetric distMetric, FuncT&& func)
+{
+  switch(distMetric)
+  {
+  case SquaredEuclidean: {
+    return func(std::integral_constant<DistanceMetric, SquaredEuclidean>{});
+  }
+  case Manhattan: {
+    return func(std::integral_constant<DistanceMetric, Manhattan>{});
+  }
+  case Cosine: {
+    return func(std::integral_constant<DistanceMetric, Cosine>{});
+  }
+  case Pearson: {
+    return func(std::integral_constant<DistanceMetric, Pearson>{});
+  }
+  case SquaredPearson: {
+    return func(std::integral_constant<DistanceMetric, SquaredPearson>{});
+  }
+  case Euclidean:
+  default: {
+    return func(std::integral_constant<DistanceMetric, Euclidean>{});
+  }
+  }
+}
+
+/**
+ * @brief Returns the number of tuples in each block when numTuples tuples are split
+ * into at most k_MaxBlockCount parallel blocks.
+ */
+inline usize GetBlockSize(usize numTuples)
+{
+  return std::max(k_BlockSize, (numTuples + k_MaxBlockCount - 1) / k_MaxBlockCount);
+}
+
+/**
+ * @brief Finds the closest of the cluster centers 1 to numClusters to a point. Centers
+ * holds numClusters + 1 tuples where tuple 0 is unused. Returns 0 if no distance is
+ * less than the largest float64. Ties go to the lowest cluster id.
+ * @param point
+ * @param centers
+ * @param numClusters
+ * @param compDims
+ * @param minDist Distance to the closest center
+ * @param secondDist Distance to the second closest center
+ * @return int32
+ */
+template <DistanceMetric Metric, typename PointT, typename CenterT>
+int32 FindClosestCenter(const PointT* point, const CenterT* centers, usize numClusters, usize compDims, float64& minDist, float64& secondDist)
+{
+  int32 closest = 0;
+  minDist = std::numeric_limits<float64>::max();
+  secondDist = std::numeric_limits<float64>::max();
+  for(usize j = 1; j <= numClusters; j++)
+  {
+    const float64 dist = GetDistance<Metric>(point, 0, centers, compDims * j, compDims);
+    if(dist < minDist)
     {
-      lVal = static_cast<float64>(leftVector[i + leftOffset]);
-      rVal = static_cast<float64>(rightVector[i + rightOffset]);
-      xAvg += lVal;
-      yAvg += rVal;
+      secondDist = minDist;
+      minDist = dist;
+      closest = static_cast<int32>(j);
     }
-    xAvg /= static_cast<float64>(compDims);
-    yAvg /= static_cast<float64>(compDims);
-    for(usize i = 0; i < compDims; i++)
+    else if(dist < secondDist)
     {
-      lVal = static_cast<float64>(leftVector[i + leftOffset]);
-      rVal = static_cast<float64>(rightVector[i + rightOffset]);
-      r += (lVal - xAvg) * (rVal - yAvg);
-      x += (lVal - xAvg) * (lVal - xAvg);
-      y += (rVal - yAvg) * (rVal - yAvg);
+      secondDist = dist;
     }
-    dist = 1 - ((r * r) / ((x * y) + epsilon));
-    break;
   }
+  return closest;
+}
+
+/**
+ * @brief Chooses numClusters tuples where mask is true as initial cluster centers using
+ * k-means++: the first tuple is drawn uniformly and every further tuple is drawn with a
+ * probability proportional to its squared distance to the closest tuple already chosen.
+ * The distances are updated in parallel blocks and summed in block order, so the same
+ * generator state always selects the same tuples.
+ * @param values
+ * @param mask
+ * @param numTuples
+ * @param compDims
+ * @param numClusters
+ * @param generator
+ * @return std::vector<usize> Indices of the chosen tuples
+ */
+template <DistanceMetric Metric, typename T>
+std::vector<usize> SelectKMeansPlusPlusSeeds(const T* values, const bool* mask, usize numTuples, usize compDims, usize numClusters, std::mt19937_64& generator)
+{
+  std::vector<usize> seeds;
+  const usize numMasked = static_cast<usize>(std::count(mask, mask + numTuples, true));
+  if(numMasked == 0 || numClusters == 0)
+  {
+    return seeds;
   }
 
-  // Return the correct primitive type for distance
-  return dist;
+  const auto selectMasked = [mask, numTuples](usize maskedIndex) {
+    for(usize i = 0; i < numTuples; i++)
+    {
+      if(mask[i] && maskedIndex-- == 0)
+      {
+        return i;
+      }
+    }
+    return numTuples - 1;
+  };
+  std::uniform_int_distribution<usize> uniform(0, numMasked - 1);
+  seeds.push_back(selectMasked(uniform(generator)));
+
+  const usize blockSize = GetBlockSize(numTuples);
+  const usize numBlocks = (numTuples + blockSize - 1) / blockSize;
+  std::vector<float64> weights(numTuples, std::numeric_limits<float64>::max());
+  std::vector<float64> blockWeights(numBlocks, 0.0);
+
+  while(seeds.size() < numClusters)
+  {
+    const T* seedValues = values + compDims * seeds.back();
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numBlocks);
+    dataAlg.execute([&](const Range& range) {
+      for(usize block = range.min(); block < range.max(); block++)
+      {
+        float64 blockWeight = 0.0;
+        const usize end = std::min(numTuples, (block + 1) * blockSize);
+        for(usize i = block * blockSize; i < end; i++)
+        {
+          if(!mask[i])
+          {
+            continue;
+          }
+          float64 weight = std::max(GetDistance<Metric>(values, compDims * i, seedValues, 0, compDims), 0.0);
+          if constexpr(Metric != SquaredEuclidean && Metric != SquaredPearson)
+          {
+            weight *= weight;
+          }
+          weights[i] = std::min(weights[i], weight);
+          blockWeight += weights[i];
+        }
+        blockWeights[block] = blockWeight;
+      }
+    });
+
+    float64 totalWeight = 0.0;
+    for(float64 blockWeight : blockWeights)
+    {
+      totalWeight += blockWeight;
+    }
+    if(!(totalWeight > 0.0) || !std::isfinite(totalWeight))
+    {
+      // Every remaining tuple coincides with a chosen center
+      seeds.push_back(selectMasked(uniform(generator)));
+      continue;
+    }
+
+    float64 target = std::uniform_real_distribution<float64>(0.0, totalWeight)(generator);
+    usize block = 0;
+    while(block + 1 < numBlocks && target >= blockWeights[block])
+    {
+      target -= blockWeights[block];
+      block++;
+    }
+    usize selected = numTuples;
+    const usize end = std::min(numTuples, (block + 1) * blockSize);
+    for(usize i = block * blockSize; i < end; i++)
+    {
+      if(!mask[i] || weights[i] <= 0.0)
+      {
+        continue;
+      }
+      selected = i;
+      if(target < weights[i])
+      {
+        break;
+      }
+      target -= weights[i];
+    }
+    seeds.push_back(selected < numTuples ? selected : seeds.back());
+  }
+  return seeds;
 }
 } // namespace complex::KUtilities
@@ -8,10 +8,13 @@
 #include "complex/Common/Types.hpp"
 #include "complex/DataStructure/Geometry/INodeGeometry0D.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
+#include "complex/Utilities/TriangleBVH.hpp"
 #include "complex/complex_export.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <functional>
+#include <limits>
 #include <random>
 #include <stdexcept>
 #include <vector>
@@ -245,6 +248,55 @@ bool DoesRayIntersectBox(complex::Ray<T> ray, const complex::BoundingBox3D<T>& b
   return true;
 }
 
+/**
+ * @brief Returns true if the segment between origin and end passes through the
+ * box. Unlike DoesRayIntersectBox, which only compares the bounds of the
+ * segment with the box, this is an exact slab test. The box is padded slightly
+ * so that segments grazing the box are never rejected due to rounding.
+ * @param origin
+ * @param end
+ * @param bounds
+ * @return bool
+ */
+template <typename T>
+bool DoesSegmentIntersectBox(const complex::Point3D<T>& origin, const complex::Point3D<T>& end, const complex::BoundingBox3D<T>& bounds)
+{
+  constexpr T k_RelativePadding = static_cast<T>(1.0E-5);
+  const auto& min = bounds.getMinPoint();
+  const auto& max = bounds.getMaxPoint();
+
+  T tMin = 0;
+  T tMax = 1;
+  for(usize axis = 0; axis < 3; axis++)
+  {
+    const T padding = k_RelativePadding * (std::abs(min[axis]) + std::abs(max[axis]) + (max[axis] - min[axis])) + std::numeric_limits<T>::min();
+    const T lower = min[axis] - padding;
+    const T upper = max[axis] + padding;
+    const T direction = end[axis] - origin[axis];
+    if(direction == 0)
+    {
+      if(origin[axis] < lower || origin[axis] > upper)
+      {
+        return false;
+      }
+      continue;
+    }
+    T t0 = (lower - origin[axis]) / direction;
+    T t1 = (upper - origin[axis]) / direction;
+    if(t0 > t1)
+    {
+      std::swap(t0, t1);
+    }
+    tMin = std::max(tMin, t0);
+    tMax = std::min(tMax, t1);
+    if(tMin > tMax)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 /**
  * @brief Returns true if a point is within the triangle defined by three
  * specified points. Returns false otherwise. This function operates in 3D
@@ -612,5 +664,103 @@ char IsPointInPolyhedron(const complex::TriangleGeom& faces, const std::vector<i
 
   return 'o';
 }
+
+/**
+ * @brief Determines if a point is in the polyhedron formed by the faces in the
+ * TriangleBVH. Returns the same codes as the face list version, but each ray
+ * only visits the faces whose BVH nodes it passes through. Rays are generated
+ * with the supplied generator so callers can reuse one generator per thread.
+ * @param faces the geometry to query
+ * @param bvh hierarchy over the faces of the polyhedron
+ * @param faceBBs the bounding boxes of each face in the geometry
+ * @param point search point
+ * @param bounds overarching bounding box for all of the geometry
+ * @param radius length of ray
+ * @param generator random number engine used to pick ray directions
+ * @return char
+ */
+template <typename T>
+char IsPointInPolyhedron(const complex::TriangleGeom& faces, const TriangleBVH& bvh, const std::vector<BoundingBox3D<T>>& faceBBs, const Point3D<T>& point, const complex::BoundingBox3D<T>& bounds,
+                         T radius, std::mt19937_64& generator)
+{
+  if(!IsPointInBox(point, bounds))
+  {
+    return 'o';
+  }
+
+  std::uniform_real_distribution<T> distribution(0.0, 1.0);
+
+  usize crossings = 0;
+  usize iter = 0;
+  const usize numFaces = bvh.getFaceIds().size();
+  while(iter++ < numFaces)
+  {
+    crossings = 0;
+
+    std::array<T, 3> eulerAngles;
+    float rand1 = distribution(generator);
+    float rand2 = distribution(generator);
+
+    eulerAngles[2] = (2.0f * rand1) - 1.0f;
+    float t = Constants::k_2PiF * rand2;
+    float w = std::sqrt(1.0f - (eulerAngles[2] * eulerAngles[2]));
+    eulerAngles[0] = w * std::cos(t);
+    eulerAngles[1] = w * std::sin(t);
+
+    Ray<T> ray(point, ZXZEuler(eulerAngles.data()), radius);
+    const Point3D<T> endPoint = ray.getEndPoint();
+
+    char result = '?';
+    bool degenerate = false;
+    bvh.visit([&point, &endPoint](const BoundingBox3D<T>& nodeBounds) { return DoesSegmentIntersectBox(point, endPoint, nodeBounds); },
+              [&](int32 faceId) {
+                if(!DoesRayIntersectBox(ray, faceBBs[faceId]))
+                {
+                  return true;
+                }
+                std::array<Point3D<T>, 3> coords;
+                faces.getFaceCoordinates(faceId, coords);
+                const char code = RayIntersectsTriangle(ray, coords[0], coords[1], coords[2]);
+
+                /* If ray is degenerate, then generate another. */
+                if(code == 'p' || code == 'v' || code == 'e' || code == '?')
+                {
+                  degenerate = true;
+                  return false;
+                }
+                /* If ray hits face at interior point, increment crossings. */
+                if(code == 'f')
+                {
+                  crossings++;
+                }
+                /* If query endpoint q sits on a V/E/F, return that code. */
+                else if(code == 'V' || code == 'E' || code == 'F')
+                {
+                  result = code;
+                  return false;
+                }
+                return true;
+              });
+
+    if(result != '?')
+    {
+      return result;
+    }
+    if(degenerate)
+    {
+      continue;
+    }
+    /* No degeneracies encountered: ray is generic, so finished. */
+    break;
+  }
+
+  /* q strictly interior to polyhedron if an odd number of crossings. */
+  if((crossings % 2) == 1)
+  {
+    return 'i';
+  }
+
+  return 'o';
+}
 } // namespace GeometryMath
 } // namespace complex
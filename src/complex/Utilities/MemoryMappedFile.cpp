@@ -0,0 +1,312 @@
+#include "MemoryMappedFile.hpp"
+
+#if defined(_WIN32)
+#include <windows.h>
+
+#include <array>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+#endif
+
+namespace complex
+{
+MemoryMappedFile::MemoryMappedFile(std::filesystem::path filePath, Mode mode)
+: m_FilePath(std::move(filePath))
+, m_Mode(mode)
+{
+}
+
+const std::filesystem::path& MemoryMappedFile::getFilePath() const
+{
+  return m_FilePath;
+}
+
+MemoryMappedFile::Mode MemoryMappedFile::getMode() const
+{
+  return m_Mode;
+}
+
+uint64 MemoryMappedFile::size() const
+{
+  return m_Size;
+}
+
+uint8* MemoryMappedFile::data()
+{
+  return m_Data;
+}
+
+const uint8* MemoryMappedFile::data() const
+{
+  return m_Data;
+}
+
+#if defined(_WIN32)
+// -----------------------------------------------------------------------------
+std::unique_ptr<MemoryMappedFile> MemoryMappedFile::CreateTemporary(const std::filesystem::path& directory, uint64 numBytes)
+{
+  std::array<wchar_t, MAX_PATH + 1> buffer = {};
+  if(GetTempFileNameW(directory.wstring().c_str(), L"cmx", 0, buffer.data()) == 0)
+  {
+    return nullptr;
+  }
+
+  HANDLE fileHandle = CreateFileW(buffer.data(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+  if(fileHandle == INVALID_HANDLE_VALUE)
+  {
+    DeleteFileW(buffer.data());
+    return nullptr;
+  }
+
+  std::unique_ptr<MemoryMappedFile> mappedFile(new MemoryMappedFile(std::filesystem::path(buffer.data()), Mode::ReadWrite));
+  mappedFile->m_FileHandle = fileHandle;
+  if(!mappedFile->resize(numBytes))
+  {
+    return nullptr;
+  }
+  return mappedFile;
+}
+
+// -----------------------------------------------------------------------------
+std::unique_ptr<MemoryMappedFile> MemoryMappedFile::Open(const std::filesystem::path& filePath, Mode mode)
+{
+  const DWORD access = (mode == Mode::ReadWrite) ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ;
+  HANDLE fileHandle = CreateFileW(filePath.wstring().c_str(), access, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(fileHandle == INVALID_HANDLE_VALUE)
+  {
+    return nullptr;
+  }
+
+  std::unique_ptr<MemoryMappedFile> mappedFile(new MemoryMappedFile(filePath, mode));
+  mappedFile->m_FileHandle = fileHandle;
+
+  LARGE_INTEGER fileSize = {};
+  if(GetFileSizeEx(fileHandle, &fileSize) == 0 || !mappedFile->map(static_cast<uint64>(fileSize.QuadPart)))
+  {
+    return nullptr;
+  }
+  return mappedFile;
+}
+
+// -----------------------------------------------------------------------------
+MemoryMappedFile::~MemoryMappedFile() noexcept
+{
+  unmap();
+  if(m_FileHandle != nullptr)
+  {
+    CloseHandle(m_FileHandle);
+    m_FileHandle = nullptr;
+  }
+}
+
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::map(uint64 numBytes)
+{
+  m_Size = numBytes;
+  if(numBytes == 0)
+  {
+    return true;
+  }
+
+  LARGE_INTEGER mappingSize = {};
+  mappingSize.QuadPart = static_cast<LONGLONG>(numBytes);
+  const DWORD protection = (m_Mode == Mode::ReadWrite) ? PAGE_READWRITE : PAGE_READONLY;
+  m_MappingHandle = CreateFileMappingW(m_FileHandle, nullptr, protection, static_cast<DWORD>(mappingSize.HighPart), mappingSize.LowPart, nullptr);
+  if(m_MappingHandle == nullptr)
+  {
+    m_Size = 0;
+    return false;
+  }
+
+  const DWORD viewAccess = (m_Mode == Mode::ReadWrite) ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ;
+  m_Data = static_cast<uint8*>(MapViewOfFile(m_MappingHandle, viewAccess, 0, 0, static_cast<SIZE_T>(numBytes)));
+  if(m_Data == nullptr)
+  {
+    unmap();
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+void MemoryMappedFile::unmap()
+{
+  if(m_Data != nullptr)
+  {
+    UnmapViewOfFile(m_Data);
+    m_Data = nullptr;
+  }
+  if(m_MappingHandle != nullptr)
+  {
+    CloseHandle(m_MappingHandle);
+    m_MappingHandle = nullptr;
+  }
+  m_Size = 0;
+}
+
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::resize(uint64 numBytes)
+{
+  if(m_Mode != Mode::ReadWrite || m_FileHandle == nullptr)
+  {
+    return false;
+  }
+
+  const uint64 oldSize = m_Size;
+  unmap();
+  LARGE_INTEGER newSize = {};
+  newSize.QuadPart = static_cast<LONGLONG>(numBytes);
+  if(SetFilePointerEx(m_FileHandle, newSize, nullptr, FILE_BEGIN) != 0 && SetEndOfFile(m_FileHandle) != 0 && map(numBytes))
+  {
+    return true;
+  }
+
+  // Put the previous size and view back so the existing bytes stay reachable
+  LARGE_INTEGER restoredSize = {};
+  restoredSize.QuadPart = static_cast<LONGLONG>(oldSize);
+  if(SetFilePointerEx(m_FileHandle, restoredSize, nullptr, FILE_BEGIN) != 0 && SetEndOfFile(m_FileHandle) != 0)
+  {
+    map(oldSize);
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::flush() const
+{
+  if(m_Data == nullptr || m_Mode != Mode::ReadWrite)
+  {
+    return true;
+  }
+  return FlushViewOfFile(m_Data, 0) != 0;
+}
+#else
+// -----------------------------------------------------------------------------
+std::unique_ptr<MemoryMappedFile> MemoryMappedFile::CreateTemporary(const std::filesystem::path& directory, uint64 numBytes)
+{
+  std::string pathTemplate = (directory / "complex_mmap_XXXXXX").string();
+  std::vector<char> buffer(pathTemplate.begin(), pathTemplate.end());
+  buffer.push_back('\0');
+
+  int32 fileDescriptor = mkstemp(buffer.data());
+  if(fileDescriptor < 0)
+  {
+    return nullptr;
+  }
+  // Removing the directory entry right away guarantees the backing storage is
+  // released when the descriptor is closed, even if the process crashes.
+  unlink(buffer.data());
+
+  std::unique_ptr<MemoryMappedFile> mappedFile(new MemoryMappedFile(std::filesystem::path(buffer.data()), Mode::ReadWrite));
+  mappedFile->m_FileDescriptor = fileDescriptor;
+  if(!mappedFile->resize(numBytes))
+  {
+    return nullptr;
+  }
+  return mappedFile;
+}
+
+// -----------------------------------------------------------------------------
+std::unique_ptr<MemoryMappedFile> MemoryMappedFile::Open(const std::filesystem::path& filePath, Mode mode)
+{
+  const int32 flags = (mode == Mode::ReadWrite) ? O_RDWR : O_RDONLY;
+  int32 fileDescriptor = open(filePath.c_str(), flags);
+  if(fileDescriptor < 0)
+  {
+    return nullptr;
+  }
+
+  std::unique_ptr<MemoryMappedFile> mappedFile(new MemoryMappedFile(filePath, mode));
+  mappedFile->m_FileDescriptor = fileDescriptor;
+
+  struct stat fileStats = {};
+  if(fstat(fileDescriptor, &fileStats) != 0 || !mappedFile->map(static_cast<uint64>(fileStats.st_size)))
+  {
+    return nullptr;
+  }
+  return mappedFile;
+}
+
+// -----------------------------------------------------------------------------
+MemoryMappedFile::~MemoryMappedFile() noexcept
+{
+  unmap();
+  if(m_FileDescriptor >= 0)
+  {
+    close(m_FileDescriptor);
+    m_FileDescriptor = -1;
+  }
+}
+
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::map(uint64 numBytes)
+{
+  m_Size = numBytes;
+  if(numBytes == 0)
+  {
+    return true;
+  }
+
+  const int32 protection = (m_Mode == Mode::ReadWrite) ? (PROT_READ | PROT_WRITE) : PROT_READ;
+  void* region = mmap(nullptr, static_cast<size_t>(numBytes), protection, MAP_SHARED, m_FileDescriptor, 0);
+  if(region == MAP_FAILED)
+  {
+    m_Size = 0;
+    return false;
+  }
+  m_Data = static_cast<uint8*>(region);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+void MemoryMappedFile::unmap()
+{
+  if(m_Data != nullptr)
+  {
+    munmap(m_Data, static_cast<size_t>(m_Size));
+    m_Data = nullptr;
+  }
+  m_Size = 0;
+}
+
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::resize(uint64 numBytes)
+{
+  if(m_Mode != Mode::ReadWrite || m_FileDescriptor < 0)
+  {
+    return false;
+  }
+
+  const uint64 oldSize = m_Size;
+  unmap();
+  if(ftruncate(m_FileDescriptor, static_cast<off_t>(numBytes)) == 0 && map(numBytes))
+  {
+    return true;
+  }
+
+  // Put the previous size and view back so the existing bytes stay reachable
+  if(ftruncate(m_FileDescriptor, static_cast<off_t>(oldSize)) == 0)
+  {
+    map(oldSize);
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+bool MemoryMappedFile::flush() const
+{
+  if(m_Data == nullptr || m_Mode != Mode::ReadWrite)
+  {
+    return true;
+  }
+  return msync(m_Data, static_cast<size_t>(m_Size), MS_ASYNC) == 0;
+}
+#endif
+} // namespace complex
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "complex/Common/Types.hpp"
+#include "complex/complex_export.hpp"
+
+#include <filesystem>
+#include <memory>
+
+namespace complex
+{
+/**
+ * @class MemoryMappedFile
+ * @brief The MemoryMappedFile class maps a file on disk into the address space
+ * of the process. Pages are loaded and evicted by the operating system as they
+ * are accessed, so the mapped size is not limited by the available RAM.
+ *
+ * Instances are created through the CreateTemporary() and Open() factory
+ * methods which return nullptr if the file could not be created or mapped.
+ */
+class COMPLEX_EXPORT MemoryMappedFile
+{
+public:
+  enum class Mode : uint8
+  {
+    ReadOnly = 0,
+    ReadWrite
+  };
+
+  /**
+   * @brief Creates a new zero filled temporary file of the specified size inside
+   * the target directory and maps it as read/write. The file is removed from
+   * disk when the MemoryMappedFile is destroyed or the process exits.
+   * Returns nullptr if the file could not be created or mapped.
+   * @param directory
+   * @param numBytes
+   * @return std::unique_ptr<MemoryMappedFile>
+   */
+  static std::unique_ptr<MemoryMappedFile> CreateTemporary(const std::filesystem::path& directory, uint64 numBytes);
+
+  /**
+   * @brief Maps an existing file using the specified access mode.
+   * Returns nullptr if the file does not exist or could not be mapped.
+   * @param filePath
+   * @param mode
+   * @return std::unique_ptr<MemoryMappedFile>
+   */
+  static std::unique_ptr<MemoryMappedFile> Open(const std::filesystem::path& filePath, Mode mode = Mode::ReadOnly);
+
+  ~MemoryMappedFile() noexcept;
+
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  MemoryMappedFile(MemoryMappedFile&&) noexcept = delete;
+  MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+  MemoryMappedFile& operator=(MemoryMappedFile&&) noexcept = delete;
+
+  /**
+   * @brief Returns the path of the mapped file. Temporary files may no longer
+   * have a visible directory entry.
+   * @return const std::filesystem::path&
+   */
+  const std::filesystem::path& getFilePath() const;
+
+  /**
+   * @brief Returns the access mode the file was mapped with.
+   * @return Mode
+   */
+  Mode getMode() const;
+
+  /**
+   * @brief Returns the number of mapped bytes.
+   * @return uint64
+   */
+  uint64 size() const;
+
+  /**
+   * @brief Returns a pointer to the start of the mapped region. Returns nullptr
+   * if the mapped size is 0.
+   * @return uint8*
+   */
+  uint8* data();
+
+  /**
+   * @brief Returns a pointer to the start of the mapped region. Returns nullptr
+   * if the mapped size is 0.
+   * @return const uint8*
+   */
+  const uint8* data() const;
+
+  /**
+   * @brief Changes the size of the backing file and remaps it. Existing bytes
+   * are preserved up to the new size and any new bytes are zero filled.
+   * Pointers previously returned by data() are invalidated.
+   * Returns false if the file is read-only or could not be resized, in which
+   * case the previous size and mapping are restored when possible.
+   * @param numBytes
+   * @return bool
+   */
+  bool resize(uint64 numBytes);
+
+  /**
+   * @brief Schedules all modified pages to be written back to the backing file.
+   * Returns false if the operating system reported an error.
+   * @return bool
+   */
+  bool flush() const;
+
+protected:
+  MemoryMappedFile(std::filesystem::path filePath, Mode mode);
+
+  /**
+   * @brief Maps the first numBytes of the open file. Returns false on failure.
+   * @param numBytes
+   * @return bool
+   */
+  bool map(uint64 numBytes);
+
+  /**
+   * @brief Unmaps the current view without closing the file.
+   */
+  void unmap();
+
+private:
+  std::filesystem::path m_FilePath;
+  Mode m_Mode = Mode::ReadOnly;
+  uint8* m_Data = nullptr;
+  uint64 m_Size = 0;
+#if defined(_WIN32)
+  void* m_FileHandle = nullptr;
+  void* m_MappingHandle = nullptr;
+#else
+  int32 m_FileDescriptor = -1;
+#endif
+};
+} // namespace complex
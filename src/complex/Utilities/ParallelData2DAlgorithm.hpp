@@ -11,6 +11,7 @@
 #include <tbb/partitioner.h>
 #endif
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <optional>
@@ -77,39 +78,60 @@ public:
   template <typename Body>
   void execute(const Body& body)
   {
-    // Check if pre-existing chunk sizes should be preserved
-    if(m_ChunkSize.has_value() == false)
+    // Prefer an explicit chunk size, then the chunk shape of the required arrays
+    std::optional<RangeType> chunkSize = m_ChunkSize;
+    const auto& chunkShape = getChunkShape();
+    if(!chunkSize.has_value() && chunkShape.size() == 2)
     {
-      executeRange<Body>(body, m_Range);
+      chunkSize = RangeType(0, chunkShape[1], 0, chunkShape[0]);
     }
-    else
+
+    if(!chunkSize.has_value())
     {
-      // Execute over pre-existing chunks
+      executeRange<Body>(body, m_Range);
+      return;
+    }
 
-      // Get chunk size
-      const usize chunkWidth = m_ChunkSize->maxCol() - m_ChunkSize->minCol();
-      const usize chunkHeight = m_ChunkSize->maxRow() - m_ChunkSize->minRow();
+    // Execute over whole chunks. Each worker receives a set of chunks and
+    // processes every chunk in a single call.
+    const usize chunkWidth = std::max<usize>(chunkSize->maxCol() - chunkSize->minCol(), 1);
+    const usize chunkHeight = std::max<usize>(chunkSize->maxRow() - chunkSize->minRow(), 1);
+    if(m_Range.minCol() >= m_Range.maxCol() || m_Range.minRow() >= m_Range.maxRow())
+    {
+      return;
+    }
 
-      // Check which chunks to operate over
-      const usize minChunkCol = m_Range.minCol() / chunkWidth;
-      const usize maxChunkCol = m_Range.maxCol() / chunkWidth;
-      const usize minChunkRow = m_Range.minRow() / chunkHeight;
-      const usize maxChunkRow = m_Range.maxRow() / chunkHeight;
+    const usize minChunkCol = m_Range.minCol() / chunkWidth;
+    const usize maxChunkCol = (m_Range.maxCol() + chunkWidth - 1) / chunkWidth;
+    const usize minChunkRow = m_Range.minRow() / chunkHeight;
+    const usize maxChunkRow = (m_Range.maxRow() + chunkHeight - 1) / chunkHeight;
 
-      for(usize chunkX = minChunkCol; chunkX <= maxChunkCol; chunkX++)
+    auto executeChunks = [&](usize minRow, usize maxRow, usize minCol, usize maxCol) {
+      for(usize chunkY = minRow; chunkY < maxRow; chunkY++)
       {
-        const usize minX = std::max(m_Range.minCol(), (chunkX - 1) * m_ChunkSize->maxCol());
-        const usize maxX = std::min(m_Range.maxCol(), chunkX * m_ChunkSize->maxCol());
-
-        for(usize chunkY = minChunkRow; chunkY <= maxChunkRow; chunkY++)
+        for(usize chunkX = minCol; chunkX < maxCol; chunkX++)
         {
-          const usize minY = std::max(m_Range.minRow(), (chunkY - 1) * m_ChunkSize->maxRow());
-          const usize maxY = std::min(m_Range.maxRow(), chunkY * m_ChunkSize->maxRow());
-
-          const RangeType chunkRange(minX, maxX, minY, maxY);
-          executeRange<Body>(body, chunkRange);
+          const RangeType chunkRange(std::max(m_Range.minCol(), chunkX * chunkWidth), std::min(m_Range.maxCol(), (chunkX + 1) * chunkWidth), std::max(m_Range.minRow(), chunkY * chunkHeight),
+                                     std::min(m_Range.maxRow(), (chunkY + 1) * chunkHeight));
+          body(chunkRange);
         }
       }
+    };
+
+#ifdef COMPLEX_ENABLE_MULTICORE
+    if(getParallelizationEnabled())
+    {
+      tbb::auto_partitioner partitioner;
+      tbb::blocked_range2d<size_t, size_t> tbbRange(minChunkRow, maxChunkRow, minChunkCol, maxChunkCol);
+      tbb::parallel_for(
+          tbbRange,
+          [&executeChunks](const tbb::blocked_range2d<size_t, size_t>& chunks) { executeChunks(chunks.rows().begin(), chunks.rows().end(), chunks.cols().begin(), chunks.cols().end()); },
+          partitioner);
+    }
+    else
+#endif
+    {
+      executeChunks(minChunkRow, maxChunkRow, minChunkCol, maxChunkCol);
     }
   }
 
@@ -11,6 +11,7 @@
 #include <tbb/partitioner.h>
 #endif
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <optional>
@@ -73,52 +74,72 @@ public:
   template <typename Body>
   void execute(const Body& body)
   {
-    // Check if pre-existing chunk sizes should be preserved
-    if(m_ChunkSize.has_value() == false)
+    // Prefer an explicit chunk size, then the chunk shape of the required arrays
+    std::optional<RangeType> chunkSize = m_ChunkSize;
+    const auto& chunkShape = getChunkShape();
+    if(!chunkSize.has_value() && chunkShape.size() == 3)
+    {
+      chunkSize = RangeType(chunkShape[2], chunkShape[1], chunkShape[0]);
+    }
+
+    if(!chunkSize.has_value())
     {
       executeRange<Body>(body, m_Range);
+      return;
     }
-    else
+
+    // Execute over whole chunks. Each worker receives a set of chunks and
+    // processes every chunk in a single call.
+    const usize chunkWidth = std::max<usize>(chunkSize->getXRange()[1] - chunkSize->getXRange()[0], 1);
+    const usize chunkHeight = std::max<usize>(chunkSize->getYRange()[1] - chunkSize->getYRange()[0], 1);
+    const usize chunkDepth = std::max<usize>(chunkSize->getZRange()[1] - chunkSize->getZRange()[0], 1);
+
+    const auto rangeX = m_Range.getXRange();
+    const auto rangeY = m_Range.getYRange();
+    const auto rangeZ = m_Range.getZRange();
+    if(rangeX[0] >= rangeX[1] || rangeY[0] >= rangeY[1] || rangeZ[0] >= rangeZ[1])
     {
-      // Execute over pre-existing chunks
-
-      // Get chunk size
-      const usize chunkWidth = m_ChunkSize->getXRange()[1];
-      const usize chunkHeight = m_ChunkSize->getYRange()[1];
-      const usize chunkDepth = m_ChunkSize->getZRange()[1];
-
-      // Check which chunks to operate over
-      const auto rangeX = m_Range.getXRange();
-      const auto rangeY = m_Range.getYRange();
-      const auto rangeZ = m_Range.getZRange();
-
-      const usize minChunkCol = m_Range.getXRange()[0] / chunkWidth;
-      const usize maxChunkCol = m_Range.getXRange()[1] / chunkWidth;
-      const usize minChunkRow = m_Range.getYRange()[0] / chunkHeight;
-      const usize maxChunkRow = m_Range.getYRange()[1] / chunkHeight;
-      const usize minChunkDepth = m_Range.getZRange()[0] / chunkDepth;
-      const usize maxChunkDepth = m_Range.getZRange()[1] / chunkDepth;
-
-      for(usize chunkX = minChunkCol; chunkX <= maxChunkCol; chunkX++)
-      {
-        const usize minX = std::max(rangeX[0], (chunkX - 1) * chunkWidth);
-        const usize maxX = std::min(rangeX[1], chunkX * chunkWidth);
+      return;
+    }
 
-        for(usize chunkY = minChunkRow; chunkY <= maxChunkRow; chunkY++)
-        {
-          const usize minY = std::max(rangeY[0], (chunkY - 1) * chunkHeight);
-          const usize maxY = std::min(rangeY[1], chunkY * chunkHeight);
+    const usize minChunkCol = rangeX[0] / chunkWidth;
+    const usize maxChunkCol = (rangeX[1] + chunkWidth - 1) / chunkWidth;
+    const usize minChunkRow = rangeY[0] / chunkHeight;
+    const usize maxChunkRow = (rangeY[1] + chunkHeight - 1) / chunkHeight;
+    const usize minChunkDepth = rangeZ[0] / chunkDepth;
+    const usize maxChunkDepth = (rangeZ[1] + chunkDepth - 1) / chunkDepth;
 
-          for(usize chunkZ = minChunkDepth; chunkZ <= maxChunkDepth; chunkZ++)
+    auto executeChunks = [&](usize minZ, usize maxZ, usize minY, usize maxY, usize minX, usize maxX) {
+      for(usize chunkZ = minZ; chunkZ < maxZ; chunkZ++)
+      {
+        for(usize chunkY = minY; chunkY < maxY; chunkY++)
+        {
+          for(usize chunkX = minX; chunkX < maxX; chunkX++)
           {
-            const usize minZ = std::max(rangeZ[0], (chunkZ - 1) * chunkDepth);
-            const usize maxZ = std::min(rangeZ[1], chunkZ * chunkDepth);
-
-            const RangeType chunkRange(minX, maxX, minY, maxY, minZ, maxZ);
-            executeRange<Body>(body, chunkRange);
+            const RangeType chunkRange(std::max(rangeX[0], chunkX * chunkWidth), std::min(rangeX[1], (chunkX + 1) * chunkWidth), std::max(rangeY[0], chunkY * chunkHeight),
+                                       std::min(rangeY[1], (chunkY + 1) * chunkHeight), std::max(rangeZ[0], chunkZ * chunkDepth), std::min(rangeZ[1], (chunkZ + 1) * chunkDepth));
+            body(chunkRange);
           }
         }
       }
+    };
+
+#ifdef COMPLEX_ENABLE_MULTICORE
+    if(getParallelizationEnabled())
+    {
+      tbb::auto_partitioner partitioner;
+      tbb::blocked_range3d<size_t, size_t, size_t> tbbRange(minChunkDepth, maxChunkDepth, minChunkRow, maxChunkRow, minChunkCol, maxChunkCol);
+      tbb::parallel_for(
+          tbbRange,
+          [&executeChunks](const tbb::blocked_range3d<size_t, size_t, size_t>& chunks) {
+            executeChunks(chunks.pages().begin(), chunks.pages().end(), chunks.rows().begin(), chunks.rows().end(), chunks.cols().begin(), chunks.cols().end());
+          },
+          partitioner);
+    }
+    else
+#endif
+    {
+      executeChunks(minChunkDepth, maxChunkDepth, minChunkRow, maxChunkRow, minChunkCol, maxChunkCol);
     }
   }
 
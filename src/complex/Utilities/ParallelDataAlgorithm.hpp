@@ -10,6 +10,7 @@
 #include <tbb/partitioner.h>
 #endif
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 
@@ -55,6 +56,8 @@ public:
 
   /**
    * @brief Runs the data algorithm.  Parallelization is used if appropriate.
+   * If the arrays passed to requireArraysInMemory are chunked, the range is
+   * treated as tuple indices and split on chunk boundaries.
    * @param body
    */
   template <typename Body>
@@ -64,6 +67,20 @@ public:
     if(getParallelizationEnabled())
     {
       tbb::auto_partitioner partitioner;
+      const usize chunkTuples = getChunkTupleCount();
+      if(chunkTuples > 0 && chunkTuples < m_Range.size())
+      {
+        // Partition along chunk boundaries so that each worker owns whole chunks
+        const usize minChunk = m_Range.min() / chunkTuples;
+        const usize maxChunk = (m_Range.max() + chunkTuples - 1) / chunkTuples;
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(minChunk, maxChunk),
+            [this, chunkTuples, &body](const tbb::blocked_range<size_t>& chunks) {
+              body(Range(std::max(m_Range.min(), chunks.begin() * chunkTuples), std::min(m_Range.max(), chunks.end() * chunkTuples)));
+            },
+            partitioner);
+        return;
+      }
       tbb::blocked_range<size_t> tbbRange(m_Range[0], m_Range[1]);
       tbb::parallel_for(tbbRange, body, partitioner);
     }
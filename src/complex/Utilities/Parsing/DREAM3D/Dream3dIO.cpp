@@ -26,6 +26,7 @@
 
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
@@ -749,6 +750,37 @@ Result<DataStructure> ImportDataStructureV8(const complex::HDF5::FileReader& fil
   return HDF5::DataStructureReader::ReadFile(fileReader, preflight);
 }
 
+Result<DataStructure> ImportDataStructureV8(const complex::HDF5::FileReader& fileReader, const std::vector<DataPath>& importPaths, bool preflight)
+{
+  return HDF5::DataStructureReader::ReadFile(fileReader, importPaths, preflight);
+}
+
+/**
+ * @brief Returns true if the legacy object at the specified path is a parent or child of one of the import paths.
+ * Always returns true if no import paths were specified.
+ * @param importPaths
+ * @param objectPath
+ * @return bool
+ */
+bool isLegacyImportRequired(const std::optional<std::vector<DataPath>>& importPaths, const DataPath& objectPath)
+{
+  if(!importPaths.has_value())
+  {
+    return true;
+  }
+  return std::any_of(importPaths->cbegin(), importPaths->cend(), [&objectPath](const DataPath& importPath) {
+    const usize sharedDepth = std::min(objectPath.getLength(), importPath.getLength());
+    for(usize i = 0; i < sharedDepth; i++)
+    {
+      if(importPath[i] != objectPath[i])
+      {
+        return false;
+      }
+    }
+    return true;
+  });
+}
+
 // Begin legacy DCA importing
 
 /**
@@ -997,10 +1029,12 @@ bool isLegacyStringArray(const complex::HDF5::DatasetReader& arrayReader)
   return objectType == "StringDataArray";
 }
 
-void readLegacyAttributeMatrix(DataStructure& dataStructure, const complex::HDF5::GroupReader& amGroupReader, DataObject& parent, bool preflight = false)
+void readLegacyAttributeMatrix(DataStructure& dataStructure, const complex::HDF5::GroupReader& amGroupReader, DataObject& parent, const std::optional<std::vector<DataPath>>& importPaths,
+                               bool preflight = false)
 {
   DataObject::IdType parentId = parent.getId();
   const std::string amName = amGroupReader.getName();
+  const DataPath amPath({parent.getName(), amName});
 
   auto tDimsReader = amGroupReader.getAttribute("TupleDimensions");
   auto tDims = tDimsReader.readAsVector<uint64>();
@@ -1011,6 +1045,11 @@ void readLegacyAttributeMatrix(DataStructure& dataStructure, const complex::HDF5
   auto dataArrayNames = amGroupReader.getChildNames();
   for(const auto& daName : dataArrayNames)
   {
+    if(!isLegacyImportRequired(importPaths, amPath.createChildPath(daName)))
+    {
+      continue;
+    }
+
     auto dataArraySet = amGroupReader.openDataset(daName);
 
     if(isLegacyNeighborList(dataArraySet))
@@ -1221,7 +1260,7 @@ DataObject* readLegacyImageGeom(DataStructure& dataStructure, const complex::HDF
 }
 // End legacy Geometry importing
 
-void readLegacyDataContainer(DataStructure& dataStructure, const complex::HDF5::GroupReader& dcGroup, bool preflight = false)
+void readLegacyDataContainer(DataStructure& dataStructure, const complex::HDF5::GroupReader& dcGroup, const std::optional<std::vector<DataPath>>& importPaths, bool preflight = false)
 {
   DataObject* container = nullptr;
   const std::string dcName = dcGroup.getName();
@@ -1279,13 +1318,17 @@ void readLegacyDataContainer(DataStructure& dataStructure, const complex::HDF5::
     {
       continue;
     }
+    if(!isLegacyImportRequired(importPaths, DataPath({dcName, amName})))
+    {
+      continue;
+    }
 
     auto attributeMatrixGroup = dcGroup.openGroup(amName);
-    readLegacyAttributeMatrix(dataStructure, attributeMatrixGroup, *container, preflight);
+    readLegacyAttributeMatrix(dataStructure, attributeMatrixGroup, *container, importPaths, preflight);
   }
 }
 
-Result<DataStructure> ImportLegacyDataStructure(const complex::HDF5::FileReader& fileReader, bool preflight)
+Result<DataStructure> ImportLegacyDataStructure(const complex::HDF5::FileReader& fileReader, const std::optional<std::vector<DataPath>>& importPaths, bool preflight)
 {
   DataStructure dataStructure;
 
@@ -1295,8 +1338,13 @@ Result<DataStructure> ImportLegacyDataStructure(const complex::HDF5::FileReader&
   const auto dcNames = dcaGroup.getChildNames();
   for(const auto& dcName : dcNames)
   {
+    if(!isLegacyImportRequired(importPaths, DataPath({dcName})))
+    {
+      continue;
+    }
+
     auto dcGroup = dcaGroup.openGroup(dcName);
-    readLegacyDataContainer(dataStructure, dcGroup, preflight);
+    readLegacyDataContainer(dataStructure, dcGroup, importPaths, preflight);
   }
 
   return {std::move(dataStructure)};
@@ -1311,7 +1359,23 @@ Result<DataStructure> DREAM3D::ImportDataStructureFromFile(const complex::HDF5::
   }
   else if(fileVersion == Legacy::FileVersion)
   {
-    return ImportLegacyDataStructure(fileReader, preflight);
+    return ImportLegacyDataStructure(fileReader, {}, preflight);
+  }
+  // Unsupported file version
+  return MakeErrorResult<DataStructure>(k_InvalidDataStructureVersion,
+                                        fmt::format("Could not parse DataStructure version {}. Expected versions: {} or {}", fileVersion, k_CurrentFileVersion, Legacy::FileVersion));
+}
+
+Result<DataStructure> DREAM3D::ImportDataStructureFromFile(const complex::HDF5::FileReader& fileReader, const std::vector<DataPath>& importPaths, bool preflight)
+{
+  const auto fileVersion = GetFileVersion(fileReader);
+  if(fileVersion == k_CurrentFileVersion)
+  {
+    return ImportDataStructureV8(fileReader, importPaths, preflight);
+  }
+  else if(fileVersion == Legacy::FileVersion)
+  {
+    return ImportLegacyDataStructure(fileReader, importPaths, preflight);
   }
   // Unsupported file version
   return MakeErrorResult<DataStructure>(k_InvalidDataStructureVersion,
@@ -1421,9 +1485,9 @@ Result<> WritePipeline(complex::HDF5::FileWriter& fileWriter, const Pipeline& pi
   return pipelineDatasetWriter.writeString(pipelineString);
 }
 
-Result<> WriteDataStructure(complex::HDF5::FileWriter& fileWriter, const DataStructure& dataStructure)
+Result<> WriteDataStructure(complex::HDF5::FileWriter& fileWriter, const DataStructure& dataStructure, const HDF5::CompressionOptions& compression)
 {
-  return HDF5::DataStructureWriter::WriteFile(dataStructure, fileWriter);
+  return HDF5::DataStructureWriter::WriteFile(dataStructure, fileWriter, compression);
 }
 
 Result<> WriteFileVersion(complex::HDF5::FileWriter& fileWriter)
@@ -1437,7 +1501,7 @@ Result<> DREAM3D::WriteFile(complex::HDF5::FileWriter& fileWriter, const FileDat
   return WriteFile(fileWriter, fileData.first, fileData.second);
 }
 
-Result<> DREAM3D::WriteFile(complex::HDF5::FileWriter& fileWriter, const Pipeline& pipeline, const DataStructure& dataStructure)
+Result<> DREAM3D::WriteFile(complex::HDF5::FileWriter& fileWriter, const Pipeline& pipeline, const DataStructure& dataStructure, const HDF5::CompressionOptions& compression)
 {
   auto result = WriteFileVersion(fileWriter);
   if(result.invalid())
@@ -1450,10 +1514,10 @@ Result<> DREAM3D::WriteFile(complex::HDF5::FileWriter& fileWriter, const Pipelin
   {
     return result;
   }
-  return WriteDataStructure(fileWriter, dataStructure);
+  return WriteDataStructure(fileWriter, dataStructure, compression);
 }
 
-Result<> DREAM3D::WriteFile(const std::filesystem::path& path, const DataStructure& dataStructure, const Pipeline& pipeline, bool writeXdmf)
+Result<> DREAM3D::WriteFile(const std::filesystem::path& path, const DataStructure& dataStructure, const Pipeline& pipeline, bool writeXdmf, const HDF5::CompressionOptions& compression)
 {
   auto fileWriterResult = complex::HDF5::FileWriter::CreateFile(path);
   if(fileWriterResult.invalid())
@@ -1463,7 +1527,7 @@ Result<> DREAM3D::WriteFile(const std::filesystem::path& path, const DataStructu
 
   complex::HDF5::FileWriter fileWriter = std::move(fileWriterResult.value());
 
-  auto result = WriteFile(fileWriter, pipeline, dataStructure);
+  auto result = WriteFile(fileWriter, pipeline, dataStructure, compression);
   if(result.invalid())
   {
     return MakeErrorResult(result.errors()[0].code, fmt::format("DREAM3D::WriteFile: Unable to write DREAM3D file with HDF5 error"));
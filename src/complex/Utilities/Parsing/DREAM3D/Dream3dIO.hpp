@@ -1,6 +1,8 @@
 #pragma once
 
+#include "complex/DataStructure/DataPath.hpp"
 #include "complex/Pipeline/Pipeline.hpp"
+#include "complex/Utilities/Parsing/HDF5/CompressionOptions.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5.hpp"
 #include "complex/complex_export.hpp"
 
@@ -78,18 +80,21 @@ COMPLEX_EXPORT Result<> WriteFile(complex::HDF5::FileWriter& fileWriter, const F
  * @brief Writes a .dream3d file with the specified data.
  * @param fileWriter
  * @param fileData
+ * @param compression = {}
  * @return Result<>
  */
-COMPLEX_EXPORT Result<> WriteFile(complex::HDF5::FileWriter& fileWriter, const Pipeline& pipeline, const DataStructure& dataStructure);
+COMPLEX_EXPORT Result<> WriteFile(complex::HDF5::FileWriter& fileWriter, const Pipeline& pipeline, const DataStructure& dataStructure, const HDF5::CompressionOptions& compression = {});
 
 /**
  * @brief Writes a .dream3d file with the specified data.
  * @param path
  * @param dataStructure
  * @param writeXdmf
+ * @param compression = {}
  * @return bool
  */
-COMPLEX_EXPORT Result<> WriteFile(const std::filesystem::path& path, const DataStructure& dataStructure, const Pipeline& pipeline = {}, bool writeXdmf = false);
+COMPLEX_EXPORT Result<> WriteFile(const std::filesystem::path& path, const DataStructure& dataStructure, const Pipeline& pipeline = {}, bool writeXdmf = false,
+                                  const HDF5::CompressionOptions& compression = {});
 
 /**
  * @brief Imports and returns the DataStructure from the target .dream3d file.
@@ -101,6 +106,18 @@ COMPLEX_EXPORT Result<> WriteFile(const std::filesystem::path& path, const DataS
  */
 COMPLEX_EXPORT Result<DataStructure> ImportDataStructureFromFile(const complex::HDF5::FileReader& fileReader, bool preflight = false);
 
+/**
+ * @brief Imports and returns the DataObjects at the specified paths from the target .dream3d file.
+ * Only the selected DataObjects along with their parents and children are read from the file.
+ *
+ * This method imports both current and legacy DataStructures.
+ * @param fileReader
+ * @param importPaths
+ * @param preflight = false
+ * @return DataStructure
+ */
+COMPLEX_EXPORT Result<DataStructure> ImportDataStructureFromFile(const complex::HDF5::FileReader& fileReader, const std::vector<DataPath>& importPaths, bool preflight = false);
+
 /**
  * @brief Imports and returns the DataStructure from the target .dream3d file.
  * This method imports both current and legacy DataStructures.
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "complex/Common/Types.hpp"
+
+namespace complex::HDF5
+{
+/**
+ * @brief The CompressionOptions struct describes how newly created datasets are
+ * chunked and filtered. Compression is disabled by default. Blosc is only used
+ * when complex is built with COMPLEX_ENABLE_COMPRESSORS and the HDF5 Blosc filter
+ * is available at runtime. Otherwise, deflate is used instead.
+ */
+struct CompressionOptions
+{
+  enum class Method : uint8
+  {
+    None = 0,
+    Deflate,
+    Blosc
+  };
+
+  static inline constexpr uint64 k_DefaultChunkBytes = 1048576; // 1 MB
+
+  Method method = Method::None;
+  uint32 level = 5;
+  bool shuffle = true;
+  uint64 chunkBytes = k_DefaultChunkBytes;
+
+  bool isEnabled() const
+  {
+    return method != Method::None;
+  }
+};
+} // namespace complex::HDF5
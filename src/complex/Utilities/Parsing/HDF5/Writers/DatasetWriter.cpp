@@ -4,12 +4,45 @@
 
 #include "fmt/format.h"
 
+#include <algorithm>
+#include <array>
 #include <iostream>
 
 #include <H5Apublic.h>
+#include <H5Zpublic.h>
+
+namespace
+{
+// Registered HDF5 filter ID for the Blosc compression filter
+constexpr H5Z_filter_t k_BloscFilterId = 32001;
+// Blosc compressor code for zstd in the HDF5 Blosc filter
+constexpr unsigned int k_BloscZstdCode = 5;
+} // namespace
 
 namespace complex::HDF5
 {
+DatasetWriter::DimsType DatasetWriter::ComputeChunkDims(const DimsType& dims, usize typeSize, uint64 targetBytes)
+{
+  DimsType chunkDims = dims;
+  const uint64 targetCount = std::max<uint64>(targetBytes / std::max<usize>(typeSize, 1), 1);
+  for(usize i = 0; i < chunkDims.size(); i++)
+  {
+    uint64 innerCount = 1;
+    for(usize j = i + 1; j < chunkDims.size(); j++)
+    {
+      innerCount *= chunkDims[j];
+    }
+    if(innerCount >= targetCount)
+    {
+      chunkDims[i] = 1;
+      continue;
+    }
+    chunkDims[i] = std::clamp<SizeType>(targetCount / innerCount, 1, std::max<SizeType>(dims[i], 1));
+    break;
+  }
+  return chunkDims;
+}
+
 DatasetWriter::DatasetWriter()
 : ObjectWriter()
 {
@@ -32,6 +65,16 @@ DatasetWriter::~DatasetWriter()
   closeHdf5();
 }
 
+void DatasetWriter::setCompression(const CompressionOptions& options)
+{
+  m_Compression = options;
+}
+
+const CompressionOptions& DatasetWriter::getCompression() const
+{
+  return m_Compression;
+}
+
 #if 0
 bool DatasetWriter::tryOpeningDataset(const std::string& datasetName, Type dataType)
 {
@@ -133,6 +176,7 @@ IdType DatasetWriter::CreateDatasetChunkProperties(nonstd::span<const hsize_t> d
   auto status = H5Pset_chunk(cparms, dims.size(), dims.data());
   if(status < 0)
   {
+    H5Pclose(cparms);
     return H5P_DEFAULT;
   }
   return cparms;
@@ -147,7 +191,134 @@ IdType DatasetWriter::CreateTransferChunkProperties(const DimsType& chunkDims)
 void DatasetWriter::createOrOpenDatasetChunk(IdType typeId, IdType dataspaceId, const DimsType& chunkDims)
 {
   auto propertiesId = CreateDatasetChunkProperties(chunkDims);
+  if(propertiesId != H5P_DEFAULT)
+  {
+    applyCompressionFilters(propertiesId);
+  }
   createOrOpenDataset(typeId, dataspaceId, propertiesId);
+  ClosePropertyList(propertiesId);
+}
+
+Result<> DatasetWriter::createChunkedDataset(IdType typeId, const DimsType& dims, const DimsType& chunkDims)
+{
+  hid_t dataspaceId = H5Screate_simple(static_cast<int32_t>(dims.size()), dims.data(), nullptr);
+  if(dataspaceId < 0)
+  {
+    return MakeErrorResult(dataspaceId, "Error Opening Dataspace");
+  }
+
+  Result<> returnError = findAndDeleteAttribute();
+  if(returnError.invalid())
+  {
+    returnError = MakeErrorResult(returnError.errors()[0].code, "Error Removing Existing Attribute");
+  }
+  else
+  {
+    createOrOpenDatasetChunk(typeId, dataspaceId, chunkDims);
+    if(getId() < 0)
+    {
+      returnError = MakeErrorResult(getId(), "Error Creating Dataset Chunk");
+    }
+  }
+
+  if(H5Sclose(dataspaceId) < 0)
+  {
+    returnError = MakeErrorResult(-1, "Error Closing Dataspace");
+  }
+  return returnError;
+}
+
+IdType DatasetWriter::createDatasetProperties(const DimsType& dims, usize typeSize) const
+{
+  // Chunked layouts cannot contain empty dimensions
+  if(!m_Compression.isEnabled() || dims.empty() || std::find(dims.cbegin(), dims.cend(), 0) != dims.cend())
+  {
+    return H5P_DEFAULT;
+  }
+
+  const DimsType chunkDims = ComputeChunkDims(dims, typeSize, m_Compression.chunkBytes);
+  IdType propertiesId = CreateDatasetChunkProperties(chunkDims);
+  if(propertiesId != H5P_DEFAULT)
+  {
+    applyCompressionFilters(propertiesId);
+  }
+  return propertiesId;
+}
+
+void DatasetWriter::applyCompressionFilters(IdType propertiesId) const
+{
+  if(!m_Compression.isEnabled())
+  {
+    return;
+  }
+
+#ifdef COMPLEX_ENABLE_COMPRESSORS
+  if(m_Compression.method == CompressionOptions::Method::Blosc && H5Zfilter_avail(k_BloscFilterId) > 0)
+  {
+    // The first four values are reserved for the filter's set_local callback
+    std::array<unsigned int, 7> cdValues = {0, 0, 0, 0, std::min(m_Compression.level, 9u), m_Compression.shuffle ? 1u : 0u, k_BloscZstdCode};
+    if(H5Pset_filter(propertiesId, k_BloscFilterId, H5Z_FLAG_OPTIONAL, cdValues.size(), cdValues.data()) >= 0)
+    {
+      return;
+    }
+  }
+#endif
+
+  if(H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0)
+  {
+    return;
+  }
+  if(m_Compression.shuffle)
+  {
+    H5Pset_shuffle(propertiesId);
+  }
+  H5Pset_deflate(propertiesId, std::min(m_Compression.level, 9u));
+}
+
+ErrorType DatasetWriter::writeChunkRegion(IdType typeId, const DimsType& dims, const DimsType& chunkDims, nonstd::span<const hsize_t> offset, const void* data)
+{
+  const usize rank = dims.size();
+  DimsType count(rank);
+  DimsType memOffset(rank, 0);
+  for(usize i = 0; i < rank; i++)
+  {
+    count[i] = std::min<SizeType>(chunkDims[i], dims[i] - std::min<SizeType>(offset[i], dims[i]));
+  }
+
+  ErrorType error = 0;
+  hid_t fileSpaceId = H5Dget_space(getId());
+  hid_t memSpaceId = H5Screate_simple(static_cast<int32_t>(rank), chunkDims.data(), nullptr);
+  if(fileSpaceId < 0 || memSpaceId < 0)
+  {
+    error = -1;
+  }
+  else if(H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, offset.data(), nullptr, count.data(), nullptr) < 0 ||
+          H5Sselect_hyperslab(memSpaceId, H5S_SELECT_SET, memOffset.data(), nullptr, count.data(), nullptr) < 0)
+  {
+    error = -1;
+  }
+  else
+  {
+    error = H5Dwrite(getId(), typeId, memSpaceId, fileSpaceId, H5P_DEFAULT, data);
+  }
+
+  if(memSpaceId >= 0)
+  {
+    H5Sclose(memSpaceId);
+  }
+  if(fileSpaceId >= 0)
+  {
+    H5Sclose(fileSpaceId);
+  }
+  return error;
+}
+
+void DatasetWriter::ClosePropertyList(IdType propertiesId)
+{
+  if(propertiesId > 0 && propertiesId != H5P_DEFAULT)
+  {
+    H5Pclose(propertiesId);
+  }
 }
 
 IdType DatasetWriter::getPListId() const
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "complex/Utilities/Parsing/HDF5/CompressionOptions.hpp"
 #include "complex/Utilities/Parsing/HDF5/H5Support.hpp"
 #include "complex/Utilities/Parsing/HDF5/Writers/ObjectWriter.hpp"
 
@@ -14,6 +15,17 @@ class COMPLEX_EXPORT DatasetWriter : public ObjectWriter
 public:
   using DimsType = std::vector<SizeType>;
 
+  /**
+   * @brief Returns chunk dimensions for a dataset with the given dimensions so
+   * that a single chunk holds at most targetBytes. Chunks cover whole rows of
+   * the fastest dimensions so that chunks map to contiguous memory.
+   * @param dims
+   * @param typeSize
+   * @param targetBytes
+   * @return DimsType
+   */
+  static DimsType ComputeChunkDims(const DimsType& dims, usize typeSize, uint64 targetBytes);
+
   /**
    * @brief Constructs an invalid DatasetWriter.
    */
@@ -47,6 +59,19 @@ public:
    */
   std::string getName() const override;
 
+  /**
+   * @brief Sets the compression options used when creating numeric datasets.
+   * Existing datasets keep their original layout.
+   * @param options
+   */
+  void setCompression(const CompressionOptions& options);
+
+  /**
+   * @brief Returns the compression options used when creating numeric datasets.
+   * @return const CompressionOptions&
+   */
+  const CompressionOptions& getCompression() const;
+
   /**
    * @brief Writes a given string to the dataset. Returns the HDF5 error,
    * should one occur.
@@ -103,7 +128,9 @@ public:
       else
       {
         /* Create the attribute. */
-        createOrOpenDataset(dataType, dataspaceId);
+        IdType propertiesId = createDatasetProperties(dims, sizeof(T));
+        createOrOpenDataset(dataType, dataspaceId, propertiesId);
+        ClosePropertyList(propertiesId);
         if(getId() >= 0)
         {
           /* Write the attribute data. */
@@ -133,64 +160,143 @@ public:
     return returnError;
   }
 
+  /**
+   * @brief Creates the dataset with the given dimensions without writing any
+   * values so that it can be filled using writeHyperslab(). Opens the dataset
+   * instead if it already exists.
+   * @tparam T
+   * @param dims
+   * @return Result<>
+   */
   template <typename T>
-  Result<> writeChunk(const DimsType& dims, nonstd::span<const T> values, const DimsType& chunkShape, nonstd::span<const hsize_t> offset)
+  Result<> createDataset(const DimsType& dims)
   {
+    hid_t dataType = Support::HdfTypeForPrimitive<T>();
+    if(dataType == -1)
+    {
+      return MakeErrorResult(-1, "DataType was unknown");
+    }
+
+    hid_t dataspaceId = H5Screate_simple(static_cast<int32_t>(dims.size()), dims.data(), nullptr);
+    if(dataspaceId < 0)
+    {
+      return MakeErrorResult(dataspaceId, "Error Opening Dataspace");
+    }
+
+    Result<> returnError = findAndDeleteAttribute();
+    if(returnError.valid())
+    {
+      IdType propertiesId = createDatasetProperties(dims, sizeof(T));
+      createOrOpenDataset(dataType, dataspaceId, propertiesId);
+      ClosePropertyList(propertiesId);
+      if(getId() < 0)
+      {
+        returnError = MakeErrorResult(getId(), "Error Creating Dataset");
+      }
+    }
+    if(H5Sclose(dataspaceId) < 0)
+    {
+      returnError = MakeErrorResult(-1, "Error Closing Dataspace");
+    }
+    return returnError;
+  }
+
+  /**
+   * @brief Writes a contiguous block of values into the region of the dataset
+   * starting at offset with the given extent. The dataset must have been created
+   * with createDataset() or one of the write* methods beforehand.
+   * @tparam T
+   * @param values
+   * @param offset
+   * @param count
+   * @return Result<>
+   */
+  template <typename T>
+  Result<> writeHyperslab(nonstd::span<const T> values, const DimsType& offset, const DimsType& count)
+  {
+    if(getId() <= 0)
+    {
+      return MakeErrorResult(-100, "Cannot write hyperslab before the dataset is created");
+    }
+    hid_t dataType = Support::HdfTypeForPrimitive<T>();
+    if(dataType == -1)
+    {
+      return MakeErrorResult(-1, "DataType was unknown");
+    }
+
     Result<> returnError = {};
-    herr_t error = 0;
-    int32_t rank = static_cast<int32_t>(dims.size());
+    hid_t fileSpaceId = H5Dget_space(getId());
+    hid_t memSpaceId = H5Screate_simple(static_cast<int32_t>(count.size()), count.data(), nullptr);
+    if(fileSpaceId < 0 || memSpaceId < 0)
+    {
+      returnError = MakeErrorResult(-1, "Error Opening Dataspace");
+    }
+    else if(H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, offset.data(), nullptr, count.data(), nullptr) < 0)
+    {
+      returnError = MakeErrorResult(-1, "Error Selecting Dataset Hyperslab");
+    }
+    else if(H5Dwrite(getId(), dataType, memSpaceId, fileSpaceId, H5P_DEFAULT, static_cast<const void*>(values.data())) < 0)
+    {
+      returnError = MakeErrorResult(-1, "Error Writing Dataset Hyperslab");
+    }
+
+    if(memSpaceId >= 0)
+    {
+      H5Sclose(memSpaceId);
+    }
+    if(fileSpaceId >= 0)
+    {
+      H5Sclose(fileSpaceId);
+    }
+    return returnError;
+  }
+
+  /**
+   * @brief Writes a single chunk of values at the given element offset. The
+   * chunked dataset is created when the first chunk is written and kept open for
+   * the remaining chunks. Values must hold a full chunk even at the dataset edges.
+   * @tparam T
+   * @param dims
+   * @param values
+   * @param chunkShape
+   * @param offset
+   * @return Result<>
+   */
+  template <typename T>
+  Result<> writeChunk(const DimsType& dims, nonstd::span<const T> values, const DimsType& chunkShape, nonstd::span<const hsize_t> offset)
+  {
     hid_t dataType = Support::HdfTypeForPrimitive<T>();
     if(dataType == -1)
     {
       return MakeErrorResult(-100, "DataType was unkown");
     }
 
-    hid_t dataspaceId = H5Screate_simple(rank, dims.data(), nullptr);
-    if(dataspaceId >= 0)
+    if(getId() <= 0)
     {
-      auto result = findAndDeleteAttribute();
+      Result<> result = createChunkedDataset(dataType, dims, chunkShape);
       if(result.invalid())
       {
-        returnError = MakeErrorResult(result.errors()[0].code, "Error Removing Existing Attribute");
-      }
-      else
-      {
-        /* Create the attribute. */
-        createOrOpenDatasetChunk(dataType, dataspaceId, chunkShape);
-        if(getId() >= 0)
-        {
-          auto plistId = getPListId();
-          if(plistId <= 0)
-          {
-            std::cout << "Error Writing Chunk: No PList ID found" << std::endl;
-          }
-          /* Write the attribute data. */
-          const void* data = static_cast<const void*>(values.data());
-          auto properties = CreateTransferChunkProperties(chunkShape);
-          // error = H5Dwrite_chunk(getId(), properties, H5P_DEFAULT, offset.data(), values.size(), data);
-          error = H5Dwrite_chunk(getId(), H5P_DEFAULT, H5P_DEFAULT, offset.data(), values.size() * sizeof(T), data);
-          if(error < 0)
-          {
-            returnError = MakeErrorResult(error, "Error Writing Dataset Chunk");
-          }
-        }
-        else
-        {
-          returnError = MakeErrorResult(getId(), "Error Creating Dataset Chunk");
-        }
-      }
-      /* Close the dataspace. */
-      error = H5Sclose(dataspaceId);
-      if(error < 0)
-      {
-        returnError = MakeErrorResult(error, "Error Closing Dataspace");
+        return result;
       }
     }
+
+    herr_t error = 0;
+    const void* data = static_cast<const void*>(values.data());
+    if(m_Compression.isEnabled())
+    {
+      // Raw chunk writes bypass the filter pipeline so compressed chunks
+      // go through a regular write of the chunk's region instead.
+      error = writeChunkRegion(dataType, dims, chunkShape, offset, data);
+    }
     else
     {
-      returnError = MakeErrorResult(dataspaceId, "Error Opening Dataspace");
+      error = H5Dwrite_chunk(getId(), H5P_DEFAULT, H5P_DEFAULT, offset.data(), values.size() * sizeof(T), data);
     }
-    return returnError;
+    if(error < 0)
+    {
+      return MakeErrorResult(error, "Error Writing Dataset Chunk");
+    }
+    return {};
   }
 
   /**
@@ -219,6 +325,50 @@ protected:
 
   void createOrOpenDatasetChunk(IdType typeId, IdType dataspaceId, const DimsType& chunkDims);
 
+  /**
+   * @brief Creates or opens the chunked dataset with the given dimensions.
+   * @param typeId
+   * @param dims
+   * @param chunkDims
+   * @return Result<>
+   */
+  Result<> createChunkedDataset(IdType typeId, const DimsType& dims, const DimsType& chunkDims);
+
+  /**
+   * @brief Creates the dataset creation property list for a numeric dataset
+   * using the current compression options. Returns H5P_DEFAULT if the dataset
+   * should not be chunked or compressed.
+   * @param dims
+   * @param typeSize
+   * @return IdType
+   */
+  IdType createDatasetProperties(const DimsType& dims, usize typeSize) const;
+
+  /**
+   * @brief Adds the filters from the current compression options to the
+   * property list. The property list must already be chunked.
+   * @param propertiesId
+   */
+  void applyCompressionFilters(IdType propertiesId) const;
+
+  /**
+   * @brief Writes a full size chunk buffer to the region of the dataset that
+   * the chunk covers, clipping the chunk to the dataset dimensions.
+   * @param typeId
+   * @param dims
+   * @param chunkDims
+   * @param offset
+   * @param data
+   * @return ErrorType
+   */
+  ErrorType writeChunkRegion(IdType typeId, const DimsType& dims, const DimsType& chunkDims, nonstd::span<const hsize_t> offset, const void* data);
+
+  /**
+   * @brief Closes the property list if it is not H5P_DEFAULT.
+   * @param propertiesId
+   */
+  static void ClosePropertyList(IdType propertiesId);
+
   /**
    * @brief Applies chunking to the dataset and sets the chunk dimensions.
    * @param dims
@@ -235,5 +385,6 @@ protected:
 
 private:
   const std::string m_DatasetName;
+  CompressionOptions m_Compression;
 };
 } // namespace complex::HDF5
@@ -4,6 +4,7 @@
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStructure.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
+#include "complex/Utilities/Parsing/Text/TextTokenizer.hpp"
 #include "complex/Utilities/StringUtilities.hpp"
 #include "complex/complex_export.hpp"
 
@@ -13,6 +14,7 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -175,72 +177,120 @@ Result<> ReadFile(const fs::path& filename, DataArray<T>& data, uint64_t skipHea
 }
 
 /**
- * @brief Reads a Text file that contains numeric values into a single DataArray<T> using an intermediate string token and checks for valid conversion to the templated type T.
+ * @brief Reads a Text file that contains numeric values into a single DataArray<T> and checks for valid conversion to the templated type T.
+ * The file is memory mapped and split into blocks of lines. The values in each block are counted first so that the blocks can then be
+ * converted in parallel straight into the DataStore.
  * @tparam T Final Target type of the value being read
  * @param filename The input path to the text file
  * @param data The Target DataArray<T>
  * @param skipHeaderLines Number of "header lines" that should be skipped before parsing begins
- * @param delimiter The delimiter to use: Comma, Space, Tab
+ * @param delimiter The delimiter to use: Comma, Space, Tab. Whitespace always separates values.
  * @return Result<> with any errors or warnings that were encountered.
  */
 template <typename T>
 Result<> ReadFile(const fs::path& filename, DataArray<T>& data, uint64_t skipHeaderLines, char delimiter)
 {
-  int32_t err = k_RBR_NO_ERROR;
   if(!fs::exists(filename))
   {
     return MakeErrorResult(k_RBR_FILE_NOT_EXIST, fmt::format("Input file does not exist: {}", filename.string()));
   }
 
-  std::ifstream in(filename.c_str(), std::ios_base::in | std::ios_base::binary);
-  if(!in.is_open())
+  std::unique_ptr<TextTokenizer> tokenizer = TextTokenizer::Open(filename);
+  if(tokenizer == nullptr)
   {
     return MakeErrorResult(k_RBR_FILE_NOT_OPEN, fmt::format("Could not open file for reading: {}", filename.string()));
   }
-
-  in.imbue(std::locale(std::locale(), new complex::CsvParser::DelimiterType(delimiter)));
-
-  std::array<char, k_BufferSize> buf = {};
-  char* buffer = buf.data();
-
-  // Skip some header bytes by just reading those bytes into the pointer knowing that the next
-  // thing we are going to do it over write those bytes with the real data that we are after.
-  for(int i = 0; i < skipHeaderLines; i++)
+  if(skipHeaderLines > tokenizer->getNumberOfLines())
   {
-    buf.fill(0x00);                                               // Splat Null Chars across the line
-    err = complex::CsvParser::ReadLine(in, buffer, k_BufferSize); // Read Line 1 - VTK Version Info
-    if(err < 0)
-    {
-      return MakeErrorResult(k_RBR_READ_ERROR, fmt::format("Could not read data from file while skipping header lines: {}", filename.string()));
-    }
+    return MakeErrorResult(k_RBR_READ_ERROR, fmt::format("Could not read data from file while skipping header lines: {}", filename.string()));
   }
 
-  size_t numTuples = data.getNumberOfTuples();
-  int scalarNumComp = data.getNumberOfComponents();
+  const usize totalSize = data.getSize();
+  const std::array<char, 6> delimiters = {delimiter, ' ', '\t', '\r', '\v', '\f'};
+  const usize numBlocks = tokenizer->getNumberOfBlocks();
 
-  size_t totalSize = numTuples * static_cast<size_t>(scalarNumComp);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setParallelizationEnabled(tokenizer->getParallelizationEnabled() && IParallelAlgorithm::CheckArraysInMemory({&data}));
 
-  std::string value;
-  for(size_t i = 0; i < totalSize; ++i)
+  // Count the values in each block so that each block knows where its first value is stored.
+  // The blocks are counted in waves of one block per thread and counting stops as soon as
+  // the blocks counted so far hold enough values, so trailing data is never scanned.
+  const usize waveSize = dataAlg.getMaxThreads();
+  std::vector<usize> blockOffsets(numBlocks + 1, 0);
+  usize countedBlocks = 0;
+  while(countedBlocks < numBlocks && blockOffsets[countedBlocks] < totalSize)
   {
-    in >> value;
-    Result<T> parseResult = ConvertTo<T>::convert(value);
-    if(parseResult.invalid())
+    const usize waveEnd = std::min(countedBlocks + waveSize, numBlocks);
+    // No block needs to count past the values still missing before the wave
+    const usize remaining = totalSize - blockOffsets[countedBlocks];
+    dataAlg.setRange(countedBlocks, waveEnd);
+    dataAlg.execute([&](const Range& range) {
+      for(usize blockIndex = range.min(); blockIndex < range.max(); blockIndex++)
+      {
+        usize count = 0;
+        tokenizer->forEachLineInBlock(blockIndex, skipHeaderLines, TextTokenizer::k_AllLines, [&delimiters, &count, remaining](usize, std::string_view line) {
+          count += TextTokenizer::CountTokens(line, delimiters);
+          return count < remaining;
+        });
+        blockOffsets[blockIndex + 1] = count;
+      }
+    });
+    for(usize blockIndex = countedBlocks; blockIndex < waveEnd; blockIndex++)
     {
-      return ConvertResult(std::move(parseResult));
+      blockOffsets[blockIndex + 1] += blockOffsets[blockIndex];
     }
-    data[i] = parseResult.value();
-    err = CheckErrorBits(&in);
-    if(err == k_RBR_READ_EOF && i < totalSize - 1)
+    countedBlocks = waveEnd;
+  }
+  if(blockOffsets[countedBlocks] < totalSize)
+  {
+    return MakeErrorResult(k_RBR_READ_EOF, fmt::format("Read past End Of File (EOF) while parsing file: {}", filename.string()));
+  }
+
+  AbstractDataStore<T>& dataStore = data.getDataStoreRef();
+  T* values = dataStore.getContiguousValues(0);
+  std::vector<Result<>> blockResults(countedBlocks);
+  dataAlg.setRange(0, countedBlocks);
+  dataAlg.execute([&](const Range& range) {
+    for(usize blockIndex = range.min(); blockIndex < range.max(); blockIndex++)
     {
-      return MakeErrorResult(k_RBR_READ_EOF, fmt::format("Read past End Of File (EOF) while parsing file: {}", filename.string()));
+      usize index = blockOffsets[blockIndex];
+      if(index >= totalSize)
+      {
+        return;
+      }
+      tokenizer->forEachLineInBlock(blockIndex, skipHeaderLines, TextTokenizer::k_AllLines, [&](usize, std::string_view line) {
+        bool valid = true;
+        TextTokenizer::ForEachToken(line, delimiters, [&](usize, std::string_view token) {
+          T value = {};
+          if(TextTokenizer::FromChars(token, value) != std::errc{})
+          {
+            blockResults[blockIndex] = ConvertResult(TextTokenizer::Convert<T>(token));
+            valid = false;
+            return false;
+          }
+          if(values != nullptr)
+          {
+            values[index] = value;
+          }
+          else
+          {
+            dataStore.setValue(index, value);
+          }
+          index++;
+          return index < totalSize;
+        });
+        return valid && index < totalSize;
+      });
     }
-    if(err == k_RBR_READ_ERROR)
+  });
+
+  for(Result<>& result : blockResults)
+  {
+    if(result.invalid())
     {
-      return MakeErrorResult(k_RBR_READ_ERROR, fmt::format("Read error while parsing file: {}", filename.string()));
+      return std::move(result);
     }
   }
-
   return {};
 }
 
@@ -0,0 +1,218 @@
+#include "TextTokenizer.hpp"
+
+using namespace complex;
+
+namespace
+{
+constexpr std::string_view k_TrimCharacters = " \t\r\n\v\f";
+} // namespace
+
+// -----------------------------------------------------------------------------
+std::unique_ptr<TextTokenizer> TextTokenizer::Open(const std::filesystem::path& filePath, bool parallelizationEnabled)
+{
+  std::unique_ptr<MemoryMappedFile> file = MemoryMappedFile::Open(filePath, MemoryMappedFile::Mode::ReadOnly);
+  if(file == nullptr)
+  {
+    return nullptr;
+  }
+
+  std::unique_ptr<TextTokenizer> tokenizer(new TextTokenizer(std::move(file), parallelizationEnabled));
+  tokenizer->findLines();
+  return tokenizer;
+}
+
+// -----------------------------------------------------------------------------
+TextTokenizer::TextTokenizer(std::unique_ptr<MemoryMappedFile> file, bool parallelizationEnabled)
+: m_File(std::move(file))
+, m_ParallelizationEnabled(parallelizationEnabled)
+{
+}
+
+// -----------------------------------------------------------------------------
+TextTokenizer::~TextTokenizer() noexcept = default;
+
+// -----------------------------------------------------------------------------
+std::string_view TextTokenizer::text() const
+{
+  if(m_File->size() == 0)
+  {
+    return {};
+  }
+  return {reinterpret_cast<const char*>(m_File->data()), static_cast<usize>(m_File->size())};
+}
+
+// -----------------------------------------------------------------------------
+void TextTokenizer::findLines()
+{
+  const std::string_view text = this->text();
+  const usize numBlocks = (text.size() + k_BlockSize - 1) / k_BlockSize;
+  m_Blocks.assign(numBlocks, {});
+  std::vector<usize> lineCounts(numBlocks, 0);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numBlocks);
+  dataAlg.setParallelizationEnabled(m_ParallelizationEnabled);
+
+  // Move the start of each block to the first line that starts inside of it. Blocks
+  // that are covered by a single long line are marked empty with k_AllLines.
+  dataAlg.execute([this, &text](const Range& range) {
+    for(usize blockIndex = range.min(); blockIndex < range.max(); blockIndex++)
+    {
+      if(blockIndex == 0)
+      {
+        m_Blocks[blockIndex].begin = 0;
+        continue;
+      }
+      const usize rawBegin = blockIndex * k_BlockSize;
+      const usize rawEnd = std::min(rawBegin + k_BlockSize, text.size());
+      // A line starts at rawBegin if the previous character ends a line
+      const usize lineFeed = text.substr(0, rawEnd - 1).find('\n', rawBegin - 1);
+      m_Blocks[blockIndex].begin = lineFeed == std::string_view::npos ? k_AllLines : lineFeed + 1;
+    }
+  });
+
+  for(usize blockIndex = numBlocks; blockIndex-- > 0;)
+  {
+    const usize nextBegin = blockIndex + 1 < numBlocks ? m_Blocks[blockIndex + 1].begin : text.size();
+    if(m_Blocks[blockIndex].begin == k_AllLines)
+    {
+      m_Blocks[blockIndex].begin = nextBegin;
+    }
+    m_Blocks[blockIndex].end = nextBegin;
+  }
+
+  dataAlg.execute([this, &text, &lineCounts](const Range& range) {
+    for(usize blockIndex = range.min(); blockIndex < range.max(); blockIndex++)
+    {
+      const LineBlock& block = m_Blocks[blockIndex];
+      const std::string_view blockText = text.substr(block.begin, block.end - block.begin);
+      lineCounts[blockIndex] = std::count(blockText.begin(), blockText.end(), '\n');
+    }
+  });
+
+  // The text after the last line feed is the last line, even if it is empty. It is
+  // read by the last block that holds any text.
+  for(usize blockIndex = numBlocks; blockIndex-- > 0;)
+  {
+    if(m_Blocks[blockIndex].begin < m_Blocks[blockIndex].end)
+    {
+      lineCounts[blockIndex]++;
+      break;
+    }
+  }
+
+  usize firstLine = 0;
+  for(usize blockIndex = 0; blockIndex < numBlocks; blockIndex++)
+  {
+    m_Blocks[blockIndex].firstLine = firstLine;
+    firstLine += lineCounts[blockIndex];
+  }
+  m_NumLines = firstLine;
+}
+
+// -----------------------------------------------------------------------------
+usize TextTokenizer::size() const
+{
+  return static_cast<usize>(m_File->size());
+}
+
+// -----------------------------------------------------------------------------
+usize TextTokenizer::getNumberOfLines() const
+{
+  return m_NumLines;
+}
+
+// -----------------------------------------------------------------------------
+usize TextTokenizer::getNumberOfBlocks() const
+{
+  return m_Blocks.size();
+}
+
+// -----------------------------------------------------------------------------
+bool TextTokenizer::getParallelizationEnabled() const
+{
+  return m_ParallelizationEnabled;
+}
+
+// -----------------------------------------------------------------------------
+void TextTokenizer::setParallelizationEnabled(bool enabled)
+{
+  m_ParallelizationEnabled = enabled;
+}
+
+// -----------------------------------------------------------------------------
+std::string_view TextTokenizer::getLine(usize index) const
+{
+  if(index >= m_NumLines)
+  {
+    return {};
+  }
+
+  // The last block whose first line is not after the index holds the line
+  auto blockIter = std::upper_bound(m_Blocks.cbegin(), m_Blocks.cend(), index, [](usize value, const LineBlock& block) { return value < block.firstLine; });
+  const LineBlock& block = *std::prev(blockIter);
+  usize offset = block.begin;
+  for(usize lineIndex = block.firstLine; lineIndex < index; lineIndex++)
+  {
+    readLine(offset);
+  }
+  return readLine(offset);
+}
+
+// -----------------------------------------------------------------------------
+std::string_view TextTokenizer::readLine(usize& offset) const
+{
+  const std::string_view text = this->text();
+  if(offset >= text.size())
+  {
+    offset = text.size();
+    return {};
+  }
+
+  usize lineFeed = text.find('\n', offset);
+  if(lineFeed == std::string_view::npos)
+  {
+    lineFeed = text.size();
+  }
+  std::string_view line = text.substr(offset, lineFeed - offset);
+  if(!line.empty() && line.back() == '\r')
+  {
+    line.remove_suffix(1);
+  }
+  offset = std::min(lineFeed + 1, text.size());
+  return line;
+}
+
+// -----------------------------------------------------------------------------
+bool TextTokenizer::isEnd(usize offset) const
+{
+  return offset >= size();
+}
+
+// -----------------------------------------------------------------------------
+usize TextTokenizer::CountTokens(std::string_view line, nonstd::span<const char> delimiters)
+{
+  return ForEachToken(line, delimiters, [](usize, std::string_view) { return true; });
+}
+
+// -----------------------------------------------------------------------------
+void TextTokenizer::Split(std::string_view line, nonstd::span<const char> delimiters, std::vector<std::string_view>& tokens)
+{
+  tokens.clear();
+  ForEachToken(line, delimiters, [&tokens](usize, std::string_view token) {
+    tokens.push_back(token);
+    return true;
+  });
+}
+
+// -----------------------------------------------------------------------------
+std::string_view TextTokenizer::Trim(std::string_view token)
+{
+  const usize first = token.find_first_not_of(k_TrimCharacters);
+  if(first == std::string_view::npos)
+  {
+    return {};
+  }
+  const usize last = token.find_last_not_of(k_TrimCharacters);
+  return token.substr(first, last - first + 1);
+}
@@ -0,0 +1,418 @@
+#pragma once
+
+#include "complex/Common/Result.hpp"
+#include "complex/Common/Types.hpp"
+#include "complex/Common/TypesUtility.hpp"
+#include "complex/Utilities/MemoryMappedFile.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
+#include "complex/complex_export.hpp"
+
+#include <fmt/core.h>
+#include <nonstd/span.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace complex
+{
+/**
+ * @class TextTokenizer
+ * @brief The TextTokenizer class memory maps a text file and splits it into lines
+ * and tokens without copying any of the text. The line boundaries are located once
+ * in parallel blocks of about k_BlockSize bytes. Ranges of lines can then be visited
+ * block by block from multiple threads and each token converted with std::from_chars
+ * straight into the destination DataStore.
+ *
+ * Lines end with "\n" or "\r\n". Tokens are split on a set of delimiters and empty
+ * tokens are dropped, which matches StringUtilities::split(). The conversion errors
+ * use the same codes as ConvertTo<T>: k_InvalidToken if the token is not a number and
+ * k_OutOfRange if the value does not fit into T.
+ *
+ * Instances are created through the Open() factory method which returns nullptr if
+ * the file could not be mapped.
+ */
+class COMPLEX_EXPORT TextTokenizer
+{
+public:
+  static constexpr int32 k_InvalidToken = -100;
+  static constexpr int32 k_OutOfRange = -101;
+
+  /**
+   * @brief Returned by the line visitors when every line was visited.
+   */
+  static constexpr usize k_AllLines = std::numeric_limits<usize>::max();
+
+  /**
+   * @brief Approximate number of bytes in each block of lines. A block is the unit
+   * of work when the lines are visited in parallel.
+   */
+  static constexpr usize k_BlockSize = 4 * 1024 * 1024;
+
+  /**
+   * @brief Spaces, tabs and the other characters that std::isspace() accepts apart from the line feed.
+   */
+  static constexpr std::array<char, 5> k_Whitespace = {' ', '\t', '\r', '\v', '\f'};
+
+  /**
+   * @brief Maps the file read only and finds the line boundaries.
+   * Returns nullptr if the file does not exist or could not be mapped.
+   * @param filePath
+   * @param parallelizationEnabled Finds the line boundaries and visits the lines from multiple threads
+   * @return std::unique_ptr<TextTokenizer>
+   */
+  static std::unique_ptr<TextTokenizer> Open(const std::filesystem::path& filePath, bool parallelizationEnabled = true);
+
+  ~TextTokenizer() noexcept;
+
+  TextTokenizer(const TextTokenizer&) = delete;
+  TextTokenizer(TextTokenizer&&) noexcept = delete;
+  TextTokenizer& operator=(const TextTokenizer&) = delete;
+  TextTokenizer& operator=(TextTokenizer&&) noexcept = delete;
+
+  /**
+   * @brief Returns the number of bytes in the file.
+   * @return usize
+   */
+  usize size() const;
+
+  /**
+   * @brief Returns the number of lines in the file. Like std::getline(), a line feed
+   * at the end of the file is followed by an empty last line. An empty file has no lines.
+   * @return usize
+   */
+  usize getNumberOfLines() const;
+
+  /**
+   * @brief Returns the number of line blocks.
+   * @return usize
+   */
+  usize getNumberOfBlocks() const;
+
+  /**
+   * @brief Returns true if lines are visited from multiple threads.
+   * @return bool
+   */
+  bool getParallelizationEnabled() const;
+
+  /**
+   * @brief Sets whether lines are visited from multiple threads. Disable this if
+   * the visitor writes into arrays that are not held in memory.
+   * @param enabled
+   */
+  void setParallelizationEnabled(bool enabled);
+
+  /**
+   * @brief Returns the line with the given index without the line ending. The line
+   * is found by scanning its block, so use readLine() or forEachLine() to walk
+   * through many lines. Returns an empty string if the index is out of range.
+   * @param index
+   * @return std::string_view
+   */
+  std::string_view getLine(usize index) const;
+
+  /**
+   * @brief Returns the line that starts at the byte offset without the line ending
+   * and moves the offset to the start of the next line. This is the sequential
+   * replacement for std::getline().
+   * @param offset
+   * @return std::string_view
+   */
+  std::string_view readLine(usize& offset) const;
+
+  /**
+   * @brief Returns true if the byte offset is at or past the end of the file.
+   * @param offset
+   * @return bool
+   */
+  bool isEnd(usize offset) const;
+
+  /**
+   * @brief Calls func(lineIndex, line) for every line of the block that lies in
+   * [firstLine, lastLine), in order. Stops at the first line for which func returns
+   * false and returns the index of that line, otherwise returns k_AllLines.
+   * @param blockIndex
+   * @param firstLine
+   * @param lastLine
+   * @param func
+   * @return usize
+   */
+  template <typename LineFunc>
+  usize forEachLineInBlock(usize blockIndex, usize firstLine, usize lastLine, LineFunc&& func) const
+  {
+    const LineBlock& block = m_Blocks[blockIndex];
+    const usize blockLastLine = blockIndex + 1 < m_Blocks.size() ? m_Blocks[blockIndex + 1].firstLine : m_NumLines;
+    if(blockLastLine <= firstLine || block.firstLine >= lastLine)
+    {
+      return k_AllLines;
+    }
+
+    usize offset = block.begin;
+    for(usize lineIndex = block.firstLine; lineIndex < blockLastLine && lineIndex < lastLine; lineIndex++)
+    {
+      const std::string_view line = readLine(offset);
+      if(lineIndex >= firstLine && !func(lineIndex, line))
+      {
+        return lineIndex;
+      }
+    }
+    return k_AllLines;
+  }
+
+  /**
+   * @brief Calls func(lineIndex, line) for the numLines lines starting at firstLine.
+   * The blocks are visited in parallel when parallelization is enabled, so func must
+   * be safe to call from multiple threads. Returns the lowest line index for which
+   * func returned false or k_AllLines. Every line before the returned index has been
+   * visited; lines after it may or may not have been.
+   * @param firstLine
+   * @param numLines
+   * @param func
+   * @return usize
+   */
+  template <typename LineFunc>
+  usize forEachLine(usize firstLine, usize numLines, LineFunc&& func) const
+  {
+    if(firstLine >= m_NumLines)
+    {
+      return k_AllLines;
+    }
+    const usize lastLine = firstLine + std::min(numLines, m_NumLines - firstLine);
+
+    std::atomic<usize> failedLine = k_AllLines;
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, m_Blocks.size());
+    dataAlg.setParallelizationEnabled(m_ParallelizationEnabled);
+    dataAlg.execute([&](const Range& range) {
+      for(usize blockIndex = range.min(); blockIndex < range.max(); blockIndex++)
+      {
+        const usize stoppedAt = forEachLineInBlock(blockIndex, firstLine, lastLine, [&](usize lineIndex, std::string_view line) {
+          // Lines after a failed line are not needed, lines before it still have to be checked
+          return lineIndex < failedLine.load(std::memory_order_relaxed) && func(lineIndex, line);
+        });
+        if(stoppedAt != k_AllLines)
+        {
+          usize current = failedLine.load();
+          while(stoppedAt < current && !failedLine.compare_exchange_weak(current, stoppedAt))
+          {
+          }
+          return;
+        }
+      }
+    });
+
+    const usize result = failedLine.load();
+    return result < lastLine ? result : k_AllLines;
+  }
+
+  /**
+   * @brief Calls func(tokenIndex, token) for every non empty token of the line, in
+   * order. Stops early if func returns false. Returns the number of tokens visited.
+   * @param line
+   * @param delimiters
+   * @param func
+   * @return usize
+   */
+  template <typename TokenFunc>
+  static usize ForEachToken(std::string_view line, nonstd::span<const char> delimiters, TokenFunc&& func)
+  {
+    const std::string_view delimiterSet(delimiters.data(), delimiters.size());
+    usize tokenIndex = 0;
+    usize start = 0;
+    while(start < line.size())
+    {
+      usize end = line.find_first_of(delimiterSet, start);
+      if(end == std::string_view::npos)
+      {
+        end = line.size();
+      }
+      if(end > start)
+      {
+        if(!func(tokenIndex, line.substr(start, end - start)))
+        {
+          return tokenIndex + 1;
+        }
+        tokenIndex++;
+      }
+      start = end + 1;
+    }
+    return tokenIndex;
+  }
+
+  /**
+   * @brief Returns the number of non empty tokens in the line.
+   * @param line
+   * @param delimiters
+   * @return usize
+   */
+  static usize CountTokens(std::string_view line, nonstd::span<const char> delimiters);
+
+  /**
+   * @brief Replaces the contents of tokens with the non empty tokens of the line.
+   * The views point into the line.
+   * @param line
+   * @param delimiters
+   * @param tokens
+   */
+  static void Split(std::string_view line, nonstd::span<const char> delimiters, std::vector<std::string_view>& tokens);
+
+  /**
+   * @brief Removes leading and trailing whitespace.
+   * @param token
+   * @return std::string_view
+   */
+  static std::string_view Trim(std::string_view token);
+
+  /**
+   * @brief Converts the token into value without allocating. Leading and trailing
+   * whitespace and a leading '+' are ignored and, like the std::sto* functions,
+   * parsing stops at the first character that does not belong to the number.
+   * Booleans accept true/false or a number where anything but 0 is true.
+   * @param token
+   * @param value Unchanged if the conversion fails
+   * @return std::errc std::errc::invalid_argument or std::errc::result_out_of_range on failure
+   */
+  template <typename T>
+  static std::errc FromChars(std::string_view token, T& value)
+  {
+    token = Trim(token);
+    if(!token.empty() && token.front() == '+')
+    {
+      token.remove_prefix(1);
+    }
+    if(token.empty())
+    {
+      return std::errc::invalid_argument;
+    }
+
+    if constexpr(std::is_same_v<T, bool>)
+    {
+      if(token == "TRUE" || token == "true" || token == "True")
+      {
+        value = true;
+        return {};
+      }
+      if(token == "FALSE" || token == "false" || token == "False")
+      {
+        value = false;
+        return {};
+      }
+      int64 intValue = 0;
+      if(FromChars(token, intValue) == std::errc{})
+      {
+        value = intValue != 0;
+        return {};
+      }
+      float64 floatValue = 0.0;
+      if(FromChars(token, floatValue) == std::errc{})
+      {
+        value = floatValue != 0.0;
+        return {};
+      }
+      // ConvertTo<bool> treats every other string as true
+      value = true;
+      return {};
+    }
+    else if constexpr(std::is_integral_v<T>)
+    {
+      if constexpr(std::is_unsigned_v<T>)
+      {
+        if(token.front() == '-')
+        {
+          return std::errc::result_out_of_range;
+        }
+      }
+      return std::from_chars(token.data(), token.data() + token.size(), value).ec;
+    }
+    else
+    {
+      static_assert(std::is_floating_point_v<T>, "TextTokenizer::FromChars requires an arithmetic type");
+#if defined(__cpp_lib_to_chars)
+      return std::from_chars(token.data(), token.data() + token.size(), value).ec;
+#else
+      // The standard library does not implement std::from_chars for floating point types
+      const std::string input(token);
+      char* end = nullptr;
+      errno = 0;
+      T result = 0;
+      if constexpr(std::is_same_v<T, float32>)
+      {
+        result = std::strtof(input.c_str(), &end);
+      }
+      else
+      {
+        result = static_cast<T>(std::strtod(input.c_str(), &end));
+      }
+      if(end == input.c_str())
+      {
+        return std::errc::invalid_argument;
+      }
+      if(errno == ERANGE)
+      {
+        return std::errc::result_out_of_range;
+      }
+      value = result;
+      return {};
+#endif
+    }
+  }
+
+  /**
+   * @brief Converts the token into T. The error codes and messages follow ConvertTo<T>.
+   * @param token
+   * @return Result<T>
+   */
+  template <typename T>
+  static Result<T> Convert(std::string_view token)
+  {
+    T value = {};
+    const std::errc errorCode = FromChars(token, value);
+    if(errorCode == std::errc::result_out_of_range)
+    {
+      return MakeErrorResult<T>(k_OutOfRange, fmt::format("Overflow error trying to convert '{}' to type '{}' using function 'std::from_chars'", token, DataTypeToString(GetDataType<T>()).str()));
+    }
+    if(errorCode != std::errc{})
+    {
+      return MakeErrorResult<T>(k_InvalidToken, fmt::format("Error trying to convert '{}' to type '{}' using function 'std::from_chars'", token, DataTypeToString(GetDataType<T>()).str()));
+    }
+    return {value};
+  }
+
+private:
+  /**
+   * @brief A run of whole lines. begin is the offset of the first line and end is the
+   * offset of the first line of the next block.
+   */
+  struct LineBlock
+  {
+    usize begin = 0;
+    usize end = 0;
+    usize firstLine = 0;
+  };
+
+  TextTokenizer(std::unique_ptr<MemoryMappedFile> file, bool parallelizationEnabled);
+
+  /**
+   * @brief Aligns the blocks to line starts and counts the lines in each block.
+   */
+  void findLines();
+
+  std::string_view text() const;
+
+  std::unique_ptr<MemoryMappedFile> m_File;
+  std::vector<LineBlock> m_Blocks;
+  usize m_NumLines = 0;
+  bool m_ParallelizationEnabled = true;
+};
+} // namespace complex
@@ -7,23 +7,190 @@
 #include "complex/Utilities/ParallelAlgorithmUtilities.hpp"
 #include "complex/Utilities/ParallelDataAlgorithm.hpp"
 #include "complex/Utilities/StringUtilities.hpp"
+#include "complex/Utilities/TriangleBVH.hpp"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
+#include <random>
 
 using namespace complex;
 
 namespace
 {
+/**
+ * @brief Buckets the sampling points into a uniform grid so that the points
+ * inside a feature's bounding box can be found without visiting every point.
+ */
+class SamplePointBins
+{
+public:
+  // Average number of points per bin
+  static constexpr usize k_PointsPerBin = 16;
+  static constexpr usize k_MaxBinsPerAxis = 1024;
+
+  explicit SamplePointBins(const std::vector<Point3Df>& points)
+  : m_Min(0.0f, 0.0f, 0.0f)
+  {
+    if(points.empty())
+    {
+      m_Offsets = {0, 0};
+      return;
+    }
+
+    Point3Df max = points[0];
+    m_Min = points[0];
+    for(const auto& point : points)
+    {
+      for(usize axis = 0; axis < 3; axis++)
+      {
+        m_Min[axis] = std::min(m_Min[axis], point[axis]);
+        max[axis] = std::max(max[axis], point[axis]);
+      }
+    }
+
+    // Pick a cubic bin size so that the bins hold k_PointsPerBin points on average. Flat axes get a single bin.
+    const usize targetBins = std::max<usize>(points.size() / k_PointsPerBin, 1);
+    float64 volume = 1.0;
+    int32 nonFlatAxes = 0;
+    for(usize axis = 0; axis < 3; axis++)
+    {
+      const float64 extent = max[axis] - m_Min[axis];
+      if(extent > 0.0)
+      {
+        volume *= extent;
+        nonFlatAxes++;
+      }
+    }
+    const float64 binSize = nonFlatAxes > 0 ? std::pow(volume / static_cast<float64>(targetBins), 1.0 / nonFlatAxes) : 1.0;
+    for(usize axis = 0; axis < 3; axis++)
+    {
+      const float64 extent = max[axis] - m_Min[axis];
+      m_Dims[axis] = extent > 0.0 ? std::clamp<usize>(static_cast<usize>(std::ceil(extent / binSize)), 1, k_MaxBinsPerAxis) : 1;
+      m_InvBinSize[axis] = extent > 0.0 ? static_cast<float32>(m_Dims[axis] / extent) : 0.0f;
+    }
+
+    // Counting sort of the point indices by bin
+    const usize numBins = m_Dims[0] * m_Dims[1] * m_Dims[2];
+    std::vector<usize> pointBins(points.size());
+    m_Offsets.assign(numBins + 1, 0);
+    for(usize i = 0; i < points.size(); i++)
+    {
+      const usize bin = (binIndex(points[i][2], 2) * m_Dims[1] + binIndex(points[i][1], 1)) * m_Dims[0] + binIndex(points[i][0], 0);
+      pointBins[i] = bin;
+      m_Offsets[bin + 1]++;
+    }
+    for(usize bin = 0; bin < numBins; bin++)
+    {
+      m_Offsets[bin + 1] += m_Offsets[bin];
+    }
+    m_PointIndices.resize(points.size());
+    std::vector<usize> insertPositions(m_Offsets.begin(), m_Offsets.end() - 1);
+    for(usize i = 0; i < points.size(); i++)
+    {
+      m_PointIndices[insertPositions[pointBins[i]]++] = i;
+    }
+  }
+
+  /**
+   * @brief Returns the indices of all points in bins overlapping the box.
+   * Points near the edge of the box may lie outside of it.
+   * @param box
+   * @return std::vector<usize>
+   */
+  std::vector<usize> findCandidates(const BoundingBox3Df& box) const
+  {
+    std::vector<usize> candidates;
+    if(m_PointIndices.empty())
+    {
+      return candidates;
+    }
+    std::array<usize, 3> lower = {0, 0, 0};
+    std::array<usize, 3> upper = {0, 0, 0};
+    for(usize axis = 0; axis < 3; axis++)
+    {
+      if(box.getMaxPoint()[axis] < m_Min[axis])
+      {
+        return candidates;
+      }
+      lower[axis] = binIndex(box.getMinPoint()[axis], axis);
+      upper[axis] = binIndex(box.getMaxPoint()[axis], axis);
+    }
+    for(usize z = lower[2]; z <= upper[2]; z++)
+    {
+      for(usize y = lower[1]; y <= upper[1]; y++)
+      {
+        const usize rowStart = (z * m_Dims[1] + y) * m_Dims[0];
+        candidates.insert(candidates.end(), m_PointIndices.begin() + m_Offsets[rowStart + lower[0]], m_PointIndices.begin() + m_Offsets[rowStart + upper[0] + 1]);
+      }
+    }
+    return candidates;
+  }
+
+private:
+  usize binIndex(float32 value, usize axis) const
+  {
+    const float32 position = (value - m_Min[axis]) * m_InvBinSize[axis];
+    if(!(position > 0.0f))
+    {
+      return 0;
+    }
+    return std::min(static_cast<usize>(position), m_Dims[axis] - 1);
+  }
+
+  Point3Df m_Min;
+  std::array<float32, 3> m_InvBinSize = {0.0f, 0.0f, 0.0f};
+  std::array<usize, 3> m_Dims = {1, 1, 1};
+  std::vector<usize> m_Offsets;
+  std::vector<usize> m_PointIndices;
+};
+
+/**
+ * @brief Classifies the candidate points of a single feature against the
+ * feature's TriangleBVH and stores the feature id for points that are inside
+ * or on the boundary.
+ */
+void SampleFeaturePoints(const TriangleGeom& faces, const TriangleBVH& bvh, const std::vector<BoundingBox3Df>& faceBBs, const std::vector<Point3Df>& points, const std::vector<usize>& candidates,
+                         usize start, usize end, int32 featureId, Int32Array& polyIds, const std::atomic_bool& shouldCancel)
+{
+  const BoundingBox3Df& boundingBox = bvh.getBounds();
+  const float32 radius = GeometryMath::FindDistanceBetweenPoints(boundingBox.getMinPoint(), boundingBox.getMaxPoint());
+
+  std::random_device randomDevice;
+  std::mt19937_64 generator(randomDevice());
+
+  for(usize i = start; i < end; i++)
+  {
+    // Check for the filter being cancelled.
+    if(shouldCancel)
+    {
+      return;
+    }
+
+    const usize pointIndex = candidates[i];
+    if(polyIds[pointIndex] == 0)
+    {
+      char code = GeometryMath::IsPointInPolyhedron(faces, bvh, faceBBs, points[pointIndex], boundingBox, radius, generator);
+      if(code == 'i' || code == 'V' || code == 'E' || code == 'F')
+      {
+        polyIds[pointIndex] = featureId;
+      }
+    }
+  }
+}
+
 class SampleSurfaceMeshImpl
 {
 public:
   SampleSurfaceMeshImpl(SampleSurfaceMesh* filter, const TriangleGeom& faces, const std::vector<std::vector<int32>>& faceIds, const std::vector<BoundingBox3Df>& faceBBs,
-                        const std::vector<Point3Df>& points, Int32Array& polyIds, const std::atomic_bool& shouldCancel)
+                        const std::vector<Point3Df>& points, const SamplePointBins& pointBins, Int32Array& polyIds, const std::atomic_bool& shouldCancel)
   : m_Filter(filter)
   , m_Faces(faces)
   , m_FaceIds(faceIds)
   , m_FaceBBs(faceBBs)
   , m_Points(points)
+  , m_PointBins(pointBins)
   , m_PolyIds(polyIds)
   , m_ShouldCancel(shouldCancel)
   {
@@ -40,32 +207,20 @@ public:
   {
     for(usize iter = start; iter < end; iter++)
     {
-      float32 radius = 0.0f;
-      usize numPoints = m_Points.size();
-
-      // find bounding box for current feature
-      BoundingBox3Df boundingBox(GeometryMath::FindBoundingBoxOfFaces(m_Faces, m_FaceIds[iter]));
-      radius = GeometryMath::FindDistanceBetweenPoints(boundingBox.getMinPoint(), boundingBox.getMaxPoint());
+      // Check for the filter being cancelled.
+      if(m_ShouldCancel)
+      {
+        return;
+      }
 
-      // check points in vertex array to see if they are in the bounding box of the feature
-      for(usize i = 0; i < numPoints; i++)
+      // Only the points in the bounding box of the current feature can be inside of it
+      const TriangleBVH bvh(m_FaceIds[iter], m_FaceBBs);
+      if(bvh.empty())
       {
-        // Check for the filter being cancelled.
-        if(m_ShouldCancel)
-        {
-          return;
-        }
-
-        Point3Df point = m_Points[i];
-        if(m_PolyIds[i] == 0)
-        {
-          char code = GeometryMath::IsPointInPolyhedron(m_Faces, m_FaceIds[iter], m_FaceBBs, point, boundingBox, radius);
-          if(code == 'i' || code == 'V' || code == 'E' || code == 'F')
-          {
-            m_PolyIds[i] = iter;
-          }
-        }
+        continue;
       }
+      const std::vector<usize> candidates = m_PointBins.findCandidates(bvh.getBounds());
+      SampleFeaturePoints(m_Faces, bvh, m_FaceBBs, m_Points, candidates, 0, candidates.size(), static_cast<int32>(iter), m_PolyIds, m_ShouldCancel);
     }
   }
 
@@ -80,6 +235,7 @@ private:
   const std::vector<std::vector<int32>>& m_FaceIds;
   const std::vector<BoundingBox3Df>& m_FaceBBs;
   const std::vector<Point3Df>& m_Points;
+  const SamplePointBins& m_PointBins;
   Int32Array& m_PolyIds;
   const std::atomic_bool& m_ShouldCancel;
 };
@@ -88,13 +244,14 @@ private:
 class SampleSurfaceMeshImplByPoints
 {
 public:
-  SampleSurfaceMeshImplByPoints(SampleSurfaceMesh* filter, const TriangleGeom& faces, const std::vector<int32>& faceIds, const std::vector<BoundingBox3Df>& faceBBs,
-                                const std::vector<Point3Df>& points, const usize featureId, Int32Array& polyIds, const std::atomic_bool& shouldCancel)
+  SampleSurfaceMeshImplByPoints(SampleSurfaceMesh* filter, const TriangleGeom& faces, const TriangleBVH& bvh, const std::vector<BoundingBox3Df>& faceBBs, const std::vector<Point3Df>& points,
+                                const std::vector<usize>& candidates, const usize featureId, Int32Array& polyIds, const std::atomic_bool& shouldCancel)
   : m_Filter(filter)
   , m_Faces(faces)
-  , m_FaceIds(faceIds)
+  , m_Bvh(bvh)
   , m_FaceBBs(faceBBs)
   , m_Points(points)
+  , m_Candidates(candidates)
   , m_FeatureId(featureId)
   , m_PolyIds(polyIds)
   , m_ShouldCancel(shouldCancel)
@@ -104,31 +261,17 @@ public:
 
   void checkPoints(usize start, usize end) const
   {
-    usize iter = m_FeatureId;
-
-    // find bounding box for current feature
-    BoundingBox3Df boundingBox(GeometryMath::FindBoundingBoxOfFaces(m_Faces, m_FaceIds));
-    float32 radius = GeometryMath::FindDistanceBetweenPoints(boundingBox.getMinPoint(), boundingBox.getMaxPoint());
-
-    usize pointsVisited = 0;
-    // check points in vertex array to see if they are in the bounding box of the feature
-    for(usize i = start; i < end; i++)
+    // Classify the points in blocks so progress can be reported in between
+    constexpr usize k_ProgressInterval = 1000;
+    for(usize blockStart = start; blockStart < end; blockStart += k_ProgressInterval)
     {
-      Point3Df point = m_Points[i];
-      if(m_PolyIds[i] == 0)
-      {
-        char code = GeometryMath::IsPointInPolyhedron(m_Faces, m_FaceIds, m_FaceBBs, point, boundingBox, radius);
-        if(code == 'i' || code == 'V' || code == 'E' || code == 'F')
-        {
-          m_PolyIds[i] = iter;
-        }
-      }
-      pointsVisited++;
+      const usize blockEnd = std::min(blockStart + k_ProgressInterval, end);
+      SampleFeaturePoints(m_Faces, m_Bvh, m_FaceBBs, m_Points, m_Candidates, blockStart, blockEnd, static_cast<int32>(m_FeatureId), m_PolyIds, m_ShouldCancel);
 
       // Send some feedback
-      if(pointsVisited % 1000 == 0)
+      if(blockEnd - blockStart == k_ProgressInterval)
       {
-        m_Filter->sendThreadSafeProgressMessage(m_FeatureId, 1000, m_Points.size());
+        m_Filter->sendThreadSafeProgressMessage(m_FeatureId, k_ProgressInterval, m_Candidates.size());
       }
       // Check for the filter being cancelled.
       if(m_ShouldCancel)
@@ -146,11 +289,12 @@ public:
 private:
   SampleSurfaceMesh* m_Filter = nullptr;
   const TriangleGeom& m_Faces;
-  const std::vector<int32>& m_FaceIds;
+  const TriangleBVH& m_Bvh;
   const std::vector<BoundingBox3Df>& m_FaceBBs;
   const std::vector<Point3Df>& m_Points;
-  Int32Array& m_PolyIds;
+  const std::vector<usize>& m_Candidates;
   const usize m_FeatureId = 0;
+  Int32Array& m_PolyIds;
   const std::atomic_bool& m_ShouldCancel;
 };
 } // namespace
@@ -277,19 +421,28 @@ Result<> SampleSurfaceMesh::execute(SampleSurfaceMeshInputValues& inputValues)
   auto nthreads = static_cast<int32>(std::thread::hardware_concurrency()); // Returns ZERO if not defined on this platform
   // If the number of features is larger than the number of cores to do the work then parallelize over the number of features
   // otherwise parallelize over the number of triangle points.
+  // Each feature only tests the points in its bounding box and each ray only tests the faces in the
+  // BVH nodes it passes through, instead of every point against every face of every feature.
+  const SamplePointBins pointBins(points);
   if(numFeatures > nthreads)
   {
     ParallelDataAlgorithm dataAlg;
     dataAlg.setRange(0, numFeatures);
-    dataAlg.execute(SampleSurfaceMeshImpl(this, triangleGeom, faceLists, faceBBs, points, polyIds, m_ShouldCancel));
+    dataAlg.execute(SampleSurfaceMeshImpl(this, triangleGeom, faceLists, faceBBs, points, pointBins, polyIds, m_ShouldCancel));
   }
   else
   {
     for(int32 featureId = 0; featureId < numFeatures; featureId++)
     {
+      const TriangleBVH bvh(faceLists[featureId], faceBBs);
+      if(bvh.empty())
+      {
+        continue;
+      }
+      const std::vector<usize> candidates = pointBins.findCandidates(bvh.getBounds());
       ParallelDataAlgorithm dataAlg;
-      dataAlg.setRange(0, points.size());
-      dataAlg.execute(SampleSurfaceMeshImplByPoints(this, triangleGeom, faceLists[featureId], faceBBs, points, featureId, polyIds, m_ShouldCancel));
+      dataAlg.setRange(0, candidates.size());
+      dataAlg.execute(SampleSurfaceMeshImplByPoints(this, triangleGeom, bvh, faceBBs, points, candidates, featureId, polyIds, m_ShouldCancel));
     }
   }
 
@@ -125,6 +125,7 @@ Result<> SegmentFeatures::execute(IGridGeometry* gridGeom)
   return {};
 }
 
+// -----------------------------------------------------------------------------
 int64 SegmentFeatures::getSeed(int32 gnum, int64 nextSeed) const
 {
   return -1;
@@ -2,19 +2,23 @@
 
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataStructure.hpp"
+#include "complex/DataStructure/Geometry/IGridGeometry.hpp"
 #include "complex/DataStructure/IDataArray.hpp"
 #include "complex/Filter/Arguments.hpp"
 #include "complex/Filter/IFilter.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 #include "complex/complex_export.hpp"
 
+#include <algorithm>
+#include <array>
+#include <limits>
 #include <random>
+#include <utility>
 #include <vector>
 
 namespace complex
 {
 
-class IGridGeometry;
-
 class COMPLEX_EXPORT SegmentFeatures
 {
 
@@ -38,6 +42,42 @@ public:
    */
   Result<> execute(IGridGeometry* gridGeom);
 
+  /**
+   * @brief Segments the grid using a block wise union-find instead of the serial flood fill
+   * performed by execute(). Blocks of rows are labeled in parallel and the groupings across
+   * block borders are merged afterwards. The grouping functor is called directly and must provide:
+   *
+   *   bool isValid(int64 point) const; // true if the voxel may belong to a feature (seed criteria)
+   *   bool areGrouped(int64 referencePoint, int64 neighborPoint) const; // true if two valid neighbors belong together
+   *
+   * Both methods are called concurrently, must not modify any data and areGrouped() must be symmetric.
+   * Features are numbered in order of their lowest voxel index, which matches the numbering of the
+   * serial flood fill for the same criteria. Voxels that are not valid are set to 0.
+   *
+   * Callers are expected to check that the arrays read by the functor are held in memory.
+   * @param gridGeom
+   * @param featureIds
+   * @param grouping
+   * @return Result<int32> Number of features found, not counting feature 0
+   */
+  template <class GroupingFunctor>
+  Result<int32> executeParallel(IGridGeometry* gridGeom, AbstractDataStore<int32>& featureIds, const GroupingFunctor& grouping)
+  {
+    const SizeVec3 udims = gridGeom->getDimensions();
+    const usize totalPoints = udims[0] * udims[1] * udims[2];
+    if(totalPoints == 0)
+    {
+      return {0};
+    }
+
+    // The union-find parents hold one index per voxel, so use 4 byte indices whenever every voxel index fits
+    if(totalPoints <= static_cast<usize>(std::numeric_limits<int32>::max()))
+    {
+      return labelParallel<int32>(udims, featureIds, grouping);
+    }
+    return labelParallel<int64>(udims, featureIds, grouping);
+  }
+
   /**
    * @brief Returns the seed for the specified values.
    * @param data
@@ -94,11 +134,173 @@ public:
   };
 
 protected:
+  /**
+   * @brief Returns the root of the set containing the specified point and halves the path to it.
+   * @param parents
+   * @param point
+   * @return IndexType
+   */
+  template <class IndexType>
+  static IndexType FindRoot(std::vector<IndexType>& parents, IndexType point)
+  {
+    while(parents[point] != point)
+    {
+      parents[point] = parents[parents[point]];
+      point = parents[point];
+    }
+    return point;
+  }
+
+  /**
+   * @brief Merges the sets containing both points. The lowest index always becomes the root.
+   * @param parents
+   * @param first
+   * @param second
+   */
+  template <class IndexType>
+  static void UniteRoots(std::vector<IndexType>& parents, IndexType first, IndexType second)
+  {
+    const IndexType firstRoot = FindRoot(parents, first);
+    const IndexType secondRoot = FindRoot(parents, second);
+    if(firstRoot < secondRoot)
+    {
+      parents[secondRoot] = firstRoot;
+    }
+    else if(secondRoot < firstRoot)
+    {
+      parents[firstRoot] = secondRoot;
+    }
+  }
+
+  /**
+   * @brief Assigns consecutive feature ids, starting at 1, in order of each set's root index.
+   * Points without a set (-1) are assigned 0. Returns the number of features.
+   * @param parents
+   * @param featureIds
+   * @return int32
+   */
+  template <class IndexType>
+  static int32 LabelRoots(std::vector<IndexType>& parents, AbstractDataStore<int32>& featureIds)
+  {
+    // Every root is the lowest index of its set, so it is always labeled before any other member.
+    int32 featureCount = 0;
+    const auto totalPoints = static_cast<IndexType>(parents.size());
+    for(IndexType point = 0; point < totalPoints; point++)
+    {
+      if(parents[point] < 0)
+      {
+        featureIds.setValue(point, 0);
+      }
+      else if(parents[point] == point)
+      {
+        featureCount++;
+        featureIds.setValue(point, featureCount);
+      }
+      else
+      {
+        featureIds.setValue(point, featureIds.getValue(FindRoot(parents, point)));
+      }
+    }
+    return featureCount;
+  }
+
   DataStructure& m_DataStructure;
   const std::atomic_bool& m_ShouldCancel;
   const IFilter::MessageHandler& m_MessageHandler;
 
 private:
+  /**
+   * @brief Runs the parallel labeling of executeParallel() with union-find parents of IndexType,
+   * which must be able to hold every voxel index of the grid.
+   * @param udims
+   * @param featureIds
+   * @param grouping
+   * @return Result<int32> Number of features found, not counting feature 0
+   */
+  template <class IndexType, class GroupingFunctor>
+  Result<int32> labelParallel(const SizeVec3& udims, AbstractDataStore<int32>& featureIds, const GroupingFunctor& grouping)
+  {
+    const int64 dimX = static_cast<int64>(udims[0]);
+    const int64 dimY = static_cast<int64>(udims[1]);
+    const int64 dimZ = static_cast<int64>(udims[2]);
+    const int64 sliceSize = dimX * dimY;
+    const int64 totalPoints = sliceSize * dimZ;
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setParallelizationEnabled(true);
+
+    // Split the grid into blocks of whole rows so that 2D grids are partitioned as well
+    const int64 totalRows = dimY * dimZ;
+    const int64 targetBlockCount = static_cast<int64>(dataAlg.getMaxThreads()) * 8;
+    const int64 rowsPerBlock = std::max<int64>(1, (totalRows + targetBlockCount - 1) / targetBlockCount);
+    const int64 blockCount = (totalRows + rowsPerBlock - 1) / rowsPerBlock;
+
+    std::vector<IndexType> parents(static_cast<usize>(totalPoints), -1);
+    std::vector<std::vector<std::pair<IndexType, IndexType>>> borderGroupings(static_cast<usize>(blockCount));
+
+    dataAlg.setRange(0, static_cast<usize>(blockCount));
+    dataAlg.execute([&](const Range& range) {
+      for(usize block = range.min(); block < range.max(); block++)
+      {
+        if(m_ShouldCancel)
+        {
+          return;
+        }
+        const int64 blockStart = static_cast<int64>(block) * rowsPerBlock * dimX;
+        const int64 blockEnd = std::min(totalPoints, blockStart + rowsPerBlock * dimX);
+        auto& borderPairs = borderGroupings[block];
+        for(int64 point = blockStart; point < blockEnd; point++)
+        {
+          if(!grouping.isValid(point))
+          {
+            continue;
+          }
+          parents[point] = static_cast<IndexType>(point);
+
+          // Only the -X, -Y and -Z neighbors are checked so that each face is evaluated once
+          const int64 col = point % dimX;
+          const int64 row = (point / dimX) % dimY;
+          const int64 plane = point / sliceSize;
+          const std::array<int64, 3> neighbors = {col > 0 ? point - 1 : -1, row > 0 ? point - dimX : -1, plane > 0 ? point - sliceSize : -1};
+          for(const int64 neighbor : neighbors)
+          {
+            if(neighbor < 0)
+            {
+              continue;
+            }
+            if(neighbor < blockStart)
+            {
+              // Neighbors in other blocks are merged after all blocks are finished
+              if(grouping.isValid(neighbor) && grouping.areGrouped(neighbor, point))
+              {
+                borderPairs.emplace_back(static_cast<IndexType>(neighbor), static_cast<IndexType>(point));
+              }
+            }
+            else if(parents[neighbor] >= 0 && grouping.areGrouped(neighbor, point))
+            {
+              UniteRoots(parents, static_cast<IndexType>(neighbor), static_cast<IndexType>(point));
+            }
+          }
+        }
+      }
+    });
+    if(m_ShouldCancel)
+    {
+      return {0};
+    }
+
+    for(const auto& borderPairs : borderGroupings)
+    {
+      for(const auto& [first, second] : borderPairs)
+      {
+        UniteRoots(parents, first, second);
+      }
+    }
+
+    const int32 featureCount = LabelRoots(parents, featureIds);
+    m_MessageHandler({IFilter::Message::Type::Info, fmt::format("Total Features Found: {}", featureCount)});
+    return {featureCount};
+  }
 };
 
 } // namespace complex
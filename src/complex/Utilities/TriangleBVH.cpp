@@ -0,0 +1,150 @@
+#include "TriangleBVH.hpp"
+
+#include <algorithm>
+#include <limits>
+
+using namespace complex;
+
+namespace
+{
+struct BuildTask
+{
+  int32 nodeIndex;
+  int32 first;
+  int32 count;
+};
+
+BoundingBox3Df EmptyBounds()
+{
+  constexpr float32 k_Max = std::numeric_limits<float32>::max();
+  return {Point3Df(k_Max, k_Max, k_Max), Point3Df(-k_Max, -k_Max, -k_Max)};
+}
+
+void ExpandBounds(BoundingBox3Df& bounds, const Point3Df& minPoint, const Point3Df& maxPoint)
+{
+  const Point3Df& currentMin = bounds.getMinPoint();
+  const Point3Df& currentMax = bounds.getMaxPoint();
+  bounds.setMinPoint({std::min(currentMin[0], minPoint[0]), std::min(currentMin[1], minPoint[1]), std::min(currentMin[2], minPoint[2])});
+  bounds.setMaxPoint({std::max(currentMax[0], maxPoint[0]), std::max(currentMax[1], maxPoint[1]), std::max(currentMax[2], maxPoint[2])});
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+TriangleBVH::TriangleBVH(nonstd::span<const int32> faceIds, const std::vector<BoundingBox3Df>& faceBounds)
+: m_FaceIds(faceIds.begin(), faceIds.end())
+{
+  if(m_FaceIds.empty())
+  {
+    return;
+  }
+
+  std::vector<Point3Df> centroids(m_FaceIds.size());
+  for(usize i = 0; i < m_FaceIds.size(); i++)
+  {
+    const BoundingBox3Df& faceBox = faceBounds[m_FaceIds[i]];
+    centroids[i] = (faceBox.getMinPoint() + faceBox.getMaxPoint()) * 0.5f;
+  }
+  // Sort an index list so the face ids and centroids stay paired while partitioning
+  std::vector<int32> order(m_FaceIds.size());
+  for(usize i = 0; i < order.size(); i++)
+  {
+    order[i] = static_cast<int32>(i);
+  }
+
+  // A median split produces at most 2 * n / k_MaxLeafSize nodes
+  m_Nodes.reserve(2 * (m_FaceIds.size() / k_MaxLeafSize + 1));
+  m_Nodes.push_back({EmptyBounds(), 0, 0});
+
+  std::vector<BuildTask> tasks = {{0, 0, static_cast<int32>(order.size())}};
+  while(!tasks.empty())
+  {
+    const BuildTask task = tasks.back();
+    tasks.pop_back();
+
+    BoundingBox3Df bounds = EmptyBounds();
+    BoundingBox3Df centroidBounds = EmptyBounds();
+    for(int32 i = task.first; i < task.first + task.count; i++)
+    {
+      const BoundingBox3Df& faceBox = faceBounds[m_FaceIds[order[i]]];
+      ExpandBounds(bounds, faceBox.getMinPoint(), faceBox.getMaxPoint());
+      const Point3Df& centroid = centroids[order[i]];
+      ExpandBounds(centroidBounds, centroid, centroid);
+    }
+    m_Nodes[task.nodeIndex].bounds = bounds;
+
+    if(task.count <= static_cast<int32>(k_MaxLeafSize))
+    {
+      m_Nodes[task.nodeIndex].first = task.first;
+      m_Nodes[task.nodeIndex].count = task.count;
+      continue;
+    }
+
+    // Split at the median centroid along the longest axis of the centroid bounds
+    const Point3Df extent = centroidBounds.getMaxPoint() - centroidBounds.getMinPoint();
+    usize axis = 0;
+    if(extent[1] > extent[axis])
+    {
+      axis = 1;
+    }
+    if(extent[2] > extent[axis])
+    {
+      axis = 2;
+    }
+    const int32 half = task.count / 2;
+    std::nth_element(order.begin() + task.first, order.begin() + task.first + half, order.begin() + task.first + task.count,
+                     [&centroids, axis](int32 lhs, int32 rhs) { return centroids[lhs][axis] < centroids[rhs][axis]; });
+
+    const auto childIndex = static_cast<int32>(m_Nodes.size());
+    m_Nodes[task.nodeIndex].first = childIndex;
+    m_Nodes[task.nodeIndex].count = 0;
+    m_Nodes.push_back({EmptyBounds(), 0, 0});
+    m_Nodes.push_back({EmptyBounds(), 0, 0});
+    tasks.push_back({childIndex, task.first, half});
+    tasks.push_back({childIndex + 1, task.first + half, task.count - half});
+  }
+
+  std::vector<int32> orderedFaceIds(m_FaceIds.size());
+  for(usize i = 0; i < order.size(); i++)
+  {
+    orderedFaceIds[i] = m_FaceIds[order[i]];
+  }
+  m_FaceIds = std::move(orderedFaceIds);
+}
+
+// -----------------------------------------------------------------------------
+bool TriangleBVH::empty() const
+{
+  return m_Nodes.empty();
+}
+
+// -----------------------------------------------------------------------------
+const BoundingBox3Df& TriangleBVH::getBounds() const
+{
+  return m_Nodes.front().bounds;
+}
+
+// -----------------------------------------------------------------------------
+const std::vector<TriangleBVH::Node>& TriangleBVH::getNodes() const
+{
+  return m_Nodes;
+}
+
+// -----------------------------------------------------------------------------
+const std::vector<int32>& TriangleBVH::getFaceIds() const
+{
+  return m_FaceIds;
+}
+
+// -----------------------------------------------------------------------------
+float32 TriangleBVH::DistanceSquared(const BoundingBox3Df& bounds, const Point3Df& point)
+{
+  const Point3Df& minPoint = bounds.getMinPoint();
+  const Point3Df& maxPoint = bounds.getMaxPoint();
+  float32 distanceSquared = 0.0f;
+  for(usize i = 0; i < 3; i++)
+  {
+    const float32 delta = std::max({minPoint[i] - point[i], 0.0f, point[i] - maxPoint[i]});
+    distanceSquared += delta * delta;
+  }
+  return distanceSquared;
+}
@@ -0,0 +1,209 @@
+#pragma once
+
+#include "complex/Common/BoundingBox.hpp"
+#include "complex/Common/Types.hpp"
+#include "complex/complex_export.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace complex
+{
+/**
+ * @class TriangleBVH
+ * @brief The TriangleBVH class is a bounding volume hierarchy over a set of
+ * triangle faces. Each node stores the bounding box of the faces below it so
+ * queries only visit faces whose bounding box can satisfy the query. The tree
+ * is built once from the bounding box of each face and is read-only afterwards,
+ * so it can be queried from multiple threads at the same time. Share a single
+ * instance by reference between threads instead of copying it.
+ */
+class COMPLEX_EXPORT TriangleBVH
+{
+public:
+  /**
+   * @brief Maximum number of faces stored in a leaf node.
+   */
+  static constexpr usize k_MaxLeafSize = 4;
+
+  struct Node
+  {
+    BoundingBox3Df bounds;
+    // Leaf nodes reference faces [first, first + count) in the face list.
+    // Interior nodes have a count of 0 and their children are at first and first + 1.
+    int32 first = 0;
+    int32 count = 0;
+  };
+
+  /**
+   * @brief Builds the hierarchy over the given faces. faceBounds is indexed by
+   * face id and must contain an entry for every face in faceIds.
+   * @param faceIds
+   * @param faceBounds
+   */
+  TriangleBVH(nonstd::span<const int32> faceIds, const std::vector<BoundingBox3Df>& faceBounds);
+
+  ~TriangleBVH() noexcept = default;
+
+  TriangleBVH(const TriangleBVH&) = default;
+  TriangleBVH(TriangleBVH&&) noexcept = default;
+  TriangleBVH& operator=(const TriangleBVH&) = default;
+  TriangleBVH& operator=(TriangleBVH&&) noexcept = default;
+
+  /**
+   * @brief Returns true if the hierarchy contains no faces.
+   * @return bool
+   */
+  bool empty() const;
+
+  /**
+   * @brief Returns the bounding box of all faces. Must not be called on an empty hierarchy.
+   * @return const BoundingBox3Df&
+   */
+  const BoundingBox3Df& getBounds() const;
+
+  /**
+   * @brief Returns the nodes of the hierarchy. The root node is at index 0.
+   * @return const std::vector<Node>&
+   */
+  const std::vector<Node>& getNodes() const;
+
+  /**
+   * @brief Returns the face ids in leaf order.
+   * @return const std::vector<int32>&
+   */
+  const std::vector<int32>& getFaceIds() const;
+
+  /**
+   * @brief Visits the hierarchy depth first. Nodes for which visitNode returns
+   * false are skipped together with everything below them. visitFace is called
+   * with the id of every face in the remaining leaves and stops the traversal
+   * when it returns false.
+   * @param visitNode bool(const BoundingBox3Df&)
+   * @param visitFace bool(int32)
+   * @return bool False if the traversal was stopped by visitFace
+   */
+  template <typename NodePredicate, typename FaceFunc>
+  bool visit(NodePredicate&& visitNode, FaceFunc&& visitFace) const
+  {
+    if(m_Nodes.empty())
+    {
+      return true;
+    }
+
+    int32 stack[64];
+    usize stackSize = 0;
+    stack[stackSize++] = 0;
+    while(stackSize > 0)
+    {
+      const Node& node = m_Nodes[stack[--stackSize]];
+      if(!visitNode(node.bounds))
+      {
+        continue;
+      }
+      if(node.count > 0)
+      {
+        for(int32 i = node.first; i < node.first + node.count; i++)
+        {
+          if(!visitFace(m_FaceIds[i]))
+          {
+            return false;
+          }
+        }
+        continue;
+      }
+      stack[stackSize++] = node.first + 1;
+      stack[stackSize++] = node.first;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Finds the face closest to point. faceDistanceSquared returns the squared
+   * distance from point to the face with the given id. The traversal visits the
+   * nearer child of each node first and skips every node whose bounding box is
+   * farther away than the closest face found so far, so only the faces near the
+   * point are measured. Ties go to the lowest face id.
+   * @param point
+   * @param faceDistanceSquared float32(int32)
+   * @param distanceSquared Receives the squared distance to the closest face
+   * @return int32 Id of the closest face or -1 if the hierarchy is empty
+   */
+  template <typename FaceDistanceFunc>
+  int32 findNearest(const Point3Df& point, FaceDistanceFunc&& faceDistanceSquared, float32& distanceSquared) const
+  {
+    int32 nearestFace = -1;
+    distanceSquared = std::numeric_limits<float32>::max();
+    if(m_Nodes.empty())
+    {
+      return nearestFace;
+    }
+
+    struct Entry
+    {
+      int32 nodeIndex;
+      float32 distanceSquared;
+    };
+    Entry stack[64];
+    usize stackSize = 0;
+    stack[stackSize++] = {0, DistanceSquared(m_Nodes[0].bounds, point)};
+    while(stackSize > 0)
+    {
+      const Entry entry = stack[--stackSize];
+      // Boxes at the same distance are still visited so ties can go to the lowest face id
+      if(entry.distanceSquared > distanceSquared)
+      {
+        continue;
+      }
+      const Node& node = m_Nodes[entry.nodeIndex];
+      if(node.count > 0)
+      {
+        for(int32 i = node.first; i < node.first + node.count; i++)
+        {
+          const int32 faceId = m_FaceIds[i];
+          const float32 faceDistance = faceDistanceSquared(faceId);
+          if(faceDistance < distanceSquared || (faceDistance == distanceSquared && (nearestFace < 0 || faceId < nearestFace)))
+          {
+            distanceSquared = faceDistance;
+            nearestFace = faceId;
+          }
+        }
+        continue;
+      }
+
+      Entry nearChild = {node.first, DistanceSquared(m_Nodes[node.first].bounds, point)};
+      Entry farChild = {node.first + 1, DistanceSquared(m_Nodes[node.first + 1].bounds, point)};
+      if(farChild.distanceSquared < nearChild.distanceSquared)
+      {
+        std::swap(nearChild, farChild);
+      }
+      // The near child is pushed last so it is searched first and tightens the bound for the far child
+      if(farChild.distanceSquared <= distanceSquared)
+      {
+        stack[stackSize++] = farChild;
+      }
+      if(nearChild.distanceSquared <= distanceSquared)
+      {
+        stack[stackSize++] = nearChild;
+      }
+    }
+    return nearestFace;
+  }
+
+  /**
+   * @brief Returns the squared distance from point to the closest point of the
+   * box. Points inside the box have a distance of 0.
+   * @param bounds
+   * @param point
+   * @return float32
+   */
+  static float32 DistanceSquared(const BoundingBox3Df& bounds, const Point3Df& point);
+
+private:
+  std::vector<Node> m_Nodes;
+  std::vector<int32> m_FaceIds;
+};
+} // namespace complex
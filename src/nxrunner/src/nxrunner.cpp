@@ -270,6 +270,16 @@ Result<> ExecutePipeline(Pipeline& pipeline)
   cliOut << "\n-------------------------";
   cliOut.endline();
 
+  // The command line never resumes from an intermediate filter so skip storing
+  // the per filter DataStructure snapshots and free or spill each array after
+  // its last use. Planning the releases needs the preflight results.
+  pipeline.setStoreNodeSnapshots(false);
+  pipeline.setReleaseUnusedData(true);
+  if(!pipeline.preflight())
+  {
+    std::string ss = "Error preflighting pipeline";
+    return complex::MakeErrorResult(k_ExecutePipelineError, ss);
+  }
   if(!pipeline.execute())
   {
     std::string ss = "Error executing pipeline";
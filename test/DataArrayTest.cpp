@@ -150,3 +150,25 @@ TEST_CASE("Copy DataStore", "DataArray")
     REQUIRE(dataStore[i] == dataStore2[i]);
   }
 }
+
+TEST_CASE("DataArray Release Values", "[complex][DataArray]")
+{
+  DataStructure dataStructure;
+  auto store = std::make_shared<DataStore<int32>>(IDataStore::ShapeType{4, 5}, IDataStore::ShapeType{3}, 7);
+  auto* dataArray = DataArray<int32>::Create(dataStructure, "Array", store);
+  REQUIRE(dataArray != nullptr);
+
+  // The copied DataStructure shares the values, so they stay readable there
+  DataStructure snapshot = dataStructure;
+  dataArray->releaseValues();
+  store.reset();
+
+  REQUIRE(dataArray->getStoreType() == IDataStore::StoreType::Empty);
+  REQUIRE(dataArray->getTupleShape() == IDataStore::ShapeType{4, 5});
+  REQUIRE(dataArray->getComponentShape() == IDataStore::ShapeType{3});
+  REQUIRE(dataArray->getSize() == 60);
+
+  const auto& snapshotArray = snapshot.getDataRefAs<DataArray<int32>>(DataPath({"Array"}));
+  REQUIRE(snapshotArray.getStoreType() == IDataStore::StoreType::InMemory);
+  REQUIRE(snapshotArray[59] == 7);
+}
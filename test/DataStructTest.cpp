@@ -1,6 +1,7 @@
 #include "DataStructObserver.hpp"
 
 #include "complex/Common/StringLiteral.hpp"
+#include "complex/Core/Application.hpp"
 #include "complex/DataStructure/DataArray.hpp"
 #include "complex/DataStructure/DataGroup.hpp"
 #include "complex/DataStructure/DataStore.hpp"
@@ -12,16 +13,21 @@
 #include "complex/DataStructure/Geometry/RectGridGeom.hpp"
 #include "complex/DataStructure/Geometry/TetrahedralGeom.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
+#include "complex/DataStructure/MmapDataStore.hpp"
 #include "complex/DataStructure/ScalarData.hpp"
 #include "complex/DataStructure/StringArray.hpp"
 #include "complex/UnitTest/UnitTestCommon.hpp"
 #include "complex/Utilities/DataArrayUtilities.hpp"
 #include "complex/Utilities/DataGroupUtilities.hpp"
+#include "complex/Utilities/ParallelData3DAlgorithm.hpp"
+#include "complex/Utilities/ParallelDataAlgorithm.hpp"
 #include "complex/unit_test/complex_test_dirs.hpp"
 
 #include <catch2/catch.hpp>
 
 #include <memory>
+#include <numeric>
+#include <utility>
 #include <vector>
 
 using namespace complex;
@@ -41,6 +47,24 @@ constexpr StringLiteral k_QuadGeo = "Quad Geometry";
 constexpr StringLiteral k_TetGeo = "Tet Geometry";
 constexpr StringLiteral k_SharedPolyhedrons = "SharedPolyhedronList";
 constexpr StringLiteral k_HexGeo = "Hex Geometry";
+
+// Reports its values as non-contiguous so the generic bulk access paths are exercised
+template <typename T>
+class NonContiguousDataStore : public DataStore<T>
+{
+public:
+  using DataStore<T>::DataStore;
+
+  const T* getContiguousValues(usize startIndex) const override
+  {
+    return nullptr;
+  }
+
+  T* getContiguousValues(usize startIndex) override
+  {
+    return nullptr;
+  }
+};
 } // namespace
 
 // This test will ensure we don't run into runtime exceptions trying to run the functions
@@ -634,6 +658,47 @@ TEST_CASE("LinkedPathTest")
   REQUIRE(!linkedPath.isValid());
 }
 
+TEST_CASE("DataStructurePathIndexTest")
+{
+  DataStructure dataStr;
+  auto group = DataGroup::Create(dataStr, "Foo");
+  auto child1 = DataGroup::Create(dataStr, "Bar1", group->getId());
+  auto child2 = DataGroup::Create(dataStr, "Bar2", group->getId());
+  auto grandchild = DataGroup::Create(dataStr, "Bazz", child1->getId());
+
+  const DataPath gcPath1({"Foo", "Bar1", "Bazz"});
+  const DataPath gcPath2({"Foo", "Bar2", "Bazz"});
+  const DataPath gcPath3({"Foo", "Bar3", "Bazz"});
+
+  // Repeated lookups resolve to the same object
+  REQUIRE(dataStr.getData(gcPath1) == grandchild);
+  REQUIRE(dataStr.getData(gcPath1) == grandchild);
+  REQUIRE(dataStr.getData(gcPath2) == nullptr);
+
+  // Renaming a parent changes every path below it
+  REQUIRE(child1->rename("Bar3"));
+  REQUIRE(dataStr.getData(gcPath1) == nullptr);
+  REQUIRE(dataStr.getData(gcPath3) == grandchild);
+
+  // Reparenting moves the object to the new path
+  REQUIRE(dataStr.setAdditionalParent(grandchild->getId(), child2->getId()));
+  REQUIRE(dataStr.removeParent(grandchild->getId(), child1->getId()));
+  REQUIRE(dataStr.getData(gcPath3) == nullptr);
+  REQUIRE(dataStr.getData(gcPath2) == grandchild);
+
+  // A new object with the name of a removed object is found at its path
+  REQUIRE(dataStr.removeData(gcPath2));
+  REQUIRE(dataStr.getData(gcPath2) == nullptr);
+  auto replacement = DataGroup::Create(dataStr, "Bazz", child2->getId());
+  REQUIRE(dataStr.getData(gcPath2) == replacement);
+
+  // Copies resolve paths to their own objects
+  DataStructure dataStrCopy(dataStr);
+  REQUIRE(dataStrCopy.getData(gcPath2) != nullptr);
+  REQUIRE(dataStrCopy.getData(gcPath2) != replacement);
+  REQUIRE(dataStrCopy.getData(gcPath2)->getId() == replacement->getId());
+}
+
 /**
  * @brief Tests IDataStructureListener usage
  */
@@ -750,6 +815,259 @@ TEST_CASE("DataStoreTest")
   }
 }
 
+TEST_CASE("DataStoreCopyOnWriteTest")
+{
+  DataStructure dataStr;
+  auto* editedArray = Int32Array::CreateWithStore<Int32DataStore>(dataStr, "Edited", {100}, {1});
+  auto* untouchedArray = Int32Array::CreateWithStore<Int32DataStore>(dataStr, "Untouched", {100}, {1});
+  editedArray->fill(1);
+  untouchedArray->fill(2);
+
+  DataStructure snapshot(dataStr);
+  auto& snapshotEdited = snapshot.getDataRefAs<Int32Array>(editedArray->getId());
+  auto& snapshotUntouched = snapshot.getDataRefAs<Int32Array>(untouchedArray->getId());
+
+  // The copies share the values until one of them is written to
+  const auto* editedStore = dynamic_cast<const Int32DataStore*>(std::as_const(*editedArray).getDataStore());
+  const auto* snapshotEditedStore = dynamic_cast<const Int32DataStore*>(std::as_const(snapshotEdited).getDataStore());
+  REQUIRE(editedStore != snapshotEditedStore);
+  REQUIRE(editedStore->isSharingData());
+  REQUIRE(editedStore->data() == snapshotEditedStore->data());
+
+  // Writing through the DataArray detaches the written DataStore only
+  (*editedArray)[0] = 10;
+  editedArray->getDataStoreRef().setValue(1, 11);
+  REQUIRE(snapshotEdited[0] == 1);
+  REQUIRE(snapshotEdited[1] == 1);
+  REQUIRE((*editedArray)[0] == 10);
+  REQUIRE(!editedStore->isSharingData());
+  REQUIRE(editedStore->data() != snapshotEditedStore->data());
+
+  const auto* untouchedStore = dynamic_cast<const Int32DataStore*>(std::as_const(*untouchedArray).getDataStore());
+  const auto* snapshotUntouchedStore = dynamic_cast<const Int32DataStore*>(std::as_const(snapshotUntouched).getDataStore());
+  REQUIRE(untouchedStore->data() == snapshotUntouchedStore->data());
+
+  // Writing to the snapshot does not modify the original
+  snapshotUntouched[5] = 20;
+  REQUIRE((*untouchedArray)[5] == 2);
+
+  // A DataArray copied outside of a DataStructure copy keeps referencing the same DataStore
+  Int32Array arrayCopy(*untouchedArray);
+  arrayCopy[6] = 30;
+  REQUIRE((*untouchedArray)[6] == 30);
+
+  // Taking the DataStore for writing detaches it before the worker threads start
+  DataStructure parallelSnapshot(dataStr);
+  auto& parallelStore = parallelSnapshot.getDataRefAs<Int32Array>(editedArray->getId()).getDataStoreRef();
+  REQUIRE(!dynamic_cast<const Int32DataStore&>(parallelStore).isSharingData());
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, parallelStore.getSize());
+  dataAlg.execute([&parallelStore](const Range& range) {
+    for(usize i = range.min(); i < range.max(); i++)
+    {
+      parallelStore[i] = static_cast<int32>(i);
+    }
+  });
+  for(usize i = 0; i < parallelStore.getSize(); i++)
+  {
+    REQUIRE(parallelStore[i] == static_cast<int32>(i));
+  }
+  REQUIRE((*editedArray)[0] == 10);
+  REQUIRE((*editedArray)[99] == 1);
+
+  // Worker threads may prepare the same DataStore for writing at the same time
+  {
+    const usize numValues = 1000000;
+    Int32DataStore sourceStore({numValues}, {1}, 1);
+    std::shared_ptr<AbstractDataStore<int32>> copyStore = sourceStore.createCopyOnWrite();
+    std::atomic<usize> mismatches = 0;
+    ParallelDataAlgorithm sharedAlg;
+    sharedAlg.setRange(0, numValues);
+    sharedAlg.execute([&](const Range& range) {
+      sourceStore.prepareForWrite();
+      for(usize i = range.min(); i < range.max(); i++)
+      {
+        if(copyStore->getValue(i) != 1)
+        {
+          mismatches++;
+        }
+        if(i % 2 == 0)
+        {
+          sourceStore[i] = -1;
+        }
+        else if(sourceStore.getValue(i) != 1)
+        {
+          mismatches++;
+        }
+      }
+    });
+    REQUIRE(!sourceStore.isSharingData());
+    for(usize i = 0; i < numValues; i++)
+    {
+      if(sourceStore.getValue(i) != (i % 2 == 0 ? -1 : 1) || copyStore->getValue(i) != 1)
+      {
+        mismatches++;
+      }
+    }
+    REQUIRE(mismatches == 0);
+  }
+}
+
+TEST_CASE("ParallelAlgorithmChunkTest")
+{
+  // Large enough that the memory mapped store is split into several chunks
+  const std::vector<usize> tupleShape = {64, 256, 256};
+  DataStructure dataStr;
+  auto* memoryArray = Int32Array::CreateWithStore<Int32DataStore>(dataStr, "Memory", tupleShape, {1});
+  auto* mmapArray = DataArray<int32>::CreateWithStore<MmapDataStore<int32>>(dataStr, "Mmap", tupleShape, {1});
+  memoryArray->fill(0);
+  mmapArray->fill(0);
+
+  // In-memory and memory mapped stores keep parallelization enabled
+  const IParallelAlgorithm::AlgorithmArrays algArrays = {memoryArray, mmapArray};
+  REQUIRE(IParallelAlgorithm::CheckArraysInMemory(algArrays));
+  REQUIRE(IParallelAlgorithm::GetChunkTupleShape({memoryArray}).empty());
+  const auto chunkShape = IParallelAlgorithm::GetChunkTupleShape(algArrays);
+  REQUIRE(chunkShape.size() == tupleShape.size());
+  REQUIRE(chunkShape[0] < tupleShape[0]);
+
+  // Chunk aligned ranges cover every tuple exactly once
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, memoryArray->getNumberOfTuples());
+  dataAlg.requireArraysInMemory(algArrays);
+#ifdef COMPLEX_ENABLE_MULTICORE
+  REQUIRE(dataAlg.getParallelizationEnabled());
+#endif
+  auto& memoryStore = memoryArray->getDataStoreRef();
+  auto& mmapStore = mmapArray->getDataStoreRef();
+  dataAlg.execute([&memoryStore, &mmapStore](const Range& range) {
+    for(usize i = range.min(); i < range.max(); i++)
+    {
+      memoryStore[i] += 1;
+      mmapStore[i] += 1;
+    }
+  });
+
+  // 3D chunks that do not divide the range evenly also cover every voxel once
+  ParallelData3DAlgorithm dataAlg3D;
+  dataAlg3D.setRange(tupleShape[2], tupleShape[1], tupleShape[0]);
+  dataAlg3D.setChunkSize(Range3D(3, 7, 4));
+  dataAlg3D.execute([&memoryStore, &tupleShape](const Range3D& range) {
+    for(usize z = range[4]; z < range[5]; z++)
+    {
+      for(usize y = range[2]; y < range[3]; y++)
+      {
+        for(usize x = range[0]; x < range[1]; x++)
+        {
+          memoryStore[(z * tupleShape[1] + y) * tupleShape[2] + x] += 1;
+        }
+      }
+    }
+  });
+
+  usize mismatchCount = 0;
+  for(usize i = 0; i < memoryStore.getSize(); i++)
+  {
+    if(memoryStore[i] != 2 || mmapStore[i] != 1)
+    {
+      mismatchCount++;
+    }
+  }
+  REQUIRE(mismatchCount == 0);
+}
+
+TEST_CASE("ParallelAlgorithmOutOfCoreDefaultTest")
+{
+  DataStructure dataStr;
+  auto* memoryArray = Int32Array::CreateWithStore<Int32DataStore>(dataStr, "Memory", {100}, {1});
+
+  auto* preferences = Application::GetOrCreateInstance()->getPreferences();
+  const std::string previousFormat = preferences->largeDataFormat();
+
+  // Algorithms that do not declare their arrays stay serial while an out-of-core format is in use
+  preferences->setLargeDataFormat("Test Format");
+  {
+    ParallelDataAlgorithm dataAlg;
+    REQUIRE_FALSE(dataAlg.getParallelizationEnabled());
+    dataAlg.requireArraysInMemory({memoryArray});
+#ifdef COMPLEX_ENABLE_MULTICORE
+    REQUIRE(dataAlg.getParallelizationEnabled());
+#endif
+  }
+
+  preferences->setLargeDataFormat("");
+  {
+    ParallelDataAlgorithm dataAlg;
+#ifdef COMPLEX_ENABLE_MULTICORE
+    REQUIRE(dataAlg.getParallelizationEnabled());
+#endif
+  }
+
+  preferences->setLargeDataFormat(previousFormat);
+}
+
+TEST_CASE("DataStoreBulkAccessTest")
+{
+  const std::vector<usize> tupleShape = {10, 10};
+  DataStore<int32> memoryStore(tupleShape, {3}, 0);
+  MmapDataStore<int32> mmapStore(tupleShape, {3}, 0);
+  NonContiguousDataStore<int32> otherStore(tupleShape, {3}, 0);
+  const std::vector<AbstractDataStore<int32>*> stores = {&memoryStore, &mmapStore, &otherStore};
+
+  REQUIRE(memoryStore.getContiguousValues(6) == memoryStore.data() + 6);
+  REQUIRE(mmapStore.getContiguousValues(0) == mmapStore.data());
+  REQUIRE(otherStore.getContiguousValues(0) == nullptr);
+  REQUIRE(memoryStore.getPreferredBlockSize() == memoryStore.getSize());
+  REQUIRE(otherStore.getPreferredBlockSize() == otherStore.getSize());
+
+  for(auto* store : stores)
+  {
+    std::vector<int32> values(store->getSize());
+    std::iota(values.begin(), values.end(), 0);
+    REQUIRE(store->copyFromBuffer(0, nonstd::span<const int32>(values.data(), values.size())));
+    REQUIRE_FALSE(store->copyFromBuffer(1, nonstd::span<const int32>(values.data(), values.size())));
+
+    std::vector<int32> buffer(25, -1);
+    REQUIRE(store->copyIntoBuffer(40, nonstd::span<int32>(buffer.data(), buffer.size())));
+    REQUIRE(buffer.front() == 40);
+    REQUIRE(buffer.back() == 64);
+    REQUIRE_FALSE(store->copyIntoBuffer(store->getSize() - 10, nonstd::span<int32>(buffer.data(), buffer.size())));
+
+    // Values written through a borrowed range are visible once the range is released
+    {
+      const AbstractDataStore<int32>& constStore = *store;
+      auto readRange = constStore.borrowRange(90, 30);
+      REQUIRE(readRange.size() == 30);
+      REQUIRE(readRange[0] == 90);
+      REQUIRE(readRange[29] == 119);
+
+      auto writeRange = store->borrowRange(30, 30);
+      for(usize i = 0; i < writeRange.size(); i++)
+      {
+        writeRange[i] *= -1;
+      }
+    }
+    REQUIRE(store->getValue(29) == 29);
+    REQUIRE(store->getValue(30) == -30);
+    REQUIRE(store->getValue(59) == -59);
+    REQUIRE(store->getValue(60) == 60);
+    REQUIRE_THROWS_AS(store->borrowRange(store->getSize() - 1, 2), std::out_of_range);
+
+    // Tuple copies between every kind of store
+    for(auto* source : stores)
+    {
+      DataStore<int32> destination({20}, {3}, 0);
+      REQUIRE(destination.copyFrom(5, *source, 10, 15));
+      REQUIRE(destination.getValue(5 * 3) == source->getValue(10 * 3));
+      REQUIRE(destination.getValue(20 * 3 - 1) == source->getValue(25 * 3 - 1));
+      REQUIRE(source->copyFrom(0, destination, 0, 1));
+      REQUIRE(source->getValue(2) == 0);
+      REQUIRE(source->copyFrom(0, destination, 5, 1));
+      REQUIRE(source->getValue(2) == destination.getValue(17));
+    }
+  }
+}
+
 TEST_CASE("DataArrayTest")
 {
   DataStructure dataStr;
@@ -818,6 +1136,59 @@ TEST_CASE("ScalarDataTest")
   REQUIRE(scalar->getValue() == newValue2);
 }
 
+TEST_CASE("DynamicListArrayTest")
+{
+  DataStructure dataStr;
+  using MeshIndexType = IGeometry::MeshIndexType;
+
+  // Two triangles sharing the edge between vertices 1 and 2 plus a third triangle that only shares vertex 2
+  auto* triangleGeom = TriangleGeom::Create(dataStr, "Triangle Geometry");
+  auto* vertices = UnitTest::CreateTestDataArray<float32>(dataStr, "Vertices", {5}, {3}, triangleGeom->getId());
+  triangleGeom->setVertices(*vertices);
+  auto* faces = UnitTest::CreateTestDataArray<MeshIndexType>(dataStr, "Faces", {3}, {3}, triangleGeom->getId());
+  const std::vector<MeshIndexType> faceVerts = {0, 1, 2, 1, 3, 2, 2, 3, 4};
+  for(usize i = 0; i < faceVerts.size(); i++)
+  {
+    (*faces)[i] = faceVerts[i];
+  }
+  triangleGeom->setFaceList(*faces);
+
+  REQUIRE(triangleGeom->findElementsContainingVert() >= 0);
+  const auto* elementsContainingVert = triangleGeom->getElementsContainingVert();
+  REQUIRE(elementsContainingVert != nullptr);
+  REQUIRE(elementsContainingVert->size() == 5);
+  REQUIRE(elementsContainingVert->getOffsets() == std::vector<usize>{0, 1, 3, 6, 8, 9});
+  REQUIRE(elementsContainingVert->getValues() == std::vector<MeshIndexType>{0, 0, 1, 0, 1, 2, 1, 2, 2});
+  REQUIRE(elementsContainingVert->getNumberOfElements(2) == 3);
+  REQUIRE(elementsContainingVert->getElementListPointer(3)[1] == 2);
+
+  REQUIRE(triangleGeom->findElementNeighbors() >= 0);
+  const auto* elementNeighbors = triangleGeom->getElementNeighbors();
+  REQUIRE(elementNeighbors != nullptr);
+  REQUIRE(elementNeighbors->getOffsets() == std::vector<usize>{0, 1, 3, 4});
+  REQUIRE(elementNeighbors->getValues() == std::vector<MeshIndexType>{1, 0, 2, 1});
+
+  // Changing the length of one list keeps the lists stored after it intact
+  auto* dynamicList = IGeometry::ElementDynamicList::Create(dataStr, "Lists", {});
+  REQUIRE(dynamicList != nullptr);
+  dynamicList->allocateLists(std::vector<uint16>{2, 1, 3});
+  const std::vector<MeshIndexType> lastList = {7, 8, 9};
+  REQUIRE(dynamicList->setElementList(2, 3, lastList.data()));
+  const std::vector<MeshIndexType> firstList = {1, 2, 3, 4};
+  REQUIRE(dynamicList->setElementList(0, 4, firstList.data()));
+  REQUIRE(dynamicList->setElementList(1, 0, nullptr));
+  REQUIRE_FALSE(dynamicList->setElementList(3, 0, nullptr));
+  REQUIRE(dynamicList->getOffsets() == std::vector<usize>{0, 4, 4, 7});
+  REQUIRE(dynamicList->getValues() == std::vector<MeshIndexType>{1, 2, 3, 4, 7, 8, 9});
+
+  REQUIRE_FALSE(dynamicList->setLists({0, 2}, {1}));
+  REQUIRE(dynamicList->setLists({0, 1, 1}, {5}));
+  REQUIRE(dynamicList->size() == 2);
+  REQUIRE(dynamicList->getElementList(0).numCells == 1);
+  REQUIRE(dynamicList->getElementList(0).cells[0] == 5);
+  REQUIRE(dynamicList->getNumberOfElements(1) == 0);
+}
+
 TEST_CASE("DataStructureDuplicateNames")
 {
   static constexpr StringLiteral name = "foo";
@@ -10,6 +10,9 @@
 #include "complex/DataStructure/Geometry/TetrahedralGeom.hpp"
 #include "complex/DataStructure/Geometry/TriangleGeom.hpp"
 #include "complex/DataStructure/Geometry/VertexGeom.hpp"
+#include "complex/Utilities/ImageSlabStreamer.hpp"
+#include "complex/Utilities/Math/GeometryMath.hpp"
+#include "complex/Utilities/TriangleBVH.hpp"
 
 #include <catch2/catch.hpp>
 
@@ -193,6 +196,107 @@ TEST_CASE("ImageGeomTest")
   }
 }
 
+TEST_CASE("ImageGeomSlabStreamingTest")
+{
+  DataStructure dataStructure;
+  auto* geom = ImageGeom::Create(dataStructure, "Image");
+  geom->setDimensions({4, 3, 10});
+
+  const auto zSlabs = geom->getZSlabs(3, 2);
+  REQUIRE(zSlabs.size() == 4);
+  REQUIRE(zSlabs[0].zStart == 0);
+  REQUIRE(zSlabs[0].zEnd == 3);
+  REQUIRE(zSlabs[0].haloStart == 0);
+  REQUIRE(zSlabs[0].haloEnd == 5);
+  REQUIRE(zSlabs[1].haloStart == 1);
+  REQUIRE(zSlabs[1].haloEnd == 8);
+  REQUIRE(zSlabs[3].zStart == 9);
+  REQUIRE(zSlabs[3].zEnd == 10);
+  REQUIRE(zSlabs[3].haloEnd == 10);
+
+  // Replace every value in place with the sum of itself and its Z neighbors
+  const usize layerSize = 4 * 3;
+  const usize numValues = layerSize * 10;
+  DataStore<int32> values({10, 3, 4}, {1}, 0);
+  std::vector<int32> expected(numValues, 0);
+  for(usize i = 0; i < numValues; i++)
+  {
+    values[i] = static_cast<int32>(i);
+  }
+  for(usize i = 0; i < numValues; i++)
+  {
+    expected[i] = values[i] + (i >= layerSize ? values[i - layerSize] : 0) + (i + layerSize < numValues ? values[i + layerSize] : 0);
+  }
+
+  ImageSlabStreamer streamer(*geom, 1);
+  streamer.setSlabDepth(2);
+  REQUIRE(streamer.getSlabDepth() == 2);
+  const usize valuesIndex = streamer.addOutput(values, true);
+  usize slabCount = 0;
+  Result<> result = streamer.execute(
+      [valuesIndex, layerSize, &slabCount](ImageSlabStreamer::Slab& slab) -> Result<> {
+        auto& buffer = slab.getBuffer<int32>(valuesIndex);
+        const usize numLayers = slab.getDimensions()[2];
+        std::vector<int32> output(layerSize * numLayers, 0);
+        for(usize z = slab.getCoreStart(); z < slab.getCoreEnd(); z++)
+        {
+          for(usize i = z * layerSize; i < (z + 1) * layerSize; i++)
+          {
+            output[i] = buffer[i] + (z > 0 ? buffer[i - layerSize] : 0) + (z + 1 < numLayers ? buffer[i + layerSize] : 0);
+          }
+        }
+        for(usize i = slab.getCoreStart() * layerSize; i < slab.getCoreEnd() * layerSize; i++)
+        {
+          buffer[i] = output[i];
+        }
+        slabCount++;
+        return {};
+      },
+      false);
+  REQUIRE(result.valid());
+  REQUIRE(slabCount == 5);
+  for(usize i = 0; i < numValues; i++)
+  {
+    REQUIRE(values[i] == expected[i]);
+  }
+}
+
+TEST_CASE("ImageGeomSlabStreamingInPlaceTest")
+{
+  DataStructure dataStructure;
+  auto* geom = ImageGeom::Create(dataStructure, "Image");
+  geom->setDimensions({4, 3, 10});
+
+  DataStore<int32> input({10, 3, 4}, {1}, 3);
+  DataStore<int32> output({10, 3, 4}, {1}, 0);
+
+  // The whole in-memory volume is a single slab, so the buffers are the arrays themselves
+  ImageSlabStreamer streamer(*geom, 1);
+  REQUIRE(streamer.getSlabDepth() == 10);
+  const usize inputIndex = streamer.addInput(input);
+  const usize outputIndex = streamer.addOutput(output);
+  usize slabCount = 0;
+  Result<> result = streamer.execute(
+      [&](ImageSlabStreamer::Slab& slab) -> Result<> {
+        REQUIRE(&slab.getBuffer<int32>(inputIndex) == &input);
+        auto& buffer = slab.getBuffer<int32>(outputIndex);
+        REQUIRE(&buffer == &output);
+        for(usize i = 0; i < buffer.getSize(); i++)
+        {
+          buffer[i] = slab.getBuffer<int32>(inputIndex)[i] * 2;
+        }
+        slabCount++;
+        return {};
+      },
+      false);
+  REQUIRE(result.valid());
+  REQUIRE(slabCount == 1);
+  for(usize i = 0; i < output.getSize(); i++)
+  {
+    REQUIRE(output[i] == 6);
+  }
+}
+
 TEST_CASE("QuadGeomTest")
 {
   DataStructure dataStructure;
@@ -245,6 +349,191 @@ TEST_CASE("TriangleGeomTest")
   }
 }
 
+TEST_CASE("TriangleBVHPointInPolyhedronTest")
+{
+  // Surface of the cube [0, 4]^3 with every side split into 4 x 4 squares of two triangles
+  constexpr usize k_Divisions = 4;
+  constexpr float32 k_Size = 4.0f;
+  DataStructure dataStructure;
+  auto* geom = createGeom<TriangleGeom>(dataStructure);
+  std::vector<float32> vertices;
+  std::vector<IGeometry::MeshIndexType> faces;
+  for(usize axis = 0; axis < 3; axis++)
+  {
+    const usize uAxis = (axis + 1) % 3;
+    const usize vAxis = (axis + 2) % 3;
+    for(float32 side : {0.0f, k_Size})
+    {
+      const auto firstVertex = static_cast<IGeometry::MeshIndexType>(vertices.size() / 3);
+      for(usize j = 0; j <= k_Divisions; j++)
+      {
+        for(usize i = 0; i <= k_Divisions; i++)
+        {
+          std::array<float32, 3> coords = {0.0f, 0.0f, 0.0f};
+          coords[axis] = side;
+          coords[uAxis] = static_cast<float32>(i);
+          coords[vAxis] = static_cast<float32>(j);
+          vertices.insert(vertices.end(), coords.begin(), coords.end());
+        }
+      }
+      for(usize j = 0; j < k_Divisions; j++)
+      {
+        for(usize i = 0; i < k_Divisions; i++)
+        {
+          const IGeometry::MeshIndexType v00 = firstVertex + j * (k_Divisions + 1) + i;
+          const IGeometry::MeshIndexType v01 = v00 + k_Divisions + 1;
+          faces.insert(faces.end(), {v00, v00 + 1, v01 + 1, v00, v01 + 1, v01});
+        }
+      }
+    }
+  }
+  auto vertexStore = std::make_shared<DataStore<float32>>(std::vector<usize>{vertices.size() / 3}, std::vector<usize>{3}, 0.0f);
+  std::copy(vertices.begin(), vertices.end(), vertexStore->begin());
+  auto* vertexList = IGeometry::SharedVertexList::Create(dataStructure, "Vertices", vertexStore, geom->getId());
+  auto faceStore = std::make_shared<DataStore<IGeometry::MeshIndexType>>(std::vector<usize>{faces.size() / 3}, std::vector<usize>{3}, 0);
+  std::copy(faces.begin(), faces.end(), faceStore->begin());
+  auto* faceList = IGeometry::SharedFaceList::Create(dataStructure, "Faces", faceStore, geom->getId());
+  geom->setVertices(*vertexList);
+  geom->setFaceList(*faceList);
+
+  const usize numFaces = geom->getNumberOfFaces();
+  std::vector<int32> faceIds(numFaces);
+  std::vector<BoundingBox3Df> faceBBs;
+  for(usize i = 0; i < numFaces; i++)
+  {
+    faceIds[i] = static_cast<int32>(i);
+    faceBBs.push_back(GeometryMath::FindBoundingBoxOfFace(*geom, static_cast<int32>(i)));
+  }
+
+  const TriangleBVH bvh(faceIds, faceBBs);
+  REQUIRE_FALSE(bvh.empty());
+  std::vector<int32> sortedIds = bvh.getFaceIds();
+  std::sort(sortedIds.begin(), sortedIds.end());
+  REQUIRE(sortedIds == faceIds);
+  const BoundingBox3Df bounds = GeometryMath::FindBoundingBoxOfFaces(*geom, faceIds);
+  REQUIRE(bvh.getBounds() == bounds);
+
+  // Every face is visited when no node is skipped and none outside of a query box
+  usize visitedFaces = 0;
+  bvh.visit([](const BoundingBox3Df&) { return true; },
+            [&visitedFaces](int32) {
+              visitedFaces++;
+              return true;
+            });
+  REQUIRE(visitedFaces == numFaces);
+  // A segment query visits every face whose bounding box it crosses and skips most of the others
+  const Point3Df segmentStart(-0.5f, -0.5f, -0.5f);
+  const Point3Df segmentEnd(1.5f, 1.5f, 1.5f);
+  std::vector<bool> visited(numFaces, false);
+  bvh.visit([&](const BoundingBox3Df& nodeBounds) { return GeometryMath::DoesSegmentIntersectBox(segmentStart, segmentEnd, nodeBounds); },
+            [&visited](int32 faceId) {
+              visited[faceId] = true;
+              return true;
+            });
+  usize missedFaces = 0;
+  for(usize i = 0; i < numFaces; i++)
+  {
+    if(!visited[i] && GeometryMath::DoesSegmentIntersectBox(segmentStart, segmentEnd, faceBBs[i]))
+    {
+      missedFaces++;
+    }
+  }
+  REQUIRE(missedFaces == 0);
+  REQUIRE(static_cast<usize>(std::count(visited.begin(), visited.end(), true)) < numFaces / 2);
+
+  // Classification matches the face list version and the expected inside/outside codes
+  const float32 radius = GeometryMath::FindDistanceBetweenPoints(bounds.getMinPoint(), bounds.getMaxPoint());
+  std::mt19937_64 generator(5489u);
+  usize mismatchCount = 0;
+  for(float32 z = -0.35f; z < 5.0f; z += 0.7f)
+  {
+    for(float32 y = -0.35f; y < 5.0f; y += 0.7f)
+    {
+      for(float32 x = -0.35f; x < 5.0f; x += 0.7f)
+      {
+        const Point3Df point(x, y, z);
+        const bool inside = x > 0.0f && x < k_Size && y > 0.0f && y < k_Size && z > 0.0f && z < k_Size;
+        const char expected = inside ? 'i' : 'o';
+        const char faceListCode = GeometryMath::IsPointInPolyhedron(*geom, faceIds, faceBBs, point, bounds, radius);
+        const char bvhCode = GeometryMath::IsPointInPolyhedron(*geom, bvh, faceBBs, point, bounds, radius, generator);
+        if(faceListCode != expected || bvhCode != expected)
+        {
+          mismatchCount++;
+        }
+      }
+    }
+  }
+  REQUIRE(mismatchCount == 0);
+
+  // Points on the surface report the boundary code
+  const char boundaryCode = GeometryMath::IsPointInPolyhedron(*geom, bvh, faceBBs, Point3Df(2.3f, 2.6f, 0.0f), bounds, radius, generator);
+  REQUIRE((boundaryCode == 'V' || boundaryCode == 'E' || boundaryCode == 'F'));
+}
+
+TEST_CASE("TriangleBVHNearestFaceTest")
+{
+  // Unit cubes on a 6 x 6 x 6 grid with a spacing of 2, the faces are the cubes themselves
+  constexpr usize k_Count = 6;
+  std::vector<int32> faceIds;
+  std::vector<BoundingBox3Df> faceBBs;
+  for(usize k = 0; k < k_Count; k++)
+  {
+    for(usize j = 0; j < k_Count; j++)
+    {
+      for(usize i = 0; i < k_Count; i++)
+      {
+        const Point3Df minPoint(2.0f * i, 2.0f * j, 2.0f * k);
+        faceIds.push_back(static_cast<int32>(faceBBs.size()));
+        faceBBs.emplace_back(minPoint, minPoint + Point3Df(1.0f, 1.0f, 1.0f));
+      }
+    }
+  }
+  const TriangleBVH bvh(faceIds, faceBBs);
+
+  float32 distanceSquared = 0.0f;
+  REQUIRE(TriangleBVH({}, faceBBs).findNearest(Point3Df(0.0f, 0.0f, 0.0f), [](int32) { return 0.0f; }, distanceSquared) == -1);
+
+  // Matches a search over every face, including points outside of the hierarchy and ties between faces
+  usize mismatchCount = 0;
+  usize measuredFaces = 0;
+  for(float32 z = -3.0f; z < 14.0f; z += 1.5f)
+  {
+    for(float32 y = -3.0f; y < 14.0f; y += 1.5f)
+    {
+      for(float32 x = -3.0f; x < 14.0f; x += 1.5f)
+      {
+        const Point3Df point(x, y, z);
+        const int32 nearestFace = bvh.findNearest(
+            point,
+            [&](int32 faceId) {
+              measuredFaces++;
+              return TriangleBVH::DistanceSquared(faceBBs[faceId], point);
+            },
+            distanceSquared);
+
+        int32 expectedFace = -1;
+        float32 expectedDistance = std::numeric_limits<float32>::max();
+        for(int32 faceId : faceIds)
+        {
+          const float32 faceDistance = TriangleBVH::DistanceSquared(faceBBs[faceId], point);
+          if(faceDistance < expectedDistance)
+          {
+            expectedDistance = faceDistance;
+            expectedFace = faceId;
+          }
+        }
+        if(nearestFace != expectedFace || distanceSquared != expectedDistance)
+        {
+          mismatchCount++;
+        }
+      }
+    }
+  }
+  REQUIRE(mismatchCount == 0);
+  // 12^3 query points, far fewer measurements than testing every face
+  REQUIRE(measuredFaces < 12 * 12 * 12 * faceIds.size() / 4);
+}
+
 TEST_CASE("VertexGeomTest")
 {
   DataStructure dataStructure;
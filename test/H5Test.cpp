@@ -12,6 +12,7 @@
 #include "complex/DataStructure/Geometry/VertexGeom.hpp"
 #include "complex/DataStructure/IO/HDF5/DataStructureReader.hpp"
 #include "complex/DataStructure/IO/HDF5/DataStructureWriter.hpp"
+#include "complex/DataStructure/MmapDataStore.hpp"
 #include "complex/DataStructure/Montage/GridMontage.hpp"
 #include "complex/DataStructure/ScalarData.hpp"
 #include "complex/DataStructure/StringArray.hpp"
@@ -29,6 +30,7 @@
 
 #include <catch2/catch.hpp>
 
+#include <numeric>
 #include <string>
 #include <type_traits>
 
@@ -68,6 +70,149 @@ fs::path GetComplexH5File()
   return GetDataDir() / Constants::k_ComplexH5File;
 }
 
+/**
+ * @brief Keeps its values in a std::vector but only exposes them through chunks,
+ * like an out-of-core DataStore, so that writing it to HDF5 goes through
+ * getChunkValues() instead of a contiguous buffer.
+ */
+template <typename T>
+class ChunkedTestDataStore : public AbstractDataStore<T>
+{
+public:
+  using value_type = typename AbstractDataStore<T>::value_type;
+  using reference = typename AbstractDataStore<T>::reference;
+  using const_reference = typename AbstractDataStore<T>::const_reference;
+  using ShapeType = typename IDataStore::ShapeType;
+
+  ChunkedTestDataStore(ShapeType tupleShape, ShapeType componentShape, ShapeType chunkShape)
+  : m_TupleShape(std::move(tupleShape))
+  , m_ComponentShape(std::move(componentShape))
+  , m_ChunkShape(std::move(chunkShape))
+  {
+    const usize numTuples = std::accumulate(m_TupleShape.cbegin(), m_TupleShape.cend(), static_cast<usize>(1), std::multiplies<>());
+    const usize numComponents = std::accumulate(m_ComponentShape.cbegin(), m_ComponentShape.cend(), static_cast<usize>(1), std::multiplies<>());
+    m_Values.resize(numTuples * numComponents);
+  }
+
+  usize getNumberOfTuples() const override
+  {
+    return m_Values.empty() ? 0 : m_Values.size() / getNumberOfComponents();
+  }
+
+  const ShapeType& getTupleShape() const override
+  {
+    return m_TupleShape;
+  }
+
+  usize getNumberOfComponents() const override
+  {
+    return std::accumulate(m_ComponentShape.cbegin(), m_ComponentShape.cend(), static_cast<usize>(1), std::multiplies<>());
+  }
+
+  const ShapeType& getComponentShape() const override
+  {
+    return m_ComponentShape;
+  }
+
+  std::optional<ShapeType> getChunkShape() const override
+  {
+    return m_ChunkShape;
+  }
+
+  void resizeTuples(const ShapeType& tupleShape) override
+  {
+    throw std::runtime_error("ChunkedTestDataStore cannot be resized");
+  }
+
+  IDataStore::StoreType getStoreType() const override
+  {
+    return IDataStore::StoreType::OutOfCore;
+  }
+
+  std::unique_ptr<IDataStore> deepCopy() const override
+  {
+    auto copy = std::make_unique<ChunkedTestDataStore>(m_TupleShape, m_ComponentShape, m_ChunkShape);
+    copy->m_Values = m_Values;
+    return copy;
+  }
+
+  std::unique_ptr<IDataStore> createNewInstance() const override
+  {
+    return std::make_unique<ChunkedTestDataStore>(m_TupleShape, m_ComponentShape, m_ChunkShape);
+  }
+
+  std::pair<int32, std::string> writeBinaryFile(const std::string& absoluteFilePath) const override
+  {
+    return {-1, "ChunkedTestDataStore cannot be written to a binary file"};
+  }
+
+  value_type getValue(usize index) const override
+  {
+    return m_Values[index];
+  }
+
+  void setValue(usize index, value_type value) override
+  {
+    m_Values[index] = value;
+  }
+
+  const_reference operator[](usize index) const override
+  {
+    return m_Values[index];
+  }
+
+  const_reference at(usize index) const override
+  {
+    return m_Values.at(index);
+  }
+
+  reference operator[](usize index) override
+  {
+    return m_Values[index];
+  }
+
+  /**
+   * @brief Returns the chunk in C order padded with zeros where it extends past the store.
+   * @param chunkPosition
+   * @return std::vector<T>
+   */
+  std::vector<T> getChunkValues(const ShapeType& chunkPosition) const override
+  {
+    ShapeType dims = m_TupleShape;
+    dims.insert(dims.end(), m_ComponentShape.cbegin(), m_ComponentShape.cend());
+    const usize rank = dims.size();
+    const usize chunkSize = std::accumulate(m_ChunkShape.cbegin(), m_ChunkShape.cend(), static_cast<usize>(1), std::multiplies<>());
+
+    std::vector<T> chunkValues(chunkSize, static_cast<T>(0));
+    for(usize chunkIndex = 0; chunkIndex < chunkSize; chunkIndex++)
+    {
+      usize remainder = chunkIndex;
+      usize index = 0;
+      usize stride = 1;
+      bool inside = true;
+      for(usize dim = rank; dim-- > 0;)
+      {
+        const usize position = chunkPosition[dim] * m_ChunkShape[dim] + remainder % m_ChunkShape[dim];
+        remainder /= m_ChunkShape[dim];
+        inside = inside && position < dims[dim];
+        index += position * stride;
+        stride *= dims[dim];
+      }
+      if(inside)
+      {
+        chunkValues[chunkIndex] = m_Values[index];
+      }
+    }
+    return chunkValues;
+  }
+
+private:
+  ShapeType m_TupleShape;
+  ShapeType m_ComponentShape;
+  ShapeType m_ChunkShape;
+  std::vector<T> m_Values;
+};
+
 bool equalsf(const FloatVec3& lhs, const FloatVec3& rhs)
 {
   for(usize i = 0; i < 3; i++)
@@ -669,6 +814,106 @@ TEST_CASE("NeighborList IO")
   }
 }
 
+TEST_CASE("DynamicListArray IO")
+{
+  auto app = Application::GetOrCreateInstance();
+
+  fs::path dataDir = GetDataDir();
+
+  if(!fs::exists(dataDir))
+  {
+    REQUIRE(fs::create_directories(dataDir));
+  }
+
+  fs::path filePath = GetDataDir() / "DynamicListArrayTest.dream3d";
+
+  std::string filePathString = filePath.string();
+
+  const DataPath geometryPath({k_TriangleGroupName, "[Geometry] Triangle"});
+  std::vector<usize> containingVertOffsets;
+  std::vector<IGeometry::MeshIndexType> containingVertValues;
+  std::vector<usize> neighborOffsets;
+  std::vector<IGeometry::MeshIndexType> neighborValues;
+
+  // Write HDF5 file
+  try
+  {
+    DataStructure dataStructure;
+    CreateTriangleGeometry(dataStructure);
+    auto& triangleGeom = dataStructure.getDataRefAs<TriangleGeom>(geometryPath);
+    REQUIRE(triangleGeom.findElementNeighbors() >= 0);
+
+    const auto* elementsContainingVert = triangleGeom.getElementsContainingVert();
+    const auto* elementNeighbors = triangleGeom.getElementNeighbors();
+    REQUIRE(elementsContainingVert != nullptr);
+    REQUIRE(elementNeighbors != nullptr);
+    REQUIRE(elementsContainingVert->getNumberOfValues() == 242 * 3);
+    REQUIRE(elementNeighbors->size() == 242);
+    containingVertOffsets = elementsContainingVert->getOffsets();
+    containingVertValues = elementsContainingVert->getValues();
+    neighborOffsets = elementNeighbors->getOffsets();
+    neighborValues = elementNeighbors->getValues();
+
+    Result<complex::HDF5::FileWriter> result = complex::HDF5::FileWriter::CreateFile(filePathString);
+    COMPLEX_RESULT_REQUIRE_VALID(result);
+
+    complex::HDF5::FileWriter fileWriter = std::move(result.value());
+    REQUIRE(fileWriter.isValid());
+
+    Result<> writeResult = HDF5::DataStructureWriter::WriteFile(dataStructure, fileWriter);
+    COMPLEX_RESULT_REQUIRE_VALID(writeResult);
+  } catch(const std::exception& e)
+  {
+    FAIL(e.what());
+  }
+
+  // Read HDF5 file
+  try
+  {
+    complex::HDF5::FileReader fileReader(filePathString);
+    REQUIRE(fileReader.isValid());
+
+    auto readResult = HDF5::DataStructureReader::ReadFile(fileReader);
+    COMPLEX_RESULT_REQUIRE_VALID(readResult);
+    DataStructure dataStructure = std::move(readResult.value());
+
+    const auto& triangleGeom = dataStructure.getDataRefAs<TriangleGeom>(geometryPath);
+    const auto* elementsContainingVert = triangleGeom.getElementsContainingVert();
+    const auto* elementNeighbors = triangleGeom.getElementNeighbors();
+    REQUIRE(elementsContainingVert != nullptr);
+    REQUIRE(elementNeighbors != nullptr);
+    REQUIRE(elementsContainingVert->getOffsets() == containingVertOffsets);
+    REQUIRE(elementsContainingVert->getValues() == containingVertValues);
+    REQUIRE(elementNeighbors->getOffsets() == neighborOffsets);
+    REQUIRE(elementNeighbors->getValues() == neighborValues);
+  } catch(const std::exception& e)
+  {
+    FAIL(e.what());
+  }
+
+  // Read HDF5 file without values
+  try
+  {
+    complex::HDF5::FileReader fileReader(filePathString);
+    REQUIRE(fileReader.isValid());
+
+    auto readResult = HDF5::DataStructureReader::ReadFile(fileReader, true);
+    COMPLEX_RESULT_REQUIRE_VALID(readResult);
+    DataStructure dataStructure = std::move(readResult.value());
+
+    const auto& triangleGeom = dataStructure.getDataRefAs<TriangleGeom>(geometryPath);
+    const auto* elementsContainingVert = triangleGeom.getElementsContainingVert();
+    const auto* elementNeighbors = triangleGeom.getElementNeighbors();
+    REQUIRE(elementsContainingVert != nullptr);
+    REQUIRE(elementNeighbors != nullptr);
+    REQUIRE(elementsContainingVert->getNumberOfValues() == 0);
+    REQUIRE(elementNeighbors->getNumberOfValues() == 0);
+  } catch(const std::exception& e)
+  {
+    FAIL(e.what());
+  }
+}
+
 TEST_CASE("DataArray<bool> IO")
 {
   auto app = Application::GetOrCreateInstance();
@@ -757,6 +1002,238 @@ TEST_CASE("DataArray<bool> IO")
   }
 }
 
+TEST_CASE("Compressed DataArray IO")
+{
+  auto app = Application::GetOrCreateInstance();
+
+  fs::path dataDir = GetDataDir();
+  if(!fs::exists(dataDir))
+  {
+    REQUIRE(fs::create_directories(dataDir));
+  }
+
+  fs::path filePath = GetDataDir() / "CompressedArrayTest.dream3d";
+  std::string filePathString = filePath.string();
+
+  const std::vector<usize> tupleShape = {50, 40, 30};
+  const std::vector<usize> componentShape = {3};
+
+  // Write HDF5 file using both a contiguous and a memory mapped store
+  try
+  {
+    DataStructure dataStructure;
+    auto* int32Array = DataArray<int32>::CreateWithStore<DataStore<int32>>(dataStructure, "Int32Array", tupleShape, componentShape);
+    auto* mmapArray = DataArray<float32>::CreateWithStore<MmapDataStore<float32>>(dataStructure, "MmapArray", tupleShape, componentShape);
+    for(usize i = 0; i < int32Array->getSize(); i++)
+    {
+      (*int32Array)[i] = static_cast<int32>(i % 97);
+      (*mmapArray)[i] = static_cast<float32>(i) * 0.5f;
+    }
+
+    Result<complex::HDF5::FileWriter> result = complex::HDF5::FileWriter::CreateFile(filePathString);
+    COMPLEX_RESULT_REQUIRE_VALID(result);
+    complex::HDF5::FileWriter fileWriter = std::move(result.value());
+    REQUIRE(fileWriter.isValid());
+
+    HDF5::CompressionOptions compression;
+    compression.method = HDF5::CompressionOptions::Method::Deflate;
+    Result<> writeResult = HDF5::DataStructureWriter::WriteFile(dataStructure, fileWriter, compression);
+    COMPLEX_RESULT_REQUIRE_VALID(writeResult);
+  } catch(const std::exception& e)
+  {
+    FAIL(e.what());
+  }
+
+  // Read HDF5 file
+  try
+  {
+    complex::HDF5::FileReader fileReader(filePathString);
+    REQUIRE(fileReader.isValid());
+
+    hid_t datasetId = H5Dopen(fileReader.getId(), "DataStructure/Int32Array", H5P_DEFAULT);
+    REQUIRE(datasetId > 0);
+    hid_t propertiesId = H5Dget_create_plist(datasetId);
+    REQUIRE(H5Pget_layout(propertiesId) == H5D_CHUNKED);
+    REQUIRE(H5Pget_nfilters(propertiesId) > 0);
+    H5Pclose(propertiesId);
+    H5Dclose(datasetId);
+
+    auto readResult = HDF5::DataStructureReader::ReadFile(fileReader);
+    COMPLEX_RESULT_REQUIRE_VALID(readResult);
+    DataStructure dataStructure = std::move(readResult.value());
+
+    auto* int32Array = dataStructure.getDataAs<Int32Array>(DataPath({"Int32Array"}));
+    auto* mmapArray = dataStructure.getDataAs<Float32Array>(DataPath({"MmapArray"}));
+    REQUIRE(int32Array != nullptr);
+    REQUIRE(mmapArray != nullptr);
+    REQUIRE(int32Array->getTupleShape() == tupleShape);
+    REQUIRE(mmapArray->getComponentShape() == componentShape);
+    for(usize i = 0; i < int32Array->getSize(); i++)
+    {
+      REQUIRE((*int32Array)[i] == static_cast<int32>(i % 97));
+      REQUIRE((*mmapArray)[i] == static_cast<float32>(i) * 0.5f);
+    }
+  } catch(const std::exception& e)
+  {
+    FAIL(e.what());
+  }
+}
+
+TEST_CASE("Chunked DataStore IO")
+{
+  auto app = Application::GetOrCreateInstance();
+
+  fs::path dataDir = GetDataDir();
+  if(!fs::exists(dataDir))
+  {
+    REQUIRE(fs::create_directories(dataDir));
+  }
+
+  fs::path filePath = GetDataDir() / "ChunkedDataStoreTest.dream3d";
+  std::string filePathString = filePath.string();
+
+  // The chunk shape does not divide the dimensions so the last chunk along each one is partial
+  const std::vector<usize> tupleShape = {7, 11, 5};
+  const std::vector<usize> componentShape = {3};
+  const std::vector<usize> chunkShape = {3, 4, 2, 2};
+
+  // Write HDF5 file from stores without contiguous values
+  try
+  {
+    DataStructure dataStructure;
+    auto int32Store = std::make_shared<ChunkedTestDataStore<int32>>(tupleShape, componentShape, chunkShape);
+    auto float64Store = std::make_shared<ChunkedTestDataStore<float64>>(tupleShape, componentShape, chunkShape);
+    REQUIRE(int32Store->getContiguousValues(0) == nullptr);
+    for(usize i = 0; i < int32Store->getSize(); i++)
+    {
+      int32Store->setValue(i, static_cast<int32>(i % 251) - 100);
+      float64Store->setValue(i, static_cast<float64>(i) * 0.25);
+    }
+    REQUIRE(Int32Array::Create(dataStructure, "Int32Array", int32Store) != nullptr);
+    REQUIRE(Float64Array::Create(dataStructure, "Float64Array", float64Store) != nullptr);
+
+    Result<complex::HDF5::FileWriter> result = complex::HDF5::FileWriter::CreateFile(filePathString);
+    COMPLEX_RESULT_REQUIRE_VALID(result);
+    complex::HDF5::FileWriter fileWriter = std::move(result.value());
+    REQUIRE(fileWriter.isValid());
+
+    Result<> writeResult = HDF5::DataStructureWriter::WriteFile(dataStructure, fileWriter);
+    COMPLEX_RESULT_REQUIRE_VALID(writeResult);
+  } catch(const std::exception& e)
+  {
+    FAIL(e.what());
+  }
+
+  // Read HDF5 file
+  try
+  {
+    complex::HDF5::FileReader fileReader(filePathString);
+    REQUIRE(fileReader.isValid());
+
+    hid_t datasetId = H5Dopen(fileReader.getId(), "DataStructure/Int32Array", H5P_DEFAULT);
+    REQUIRE(datasetId > 0);
+    hid_t propertiesId = H5Dget_create_plist(datasetId);
+    REQUIRE(H5Pget_layout(propertiesId) == H5D_CHUNKED);
+    std::vector<hsize_t> fileChunkDims(chunkShape.size());
+    REQUIRE(H5Pget_chunk(propertiesId, static_cast<int>(fileChunkDims.size()), fileChunkDims.data()) == static_cast<int>(chunkShape.size()));
+    REQUIRE(std::equal(fileChunkDims.cbegin(), fileChunkDims.cend(), chunkShape.cbegin()));
+    H5Pclose(propertiesId);
+    H5Dclose(datasetId);
+
+    auto readResult = HDF5::DataStructureReader::ReadFile(fileReader);
+    COMPLEX_RESULT_REQUIRE_VALID(readResult);
+    DataStructure dataStructure = std::move(readResult.value());
+
+    auto* int32Array = dataStructure.getDataAs<Int32Array>(DataPath({"Int32Array"}));
+    auto* float64Array = dataStructure.getDataAs<Float64Array>(DataPath({"Float64Array"}));
+    REQUIRE(int32Array != nullptr);
+    REQUIRE(float64Array != nullptr);
+    REQUIRE(int32Array->getTupleShape() == tupleShape);
+    REQUIRE(int32Array->getComponentShape() == componentShape);
+    REQUIRE(float64Array->getTupleShape() == tupleShape);
+    REQUIRE(float64Array->getComponentShape() == componentShape);
+    for(usize i = 0; i < int32Array->getSize(); i++)
+    {
+      REQUIRE((*int32Array)[i] == static_cast<int32>(i % 251) - 100);
+      REQUIRE((*float64Array)[i] == static_cast<float64>(i) * 0.25);
+    }
+  } catch(const std::exception& e)
+  {
+    FAIL(e.what());
+  }
+}
+
+TEST_CASE("Selective DataStructure Import")
+{
+  auto app = Application::GetOrCreateInstance();
+
+  fs::path dataDir = GetDataDir();
+  if(!fs::exists(dataDir))
+  {
+    REQUIRE(fs::create_directories(dataDir));
+  }
+
+  fs::path filePath = GetDataDir() / "SelectiveImportTest.dream3d";
+  std::string filePathString = filePath.string();
+
+  const std::vector<usize> tupleShape = {10, 5};
+  const std::vector<usize> componentShape = {1};
+
+  // Write HDF5 file
+  try
+  {
+    DataStructure dataStructure;
+    auto* topGroup = DataGroup::Create(dataStructure, "TopGroup");
+    auto* childGroup = DataGroup::Create(dataStructure, "ChildGroup", topGroup->getId());
+    auto* selectedArray = Int32Array::CreateWithStore<DataStore<int32>>(dataStructure, "SelectedArray", tupleShape, componentShape, childGroup->getId());
+    Int32Array::CreateWithStore<DataStore<int32>>(dataStructure, "SiblingArray", tupleShape, componentShape, childGroup->getId());
+    Int32Array::CreateWithStore<DataStore<int32>>(dataStructure, "OtherArray", tupleShape, componentShape);
+    for(usize i = 0; i < selectedArray->getSize(); i++)
+    {
+      (*selectedArray)[i] = static_cast<int32>(i);
+    }
+
+    Result<> writeResult = DREAM3D::WriteFile(filePath, dataStructure);
+    COMPLEX_RESULT_REQUIRE_VALID(writeResult);
+  } catch(const std::exception& e)
+  {
+    FAIL(e.what());
+  }
+
+  // Read only the selected path
+  try
+  {
+    complex::HDF5::FileReader fileReader(filePathString);
+    REQUIRE(fileReader.isValid());
+
+    const DataPath selectedPath({"TopGroup", "ChildGroup", "SelectedArray"});
+    auto readResult = DREAM3D::ImportDataStructureFromFile(fileReader, std::vector<DataPath>{selectedPath});
+    COMPLEX_RESULT_REQUIRE_VALID(readResult);
+    DataStructure dataStructure = std::move(readResult.value());
+
+    REQUIRE(dataStructure.getDataAs<DataGroup>(DataPath({"TopGroup", "ChildGroup"})) != nullptr);
+    REQUIRE(dataStructure.getData(DataPath({"TopGroup", "ChildGroup", "SiblingArray"})) == nullptr);
+    REQUIRE(dataStructure.getData(DataPath({"OtherArray"})) == nullptr);
+
+    auto* selectedArray = dataStructure.getDataAs<Int32Array>(selectedPath);
+    REQUIRE(selectedArray != nullptr);
+    REQUIRE(selectedArray->getTupleShape() == tupleShape);
+    for(usize i = 0; i < selectedArray->getSize(); i++)
+    {
+      REQUIRE((*selectedArray)[i] == static_cast<int32>(i));
+    }
+
+    // Selecting a group also reads its children
+    auto groupResult = DREAM3D::ImportDataStructureFromFile(fileReader, std::vector<DataPath>{DataPath({"TopGroup"})});
+    COMPLEX_RESULT_REQUIRE_VALID(groupResult);
+    REQUIRE(groupResult.value().getData(DataPath({"TopGroup", "ChildGroup", "SiblingArray"})) != nullptr);
+    REQUIRE(groupResult.value().getData(DataPath({"OtherArray"})) == nullptr);
+  } catch(const std::exception& e)
+  {
+    FAIL(e.what());
+  }
+}
+
 TEST_CASE("xdmf")
 {
   DataStructure dataStructure;
@@ -1,8 +1,16 @@
 #include <catch2/catch.hpp>
 
 #include "complex/Core/Application.hpp"
+#include "complex/DataStructure/AbstractDataStore.hpp"
 #include "complex/DataStructure/IO/Generic/DataIOCollection.hpp"
+#include "complex/DataStructure/IO/Generic/IOConstants.hpp"
 #include "complex/Utilities/MemoryUtilities.hpp"
+#include "complex/Utilities/Parsing/Text/TextTokenizer.hpp"
+#include "complex/unit_test/complex_test_dirs.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
 
 using namespace complex;
 
@@ -38,3 +46,124 @@ TEST_CASE("Target DataStructure Size", "IOTest")
   }
   REQUIRE(preferences->defaultValueAs<uint64>(Preferences::k_LargeDataStructureSize_Key) == targetReducedSize);
 }
+
+TEST_CASE("Memory Mapped DataStore", "IOTest")
+{
+  auto ioCollection = Application::GetOrCreateInstance()->getIOCollection();
+  REQUIRE(ioCollection->hasDataStoreCreationFunction(IOConstants::k_MmapDataFormat));
+
+  const IDataStore::ShapeType tupleShape = {4, 3, 2};
+  const IDataStore::ShapeType componentShape = {3};
+  auto dataStore = ioCollection->createDataStoreWithType<int32>(IOConstants::k_MmapDataFormat, tupleShape, componentShape);
+  REQUIRE(dataStore != nullptr);
+  REQUIRE(dataStore->getStoreType() == IDataStore::StoreType::OutOfCore);
+  REQUIRE(dataStore->getDataFormat() == IOConstants::k_MmapDataFormat.str());
+  REQUIRE(dataStore->getSize() == 72);
+
+  for(usize i = 0; i < dataStore->getSize(); i++)
+  {
+    REQUIRE(dataStore->getValue(i) == 0);
+    dataStore->setValue(i, static_cast<int32>(i));
+  }
+  dataStore->flush();
+
+  auto chunkShape = dataStore->getChunkShape();
+  REQUIRE(chunkShape.has_value());
+  REQUIRE(chunkShape->size() == tupleShape.size() + componentShape.size());
+  const std::vector<int32> chunkValues = dataStore->getChunkValues({0, 0, 0, 0});
+  REQUIRE(chunkValues.size() == (*chunkShape)[0] * 3 * 2 * 3);
+  REQUIRE(chunkValues.front() == 0);
+  REQUIRE(chunkValues.back() == static_cast<int32>(chunkValues.size() - 1));
+
+  auto copy = dataStore->deepCopy();
+  dataStore->setValue(0, 42);
+  REQUIRE(dynamic_cast<AbstractDataStore<int32>*>(copy.get())->getValue(0) == 0);
+
+  dataStore->resizeTuples({8, 3, 2});
+  REQUIRE(dataStore->getSize() == 144);
+  REQUIRE(dataStore->getValue(0) == 42);
+  REQUIRE(dataStore->getValue(71) == 71);
+  REQUIRE(dataStore->getValue(143) == 0);
+}
+
+TEST_CASE("Memory Mapped Text Tokenizer", "IOTest")
+{
+  // Enough lines to span several blocks, with a line that is longer than a block and Windows line endings
+  std::string text;
+  for(usize i = 0; i < 400000; i++)
+  {
+    text += fmt::format("{},{}, {}\t{}{}", i, i % 7 == 0 ? "" : "-3", i * 0.5, i % 2 == 0, i % 3 == 0 ? "\r\n" : "\n");
+    if(i == 200000)
+    {
+      text += std::string(TextTokenizer::k_BlockSize + 10, 'x') + "\n";
+    }
+  }
+  const std::filesystem::path filePath = std::filesystem::path(unit_test::k_BinaryTestOutputDir.view()) / "TextTokenizerTest.txt";
+  std::filesystem::create_directories(filePath.parent_path());
+  {
+    std::ofstream file(filePath, std::ios_base::binary);
+    file << text;
+  }
+
+  std::vector<std::string> expectedLines;
+  {
+    std::istringstream stream(text);
+    std::string line;
+    while(std::getline(stream, line))
+    {
+      expectedLines.push_back(line.empty() || line.back() != '\r' ? line : line.substr(0, line.size() - 1));
+    }
+    // The line feed at the end of the file is followed by an empty line
+    expectedLines.emplace_back();
+  }
+
+  for(bool parallel : {false, true})
+  {
+    std::unique_ptr<TextTokenizer> tokenizer = TextTokenizer::Open(filePath, parallel);
+    REQUIRE(tokenizer != nullptr);
+    REQUIRE(tokenizer->getNumberOfBlocks() > 2);
+    REQUIRE(tokenizer->getNumberOfLines() == expectedLines.size());
+    REQUIRE(tokenizer->getLine(200001) == expectedLines[200001]);
+    REQUIRE(tokenizer->getLine(expectedLines.size() - 2) == expectedLines[expectedLines.size() - 2]);
+
+    std::vector<uint8> matches(expectedLines.size(), 0);
+    const usize failedLine = tokenizer->forEachLine(0, TextTokenizer::k_AllLines, [&](usize lineIndex, std::string_view line) {
+      matches[lineIndex] = line == expectedLines[lineIndex] ? 1 : 0;
+      return true;
+    });
+    REQUIRE(failedLine == TextTokenizer::k_AllLines);
+    REQUIRE(std::count(matches.begin(), matches.end(), 1) == matches.size());
+
+    usize offset = 0;
+    for(usize i = 0; i < 3; i++)
+    {
+      REQUIRE(tokenizer->readLine(offset) == expectedLines[i]);
+    }
+
+    // The lowest line that fails is returned no matter which thread reaches it first
+    const usize firstFailure = tokenizer->forEachLine(1000, 390000, [](usize lineIndex, std::string_view) { return lineIndex % 100000 != 1; });
+    REQUIRE(firstFailure == 100001);
+  }
+
+  // Empty tokens are dropped like StringUtilities::split()
+  const std::array<char, 2> delimiters = {',', ' '};
+  std::vector<std::string_view> tokens;
+  TextTokenizer::Split("0,, 1.5 ,true", delimiters, tokens);
+  REQUIRE(tokens == std::vector<std::string_view>{"0", "1.5", "true"});
+  REQUIRE(TextTokenizer::CountTokens(",, ,", delimiters) == 0);
+
+  // The conversion errors match ConvertTo<T>
+  REQUIRE(TextTokenizer::Convert<int8>(" -128").value() == -128);
+  REQUIRE(TextTokenizer::Convert<int8>("128").errors()[0].code == TextTokenizer::k_OutOfRange);
+  REQUIRE(TextTokenizer::Convert<uint32>("-1").errors()[0].code == TextTokenizer::k_OutOfRange);
+  REQUIRE(TextTokenizer::Convert<uint32>("+42\r").value() == 42);
+  REQUIRE(TextTokenizer::Convert<int32>("a").errors()[0].code == TextTokenizer::k_InvalidToken);
+  REQUIRE(TextTokenizer::Convert<float32>("3.5E38").errors()[0].code == TextTokenizer::k_OutOfRange);
+  REQUIRE(TextTokenizer::Convert<float64>("1.25e2").value() == 125.0);
+  REQUIRE(TextTokenizer::Convert<float64>(" ").errors()[0].code == TextTokenizer::k_InvalidToken);
+  REQUIRE(TextTokenizer::Convert<bool>("False").value() == false);
+  REQUIRE(TextTokenizer::Convert<bool>("0.0").value() == false);
+  REQUIRE(TextTokenizer::Convert<bool>("2").value() == true);
+
+  std::filesystem::remove(filePath);
+}
@@ -30,6 +30,7 @@
 
 #include <algorithm>
 #include <filesystem>
+#include <map>
 
 namespace fs = std::filesystem;
 using namespace complex;
@@ -862,6 +863,67 @@ NeighborList<T>* CreateTestNeighborList(DataStructure& dataStructure, const std:
   return neighborList;
 }
 
+/**
+ * @brief In memory DataStore that reports that it is not thread safe. Filters that check
+ * IParallelAlgorithm::CheckArraysInMemory() take their serial code path for arrays using it,
+ * so the serial and parallel implementations can be compared on the same data.
+ */
+template <typename T>
+class SerialDataStore : public DataStore<T>
+{
+public:
+  using ShapeType = typename DataStore<T>::ShapeType;
+
+  SerialDataStore(const ShapeType& tupleShape, const ShapeType& componentShape)
+  : DataStore<T>(tupleShape, componentShape, static_cast<T>(0))
+  {
+  }
+
+  ~SerialDataStore() override = default;
+
+  bool isThreadSafe() const override
+  {
+    return false;
+  }
+};
+
+/**
+ * @brief Checks that two feature id arrays describe the same partition of the cells. Feature
+ * ids may be numbered differently, but every feature of one array has to map onto exactly one
+ * feature of the other array and cells that are 0 in one array have to be 0 in the other.
+ * @param left
+ * @param right
+ */
+inline void ComparePartitions(const AbstractDataStore<int32>& left, const AbstractDataStore<int32>& right)
+{
+  REQUIRE(left.getSize() == right.getSize());
+  std::map<int32, int32> leftToRight;
+  std::map<int32, int32> rightToLeft;
+  for(usize i = 0; i < left.getSize(); i++)
+  {
+    const int32 leftId = left.getValue(i);
+    const int32 rightId = right.getValue(i);
+    if(leftId == 0 || rightId == 0)
+    {
+      if(leftId != rightId)
+      {
+        UNSCOPED_INFO(fmt::format("Index {}: {} != {}", i, leftId, rightId));
+        REQUIRE(leftId == rightId);
+      }
+      continue;
+    }
+    // Both maps must be consistent for the mapping to be one to one
+    const int32 mappedRight = leftToRight.emplace(leftId, rightId).first->second;
+    const int32 mappedLeft = rightToLeft.emplace(rightId, leftId).first->second;
+    if(mappedRight != rightId || mappedLeft != leftId)
+    {
+      UNSCOPED_INFO(fmt::format("Index {}: feature {} maps onto {} and {}", i, leftId, mappedRight, rightId));
+      REQUIRE(mappedRight == rightId);
+      REQUIRE(mappedLeft == leftId);
+    }
+  }
+}
+
 /**
  * @brief Creates a DataStructure that mimics an EBSD data set
  * @return